@@ -0,0 +1,439 @@
+/*
+ * Copyright 2023 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Definition of anonymous streams of bytes.
+ */
+#pragma once
+
+#include <utility>
+
+#include "shm_stream/bytes_view.h"
+#include "shm_stream/c_interface/anonymous_stream_common.h"
+#include "shm_stream/c_interface/anonymous_stream_reader.h"
+#include "shm_stream/c_interface/anonymous_stream_writer.h"
+#include "shm_stream/common_types.h"
+#include "shm_stream/details/smart_ptr.h"
+#include "shm_stream/details/throw_if_error.h"
+
+namespace shm_stream {
+
+/*!
+ * \brief Class of handles of anonymous streams of bytes.
+ *
+ * Anonymous streams have no name, and they are opened using handles instead.
+ * Handles can be passed to other processes via Unix domain sockets using
+ * anonymous_stream::send and anonymous_stream::receive functions. A stream is
+ * removed when all handles and all writers and readers are destroyed.
+ *
+ * \note This class owns a file descriptor of the memory of the stream.
+ */
+class anonymous_stream_handle {
+public:
+    /*!
+     * \brief Constructor.
+     */
+    anonymous_stream_handle() noexcept = default;
+
+    /*!
+     * \brief Constructor.
+     *
+     * \param[in] fd File descriptor to own.
+     */
+    explicit anonymous_stream_handle(int fd) noexcept : fd_(fd) {}
+
+    // Prevent copy.
+    anonymous_stream_handle(const anonymous_stream_handle&) = delete;
+    auto operator=(const anonymous_stream_handle&) = delete;
+
+    /*!
+     * \brief Move constructor.
+     *
+     * \param[in] obj Object to move from.
+     */
+    anonymous_stream_handle(anonymous_stream_handle&& obj) noexcept
+        : fd_(std::exchange(obj.fd_, -1)) {}
+
+    /*!
+     * \brief Move assignment operator.
+     *
+     * \param[in] obj Object to move from.
+     * \return This.
+     */
+    anonymous_stream_handle& operator=(anonymous_stream_handle&& obj) noexcept {
+        if (this != &obj) {
+            reset();
+            fd_ = std::exchange(obj.fd_, -1);
+        }
+        return *this;
+    }
+
+    /*!
+     * \brief Destructor.
+     */
+    ~anonymous_stream_handle() noexcept { reset(); }
+
+    /*!
+     * \brief Check whether this object has a file descriptor.
+     *
+     * \retval true This object has a file descriptor.
+     * \retval false This object has no file descriptor.
+     */
+    [[nodiscard]] bool is_valid() const noexcept { return fd_ >= 0; }
+
+    /*!
+     * \brief Get the file descriptor.
+     *
+     * \return File descriptor.
+     */
+    [[nodiscard]] int fd() const noexcept { return fd_; }
+
+    /*!
+     * \brief Release the ownership of the file descriptor.
+     *
+     * \return File descriptor.
+     */
+    [[nodiscard]] int release() noexcept { return std::exchange(fd_, -1); }
+
+    /*!
+     * \brief Close the file descriptor.
+     *
+     * \note Writers and readers already opened can be used after this
+     * function is called.
+     */
+    void reset() noexcept {
+        if (fd_ >= 0) {
+            c_shm_stream_anonymous_stream_close(std::exchange(fd_, -1));
+        }
+    }
+
+private:
+    //! File descriptor. (-1 if not valid.)
+    int fd_{-1};
+};
+
+/*!
+ * \brief Class of writer of anonymous streams of bytes.
+ *
+ * \thread_safety All operation is safe if only one writer exists.
+ */
+class anonymous_stream_writer {
+public:
+    /*!
+     * \brief Constructor.
+     */
+    anonymous_stream_writer() = default;
+
+    // Prevent copy.
+    anonymous_stream_writer(const anonymous_stream_writer&) = delete;
+    auto operator=(const anonymous_stream_writer&) = delete;
+
+    /*!
+     * \brief Move constructor.
+     */
+    anonymous_stream_writer(
+        anonymous_stream_writer&& /*obj*/) noexcept = default;
+
+    /*!
+     * \brief Move assignment operator.
+     *
+     * \return This.
+     */
+    anonymous_stream_writer& operator=(
+        anonymous_stream_writer&& /*obj*/) noexcept = default;
+
+    /*!
+     * \brief Destructor.
+     *
+     * \note This function will automatically close this stream.
+     */
+    ~anonymous_stream_writer() noexcept = default;
+
+    /*!
+     * \brief Open a stream.
+     *
+     * \param[in] handle Handle of the stream.
+     */
+    void open(const anonymous_stream_handle& handle) {
+        c_shm_stream_anonymous_stream_writer_t* writer{nullptr};
+        details::throw_if_error(c_shm_stream_anonymous_stream_writer_create(
+            &writer, handle.fd()));
+        writer_ = details::smart_ptr<c_shm_stream_anonymous_stream_writer_t>(
+            writer, c_shm_stream_anonymous_stream_writer_destroy);
+    }
+
+    /*!
+     * \brief Close a stream.
+     *
+     * \note This function can be called when this stream has been already
+     * closed.
+     */
+    void close() noexcept { writer_.reset(); }
+
+    /*!
+     * \brief Check whether this object is opened.
+     *
+     * \retval true This object is opened.
+     * \retval false This object is not opened.
+     */
+    [[nodiscard]] bool is_opened() const noexcept { return writer_.has_obj(); }
+
+    /*!
+     * \brief Get the number of the available bytes to write.
+     *
+     * \return Number of the available bytes to write.
+     */
+    [[nodiscard]] shm_stream_size_t available_size() const noexcept {
+        return c_shm_stream_anonymous_stream_writer_available_size(
+            writer_.get());
+    }
+
+    /*!
+     * \brief Try to reserve some bytes to write.
+     *
+     * \param[in] expected_size Expected number of bytes to reserve to write.
+     * \return Buffer of the reserved bytes.
+     *
+     * \note This function tries to reserve given number of bytes, but a smaller
+     * or empty buffer may be returned.
+     * \note This function can return a buffer with a size smaller than the
+     * return value of available_size function, because this stream uses a
+     * circular buffer in the implementation and this function reserves
+     * continuous byte sequences from the circular buffer.
+     */
+    [[nodiscard]] mutable_bytes_view try_reserve(
+        shm_stream_size_t expected_size) noexcept {
+        const auto buf = c_shm_stream_anonymous_stream_writer_try_reserve(
+            writer_.get(), expected_size);
+        return mutable_bytes_view(buf.data, buf.size);
+    }
+
+    /*!
+     * \brief Try to reserve some bytes to write as many as possible.
+     *
+     * \return Buffer of the reserved bytes.
+     *
+     * \note This function can return a buffer with a size smaller than the
+     * return value of available_size function, because this stream uses a
+     * circular buffer in the implementation and this function reserves
+     * continuous byte sequences from the circular buffer.
+     */
+    [[nodiscard]] mutable_bytes_view try_reserve() noexcept {
+        const auto buf =
+            c_shm_stream_anonymous_stream_writer_try_reserve_all(writer_.get());
+        return mutable_bytes_view(buf.data, buf.size);
+    }
+
+    /*!
+     * \brief Save written bytes as completed and ready to be read by a reader.
+     *
+     * \param[in] written_size Number of written bytes to save.
+     */
+    void commit(shm_stream_size_t written_size) noexcept {
+        c_shm_stream_anonymous_stream_writer_commit(
+            writer_.get(), written_size);
+    }
+
+private:
+    //! Actual writer in C interface.
+    details::smart_ptr<c_shm_stream_anonymous_stream_writer_t> writer_{};
+};
+
+/*!
+ * \brief Class of reader of anonymous streams of bytes.
+ *
+ * \thread_safety All operation is safe if only one reader exists.
+ */
+class anonymous_stream_reader {
+public:
+    /*!
+     * \brief Constructor.
+     */
+    anonymous_stream_reader() = default;
+
+    // Prevent copy.
+    anonymous_stream_reader(const anonymous_stream_reader&) = delete;
+    auto operator=(const anonymous_stream_reader&) = delete;
+
+    /*!
+     * \brief Move constructor.
+     *
+     * \param[in] obj Object to move from.
+     */
+    anonymous_stream_reader(anonymous_stream_reader&& obj) noexcept = default;
+
+    /*!
+     * \brief Move assignment operator.
+     *
+     * \param[in] obj Object to move from.
+     * \return This.
+     */
+    anonymous_stream_reader& operator=(
+        anonymous_stream_reader&& obj) noexcept = default;
+
+    /*!
+     * \brief Destructor.
+     *
+     * \note This function will automatically close this stream.
+     */
+    ~anonymous_stream_reader() noexcept = default;
+
+    /*!
+     * \brief Open a stream.
+     *
+     * \param[in] handle Handle of the stream.
+     */
+    void open(const anonymous_stream_handle& handle) {
+        c_shm_stream_anonymous_stream_reader_t* reader{nullptr};
+        details::throw_if_error(c_shm_stream_anonymous_stream_reader_create(
+            &reader, handle.fd()));
+        reader_ = details::smart_ptr<c_shm_stream_anonymous_stream_reader_t>(
+            reader, c_shm_stream_anonymous_stream_reader_destroy);
+    }
+
+    /*!
+     * \brief Close a stream.
+     *
+     * \note This function can be called when this stream has been already
+     * closed.
+     */
+    void close() noexcept { reader_.reset(); }
+
+    /*!
+     * \brief Check whether this object is opened.
+     *
+     * \retval true This object is opened.
+     * \retval false This object is not opened.
+     */
+    [[nodiscard]] bool is_opened() const noexcept { return reader_.has_obj(); }
+
+    /*!
+     * \brief Get the number of the available bytes to read.
+     *
+     * \return Number of the available bytes to read.
+     */
+    [[nodiscard]] shm_stream_size_t available_size() const noexcept {
+        return c_shm_stream_anonymous_stream_reader_available_size(
+            reader_.get());
+    }
+
+    /*!
+     * \brief Try to reserve some bytes to read.
+     *
+     * \param[in] expected_size Expected number of bytes to reserve to read.
+     * \return Buffer of the reserved bytes.
+     *
+     * \note This function tries to reserve given number of bytes, but a smaller
+     * or empty buffer may be returned.
+     * \note This function can return a buffer with a size smaller than the
+     * return value of available_size function, because this stream uses a
+     * circular buffer in the implementation and this function reserves
+     * continuous byte sequences from the circular buffer.
+     */
+    [[nodiscard]] bytes_view try_reserve(
+        shm_stream_size_t expected_size) noexcept {
+        const auto buf = c_shm_stream_anonymous_stream_reader_try_reserve(
+            reader_.get(), expected_size);
+        return bytes_view(buf.data, buf.size);
+    }
+
+    /*!
+     * \brief Try to reserve some bytes to read as many as possible.
+     *
+     * \return Buffer of the reserved bytes.
+     *
+     * \note This function can return a buffer with a size smaller than the
+     * return value of available_size function, because this stream uses a
+     * circular buffer in the implementation and this function reserves
+     * continuous byte sequences from the circular buffer.
+     */
+    [[nodiscard]] bytes_view try_reserve() noexcept {
+        const auto buf =
+            c_shm_stream_anonymous_stream_reader_try_reserve_all(reader_.get());
+        return bytes_view(buf.data, buf.size);
+    }
+
+    /*!
+     * \brief Set some bytes as finished to read and ready to be written by a
+     * writer.
+     *
+     * \param[in] read_size Number of read bytes to save.
+     */
+    void commit(shm_stream_size_t read_size) noexcept {
+        c_shm_stream_anonymous_stream_reader_commit(reader_.get(), read_size);
+    }
+
+private:
+    //! Actual reader in C interface.
+    details::smart_ptr<c_shm_stream_anonymous_stream_reader_t> reader_{};
+};
+
+namespace anonymous_stream {
+
+/*!
+ * \brief Class of writer of anonymous streams of bytes.
+ */
+using writer = anonymous_stream_writer;
+
+/*!
+ * \brief Class of reader of anonymous streams of bytes.
+ */
+using reader = anonymous_stream_reader;
+
+/*!
+ * \brief Create a stream.
+ *
+ * \param[in] buffer_size Size of the buffer.
+ * \return Handle of the stream.
+ *
+ * \note This function is supported only on Linux.
+ */
+[[nodiscard]] inline anonymous_stream_handle create(
+    shm_stream_size_t buffer_size) {
+    int fd{-1};
+    details::throw_if_error(
+        c_shm_stream_anonymous_stream_create(&fd, buffer_size));
+    return anonymous_stream_handle(fd);
+}
+
+/*!
+ * \brief Send a handle of a stream to another process via a Unix domain
+ * socket.
+ *
+ * \param[in] socket Socket.
+ * \param[in] handle Handle of the stream.
+ */
+inline void send(int socket, const anonymous_stream_handle& handle) {
+    details::throw_if_error(
+        c_shm_stream_anonymous_stream_send(socket, handle.fd()));
+}
+
+/*!
+ * \brief Receive a handle of a stream from another process via a Unix domain
+ * socket.
+ *
+ * \param[in] socket Socket.
+ * \return Handle of the stream.
+ */
+[[nodiscard]] inline anonymous_stream_handle receive(int socket) {
+    int fd{-1};
+    details::throw_if_error(c_shm_stream_anonymous_stream_receive(socket, &fd));
+    return anonymous_stream_handle(fd);
+}
+
+}  // namespace anonymous_stream
+
+}  // namespace shm_stream
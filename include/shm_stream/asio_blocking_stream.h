@@ -0,0 +1,468 @@
+/*
+ * Copyright 2023 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Definition of asynchronous operations of blocking streams in asio.
+ *
+ * \note This header requires standalone asio, and is not included from other
+ * headers of this library.
+ */
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <utility>
+
+#include <asio/async_result.hpp>
+#include <asio/compose.hpp>
+#include <asio/error.hpp>
+#include <asio/error_code.hpp>
+#include <asio/post.hpp>
+#include <asio/steady_timer.hpp>
+
+#include "shm_stream/blocking_stream.h"
+#include "shm_stream/bytes_view.h"
+#include "shm_stream/common_types.h"
+
+namespace shm_stream {
+namespace details {
+
+/*!
+ * \brief Get the error code of operations of stopped streams.
+ *
+ * \return Error code.
+ */
+inline asio::error_code asio_stopped_error(
+    const blocking_stream_reader& /*stream*/) noexcept {
+    return asio::error::eof;
+}
+
+/*!
+ * \copydoc asio_stopped_error(const blocking_stream_reader&)
+ */
+inline asio::error_code asio_stopped_error(
+    const blocking_stream_writer& /*stream*/) noexcept {
+    return asio::error::broken_pipe;
+}
+
+/*!
+ * \brief Class to poll streams in asynchronous operations of asio.
+ *
+ * Streams are checked again after intervals of a timer starting from 1
+ * microsecond and doubling up to 1 millisecond while the streams are not
+ * ready, so that operations don't block threads of executors.
+ */
+class asio_stream_poller {
+public:
+    /*!
+     * \brief Constructor.
+     *
+     * \tparam ExecutorOrContext Type of the executor or the execution context.
+     * \param[in] executor_or_context Executor or execution context.
+     */
+    template <typename ExecutorOrContext>
+    explicit asio_stream_poller(ExecutorOrContext& executor_or_context)
+        : timer_(std::make_unique<asio::steady_timer>(executor_or_context)) {}
+
+    /*!
+     * \brief Start an operation.
+     *
+     * \tparam Self Type of the composed operation.
+     * \param[in] self Composed operation.
+     * \retval true The operation has already been started.
+     * \retval false The operation is started now and posted to the executor,
+     * so that the completion handler is not invoked in the initiating
+     * function.
+     */
+    template <typename Self>
+    [[nodiscard]] bool start(Self& self) {
+        if (is_started_) {
+            return true;
+        }
+        is_started_ = true;
+        asio::post(timer_->get_executor(), std::move(self));
+        return false;
+    }
+
+    /*!
+     * \brief Wait for the next check of the stream.
+     *
+     * \tparam Self Type of the composed operation.
+     * \param[in] self Composed operation.
+     */
+    template <typename Self>
+    void wait(Self& self) {
+        asio::steady_timer& timer = *timer_;
+        timer.expires_after(interval_);
+        interval_ = std::min(interval_ * 2, max_interval());
+        timer.async_wait(std::move(self));
+    }
+
+    /*!
+     * \brief Reset the interval after progress of the stream.
+     */
+    void reset() noexcept { interval_ = min_interval(); }
+
+private:
+    /*!
+     * \brief Get the minimum interval of checks.
+     *
+     * \return Interval.
+     */
+    static constexpr std::chrono::nanoseconds min_interval() noexcept {
+        return std::chrono::microseconds(1);
+    }
+
+    /*!
+     * \brief Get the maximum interval of checks.
+     *
+     * \return Interval.
+     */
+    static constexpr std::chrono::nanoseconds max_interval() noexcept {
+        return std::chrono::milliseconds(1);
+    }
+
+    //! Timer.
+    std::unique_ptr<asio::steady_timer> timer_;
+
+    //! Interval of the next check.
+    std::chrono::nanoseconds interval_{min_interval()};
+
+    //! Whether the operation has been started.
+    bool is_started_{false};
+};
+
+/*!
+ * \brief Class of composed operations to wait to reserve bytes.
+ *
+ * \tparam Stream Type of the writer or reader.
+ */
+template <typename Stream>
+class asio_wait_reserve_op {
+public:
+    //! Type of buffers.
+    using buffer_type =
+        decltype(std::declval<Stream&>().try_reserve(shm_stream_size_t()));
+
+    /*!
+     * \brief Constructor.
+     *
+     * \tparam ExecutorOrContext Type of the executor or the execution context.
+     * \param[in] stream Writer or reader.
+     * \param[in] expected_size Expected number of bytes to reserve.
+     * \param[in] executor_or_context Executor or execution context.
+     */
+    template <typename ExecutorOrContext>
+    asio_wait_reserve_op(Stream& stream, shm_stream_size_t expected_size,
+        ExecutorOrContext& executor_or_context)
+        : stream_(&stream),
+          expected_size_(expected_size),
+          poller_(executor_or_context) {}
+
+    /*!
+     * \brief Process the operation.
+     *
+     * \tparam Self Type of the composed operation.
+     * \param[in] self Composed operation.
+     * \param[in] error Error of the last wait.
+     */
+    template <typename Self>
+    void operator()(Self& self, asio::error_code error = asio::error_code()) {
+        if (!poller_.start(self)) {
+            return;
+        }
+        if (error) {
+            self.complete(error, buffer_type(nullptr, 0U));
+            return;
+        }
+        if (stream_->is_stopped()) {
+            self.complete(
+                asio_stopped_error(*stream_), buffer_type(nullptr, 0U));
+            return;
+        }
+        const buffer_type buffer = stream_->try_reserve(expected_size_);
+        if (!buffer.empty()) {
+            self.complete(error, buffer);
+            return;
+        }
+        poller_.wait(self);
+    }
+
+private:
+    //! Writer or reader.
+    Stream* stream_;
+
+    //! Expected number of bytes to reserve.
+    shm_stream_size_t expected_size_;
+
+    //! Poller.
+    asio_stream_poller poller_;
+};
+
+/*!
+ * \brief Class of composed operations to read some bytes.
+ */
+class asio_read_some_op {
+public:
+    /*!
+     * \brief Constructor.
+     *
+     * \tparam ExecutorOrContext Type of the executor or the execution context.
+     * \param[in] reader Reader.
+     * \param[in] buffer Buffer to write read bytes.
+     * \param[in] executor_or_context Executor or execution context.
+     */
+    template <typename ExecutorOrContext>
+    asio_read_some_op(blocking_stream_reader& reader,
+        mutable_bytes_view buffer, ExecutorOrContext& executor_or_context)
+        : reader_(&reader), buffer_(buffer), poller_(executor_or_context) {}
+
+    /*!
+     * \brief Process the operation.
+     *
+     * \tparam Self Type of the composed operation.
+     * \param[in] self Composed operation.
+     * \param[in] error Error of the last wait.
+     */
+    template <typename Self>
+    void operator()(Self& self, asio::error_code error = asio::error_code()) {
+        if (!poller_.start(self)) {
+            return;
+        }
+        if (error) {
+            self.complete(error, std::size_t{0});
+            return;
+        }
+        if (buffer_.empty()) {
+            self.complete(error, std::size_t{0});
+            return;
+        }
+        if (reader_->is_stopped()) {
+            self.complete(asio_stopped_error(*reader_), std::size_t{0});
+            return;
+        }
+        const bytes_view reserved = reader_->try_reserve(buffer_.size());
+        if (!reserved.empty()) {
+            std::memcpy(buffer_.data(), reserved.data(), reserved.size());
+            reader_->commit(reserved.size());
+            self.complete(error, static_cast<std::size_t>(reserved.size()));
+            return;
+        }
+        poller_.wait(self);
+    }
+
+private:
+    //! Reader.
+    blocking_stream_reader* reader_;
+
+    //! Buffer to write read bytes.
+    mutable_bytes_view buffer_;
+
+    //! Poller.
+    asio_stream_poller poller_;
+};
+
+/*!
+ * \brief Class of composed operations to write all bytes.
+ */
+class asio_write_all_op {
+public:
+    /*!
+     * \brief Constructor.
+     *
+     * \tparam ExecutorOrContext Type of the executor or the execution context.
+     * \param[in] writer Writer.
+     * \param[in] data Bytes to write.
+     * \param[in] executor_or_context Executor or execution context.
+     */
+    template <typename ExecutorOrContext>
+    asio_write_all_op(blocking_stream_writer& writer, bytes_view data,
+        ExecutorOrContext& executor_or_context)
+        : writer_(&writer), data_(data), poller_(executor_or_context) {}
+
+    /*!
+     * \brief Process the operation.
+     *
+     * \tparam Self Type of the composed operation.
+     * \param[in] self Composed operation.
+     * \param[in] error Error of the last wait.
+     */
+    template <typename Self>
+    void operator()(Self& self, asio::error_code error = asio::error_code()) {
+        if (!poller_.start(self)) {
+            return;
+        }
+        if (error) {
+            self.complete(error, written_size_);
+            return;
+        }
+        while (written_size_ < data_.size()) {
+            if (writer_->is_stopped()) {
+                self.complete(asio_stopped_error(*writer_), written_size_);
+                return;
+            }
+            const auto remaining_size =
+                static_cast<shm_stream_size_t>(data_.size() - written_size_);
+            const mutable_bytes_view reserved =
+                writer_->try_reserve(remaining_size);
+            if (reserved.empty()) {
+                poller_.wait(self);
+                return;
+            }
+            std::memcpy(reserved.data(), data_.data() + written_size_,
+                reserved.size());
+            writer_->commit(reserved.size());
+            written_size_ += reserved.size();
+            poller_.reset();
+        }
+        self.complete(error, written_size_);
+    }
+
+private:
+    //! Writer.
+    blocking_stream_writer* writer_;
+
+    //! Bytes to write.
+    bytes_view data_;
+
+    //! Number of written bytes.
+    std::size_t written_size_{0};
+
+    //! Poller.
+    asio_stream_poller poller_;
+};
+
+}  // namespace details
+
+/*!
+ * \brief Asynchronously wait to reserve some bytes to read.
+ *
+ * \tparam ExecutorOrContext Type of the executor or the execution context.
+ * \tparam CompletionToken Type of the completion token.
+ * \param[in] executor_or_context Executor or execution context to run the
+ * operation.
+ * \param[in] reader Reader.
+ * \param[in] expected_size Expected number of bytes to reserve to read.
+ * \param[in] token Completion token with signature
+ * `void(asio::error_code, bytes_view)`.
+ * \return Value determined by the completion token.
+ *
+ * \note The operation completes when at least one byte is available, and the
+ * reserved bytes must be committed by the reader. After stop of the stream,
+ * the operation completes with asio::error::eof.
+ * \note The reader must not be used until the operation completes.
+ */
+template <typename ExecutorOrContext, typename CompletionToken>
+auto async_wait_reserve(ExecutorOrContext&& executor_or_context,
+    blocking_stream_reader& reader, shm_stream_size_t expected_size,
+    CompletionToken&& token) {
+    return asio::async_compose<CompletionToken,
+        void(asio::error_code, bytes_view)>(
+        details::asio_wait_reserve_op<blocking_stream_reader>(
+            reader, expected_size, executor_or_context),
+        token, executor_or_context);
+}
+
+/*!
+ * \brief Asynchronously wait to reserve some bytes to write.
+ *
+ * \tparam ExecutorOrContext Type of the executor or the execution context.
+ * \tparam CompletionToken Type of the completion token.
+ * \param[in] executor_or_context Executor or execution context to run the
+ * operation.
+ * \param[in] writer Writer.
+ * \param[in] expected_size Expected number of bytes to reserve to write.
+ * \param[in] token Completion token with signature
+ * `void(asio::error_code, mutable_bytes_view)`.
+ * \return Value determined by the completion token.
+ *
+ * \note The operation completes when at least one byte is available, and the
+ * reserved bytes must be committed by the writer. After stop of the stream,
+ * the operation completes with asio::error::broken_pipe.
+ * \note The writer must not be used until the operation completes.
+ */
+template <typename ExecutorOrContext, typename CompletionToken>
+auto async_wait_reserve(ExecutorOrContext&& executor_or_context,
+    blocking_stream_writer& writer, shm_stream_size_t expected_size,
+    CompletionToken&& token) {
+    return asio::async_compose<CompletionToken,
+        void(asio::error_code, mutable_bytes_view)>(
+        details::asio_wait_reserve_op<blocking_stream_writer>(
+            writer, expected_size, executor_or_context),
+        token, executor_or_context);
+}
+
+/*!
+ * \brief Asynchronously read some bytes.
+ *
+ * \tparam ExecutorOrContext Type of the executor or the execution context.
+ * \tparam CompletionToken Type of the completion token.
+ * \param[in] executor_or_context Executor or execution context to run the
+ * operation.
+ * \param[in] reader Reader.
+ * \param[in] buffer Buffer to write read bytes.
+ * \param[in] token Completion token with signature
+ * `void(asio::error_code, std::size_t)` receiving the number of read bytes.
+ * \return Value determined by the completion token.
+ *
+ * \note The operation completes when at least one byte is read. After stop of
+ * the stream, the operation completes with asio::error::eof.
+ * \note The reader and the buffer must not be used until the operation
+ * completes.
+ */
+template <typename ExecutorOrContext, typename CompletionToken>
+auto async_read_some(ExecutorOrContext&& executor_or_context,
+    blocking_stream_reader& reader, mutable_bytes_view buffer,
+    CompletionToken&& token) {
+    return asio::async_compose<CompletionToken,
+        void(asio::error_code, std::size_t)>(
+        details::asio_read_some_op(reader, buffer, executor_or_context), token,
+        executor_or_context);
+}
+
+/*!
+ * \brief Asynchronously write all bytes.
+ *
+ * \tparam ExecutorOrContext Type of the executor or the execution context.
+ * \tparam CompletionToken Type of the completion token.
+ * \param[in] executor_or_context Executor or execution context to run the
+ * operation.
+ * \param[in] writer Writer.
+ * \param[in] data Bytes to write.
+ * \param[in] token Completion token with signature
+ * `void(asio::error_code, std::size_t)` receiving the number of written
+ * bytes.
+ * \return Value determined by the completion token.
+ *
+ * \note Byte sequences larger than the buffer of the stream are written in
+ * parts. After stop of the stream, the operation completes with
+ * asio::error::broken_pipe.
+ * \note The writer and the bytes must not be used until the operation
+ * completes.
+ */
+template <typename ExecutorOrContext, typename CompletionToken>
+auto async_write_all(ExecutorOrContext&& executor_or_context,
+    blocking_stream_writer& writer, bytes_view data, CompletionToken&& token) {
+    return asio::async_compose<CompletionToken,
+        void(asio::error_code, std::size_t)>(
+        details::asio_write_all_op(writer, data, executor_or_context), token,
+        executor_or_context);
+}
+
+}  // namespace shm_stream
@@ -19,15 +19,23 @@
  */
 #pragma once
 
+#include <chrono>
+#include <initializer_list>
+#include <vector>
+
 #include "shm_stream/bytes_view.h"
 #include "shm_stream/c_interface/blocking_stream_common.h"
 #include "shm_stream/c_interface/blocking_stream_reader.h"
 #include "shm_stream/c_interface/blocking_stream_writer.h"
 #include "shm_stream/c_interface/string_view.h"
 #include "shm_stream/common_types.h"
+#include "shm_stream/details/scatter_gather.h"
 #include "shm_stream/details/smart_ptr.h"
 #include "shm_stream/details/throw_if_error.h"
+#include "shm_stream/doorbell.h"
+#include "shm_stream/stream_reactor.h"
 #include "shm_stream/string_view.h"
+#include "shm_stream/wait_policy.h"
 
 namespace shm_stream {
 
@@ -74,12 +82,18 @@ public:
      *
      * \param[in] name Name of the stream.
      * \param[in] buffer_size Size of the buffer.
+     * \param[in] policy Policy to wait.
+     * \param[in] options Options of memory.
      */
-    void open(string_view name, shm_stream_size_t buffer_size) {
+    void open(string_view name, shm_stream_size_t buffer_size,
+        const wait_policy& policy = wait_policy(),
+        memory_options options = memory_options::none) {
         c_shm_stream_blocking_stream_writer_t* writer{nullptr};
-        details::throw_if_error(c_shm_stream_blocking_stream_writer_create(
-            &writer, c_shm_stream_string_view_t{name.data(), name.size()},
-            buffer_size));
+        details::throw_if_error(
+            c_shm_stream_blocking_stream_writer_create_with_memory_options(
+                &writer, c_shm_stream_string_view_t{name.data(), name.size()},
+                buffer_size, policy.c_policy(),
+                static_cast<c_shm_stream_memory_options_t>(options)));
         writer_ = details::smart_ptr<c_shm_stream_blocking_stream_writer_t>(
             writer, c_shm_stream_blocking_stream_writer_destroy);
     }
@@ -112,6 +126,42 @@ public:
             writer_.get());
     }
 
+    /*!
+     * \brief Get the size of pages backing the buffer of the stream.
+     *
+     * \return Size of pages actually used by the operating system.
+     *
+     * \note This function is useful to check whether huge pages are used with
+     * buffer_layout::huge_pages layout. Pages may be allocated at the first
+     * access, so call this function after some data are transferred.
+     */
+    [[nodiscard]] shm_stream_size_t page_size() const noexcept {
+        return c_shm_stream_blocking_stream_writer_page_size(writer_.get());
+    }
+
+    /*!
+     * \brief Get the NUMA node on which pages of the stream are.
+     *
+     * \return NUMA node having the most pages of the stream. (numa_node_none
+     * if unknown.)
+     */
+    [[nodiscard]] numa_node_t numa_node() const noexcept {
+        return c_shm_stream_blocking_stream_writer_numa_node(writer_.get());
+    }
+
+    /*!
+     * \brief Set a doorbell to ring when a reader armed it.
+     *
+     * \param[in] bell Doorbell. (An empty doorbell to remove the doorbell.)
+     *
+     * \note This object keeps its own file descriptor of the doorbell.
+     */
+    void set_doorbell(const doorbell& bell) {
+        details::throw_if_error(
+            c_shm_stream_blocking_stream_writer_set_doorbell(
+                writer_.get(), bell.fd()));
+    }
+
     /*!
      * \brief Wait until some bytes are available.
      *
@@ -220,6 +270,27 @@ public:
         return mutable_bytes_view(buf.data, buf.size);
     }
 
+#ifdef SHM_STREAM_HAS_COROUTINES
+    /*!
+     * \brief Asynchronously wait to reserve some bytes to write.
+     *
+     * \param[in] expected_size Expected number of bytes to reserve to write.
+     * \param[in] reactor Reactor to resume the awaiting coroutine.
+     * \return Awaitable object returning the buffer of the reserved bytes.
+     *
+     * \note The awaiting coroutine is resumed in the thread of the reactor
+     * when at least one byte is available or this stream is stopped (then the
+     * buffer is empty).
+     * \note This function is available only in C++20 or later.
+     */
+    [[nodiscard]] details::reserve_awaitable<blocking_stream_writer>
+    async_reserve(shm_stream_size_t expected_size,
+        stream_reactor& reactor = stream_reactor::default_reactor()) {
+        return details::reserve_awaitable<blocking_stream_writer>(
+            *this, expected_size, reactor);
+    }
+#endif
+
     /*!
      * \brief Save written bytes as completed and ready to be read by a reader.
      *
@@ -229,6 +300,55 @@ public:
         c_shm_stream_blocking_stream_writer_commit(writer_.get(), written_size);
     }
 
+    /*!
+     * \brief Wait to write bytes gathered from pieces at once.
+     *
+     * \param[in] pieces Pieces of bytes to write in order.
+     * \param[in] num_pieces Number of the pieces.
+     * \retval true All pieces were written.
+     * \retval false This stream was stopped, or the pieces can never fit in
+     * the buffer. (No byte is written.)
+     *
+     * \note This function waits until space for all pieces is available,
+     * copies them into one reservation wrapping around the end of the
+     * circular buffer, and commits them at once.
+     */
+    [[nodiscard]] bool wait_write_gather(
+        const bytes_view* pieces, shm_stream_size_t num_pieces) noexcept {
+        return c_shm_stream_blocking_stream_writer_wait_write_gather(
+            writer_.get(), details::to_c_bytes_views(pieces), num_pieces);
+    }
+
+    /*!
+     * \brief Wait to write bytes gathered from pieces at once.
+     *
+     * \param[in] pieces Pieces of bytes to write in order.
+     * \retval true All pieces were written.
+     * \retval false This stream was stopped, or the pieces can never fit in
+     * the buffer. (No byte is written.)
+     */
+    [[nodiscard]] bool wait_write_gather(
+        std::initializer_list<bytes_view> pieces) noexcept {
+        return wait_write_gather(
+            pieces.begin(), static_cast<shm_stream_size_t>(pieces.size()));
+    }
+
+    /*!
+     * \brief Write all bytes in a byte sequence waiting for space.
+     *
+     * \param[in] data Bytes to write.
+     * \retval true All bytes were written.
+     * \retval false This stream was stopped before all bytes were written.
+     *
+     * \note This function copies bytes with non-temporal stores for large
+     * byte sequences so that the bytes do not evict the cache of the writer.
+     * \note Byte sequences larger than the buffer are written in parts.
+     */
+    [[nodiscard]] bool write_all(bytes_view data) noexcept {
+        return c_shm_stream_blocking_stream_writer_write_all(
+            writer_.get(), c_shm_stream_bytes_view_t{data.data(), data.size()});
+    }
+
 private:
     //! Actual writer in C interface.
     details::smart_ptr<c_shm_stream_blocking_stream_writer_t> writer_{};
@@ -280,12 +400,18 @@ public:
      *
      * \param[in] name Name of the stream.
      * \param[in] buffer_size Size of the buffer.
+     * \param[in] policy Policy to wait.
+     * \param[in] options Options of memory.
      */
-    void open(string_view name, shm_stream_size_t buffer_size) {
+    void open(string_view name, shm_stream_size_t buffer_size,
+        const wait_policy& policy = wait_policy(),
+        memory_options options = memory_options::none) {
         c_shm_stream_blocking_stream_reader_t* reader{nullptr};
-        details::throw_if_error(c_shm_stream_blocking_stream_reader_create(
-            &reader, c_shm_stream_string_view_t{name.data(), name.size()},
-            buffer_size));
+        details::throw_if_error(
+            c_shm_stream_blocking_stream_reader_create_with_memory_options(
+                &reader, c_shm_stream_string_view_t{name.data(), name.size()},
+                buffer_size, policy.c_policy(),
+                static_cast<c_shm_stream_memory_options_t>(options)));
         reader_ = details::smart_ptr<c_shm_stream_blocking_stream_reader_t>(
             reader, c_shm_stream_blocking_stream_reader_destroy);
     }
@@ -318,6 +444,56 @@ public:
             reader_.get());
     }
 
+    /*!
+     * \brief Get the size of pages backing the buffer of the stream.
+     *
+     * \return Size of pages actually used by the operating system.
+     *
+     * \note This function is useful to check whether huge pages are used with
+     * buffer_layout::huge_pages layout. Pages may be allocated at the first
+     * access, so call this function after some data are transferred.
+     */
+    [[nodiscard]] shm_stream_size_t page_size() const noexcept {
+        return c_shm_stream_blocking_stream_reader_page_size(reader_.get());
+    }
+
+    /*!
+     * \brief Get the NUMA node on which pages of the stream are.
+     *
+     * \return NUMA node having the most pages of the stream. (numa_node_none
+     * if unknown.)
+     */
+    [[nodiscard]] numa_node_t numa_node() const noexcept {
+        return c_shm_stream_blocking_stream_reader_numa_node(reader_.get());
+    }
+
+    /*!
+     * \brief Set a doorbell to be notified of commits of the writer.
+     *
+     * \param[in] bell Doorbell. (An empty doorbell to remove the doorbell.)
+     *
+     * \note This object keeps its own file descriptor of the doorbell.
+     */
+    void set_doorbell(const doorbell& bell) {
+        details::throw_if_error(
+            c_shm_stream_blocking_stream_reader_set_doorbell(
+                reader_.get(), bell.fd()));
+    }
+
+    /*!
+     * \brief Arm the doorbell before waiting for it.
+     *
+     * \retval true Doorbell is armed. Wait for the file descriptor of the
+     * doorbell to be readable, then read bytes and call this function again.
+     * \retval false Some bytes are available or this stream is stopped, so the
+     * doorbell is not armed.
+     *
+     * \note The doorbell must be set to both the writer and this reader.
+     */
+    [[nodiscard]] bool arm_doorbell() noexcept {
+        return c_shm_stream_blocking_stream_reader_arm_doorbell(reader_.get());
+    }
+
     /*!
      * \brief Get the number of the available bytes to read.
      *
@@ -426,6 +602,27 @@ public:
         return bytes_view(buf.data, buf.size);
     }
 
+#ifdef SHM_STREAM_HAS_COROUTINES
+    /*!
+     * \brief Asynchronously wait to reserve some bytes to read.
+     *
+     * \param[in] expected_size Expected number of bytes to reserve to read.
+     * \param[in] reactor Reactor to resume the awaiting coroutine.
+     * \return Awaitable object returning the buffer of the reserved bytes.
+     *
+     * \note The awaiting coroutine is resumed in the thread of the reactor
+     * when at least one byte is available or this stream is stopped (then the
+     * buffer is empty).
+     * \note This function is available only in C++20 or later.
+     */
+    [[nodiscard]] details::reserve_awaitable<blocking_stream_reader>
+    async_reserve(shm_stream_size_t expected_size,
+        stream_reactor& reactor = stream_reactor::default_reactor()) {
+        return details::reserve_awaitable<blocking_stream_reader>(
+            *this, expected_size, reactor);
+    }
+#endif
+
     /*!
      * \brief Set some bytes as finished to read and ready to be written by a
      * writer.
@@ -436,11 +633,135 @@ public:
         c_shm_stream_blocking_stream_reader_commit(reader_.get(), read_size);
     }
 
+    /*!
+     * \brief Wait to read bytes scattering into pieces at once.
+     *
+     * \param[in] pieces Pieces of buffers to fill in order.
+     * \param[in] num_pieces Number of the pieces.
+     * \retval true All pieces were filled.
+     * \retval false This stream was stopped, or the pieces can never be
+     * filled from the buffer. (No byte is read.)
+     *
+     * \note This function waits until bytes for all pieces are available,
+     * copies them from one reservation wrapping around the end of the
+     * circular buffer, and commits them at once.
+     */
+    [[nodiscard]] bool wait_read_scatter(const mutable_bytes_view* pieces,
+        shm_stream_size_t num_pieces) noexcept {
+        return c_shm_stream_blocking_stream_reader_wait_read_scatter(
+            reader_.get(), details::to_c_bytes_views(pieces), num_pieces);
+    }
+
+    /*!
+     * \brief Wait to read bytes scattering into pieces at once.
+     *
+     * \param[in] pieces Pieces of buffers to fill in order.
+     * \retval true All pieces were filled.
+     * \retval false This stream was stopped, or the pieces can never be
+     * filled from the buffer. (No byte is read.)
+     */
+    [[nodiscard]] bool wait_read_scatter(
+        std::initializer_list<mutable_bytes_view> pieces) noexcept {
+        return wait_read_scatter(
+            pieces.begin(), static_cast<shm_stream_size_t>(pieces.size()));
+    }
+
+    /*!
+     * \brief Read bytes filling a buffer waiting for bytes.
+     *
+     * \param[in] buffer Buffer to fill.
+     * \retval true The buffer was filled.
+     * \retval false This stream was stopped before the buffer was filled.
+     *
+     * \note Unlike the function to write all bytes in the writer, this
+     * function copies bytes without non-temporal stores, because the bytes
+     * are used by the reader soon.
+     * \note Buffers larger than the buffer of this stream are filled in
+     * parts.
+     */
+    [[nodiscard]] bool read_exact(mutable_bytes_view buffer) noexcept {
+        return c_shm_stream_blocking_stream_reader_read_exact(reader_.get(),
+            c_shm_stream_mutable_bytes_view_t{buffer.data(), buffer.size()});
+    }
+
 private:
+    friend std::vector<shm_stream_size_t> wait_any(
+        blocking_stream_reader* const* readers, shm_stream_size_t num_readers,
+        std::chrono::nanoseconds timeout);
+
     //! Actual reader in C interface.
     details::smart_ptr<c_shm_stream_blocking_stream_reader_t> reader_{};
 };
 
+/*!
+ * \brief Wait until any of readers of blocking streams can read some bytes.
+ *
+ * \param[in] readers Readers.
+ * \param[in] num_readers Number of readers.
+ * \param[in] timeout Timeout. (Negative value for no timeout.)
+ * \return Indices of ready readers in ascending order. (Empty on timeout.)
+ *
+ * \note Readers of stopped streams and closed readers are treated as ready.
+ * \note On Linux, this function waits for all readers at once using
+ * futex_waitv system call.
+ */
+inline std::vector<shm_stream_size_t> wait_any(
+    blocking_stream_reader* const* readers, shm_stream_size_t num_readers,
+    std::chrono::nanoseconds timeout) {
+    std::vector<c_shm_stream_blocking_stream_reader_t*> c_readers;
+    c_readers.reserve(num_readers);
+    for (shm_stream_size_t i = 0U; i < num_readers; ++i) {
+        c_readers.push_back(readers[i]->reader_.get());
+    }
+    std::vector<shm_stream_size_t> ready_indices(num_readers);
+    ready_indices.resize(c_shm_stream_blocking_stream_reader_wait_any(
+        c_readers.data(), num_readers, timeout.count(),
+        ready_indices.data()));
+    return ready_indices;
+}
+
+/*!
+ * \brief Wait until any of readers of blocking streams can read some bytes
+ * without timeout.
+ *
+ * \param[in] readers Readers.
+ * \param[in] num_readers Number of readers.
+ * \return Indices of ready readers in ascending order.
+ *
+ * \note Readers of stopped streams and closed readers are treated as ready.
+ */
+inline std::vector<shm_stream_size_t> wait_any(
+    blocking_stream_reader* const* readers, shm_stream_size_t num_readers) {
+    return wait_any(readers, num_readers, std::chrono::nanoseconds(-1));
+}
+
+/*!
+ * \brief Wait until any of readers of blocking streams can read some bytes.
+ *
+ * \param[in] readers Readers.
+ * \param[in] timeout Timeout. (Negative value for no timeout.)
+ * \return Indices of ready readers in ascending order. (Empty on timeout.)
+ */
+inline std::vector<shm_stream_size_t> wait_any(
+    std::initializer_list<blocking_stream_reader*> readers,
+    std::chrono::nanoseconds timeout) {
+    return wait_any(readers.begin(),
+        static_cast<shm_stream_size_t>(readers.size()), timeout);
+}
+
+/*!
+ * \brief Wait until any of readers of blocking streams can read some bytes
+ * without timeout.
+ *
+ * \param[in] readers Readers.
+ * \return Indices of ready readers in ascending order.
+ */
+inline std::vector<shm_stream_size_t> wait_any(
+    std::initializer_list<blocking_stream_reader*> readers) {
+    return wait_any(readers.begin(),
+        static_cast<shm_stream_size_t>(readers.size()));
+}
+
 /*!
  * \brief Classes and functions of blocking streams of bytes with wait
  * operations.
@@ -462,10 +783,27 @@ using reader = blocking_stream_reader;
  *
  * \param[in] name Name of the stream.
  * \param[in] buffer_size Size of the buffer.
+ * \param[in] layout Layout of the buffer.
+ * \param[in] numa_node NUMA node to bind pages to. (numa_node_current for the
+ * node of the CPU running the calling thread, numa_node_none for the usual
+ * placement of pages.)
+ *
+ * \note If the stream already exists, the layout and the placement of pages
+ * of the existing stream are used.
+ * \note If pages cannot be bound to the NUMA node, the stream is not created.
  */
-inline void create(string_view name, shm_stream_size_t buffer_size) {
-    details::throw_if_error(c_shm_stream_blocking_stream_create(
-        c_shm_stream_string_view_t{name.data(), name.size()}, buffer_size));
+inline void create(string_view name, shm_stream_size_t buffer_size,
+    buffer_layout layout = buffer_layout::plain,
+    numa_node_t numa_node = numa_node_none) {
+    if (numa_node == numa_node_none) {
+        details::throw_if_error(c_shm_stream_blocking_stream_create_with_layout(
+            c_shm_stream_string_view_t{name.data(), name.size()}, buffer_size,
+            static_cast<c_shm_stream_buffer_layout_t>(layout)));
+        return;
+    }
+    details::throw_if_error(c_shm_stream_blocking_stream_create_on_numa_node(
+        c_shm_stream_string_view_t{name.data(), name.size()}, buffer_size,
+        static_cast<c_shm_stream_buffer_layout_t>(layout), numa_node));
 }
 
 /*!
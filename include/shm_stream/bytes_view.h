@@ -25,16 +25,22 @@ namespace shm_stream {
 
 /*!
  * \brief Class of views of non-constant byte sequences.
+ *
+ * \tparam SizeType Type of sizes.
  */
-class mutable_bytes_view {
+template <typename SizeType>
+class basic_mutable_bytes_view {
 public:
+    //! Type of sizes.
+    using size_type = SizeType;
+
     /*!
      * \brief Constructor.
      *
      * \param[in] data Pointer to the data.
      * \param[in] size Size of the data.
      */
-    constexpr mutable_bytes_view(char* data, shm_stream_size_t size) noexcept
+    constexpr basic_mutable_bytes_view(char* data, size_type size) noexcept
         : data_(data), size_(size) {}
 
     /*!
@@ -49,7 +55,7 @@ public:
      *
      * \return Size of the data.
      */
-    [[nodiscard]] shm_stream_size_t size() const noexcept { return size_; }
+    [[nodiscard]] size_type size() const noexcept { return size_; }
 
     /*!
      * \brief Check whether this buffer is empty.
@@ -64,21 +70,27 @@ private:
     char* data_;
 
     //! Size of the data.
-    shm_stream_size_t size_;
+    size_type size_;
 };
 
 /*!
  * \brief Class of views of constant byte sequences.
+ *
+ * \tparam SizeType Type of sizes.
  */
-class bytes_view {
+template <typename SizeType>
+class basic_bytes_view {
 public:
+    //! Type of sizes.
+    using size_type = SizeType;
+
     /*!
      * \brief Constructor.
      *
      * \param[in] data Pointer to the data.
      * \param[in] size Size of the data.
      */
-    constexpr bytes_view(const char* data, shm_stream_size_t size) noexcept
+    constexpr basic_bytes_view(const char* data, size_type size) noexcept
         : data_(data), size_(size) {}
 
     /*!
@@ -86,9 +98,9 @@ public:
      *
      * \param[in] view View of a writable byte sequence.
      */
-    bytes_view(  // NOLINT(google-explicit-constructor, hicpp-explicit-conversions)
-        const mutable_bytes_view& view) noexcept
-        : bytes_view(view.data(), view.size()) {}
+    basic_bytes_view(  // NOLINT(google-explicit-constructor, hicpp-explicit-conversions)
+        const basic_mutable_bytes_view<size_type>& view) noexcept
+        : basic_bytes_view(view.data(), view.size()) {}
 
     /*!
      * \brief Get the pointer to the data.
@@ -102,9 +114,7 @@ public:
      *
      * \return Size of the data.
      */
-    [[nodiscard]] constexpr shm_stream_size_t size() const noexcept {
-        return size_;
-    }
+    [[nodiscard]] constexpr size_type size() const noexcept { return size_; }
 
     /*!
      * \brief Check whether this buffer is empty.
@@ -119,7 +129,27 @@ private:
     const char* data_;
 
     //! Size of the data.
-    shm_stream_size_t size_;
+    size_type size_;
 };
 
+/*!
+ * \brief Class of views of non-constant byte sequences.
+ */
+using mutable_bytes_view = basic_mutable_bytes_view<shm_stream_size_t>;
+
+/*!
+ * \brief Class of views of constant byte sequences.
+ */
+using bytes_view = basic_bytes_view<shm_stream_size_t>;
+
+/*!
+ * \brief Class of views of non-constant byte sequences with 64-bit sizes.
+ */
+using mutable_bytes_view64 = basic_mutable_bytes_view<shm_stream_size64_t>;
+
+/*!
+ * \brief Class of views of constant byte sequences with 64-bit sizes.
+ */
+using bytes_view64 = basic_bytes_view<shm_stream_size64_t>;
+
 }  // namespace shm_stream
@@ -0,0 +1,79 @@
+/*
+ * Copyright 2023 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Definition of C interface of anonymous streams of bytes.
+ */
+#pragma once
+
+#include "shm_stream/c_interface/common_types.h"
+#include "shm_stream/c_interface/error_codes.h"
+#include "shm_stream/details/shm_stream_export.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*!
+ * \brief Create an anonymous stream of bytes.
+ *
+ * \param[out] fd File descriptor of the memory of the stream.
+ * \param[in] buffer_size Size of the buffer.
+ * \return Error code.
+ *
+ * \note Anonymous streams have no name, so they are opened using the file
+ * descriptor. The stream is removed when all file descriptors are closed and
+ * all writers and readers are destroyed.
+ * \note This function is supported only on Linux.
+ */
+SHM_STREAM_EXPORT c_shm_stream_error_code_t
+c_shm_stream_anonymous_stream_create(int* fd, c_shm_stream_size_t buffer_size);
+
+/*!
+ * \brief Close a file descriptor of an anonymous stream of bytes.
+ *
+ * \param[in] fd File descriptor.
+ *
+ * \note Writers and readers already created can be used after this
+ * function is called.
+ */
+SHM_STREAM_EXPORT void c_shm_stream_anonymous_stream_close(int fd);
+
+/*!
+ * \brief Send a file descriptor of an anonymous stream of bytes to another
+ * process via a Unix domain socket.
+ *
+ * \param[in] socket Socket.
+ * \param[in] fd File descriptor.
+ * \return Error code.
+ */
+SHM_STREAM_EXPORT c_shm_stream_error_code_t c_shm_stream_anonymous_stream_send(
+    int socket, int fd);
+
+/*!
+ * \brief Receive a file descriptor of an anonymous stream of bytes from
+ * another process via a Unix domain socket.
+ *
+ * \param[in] socket Socket.
+ * \param[out] fd File descriptor.
+ * \return Error code.
+ */
+SHM_STREAM_EXPORT c_shm_stream_error_code_t
+c_shm_stream_anonymous_stream_receive(int socket, int* fd);
+
+#ifdef __cplusplus
+}
+#endif
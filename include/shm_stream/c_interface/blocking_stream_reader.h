@@ -24,6 +24,7 @@
 #include "shm_stream/c_interface/common_types.h"
 #include "shm_stream/c_interface/error_codes.h"
 #include "shm_stream/c_interface/string_view.h"
+#include "shm_stream/c_interface/wait_policy.h"
 #include "shm_stream/details/shm_stream_export.h"
 
 #ifdef __cplusplus
@@ -54,6 +55,60 @@ c_shm_stream_blocking_stream_reader_create(
     c_shm_stream_blocking_stream_reader_t** reader,
     c_shm_stream_string_view_t name, c_shm_stream_size_t buffer_size);
 
+/*!
+ * \brief Create a reader of a blocking stream with a policy to wait.
+ *
+ * \param[out] reader Reader.
+ * \param[in] name Name of the stream.
+ * \param[in] buffer_size Size of the buffer.
+ * \param[in] policy Policy to wait.
+ * \return Error code.
+ */
+SHM_STREAM_EXPORT c_shm_stream_error_code_t
+c_shm_stream_blocking_stream_reader_create_with_wait_policy(
+    c_shm_stream_blocking_stream_reader_t** reader,
+    c_shm_stream_string_view_t name, c_shm_stream_size_t buffer_size,
+    c_shm_stream_wait_policy_t policy);
+
+/*!
+ * \brief Create a reader of a blocking stream of elements of a type.
+ *
+ * \param[out] reader Reader.
+ * \param[in] name Name of the stream.
+ * \param[in] buffer_size Size of the buffer.
+ * \param[in] element_type Fingerprint of the type of elements. (Must not be
+ * zero.)
+ * \param[in] element_size Size of each element.
+ * \param[in] policy Policy to wait.
+ * \return Error code.
+ *
+ * \note If the stream already exists with another type of elements, this
+ * function fails with c_shm_stream_error_code_type_mismatch.
+ */
+SHM_STREAM_EXPORT c_shm_stream_error_code_t
+c_shm_stream_blocking_stream_reader_create_typed(
+    c_shm_stream_blocking_stream_reader_t** reader,
+    c_shm_stream_string_view_t name, c_shm_stream_size_t buffer_size,
+    c_shm_stream_size64_t element_type, c_shm_stream_size_t element_size,
+    c_shm_stream_wait_policy_t policy);
+
+/*!
+ * \brief Create a reader of a blocking stream with options of memory.
+ *
+ * \param[out] reader Reader.
+ * \param[in] name Name of the stream.
+ * \param[in] buffer_size Size of the buffer.
+ * \param[in] policy Policy to wait.
+ * \param[in] options Options of memory. (Combination of
+ * c_shm_stream_memory_option values.)
+ * \return Error code.
+ */
+SHM_STREAM_EXPORT c_shm_stream_error_code_t
+c_shm_stream_blocking_stream_reader_create_with_memory_options(
+    c_shm_stream_blocking_stream_reader_t** reader,
+    c_shm_stream_string_view_t name, c_shm_stream_size_t buffer_size,
+    c_shm_stream_wait_policy_t policy, c_shm_stream_memory_options_t options);
+
 /*!
  * \brief Destroy a reader of a blocking stream.
  *
@@ -74,6 +129,32 @@ SHM_STREAM_EXPORT c_shm_stream_size_t
 c_shm_stream_blocking_stream_reader_available_size(
     c_shm_stream_blocking_stream_reader_t* reader);
 
+/*!
+ * \brief Get the size of pages backing the buffer of the stream.
+ *
+ * \param[in] reader Reader.
+ * \return Size of pages actually used by the operating system. (Zero for
+ * invalid readers.)
+ *
+ * \note This function is useful to check whether huge pages are used with
+ * c_shm_stream_buffer_layout_huge_pages layout. Pages may be allocated at the
+ * first access, so call this function after some data are transferred.
+ */
+SHM_STREAM_EXPORT c_shm_stream_size_t
+c_shm_stream_blocking_stream_reader_page_size(
+    c_shm_stream_blocking_stream_reader_t* reader);
+
+/*!
+ * \brief Get the NUMA node on which pages of the stream are.
+ *
+ * \param[in] reader Reader.
+ * \return NUMA node having the most pages of the stream.
+ * (c_shm_stream_numa_node_none if unknown.)
+ */
+SHM_STREAM_EXPORT c_shm_stream_numa_node_t
+c_shm_stream_blocking_stream_reader_numa_node(
+    c_shm_stream_blocking_stream_reader_t* reader);
+
 /*!
  * \brief Wait until some bytes are available.
  *
@@ -190,6 +271,93 @@ SHM_STREAM_EXPORT void c_shm_stream_blocking_stream_reader_commit(
     c_shm_stream_blocking_stream_reader_t* reader,
     c_shm_stream_size_t read_size);
 
+/*!
+ * \brief Wait to read bytes scattering into pieces at once.
+ *
+ * \param[in] reader Reader.
+ * \param[in] pieces Pieces of buffers to fill in order.
+ * \param[in] num_pieces Number of the pieces.
+ * \retval true All pieces were filled.
+ * \retval false This stream was stopped, or the pieces can never
+ * be filled from the buffer. (No byte is read.)
+ *
+ * \note This function waits until bytes for all pieces are available, copies
+ * them from one reservation wrapping around the end of the circular buffer,
+ * and commits them at once.
+ */
+SHM_STREAM_EXPORT bool c_shm_stream_blocking_stream_reader_wait_read_scatter(
+    c_shm_stream_blocking_stream_reader_t* reader,
+    const c_shm_stream_mutable_bytes_view_t* pieces,
+    c_shm_stream_size_t num_pieces);
+
+/*!
+ * \brief Read bytes filling a buffer waiting for bytes.
+ *
+ * \param[in] reader Reader.
+ * \param[in] buffer Buffer to fill.
+ * \retval true The buffer was filled.
+ * \retval false This stream was stopped before the buffer was
+ * filled.
+ *
+ * \note Unlike the function to write all bytes in the writer, this function
+ * copies bytes without non-temporal stores, because the bytes are used by the
+ * reader soon.
+ * \note Buffers larger than the buffer of this stream are filled in parts.
+ */
+SHM_STREAM_EXPORT bool c_shm_stream_blocking_stream_reader_read_exact(
+    c_shm_stream_blocking_stream_reader_t* reader,
+    c_shm_stream_mutable_bytes_view_t buffer);
+
+/*!
+ * \brief Set a doorbell to be notified of commits of the writer.
+ *
+ * \param[in] reader Reader.
+ * \param[in] fd File descriptor of the doorbell created by
+ * c_shm_stream_doorbell_create function. (Duplicated in this function.
+ * Negative value to remove the doorbell.)
+ * \return Error code.
+ */
+SHM_STREAM_EXPORT c_shm_stream_error_code_t
+c_shm_stream_blocking_stream_reader_set_doorbell(
+    c_shm_stream_blocking_stream_reader_t* reader, int fd);
+
+/*!
+ * \brief Arm the doorbell before waiting for it.
+ *
+ * \param[in] reader Reader.
+ * \retval true Doorbell is armed. Wait for the file descriptor of the
+ * doorbell to be readable (using poll, epoll, or other event loops), then
+ * read bytes and call this function again.
+ * \retval false Some bytes are available or the stream is stopped, so the
+ * doorbell is not armed.
+ *
+ * \note The doorbell must be set to both the writer and this reader.
+ */
+SHM_STREAM_EXPORT bool c_shm_stream_blocking_stream_reader_arm_doorbell(
+    c_shm_stream_blocking_stream_reader_t* reader);
+
+/*!
+ * \brief Wait until any of readers can read some bytes.
+ *
+ * \param[in] readers Readers.
+ * \param[in] num_readers Number of readers.
+ * \param[in] timeout_nanoseconds Timeout in nanoseconds. (Negative value for
+ * no timeout.)
+ * \param[out] ready_indices Buffer to write indices of ready readers in
+ * ascending order. (At least num_readers elements.)
+ * \return Number of ready readers. (Zero on timeout.)
+ *
+ * \note Readers of stopped streams and null readers are treated as ready.
+ * \note On Linux, this function uses futex_waitv system call to wait for
+ * readers at once, and falls back to checking readers periodically when the
+ * system call is not available.
+ */
+SHM_STREAM_EXPORT c_shm_stream_size_t
+c_shm_stream_blocking_stream_reader_wait_any(
+    c_shm_stream_blocking_stream_reader_t* const* readers,
+    c_shm_stream_size_t num_readers, int64_t timeout_nanoseconds,
+    c_shm_stream_size_t* ready_indices);
+
 #ifdef __cplusplus
 }
 #endif
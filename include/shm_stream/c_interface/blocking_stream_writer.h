@@ -24,6 +24,7 @@
 #include "shm_stream/c_interface/common_types.h"
 #include "shm_stream/c_interface/error_codes.h"
 #include "shm_stream/c_interface/string_view.h"
+#include "shm_stream/c_interface/wait_policy.h"
 #include "shm_stream/details/shm_stream_export.h"
 
 #ifdef __cplusplus
@@ -54,6 +55,60 @@ c_shm_stream_blocking_stream_writer_create(
     c_shm_stream_blocking_stream_writer_t** writer,
     c_shm_stream_string_view_t name, c_shm_stream_size_t buffer_size);
 
+/*!
+ * \brief Create a writer of a blocking stream with a policy to wait.
+ *
+ * \param[out] writer Writer.
+ * \param[in] name Name of the stream.
+ * \param[in] buffer_size Size of the buffer.
+ * \param[in] policy Policy to wait.
+ * \return Error code.
+ */
+SHM_STREAM_EXPORT c_shm_stream_error_code_t
+c_shm_stream_blocking_stream_writer_create_with_wait_policy(
+    c_shm_stream_blocking_stream_writer_t** writer,
+    c_shm_stream_string_view_t name, c_shm_stream_size_t buffer_size,
+    c_shm_stream_wait_policy_t policy);
+
+/*!
+ * \brief Create a writer of a blocking stream of elements of a type.
+ *
+ * \param[out] writer Writer.
+ * \param[in] name Name of the stream.
+ * \param[in] buffer_size Size of the buffer.
+ * \param[in] element_type Fingerprint of the type of elements. (Must not be
+ * zero.)
+ * \param[in] element_size Size of each element.
+ * \param[in] policy Policy to wait.
+ * \return Error code.
+ *
+ * \note If the stream already exists with another type of elements, this
+ * function fails with c_shm_stream_error_code_type_mismatch.
+ */
+SHM_STREAM_EXPORT c_shm_stream_error_code_t
+c_shm_stream_blocking_stream_writer_create_typed(
+    c_shm_stream_blocking_stream_writer_t** writer,
+    c_shm_stream_string_view_t name, c_shm_stream_size_t buffer_size,
+    c_shm_stream_size64_t element_type, c_shm_stream_size_t element_size,
+    c_shm_stream_wait_policy_t policy);
+
+/*!
+ * \brief Create a writer of a blocking stream with options of memory.
+ *
+ * \param[out] writer Writer.
+ * \param[in] name Name of the stream.
+ * \param[in] buffer_size Size of the buffer.
+ * \param[in] policy Policy to wait.
+ * \param[in] options Options of memory. (Combination of
+ * c_shm_stream_memory_option values.)
+ * \return Error code.
+ */
+SHM_STREAM_EXPORT c_shm_stream_error_code_t
+c_shm_stream_blocking_stream_writer_create_with_memory_options(
+    c_shm_stream_blocking_stream_writer_t** writer,
+    c_shm_stream_string_view_t name, c_shm_stream_size_t buffer_size,
+    c_shm_stream_wait_policy_t policy, c_shm_stream_memory_options_t options);
+
 /*!
  * \brief Destroy a writer of a blocking stream.
  *
@@ -74,6 +129,32 @@ SHM_STREAM_EXPORT c_shm_stream_size_t
 c_shm_stream_blocking_stream_writer_available_size(
     c_shm_stream_blocking_stream_writer_t* writer);
 
+/*!
+ * \brief Get the size of pages backing the buffer of the stream.
+ *
+ * \param[in] writer Writer.
+ * \return Size of pages actually used by the operating system. (Zero for
+ * invalid writers.)
+ *
+ * \note This function is useful to check whether huge pages are used with
+ * c_shm_stream_buffer_layout_huge_pages layout. Pages may be allocated at the
+ * first access, so call this function after some data are transferred.
+ */
+SHM_STREAM_EXPORT c_shm_stream_size_t
+c_shm_stream_blocking_stream_writer_page_size(
+    c_shm_stream_blocking_stream_writer_t* writer);
+
+/*!
+ * \brief Get the NUMA node on which pages of the stream are.
+ *
+ * \param[in] writer Writer.
+ * \return NUMA node having the most pages of the stream.
+ * (c_shm_stream_numa_node_none if unknown.)
+ */
+SHM_STREAM_EXPORT c_shm_stream_numa_node_t
+c_shm_stream_blocking_stream_writer_numa_node(
+    c_shm_stream_blocking_stream_writer_t* writer);
+
 /*!
  * \brief Wait until some bytes are available.
  *
@@ -189,6 +270,57 @@ SHM_STREAM_EXPORT void c_shm_stream_blocking_stream_writer_commit(
     c_shm_stream_blocking_stream_writer_t* writer,
     c_shm_stream_size_t written_size);
 
+/*!
+ * \brief Wait to write bytes gathered from pieces at once.
+ *
+ * \param[in] writer Writer.
+ * \param[in] pieces Pieces of bytes to write in order.
+ * \param[in] num_pieces Number of the pieces.
+ * \retval true All pieces were written.
+ * \retval false This stream was stopped, or the pieces can never
+ * fit in the buffer. (No byte is written.)
+ *
+ * \note This function waits until space for all pieces is available, copies
+ * them into one reservation wrapping around the end of the circular buffer,
+ * and commits them at once.
+ */
+SHM_STREAM_EXPORT bool c_shm_stream_blocking_stream_writer_wait_write_gather(
+    c_shm_stream_blocking_stream_writer_t* writer,
+    const c_shm_stream_bytes_view_t* pieces, c_shm_stream_size_t num_pieces);
+
+/*!
+ * \brief Write all bytes in a byte sequence waiting for space.
+ *
+ * \param[in] writer Writer.
+ * \param[in] data Bytes to write.
+ * \retval true All bytes were written.
+ * \retval false This stream was stopped before all bytes were
+ * written.
+ *
+ * \note This function copies bytes with non-temporal stores for large byte
+ * sequences so that the bytes do not evict the cache of the writer.
+ * \note Byte sequences larger than the buffer are written in parts.
+ */
+SHM_STREAM_EXPORT bool c_shm_stream_blocking_stream_writer_write_all(
+    c_shm_stream_blocking_stream_writer_t* writer,
+    c_shm_stream_bytes_view_t data);
+
+/*!
+ * \brief Set a doorbell to ring when a reader armed it.
+ *
+ * \param[in] writer Writer.
+ * \param[in] fd File descriptor of the doorbell created by
+ * c_shm_stream_doorbell_create function. (Duplicated in this function.
+ * Negative value to remove the doorbell.)
+ * \return Error code.
+ *
+ * \note After a doorbell is set, functions to commit bytes ring the doorbell
+ * only when a reader armed it.
+ */
+SHM_STREAM_EXPORT c_shm_stream_error_code_t
+c_shm_stream_blocking_stream_writer_set_doorbell(
+    c_shm_stream_blocking_stream_writer_t* writer, int fd);
+
 #ifdef __cplusplus
 }
 #endif
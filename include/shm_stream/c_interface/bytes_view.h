@@ -58,6 +58,39 @@ struct c_shm_stream_mutable_bytes_view {
 typedef struct c_shm_stream_mutable_bytes_view
     c_shm_stream_mutable_bytes_view_t;
 
+/*!
+ * \brief Struct of views of constant byte sequences with 64-bit sizes.
+ */
+struct c_shm_stream_bytes_view64 {
+    //! Pointer to data.
+    const char* data;
+
+    //! Size of data.
+    c_shm_stream_size64_t size;
+};
+
+/*!
+ * \brief Struct of views of constant byte sequences with 64-bit sizes.
+ */
+typedef struct c_shm_stream_bytes_view64 c_shm_stream_bytes_view64_t;
+
+/*!
+ * \brief Struct of views of non-constant byte sequences with 64-bit sizes.
+ */
+struct c_shm_stream_mutable_bytes_view64 {
+    //! Pointer to data.
+    char* data;
+
+    //! Size of data.
+    c_shm_stream_size64_t size;
+};
+
+/*!
+ * \brief Struct of views of non-constant byte sequences with 64-bit sizes.
+ */
+typedef struct c_shm_stream_mutable_bytes_view64
+    c_shm_stream_mutable_bytes_view64_t;
+
 #ifdef __cplusplus
 }
 #endif
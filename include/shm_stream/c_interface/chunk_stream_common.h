@@ -0,0 +1,54 @@
+/*
+ * Copyright 2023 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Definition of C interface of streams passing descriptors of chunks
+ * in shared memory.
+ */
+#pragma once
+
+#include "shm_stream/c_interface/common_types.h"
+#include "shm_stream/c_interface/error_codes.h"
+#include "shm_stream/c_interface/string_view.h"
+#include "shm_stream/details/shm_stream_export.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*!
+ * \brief Create a stream of chunks.
+ *
+ * \param[in] name Name of the stream.
+ * \param[in] num_chunks Number of chunks in the pool.
+ * \param[in] chunk_size Size of each chunk.
+ * \return Error code.
+ */
+SHM_STREAM_EXPORT c_shm_stream_error_code_t c_shm_stream_chunk_stream_create(
+    c_shm_stream_string_view_t name, c_shm_stream_size_t num_chunks,
+    c_shm_stream_size_t chunk_size);
+
+/*!
+ * \brief Remove a stream of chunks.
+ *
+ * \param[in] name Name of the stream.
+ */
+SHM_STREAM_EXPORT void c_shm_stream_chunk_stream_remove(
+    c_shm_stream_string_view_t name);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,97 @@
+/*
+ * Copyright 2023 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Definition of C interface of readers of streams passing descriptors
+ * of chunks in shared memory.
+ */
+#pragma once
+
+#include "shm_stream/c_interface/bytes_view.h"
+#include "shm_stream/c_interface/common_types.h"
+#include "shm_stream/c_interface/error_codes.h"
+#include "shm_stream/c_interface/string_view.h"
+#include "shm_stream/details/shm_stream_export.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*!
+ * \brief Reader of streams of chunks.
+ */
+struct c_shm_stream_chunk_stream_reader;
+
+/*!
+ * \brief Reader of streams of chunks.
+ */
+typedef struct c_shm_stream_chunk_stream_reader
+    c_shm_stream_chunk_stream_reader_t;
+
+/*!
+ * \brief Create a reader of a stream of chunks.
+ *
+ * \param[out] reader Reader.
+ * \param[in] name Name of the stream.
+ * \param[in] num_chunks Number of chunks in the pool.
+ * \param[in] chunk_size Size of each chunk.
+ * \return Error code.
+ *
+ * \note If the stream already exists, the parameters of the existing stream
+ * are used.
+ */
+SHM_STREAM_EXPORT c_shm_stream_error_code_t
+c_shm_stream_chunk_stream_reader_create(
+    c_shm_stream_chunk_stream_reader_t** reader,
+    c_shm_stream_string_view_t name, c_shm_stream_size_t num_chunks,
+    c_shm_stream_size_t chunk_size);
+
+/*!
+ * \brief Destroy a reader of a stream of chunks.
+ *
+ * \param[in] reader Reader.
+ */
+SHM_STREAM_EXPORT void c_shm_stream_chunk_stream_reader_destroy(
+    c_shm_stream_chunk_stream_reader_t* reader);
+
+/*!
+ * \brief Try to receive a chunk.
+ *
+ * \param[in] reader Reader.
+ * \return Buffer of the bytes written to the chunk. If no chunk has been sent,
+ * the data pointer of the buffer is null.
+ *
+ * \note The chunk must be returned to the writer by
+ * c_shm_stream_chunk_stream_reader_release function after reading it.
+ */
+SHM_STREAM_EXPORT c_shm_stream_bytes_view_t
+c_shm_stream_chunk_stream_reader_try_receive(
+    c_shm_stream_chunk_stream_reader_t* reader);
+
+/*!
+ * \brief Return a chunk to the writer.
+ *
+ * \param[in] reader Reader.
+ * \param[in] chunk Buffer of the chunk returned by
+ * c_shm_stream_chunk_stream_reader_try_receive function.
+ */
+SHM_STREAM_EXPORT void c_shm_stream_chunk_stream_reader_release(
+    c_shm_stream_chunk_stream_reader_t* reader,
+    c_shm_stream_bytes_view_t chunk);
+
+#ifdef __cplusplus
+}
+#endif
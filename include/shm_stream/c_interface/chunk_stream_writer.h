@@ -0,0 +1,108 @@
+/*
+ * Copyright 2023 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Definition of C interface of writers of streams passing descriptors
+ * of chunks in shared memory.
+ */
+#pragma once
+
+#include "shm_stream/c_interface/bytes_view.h"
+#include "shm_stream/c_interface/common_types.h"
+#include "shm_stream/c_interface/error_codes.h"
+#include "shm_stream/c_interface/string_view.h"
+#include "shm_stream/details/shm_stream_export.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*!
+ * \brief Writer of streams of chunks.
+ */
+struct c_shm_stream_chunk_stream_writer;
+
+/*!
+ * \brief Writer of streams of chunks.
+ */
+typedef struct c_shm_stream_chunk_stream_writer
+    c_shm_stream_chunk_stream_writer_t;
+
+/*!
+ * \brief Create a writer of a stream of chunks.
+ *
+ * \param[out] writer Writer.
+ * \param[in] name Name of the stream.
+ * \param[in] num_chunks Number of chunks in the pool.
+ * \param[in] chunk_size Size of each chunk.
+ * \return Error code.
+ *
+ * \note If the stream already exists, the parameters of the existing stream
+ * are used.
+ */
+SHM_STREAM_EXPORT c_shm_stream_error_code_t
+c_shm_stream_chunk_stream_writer_create(
+    c_shm_stream_chunk_stream_writer_t** writer,
+    c_shm_stream_string_view_t name, c_shm_stream_size_t num_chunks,
+    c_shm_stream_size_t chunk_size);
+
+/*!
+ * \brief Destroy a writer of a stream of chunks.
+ *
+ * \param[in] writer Writer.
+ */
+SHM_STREAM_EXPORT void c_shm_stream_chunk_stream_writer_destroy(
+    c_shm_stream_chunk_stream_writer_t* writer);
+
+/*!
+ * \brief Get the size of each chunk.
+ *
+ * \param[in] writer Writer.
+ * \return Number of bytes.
+ */
+SHM_STREAM_EXPORT c_shm_stream_size_t
+c_shm_stream_chunk_stream_writer_chunk_size(
+    c_shm_stream_chunk_stream_writer_t* writer);
+
+/*!
+ * \brief Try to allocate a chunk to write.
+ *
+ * \param[in] writer Writer.
+ * \return Buffer of the chunk. If no chunk is free now, the data pointer of
+ * the buffer is null.
+ */
+SHM_STREAM_EXPORT c_shm_stream_mutable_bytes_view_t
+c_shm_stream_chunk_stream_writer_try_allocate(
+    c_shm_stream_chunk_stream_writer_t* writer);
+
+/*!
+ * \brief Send a chunk to the reader.
+ *
+ * \param[in] writer Writer.
+ * \param[in] chunk Buffer of the chunk returned by
+ * c_shm_stream_chunk_stream_writer_try_allocate function.
+ * \param[in] size Number of bytes written to the chunk.
+ *
+ * \note Only the descriptor of the chunk is sent, and the bytes in the chunk
+ * are never copied.
+ */
+SHM_STREAM_EXPORT void c_shm_stream_chunk_stream_writer_send(
+    c_shm_stream_chunk_stream_writer_t* writer,
+    c_shm_stream_mutable_bytes_view_t chunk, c_shm_stream_size_t size);
+
+#ifdef __cplusplus
+}
+#endif
@@ -33,6 +33,102 @@ extern "C" {
  */
 typedef uint32_t c_shm_stream_size_t;
 
+/*!
+ * \brief Type of sizes used in streams with 64-bit indices.
+ */
+typedef uint64_t c_shm_stream_size64_t;
+
+/*!
+ * \brief Enumeration of layouts of buffers in shared memory.
+ */
+enum c_shm_stream_buffer_layout {
+    //! Buffer mapped once to the virtual memory.
+    c_shm_stream_buffer_layout_plain = 0,
+
+    /*!
+     * \brief Buffer mapped twice back-to-back to the virtual memory.
+     *
+     * With this layout, any continuous byte sequence up to the available size
+     * can be reserved at once, even if it crosses the end of the circular
+     * buffer. The size of the buffer must be a multiple of the page size.
+     */
+    c_shm_stream_buffer_layout_mirrored = 1,
+
+    /*!
+     * \brief Buffer mapped once to the virtual memory aligned to huge pages.
+     *
+     * With this layout, the memory is rounded up to a multiple of the huge
+     * page size (2 MiB). If hugetlbfs with pages of this size is mounted and
+     * has free pages, the stream is placed in a file of hugetlbfs. Otherwise,
+     * the shared memory is mapped at an address aligned to huge pages, and the
+     * operating system is advised to back it with transparent huge pages.
+     * When huge pages are unavailable, normal pages are used instead. The page
+     * size actually used can be queried from writers and readers.
+     */
+    c_shm_stream_buffer_layout_huge_pages = 2
+};
+
+/*!
+ * \brief Enumeration of layouts of buffers in shared memory.
+ */
+typedef enum c_shm_stream_buffer_layout c_shm_stream_buffer_layout_t;
+
+/*!
+ * \brief Enumeration of options of memory of streams.
+ *
+ * Values can be combined using bitwise OR.
+ */
+enum c_shm_stream_memory_option {
+    //! No option.
+    c_shm_stream_memory_option_none = 0,
+
+    /*!
+     * \brief Pre-fault all pages of the mapped region when opening a stream.
+     *
+     * This avoids page faults in the first pass over the buffer.
+     */
+    c_shm_stream_memory_option_prefault = 1,
+
+    /*!
+     * \brief Lock all pages of the mapped region in physical memory when
+     * opening a stream.
+     *
+     * This requires a limit of locked memory (RLIMIT_MEMLOCK in Linux) of at
+     * least the size of the mapped region in addition to memory already
+     * locked by the process, unless the process is privileged
+     * (CAP_IPC_LOCK in Linux). If pages cannot be locked, opening the stream
+     * fails, and a stream created in the attempt is removed.
+     */
+    c_shm_stream_memory_option_lock = 2
+};
+
+/*!
+ * \brief Type of combinations of c_shm_stream_memory_option values.
+ */
+typedef uint32_t c_shm_stream_memory_options_t;
+
+/*!
+ * \brief Type of indices of NUMA nodes.
+ */
+typedef int32_t c_shm_stream_numa_node_t;
+
+/*!
+ * \brief Enumeration of special values of c_shm_stream_numa_node_t.
+ */
+enum c_shm_stream_numa_node_special {
+    /*!
+     * \brief No NUMA node.
+     *
+     * When creating streams, the operating system places pages as usual
+     * (typically on the node which first touches them). When querying
+     * streams, the node is unknown.
+     */
+    c_shm_stream_numa_node_none = -1,
+
+    //! NUMA node of the CPU running the calling thread.
+    c_shm_stream_numa_node_current = -2
+};
+
 #ifdef __cplusplus
 }
 #endif
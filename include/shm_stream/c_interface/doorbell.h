@@ -0,0 +1,77 @@
+/*
+ * Copyright 2023 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Definition of C interface of doorbells.
+ */
+#pragma once
+
+#include "shm_stream/c_interface/error_codes.h"
+#include "shm_stream/details/shm_stream_export.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*!
+ * \brief Create a doorbell.
+ *
+ * \param[out] fd File descriptor of the doorbell.
+ * \return Error code.
+ *
+ * \note Doorbells notify readers of streams of commits of writers via file
+ * descriptors which can be waited using poll, epoll, or other event loops.
+ * Set the same doorbell to a writer and a reader of a stream.
+ * \note This function is supported only on Linux.
+ */
+SHM_STREAM_EXPORT c_shm_stream_error_code_t c_shm_stream_doorbell_create(
+    int* fd);
+
+/*!
+ * \brief Close a file descriptor of a doorbell.
+ *
+ * \param[in] fd File descriptor.
+ *
+ * \note Writers and readers which the doorbell is set to keep their own
+ * file descriptors, so this function can be called after the doorbell is set.
+ */
+SHM_STREAM_EXPORT void c_shm_stream_doorbell_close(int fd);
+
+/*!
+ * \brief Send a file descriptor of a doorbell to another process via a Unix
+ * domain socket.
+ *
+ * \param[in] socket Socket.
+ * \param[in] fd File descriptor.
+ * \return Error code.
+ */
+SHM_STREAM_EXPORT c_shm_stream_error_code_t c_shm_stream_doorbell_send(
+    int socket, int fd);
+
+/*!
+ * \brief Receive a file descriptor of a doorbell from another process via a
+ * Unix domain socket.
+ *
+ * \param[in] socket Socket.
+ * \param[out] fd File descriptor.
+ * \return Error code.
+ */
+SHM_STREAM_EXPORT c_shm_stream_error_code_t c_shm_stream_doorbell_receive(
+    int socket, int* fd);
+
+#ifdef __cplusplus
+}
+#endif
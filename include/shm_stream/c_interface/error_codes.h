@@ -39,7 +39,22 @@ enum c_shm_stream_error_code {
     c_shm_stream_error_code_failed_to_open,
 
     //! Internal error.
-    c_shm_stream_error_code_internal_error
+    c_shm_stream_error_code_internal_error,
+
+    //! Operation not supported in the current environment.
+    c_shm_stream_error_code_not_supported,
+
+    //! Too many readers attached to a stream.
+    c_shm_stream_error_code_too_many_readers,
+
+    //! Mismatched type of elements in a stream.
+    c_shm_stream_error_code_type_mismatch,
+
+    //! Failed to lock memory.
+    c_shm_stream_error_code_failed_to_lock_memory,
+
+    //! Failed to transfer a handle of a stream to another process.
+    c_shm_stream_error_code_failed_to_transfer
 };
 
 /*!
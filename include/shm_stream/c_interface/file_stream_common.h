@@ -0,0 +1,53 @@
+/*
+ * Copyright 2023 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Definition of C interface of file-backed streams of bytes.
+ */
+#pragma once
+
+#include "shm_stream/c_interface/common_types.h"
+#include "shm_stream/c_interface/error_codes.h"
+#include "shm_stream/c_interface/string_view.h"
+#include "shm_stream/details/shm_stream_export.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*!
+ * \brief Create a file-backed stream of bytes.
+ *
+ * \param[in] path Path of the file.
+ * \param[in] buffer_size Size of the buffer.
+ * \return Error code.
+ *
+ * \note If the file already exists, the stream in the file is used.
+ */
+SHM_STREAM_EXPORT c_shm_stream_error_code_t c_shm_stream_file_stream_create(
+    c_shm_stream_string_view_t path, c_shm_stream_size_t buffer_size);
+
+/*!
+ * \brief Remove a file-backed stream of bytes.
+ *
+ * \param[in] path Path of the file.
+ */
+SHM_STREAM_EXPORT void c_shm_stream_file_stream_remove(
+    c_shm_stream_string_view_t path);
+
+#ifdef __cplusplus
+}
+#endif
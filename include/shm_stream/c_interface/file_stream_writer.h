@@ -0,0 +1,159 @@
+/*
+ * Copyright 2023 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Definition of C interface of file-backed streams of bytes.
+ */
+#pragma once
+
+#include "shm_stream/c_interface/bytes_view.h"
+#include "shm_stream/c_interface/common_types.h"
+#include "shm_stream/c_interface/error_codes.h"
+#include "shm_stream/c_interface/flush_policy.h"
+#include "shm_stream/c_interface/string_view.h"
+#include "shm_stream/details/shm_stream_export.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*!
+ * \brief Writer of file-backed streams of bytes.
+ */
+struct c_shm_stream_file_stream_writer;
+
+/*!
+ * \brief Writer of file-backed streams of bytes.
+ */
+typedef struct c_shm_stream_file_stream_writer
+    c_shm_stream_file_stream_writer_t;
+
+/*!
+ * \brief Create a writer of a file-backed stream.
+ *
+ * \param[out] writer Writer.
+ * \param[in] path Path of the file.
+ * \param[in] buffer_size Size of the buffer.
+ * \param[in] policy Policy to flush.
+ * \return Error code.
+ *
+ * \note If the file already exists, the stream in the file is used, and bytes
+ * not read yet are kept.
+ */
+SHM_STREAM_EXPORT c_shm_stream_error_code_t
+c_shm_stream_file_stream_writer_create(
+    c_shm_stream_file_stream_writer_t** writer,
+    c_shm_stream_string_view_t path, c_shm_stream_size_t buffer_size,
+    c_shm_stream_flush_policy_t policy);
+
+/*!
+ * \brief Destroy a writer of a file-backed stream.
+ *
+ * \param[in] writer Writer.
+ *
+ * \note Bytes committed after the last flush are flushed here unless the mode
+ * of the policy is c_shm_stream_flush_mode_none.
+ */
+SHM_STREAM_EXPORT void c_shm_stream_file_stream_writer_destroy(
+    c_shm_stream_file_stream_writer_t* writer);
+
+/*!
+ * \brief Get the number of the available bytes to write.
+ *
+ * \param[in] writer Writer.
+ * \return Number of the available bytes to write.
+ */
+SHM_STREAM_EXPORT c_shm_stream_size_t
+c_shm_stream_file_stream_writer_available_size(
+    c_shm_stream_file_stream_writer_t* writer);
+
+/*!
+ * \brief Try to reserve some bytes to write.
+ *
+ * \param[in] writer Writer.
+ * \param[in] expected_size Expected number of bytes to reserve to write.
+ * \return Buffer of the reserved bytes.
+ *
+ * \note This function tries to reserve given number of bytes, but a smaller
+ * or empty buffer may be returned.
+ * \note This function can return a buffer with a size smaller than the
+ * return value of available_size function, because this stream uses a
+ * circular buffer in the implementation and this function reserves
+ * continuous byte sequences from the circular buffer.
+ */
+SHM_STREAM_EXPORT c_shm_stream_mutable_bytes_view_t
+c_shm_stream_file_stream_writer_try_reserve(
+    c_shm_stream_file_stream_writer_t* writer,
+    c_shm_stream_size_t expected_size);
+
+/*!
+ * \brief Try to reserve some bytes to write as many as possible.
+ *
+ * \param[in] writer Writer.
+ * \return Buffer of the reserved bytes.
+ *
+ * \note This function can return a buffer with a size smaller than the
+ * return value of available_size function, because this stream uses a
+ * circular buffer in the implementation and this function reserves
+ * continuous byte sequences from the circular buffer.
+ */
+SHM_STREAM_EXPORT c_shm_stream_mutable_bytes_view_t
+c_shm_stream_file_stream_writer_try_reserve_all(
+    c_shm_stream_file_stream_writer_t* writer);
+
+/*!
+ * \brief Commit written bytes.
+ *
+ * \param[in] writer Writer.
+ * \param[in] written_size Number of written bytes.
+ * \return Error code.
+ *
+ * \note Bytes are committed even if flushing according to the policy fails.
+ * \note With c_shm_stream_flush_mode_on_commit, the written bytes are flushed
+ * before the index of the writer, so the file never has an index pointing past
+ * bytes not flushed. Other modes give no guarantee of the order.
+ */
+SHM_STREAM_EXPORT c_shm_stream_error_code_t
+c_shm_stream_file_stream_writer_commit(
+    c_shm_stream_file_stream_writer_t* writer,
+    c_shm_stream_size_t written_size);
+
+/*!
+ * \brief Flush committed bytes to the file.
+ *
+ * \param[in] writer Writer.
+ * \return Error code.
+ */
+SHM_STREAM_EXPORT c_shm_stream_error_code_t
+c_shm_stream_file_stream_writer_flush(
+    c_shm_stream_file_stream_writer_t* writer);
+
+/*!
+ * \brief Get the number of flushes done by a writer.
+ *
+ * \param[in] writer Writer.
+ * \return Number of flushes.
+ *
+ * \note Flushes requested explicitly and flushes according to the policy are
+ * counted.
+ */
+SHM_STREAM_EXPORT c_shm_stream_size_t
+c_shm_stream_file_stream_writer_flush_count(
+    c_shm_stream_file_stream_writer_t* writer);
+
+#ifdef __cplusplus
+}
+#endif
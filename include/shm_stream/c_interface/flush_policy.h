@@ -0,0 +1,73 @@
+/*
+ * Copyright 2023 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Definition of c_shm_stream_flush_policy struct.
+ */
+#pragma once
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*!
+ * \brief Enumeration of modes to flush file-backed streams.
+ */
+enum c_shm_stream_flush_mode {
+    //! Flush only when requested explicitly.
+    c_shm_stream_flush_mode_none = 0,
+
+    /*!
+     * \brief Flush on commits if the interval has passed since the last flush.
+     *
+     * The interval is checked only on commits. Bytes committed after the
+     * last flush are flushed when the writer is destroyed.
+     */
+    c_shm_stream_flush_mode_periodic = 1,
+
+    //! Flush on every commit.
+    c_shm_stream_flush_mode_on_commit = 2
+};
+
+/*!
+ * \brief Enumeration of modes to flush file-backed streams.
+ */
+typedef enum c_shm_stream_flush_mode c_shm_stream_flush_mode_t;
+
+/*!
+ * \brief Struct of policies to flush file-backed streams.
+ *
+ * Flushing writes the modified pages of a stream to the file synchronously,
+ * so that written bytes survive crashes of the operating system.
+ */
+struct c_shm_stream_flush_policy {
+    //! Mode.
+    c_shm_stream_flush_mode_t mode;
+
+    //! Interval of flushes in milliseconds for periodic mode.
+    uint32_t interval_milliseconds;
+};
+
+/*!
+ * \brief Struct of policies to flush file-backed streams.
+ */
+typedef struct c_shm_stream_flush_policy c_shm_stream_flush_policy_t;
+
+#ifdef __cplusplus
+}
+#endif
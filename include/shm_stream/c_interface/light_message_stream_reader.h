@@ -0,0 +1,92 @@
+/*
+ * Copyright 2023 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Definition of C interface of readers of light streams of messages
+ * without waiting (possibly lock-free and wait-free).
+ */
+#pragma once
+
+#include "shm_stream/c_interface/bytes_view.h"
+#include "shm_stream/c_interface/common_types.h"
+#include "shm_stream/c_interface/error_codes.h"
+#include "shm_stream/c_interface/string_view.h"
+#include "shm_stream/details/shm_stream_export.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*!
+ * \brief Reader of light streams of messages without waiting (possibly
+ * lock-free and wait-free).
+ */
+struct c_shm_stream_light_message_stream_reader;
+
+/*!
+ * \brief Reader of light streams of messages without waiting (possibly
+ * lock-free and wait-free).
+ */
+typedef struct c_shm_stream_light_message_stream_reader
+    c_shm_stream_light_message_stream_reader_t;
+
+/*!
+ * \brief Create a reader of a light stream of messages.
+ *
+ * \param[out] reader Reader.
+ * \param[in] name Name of the stream.
+ * \param[in] buffer_size Size of the buffer.
+ * \return Error code.
+ */
+SHM_STREAM_EXPORT c_shm_stream_error_code_t
+c_shm_stream_light_message_stream_reader_create(
+    c_shm_stream_light_message_stream_reader_t** reader,
+    c_shm_stream_string_view_t name, c_shm_stream_size_t buffer_size);
+
+/*!
+ * \brief Destroy a reader of a light stream of messages.
+ *
+ * \param[in] reader Reader.
+ */
+SHM_STREAM_EXPORT void c_shm_stream_light_message_stream_reader_destroy(
+    c_shm_stream_light_message_stream_reader_t* reader);
+
+/*!
+ * \brief Try to get the next message.
+ *
+ * \param[in] reader Reader.
+ * \return Buffer of the message.
+ *
+ * \note If no message is available now, the data pointer of the returned
+ * buffer is null.
+ * \note This function returns the same message until
+ * c_shm_stream_light_message_stream_reader_commit function is called.
+ */
+SHM_STREAM_EXPORT c_shm_stream_bytes_view_t
+c_shm_stream_light_message_stream_reader_next(
+    c_shm_stream_light_message_stream_reader_t* reader);
+
+/*!
+ * \brief Set the current message as finished to read.
+ *
+ * \param[in] reader Reader.
+ */
+SHM_STREAM_EXPORT void c_shm_stream_light_message_stream_reader_commit(
+    c_shm_stream_light_message_stream_reader_t* reader);
+
+#ifdef __cplusplus
+}
+#endif
@@ -20,6 +20,8 @@
  */
 #pragma once
 
+#include <stdbool.h>
+
 #include "shm_stream/c_interface/common_types.h"
 #include "shm_stream/c_interface/error_codes.h"
 #include "shm_stream/c_interface/string_view.h"
@@ -29,6 +31,36 @@
 extern "C" {
 #endif
 
+/*!
+ * \brief Struct of the layout of a queue of a light stream mapped to the
+ * memory of this process.
+ *
+ * \note This struct is used to operate queues with inline functions in C++
+ * instead of calling functions in this library for each operation.
+ */
+typedef struct c_shm_stream_light_stream_queue_layout {
+    /*!
+     * \brief Atomic variables of the indices of the next bytes for the writer
+     * and the reader. (shm_stream::details::atomic_index_pair<> in C++.)
+     */
+    void* atomic_indices;
+
+    //! Buffer of data.
+    char* buffer;
+
+    //! Size of the buffer.
+    c_shm_stream_size_t buffer_size;
+
+    //! Whether the buffer is mirrored.
+    bool is_mirrored;
+
+    /*!
+     * \brief Atomic variable of whether the reader armed the doorbell.
+     * (boost::atomics::ipc_atomic<uint32_t> in C++.)
+     */
+    void* doorbell_armed;
+} c_shm_stream_light_stream_queue_layout_t;
+
 /*!
  * \brief Create a light stream of bytes without waiting.
  *
@@ -39,6 +71,59 @@ extern "C" {
 SHM_STREAM_EXPORT c_shm_stream_error_code_t c_shm_stream_light_stream_create(
     c_shm_stream_string_view_t name, c_shm_stream_size_t buffer_size);
 
+/*!
+ * \brief Create a light stream of bytes without waiting with a layout of the buffer.
+ *
+ * \param[in] name Name of the stream.
+ * \param[in] buffer_size Size of the buffer.
+ * \param[in] layout Layout of the buffer.
+ * \return Error code.
+ *
+ * \note If the stream already exists, the layout of the existing stream is
+ * used.
+ */
+SHM_STREAM_EXPORT c_shm_stream_error_code_t
+c_shm_stream_light_stream_create_with_layout(c_shm_stream_string_view_t name,
+    c_shm_stream_size_t buffer_size, c_shm_stream_buffer_layout_t layout);
+
+/*!
+ * \brief Create a light stream of bytes without waiting with pages bound to a
+ * NUMA node.
+ *
+ * \param[in] name Name of the stream.
+ * \param[in] buffer_size Size of the buffer.
+ * \param[in] layout Layout of the buffer.
+ * \param[in] numa_node NUMA node. (c_shm_stream_numa_node_current for the
+ * node of the CPU running the calling thread.)
+ * \return Error code.
+ *
+ * \note If the stream already exists, the existing stream is used without
+ * changing the placement of its pages.
+ * \note If binding fails, the stream is not created.
+ */
+SHM_STREAM_EXPORT c_shm_stream_error_code_t
+c_shm_stream_light_stream_create_on_numa_node(
+    c_shm_stream_string_view_t name, c_shm_stream_size_t buffer_size,
+    c_shm_stream_buffer_layout_t layout, c_shm_stream_numa_node_t numa_node);
+
+/*!
+ * \brief Create a light stream of elements of a type.
+ *
+ * \param[in] name Name of the stream.
+ * \param[in] buffer_size Size of the buffer.
+ * \param[in] element_type Fingerprint of the type of elements. (Must not be
+ * zero.)
+ * \param[in] element_size Size of each element.
+ * \return Error code.
+ *
+ * \note If the stream already exists with another type of elements, this
+ * function fails with c_shm_stream_error_code_type_mismatch.
+ */
+SHM_STREAM_EXPORT c_shm_stream_error_code_t
+c_shm_stream_light_stream_create_typed(c_shm_stream_string_view_t name,
+    c_shm_stream_size_t buffer_size, c_shm_stream_size64_t element_type,
+    c_shm_stream_size_t element_size);
+
 /*!
  * \brief Remove a light stream of bytes without waiting.
  *
@@ -20,9 +20,12 @@
  */
 #pragma once
 
+#include <stdbool.h>
+
 #include "shm_stream/c_interface/bytes_view.h"
 #include "shm_stream/c_interface/common_types.h"
 #include "shm_stream/c_interface/error_codes.h"
+#include "shm_stream/c_interface/light_stream_common.h"
 #include "shm_stream/c_interface/string_view.h"
 #include "shm_stream/details/shm_stream_export.h"
 
@@ -56,6 +59,42 @@ c_shm_stream_light_stream_reader_create(
     c_shm_stream_light_stream_reader_t** reader,
     c_shm_stream_string_view_t name, c_shm_stream_size_t buffer_size);
 
+/*!
+ * \brief Create a reader of a light stream of elements of a type.
+ *
+ * \param[out] reader Reader.
+ * \param[in] name Name of the stream.
+ * \param[in] buffer_size Size of the buffer.
+ * \param[in] element_type Fingerprint of the type of elements. (Must not be
+ * zero.)
+ * \param[in] element_size Size of each element.
+ * \return Error code.
+ *
+ * \note If the stream already exists with another type of elements, this
+ * function fails with c_shm_stream_error_code_type_mismatch.
+ */
+SHM_STREAM_EXPORT c_shm_stream_error_code_t
+c_shm_stream_light_stream_reader_create_typed(
+    c_shm_stream_light_stream_reader_t** reader,
+    c_shm_stream_string_view_t name, c_shm_stream_size_t buffer_size,
+    c_shm_stream_size64_t element_type, c_shm_stream_size_t element_size);
+
+/*!
+ * \brief Create a reader of a light stream with options of memory.
+ *
+ * \param[out] reader Reader.
+ * \param[in] name Name of the stream.
+ * \param[in] buffer_size Size of the buffer.
+ * \param[in] options Options of memory. (Combination of
+ * c_shm_stream_memory_option values.)
+ * \return Error code.
+ */
+SHM_STREAM_EXPORT c_shm_stream_error_code_t
+c_shm_stream_light_stream_reader_create_with_memory_options(
+    c_shm_stream_light_stream_reader_t** reader,
+    c_shm_stream_string_view_t name, c_shm_stream_size_t buffer_size,
+    c_shm_stream_memory_options_t options);
+
 /*!
  * \brief Destroy a reader of a light stream.
  *
@@ -74,6 +113,32 @@ SHM_STREAM_EXPORT c_shm_stream_size_t
 c_shm_stream_light_stream_reader_available_size(
     c_shm_stream_light_stream_reader_t* reader);
 
+/*!
+ * \brief Get the size of pages backing the buffer of the stream.
+ *
+ * \param[in] reader Reader.
+ * \return Size of pages actually used by the operating system. (Zero for
+ * invalid readers.)
+ *
+ * \note This function is useful to check whether huge pages are used with
+ * c_shm_stream_buffer_layout_huge_pages layout. Pages may be allocated at the
+ * first access, so call this function after some data are transferred.
+ */
+SHM_STREAM_EXPORT c_shm_stream_size_t
+c_shm_stream_light_stream_reader_page_size(
+    c_shm_stream_light_stream_reader_t* reader);
+
+/*!
+ * \brief Get the NUMA node on which pages of the stream are.
+ *
+ * \param[in] reader Reader.
+ * \return NUMA node having the most pages of the stream.
+ * (c_shm_stream_numa_node_none if unknown.)
+ */
+SHM_STREAM_EXPORT c_shm_stream_numa_node_t
+c_shm_stream_light_stream_reader_numa_node(
+    c_shm_stream_light_stream_reader_t* reader);
+
 /*!
  * \brief Try to reserve some bytes to read.
  *
@@ -120,6 +185,84 @@ c_shm_stream_light_stream_reader_try_reserve_all(
 SHM_STREAM_EXPORT void c_shm_stream_light_stream_reader_commit(
     c_shm_stream_light_stream_reader_t* reader, c_shm_stream_size_t read_size);
 
+/*!
+ * \brief Try to read bytes scattering into pieces at once.
+ *
+ * \param[in] reader Reader.
+ * \param[in] pieces Pieces of buffers to fill in order.
+ * \param[in] num_pieces Number of the pieces.
+ * \retval true All pieces were filled.
+ * \retval false Bytes were not enough to fill all pieces. (No
+ * byte is read.)
+ *
+ * \note This function copies bytes into all pieces from one reservation,
+ * wrapping around the end of the circular buffer, and commits them at once.
+ */
+SHM_STREAM_EXPORT bool c_shm_stream_light_stream_reader_try_read_scatter(
+    c_shm_stream_light_stream_reader_t* reader,
+    const c_shm_stream_mutable_bytes_view_t* pieces,
+    c_shm_stream_size_t num_pieces);
+
+/*!
+ * \brief Try to read bytes filling a buffer.
+ *
+ * \param[in] reader Reader.
+ * \param[in] buffer Buffer to fill.
+ * \retval true The buffer was filled.
+ * \retval false Bytes were not enough to fill the buffer. (No
+ * byte is read.)
+ *
+ * \note Unlike the function to write all bytes in the writer, this function
+ * copies bytes without non-temporal stores, because the bytes are used by the
+ * reader soon.
+ */
+SHM_STREAM_EXPORT bool c_shm_stream_light_stream_reader_try_read_exact(
+    c_shm_stream_light_stream_reader_t* reader,
+    c_shm_stream_mutable_bytes_view_t buffer);
+
+/*!
+ * \brief Set a doorbell to be notified of commits of the writer.
+ *
+ * \param[in] reader Reader.
+ * \param[in] fd File descriptor of the doorbell created by
+ * c_shm_stream_doorbell_create function. (Duplicated in this function.
+ * Negative value to remove the doorbell.)
+ * \return Error code.
+ */
+SHM_STREAM_EXPORT c_shm_stream_error_code_t
+c_shm_stream_light_stream_reader_set_doorbell(
+    c_shm_stream_light_stream_reader_t* reader, int fd);
+
+/*!
+ * \brief Arm the doorbell before waiting for it.
+ *
+ * \param[in] reader Reader.
+ * \retval true Doorbell is armed. Wait for the file descriptor of the
+ * doorbell to be readable (using poll, epoll, or other event loops), then
+ * read bytes and call this function again.
+ * \retval false Some bytes are available, so the doorbell is not armed.
+ *
+ * \note The doorbell must be set to both the writer and this reader.
+ */
+SHM_STREAM_EXPORT bool c_shm_stream_light_stream_reader_arm_doorbell(
+    c_shm_stream_light_stream_reader_t* reader);
+
+/*!
+ * \brief Get the layout of the queue of a reader.
+ *
+ * \param[in] reader Reader.
+ * \param[out] layout Layout of the queue.
+ * \return Error code.
+ *
+ * \note The layout is valid until the reader is destroyed. While the queue is
+ * operated using the layout, functions to reserve, commit, and read bytes of
+ * the reader and doorbells of the reader must not be used.
+ */
+SHM_STREAM_EXPORT c_shm_stream_error_code_t
+c_shm_stream_light_stream_reader_queue_layout(
+    c_shm_stream_light_stream_reader_t* reader,
+    c_shm_stream_light_stream_queue_layout_t* layout);
+
 #ifdef __cplusplus
 }
 #endif
@@ -20,9 +20,12 @@
  */
 #pragma once
 
+#include <stdbool.h>
+
 #include "shm_stream/c_interface/bytes_view.h"
 #include "shm_stream/c_interface/common_types.h"
 #include "shm_stream/c_interface/error_codes.h"
+#include "shm_stream/c_interface/light_stream_common.h"
 #include "shm_stream/c_interface/string_view.h"
 #include "shm_stream/details/shm_stream_export.h"
 
@@ -56,6 +59,42 @@ c_shm_stream_light_stream_writer_create(
     c_shm_stream_light_stream_writer_t** writer,
     c_shm_stream_string_view_t name, c_shm_stream_size_t buffer_size);
 
+/*!
+ * \brief Create a writer of a light stream of elements of a type.
+ *
+ * \param[out] writer Writer.
+ * \param[in] name Name of the stream.
+ * \param[in] buffer_size Size of the buffer.
+ * \param[in] element_type Fingerprint of the type of elements. (Must not be
+ * zero.)
+ * \param[in] element_size Size of each element.
+ * \return Error code.
+ *
+ * \note If the stream already exists with another type of elements, this
+ * function fails with c_shm_stream_error_code_type_mismatch.
+ */
+SHM_STREAM_EXPORT c_shm_stream_error_code_t
+c_shm_stream_light_stream_writer_create_typed(
+    c_shm_stream_light_stream_writer_t** writer,
+    c_shm_stream_string_view_t name, c_shm_stream_size_t buffer_size,
+    c_shm_stream_size64_t element_type, c_shm_stream_size_t element_size);
+
+/*!
+ * \brief Create a writer of a light stream with options of memory.
+ *
+ * \param[out] writer Writer.
+ * \param[in] name Name of the stream.
+ * \param[in] buffer_size Size of the buffer.
+ * \param[in] options Options of memory. (Combination of
+ * c_shm_stream_memory_option values.)
+ * \return Error code.
+ */
+SHM_STREAM_EXPORT c_shm_stream_error_code_t
+c_shm_stream_light_stream_writer_create_with_memory_options(
+    c_shm_stream_light_stream_writer_t** writer,
+    c_shm_stream_string_view_t name, c_shm_stream_size_t buffer_size,
+    c_shm_stream_memory_options_t options);
+
 /*!
  * \brief Destroy a writer of a light stream.
  *
@@ -74,6 +113,32 @@ SHM_STREAM_EXPORT c_shm_stream_size_t
 c_shm_stream_light_stream_writer_available_size(
     c_shm_stream_light_stream_writer_t* writer);
 
+/*!
+ * \brief Get the size of pages backing the buffer of the stream.
+ *
+ * \param[in] writer Writer.
+ * \return Size of pages actually used by the operating system. (Zero for
+ * invalid writers.)
+ *
+ * \note This function is useful to check whether huge pages are used with
+ * c_shm_stream_buffer_layout_huge_pages layout. Pages may be allocated at the
+ * first access, so call this function after some data are transferred.
+ */
+SHM_STREAM_EXPORT c_shm_stream_size_t
+c_shm_stream_light_stream_writer_page_size(
+    c_shm_stream_light_stream_writer_t* writer);
+
+/*!
+ * \brief Get the NUMA node on which pages of the stream are.
+ *
+ * \param[in] writer Writer.
+ * \return NUMA node having the most pages of the stream.
+ * (c_shm_stream_numa_node_none if unknown.)
+ */
+SHM_STREAM_EXPORT c_shm_stream_numa_node_t
+c_shm_stream_light_stream_writer_numa_node(
+    c_shm_stream_light_stream_writer_t* writer);
+
 /*!
  * \brief Try to reserve some bytes to write.
  *
@@ -120,6 +185,81 @@ SHM_STREAM_EXPORT void c_shm_stream_light_stream_writer_commit(
     c_shm_stream_light_stream_writer_t* writer,
     c_shm_stream_size_t written_size);
 
+/*!
+ * \brief Try to write bytes gathered from pieces at once.
+ *
+ * \param[in] writer Writer.
+ * \param[in] pieces Pieces of bytes to write in order.
+ * \param[in] num_pieces Number of the pieces.
+ * \retval true All pieces were written.
+ * \retval false Space was not enough to write all pieces. (No
+ * byte is written.)
+ *
+ * \note This function copies all pieces into one reservation, wrapping around
+ * the end of the circular buffer, and commits them at once.
+ */
+SHM_STREAM_EXPORT bool c_shm_stream_light_stream_writer_try_write_gather(
+    c_shm_stream_light_stream_writer_t* writer,
+    const c_shm_stream_bytes_view_t* pieces, c_shm_stream_size_t num_pieces);
+
+/*!
+ * \brief Try to write all bytes in a byte sequence.
+ *
+ * \param[in] writer Writer.
+ * \param[in] data Bytes to write.
+ * \retval true All bytes were written.
+ * \retval false Space was not enough to write all bytes. (No
+ * byte is written.)
+ *
+ * \note This function copies bytes with non-temporal stores for large byte
+ * sequences so that the bytes do not evict the cache of the writer.
+ */
+SHM_STREAM_EXPORT bool c_shm_stream_light_stream_writer_try_write_all(
+    c_shm_stream_light_stream_writer_t* writer, c_shm_stream_bytes_view_t data);
+
+/*!
+ * \brief Set a doorbell to ring when a reader armed it.
+ *
+ * \param[in] writer Writer.
+ * \param[in] fd File descriptor of the doorbell created by
+ * c_shm_stream_doorbell_create function. (Duplicated in this function.
+ * Negative value to remove the doorbell.)
+ * \return Error code.
+ *
+ * \note After a doorbell is set, functions to commit bytes ring the doorbell
+ * only when a reader armed it.
+ */
+SHM_STREAM_EXPORT c_shm_stream_error_code_t
+c_shm_stream_light_stream_writer_set_doorbell(
+    c_shm_stream_light_stream_writer_t* writer, int fd);
+
+/*!
+ * \brief Get the layout of the queue of a writer.
+ *
+ * \param[in] writer Writer.
+ * \param[out] layout Layout of the queue.
+ * \return Error code.
+ *
+ * \note The layout is valid until the writer is destroyed. While the queue is
+ * operated using the layout, functions to reserve, commit, and write bytes of
+ * the writer must not be used.
+ */
+SHM_STREAM_EXPORT c_shm_stream_error_code_t
+c_shm_stream_light_stream_writer_queue_layout(
+    c_shm_stream_light_stream_writer_t* writer,
+    c_shm_stream_light_stream_queue_layout_t* layout);
+
+/*!
+ * \brief Ring the doorbell if a reader armed it.
+ *
+ * \param[in] writer Writer.
+ *
+ * \note This function is used after commits of bytes to the queue operated
+ * using the layout of the queue.
+ */
+SHM_STREAM_EXPORT void c_shm_stream_light_stream_writer_ring_doorbell(
+    c_shm_stream_light_stream_writer_t* writer);
+
 #ifdef __cplusplus
 }
 #endif
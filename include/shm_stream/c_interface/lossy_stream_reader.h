@@ -0,0 +1,113 @@
+/*
+ * Copyright 2023 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Definition of C interface of readers of lossy streams of messages
+ * overwriting the oldest messages when full.
+ */
+#pragma once
+
+#include <stdbool.h>
+
+#include "shm_stream/c_interface/bytes_view.h"
+#include "shm_stream/c_interface/common_types.h"
+#include "shm_stream/c_interface/error_codes.h"
+#include "shm_stream/c_interface/string_view.h"
+#include "shm_stream/details/shm_stream_export.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*!
+ * \brief Reader of lossy streams of messages.
+ */
+struct c_shm_stream_lossy_stream_reader;
+
+/*!
+ * \brief Reader of lossy streams of messages.
+ */
+typedef struct c_shm_stream_lossy_stream_reader
+    c_shm_stream_lossy_stream_reader_t;
+
+/*!
+ * \brief Create a reader of a lossy stream.
+ *
+ * \param[out] reader Reader.
+ * \param[in] name Name of the stream.
+ * \param[in] num_records Number of records in the buffer. (Must be a power of
+ * two.)
+ * \param[in] max_message_size Maximum size of messages.
+ * \return Error code.
+ *
+ * \note The reader starts from the oldest message left in the stream.
+ * \note If the stream already exists, the parameters of the existing stream
+ * are used.
+ */
+SHM_STREAM_EXPORT c_shm_stream_error_code_t
+c_shm_stream_lossy_stream_reader_create(
+    c_shm_stream_lossy_stream_reader_t** reader,
+    c_shm_stream_string_view_t name, c_shm_stream_size_t num_records,
+    c_shm_stream_size_t max_message_size);
+
+/*!
+ * \brief Destroy a reader of a lossy stream.
+ *
+ * \param[in] reader Reader.
+ */
+SHM_STREAM_EXPORT void c_shm_stream_lossy_stream_reader_destroy(
+    c_shm_stream_lossy_stream_reader_t* reader);
+
+/*!
+ * \brief Try to get the next message.
+ *
+ * \param[in] reader Reader.
+ * \return Buffer of the message. If no message is completed now, the data
+ * pointer of the buffer is null.
+ *
+ * \note The message can be overwritten by the writer while reading it, so
+ * check the return value of c_shm_stream_lossy_stream_reader_commit function
+ * before using the data read from the message.
+ */
+SHM_STREAM_EXPORT c_shm_stream_bytes_view_t
+c_shm_stream_lossy_stream_reader_next(
+    c_shm_stream_lossy_stream_reader_t* reader);
+
+/*!
+ * \brief Finish reading the message returned by
+ * c_shm_stream_lossy_stream_reader_next function.
+ *
+ * \param[in] reader Reader.
+ * \retval true The message was read without being overwritten.
+ * \retval false The message was overwritten while reading it.
+ */
+SHM_STREAM_EXPORT bool c_shm_stream_lossy_stream_reader_commit(
+    c_shm_stream_lossy_stream_reader_t* reader);
+
+/*!
+ * \brief Get the number of messages lost because the writer overwrote them
+ * before the reader read them.
+ *
+ * \param[in] reader Reader.
+ * \return Number of messages.
+ */
+SHM_STREAM_EXPORT c_shm_stream_size64_t
+c_shm_stream_lossy_stream_reader_lost_messages(
+    c_shm_stream_lossy_stream_reader_t* reader);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,108 @@
+/*
+ * Copyright 2023 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Definition of C interface of writers of lossy streams of messages
+ * overwriting the oldest messages when full.
+ */
+#pragma once
+
+#include "shm_stream/c_interface/bytes_view.h"
+#include "shm_stream/c_interface/common_types.h"
+#include "shm_stream/c_interface/error_codes.h"
+#include "shm_stream/c_interface/string_view.h"
+#include "shm_stream/details/shm_stream_export.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*!
+ * \brief Writer of lossy streams of messages.
+ */
+struct c_shm_stream_lossy_stream_writer;
+
+/*!
+ * \brief Writer of lossy streams of messages.
+ */
+typedef struct c_shm_stream_lossy_stream_writer
+    c_shm_stream_lossy_stream_writer_t;
+
+/*!
+ * \brief Create a writer of a lossy stream.
+ *
+ * \param[out] writer Writer.
+ * \param[in] name Name of the stream.
+ * \param[in] num_records Number of records in the buffer. (Must be a power of
+ * two.)
+ * \param[in] max_message_size Maximum size of messages.
+ * \return Error code.
+ *
+ * \note If the stream already exists, the parameters of the existing stream
+ * are used.
+ */
+SHM_STREAM_EXPORT c_shm_stream_error_code_t
+c_shm_stream_lossy_stream_writer_create(
+    c_shm_stream_lossy_stream_writer_t** writer,
+    c_shm_stream_string_view_t name, c_shm_stream_size_t num_records,
+    c_shm_stream_size_t max_message_size);
+
+/*!
+ * \brief Destroy a writer of a lossy stream.
+ *
+ * \param[in] writer Writer.
+ */
+SHM_STREAM_EXPORT void c_shm_stream_lossy_stream_writer_destroy(
+    c_shm_stream_lossy_stream_writer_t* writer);
+
+/*!
+ * \brief Get the maximum size of messages.
+ *
+ * \param[in] writer Writer.
+ * \return Maximum number of bytes in a message.
+ */
+SHM_STREAM_EXPORT c_shm_stream_size_t
+c_shm_stream_lossy_stream_writer_max_message_size(
+    c_shm_stream_lossy_stream_writer_t* writer);
+
+/*!
+ * \brief Reserve a message to write.
+ *
+ * \param[in] writer Writer.
+ * \param[in] message_size Size of the message.
+ * \return Buffer of the message. If the size is larger than the maximum size
+ * of messages, the data pointer of the buffer is null.
+ *
+ * \note This function never waits for readers, and overwrites the oldest
+ * message in the stream.
+ */
+SHM_STREAM_EXPORT c_shm_stream_mutable_bytes_view_t
+c_shm_stream_lossy_stream_writer_reserve(
+    c_shm_stream_lossy_stream_writer_t* writer,
+    c_shm_stream_size_t message_size);
+
+/*!
+ * \brief Save the reserved message as completed and ready to be read by
+ * readers.
+ *
+ * \param[in] writer Writer.
+ */
+SHM_STREAM_EXPORT void c_shm_stream_lossy_stream_writer_commit(
+    c_shm_stream_lossy_stream_writer_t* writer);
+
+#ifdef __cplusplus
+}
+#endif
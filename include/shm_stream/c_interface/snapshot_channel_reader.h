@@ -0,0 +1,105 @@
+/*
+ * Copyright 2023 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Definition of C interface of readers of channels of the latest
+ * snapshots.
+ */
+#pragma once
+
+#include "shm_stream/c_interface/bytes_view.h"
+#include "shm_stream/c_interface/common_types.h"
+#include "shm_stream/c_interface/error_codes.h"
+#include "shm_stream/c_interface/string_view.h"
+#include "shm_stream/details/shm_stream_export.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*!
+ * \brief Reader of channels of the latest snapshots.
+ */
+struct c_shm_stream_snapshot_channel_reader;
+
+/*!
+ * \brief Reader of channels of the latest snapshots.
+ */
+typedef struct c_shm_stream_snapshot_channel_reader
+    c_shm_stream_snapshot_channel_reader_t;
+
+/*!
+ * \brief Create a reader of a snapshot channel.
+ *
+ * \param[out] reader Reader.
+ * \param[in] name Name of the channel.
+ * \param[in] max_size Maximum size of snapshots.
+ * \return Error code.
+ *
+ * \note If the channel already exists, the maximum size of the existing
+ * channel is used.
+ */
+SHM_STREAM_EXPORT c_shm_stream_error_code_t
+c_shm_stream_snapshot_channel_reader_create(
+    c_shm_stream_snapshot_channel_reader_t** reader,
+    c_shm_stream_string_view_t name, c_shm_stream_size_t max_size);
+
+/*!
+ * \brief Destroy a reader of a snapshot channel.
+ *
+ * \param[in] reader Reader.
+ */
+SHM_STREAM_EXPORT void c_shm_stream_snapshot_channel_reader_destroy(
+    c_shm_stream_snapshot_channel_reader_t* reader);
+
+/*!
+ * \brief Get the maximum size of snapshots.
+ *
+ * \param[in] reader Reader.
+ * \return Maximum number of bytes in a snapshot.
+ */
+SHM_STREAM_EXPORT c_shm_stream_size_t
+c_shm_stream_snapshot_channel_reader_max_size(
+    c_shm_stream_snapshot_channel_reader_t* reader);
+
+/*!
+ * \brief Get the version of the latest snapshot.
+ *
+ * \param[in] reader Reader.
+ * \return Version. (Zero if no snapshot has been published.)
+ */
+SHM_STREAM_EXPORT c_shm_stream_size64_t
+c_shm_stream_snapshot_channel_reader_version(
+    c_shm_stream_snapshot_channel_reader_t* reader);
+
+/*!
+ * \brief Copy the latest snapshot.
+ *
+ * \param[in] reader Reader.
+ * \param[out] buffer Buffer to copy the snapshot to. If the buffer is smaller
+ * than the snapshot, the snapshot is truncated.
+ * \param[out] size Size of the snapshot.
+ * \return Version of the copied snapshot. (Zero if no snapshot has been
+ * published.)
+ */
+SHM_STREAM_EXPORT c_shm_stream_size64_t
+c_shm_stream_snapshot_channel_reader_read(
+    c_shm_stream_snapshot_channel_reader_t* reader,
+    c_shm_stream_mutable_bytes_view_t buffer, c_shm_stream_size_t* size);
+
+#ifdef __cplusplus
+}
+#endif
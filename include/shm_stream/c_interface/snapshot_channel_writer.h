@@ -0,0 +1,114 @@
+/*
+ * Copyright 2023 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Definition of C interface of writers of channels of the latest
+ * snapshots.
+ */
+#pragma once
+
+#include "shm_stream/c_interface/bytes_view.h"
+#include "shm_stream/c_interface/common_types.h"
+#include "shm_stream/c_interface/error_codes.h"
+#include "shm_stream/c_interface/string_view.h"
+#include "shm_stream/details/shm_stream_export.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*!
+ * \brief Writer of channels of the latest snapshots.
+ */
+struct c_shm_stream_snapshot_channel_writer;
+
+/*!
+ * \brief Writer of channels of the latest snapshots.
+ */
+typedef struct c_shm_stream_snapshot_channel_writer
+    c_shm_stream_snapshot_channel_writer_t;
+
+/*!
+ * \brief Create a writer of a snapshot channel.
+ *
+ * \param[out] writer Writer.
+ * \param[in] name Name of the channel.
+ * \param[in] max_size Maximum size of snapshots.
+ * \return Error code.
+ *
+ * \note If the channel already exists, the maximum size of the existing
+ * channel is used.
+ */
+SHM_STREAM_EXPORT c_shm_stream_error_code_t
+c_shm_stream_snapshot_channel_writer_create(
+    c_shm_stream_snapshot_channel_writer_t** writer,
+    c_shm_stream_string_view_t name, c_shm_stream_size_t max_size);
+
+/*!
+ * \brief Destroy a writer of a snapshot channel.
+ *
+ * \param[in] writer Writer.
+ */
+SHM_STREAM_EXPORT void c_shm_stream_snapshot_channel_writer_destroy(
+    c_shm_stream_snapshot_channel_writer_t* writer);
+
+/*!
+ * \brief Get the maximum size of snapshots.
+ *
+ * \param[in] writer Writer.
+ * \return Maximum number of bytes in a snapshot.
+ */
+SHM_STREAM_EXPORT c_shm_stream_size_t
+c_shm_stream_snapshot_channel_writer_max_size(
+    c_shm_stream_snapshot_channel_writer_t* writer);
+
+/*!
+ * \brief Reserve the buffer of the next snapshot.
+ *
+ * \param[in] writer Writer.
+ * \return Buffer of the snapshot with the maximum size.
+ *
+ * \note Readers keep reading the previous snapshot until
+ * c_shm_stream_snapshot_channel_writer_commit function is called.
+ */
+SHM_STREAM_EXPORT c_shm_stream_mutable_bytes_view_t
+c_shm_stream_snapshot_channel_writer_reserve(
+    c_shm_stream_snapshot_channel_writer_t* writer);
+
+/*!
+ * \brief Publish the reserved snapshot.
+ *
+ * \param[in] writer Writer.
+ * \param[in] size Size of the snapshot.
+ */
+SHM_STREAM_EXPORT void c_shm_stream_snapshot_channel_writer_commit(
+    c_shm_stream_snapshot_channel_writer_t* writer, c_shm_stream_size_t size);
+
+/*!
+ * \brief Publish a snapshot.
+ *
+ * \param[in] writer Writer.
+ * \param[in] data Data of the snapshot.
+ * \return Error code.
+ */
+SHM_STREAM_EXPORT c_shm_stream_error_code_t
+c_shm_stream_snapshot_channel_writer_publish(
+    c_shm_stream_snapshot_channel_writer_t* writer,
+    c_shm_stream_bytes_view_t data);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,57 @@
+/*
+ * Copyright 2023 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Definition of c_shm_stream_wait_policy struct.
+ */
+#pragma once
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*!
+ * \brief Struct of policies to wait for blocking streams.
+ *
+ * Waiting operations first spin with CPU pause instructions, then yield the
+ * thread, and finally sleep until notified. The number of iterations of
+ * spinning is adapted to recently observed waiting time, measured in
+ * iterations of spinning rather than clock time, in the range from
+ * min_spin_count to max_spin_count.
+ *
+ * \note When all members are zero, waiting operations sleep immediately.
+ */
+struct c_shm_stream_wait_policy {
+    //! Minimum number of iterations of spinning.
+    uint32_t min_spin_count;
+
+    //! Maximum number of iterations of spinning.
+    uint32_t max_spin_count;
+
+    //! Number of iterations of yielding the thread after spinning.
+    uint32_t yield_count;
+};
+
+/*!
+ * \brief Struct of policies to wait for blocking streams.
+ */
+typedef struct c_shm_stream_wait_policy c_shm_stream_wait_policy_t;
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,300 @@
+/*
+ * Copyright 2023 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Definition of streams passing descriptors of chunks in shared
+ * memory.
+ */
+#pragma once
+
+#include "shm_stream/bytes_view.h"
+#include "shm_stream/c_interface/bytes_view.h"
+#include "shm_stream/c_interface/chunk_stream_common.h"
+#include "shm_stream/c_interface/chunk_stream_reader.h"
+#include "shm_stream/c_interface/chunk_stream_writer.h"
+#include "shm_stream/c_interface/string_view.h"
+#include "shm_stream/common_types.h"
+#include "shm_stream/details/smart_ptr.h"
+#include "shm_stream/details/throw_if_error.h"
+#include "shm_stream/string_view.h"
+
+namespace shm_stream {
+
+/*!
+ * \brief Class of writer of streams of chunks.
+ *
+ * The writer allocates a chunk from a pool in shared memory, writes data
+ * directly to the chunk, and sends only a small descriptor of the chunk to
+ * the reader. The reader returns the chunk to the pool after reading it, so
+ * payloads are written once and never copied by the stream.
+ *
+ * \thread_safety All operation is safe if only one writer exists.
+ */
+class chunk_stream_writer {
+public:
+    /*!
+     * \brief Constructor.
+     */
+    chunk_stream_writer() = default;
+
+    // Prevent copy.
+    chunk_stream_writer(const chunk_stream_writer&) = delete;
+    auto operator=(const chunk_stream_writer&) = delete;
+
+    /*!
+     * \brief Move constructor.
+     */
+    chunk_stream_writer(chunk_stream_writer&& /*obj*/) noexcept = default;
+
+    /*!
+     * \brief Move assignment operator.
+     *
+     * \return This.
+     */
+    chunk_stream_writer& operator=(
+        chunk_stream_writer&& /*obj*/) noexcept = default;
+
+    /*!
+     * \brief Destructor.
+     *
+     * \note This function will automatically close this stream.
+     */
+    ~chunk_stream_writer() noexcept = default;
+
+    /*!
+     * \brief Open a stream.
+     *
+     * \param[in] name Name of the stream.
+     * \param[in] num_chunks Number of chunks in the pool.
+     * \param[in] chunk_size Size of each chunk.
+     *
+     * \note If the stream already exists, the parameters of the existing
+     * stream are used.
+     */
+    void open(string_view name, shm_stream_size_t num_chunks,
+        shm_stream_size_t chunk_size) {
+        c_shm_stream_chunk_stream_writer_t* writer{nullptr};
+        details::throw_if_error(c_shm_stream_chunk_stream_writer_create(&writer,
+            c_shm_stream_string_view_t{name.data(), name.size()}, num_chunks,
+            chunk_size));
+        writer_ = details::smart_ptr<c_shm_stream_chunk_stream_writer_t>(
+            writer, c_shm_stream_chunk_stream_writer_destroy);
+    }
+
+    /*!
+     * \brief Close a stream.
+     *
+     * \note This function can be called when this stream has been already
+     * closed.
+     */
+    void close() noexcept { writer_.reset(); }
+
+    /*!
+     * \brief Check whether this object is opened.
+     *
+     * \retval true This object is opened.
+     * \retval false This object is not opened.
+     */
+    [[nodiscard]] bool is_opened() const noexcept { return writer_.has_obj(); }
+
+    /*!
+     * \brief Get the size of each chunk.
+     *
+     * \return Number of bytes.
+     */
+    [[nodiscard]] shm_stream_size_t chunk_size() const noexcept {
+        return c_shm_stream_chunk_stream_writer_chunk_size(writer_.get());
+    }
+
+    /*!
+     * \brief Try to allocate a chunk to write.
+     *
+     * \return Buffer of the chunk. If no chunk is free now, the data pointer
+     * of the buffer is null.
+     *
+     * \note Allocated chunk is sent to the reader by send function.
+     */
+    [[nodiscard]] mutable_bytes_view try_allocate() noexcept {
+        const auto buf =
+            c_shm_stream_chunk_stream_writer_try_allocate(writer_.get());
+        return mutable_bytes_view(buf.data, buf.size);
+    }
+
+    /*!
+     * \brief Send a chunk to the reader.
+     *
+     * \param[in] chunk Buffer of the chunk returned by try_allocate function.
+     * \param[in] size Number of bytes written to the chunk.
+     */
+    void send(mutable_bytes_view chunk, shm_stream_size_t size) noexcept {
+        c_shm_stream_chunk_stream_writer_send(writer_.get(),
+            c_shm_stream_mutable_bytes_view_t{chunk.data(), chunk.size()},
+            size);
+    }
+
+private:
+    //! Actual writer in C interface.
+    details::smart_ptr<c_shm_stream_chunk_stream_writer_t> writer_{};
+};
+
+/*!
+ * \brief Class of reader of streams of chunks.
+ *
+ * \thread_safety All operation is safe if only one reader exists.
+ */
+class chunk_stream_reader {
+public:
+    /*!
+     * \brief Constructor.
+     */
+    chunk_stream_reader() = default;
+
+    // Prevent copy.
+    chunk_stream_reader(const chunk_stream_reader&) = delete;
+    auto operator=(const chunk_stream_reader&) = delete;
+
+    /*!
+     * \brief Move constructor.
+     *
+     * \param[in] obj Object to move from.
+     */
+    chunk_stream_reader(chunk_stream_reader&& obj) noexcept = default;
+
+    /*!
+     * \brief Move assignment operator.
+     *
+     * \param[in] obj Object to move from.
+     * \return This.
+     */
+    chunk_stream_reader& operator=(
+        chunk_stream_reader&& obj) noexcept = default;
+
+    /*!
+     * \brief Destructor.
+     *
+     * \note This function will automatically close this stream.
+     */
+    ~chunk_stream_reader() noexcept = default;
+
+    /*!
+     * \brief Open a stream.
+     *
+     * \param[in] name Name of the stream.
+     * \param[in] num_chunks Number of chunks in the pool.
+     * \param[in] chunk_size Size of each chunk.
+     *
+     * \note If the stream already exists, the parameters of the existing
+     * stream are used.
+     */
+    void open(string_view name, shm_stream_size_t num_chunks,
+        shm_stream_size_t chunk_size) {
+        c_shm_stream_chunk_stream_reader_t* reader{nullptr};
+        details::throw_if_error(c_shm_stream_chunk_stream_reader_create(&reader,
+            c_shm_stream_string_view_t{name.data(), name.size()}, num_chunks,
+            chunk_size));
+        reader_ = details::smart_ptr<c_shm_stream_chunk_stream_reader_t>(
+            reader, c_shm_stream_chunk_stream_reader_destroy);
+    }
+
+    /*!
+     * \brief Close a stream.
+     *
+     * \note This function can be called when this stream has been already
+     * closed.
+     */
+    void close() noexcept { reader_.reset(); }
+
+    /*!
+     * \brief Check whether this object is opened.
+     *
+     * \retval true This object is opened.
+     * \retval false This object is not opened.
+     */
+    [[nodiscard]] bool is_opened() const noexcept { return reader_.has_obj(); }
+
+    /*!
+     * \brief Try to receive a chunk.
+     *
+     * \return Buffer of the bytes written to the chunk. If no chunk has been
+     * sent, the data pointer of the buffer is null.
+     *
+     * \note The chunk must be returned to the writer by release function
+     * after reading it.
+     */
+    [[nodiscard]] bytes_view try_receive() noexcept {
+        const auto buf =
+            c_shm_stream_chunk_stream_reader_try_receive(reader_.get());
+        return bytes_view(buf.data, buf.size);
+    }
+
+    /*!
+     * \brief Return a chunk to the writer.
+     *
+     * \param[in] chunk Buffer of the chunk returned by try_receive function.
+     */
+    void release(bytes_view chunk) noexcept {
+        c_shm_stream_chunk_stream_reader_release(reader_.get(),
+            c_shm_stream_bytes_view_t{chunk.data(), chunk.size()});
+    }
+
+private:
+    //! Actual reader in C interface.
+    details::smart_ptr<c_shm_stream_chunk_stream_reader_t> reader_{};
+};
+
+/*!
+ * \brief Classes and functions of streams passing descriptors of chunks in
+ * shared memory.
+ */
+namespace chunk_stream {
+
+/*!
+ * \brief Class of writer of streams of chunks.
+ */
+using writer = chunk_stream_writer;
+
+/*!
+ * \brief Class of reader of streams of chunks.
+ */
+using reader = chunk_stream_reader;
+
+/*!
+ * \brief Create a stream.
+ *
+ * \param[in] name Name of the stream.
+ * \param[in] num_chunks Number of chunks in the pool.
+ * \param[in] chunk_size Size of each chunk.
+ */
+inline void create(string_view name, shm_stream_size_t num_chunks,
+    shm_stream_size_t chunk_size) {
+    details::throw_if_error(c_shm_stream_chunk_stream_create(
+        c_shm_stream_string_view_t{name.data(), name.size()}, num_chunks,
+        chunk_size));
+}
+
+/*!
+ * \brief Remove a stream.
+ *
+ * \param[in] name Name of the stream.
+ */
+inline void remove(string_view name) {
+    c_shm_stream_chunk_stream_remove(
+        c_shm_stream_string_view_t{name.data(), name.size()});
+}
+
+}  // namespace chunk_stream
+
+}  // namespace shm_stream
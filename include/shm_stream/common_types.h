@@ -31,4 +31,113 @@ namespace shm_stream {
  */
 using shm_stream_size_t = c_shm_stream_size_t;
 
+/*!
+ * \brief Type of sizes used in streams with 64-bit indices.
+ */
+using shm_stream_size64_t = c_shm_stream_size64_t;
+
+/*!
+ * \brief Enumeration of layouts of buffers in shared memory.
+ */
+enum class buffer_layout {
+    //! Buffer mapped once to the virtual memory.
+    plain = c_shm_stream_buffer_layout_plain,
+
+    /*!
+     * \brief Buffer mapped twice back-to-back to the virtual memory.
+     *
+     * With this layout, any continuous byte sequence up to the available size
+     * can be reserved at once, even if it crosses the end of the circular
+     * buffer. The size of the buffer must be a multiple of the page size.
+     */
+    mirrored = c_shm_stream_buffer_layout_mirrored,
+
+    /*!
+     * \brief Buffer mapped once to the virtual memory aligned to huge pages.
+     *
+     * With this layout, the memory is rounded up to a multiple of the huge
+     * page size (2 MiB). If hugetlbfs with pages of this size is mounted and
+     * has free pages, the stream is placed in a file of hugetlbfs. Otherwise,
+     * the shared memory is mapped at an address aligned to huge pages, and the
+     * operating system is advised to back it with transparent huge pages.
+     * When huge pages are unavailable, normal pages are used instead. The page
+     * size actually used can be queried from writers and readers.
+     */
+    huge_pages = c_shm_stream_buffer_layout_huge_pages
+};
+
+/*!
+ * \brief Type of indices of NUMA nodes.
+ */
+using numa_node_t = c_shm_stream_numa_node_t;
+
+/*!
+ * \brief Value of NUMA nodes to place pages as usual when creating streams,
+ * or the unknown node when querying streams.
+ */
+constexpr numa_node_t numa_node_none = c_shm_stream_numa_node_none;
+
+/*!
+ * \brief Value of NUMA nodes to use the node of the CPU running the calling
+ * thread.
+ */
+constexpr numa_node_t numa_node_current = c_shm_stream_numa_node_current;
+
+/*!
+ * \brief Enumeration of options of memory of streams.
+ *
+ * Values can be combined using operator|.
+ */
+enum class memory_options : c_shm_stream_memory_options_t {
+    //! No option.
+    none = c_shm_stream_memory_option_none,
+
+    /*!
+     * \brief Pre-fault all pages of the mapped region when opening a stream.
+     *
+     * This avoids page faults in the first pass over the buffer.
+     */
+    prefault = c_shm_stream_memory_option_prefault,
+
+    /*!
+     * \brief Lock all pages of the mapped region in physical memory when
+     * opening a stream.
+     *
+     * This requires a limit of locked memory (RLIMIT_MEMLOCK in Linux) of at
+     * least the size of the mapped region in addition to memory already
+     * locked by the process, unless the process is privileged
+     * (CAP_IPC_LOCK in Linux). If pages cannot be locked, opening the stream
+     * fails, and a stream created in the attempt is removed.
+     */
+    lock = c_shm_stream_memory_option_lock
+};
+
+/*!
+ * \brief Combine options of memory.
+ *
+ * \param[in] left Left-hand-side object.
+ * \param[in] right Right-hand-side object.
+ * \return Combined options.
+ */
+[[nodiscard]] constexpr memory_options operator|(
+    memory_options left, memory_options right) noexcept {
+    return static_cast<memory_options>(
+        static_cast<c_shm_stream_memory_options_t>(left) |
+        static_cast<c_shm_stream_memory_options_t>(right));
+}
+
+/*!
+ * \brief Check whether options of memory contain an option.
+ *
+ * \param[in] options Options.
+ * \param[in] option Option to check.
+ * \retval true Options contain the option.
+ * \retval false Options don't contain the option.
+ */
+[[nodiscard]] constexpr bool has_memory_option(
+    memory_options options, memory_options option) noexcept {
+    return (static_cast<c_shm_stream_memory_options_t>(options) &
+               static_cast<c_shm_stream_memory_options_t>(option)) != 0U;
+}
+
 }  // namespace shm_stream
@@ -0,0 +1,149 @@
+/*
+ * Copyright 2023 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Definition of adaptive_spinner class.
+ */
+#pragma once
+
+#include <cstdint>
+#include <thread>
+
+#include <boost/memory_order.hpp>
+
+#include "shm_stream/c_interface/error_codes.h"
+#include "shm_stream/details/pause.h"
+#include "shm_stream/shm_stream_exception.h"
+#include "shm_stream/wait_policy.h"
+
+namespace shm_stream {
+namespace details {
+
+/*!
+ * \brief Class to spin and yield before sleeping, with the number of
+ * iterations of spinning adapted to recently observed waiting time.
+ *
+ * Waiting time is measured in iterations of spinning needed until values
+ * changed, not in clock time: twice the number of iterations when a value
+ * changed while spinning, the maximum when it changed while yielding, and the
+ * minimum when it didn't change.
+ *
+ * \thread_safety Not thread-safe.
+ */
+class adaptive_spinner {
+public:
+    /*!
+     * \brief Constructor.
+     *
+     * \param[in] policy Policy to wait.
+     */
+    explicit adaptive_spinner(const wait_policy& policy = wait_policy())
+        : min_spin_count_(policy.min_spin_count()),
+          max_spin_count_(policy.max_spin_count()),
+          yield_count_(policy.yield_count()),
+          spin_count_(policy.max_spin_count()) {
+        if (min_spin_count_ > max_spin_count_) {
+            throw shm_stream_error(c_shm_stream_error_code_invalid_argument);
+        }
+    }
+
+    /*!
+     * \brief Spin and yield until the value of an atomic variable changes.
+     *
+     * \tparam AtomicType Type of the atomic variable.
+     * \param[in] variable Atomic variable.
+     * \param[in] unexpected_value Current value of the variable.
+     * \param[out] value New value of the variable, if changed.
+     * \retval true The value changed.
+     * \retval false The value didn't change, and the caller should sleep.
+     *
+     * \note Values are loaded with relaxed memory order.
+     */
+    template <typename AtomicType>
+    [[nodiscard]] bool spin(const AtomicType& variable,
+        typename AtomicType::value_type unexpected_value,
+        typename AtomicType::value_type& value) noexcept {
+        for (std::uint32_t i = 0U; i < spin_count_; ++i) {
+            value = variable.load(boost::memory_order::relaxed);
+            if (value != unexpected_value) {
+                adapt(2U * (static_cast<std::uint64_t>(i) + 1U));
+                return true;
+            }
+            pause();
+        }
+        for (std::uint32_t i = 0U; i < yield_count_; ++i) {
+            std::this_thread::yield();
+            value = variable.load(boost::memory_order::relaxed);
+            if (value != unexpected_value) {
+                adapt(max_spin_count_);
+                return true;
+            }
+        }
+        adapt(min_spin_count_);
+        return false;
+    }
+
+    /*!
+     * \brief Get the current number of iterations of spinning.
+     *
+     * \return Number of iterations.
+     */
+    [[nodiscard]] std::uint32_t spin_count() const noexcept {
+        return spin_count_;
+    }
+
+private:
+    /*!
+     * \brief Move the number of iterations of spinning toward a target.
+     *
+     * \param[in] target Target number of iterations.
+     */
+    void adapt(std::uint64_t target) noexcept {
+        if (target < min_spin_count_) {
+            target = min_spin_count_;
+        }
+        if (target > max_spin_count_) {
+            target = max_spin_count_;
+        }
+        // Exponential moving average with the weight 1/8 for the new value.
+        constexpr std::int64_t inverse_weight = 8;
+        const std::int64_t diff = static_cast<std::int64_t>(target) -
+            static_cast<std::int64_t>(spin_count_);
+        std::int64_t step = diff / inverse_weight;
+        // Steps truncated to zero are rounded away from zero so that the
+        // number reaches the target.
+        if (step == 0 && diff != 0) {
+            step = (diff > 0) ? 1 : -1;
+        }
+        spin_count_ = static_cast<std::uint32_t>(
+            static_cast<std::int64_t>(spin_count_) + step);
+    }
+
+    //! Minimum number of iterations of spinning.
+    std::uint32_t min_spin_count_;
+
+    //! Maximum number of iterations of spinning.
+    std::uint32_t max_spin_count_;
+
+    //! Number of iterations of yielding the thread.
+    std::uint32_t yield_count_;
+
+    //! Current number of iterations of spinning.
+    std::uint32_t spin_count_;
+};
+
+}  // namespace details
+}  // namespace shm_stream
@@ -42,9 +42,11 @@ public:
     using atomic_type = AtomicType;
 
     static_assert(std::is_same<typename atomic_type::value_type,
-                      shm_stream_size_t>::value,
+                      shm_stream_size_t>::value ||
+            std::is_same<typename atomic_type::value_type,
+                shm_stream_size64_t>::value,
         "Type of values in atomic variables must be equal to "
-        "shm_stream_size_t.");
+        "shm_stream_size_t or shm_stream_size64_t.");
 
     /*!
      * \brief Constructor.
@@ -65,12 +67,50 @@ public:
      */
     [[nodiscard]] atomic_type& reader() noexcept { return reader_index_; }
 
+    /*!
+     * \brief Get the number of threads waiting for changes of the index of the
+     * writer.
+     *
+     * \return Atomic variable of the number of threads.
+     */
+    [[nodiscard]] atomic_type& writer_waiters() noexcept {
+        return writer_waiters_;
+    }
+
+    /*!
+     * \brief Get the number of threads waiting for changes of the index of the
+     * reader.
+     *
+     * \return Atomic variable of the number of threads.
+     */
+    [[nodiscard]] atomic_type& reader_waiters() noexcept {
+        return reader_waiters_;
+    }
+
 private:
     //! Index of the writer.
     alignas(cache_line_size()) atomic_type writer_index_{0U};
 
+    /*!
+     * \brief Number of threads waiting for changes of the index of the writer.
+     *
+     * \note This variable is placed in the same cache line as the index of the
+     * writer, because the writer checks this variable after each update of the
+     * index.
+     */
+    atomic_type writer_waiters_{0U};
+
     //! Index of the reader.
     alignas(cache_line_size()) atomic_type reader_index_{0U};
+
+    /*!
+     * \brief Number of threads waiting for changes of the index of the reader.
+     *
+     * \note This variable is placed in the same cache line as the index of the
+     * reader, because the reader checks this variable after each update of the
+     * index.
+     */
+    atomic_type reader_waiters_{0U};
 };
 
 /*!
@@ -86,20 +126,32 @@ public:
     using atomic_type = AtomicType;
 
     static_assert(std::is_same<typename atomic_type::value_type,
-                      shm_stream_size_t>::value,
+                      shm_stream_size_t>::value ||
+            std::is_same<typename atomic_type::value_type,
+                shm_stream_size64_t>::value,
         "Type of values in atomic variables must be equal to "
-        "shm_stream_size_t.");
+        "shm_stream_size_t or shm_stream_size64_t.");
 
     /*!
      * \brief Constructor.
      *
      * \param[in] writer_index Index of the writer.
      * \param[in] reader_index Index of the reader.
+     * \param[in] writer_waiters Number of threads waiting for changes of the
+     * index of the writer.
+     * \param[in] reader_waiters Number of threads waiting for changes of the
+     * index of the reader.
      */
-    atomic_index_pair_view(atomic_type* writer_index, atomic_type* reader_index)
-        : writer_index_(writer_index), reader_index_(reader_index) {
+    atomic_index_pair_view(atomic_type* writer_index, atomic_type* reader_index,
+        atomic_type* writer_waiters, atomic_type* reader_waiters)
+        : writer_index_(writer_index),
+          reader_index_(reader_index),
+          writer_waiters_(writer_waiters),
+          reader_waiters_(reader_waiters) {
         SHM_STREAM_ASSERT(writer_index_ != nullptr);
         SHM_STREAM_ASSERT(reader_index_ != nullptr);
+        SHM_STREAM_ASSERT(writer_waiters_ != nullptr);
+        SHM_STREAM_ASSERT(reader_waiters_ != nullptr);
     }
 
     /*!
@@ -109,7 +161,8 @@ public:
      */
     atomic_index_pair_view(  // NOLINT(google-explicit-constructor, hicpp-explicit-conversions)
         atomic_index_pair<atomic_type>& indices)
-        : atomic_index_pair_view(&indices.writer(), &indices.reader()) {}
+        : atomic_index_pair_view(&indices.writer(), &indices.reader(),
+              &indices.writer_waiters(), &indices.reader_waiters()) {}
 
     /*!
      * \brief Get the index of the writer.
@@ -125,12 +178,38 @@ public:
      */
     [[nodiscard]] atomic_type& reader() noexcept { return *reader_index_; }
 
+    /*!
+     * \brief Get the number of threads waiting for changes of the index of the
+     * writer.
+     *
+     * \return Atomic variable of the number of threads.
+     */
+    [[nodiscard]] atomic_type& writer_waiters() noexcept {
+        return *writer_waiters_;
+    }
+
+    /*!
+     * \brief Get the number of threads waiting for changes of the index of the
+     * reader.
+     *
+     * \return Atomic variable of the number of threads.
+     */
+    [[nodiscard]] atomic_type& reader_waiters() noexcept {
+        return *reader_waiters_;
+    }
+
 private:
     //! Index of the writer.
     atomic_type* writer_index_;
 
     //! Index of the reader.
     atomic_type* reader_index_;
+
+    //! Number of threads waiting for changes of the index of the writer.
+    atomic_type* writer_waiters_;
+
+    //! Number of threads waiting for changes of the index of the reader.
+    atomic_type* reader_waiters_;
 };
 
 }  // namespace details
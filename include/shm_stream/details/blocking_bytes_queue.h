@@ -20,6 +20,7 @@
 #pragma once
 
 #include <algorithm>
+#include <cstddef>
 #include <limits>
 #include <type_traits>
 
@@ -30,8 +31,11 @@
 #include "shm_stream/bytes_view.h"
 #include "shm_stream/c_interface/error_codes.h"
 #include "shm_stream/common_types.h"
+#include "shm_stream/details/adaptive_spinner.h"
 #include "shm_stream/details/atomic_index_pair.h"
+#include "shm_stream/details/scatter_gather.h"
 #include "shm_stream/shm_stream_exception.h"
+#include "shm_stream/wait_policy.h"
 
 namespace shm_stream {
 namespace details {
@@ -101,16 +105,30 @@ public:
      * \param[in] atomic_indices Atomic variables of the indices of the next
      * bytes for the writer and the reader.
      * \param[in] buffer Buffer of data.
+     * \param[in] is_mirrored Whether the buffer is mirrored, i.e., mapped
+     * twice back-to-back so that bytes after the end of the buffer are the
+     * bytes at the beginning of the buffer.
+     * \param[in] policy Policy to wait.
+     * \param[in] unit_size Size of units in which bytes are written. The
+     * writer waits until a whole unit is available.
      */
     blocking_bytes_queue_writer(
         atomic_index_pair_view<atomic_type> atomic_indices,
-        mutable_bytes_view buffer)
+        mutable_bytes_view buffer, bool is_mirrored = false,
+        const wait_policy& policy = wait_policy(),
+        shm_stream_size_t unit_size = 1U)
         : atomic_next_read_index_(&atomic_indices.reader()),
           atomic_next_write_index_(&atomic_indices.writer()),
+          atomic_read_index_waiters_(&atomic_indices.reader_waiters()),
+          atomic_write_index_waiters_(&atomic_indices.writer_waiters()),
           buffer_(buffer.data()),
           size_(buffer.size()),
+          unit_size_(unit_size),
+          is_mirrored_(is_mirrored),
           next_write_index_(0U),
-          reserved_(0U) {
+          cached_next_read_index_(0U),
+          reserved_(0U),
+          spinner_(policy) {
         SHM_STREAM_ASSERT(atomic_next_read_index_ != nullptr);
         SHM_STREAM_ASSERT(atomic_next_read_index_->load() < max_size() ||
             atomic_next_read_index_->load() ==
@@ -119,9 +137,12 @@ public:
         SHM_STREAM_ASSERT(atomic_next_write_index_->load() < max_size() ||
             atomic_next_write_index_->load() ==
                 blocking_bytes_queue_stop_index());
+        SHM_STREAM_ASSERT(atomic_read_index_waiters_ != nullptr);
+        SHM_STREAM_ASSERT(atomic_write_index_waiters_ != nullptr);
         SHM_STREAM_ASSERT(buffer_ != nullptr);
 
-        if (size_ < min_size() || size_ > max_size()) {
+        if (size_ < min_size() || size_ > max_size() || unit_size_ == 0U ||
+            unit_size_ >= size_) {
             throw shm_stream_error(c_shm_stream_error_code_invalid_argument);
         }
 
@@ -130,6 +151,8 @@ public:
         if (next_write_index_ == blocking_bytes_queue_stop_index()) {
             next_write_index_ = 0U;
         }
+        cached_next_read_index_ =
+            atomic_next_read_index_->load(boost::memory_order::acquire);
     }
 
     // Prevent copy.
@@ -171,17 +194,17 @@ public:
      *
      * \note After stop of this queue, this function immediately returns zero.
      */
-    shm_stream_size_t wait() const noexcept {
-        shm_stream_size_t unexpected_next_read_index = next_write_index_ + 1U;
-        if (unexpected_next_read_index == size_) {
-            unexpected_next_read_index = 0U;
+    shm_stream_size_t wait() noexcept {
+        shm_stream_size_t unexpected_next_read_index =
+            next_write_index_ + unit_size_;
+        if (unexpected_next_read_index >= size_) {
+            unexpected_next_read_index -= size_;
         }
 
         shm_stream_size_t next_read_index =
             atomic_next_read_index_->load(boost::memory_order::relaxed);
         while (next_read_index == unexpected_next_read_index) {
-            next_read_index = atomic_next_read_index_->wait(
-                unexpected_next_read_index, boost::memory_order::relaxed);
+            next_read_index = wait_next_read_index(unexpected_next_read_index);
         }
 
         return calc_available_size(next_read_index);
@@ -223,16 +246,23 @@ public:
      * \note This function can return a buffer with a size smaller than the
      * return value of available_size function, because this queue is a circular
      * buffer and this function reserves continuous byte sequences from the
-     * circular buffer.
+     * circular buffer, unless the buffer is mirrored.
      * \note After stop of this queue, this function returns empty buffers.
+     * \note This function loads the index of the reader only when the cached
+     * value of the index is not enough to reserve the expected number of bytes
+     * or this queue is stopped.
      */
     [[nodiscard]] mutable_bytes_view try_reserve(
         shm_stream_size_t expected_size = max_size()) noexcept {
-        const shm_stream_size_t next_read_index =
-            atomic_next_read_index_->load(boost::memory_order::acquire);
-
-        const shm_stream_size_t max_reservable_size =
-            calc_reservable_size(next_read_index);
+        shm_stream_size_t max_reservable_size =
+            calc_reservable_size(cached_next_read_index_);
+        if (max_reservable_size < expected_size ||
+            atomic_next_write_index_->load(boost::memory_order::relaxed) ==
+                blocking_bytes_queue_stop_index()) {
+            cached_next_read_index_ =
+                atomic_next_read_index_->load(boost::memory_order::acquire);
+            max_reservable_size = calc_reservable_size(cached_next_read_index_);
+        }
         reserved_ = std::min(expected_size, max_reservable_size);
 
         return mutable_bytes_view(buffer_ + next_write_index_, reserved_);
@@ -248,24 +278,25 @@ public:
      * \note This function can return a buffer with a size smaller than the
      * return value of available_size function, because this queue is a circular
      * buffer and this function reserves continuous byte sequences from the
-     * circular buffer.
+     * circular buffer, unless the buffer is mirrored.
      * \note After stop of this queue, this function immediately returns empty
      * buffers.
      */
     [[nodiscard]] mutable_bytes_view wait_reserve(
         shm_stream_size_t expected_size = max_size()) noexcept {
-        shm_stream_size_t unexpected_next_read_index = next_write_index_ + 1U;
-        if (unexpected_next_read_index == size_) {
-            unexpected_next_read_index = 0U;
+        shm_stream_size_t unexpected_next_read_index =
+            next_write_index_ + unit_size_;
+        if (unexpected_next_read_index >= size_) {
+            unexpected_next_read_index -= size_;
         }
 
         shm_stream_size_t next_read_index =
             atomic_next_read_index_->load(boost::memory_order::relaxed);
         while (next_read_index == unexpected_next_read_index) {
-            next_read_index = atomic_next_read_index_->wait(
-                unexpected_next_read_index, boost::memory_order::relaxed);
+            next_read_index = wait_next_read_index(unexpected_next_read_index);
         }
         boost::atomics::atomic_thread_fence(boost::memory_order::acquire);
+        cached_next_read_index_ = next_read_index;
 
         const shm_stream_size_t max_reservable_size =
             calc_reservable_size(next_read_index);
@@ -278,6 +309,9 @@ public:
      * \brief Save written bytes as completed and ready to be read by a reader.
      *
      * \param[in] written_size Number of written bytes to save.
+     *
+     * \note This function notifies readers only when some readers are waiting
+     * in wait or wait_reserve function.
      */
     void commit(shm_stream_size_t written_size) noexcept {
         if (written_size == 0U) {
@@ -286,23 +320,94 @@ public:
         SHM_STREAM_ASSERT(written_size <= reserved_);
 
         next_write_index_ += written_size;
-        if (next_write_index_ == size_) {
-            next_write_index_ = 0;
+        if (next_write_index_ >= size_) {
+            next_write_index_ -= size_;
         }
         SHM_STREAM_ASSERT(next_write_index_ < size_);
 
+        // Sequentially consistent operations are used here and in
+        // wait_next_write_index function of readers so that either this
+        // function sees the waiting reader or the reader sees the new index.
         const shm_stream_size_t old_next_write_index =
             atomic_next_write_index_->exchange(
-                next_write_index_, boost::memory_order::release);
+                next_write_index_, boost::memory_order::seq_cst);
         if (old_next_write_index == blocking_bytes_queue_stop_index()) {
             stop();
         }
-        atomic_next_write_index_->notify_all();
+        if (atomic_write_index_waiters_->load(boost::memory_order::seq_cst) !=
+            0U) {
+            atomic_next_write_index_->notify_all();
+        }
 
         reserved_ = 0U;
     }
 
+    /*!
+     * \brief Wait to write bytes gathered from pieces at once.
+     *
+     * \tparam Piece Type of views of the pieces.
+     * \param[in] pieces Pieces of bytes to write in order.
+     * \param[in] num_pieces Number of the pieces.
+     * \retval true All pieces were written.
+     * \retval false This queue was stopped, or the pieces can never fit in the
+     * buffer. (No byte is written.)
+     *
+     * \note This function waits until space for all pieces is available,
+     * copies them into one reservation wrapping around the end of the circular
+     * buffer, and saves them with a single update of the index.
+     */
+    template <typename Piece>
+    [[nodiscard]] bool wait_write_gather(
+        const Piece* pieces, std::size_t num_pieces) noexcept {
+        shm_stream_size_t total_size = 0U;
+        if (!calc_total_piece_size(pieces, num_pieces, total_size) ||
+            total_size >= size_) {
+            return false;
+        }
+        if (total_size == 0U) {
+            return true;
+        }
+
+        shm_stream_size_t next_read_index =
+            atomic_next_read_index_->load(boost::memory_order::relaxed);
+        while (calc_available_size(next_read_index) < total_size) {
+            if (next_read_index == blocking_bytes_queue_stop_index()) {
+                return false;
+            }
+            next_read_index = wait_next_read_index(next_read_index);
+        }
+        boost::atomics::atomic_thread_fence(boost::memory_order::acquire);
+        cached_next_read_index_ = next_read_index;
+
+        gather_to_circular_buffer(
+            buffer_, size_, next_write_index_, pieces, num_pieces);
+        reserved_ = total_size;
+        commit(total_size);
+        return true;
+    }
+
 private:
+    /*!
+     * \brief Wait for a change of the index of the next byte to read.
+     *
+     * \param[in] unexpected_next_read_index Current value of the index.
+     * \return New value of the index.
+     */
+    [[nodiscard]] shm_stream_size_t wait_next_read_index(
+        shm_stream_size_t unexpected_next_read_index) noexcept {
+        shm_stream_size_t spun_next_read_index = 0U;
+        if (spinner_.spin(*atomic_next_read_index_, unexpected_next_read_index,
+                spun_next_read_index)) {
+            return spun_next_read_index;
+        }
+
+        atomic_read_index_waiters_->fetch_add(1U, boost::memory_order::seq_cst);
+        const shm_stream_size_t next_read_index = atomic_next_read_index_->wait(
+            unexpected_next_read_index, boost::memory_order::seq_cst);
+        atomic_read_index_waiters_->fetch_sub(1U, boost::memory_order::relaxed);
+        return next_read_index;
+    }
+
     /*!
      * \brief Calculate the number of reservable bytes.
      *
@@ -317,6 +422,9 @@ private:
         if (next_write_index_ < next_read_index) {
             return next_read_index - next_write_index_ - 1U;
         }
+        if (is_mirrored_) {
+            return size_ - next_write_index_ + next_read_index - 1U;
+        }
         if (next_read_index == 0U) {
             return size_ - next_write_index_ - 1U;
         }
@@ -347,17 +455,41 @@ private:
     //! Atomic variable of the index of the next byte to write.
     atomic_type* atomic_next_write_index_;
 
+    /*!
+     * \brief Atomic variable of the number of threads waiting for changes of
+     * the index of the next byte to read.
+     */
+    atomic_type* atomic_read_index_waiters_;
+
+    /*!
+     * \brief Atomic variable of the number of threads waiting for changes of
+     * the index of the next byte to write.
+     */
+    atomic_type* atomic_write_index_waiters_;
+
     //! Pointer to the buffer.
     char* buffer_;
 
     //! Size of the buffer.
     shm_stream_size_t size_;
 
+    //! Size of units in which bytes are written.
+    shm_stream_size_t unit_size_;
+
+    //! Whether the buffer is mirrored.
+    bool is_mirrored_;
+
     //! Index of the next byte to write.
     shm_stream_size_t next_write_index_;
 
+    //! Cached value of atomic_next_read_index_.
+    shm_stream_size_t cached_next_read_index_;
+
     //! Number of bytes reserved to write currently.
     shm_stream_size_t reserved_;
+
+    //! Spinner used before sleeping in waiting operations.
+    adaptive_spinner spinner_;
 };
 
 /*!
@@ -416,15 +548,25 @@ public:
      * \param[in] atomic_indices Atomic variables of the indices of the next
      * bytes for the writer and the reader.
      * \param[in] buffer Buffer of data.
+     * \param[in] is_mirrored Whether the buffer is mirrored, i.e., mapped
+     * twice back-to-back so that bytes after the end of the buffer are the
+     * bytes at the beginning of the buffer.
+     * \param[in] policy Policy to wait.
      */
     blocking_bytes_queue_reader(
-        atomic_index_pair_view<atomic_type> atomic_indices, bytes_view buffer)
+        atomic_index_pair_view<atomic_type> atomic_indices, bytes_view buffer,
+        bool is_mirrored = false, const wait_policy& policy = wait_policy())
         : atomic_next_read_index_(&atomic_indices.reader()),
           atomic_next_write_index_(&atomic_indices.writer()),
+          atomic_read_index_waiters_(&atomic_indices.reader_waiters()),
+          atomic_write_index_waiters_(&atomic_indices.writer_waiters()),
           buffer_(buffer.data()),
           size_(buffer.size()),
+          is_mirrored_(is_mirrored),
           next_read_index_(0U),
-          reserved_(0U) {
+          cached_next_write_index_(0U),
+          reserved_(0U),
+          spinner_(policy) {
         SHM_STREAM_ASSERT(atomic_next_read_index_ != nullptr);
         SHM_STREAM_ASSERT(atomic_next_read_index_->load() < max_size() ||
             atomic_next_read_index_->load() ==
@@ -433,6 +575,8 @@ public:
         SHM_STREAM_ASSERT(atomic_next_write_index_->load() < max_size() ||
             atomic_next_write_index_->load() ==
                 blocking_bytes_queue_stop_index());
+        SHM_STREAM_ASSERT(atomic_read_index_waiters_ != nullptr);
+        SHM_STREAM_ASSERT(atomic_write_index_waiters_ != nullptr);
         SHM_STREAM_ASSERT(buffer_ != nullptr);
 
         if (size_ < min_size() || size_ > max_size()) {
@@ -444,6 +588,8 @@ public:
         if (next_read_index_ == blocking_bytes_queue_stop_index()) {
             next_read_index_ = 0U;
         }
+        cached_next_write_index_ =
+            atomic_next_write_index_->load(boost::memory_order::acquire);
     }
 
     // Prevent copy.
@@ -485,14 +631,14 @@ public:
      *
      * \note After stop of this queue, this function immediately returns zero.
      */
-    shm_stream_size_t wait() const noexcept {
+    shm_stream_size_t wait() noexcept {
         const shm_stream_size_t unexpected_next_write_index = next_read_index_;
 
         shm_stream_size_t next_write_index =
             atomic_next_write_index_->load(boost::memory_order::relaxed);
         while (next_write_index == unexpected_next_write_index) {
-            next_write_index = atomic_next_write_index_->wait(
-                unexpected_next_write_index, boost::memory_order::relaxed);
+            next_write_index =
+                wait_next_write_index(unexpected_next_write_index);
         }
 
         return calc_available_size(next_write_index);
@@ -523,6 +669,53 @@ public:
                 blocking_bytes_queue_stop_index());
     }
 
+    /*!
+     * \brief Start waiting for bytes together with other queues.
+     *
+     * \param[out] unexpected_next_write_index Value of the index of the next
+     * byte to write. Wait for changes of atomic_next_write_index function
+     * from this value, then call end_wait_any function.
+     * \retval true Waiting is started.
+     * \retval false Some bytes are available or this queue is stopped, so
+     * waiting is not started.
+     *
+     * \note This function is used to wait for multiple queues in a thread
+     * using system calls which wait for multiple atomic variables at once.
+     */
+    [[nodiscard]] bool begin_wait_any(
+        shm_stream_size_t& unexpected_next_write_index) noexcept {
+        // The writer checks the number of waiters after updates of the index,
+        // so either the writer sees this waiter or this reader sees the new
+        // index.
+        atomic_write_index_waiters_->fetch_add(
+            1U, boost::memory_order::seq_cst);
+        unexpected_next_write_index =
+            atomic_next_write_index_->load(boost::memory_order::seq_cst);
+        if (unexpected_next_write_index != next_read_index_ ||
+            is_stopped()) {
+            end_wait_any();
+            return false;
+        }
+        return true;
+    }
+
+    /*!
+     * \brief Finish waiting started by begin_wait_any function.
+     */
+    void end_wait_any() noexcept {
+        atomic_write_index_waiters_->fetch_sub(
+            1U, boost::memory_order::relaxed);
+    }
+
+    /*!
+     * \brief Get the atomic variable of the index of the next byte to write.
+     *
+     * \return Atomic variable.
+     */
+    [[nodiscard]] const atomic_type& atomic_next_write_index() const noexcept {
+        return *atomic_next_write_index_;
+    }
+
     /*!
      * \brief Try to reserve some bytes to read.
      *
@@ -534,16 +727,24 @@ public:
      * \note This function can return a buffer with a size smaller than the
      * return value of available_size function, because this queue is a circular
      * buffer and this function reserves continuous byte sequences from the
-     * circular buffer.
+     * circular buffer, unless the buffer is mirrored.
      * \note After stop of this queue, this function returns empty buffers.
+     * \note This function loads the index of the writer only when the cached
+     * value of the index is not enough to reserve the expected number of bytes
+     * or this queue is stopped.
      */
     [[nodiscard]] bytes_view try_reserve(
         shm_stream_size_t expected_size = max_size()) noexcept {
-        const shm_stream_size_t next_write_index =
-            atomic_next_write_index_->load(boost::memory_order::acquire);
-
-        const shm_stream_size_t max_reservable_size =
-            calc_reservable_size(next_write_index);
+        shm_stream_size_t max_reservable_size =
+            calc_reservable_size(cached_next_write_index_);
+        if (max_reservable_size < expected_size ||
+            atomic_next_read_index_->load(boost::memory_order::relaxed) ==
+                blocking_bytes_queue_stop_index()) {
+            cached_next_write_index_ =
+                atomic_next_write_index_->load(boost::memory_order::acquire);
+            max_reservable_size =
+                calc_reservable_size(cached_next_write_index_);
+        }
         reserved_ = std::min(expected_size, max_reservable_size);
 
         return bytes_view(buffer_ + next_read_index_, reserved_);
@@ -559,7 +760,7 @@ public:
      * \note This function can return a buffer with a size smaller than the
      * return value of available_size function, because this queue is a circular
      * buffer and this function reserves continuous byte sequences from the
-     * circular buffer.
+     * circular buffer, unless the buffer is mirrored.
      * \note After stop of this queue, this function immediately returns empty
      * buffers.
      */
@@ -570,10 +771,11 @@ public:
         shm_stream_size_t next_write_index =
             atomic_next_write_index_->load(boost::memory_order::relaxed);
         while (next_write_index == unexpected_next_write_index) {
-            next_write_index = atomic_next_write_index_->wait(
-                unexpected_next_write_index, boost::memory_order::relaxed);
+            next_write_index =
+                wait_next_write_index(unexpected_next_write_index);
         }
         boost::atomics::atomic_thread_fence(boost::memory_order::acquire);
+        cached_next_write_index_ = next_write_index;
 
         const shm_stream_size_t max_reservable_size =
             calc_reservable_size(next_write_index);
@@ -586,6 +788,9 @@ public:
      * \brief Set some bytes finished to read and ready to write by a writer.
      *
      * \param[in] read_size Number of bytes to set finished to read.
+     *
+     * \note This function notifies writers only when some writers are waiting
+     * in wait or wait_reserve function.
      */
     void commit(shm_stream_size_t read_size) noexcept {
         if (read_size == 0U) {
@@ -594,23 +799,97 @@ public:
         SHM_STREAM_ASSERT(read_size <= reserved_);
 
         next_read_index_ += read_size;
-        if (next_read_index_ == size_) {
-            next_read_index_ = 0;
+        if (next_read_index_ >= size_) {
+            next_read_index_ -= size_;
         }
         SHM_STREAM_ASSERT(next_read_index_ < size_);
 
+        // Sequentially consistent operations are used here and in
+        // wait_next_read_index function of writers so that either this function
+        // sees the waiting writer or the writer sees the new index.
         const shm_stream_size_t old_next_read_index =
             atomic_next_read_index_->exchange(
-                next_read_index_, boost::memory_order::release);
+                next_read_index_, boost::memory_order::seq_cst);
         if (old_next_read_index == blocking_bytes_queue_stop_index()) {
             stop();
         }
-        atomic_next_read_index_->notify_all();
+        if (atomic_read_index_waiters_->load(boost::memory_order::seq_cst) !=
+            0U) {
+            atomic_next_read_index_->notify_all();
+        }
 
         reserved_ = 0U;
     }
 
+    /*!
+     * \brief Wait to read bytes scattering into pieces at once.
+     *
+     * \tparam Piece Type of views of the pieces.
+     * \param[in] pieces Pieces of buffers to fill in order.
+     * \param[in] num_pieces Number of the pieces.
+     * \retval true All pieces were filled.
+     * \retval false This queue was stopped, or the pieces can never be filled
+     * from the buffer. (No byte is read.)
+     *
+     * \note This function waits until bytes for all pieces are available,
+     * copies them from one reservation wrapping around the end of the circular
+     * buffer, and sets them finished to read with a single update of the index.
+     */
+    template <typename Piece>
+    [[nodiscard]] bool wait_read_scatter(
+        const Piece* pieces, std::size_t num_pieces) noexcept {
+        shm_stream_size_t total_size = 0U;
+        if (!calc_total_piece_size(pieces, num_pieces, total_size) ||
+            total_size >= size_) {
+            return false;
+        }
+        if (total_size == 0U) {
+            return true;
+        }
+
+        shm_stream_size_t next_write_index =
+            atomic_next_write_index_->load(boost::memory_order::relaxed);
+        while (calc_available_size(next_write_index) < total_size) {
+            if (next_write_index == blocking_bytes_queue_stop_index()) {
+                return false;
+            }
+            next_write_index = wait_next_write_index(next_write_index);
+        }
+        boost::atomics::atomic_thread_fence(boost::memory_order::acquire);
+        cached_next_write_index_ = next_write_index;
+
+        scatter_from_circular_buffer(
+            buffer_, size_, next_read_index_, pieces, num_pieces);
+        reserved_ = total_size;
+        commit(total_size);
+        return true;
+    }
+
 private:
+    /*!
+     * \brief Wait for a change of the index of the next byte to write.
+     *
+     * \param[in] unexpected_next_write_index Current value of the index.
+     * \return New value of the index.
+     */
+    [[nodiscard]] shm_stream_size_t wait_next_write_index(
+        shm_stream_size_t unexpected_next_write_index) noexcept {
+        shm_stream_size_t spun_next_write_index = 0U;
+        if (spinner_.spin(*atomic_next_write_index_,
+                unexpected_next_write_index, spun_next_write_index)) {
+            return spun_next_write_index;
+        }
+
+        atomic_write_index_waiters_->fetch_add(
+            1U, boost::memory_order::seq_cst);
+        const shm_stream_size_t next_write_index =
+            atomic_next_write_index_->wait(
+                unexpected_next_write_index, boost::memory_order::seq_cst);
+        atomic_write_index_waiters_->fetch_sub(
+            1U, boost::memory_order::relaxed);
+        return next_write_index;
+    }
+
     /*!
      * \brief Calculate the number of reservable bytes.
      *
@@ -625,6 +904,9 @@ private:
         if (next_read_index_ <= next_write_index) {
             return next_write_index - next_read_index_;
         }
+        if (is_mirrored_) {
+            return size_ - next_read_index_ + next_write_index;
+        }
         return size_ - next_read_index_;
     }
 
@@ -653,17 +935,38 @@ private:
     //! Atomic variable of the index of the next byte to write.
     atomic_type* atomic_next_write_index_;
 
+    /*!
+     * \brief Atomic variable of the number of threads waiting for changes of
+     * the index of the next byte to read.
+     */
+    atomic_type* atomic_read_index_waiters_;
+
+    /*!
+     * \brief Atomic variable of the number of threads waiting for changes of
+     * the index of the next byte to write.
+     */
+    atomic_type* atomic_write_index_waiters_;
+
     //! Pointer to the buffer.
     const char* buffer_;
 
     //! Size of the buffer.
     shm_stream_size_t size_;
 
+    //! Whether the buffer is mirrored.
+    bool is_mirrored_;
+
     //! Index of the next byte to read.
     shm_stream_size_t next_read_index_;
 
+    //! Cached value of atomic_next_write_index_.
+    shm_stream_size_t cached_next_write_index_;
+
     //! Number of bytes reserved to read currently.
     shm_stream_size_t reserved_;
+
+    //! Spinner used before sleeping in waiting operations.
+    adaptive_spinner spinner_;
 };
 
 }  // namespace details
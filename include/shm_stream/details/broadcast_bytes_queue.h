@@ -0,0 +1,425 @@
+/*
+ * Copyright 2023 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Definition of broadcast_bytes_queue class.
+ */
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+
+#include <boost/atomic/ipc_atomic.hpp>
+#include <boost/memory_order.hpp>
+
+#include "shm_stream/bytes_view.h"
+#include "shm_stream/c_interface/error_codes.h"
+#include "shm_stream/common_types.h"
+#include "shm_stream/details/broadcast_index_table.h"
+#include "shm_stream/details/index_policy.h"
+#include "shm_stream/details/light_bytes_queue.h"
+#include "shm_stream/shm_stream_assert.h"
+#include "shm_stream/shm_stream_exception.h"
+
+namespace shm_stream {
+namespace details {
+
+/*!
+ * \brief Class of writers of queues of bytes broadcast to multiple readers
+ * without waiting (possibly lock-free and wait-free).
+ *
+ * The writer reuses bytes in the buffer only after all the attached readers
+ * have read them.
+ *
+ * \tparam AtomicType Type of atomic variables.
+ *
+ * \thread_safety All operation is safe if only one writer exists.
+ */
+template <typename AtomicType = boost::atomics::ipc_atomic<shm_stream_size_t>>
+class broadcast_bytes_queue_writer {
+public:
+    //! Type of atomic variables.
+    using atomic_type = AtomicType;
+
+    //! Type of tables of indices.
+    using index_table_type = broadcast_index_table<atomic_type>;
+
+    //! Type of sizes and indices.
+    using size_type = typename index_table_type::size_type;
+
+    //! Type of views of mutable bytes.
+    using mutable_bytes_view = basic_mutable_bytes_view<size_type>;
+
+    //! Type of the policy of indices.
+    using index_policy = wrapped_index_policy;
+
+    /*!
+     * \brief Get the maximum size of buffers.
+     *
+     * \return Maximum size of buffers.
+     */
+    static constexpr size_type max_size() noexcept {
+        return light_bytes_queue_writer<atomic_type>::max_size();
+    }
+
+    /*!
+     * \brief Get the minimum size of buffers.
+     *
+     * \return Minimum size of buffers.
+     */
+    static constexpr size_type min_size() noexcept {
+        return light_bytes_queue_writer<atomic_type>::min_size();
+    }
+
+    /*!
+     * \brief Constructor.
+     *
+     * \param[in] indices Table of the indices of the writer and the readers.
+     * \param[in] buffer Buffer of data.
+     */
+    broadcast_bytes_queue_writer(
+        index_table_type& indices, mutable_bytes_view buffer)
+        : indices_(&indices),
+          buffer_(buffer.data()),
+          size_(buffer.size()),
+          next_write_index_(0U),
+          cached_slowest_read_index_(0U),
+          reserved_(0U) {
+        SHM_STREAM_ASSERT(buffer_ != nullptr);
+
+        if (size_ < min_size() || size_ > max_size()) {
+            throw shm_stream_error(c_shm_stream_error_code_invalid_argument);
+        }
+
+        next_write_index_ =
+            indices_->writer().load(boost::memory_order::relaxed);
+        SHM_STREAM_ASSERT(next_write_index_ < size_);
+        cached_slowest_read_index_ = load_slowest_read_index();
+    }
+
+    /*!
+     * \brief Get the number of the available bytes to write.
+     *
+     * \return Number of the available bytes to write.
+     */
+    [[nodiscard]] size_type available_size() const noexcept {
+        return index_policy::writable_size(
+            size_, next_write_index_, load_slowest_read_index());
+    }
+
+    /*!
+     * \brief Try to reserve some bytes to write.
+     *
+     * \param[in] expected_size Expected number of bytes to reserve to write.
+     * \return Buffer of the reserved bytes.
+     *
+     * \note This function tries to reserve given number of bytes, but a smaller
+     * or empty buffer may be returned.
+     * \note This function loads the indices of the readers only when the
+     * cached index of the slowest reader is not enough to reserve the expected
+     * number of bytes.
+     */
+    [[nodiscard]] mutable_bytes_view try_reserve(
+        size_type expected_size = max_size()) noexcept {
+        size_type max_reservable_size =
+            calc_reservable_size(cached_slowest_read_index_);
+        if (max_reservable_size < expected_size) {
+            cached_slowest_read_index_ = load_slowest_read_index();
+            max_reservable_size =
+                calc_reservable_size(cached_slowest_read_index_);
+        }
+        reserved_ = std::min(expected_size, max_reservable_size);
+
+        return mutable_bytes_view(buffer_ + next_write_index_, reserved_);
+    }
+
+    /*!
+     * \brief Save written bytes as completed and ready to be read by readers.
+     *
+     * \param[in] written_size Number of written bytes to save.
+     */
+    void commit(size_type written_size) noexcept {
+        SHM_STREAM_ASSERT(written_size <= reserved_);
+        next_write_index_ =
+            index_policy::advance(size_, next_write_index_, written_size);
+        SHM_STREAM_ASSERT(next_write_index_ < size_);
+        reserved_ = 0U;
+
+        // Sequential consistency is required to synchronize with readers
+        // attaching concurrently.
+        indices_->writer().store(
+            next_write_index_, boost::memory_order::seq_cst);
+    }
+
+private:
+    /*!
+     * \brief Load the index of the slowest reader.
+     *
+     * \return Index of the slowest reader, or the index of the writer if no
+     * reader is attached.
+     */
+    [[nodiscard]] size_type load_slowest_read_index() const noexcept {
+        size_type slowest_read_index = next_write_index_;
+        size_type min_writable_size = size_ - 1U;
+        for (std::size_t slot = 0U; slot < index_table_type::max_readers();
+             ++slot) {
+            const size_type read_index =
+                indices_->reader(slot).load(boost::memory_order::seq_cst);
+            if (read_index == index_table_type::detached_index()) {
+                continue;
+            }
+            SHM_STREAM_ASSERT(read_index < size_);
+            const size_type writable_size = index_policy::writable_size(
+                size_, next_write_index_, read_index);
+            if (writable_size < min_writable_size) {
+                min_writable_size = writable_size;
+                slowest_read_index = read_index;
+            }
+        }
+        return slowest_read_index;
+    }
+
+    /*!
+     * \brief Calculate the maximum number of bytes which can be reserved.
+     *
+     * \param[in] slowest_read_index Index of the slowest reader.
+     * \return Number of bytes.
+     */
+    [[nodiscard]] size_type calc_reservable_size(
+        size_type slowest_read_index) const noexcept {
+        return std::min<size_type>(
+            index_policy::writable_size(
+                size_, next_write_index_, slowest_read_index),
+            size_ - next_write_index_);
+    }
+
+    //! Table of indices.
+    index_table_type* indices_;
+
+    //! Buffer.
+    char* buffer_;
+
+    //! Size of the buffer.
+    size_type size_;
+
+    //! Index of the next byte to write.
+    size_type next_write_index_;
+
+    //! Cached index of the slowest reader.
+    size_type cached_slowest_read_index_;
+
+    //! Number of reserved bytes.
+    size_type reserved_;
+};
+
+/*!
+ * \brief Class of readers of queues of bytes broadcast to multiple readers
+ * without waiting (possibly lock-free and wait-free).
+ *
+ * A reader attaches to a free slot in the table of indices when constructed,
+ * starting from the bytes written after the attachment, and detaches when
+ * destructed.
+ *
+ * \tparam AtomicType Type of atomic variables.
+ *
+ * \thread_safety All operation is safe if each reader is used in one thread.
+ */
+template <typename AtomicType = boost::atomics::ipc_atomic<shm_stream_size_t>>
+class broadcast_bytes_queue_reader {
+public:
+    //! Type of atomic variables.
+    using atomic_type = AtomicType;
+
+    //! Type of tables of indices.
+    using index_table_type = broadcast_index_table<atomic_type>;
+
+    //! Type of queues of bytes for each reader.
+    using bytes_queue_type = light_bytes_queue_reader<atomic_type>;
+
+    //! Type of sizes and indices.
+    using size_type = typename index_table_type::size_type;
+
+    //! Type of views of bytes.
+    using bytes_view = basic_bytes_view<size_type>;
+
+    /*!
+     * \brief Get the maximum size of buffers.
+     *
+     * \return Maximum size of buffers.
+     */
+    static constexpr size_type max_size() noexcept {
+        return bytes_queue_type::max_size();
+    }
+
+    /*!
+     * \brief Constructor.
+     *
+     * \param[in] indices Table of the indices of the writer and the readers.
+     * \param[in] buffer Buffer of data.
+     */
+    broadcast_bytes_queue_reader(index_table_type& indices, bytes_view buffer)
+        : indices_(&indices),
+          slot_(attach(indices, buffer.size())),
+          bytes_queue_(indices.view(slot_), buffer) {}
+
+    // Prevent copy.
+    broadcast_bytes_queue_reader(const broadcast_bytes_queue_reader&) = delete;
+    auto operator=(const broadcast_bytes_queue_reader&) = delete;
+
+    /*!
+     * \brief Move constructor.
+     *
+     * \param[in] obj Object to move from.
+     */
+    broadcast_bytes_queue_reader(broadcast_bytes_queue_reader&& obj) noexcept
+        : indices_(obj.indices_),
+          slot_(std::exchange(obj.slot_, no_slot())),
+          bytes_queue_(std::move(obj.bytes_queue_)) {}
+
+    /*!
+     * \brief Move assignment operator.
+     *
+     * \param[in] obj Object to move from.
+     * \return This.
+     */
+    broadcast_bytes_queue_reader& operator=(
+        broadcast_bytes_queue_reader&& obj) noexcept {
+        if (this != &obj) {
+            detach();
+            indices_ = obj.indices_;
+            slot_ = std::exchange(obj.slot_, no_slot());
+            bytes_queue_ = std::move(obj.bytes_queue_);
+        }
+        return *this;
+    }
+
+    /*!
+     * \brief Destructor.
+     *
+     * \note This function detaches this reader.
+     */
+    ~broadcast_bytes_queue_reader() noexcept { detach(); }
+
+    /*!
+     * \brief Get the slot of this reader in the table of indices.
+     *
+     * \return Slot.
+     */
+    [[nodiscard]] std::size_t slot() const noexcept { return slot_; }
+
+    /*!
+     * \brief Get the number of the available bytes to read.
+     *
+     * \return Number of the available bytes to read.
+     */
+    [[nodiscard]] size_type available_size() const noexcept {
+        return bytes_queue_.available_size();
+    }
+
+    /*!
+     * \brief Try to reserve some bytes to read.
+     *
+     * \param[in] expected_size Expected number of bytes to reserve to read.
+     * \return Buffer of the reserved bytes.
+     *
+     * \note This function tries to reserve given number of bytes, but a smaller
+     * or empty buffer may be returned.
+     */
+    [[nodiscard]] bytes_view try_reserve(
+        size_type expected_size = max_size()) noexcept {
+        return bytes_queue_.try_reserve(expected_size);
+    }
+
+    /*!
+     * \brief Set some bytes as finished to read.
+     *
+     * \param[in] read_size Number of read bytes to save.
+     */
+    void commit(size_type read_size) noexcept {
+        bytes_queue_.commit(read_size);
+    }
+
+private:
+    /*!
+     * \brief Get the value of slots representing no slot.
+     *
+     * \return Value.
+     */
+    static constexpr std::size_t no_slot() noexcept {
+        return index_table_type::max_readers();
+    }
+
+    /*!
+     * \brief Attach a reader to a free slot.
+     *
+     * \param[in] indices Table of indices.
+     * \param[in] size Size of the buffer.
+     * \return Slot.
+     */
+    [[nodiscard]] static std::size_t attach(
+        index_table_type& indices, size_type size) {
+        if (size < bytes_queue_type::min_size() ||
+            size > bytes_queue_type::max_size()) {
+            throw shm_stream_error(c_shm_stream_error_code_invalid_argument);
+        }
+
+        size_type write_index =
+            indices.writer().load(boost::memory_order::seq_cst);
+        for (std::size_t slot = 0U; slot < index_table_type::max_readers();
+             ++slot) {
+            size_type expected = index_table_type::detached_index();
+            if (!indices.reader(slot).compare_exchange_strong(expected,
+                    write_index, boost::memory_order::seq_cst)) {
+                continue;
+            }
+            // Repeat until the writer surely sees this reader before
+            // writing after the index of this reader.
+            while (true) {
+                const size_type current_write_index =
+                    indices.writer().load(boost::memory_order::seq_cst);
+                if (current_write_index == write_index) {
+                    return slot;
+                }
+                write_index = current_write_index;
+                indices.reader(slot).store(
+                    write_index, boost::memory_order::seq_cst);
+            }
+        }
+        throw shm_stream_error(c_shm_stream_error_code_too_many_readers);
+    }
+
+    //! Detach this reader.
+    void detach() noexcept {
+        if (slot_ != no_slot()) {
+            indices_->reader(slot_).store(index_table_type::detached_index(),
+                boost::memory_order::release);
+            slot_ = no_slot();
+        }
+    }
+
+    //! Table of indices.
+    index_table_type* indices_;
+
+    //! Slot of this reader.
+    std::size_t slot_;
+
+    //! Queue of bytes.
+    bytes_queue_type bytes_queue_;
+};
+
+}  // namespace details
+}  // namespace shm_stream
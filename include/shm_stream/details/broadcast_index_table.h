@@ -0,0 +1,155 @@
+/*
+ * Copyright 2023 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Definition of broadcast_index_table class.
+ */
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+
+#include <boost/atomic/ipc_atomic.hpp>
+
+#include "shm_stream/common_types.h"
+#include "shm_stream/details/atomic_index_pair.h"
+#include "shm_stream/details/cache_line_size.h"
+
+namespace shm_stream {
+namespace details {
+
+/*!
+ * \brief Class of tables of atomic variables for indices of a writer and
+ * multiple readers.
+ *
+ * \tparam AtomicType Type of atomic variables.
+ */
+template <typename AtomicType = boost::atomics::ipc_atomic<shm_stream_size_t>>
+class broadcast_index_table {
+public:
+    //! Type of the atomic variables.
+    using atomic_type = AtomicType;
+
+    //! Type of indices.
+    using size_type = typename atomic_type::value_type;
+
+    static_assert(std::is_same<size_type, shm_stream_size_t>::value ||
+            std::is_same<size_type, shm_stream_size64_t>::value,
+        "Type of values in atomic variables must be equal to "
+        "shm_stream_size_t or shm_stream_size64_t.");
+
+    /*!
+     * \brief Get the maximum number of readers.
+     *
+     * \return Number of readers.
+     */
+    static constexpr std::size_t max_readers() noexcept {
+        return 16U;  // NOLINT
+    }
+
+    /*!
+     * \brief Get the value of indices of readers not attached.
+     *
+     * \return Value.
+     */
+    static constexpr size_type detached_index() noexcept {
+        return std::numeric_limits<size_type>::max();
+    }
+
+    /*!
+     * \brief Constructor.
+     */
+    broadcast_index_table() noexcept {
+        for (auto& slot : reader_slots_) {
+            slot.index.store(detached_index());
+        }
+    }
+
+    /*!
+     * \brief Get the index of the writer.
+     *
+     * \return Atomic variable of the index.
+     */
+    [[nodiscard]] atomic_type& writer() noexcept { return writer_index_; }
+
+    /*!
+     * \brief Get the number of threads waiting for changes of the index of the
+     * writer.
+     *
+     * \return Atomic variable of the number of threads.
+     */
+    [[nodiscard]] atomic_type& writer_waiters() noexcept {
+        return writer_waiters_;
+    }
+
+    /*!
+     * \brief Get the index of a reader.
+     *
+     * \param[in] slot Slot of the reader.
+     * \return Atomic variable of the index.
+     */
+    [[nodiscard]] atomic_type& reader(std::size_t slot) noexcept {
+        return reader_slots_[slot].index;
+    }
+
+    /*!
+     * \brief Get the number of threads waiting for changes of the index of a
+     * reader.
+     *
+     * \param[in] slot Slot of the reader.
+     * \return Atomic variable of the number of threads.
+     */
+    [[nodiscard]] atomic_type& reader_waiters(std::size_t slot) noexcept {
+        return reader_slots_[slot].waiters;
+    }
+
+    /*!
+     * \brief Get a view of the indices of the writer and a reader.
+     *
+     * \param[in] slot Slot of the reader.
+     * \return View.
+     */
+    [[nodiscard]] atomic_index_pair_view<atomic_type> view(
+        std::size_t slot) noexcept {
+        return atomic_index_pair_view<atomic_type>(&writer_index_,
+            &reader_slots_[slot].index, &writer_waiters_,
+            &reader_slots_[slot].waiters);
+    }
+
+private:
+    //! Struct of slots of readers.
+    struct reader_slot {
+        //! Index of the reader.
+        alignas(cache_line_size()) atomic_type index{0U};
+
+        //! Number of threads waiting for changes of the index of the reader.
+        atomic_type waiters{0U};
+    };
+
+    //! Index of the writer.
+    alignas(cache_line_size()) atomic_type writer_index_{0U};
+
+    //! Number of threads waiting for changes of the index of the writer.
+    atomic_type writer_waiters_{0U};
+
+    //! Slots of readers.
+    std::array<reader_slot, max_readers()> reader_slots_{};
+};
+
+}  // namespace details
+}  // namespace shm_stream
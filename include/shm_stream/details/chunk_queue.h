@@ -0,0 +1,459 @@
+/*
+ * Copyright 2023 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Definition of chunk_queue class.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+
+#include <boost/atomic/ipc_atomic.hpp>
+
+#include "shm_stream/bytes_view.h"
+#include "shm_stream/c_interface/error_codes.h"
+#include "shm_stream/common_types.h"
+#include "shm_stream/details/atomic_index_pair.h"
+#include "shm_stream/details/cache_line_size.h"
+#include "shm_stream/details/index_policy.h"
+#include "shm_stream/details/light_bytes_queue.h"
+#include "shm_stream/shm_stream_assert.h"
+#include "shm_stream/shm_stream_exception.h"
+
+namespace shm_stream {
+namespace details {
+
+/*!
+ * \brief Struct of descriptors of chunks sent from the writer to the reader.
+ */
+struct chunk_descriptor {
+    //! Index of the chunk.
+    shm_stream_size_t index;
+
+    //! Number of bytes written to the chunk.
+    shm_stream_size_t size;
+};
+
+/*!
+ * \brief Class of views of pools of chunks.
+ *
+ * Chunks have the same size, and each chunk starts at a boundary of cache
+ * lines.
+ */
+class chunk_pool_view {
+public:
+    /*!
+     * \brief Get the maximum number of chunks.
+     *
+     * \return Number of chunks.
+     */
+    static constexpr shm_stream_size_t max_chunks() noexcept {
+        return static_cast<shm_stream_size_t>(1U) << 24U;
+    }
+
+    /*!
+     * \brief Calculate the distance between the beginnings of chunks.
+     *
+     * \param[in] chunk_size Size of each chunk.
+     * \return Number of bytes.
+     */
+    static constexpr std::size_t chunk_stride(
+        shm_stream_size_t chunk_size) noexcept {
+        return (static_cast<std::size_t>(chunk_size) + cache_line_size() - 1U) &
+            ~(cache_line_size() - 1U);
+    }
+
+    /*!
+     * \brief Check parameters of a pool.
+     *
+     * \param[in] num_chunks Number of chunks.
+     * \param[in] chunk_size Size of each chunk.
+     */
+    static void check_params(
+        shm_stream_size_t num_chunks, shm_stream_size_t chunk_size) {
+        if (num_chunks == 0U || num_chunks > max_chunks() ||
+            chunk_size == 0U) {
+            throw shm_stream_error(c_shm_stream_error_code_invalid_argument);
+        }
+    }
+
+    /*!
+     * \brief Constructor.
+     *
+     * \param[in] chunks Address of the first chunk. (Must be aligned to cache
+     * lines.)
+     * \param[in] num_chunks Number of chunks.
+     * \param[in] chunk_size Size of each chunk.
+     */
+    chunk_pool_view(char* chunks, shm_stream_size_t num_chunks,
+        shm_stream_size_t chunk_size)
+        : chunks_(chunks),
+          num_chunks_(num_chunks),
+          chunk_size_(chunk_size),
+          stride_(chunk_stride(chunk_size)) {
+        SHM_STREAM_ASSERT(chunks_ != nullptr);
+        check_params(num_chunks_, chunk_size_);
+    }
+
+    /*!
+     * \brief Get the number of chunks.
+     *
+     * \return Number of chunks.
+     */
+    [[nodiscard]] shm_stream_size_t num_chunks() const noexcept {
+        return num_chunks_;
+    }
+
+    /*!
+     * \brief Get the size of each chunk.
+     *
+     * \return Number of bytes.
+     */
+    [[nodiscard]] shm_stream_size_t chunk_size() const noexcept {
+        return chunk_size_;
+    }
+
+    /*!
+     * \brief Get a chunk.
+     *
+     * \param[in] index Index of the chunk.
+     * \return Address of the chunk.
+     */
+    [[nodiscard]] char* chunk(shm_stream_size_t index) const noexcept {
+        SHM_STREAM_ASSERT(index < num_chunks_);
+        return chunks_ + static_cast<std::size_t>(index) * stride_;
+    }
+
+    /*!
+     * \brief Get the index of a chunk.
+     *
+     * \param[in] address Address of the chunk.
+     * \return Index of the chunk.
+     */
+    [[nodiscard]] shm_stream_size_t index_of(
+        const char* address) const noexcept {
+        SHM_STREAM_ASSERT(address >= chunks_);
+        const auto offset = static_cast<std::size_t>(address - chunks_);
+        SHM_STREAM_ASSERT(offset % stride_ == 0U);
+        const auto index = static_cast<shm_stream_size_t>(offset / stride_);
+        SHM_STREAM_ASSERT(index < num_chunks_);
+        return index;
+    }
+
+private:
+    //! Address of the first chunk.
+    char* chunks_;
+
+    //! Number of chunks.
+    shm_stream_size_t num_chunks_;
+
+    //! Size of each chunk.
+    shm_stream_size_t chunk_size_;
+
+    //! Distance between the beginnings of chunks.
+    std::size_t stride_;
+};
+
+/*!
+ * \brief Class of common definitions of queues of chunks.
+ *
+ * The writer sends descriptors of chunks through a queue of descriptors, and
+ * the reader returns indices of chunks through a queue of returned chunks.
+ * Both queues have enough capacity for all chunks, so pushing to the queues
+ * never fails.
+ *
+ * \tparam AtomicType Type of atomic variables.
+ */
+template <typename AtomicType = boost::atomics::ipc_atomic<shm_stream_size_t>>
+class chunk_queue_base {
+public:
+    //! Type of atomic variables.
+    using atomic_type = AtomicType;
+
+    //! Type of sizes.
+    using size_type = typename atomic_type::value_type;
+
+    //! Type of views of bytes.
+    using bytes_view = basic_bytes_view<size_type>;
+
+    //! Type of views of mutable bytes.
+    using mutable_bytes_view = basic_mutable_bytes_view<size_type>;
+
+    //! Type of the policy of indices in queues.
+    using index_policy = masked_index_policy;
+
+    /*!
+     * \brief Calculate the size of the buffer of the queue of descriptors.
+     *
+     * \param[in] num_chunks Number of chunks.
+     * \return Number of bytes.
+     */
+    static size_type descriptor_buffer_size(shm_stream_size_t num_chunks) {
+        return queue_capacity(num_chunks) *
+            static_cast<size_type>(sizeof(chunk_descriptor));
+    }
+
+    /*!
+     * \brief Calculate the size of the buffer of the queue of returned
+     * chunks.
+     *
+     * \param[in] num_chunks Number of chunks.
+     * \return Number of bytes.
+     */
+    static size_type return_buffer_size(shm_stream_size_t num_chunks) {
+        return queue_capacity(num_chunks) *
+            static_cast<size_type>(sizeof(shm_stream_size_t));
+    }
+
+    /*!
+     * \brief Initialize the queue of returned chunks with all chunks.
+     *
+     * \param[in] return_indices Atomic variables of the indices of the queue of
+     * returned chunks.
+     * \param[in] return_buffer Buffer of the queue of returned chunks.
+     * \param[in] num_chunks Number of chunks.
+     */
+    static void initialize_returned_chunks(
+        atomic_index_pair_view<atomic_type> return_indices,
+        mutable_bytes_view return_buffer, shm_stream_size_t num_chunks) {
+        light_bytes_queue_writer<atomic_type, index_policy> writer{
+            return_indices, return_buffer};
+        for (shm_stream_size_t i = 0U; i < num_chunks; ++i) {
+            push(writer, i);
+        }
+    }
+
+protected:
+    /*!
+     * \brief Calculate the capacity of queues.
+     *
+     * \param[in] num_chunks Number of chunks.
+     * \return Number of elements.
+     */
+    static size_type queue_capacity(shm_stream_size_t num_chunks) {
+        chunk_pool_view::check_params(num_chunks, 1U);
+        size_type capacity = 2U;
+        while (capacity < num_chunks) {
+            capacity *= 2U;
+        }
+        return capacity;
+    }
+
+    /*!
+     * \brief Push an element to a queue.
+     *
+     * \tparam T Type of the element.
+     * \param[in] writer Writer of the queue.
+     * \param[in] value Element.
+     */
+    template <typename T>
+    static void push(
+        light_bytes_queue_writer<atomic_type, index_policy>& writer,
+        const T& value) noexcept {
+        const auto buffer =
+            writer.try_reserve(static_cast<size_type>(sizeof(T)));
+        // Queues have enough capacity and elements never cross the end of the
+        // buffers.
+        SHM_STREAM_ASSERT(buffer.size() == sizeof(T));
+        std::memcpy(buffer.data(), &value, sizeof(T));
+        writer.commit(static_cast<size_type>(sizeof(T)));
+    }
+
+    /*!
+     * \brief Pop an element from a queue.
+     *
+     * \tparam T Type of the element.
+     * \param[in] reader Reader of the queue.
+     * \param[out] value Element.
+     * \retval true An element was popped.
+     * \retval false The queue is empty.
+     */
+    template <typename T>
+    static bool pop(light_bytes_queue_reader<atomic_type, index_policy>& reader,
+        T& value) noexcept {
+        const auto buffer =
+            reader.try_reserve(static_cast<size_type>(sizeof(T)));
+        if (buffer.size() < sizeof(T)) {
+            return false;
+        }
+        std::memcpy(&value, buffer.data(), sizeof(T));
+        reader.commit(static_cast<size_type>(sizeof(T)));
+        return true;
+    }
+};
+
+/*!
+ * \brief Class of writers of queues of chunks.
+ *
+ * \tparam AtomicType Type of atomic variables.
+ *
+ * \thread_safety All operation is safe if only one writer exists.
+ */
+template <typename AtomicType = boost::atomics::ipc_atomic<shm_stream_size_t>>
+class chunk_queue_writer : public chunk_queue_base<AtomicType> {
+public:
+    //! Type of the base class.
+    using base_type = chunk_queue_base<AtomicType>;
+
+    using typename base_type::atomic_type;
+    using typename base_type::bytes_view;
+    using typename base_type::index_policy;
+    using typename base_type::mutable_bytes_view;
+    using typename base_type::size_type;
+
+    /*!
+     * \brief Constructor.
+     *
+     * \param[in] descriptor_indices Atomic variables of the indices of the
+     * queue of descriptors.
+     * \param[in] descriptor_buffer Buffer of the queue of descriptors.
+     * \param[in] return_indices Atomic variables of the indices of the queue
+     * of returned chunks.
+     * \param[in] return_buffer Buffer of the queue of returned chunks.
+     * \param[in] chunks Pool of chunks.
+     */
+    chunk_queue_writer(atomic_index_pair_view<atomic_type> descriptor_indices,
+        mutable_bytes_view descriptor_buffer,
+        atomic_index_pair_view<atomic_type> return_indices,
+        bytes_view return_buffer, chunk_pool_view chunks)
+        : descriptor_writer_(descriptor_indices, descriptor_buffer),
+          return_reader_(return_indices, return_buffer),
+          chunks_(chunks) {}
+
+    /*!
+     * \brief Get the size of each chunk.
+     *
+     * \return Number of bytes.
+     */
+    [[nodiscard]] shm_stream_size_t chunk_size() const noexcept {
+        return chunks_.chunk_size();
+    }
+
+    /*!
+     * \brief Try to allocate a chunk to write.
+     *
+     * \return Buffer of the chunk with the size of chunks. If no chunk is free
+     * now, the data pointer of the buffer is null.
+     */
+    [[nodiscard]] mutable_bytes_view try_allocate() noexcept {
+        shm_stream_size_t index = 0U;
+        if (!base_type::pop(return_reader_, index)) {
+            return mutable_bytes_view(nullptr, 0U);
+        }
+        return mutable_bytes_view(chunks_.chunk(index), chunks_.chunk_size());
+    }
+
+    /*!
+     * \brief Send a chunk to the reader.
+     *
+     * \param[in] chunk Buffer of the chunk returned by try_allocate function.
+     * \param[in] size Number of bytes written to the chunk.
+     */
+    void send(mutable_bytes_view chunk, shm_stream_size_t size) noexcept {
+        SHM_STREAM_ASSERT(size <= chunks_.chunk_size());
+        base_type::push(descriptor_writer_,
+            chunk_descriptor{chunks_.index_of(chunk.data()), size});
+    }
+
+private:
+    //! Writer of the queue of descriptors.
+    light_bytes_queue_writer<atomic_type, index_policy> descriptor_writer_;
+
+    //! Reader of the queue of returned chunks.
+    light_bytes_queue_reader<atomic_type, index_policy> return_reader_;
+
+    //! Pool of chunks.
+    chunk_pool_view chunks_;
+};
+
+/*!
+ * \brief Class of readers of queues of chunks.
+ *
+ * \tparam AtomicType Type of atomic variables.
+ *
+ * \thread_safety All operation is safe if only one reader exists.
+ */
+template <typename AtomicType = boost::atomics::ipc_atomic<shm_stream_size_t>>
+class chunk_queue_reader : public chunk_queue_base<AtomicType> {
+public:
+    //! Type of the base class.
+    using base_type = chunk_queue_base<AtomicType>;
+
+    using typename base_type::atomic_type;
+    using typename base_type::bytes_view;
+    using typename base_type::index_policy;
+    using typename base_type::mutable_bytes_view;
+    using typename base_type::size_type;
+
+    /*!
+     * \brief Constructor.
+     *
+     * \param[in] descriptor_indices Atomic variables of the indices of the
+     * queue of descriptors.
+     * \param[in] descriptor_buffer Buffer of the queue of descriptors.
+     * \param[in] return_indices Atomic variables of the indices of the queue
+     * of returned chunks.
+     * \param[in] return_buffer Buffer of the queue of returned chunks.
+     * \param[in] chunks Pool of chunks.
+     */
+    chunk_queue_reader(atomic_index_pair_view<atomic_type> descriptor_indices,
+        bytes_view descriptor_buffer,
+        atomic_index_pair_view<atomic_type> return_indices,
+        mutable_bytes_view return_buffer, chunk_pool_view chunks)
+        : descriptor_reader_(descriptor_indices, descriptor_buffer),
+          return_writer_(return_indices, return_buffer),
+          chunks_(chunks) {}
+
+    /*!
+     * \brief Try to receive a chunk.
+     *
+     * \return Buffer of the bytes written to the chunk. If no chunk has been
+     * sent, the data pointer of the buffer is null.
+     *
+     * \note The chunk must be returned to the writer by release function after
+     * reading it.
+     */
+    [[nodiscard]] bytes_view try_receive() noexcept {
+        chunk_descriptor descriptor{0U, 0U};
+        if (!base_type::pop(descriptor_reader_, descriptor)) {
+            return bytes_view(nullptr, 0U);
+        }
+        return bytes_view(chunks_.chunk(descriptor.index), descriptor.size);
+    }
+
+    /*!
+     * \brief Return a chunk to the writer.
+     *
+     * \param[in] chunk Buffer of the chunk returned by try_receive function.
+     */
+    void release(bytes_view chunk) noexcept {
+        base_type::push(return_writer_, chunks_.index_of(chunk.data()));
+    }
+
+private:
+    //! Reader of the queue of descriptors.
+    light_bytes_queue_reader<atomic_type, index_policy> descriptor_reader_;
+
+    //! Writer of the queue of returned chunks.
+    light_bytes_queue_writer<atomic_type, index_policy> return_writer_;
+
+    //! Pool of chunks.
+    chunk_pool_view chunks_;
+};
+
+}  // namespace details
+}  // namespace shm_stream
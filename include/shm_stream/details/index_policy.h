@@ -0,0 +1,233 @@
+/*
+ * Copyright 2023 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Definition of policies of indices in queues of bytes.
+ */
+#pragma once
+
+namespace shm_stream {
+namespace details {
+
+/*!
+ * \brief Policy of indices wrapped into the range of the buffer.
+ *
+ * Indices are always smaller than the size of the buffer, and one byte of the
+ * buffer is kept unused to distinguish a full buffer from an empty one. Any
+ * size of buffers can be used.
+ */
+struct wrapped_index_policy {
+    /*!
+     * \brief Check whether a size of buffers can be used.
+     *
+     * \tparam SizeType Type of sizes.
+     * \param[in] size Size of the buffer.
+     * \return Whether the size can be used.
+     */
+    template <typename SizeType>
+    [[nodiscard]] static constexpr bool is_valid_size(
+        SizeType size) noexcept {
+        (void)size;
+        return true;
+    }
+
+    /*!
+     * \brief Check whether an index is valid.
+     *
+     * \tparam SizeType Type of sizes.
+     * \param[in] size Size of the buffer.
+     * \param[in] index Index.
+     * \return Whether the index is valid.
+     */
+    template <typename SizeType>
+    [[nodiscard]] static constexpr bool is_valid_index(
+        SizeType size, SizeType index) noexcept {
+        return index < size;
+    }
+
+    /*!
+     * \brief Calculate the number of bytes available to write.
+     *
+     * \tparam SizeType Type of sizes.
+     * \param[in] size Size of the buffer.
+     * \param[in] write_index Index of the next byte to write.
+     * \param[in] read_index Index of the next byte to read.
+     * \return Number of bytes.
+     */
+    template <typename SizeType>
+    [[nodiscard]] static constexpr SizeType writable_size(SizeType size,
+        SizeType write_index, SizeType read_index) noexcept {
+        if (read_index <= write_index) {
+            read_index += size;
+        }
+        return read_index - write_index - 1U;
+    }
+
+    /*!
+     * \brief Calculate the number of bytes available to read.
+     *
+     * \tparam SizeType Type of sizes.
+     * \param[in] size Size of the buffer.
+     * \param[in] write_index Index of the next byte to write.
+     * \param[in] read_index Index of the next byte to read.
+     * \return Number of bytes.
+     */
+    template <typename SizeType>
+    [[nodiscard]] static constexpr SizeType readable_size(SizeType size,
+        SizeType write_index, SizeType read_index) noexcept {
+        if (write_index < read_index) {
+            write_index += size;
+        }
+        return write_index - read_index;
+    }
+
+    /*!
+     * \brief Get the position of an index in the buffer.
+     *
+     * \tparam SizeType Type of sizes.
+     * \param[in] size Size of the buffer.
+     * \param[in] index Index.
+     * \return Position in the buffer.
+     */
+    template <typename SizeType>
+    [[nodiscard]] static constexpr SizeType position(
+        SizeType size, SizeType index) noexcept {
+        (void)size;
+        return index;
+    }
+
+    /*!
+     * \brief Advance an index.
+     *
+     * \tparam SizeType Type of sizes.
+     * \param[in] size Size of the buffer.
+     * \param[in] index Index.
+     * \param[in] num_bytes Number of bytes to advance.
+     * \return Advanced index.
+     */
+    template <typename SizeType>
+    [[nodiscard]] static constexpr SizeType advance(
+        SizeType size, SizeType index, SizeType num_bytes) noexcept {
+        index += num_bytes;
+        if (index >= size) {
+            index -= size;
+        }
+        return index;
+    }
+};
+
+/*!
+ * \brief Policy of free-running indices masked by the size of the buffer.
+ *
+ * Indices are counters of bytes which overflow naturally, and positions in
+ * the buffer are calculated by masking the indices. The size of the buffer
+ * must be a power of two, and the full capacity of the buffer can be used.
+ */
+struct masked_index_policy {
+    /*!
+     * \brief Check whether a size of buffers can be used.
+     *
+     * \tparam SizeType Type of sizes.
+     * \param[in] size Size of the buffer.
+     * \return Whether the size can be used.
+     */
+    template <typename SizeType>
+    [[nodiscard]] static constexpr bool is_valid_size(
+        SizeType size) noexcept {
+        return (size & (size - 1U)) == 0U;
+    }
+
+    /*!
+     * \brief Check whether an index is valid.
+     *
+     * \tparam SizeType Type of sizes.
+     * \param[in] size Size of the buffer.
+     * \param[in] index Index.
+     * \return Whether the index is valid.
+     */
+    template <typename SizeType>
+    [[nodiscard]] static constexpr bool is_valid_index(
+        SizeType size, SizeType index) noexcept {
+        (void)size;
+        (void)index;
+        return true;
+    }
+
+    /*!
+     * \brief Calculate the number of bytes available to write.
+     *
+     * \tparam SizeType Type of sizes.
+     * \param[in] size Size of the buffer.
+     * \param[in] write_index Index of the next byte to write.
+     * \param[in] read_index Index of the next byte to read.
+     * \return Number of bytes.
+     */
+    template <typename SizeType>
+    [[nodiscard]] static constexpr SizeType writable_size(SizeType size,
+        SizeType write_index, SizeType read_index) noexcept {
+        return static_cast<SizeType>(
+            size - static_cast<SizeType>(write_index - read_index));
+    }
+
+    /*!
+     * \brief Calculate the number of bytes available to read.
+     *
+     * \tparam SizeType Type of sizes.
+     * \param[in] size Size of the buffer.
+     * \param[in] write_index Index of the next byte to write.
+     * \param[in] read_index Index of the next byte to read.
+     * \return Number of bytes.
+     */
+    template <typename SizeType>
+    [[nodiscard]] static constexpr SizeType readable_size(SizeType size,
+        SizeType write_index, SizeType read_index) noexcept {
+        (void)size;
+        return static_cast<SizeType>(write_index - read_index);
+    }
+
+    /*!
+     * \brief Get the position of an index in the buffer.
+     *
+     * \tparam SizeType Type of sizes.
+     * \param[in] size Size of the buffer.
+     * \param[in] index Index.
+     * \return Position in the buffer.
+     */
+    template <typename SizeType>
+    [[nodiscard]] static constexpr SizeType position(
+        SizeType size, SizeType index) noexcept {
+        return index & (size - 1U);
+    }
+
+    /*!
+     * \brief Advance an index.
+     *
+     * \tparam SizeType Type of sizes.
+     * \param[in] size Size of the buffer.
+     * \param[in] index Index.
+     * \param[in] num_bytes Number of bytes to advance.
+     * \return Advanced index.
+     */
+    template <typename SizeType>
+    [[nodiscard]] static constexpr SizeType advance(
+        SizeType size, SizeType index, SizeType num_bytes) noexcept {
+        (void)size;
+        return static_cast<SizeType>(index + num_bytes);
+    }
+};
+
+}  // namespace details
+}  // namespace shm_stream
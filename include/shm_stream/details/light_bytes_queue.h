@@ -21,6 +21,7 @@
 #pragma once
 
 #include <algorithm>
+#include <cstddef>
 #include <limits>
 #include <type_traits>
 
@@ -32,6 +33,8 @@
 #include "shm_stream/c_interface/error_codes.h"
 #include "shm_stream/common_types.h"
 #include "shm_stream/details/atomic_index_pair.h"
+#include "shm_stream/details/index_policy.h"
+#include "shm_stream/details/scatter_gather.h"
 #include "shm_stream/shm_stream_assert.h"
 #include "shm_stream/shm_stream_exception.h"
 
@@ -43,27 +46,39 @@ namespace details {
  * lock-free and wait-free).
  *
  * \tparam AtomicType Type of atomic variables.
+ * \tparam IndexPolicy Policy of indices (wrapped_index_policy or
+ * masked_index_policy).
  *
  * \thread_safety All operation is safe if only one writer exists.
  */
-template <typename AtomicType = boost::atomics::ipc_atomic<shm_stream_size_t>>
+template <typename AtomicType = boost::atomics::ipc_atomic<shm_stream_size_t>,
+    typename IndexPolicy = wrapped_index_policy>
 class light_bytes_queue_writer {
 public:
     //! Type of the atomic variables.
     using atomic_type = AtomicType;
 
-    static_assert(std::is_same<typename atomic_type::value_type,
-                      shm_stream_size_t>::value,
+    //! Type of the policy of indices.
+    using index_policy = IndexPolicy;
+
+    //! Type of sizes and indices.
+    using size_type = typename atomic_type::value_type;
+
+    static_assert(std::is_same<size_type, shm_stream_size_t>::value ||
+            std::is_same<size_type, shm_stream_size64_t>::value,
         "Type of values in atomic variables must be equal to "
-        "shm_stream_size_t.");
+        "shm_stream_size_t or shm_stream_size64_t.");
+
+    //! Type of views of non-constant byte sequences.
+    using mutable_bytes_view = basic_mutable_bytes_view<size_type>;
 
     /*!
      * \brief Get the maximum size of buffers.
      *
      * \return Size.
      */
-    static constexpr shm_stream_size_t max_size() noexcept {
-        return std::numeric_limits<shm_stream_size_t>::max() / 2U;
+    static constexpr size_type max_size() noexcept {
+        return std::numeric_limits<size_type>::max() / 2U;
     }
 
     /*!
@@ -71,7 +86,7 @@ public:
      *
      * \return Size.
      */
-    static constexpr shm_stream_size_t min_size() noexcept { return 2U; }
+    static constexpr size_type min_size() noexcept { return 2U; }
 
     /*!
      * \brief Get whether this implementation is lock-free in the current
@@ -93,27 +108,37 @@ public:
      * \param[in] atomic_indices Atomic variables of the indices of the next
      * bytes for the writer and the reader.
      * \param[in] buffer Buffer of data.
+     * \param[in] is_mirrored Whether the buffer is mirrored, i.e., mapped
+     * twice back-to-back so that bytes after the end of the buffer are the
+     * bytes at the beginning of the buffer.
      */
     light_bytes_queue_writer(atomic_index_pair_view<atomic_type> atomic_indices,
-        mutable_bytes_view buffer)
+        mutable_bytes_view buffer, bool is_mirrored = false)
         : atomic_next_read_index_(&atomic_indices.reader()),
           atomic_next_write_index_(&atomic_indices.writer()),
           buffer_(buffer.data()),
           size_(buffer.size()),
+          is_mirrored_(is_mirrored),
           next_write_index_(0U),
+          cached_next_read_index_(0U),
           reserved_(0U) {
         SHM_STREAM_ASSERT(atomic_next_read_index_ != nullptr);
-        SHM_STREAM_ASSERT(atomic_next_read_index_->load() < max_size());
         SHM_STREAM_ASSERT(atomic_next_write_index_ != nullptr);
-        SHM_STREAM_ASSERT(atomic_next_write_index_->load() < max_size());
         SHM_STREAM_ASSERT(buffer_ != nullptr);
 
-        if (size_ < min_size() || size_ > max_size()) {
+        if (size_ < min_size() || size_ > max_size() ||
+            !index_policy::is_valid_size(size_)) {
             throw shm_stream_error(c_shm_stream_error_code_invalid_argument);
         }
+        SHM_STREAM_ASSERT(index_policy::is_valid_index(
+            size_, atomic_next_read_index_->load()));
+        SHM_STREAM_ASSERT(index_policy::is_valid_index(
+            size_, atomic_next_write_index_->load()));
 
         next_write_index_ =
             atomic_next_write_index_->load(boost::memory_order::relaxed);
+        cached_next_read_index_ =
+            atomic_next_read_index_->load(boost::memory_order::acquire);
     }
 
     // Prevent copy.
@@ -139,15 +164,11 @@ public:
      *
      * \return Number of the available bytes to write.
      */
-    [[nodiscard]] shm_stream_size_t available_size() const noexcept {
-        shm_stream_size_t next_read_index =
+    [[nodiscard]] size_type available_size() const noexcept {
+        const size_type next_read_index =
             atomic_next_read_index_->load(boost::memory_order::relaxed);
-
-        if (next_read_index <= next_write_index_) {
-            next_read_index += size_;
-            SHM_STREAM_ASSERT(next_read_index > next_write_index_);
-        }
-        return next_read_index - next_write_index_ - 1U;
+        return index_policy::writable_size(
+            size_, next_write_index_, next_read_index);
     }
 
     /*!
@@ -161,18 +182,24 @@ public:
      * \note This function can return a buffer with a size smaller than the
      * return value of available_size function, because this queue is a circular
      * buffer and this function reserves continuous byte sequences from the
-     * circular buffer.
+     * circular buffer, unless the buffer is mirrored.
+     * \note This function loads the index of the reader only when the cached
+     * value of the index is not enough to reserve the expected number of bytes.
      */
     [[nodiscard]] mutable_bytes_view try_reserve(
-        shm_stream_size_t expected_size = max_size()) noexcept {
-        const shm_stream_size_t next_read_index =
-            atomic_next_read_index_->load(boost::memory_order::acquire);
-
-        const shm_stream_size_t max_reservable_size =
-            calc_reservable_size(next_read_index);
+        size_type expected_size = max_size()) noexcept {
+        size_type max_reservable_size =
+            calc_reservable_size(cached_next_read_index_);
+        if (max_reservable_size < expected_size) {
+            cached_next_read_index_ =
+                atomic_next_read_index_->load(boost::memory_order::acquire);
+            max_reservable_size = calc_reservable_size(cached_next_read_index_);
+        }
         reserved_ = std::min(expected_size, max_reservable_size);
 
-        return mutable_bytes_view(buffer_ + next_write_index_, reserved_);
+        return mutable_bytes_view(
+            buffer_ + index_policy::position(size_, next_write_index_),
+            reserved_);
     }
 
     /*!
@@ -180,17 +207,16 @@ public:
      *
      * \param[in] written_size Number of written bytes to save.
      */
-    void commit(shm_stream_size_t written_size) noexcept {
+    void commit(size_type written_size) noexcept {
         if (written_size == 0U) {
             return;
         }
         SHM_STREAM_ASSERT(written_size <= reserved_);
 
-        next_write_index_ += written_size;
-        if (next_write_index_ == size_) {
-            next_write_index_ = 0;
-        }
-        SHM_STREAM_ASSERT(next_write_index_ < size_);
+        next_write_index_ =
+            index_policy::advance(size_, next_write_index_, written_size);
+        SHM_STREAM_ASSERT(
+            index_policy::is_valid_index(size_, next_write_index_));
 
         atomic_next_write_index_->store(
             next_write_index_, boost::memory_order::release);
@@ -198,6 +224,49 @@ public:
         reserved_ = 0U;
     }
 
+    /*!
+     * \brief Try to write bytes gathered from pieces at once.
+     *
+     * \tparam Piece Type of views of the pieces.
+     * \param[in] pieces Pieces of bytes to write in order.
+     * \param[in] num_pieces Number of the pieces.
+     * \retval true All pieces were written.
+     * \retval false Space was not enough to write all pieces. (No byte is
+     * written.)
+     *
+     * \note This function copies all pieces into one reservation, wrapping
+     * around the end of the circular buffer, and saves them with a single
+     * store of the index.
+     */
+    template <typename Piece>
+    [[nodiscard]] bool try_write_gather(
+        const Piece* pieces, std::size_t num_pieces) noexcept {
+        size_type total_size = 0U;
+        if (!calc_total_piece_size(pieces, num_pieces, total_size)) {
+            return false;
+        }
+        if (total_size == 0U) {
+            return true;
+        }
+
+        if (index_policy::writable_size(size_, next_write_index_,
+                cached_next_read_index_) < total_size) {
+            cached_next_read_index_ =
+                atomic_next_read_index_->load(boost::memory_order::acquire);
+            if (index_policy::writable_size(size_, next_write_index_,
+                    cached_next_read_index_) < total_size) {
+                return false;
+            }
+        }
+
+        gather_to_circular_buffer(buffer_, size_,
+            index_policy::position(size_, next_write_index_), pieces,
+            num_pieces);
+        reserved_ = total_size;
+        commit(total_size);
+        return true;
+    }
+
 private:
     /*!
      * \brief Calculate the number of reservable bytes.
@@ -205,15 +274,15 @@ private:
      * \param[in] next_read_index Value of atomic_next_read_index_.
      * \return Number of reservable bytes.
      */
-    [[nodiscard]] shm_stream_size_t calc_reservable_size(
-        shm_stream_size_t next_read_index) const noexcept {
-        if (next_write_index_ < next_read_index) {
-            return next_read_index - next_write_index_ - 1U;
+    [[nodiscard]] size_type calc_reservable_size(
+        size_type next_read_index) const noexcept {
+        const size_type writable_size = index_policy::writable_size(
+            size_, next_write_index_, next_read_index);
+        if (is_mirrored_) {
+            return writable_size;
         }
-        if (next_read_index == 0U) {
-            return size_ - next_write_index_ - 1U;
-        }
-        return size_ - next_write_index_;
+        return std::min<size_type>(writable_size,
+            size_ - index_policy::position(size_, next_write_index_));
     }
 
     //! Atomic variable of the index of the next byte to read.
@@ -226,13 +295,19 @@ private:
     char* buffer_;
 
     //! Size of the buffer.
-    shm_stream_size_t size_;
+    size_type size_;
+
+    //! Whether the buffer is mirrored.
+    bool is_mirrored_;
 
     //! Index of the next byte to write.
-    shm_stream_size_t next_write_index_;
+    size_type next_write_index_;
+
+    //! Cached value of atomic_next_read_index_.
+    size_type cached_next_read_index_;
 
     //! Number of bytes reserved to write currently.
-    shm_stream_size_t reserved_;
+    size_type reserved_;
 };
 
 /*!
@@ -240,27 +315,39 @@ private:
  * lock-free and wait-free).
  *
  * \tparam AtomicType Type of atomic variables.
+ * \tparam IndexPolicy Policy of indices (wrapped_index_policy or
+ * masked_index_policy).
  *
  * \thread_safety All operation is safe if only one reader exists.
  */
-template <typename AtomicType = boost::atomics::ipc_atomic<shm_stream_size_t>>
+template <typename AtomicType = boost::atomics::ipc_atomic<shm_stream_size_t>,
+    typename IndexPolicy = wrapped_index_policy>
 class light_bytes_queue_reader {
 public:
     //! Type of the atomic variables.
     using atomic_type = AtomicType;
 
-    static_assert(std::is_same<typename atomic_type::value_type,
-                      shm_stream_size_t>::value,
+    //! Type of the policy of indices.
+    using index_policy = IndexPolicy;
+
+    //! Type of sizes and indices.
+    using size_type = typename atomic_type::value_type;
+
+    static_assert(std::is_same<size_type, shm_stream_size_t>::value ||
+            std::is_same<size_type, shm_stream_size64_t>::value,
         "Type of values in atomic variables must be equal to "
-        "shm_stream_size_t.");
+        "shm_stream_size_t or shm_stream_size64_t.");
+
+    //! Type of views of constant byte sequences.
+    using bytes_view = basic_bytes_view<size_type>;
 
     /*!
      * \brief Get the maximum size of buffers.
      *
      * \return Size.
      */
-    static constexpr shm_stream_size_t max_size() noexcept {
-        return std::numeric_limits<shm_stream_size_t>::max() / 2U;
+    static constexpr size_type max_size() noexcept {
+        return std::numeric_limits<size_type>::max() / 2U;
     }
 
     /*!
@@ -268,7 +355,7 @@ public:
      *
      * \return Size.
      */
-    static constexpr shm_stream_size_t min_size() noexcept { return 2U; }
+    static constexpr size_type min_size() noexcept { return 2U; }
 
     /*!
      * \brief Get whether this implementation is lock-free in the current
@@ -290,27 +377,37 @@ public:
      * \param[in] atomic_indices Atomic variables of the indices of the next
      * bytes for the writer and the reader.
      * \param[in] buffer Buffer of data.
+     * \param[in] is_mirrored Whether the buffer is mirrored, i.e., mapped
+     * twice back-to-back so that bytes after the end of the buffer are the
+     * bytes at the beginning of the buffer.
      */
-    light_bytes_queue_reader(
-        atomic_index_pair_view<atomic_type> atomic_indices, bytes_view buffer)
+    light_bytes_queue_reader(atomic_index_pair_view<atomic_type> atomic_indices,
+        bytes_view buffer, bool is_mirrored = false)
         : atomic_next_read_index_(&atomic_indices.reader()),
           atomic_next_write_index_(&atomic_indices.writer()),
           buffer_(buffer.data()),
           size_(buffer.size()),
+          is_mirrored_(is_mirrored),
           next_read_index_(0U),
+          cached_next_write_index_(0U),
           reserved_(0U) {
         SHM_STREAM_ASSERT(atomic_next_read_index_ != nullptr);
-        SHM_STREAM_ASSERT(atomic_next_read_index_->load() < max_size());
         SHM_STREAM_ASSERT(atomic_next_write_index_ != nullptr);
-        SHM_STREAM_ASSERT(atomic_next_write_index_->load() < max_size());
         SHM_STREAM_ASSERT(buffer_ != nullptr);
 
-        if (size_ < min_size() || size_ > max_size()) {
+        if (size_ < min_size() || size_ > max_size() ||
+            !index_policy::is_valid_size(size_)) {
             throw shm_stream_error(c_shm_stream_error_code_invalid_argument);
         }
+        SHM_STREAM_ASSERT(index_policy::is_valid_index(
+            size_, atomic_next_read_index_->load()));
+        SHM_STREAM_ASSERT(index_policy::is_valid_index(
+            size_, atomic_next_write_index_->load()));
 
         next_read_index_ =
             atomic_next_read_index_->load(boost::memory_order::relaxed);
+        cached_next_write_index_ =
+            atomic_next_write_index_->load(boost::memory_order::acquire);
     }
 
     // Prevent copy.
@@ -336,16 +433,11 @@ public:
      *
      * \return Number of the available bytes to read.
      */
-    [[nodiscard]] shm_stream_size_t available_size() const noexcept {
-        shm_stream_size_t next_write_index =
+    [[nodiscard]] size_type available_size() const noexcept {
+        const size_type next_write_index =
             atomic_next_write_index_->load(boost::memory_order::relaxed);
-
-        if (next_write_index < next_read_index_) {
-            next_write_index += size_;
-        }
-        SHM_STREAM_ASSERT(next_read_index_ <= next_write_index);
-
-        return next_write_index - next_read_index_;
+        return index_policy::readable_size(
+            size_, next_write_index, next_read_index_);
     }
 
     /*!
@@ -359,18 +451,25 @@ public:
      * \note This function can return a buffer with a size smaller than the
      * return value of available_size function, because this queue is a circular
      * buffer and this function reserves continuous byte sequences from the
-     * circular buffer.
+     * circular buffer, unless the buffer is mirrored.
+     * \note This function loads the index of the writer only when the cached
+     * value of the index is not enough to reserve the expected number of bytes.
      */
     [[nodiscard]] bytes_view try_reserve(
-        shm_stream_size_t expected_size = max_size()) noexcept {
-        const shm_stream_size_t next_write_index =
-            atomic_next_write_index_->load(boost::memory_order::acquire);
-
-        const shm_stream_size_t max_reservable_size =
-            calc_reservable_size(next_write_index);
+        size_type expected_size = max_size()) noexcept {
+        size_type max_reservable_size =
+            calc_reservable_size(cached_next_write_index_);
+        if (max_reservable_size < expected_size) {
+            cached_next_write_index_ =
+                atomic_next_write_index_->load(boost::memory_order::acquire);
+            max_reservable_size =
+                calc_reservable_size(cached_next_write_index_);
+        }
         reserved_ = std::min(expected_size, max_reservable_size);
 
-        return bytes_view(buffer_ + next_read_index_, reserved_);
+        return bytes_view(
+            buffer_ + index_policy::position(size_, next_read_index_),
+            reserved_);
     }
 
     /*!
@@ -378,17 +477,16 @@ public:
      *
      * \param[in] read_size Number of bytes to set finished to read.
      */
-    void commit(shm_stream_size_t read_size) noexcept {
+    void commit(size_type read_size) noexcept {
         if (read_size == 0U) {
             return;
         }
         SHM_STREAM_ASSERT(read_size <= reserved_);
 
-        next_read_index_ += read_size;
-        if (next_read_index_ == size_) {
-            next_read_index_ = 0;
-        }
-        SHM_STREAM_ASSERT(next_read_index_ < size_);
+        next_read_index_ =
+            index_policy::advance(size_, next_read_index_, read_size);
+        SHM_STREAM_ASSERT(
+            index_policy::is_valid_index(size_, next_read_index_));
 
         atomic_next_read_index_->store(
             next_read_index_, boost::memory_order::release);
@@ -396,6 +494,49 @@ public:
         reserved_ = 0U;
     }
 
+    /*!
+     * \brief Try to read bytes scattering into pieces at once.
+     *
+     * \tparam Piece Type of views of the pieces.
+     * \param[in] pieces Pieces of buffers to fill in order.
+     * \param[in] num_pieces Number of the pieces.
+     * \retval true All pieces were filled.
+     * \retval false Bytes were not enough to fill all pieces. (No byte is
+     * read.)
+     *
+     * \note This function copies bytes into all pieces from one reservation,
+     * wrapping around the end of the circular buffer, and sets them finished to
+     * read with a single store of the index.
+     */
+    template <typename Piece>
+    [[nodiscard]] bool try_read_scatter(
+        const Piece* pieces, std::size_t num_pieces) noexcept {
+        size_type total_size = 0U;
+        if (!calc_total_piece_size(pieces, num_pieces, total_size)) {
+            return false;
+        }
+        if (total_size == 0U) {
+            return true;
+        }
+
+        if (index_policy::readable_size(size_, cached_next_write_index_,
+                next_read_index_) < total_size) {
+            cached_next_write_index_ =
+                atomic_next_write_index_->load(boost::memory_order::acquire);
+            if (index_policy::readable_size(size_, cached_next_write_index_,
+                    next_read_index_) < total_size) {
+                return false;
+            }
+        }
+
+        scatter_from_circular_buffer(buffer_, size_,
+            index_policy::position(size_, next_read_index_), pieces,
+            num_pieces);
+        reserved_ = total_size;
+        commit(total_size);
+        return true;
+    }
+
 private:
     /*!
      * \brief Calculate the number of reservable bytes.
@@ -403,12 +544,15 @@ private:
      * \param[in] next_write_index Value of atomic_next_write_index_.
      * \return Number of reservable bytes.
      */
-    [[nodiscard]] shm_stream_size_t calc_reservable_size(
-        shm_stream_size_t next_write_index) const noexcept {
-        if (next_read_index_ <= next_write_index) {
-            return next_write_index - next_read_index_;
+    [[nodiscard]] size_type calc_reservable_size(
+        size_type next_write_index) const noexcept {
+        const size_type readable_size = index_policy::readable_size(
+            size_, next_write_index, next_read_index_);
+        if (is_mirrored_) {
+            return readable_size;
         }
-        return size_ - next_read_index_;
+        return std::min<size_type>(readable_size,
+            size_ - index_policy::position(size_, next_read_index_));
     }
 
     //! Atomic variable of the index of the next byte to read.
@@ -421,13 +565,19 @@ private:
     const char* buffer_;
 
     //! Size of the buffer.
-    shm_stream_size_t size_;
+    size_type size_;
+
+    //! Whether the buffer is mirrored.
+    bool is_mirrored_;
 
     //! Index of the next byte to read.
-    shm_stream_size_t next_read_index_;
+    size_type next_read_index_;
+
+    //! Cached value of atomic_next_write_index_.
+    size_type cached_next_write_index_;
 
     //! Number of bytes reserved to read currently.
-    shm_stream_size_t reserved_;
+    size_type reserved_;
 };
 
 }  // namespace details
@@ -0,0 +1,306 @@
+/*
+ * Copyright 2023 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Definition of light_message_queue class.
+ */
+#pragma once
+
+#include <cstring>
+#include <limits>
+
+#include <boost/atomic/ipc_atomic.hpp>
+
+#include "shm_stream/bytes_view.h"
+#include "shm_stream/common_types.h"
+#include "shm_stream/details/atomic_index_pair.h"
+#include "shm_stream/details/light_bytes_queue.h"
+#include "shm_stream/shm_stream_assert.h"
+
+namespace shm_stream {
+namespace details {
+
+/*!
+ * \brief Class of writers of queues of messages without waiting (possibly
+ * lock-free and wait-free).
+ *
+ * Each message is written with a header of its size into the underlying queue
+ * of bytes. When a message does not fit in the bytes before the end of the
+ * circular buffer, the bytes are skipped with a padding marker so that each
+ * message is always contiguous.
+ *
+ * \tparam AtomicType Type of atomic variables.
+ *
+ * \thread_safety All operation is safe if only one writer exists.
+ */
+template <typename AtomicType = boost::atomics::ipc_atomic<shm_stream_size_t>>
+class light_message_queue_writer {
+public:
+    //! Type of queues of bytes.
+    using bytes_queue_type = light_bytes_queue_writer<AtomicType>;
+
+    //! Type of atomic variables.
+    using atomic_type = typename bytes_queue_type::atomic_type;
+
+    //! Type of sizes and indices.
+    using size_type = typename bytes_queue_type::size_type;
+
+    //! Type of views of mutable bytes.
+    using mutable_bytes_view = typename bytes_queue_type::mutable_bytes_view;
+
+    /*!
+     * \brief Get the size of headers of messages.
+     *
+     * \return Number of bytes.
+     */
+    static constexpr size_type header_size() noexcept {
+        return static_cast<size_type>(sizeof(size_type));
+    }
+
+    /*!
+     * \brief Get the value of headers marking the bytes until the end of the
+     * buffer as padding.
+     *
+     * \return Value of the header.
+     */
+    static constexpr size_type padding_marker() noexcept {
+        return std::numeric_limits<size_type>::max();
+    }
+
+    /*!
+     * \brief Constructor.
+     *
+     * \param[in] atomic_indices Atomic variables of the indices of the next
+     * bytes for the writer and the reader.
+     * \param[in] buffer Buffer of data.
+     * \param[in] is_mirrored Whether the buffer is mirrored.
+     */
+    light_message_queue_writer(
+        atomic_index_pair_view<atomic_type> atomic_indices,
+        mutable_bytes_view buffer, bool is_mirrored = false)
+        : bytes_queue_(atomic_indices, buffer, is_mirrored),
+          buffer_(buffer.data()),
+          size_(buffer.size()),
+          is_mirrored_(is_mirrored),
+          reserved_(0U) {}
+
+    /*!
+     * \brief Get the maximum size of messages.
+     *
+     * \return Number of bytes.
+     */
+    [[nodiscard]] size_type max_message_size() const noexcept {
+        // One byte in the buffer is kept unused by the queue of bytes.
+        if (size_ <= header_size() + 1U) {
+            return 0U;
+        }
+        return size_ - header_size() - 1U;
+    }
+
+    /*!
+     * \brief Try to reserve a message to write.
+     *
+     * \param[in] message_size Size of the message.
+     * \return Buffer of the message. If the message cannot be reserved now or
+     * the size is larger than max_message_size function, the data pointer of
+     * the buffer is null.
+     */
+    [[nodiscard]] mutable_bytes_view try_reserve_message(
+        size_type message_size) noexcept {
+        if (message_size > max_message_size()) {
+            return mutable_bytes_view(nullptr, 0U);
+        }
+        const size_type record_size = header_size() + message_size;
+        while (true) {
+            const mutable_bytes_view buffer =
+                bytes_queue_.try_reserve(record_size);
+            if (buffer.size() == record_size) {
+                std::memcpy(buffer.data(), &message_size, sizeof(size_type));
+                reserved_ = record_size;
+                return mutable_bytes_view(
+                    buffer.data() + header_size(), message_size);
+            }
+            if (is_mirrored_) {
+                return mutable_bytes_view(nullptr, 0U);
+            }
+
+            const auto bytes_to_end = static_cast<size_type>(
+                size_ - static_cast<size_type>(buffer.data() - buffer_));
+            if (buffer.size() < bytes_to_end) {
+                return mutable_bytes_view(nullptr, 0U);
+            }
+            // The message does not fit before the end of the buffer.
+            if (bytes_to_end >= header_size()) {
+                const size_type marker = padding_marker();
+                std::memcpy(buffer.data(), &marker, sizeof(size_type));
+            }
+            bytes_queue_.commit(bytes_to_end);
+        }
+    }
+
+    /*!
+     * \brief Save the reserved message as completed and ready to be read by a
+     * reader.
+     */
+    void commit_message() noexcept {
+        bytes_queue_.commit(reserved_);
+        reserved_ = 0U;
+    }
+
+private:
+    //! Queue of bytes.
+    bytes_queue_type bytes_queue_;
+
+    //! Buffer.
+    char* buffer_;
+
+    //! Size of the buffer.
+    size_type size_;
+
+    //! Whether the buffer is mirrored.
+    bool is_mirrored_;
+
+    //! Number of reserved bytes including the header.
+    size_type reserved_;
+};
+
+/*!
+ * \brief Class of readers of queues of messages without waiting (possibly
+ * lock-free and wait-free).
+ *
+ * \tparam AtomicType Type of atomic variables.
+ *
+ * \thread_safety All operation is safe if only one reader exists.
+ */
+template <typename AtomicType = boost::atomics::ipc_atomic<shm_stream_size_t>>
+class light_message_queue_reader {
+public:
+    //! Type of queues of bytes.
+    using bytes_queue_type = light_bytes_queue_reader<AtomicType>;
+
+    //! Type of atomic variables.
+    using atomic_type = typename bytes_queue_type::atomic_type;
+
+    //! Type of sizes and indices.
+    using size_type = typename bytes_queue_type::size_type;
+
+    //! Type of views of bytes.
+    using bytes_view = typename bytes_queue_type::bytes_view;
+
+    /*!
+     * \brief Get the size of headers of messages.
+     *
+     * \return Number of bytes.
+     */
+    static constexpr size_type header_size() noexcept {
+        return light_message_queue_writer<AtomicType>::header_size();
+    }
+
+    /*!
+     * \brief Get the value of headers marking the bytes until the end of the
+     * buffer as padding.
+     *
+     * \return Value of the header.
+     */
+    static constexpr size_type padding_marker() noexcept {
+        return light_message_queue_writer<AtomicType>::padding_marker();
+    }
+
+    /*!
+     * \brief Constructor.
+     *
+     * \param[in] atomic_indices Atomic variables of the indices of the next
+     * bytes for the writer and the reader.
+     * \param[in] buffer Buffer of data.
+     * \param[in] is_mirrored Whether the buffer is mirrored.
+     */
+    light_message_queue_reader(
+        atomic_index_pair_view<atomic_type> atomic_indices, bytes_view buffer,
+        bool is_mirrored = false)
+        : bytes_queue_(atomic_indices, buffer, is_mirrored),
+          buffer_(buffer.data()),
+          size_(buffer.size()),
+          is_mirrored_(is_mirrored),
+          reserved_(0U) {}
+
+    /*!
+     * \brief Try to get the next message.
+     *
+     * \return Buffer of the message. If no message is available now, the data
+     * pointer of the buffer is null.
+     *
+     * \note This function returns the same message until commit_message
+     * function is called.
+     */
+    [[nodiscard]] bytes_view next_message() noexcept {
+        while (true) {
+            const bytes_view buffer = bytes_queue_.try_reserve();
+            if (buffer.empty()) {
+                return bytes_view(nullptr, 0U);
+            }
+
+            const auto bytes_to_end = static_cast<size_type>(
+                size_ - static_cast<size_type>(buffer.data() - buffer_));
+            if (!is_mirrored_ && bytes_to_end < header_size()) {
+                // Too few bytes for a header are skipped by the writer.
+                SHM_STREAM_ASSERT(buffer.size() == bytes_to_end);
+                bytes_queue_.commit(bytes_to_end);
+                continue;
+            }
+
+            SHM_STREAM_ASSERT(buffer.size() >= header_size());
+            size_type message_size{};
+            std::memcpy(&message_size, buffer.data(), sizeof(size_type));
+            if (message_size == padding_marker()) {
+                SHM_STREAM_ASSERT(buffer.size() == bytes_to_end);
+                bytes_queue_.commit(bytes_to_end);
+                continue;
+            }
+
+            reserved_ = header_size() + message_size;
+            SHM_STREAM_ASSERT(buffer.size() >= reserved_);
+            return bytes_view(buffer.data() + header_size(), message_size);
+        }
+    }
+
+    /*!
+     * \brief Set the message returned by next_message function as finished to
+     * read.
+     */
+    void commit_message() noexcept {
+        bytes_queue_.commit(reserved_);
+        reserved_ = 0U;
+    }
+
+private:
+    //! Queue of bytes.
+    bytes_queue_type bytes_queue_;
+
+    //! Buffer.
+    const char* buffer_;
+
+    //! Size of the buffer.
+    size_type size_;
+
+    //! Whether the buffer is mirrored.
+    bool is_mirrored_;
+
+    //! Number of reserved bytes including the header.
+    size_type reserved_;
+};
+
+}  // namespace details
+}  // namespace shm_stream
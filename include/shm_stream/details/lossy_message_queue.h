@@ -0,0 +1,499 @@
+/*
+ * Copyright 2023 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Definition of lossy_message_queue class.
+ */
+#pragma once
+
+#include <cstddef>
+#include <limits>
+
+#include <boost/atomic/fences.hpp>
+#include <boost/atomic/ipc_atomic.hpp>
+#include <boost/atomic/ipc_atomic_ref.hpp>
+#include <boost/memory_order.hpp>
+
+#include "shm_stream/bytes_view.h"
+#include "shm_stream/c_interface/error_codes.h"
+#include "shm_stream/common_types.h"
+#include "shm_stream/details/index_policy.h"
+#include "shm_stream/shm_stream_assert.h"
+#include "shm_stream/shm_stream_exception.h"
+
+namespace shm_stream {
+namespace details {
+
+/*!
+ * \brief Class of common definitions of queues of messages overwriting the
+ * oldest messages when full.
+ *
+ * The buffer is divided into records of the same size, and each record
+ * consists of a header and a message. The header holds the sequence number of
+ * the message, which is odd while the writer writes the message and even after
+ * the writer commits the message. Readers check the sequence numbers to detect
+ * messages overwritten by the writer.
+ *
+ * \tparam AtomicType Type of atomic variables.
+ */
+template <typename AtomicType =
+              boost::atomics::ipc_atomic<shm_stream_size64_t>>
+class lossy_message_queue_base {
+public:
+    //! Type of atomic variables.
+    using atomic_type = AtomicType;
+
+    //! Type of sequence numbers.
+    using sequence_type = typename atomic_type::value_type;
+
+    //! Type of sizes.
+    using size_type = shm_stream_size_t;
+
+    //! Type of references to headers in the buffer.
+    using header_ref_type = boost::atomics::ipc_atomic_ref<sequence_type>;
+
+    //! Type of the policy of indices of records.
+    using index_policy = masked_index_policy;
+
+    /*!
+     * \brief Get the size of headers of records, which is also the alignment
+     * of records.
+     *
+     * \return Number of bytes.
+     */
+    static constexpr size_type header_size() noexcept { return 16U; }
+
+    /*!
+     * \brief Get the minimum number of records.
+     *
+     * \return Minimum number of records.
+     */
+    static constexpr size_type min_records() noexcept { return 2U; }
+
+    /*!
+     * \brief Calculate the size of each record.
+     *
+     * \param[in] max_message_size Maximum size of messages.
+     * \return Size of each record.
+     */
+    static constexpr size_type record_size(
+        size_type max_message_size) noexcept {
+        return (header_size() + max_message_size + header_size() - 1U) &
+            ~(header_size() - 1U);
+    }
+
+    /*!
+     * \brief Calculate the size of the buffer.
+     *
+     * \param[in] num_records Number of records.
+     * \param[in] max_message_size Maximum size of messages.
+     * \return Size of the buffer.
+     */
+    static size_type buffer_size(
+        size_type num_records, size_type max_message_size) {
+        check_params(num_records, max_message_size);
+        return num_records * record_size(max_message_size);
+    }
+
+protected:
+    /*!
+     * \brief Check parameters of a buffer.
+     *
+     * \param[in] num_records Number of records.
+     * \param[in] max_message_size Maximum size of messages.
+     */
+    static void check_params(
+        size_type num_records, size_type max_message_size) {
+        constexpr size_type max_size = std::numeric_limits<size_type>::max();
+        if (num_records < min_records() ||
+            !index_policy::is_valid_size(num_records) ||
+            max_message_size > max_size - 2U * header_size() ||
+            record_size(max_message_size) > max_size / num_records) {
+            throw shm_stream_error(c_shm_stream_error_code_invalid_argument);
+        }
+    }
+
+    /*!
+     * \brief Get the header of a record.
+     *
+     * \param[in] address Address of the record.
+     * \return Reference to the sequence number in the header.
+     */
+    static header_ref_type sequence_at(char* address) noexcept {
+        return header_ref_type(*static_cast<sequence_type*>(
+            static_cast<void*>(address)));  // NOLINT
+    }
+
+    /*!
+     * \brief Get the size of the message in a record.
+     *
+     * \param[in] address Address of the record.
+     * \return Reference to the size.
+     */
+    static size_type& message_size_at(char* address) noexcept {
+        return *static_cast<size_type*>(static_cast<void*>(
+            address + sizeof(sequence_type)));  // NOLINT
+    }
+
+    /*!
+     * \brief Get the value of the header of a message being written.
+     *
+     * \param[in] sequence Sequence number of the message.
+     * \return Value of the header.
+     */
+    static constexpr sequence_type writing_stamp(
+        sequence_type sequence) noexcept {
+        return 2U * sequence + 1U;
+    }
+
+    /*!
+     * \brief Get the value of the header of a committed message.
+     *
+     * \param[in] sequence Sequence number of the message.
+     * \return Value of the header.
+     */
+    static constexpr sequence_type committed_stamp(
+        sequence_type sequence) noexcept {
+        return 2U * sequence + 2U;
+    }
+};
+
+/*!
+ * \brief Class of writers of queues of messages overwriting the oldest
+ * messages when full.
+ *
+ * The writer never waits for readers and never reads any variable written by
+ * readers.
+ *
+ * \tparam AtomicType Type of atomic variables.
+ *
+ * \thread_safety All operation is safe if only one writer exists.
+ */
+template <typename AtomicType =
+              boost::atomics::ipc_atomic<shm_stream_size64_t>>
+class lossy_message_queue_writer : public lossy_message_queue_base<AtomicType> {
+public:
+    //! Type of the base class.
+    using base_type = lossy_message_queue_base<AtomicType>;
+
+    using typename base_type::atomic_type;
+    using typename base_type::index_policy;
+    using typename base_type::sequence_type;
+    using typename base_type::size_type;
+
+    /*!
+     * \brief Constructor.
+     *
+     * \param[in] atomic_next_sequence Atomic variable of the sequence number
+     * of the next message written by the writer.
+     * \param[in] buffer Buffer of data.
+     * \param[in] max_message_size Maximum size of messages.
+     */
+    lossy_message_queue_writer(atomic_type& atomic_next_sequence,
+        mutable_bytes_view buffer, size_type max_message_size)
+        : atomic_next_sequence_(&atomic_next_sequence),
+          buffer_(buffer.data()),
+          record_size_(base_type::record_size(max_message_size)),
+          num_records_(0U),
+          max_message_size_(max_message_size),
+          next_sequence_(0U),
+          reserved_record_(nullptr),
+          reserved_message_size_(0U) {
+        SHM_STREAM_ASSERT(buffer_ != nullptr);
+        num_records_ = buffer.size() / record_size_;
+        base_type::check_params(num_records_, max_message_size_);
+        if (buffer.size() != num_records_ * record_size_) {
+            throw shm_stream_error(c_shm_stream_error_code_invalid_argument);
+        }
+        next_sequence_ =
+            atomic_next_sequence_->load(boost::memory_order::relaxed);
+    }
+
+    /*!
+     * \brief Get the maximum size of messages.
+     *
+     * \return Number of bytes.
+     */
+    [[nodiscard]] size_type max_message_size() const noexcept {
+        return max_message_size_;
+    }
+
+    /*!
+     * \brief Reserve a message to write.
+     *
+     * \param[in] message_size Size of the message.
+     * \return Buffer of the message. If the size is larger than
+     * max_message_size function, the data pointer of the buffer is null.
+     *
+     * \note This function overwrites the oldest message in the buffer.
+     */
+    [[nodiscard]] mutable_bytes_view reserve_message(
+        size_type message_size) noexcept {
+        if (message_size > max_message_size_) {
+            return mutable_bytes_view(nullptr, 0U);
+        }
+        reserved_record_ = buffer_ +
+            static_cast<std::size_t>(index_policy::position(num_records_,
+                static_cast<size_type>(next_sequence_))) *
+                record_size_;
+        reserved_message_size_ = message_size;
+
+        base_type::sequence_at(reserved_record_)
+            .store(base_type::writing_stamp(next_sequence_),
+                boost::memory_order::relaxed);
+        // Make the odd sequence number visible before any byte of the message.
+        boost::atomic_thread_fence(boost::memory_order::release);
+
+        return mutable_bytes_view(
+            reserved_record_ + base_type::header_size(), message_size);
+    }
+
+    /*!
+     * \brief Save the reserved message as completed and ready to be read by
+     * readers.
+     */
+    void commit_message() noexcept {
+        if (reserved_record_ == nullptr) {
+            return;
+        }
+        base_type::message_size_at(reserved_record_) = reserved_message_size_;
+        base_type::sequence_at(reserved_record_)
+            .store(base_type::committed_stamp(next_sequence_),
+                boost::memory_order::release);
+        ++next_sequence_;
+        atomic_next_sequence_->store(
+            next_sequence_, boost::memory_order::release);
+        reserved_record_ = nullptr;
+        reserved_message_size_ = 0U;
+    }
+
+private:
+    //! Atomic variable of the sequence number of the next message.
+    atomic_type* atomic_next_sequence_;
+
+    //! Buffer.
+    char* buffer_;
+
+    //! Size of each record.
+    size_type record_size_;
+
+    //! Number of records.
+    size_type num_records_;
+
+    //! Maximum size of messages.
+    size_type max_message_size_;
+
+    //! Sequence number of the next message.
+    sequence_type next_sequence_;
+
+    //! Reserved record.
+    char* reserved_record_;
+
+    //! Size of the reserved message.
+    size_type reserved_message_size_;
+};
+
+/*!
+ * \brief Class of readers of queues of messages overwriting the oldest
+ * messages when full.
+ *
+ * Readers don't write to shared memory, so any number of readers can read the
+ * same queue. When the writer overwrites messages not read yet, the reader
+ * skips to the oldest message left in the buffer and counts the skipped
+ * messages as lost.
+ *
+ * \tparam AtomicType Type of atomic variables.
+ *
+ * \thread_safety Multiple readers can be used concurrently, but each reader
+ * must be used in one thread.
+ */
+template <typename AtomicType =
+              boost::atomics::ipc_atomic<shm_stream_size64_t>>
+class lossy_message_queue_reader : public lossy_message_queue_base<AtomicType> {
+public:
+    //! Type of the base class.
+    using base_type = lossy_message_queue_base<AtomicType>;
+
+    using typename base_type::atomic_type;
+    using typename base_type::index_policy;
+    using typename base_type::sequence_type;
+    using typename base_type::size_type;
+
+    /*!
+     * \brief Constructor.
+     *
+     * \param[in] atomic_next_sequence Atomic variable of the sequence number
+     * of the next message written by the writer.
+     * \param[in] buffer Buffer of data.
+     * \param[in] max_message_size Maximum size of messages.
+     *
+     * \note The reader starts from the oldest message left in the buffer.
+     */
+    lossy_message_queue_reader(const atomic_type& atomic_next_sequence,
+        bytes_view buffer, size_type max_message_size)
+        : atomic_next_sequence_(&atomic_next_sequence),
+          // Headers are atomically loaded, but never modified by readers.
+          buffer_(const_cast<char*>(buffer.data())),  // NOLINT
+          record_size_(base_type::record_size(max_message_size)),
+          num_records_(0U),
+          max_message_size_(max_message_size),
+          next_sequence_(0U),
+          lost_messages_(0U),
+          reserved_record_(nullptr) {
+        SHM_STREAM_ASSERT(buffer_ != nullptr);
+        num_records_ = buffer.size() / record_size_;
+        base_type::check_params(num_records_, max_message_size_);
+        if (buffer.size() != num_records_ * record_size_) {
+            throw shm_stream_error(c_shm_stream_error_code_invalid_argument);
+        }
+        next_sequence_ = oldest_sequence();
+    }
+
+    /*!
+     * \brief Try to get the next message.
+     *
+     * \return Buffer of the message. If no message is completed now, the data
+     * pointer of the buffer is null.
+     *
+     * \note The returned message can be overwritten by the writer while
+     * reading it. Check the return value of commit_message function before
+     * using the data read from the message.
+     */
+    [[nodiscard]] bytes_view next_message() noexcept {
+        while (true) {
+            char* record = record_at(next_sequence_);
+            const sequence_type stamp = base_type::sequence_at(record).load(
+                boost::memory_order::acquire);
+            if (stamp == base_type::committed_stamp(next_sequence_)) {
+                const size_type message_size =
+                    base_type::message_size_at(record);
+                if (message_size <= max_message_size_) {
+                    reserved_record_ = record;
+                    return bytes_view(
+                        record + base_type::header_size(), message_size);
+                }
+                // The size has been overwritten by the writer.
+            } else if (stamp <= base_type::writing_stamp(next_sequence_)) {
+                return bytes_view(nullptr, 0U);
+            }
+            skip_lost_messages();
+        }
+    }
+
+    /*!
+     * \brief Finish reading the message returned by next_message function.
+     *
+     * \retval true The message was read without being overwritten.
+     * \retval false The message was overwritten by the writer while reading
+     * it, so the data read from the message must be discarded.
+     */
+    bool commit_message() noexcept {
+        if (reserved_record_ == nullptr) {
+            return false;
+        }
+        // Make the bytes of the message read before checking the header again.
+        boost::atomic_thread_fence(boost::memory_order::acquire);
+        const sequence_type stamp = base_type::sequence_at(reserved_record_)
+                                        .load(boost::memory_order::relaxed);
+        reserved_record_ = nullptr;
+        if (stamp != base_type::committed_stamp(next_sequence_)) {
+            skip_lost_messages();
+            return false;
+        }
+        ++next_sequence_;
+        return true;
+    }
+
+    /*!
+     * \brief Get the number of messages lost because of overwriting.
+     *
+     * \return Number of messages.
+     */
+    [[nodiscard]] sequence_type lost_messages() const noexcept {
+        return lost_messages_;
+    }
+
+private:
+    /*!
+     * \brief Get a record.
+     *
+     * \param[in] sequence Sequence number of the message in the record.
+     * \return Address of the record.
+     */
+    [[nodiscard]] char* record_at(sequence_type sequence) const noexcept {
+        return buffer_ +
+            static_cast<std::size_t>(index_policy::position(
+                num_records_, static_cast<size_type>(sequence))) *
+            record_size_;
+    }
+
+    /*!
+     * \brief Get the sequence number of the oldest message left in the buffer.
+     *
+     * \return Sequence number.
+     */
+    [[nodiscard]] sequence_type oldest_sequence() const noexcept {
+        const sequence_type writer_sequence =
+            atomic_next_sequence_->load(boost::memory_order::acquire);
+        if (writer_sequence < num_records_) {
+            return 0U;
+        }
+        return writer_sequence - num_records_;
+    }
+
+    /*!
+     * \brief Skip messages overwritten by the writer.
+     */
+    void skip_lost_messages() noexcept {
+        const sequence_type oldest = oldest_sequence();
+        if (oldest > next_sequence_) {
+            lost_messages_ += oldest - next_sequence_;
+            next_sequence_ = oldest;
+        } else {
+            // The writer has started overwriting the oldest record, but hasn't
+            // committed the new message yet.
+            lost_messages_ += 1U;
+            next_sequence_ += 1U;
+        }
+    }
+
+    //! Atomic variable of the sequence number of the next message.
+    const atomic_type* atomic_next_sequence_;
+
+    //! Buffer.
+    char* buffer_;
+
+    //! Size of each record.
+    size_type record_size_;
+
+    //! Number of records.
+    size_type num_records_;
+
+    //! Maximum size of messages.
+    size_type max_message_size_;
+
+    //! Sequence number of the next message to read.
+    sequence_type next_sequence_;
+
+    //! Number of lost messages.
+    sequence_type lost_messages_;
+
+    //! Reserved record.
+    char* reserved_record_;
+};
+
+}  // namespace details
+}  // namespace shm_stream
@@ -0,0 +1,412 @@
+/*
+ * Copyright 2023 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Definition of mpsc_message_queue class.
+ */
+#pragma once
+
+#include <cstring>
+#include <limits>
+
+#include <boost/atomic/ipc_atomic.hpp>
+#include <boost/atomic/ipc_atomic_ref.hpp>
+#include <boost/memory_order.hpp>
+
+#include "shm_stream/bytes_view.h"
+#include "shm_stream/c_interface/error_codes.h"
+#include "shm_stream/common_types.h"
+#include "shm_stream/details/atomic_index_pair.h"
+#include "shm_stream/details/index_policy.h"
+#include "shm_stream/shm_stream_assert.h"
+#include "shm_stream/shm_stream_exception.h"
+
+namespace shm_stream {
+namespace details {
+
+/*!
+ * \brief Class of common definitions of queues of messages with multiple
+ * writers and a single reader.
+ *
+ * Each record in the buffer consists of a header and a message, and is
+ * aligned to the size of the header. Headers are zero until the writer
+ * commits the message, so the reader reads only completed messages in the
+ * order of reservations. The reader clears records after reading them.
+ *
+ * \tparam AtomicType Type of atomic variables.
+ */
+template <typename AtomicType = boost::atomics::ipc_atomic<shm_stream_size_t>>
+class mpsc_message_queue_base {
+public:
+    //! Type of atomic variables.
+    using atomic_type = AtomicType;
+
+    //! Type of sizes and indices.
+    using size_type = typename atomic_type::value_type;
+
+    //! Type of references to headers in the buffer.
+    using header_ref_type = boost::atomics::ipc_atomic_ref<size_type>;
+
+    //! Type of the policy of indices.
+    using index_policy = masked_index_policy;
+
+    /*!
+     * \brief Get the size of headers of records, which is also the alignment
+     * of records.
+     *
+     * \return Number of bytes.
+     */
+    static constexpr size_type header_size() noexcept { return 8U; }
+
+    /*!
+     * \brief Get the value of headers marking the bytes until the end of the
+     * buffer as padding.
+     *
+     * \return Value of the header.
+     */
+    static constexpr size_type padding_marker() noexcept {
+        return std::numeric_limits<size_type>::max();
+    }
+
+    /*!
+     * \brief Get the minimum size of buffers.
+     *
+     * \return Minimum size of buffers.
+     */
+    static constexpr size_type min_size() noexcept {
+        return 2U * header_size();
+    }
+
+    /*!
+     * \brief Get the maximum size of buffers.
+     *
+     * \return Maximum size of buffers.
+     */
+    static constexpr size_type max_size() noexcept {
+        return std::numeric_limits<size_type>::max() / 2U + 1U;
+    }
+
+    /*!
+     * \brief Calculate the size of a record.
+     *
+     * \param[in] message_size Size of the message.
+     * \return Size of the record.
+     */
+    static constexpr size_type record_size(size_type message_size) noexcept {
+        return (header_size() + message_size + header_size() - 1U) &
+            ~(header_size() - 1U);
+    }
+
+protected:
+    /*!
+     * \brief Check the size of a buffer.
+     *
+     * \param[in] size Size of the buffer.
+     */
+    static void check_size(size_type size) {
+        if (size < min_size() || size > max_size() ||
+            !index_policy::is_valid_size(size)) {
+            throw shm_stream_error(c_shm_stream_error_code_invalid_argument);
+        }
+    }
+
+    /*!
+     * \brief Get the header of a record.
+     *
+     * \param[in] address Address of the record.
+     * \return Reference to the header.
+     */
+    static header_ref_type header_at(char* address) noexcept {
+        return header_ref_type(*static_cast<size_type*>(
+            static_cast<void*>(address)));  // NOLINT
+    }
+};
+
+/*!
+ * \brief Class of writers of queues of messages with multiple writers and a
+ * single reader without waiting (possibly lock-free).
+ *
+ * Writers claim space in the buffer by compare-and-swap operations on the
+ * shared index of claimed bytes.
+ *
+ * \tparam AtomicType Type of atomic variables.
+ *
+ * \thread_safety Multiple writers can be used concurrently, but each writer
+ * must be used in one thread.
+ */
+template <typename AtomicType = boost::atomics::ipc_atomic<shm_stream_size_t>>
+class mpsc_message_queue_writer : public mpsc_message_queue_base<AtomicType> {
+public:
+    //! Type of the base class.
+    using base_type = mpsc_message_queue_base<AtomicType>;
+
+    using typename base_type::atomic_type;
+    using typename base_type::index_policy;
+    using typename base_type::size_type;
+
+    //! Type of views of mutable bytes.
+    using mutable_bytes_view = basic_mutable_bytes_view<size_type>;
+
+    /*!
+     * \brief Constructor.
+     *
+     * \param[in] atomic_indices Atomic variables of the index of claimed bytes
+     * (as the index of the writer) and the index of the reader.
+     * \param[in] buffer Buffer of data.
+     */
+    mpsc_message_queue_writer(
+        atomic_index_pair_view<atomic_type> atomic_indices,
+        mutable_bytes_view buffer)
+        : atomic_claim_index_(&atomic_indices.writer()),
+          atomic_read_index_(&atomic_indices.reader()),
+          buffer_(buffer.data()),
+          size_(buffer.size()),
+          reserved_header_(nullptr),
+          reserved_message_size_(0U) {
+        SHM_STREAM_ASSERT(buffer_ != nullptr);
+        base_type::check_size(size_);
+    }
+
+    /*!
+     * \brief Get the maximum size of messages.
+     *
+     * \return Number of bytes.
+     *
+     * \note Records are limited to the half of the buffer, so that a record
+     * always fits either before or after the padding at the end of the empty
+     * buffer.
+     */
+    [[nodiscard]] size_type max_message_size() const noexcept {
+        return size_ / 2U - base_type::header_size();
+    }
+
+    /*!
+     * \brief Try to reserve a message to write.
+     *
+     * \param[in] message_size Size of the message.
+     * \return Buffer of the message. If the message cannot be reserved now or
+     * the size is larger than max_message_size function, the data pointer of
+     * the buffer is null.
+     */
+    [[nodiscard]] mutable_bytes_view try_reserve_message(
+        size_type message_size) noexcept {
+        if (message_size > max_message_size()) {
+            return mutable_bytes_view(nullptr, 0U);
+        }
+        const size_type record_size = base_type::record_size(message_size);
+
+        size_type claim_index =
+            atomic_claim_index_->load(boost::memory_order::relaxed);
+        while (true) {
+            const size_type read_index =
+                atomic_read_index_->load(boost::memory_order::acquire);
+            const size_type free_size =
+                index_policy::writable_size(size_, claim_index, read_index);
+            const size_type position =
+                index_policy::position(size_, claim_index);
+            const size_type bytes_to_end = size_ - position;
+
+            if (record_size <= bytes_to_end) {
+                if (record_size > free_size) {
+                    return mutable_bytes_view(nullptr, 0U);
+                }
+                if (atomic_claim_index_->compare_exchange_weak(claim_index,
+                        index_policy::advance(size_, claim_index, record_size),
+                        boost::memory_order::relaxed)) {
+                    reserved_header_ = buffer_ + position;
+                    reserved_message_size_ = message_size;
+                    return mutable_bytes_view(
+                        reserved_header_ + base_type::header_size(),
+                        message_size);
+                }
+                continue;
+            }
+
+            // The record does not fit before the end of the buffer.
+            if (bytes_to_end > free_size) {
+                return mutable_bytes_view(nullptr, 0U);
+            }
+            if (atomic_claim_index_->compare_exchange_weak(claim_index,
+                    index_policy::advance(size_, claim_index, bytes_to_end),
+                    boost::memory_order::relaxed)) {
+                base_type::header_at(buffer_ + position)
+                    .store(base_type::padding_marker(),
+                        boost::memory_order::release);
+                claim_index =
+                    index_policy::advance(size_, claim_index, bytes_to_end);
+            }
+        }
+    }
+
+    /*!
+     * \brief Save the reserved message as completed and ready to be read by
+     * the reader.
+     */
+    void commit_message() noexcept {
+        if (reserved_header_ == nullptr) {
+            return;
+        }
+        base_type::header_at(reserved_header_)
+            .store(reserved_message_size_ + 1U, boost::memory_order::release);
+        reserved_header_ = nullptr;
+        reserved_message_size_ = 0U;
+    }
+
+private:
+    //! Atomic variable of the index of claimed bytes.
+    atomic_type* atomic_claim_index_;
+
+    //! Atomic variable of the index of the reader.
+    atomic_type* atomic_read_index_;
+
+    //! Buffer.
+    char* buffer_;
+
+    //! Size of the buffer.
+    size_type size_;
+
+    //! Header of the reserved record.
+    char* reserved_header_;
+
+    //! Size of the reserved message.
+    size_type reserved_message_size_;
+};
+
+/*!
+ * \brief Class of readers of queues of messages with multiple writers and a
+ * single reader without waiting (possibly lock-free).
+ *
+ * \tparam AtomicType Type of atomic variables.
+ *
+ * \thread_safety All operation is safe if only one reader exists.
+ */
+template <typename AtomicType = boost::atomics::ipc_atomic<shm_stream_size_t>>
+class mpsc_message_queue_reader : public mpsc_message_queue_base<AtomicType> {
+public:
+    //! Type of the base class.
+    using base_type = mpsc_message_queue_base<AtomicType>;
+
+    using typename base_type::atomic_type;
+    using typename base_type::index_policy;
+    using typename base_type::size_type;
+
+    //! Type of views of bytes.
+    using bytes_view = basic_bytes_view<size_type>;
+
+    //! Type of views of mutable bytes.
+    using mutable_bytes_view = basic_mutable_bytes_view<size_type>;
+
+    /*!
+     * \brief Constructor.
+     *
+     * \param[in] atomic_indices Atomic variables of the index of claimed bytes
+     * (as the index of the writer) and the index of the reader.
+     * \param[in] buffer Buffer of data. (This must be mutable because the
+     * reader clears records after reading them.)
+     */
+    mpsc_message_queue_reader(
+        atomic_index_pair_view<atomic_type> atomic_indices,
+        mutable_bytes_view buffer)
+        : atomic_read_index_(&atomic_indices.reader()),
+          buffer_(buffer.data()),
+          size_(buffer.size()),
+          next_read_index_(0U),
+          reserved_(0U) {
+        SHM_STREAM_ASSERT(buffer_ != nullptr);
+        base_type::check_size(size_);
+        next_read_index_ =
+            atomic_read_index_->load(boost::memory_order::relaxed);
+    }
+
+    /*!
+     * \brief Try to get the next message.
+     *
+     * \return Buffer of the message. If no message is completed now, the data
+     * pointer of the buffer is null.
+     *
+     * \note This function returns the same message until commit_message
+     * function is called.
+     */
+    [[nodiscard]] bytes_view next_message() noexcept {
+        while (true) {
+            const size_type position =
+                index_policy::position(size_, next_read_index_);
+            const size_type header =
+                base_type::header_at(buffer_ + position)
+                    .load(boost::memory_order::acquire);
+            if (header == 0U) {
+                return bytes_view(nullptr, 0U);
+            }
+            if (header == base_type::padding_marker()) {
+                release(position, size_ - position);
+                continue;
+            }
+
+            const size_type message_size = header - 1U;
+            reserved_ = base_type::record_size(message_size);
+            return bytes_view(
+                buffer_ + position + base_type::header_size(), message_size);
+        }
+    }
+
+    /*!
+     * \brief Set the message returned by next_message function as finished to
+     * read.
+     */
+    void commit_message() noexcept {
+        if (reserved_ == 0U) {
+            return;
+        }
+        release(index_policy::position(size_, next_read_index_), reserved_);
+        reserved_ = 0U;
+    }
+
+private:
+    /*!
+     * \brief Clear a record and pass it to writers.
+     *
+     * \param[in] position Position of the record.
+     * \param[in] record_size Size of the record.
+     */
+    void release(size_type position, size_type record_size) noexcept {
+        base_type::header_at(buffer_ + position)
+            .store(0U, boost::memory_order::relaxed);
+        std::memset(buffer_ + position + base_type::header_size(), 0,
+            record_size - base_type::header_size());
+        next_read_index_ =
+            index_policy::advance(size_, next_read_index_, record_size);
+        atomic_read_index_->store(
+            next_read_index_, boost::memory_order::release);
+    }
+
+    //! Atomic variable of the index of the reader.
+    atomic_type* atomic_read_index_;
+
+    //! Buffer.
+    char* buffer_;
+
+    //! Size of the buffer.
+    size_type size_;
+
+    //! Index of the next byte to read.
+    size_type next_read_index_;
+
+    //! Size of the reserved record.
+    size_type reserved_;
+};
+
+}  // namespace details
+}  // namespace shm_stream
@@ -0,0 +1,45 @@
+/*
+ * Copyright 2023 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Definition of pause function.
+ */
+#pragma once
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || \
+    defined(_M_IX86)
+#include <emmintrin.h>
+#define SHM_STREAM_HAS_MM_PAUSE 1
+#endif
+
+namespace shm_stream {
+namespace details {
+
+/*!
+ * \brief Hint to CPU that the current thread is spinning.
+ *
+ * \note This function does nothing in environments without such instructions.
+ */
+inline void pause() noexcept {
+#if defined(SHM_STREAM_HAS_MM_PAUSE)
+    _mm_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+    __asm__ __volatile__("yield");  // NOLINT(hicpp-no-assembler)
+#endif
+}
+
+}  // namespace details
+}  // namespace shm_stream
@@ -0,0 +1,257 @@
+/*
+ * Copyright 2023 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Definition of helper functions to copy pieces of bytes from and to
+ * circular buffers at once.
+ */
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+#include "shm_stream/bytes_view.h"
+#include "shm_stream/c_interface/bytes_view.h"
+#include "shm_stream/common_types.h"
+
+namespace shm_stream {
+namespace details {
+
+/*!
+ * \brief Get the pointer to the data of a piece of bytes.
+ *
+ * \param[in] piece Piece.
+ * \return Pointer to the data.
+ */
+inline const char* piece_data(const c_shm_stream_bytes_view_t& piece) noexcept {
+    return piece.data;
+}
+
+/*!
+ * \brief Get the pointer to the data of a piece of bytes.
+ *
+ * \param[in] piece Piece.
+ * \return Pointer to the data.
+ */
+inline char* piece_data(
+    const c_shm_stream_mutable_bytes_view_t& piece) noexcept {
+    return piece.data;
+}
+
+/*!
+ * \brief Get the pointer to the data of a piece of bytes.
+ *
+ * \tparam SizeType Type of sizes.
+ * \param[in] piece Piece.
+ * \return Pointer to the data.
+ */
+template <typename SizeType>
+inline const char* piece_data(
+    const basic_bytes_view<SizeType>& piece) noexcept {
+    return piece.data();
+}
+
+/*!
+ * \brief Get the pointer to the data of a piece of bytes.
+ *
+ * \tparam SizeType Type of sizes.
+ * \param[in] piece Piece.
+ * \return Pointer to the data.
+ */
+template <typename SizeType>
+inline char* piece_data(
+    const basic_mutable_bytes_view<SizeType>& piece) noexcept {
+    return piece.data();
+}
+
+/*!
+ * \brief Get the size of a piece of bytes.
+ *
+ * \param[in] piece Piece.
+ * \return Size.
+ */
+inline shm_stream_size_t piece_size(
+    const c_shm_stream_bytes_view_t& piece) noexcept {
+    return piece.size;
+}
+
+/*!
+ * \brief Get the size of a piece of bytes.
+ *
+ * \param[in] piece Piece.
+ * \return Size.
+ */
+inline shm_stream_size_t piece_size(
+    const c_shm_stream_mutable_bytes_view_t& piece) noexcept {
+    return piece.size;
+}
+
+/*!
+ * \brief Get the size of a piece of bytes.
+ *
+ * \tparam SizeType Type of sizes.
+ * \param[in] piece Piece.
+ * \return Size.
+ */
+template <typename SizeType>
+inline SizeType piece_size(const basic_bytes_view<SizeType>& piece) noexcept {
+    return piece.size();
+}
+
+/*!
+ * \brief Get the size of a piece of bytes.
+ *
+ * \tparam SizeType Type of sizes.
+ * \param[in] piece Piece.
+ * \return Size.
+ */
+template <typename SizeType>
+inline SizeType piece_size(
+    const basic_mutable_bytes_view<SizeType>& piece) noexcept {
+    return piece.size();
+}
+
+/*!
+ * \brief Calculate the total size of pieces of bytes.
+ *
+ * \tparam SizeType Type of sizes.
+ * \tparam Piece Type of pieces.
+ * \param[in] pieces Pieces.
+ * \param[in] num_pieces Number of the pieces.
+ * \param[out] total_size Total size.
+ * \retval true Succeeded.
+ * \retval false The total size overflows SizeType.
+ */
+template <typename SizeType, typename Piece>
+[[nodiscard]] inline bool calc_total_piece_size(const Piece* pieces,
+    std::size_t num_pieces, SizeType& total_size) noexcept {
+    total_size = 0U;
+    for (std::size_t i = 0U; i < num_pieces; ++i) {
+        const SizeType size = piece_size(pieces[i]);
+        if (size > std::numeric_limits<SizeType>::max() - total_size) {
+            return false;
+        }
+        total_size += size;
+    }
+    return true;
+}
+
+/*!
+ * \brief Copy pieces of bytes into a circular buffer.
+ *
+ * \tparam SizeType Type of sizes.
+ * \tparam Piece Type of pieces.
+ * \param[in] buffer Buffer.
+ * \param[in] size Size of the buffer.
+ * \param[in] position Position in the buffer to start writing.
+ * \param[in] pieces Pieces.
+ * \param[in] num_pieces Number of the pieces.
+ *
+ * \note Bytes after the end of the buffer are written to the beginning of the
+ * buffer. Callers must check that the buffer has enough space.
+ */
+template <typename SizeType, typename Piece>
+inline void gather_to_circular_buffer(char* buffer, SizeType size,
+    SizeType position, const Piece* pieces, std::size_t num_pieces) noexcept {
+    for (std::size_t i = 0U; i < num_pieces; ++i) {
+        const char* data = piece_data(pieces[i]);
+        SizeType remaining = piece_size(pieces[i]);
+        while (remaining > 0U) {
+            const SizeType copied = std::min(remaining, size - position);
+            std::memcpy(buffer + position, data, copied);
+            data += copied;
+            remaining -= copied;
+            position += copied;
+            if (position == size) {
+                position = 0U;
+            }
+        }
+    }
+}
+
+/*!
+ * \brief Copy bytes in a circular buffer into pieces.
+ *
+ * \tparam SizeType Type of sizes.
+ * \tparam Piece Type of pieces.
+ * \param[in] buffer Buffer.
+ * \param[in] size Size of the buffer.
+ * \param[in] position Position in the buffer to start reading.
+ * \param[in] pieces Pieces.
+ * \param[in] num_pieces Number of the pieces.
+ *
+ * \note Bytes after the end of the buffer are read from the beginning of the
+ * buffer. Callers must check that the buffer has enough bytes.
+ */
+template <typename SizeType, typename Piece>
+inline void scatter_from_circular_buffer(const char* buffer, SizeType size,
+    SizeType position, const Piece* pieces, std::size_t num_pieces) noexcept {
+    for (std::size_t i = 0U; i < num_pieces; ++i) {
+        char* data = piece_data(pieces[i]);
+        SizeType remaining = piece_size(pieces[i]);
+        while (remaining > 0U) {
+            const SizeType copied = std::min(remaining, size - position);
+            std::memcpy(data, buffer + position, copied);
+            data += copied;
+            remaining -= copied;
+            position += copied;
+            if (position == size) {
+                position = 0U;
+            }
+        }
+    }
+}
+
+/*!
+ * \brief Convert views of byte sequences to the struct in C interface.
+ *
+ * \param[in] pieces Views.
+ * \return Views in C interface.
+ */
+inline const c_shm_stream_bytes_view_t* to_c_bytes_views(
+    const bytes_view* pieces) noexcept {
+    static_assert(std::is_standard_layout<bytes_view>::value &&
+            sizeof(bytes_view) == sizeof(c_shm_stream_bytes_view_t) &&
+            alignof(bytes_view) == alignof(c_shm_stream_bytes_view_t),
+        "bytes_view must have the same layout as c_shm_stream_bytes_view_t.");
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    return reinterpret_cast<const c_shm_stream_bytes_view_t*>(pieces);
+}
+
+/*!
+ * \brief Convert views of byte sequences to the struct in C interface.
+ *
+ * \param[in] pieces Views.
+ * \return Views in C interface.
+ */
+inline const c_shm_stream_mutable_bytes_view_t* to_c_bytes_views(
+    const mutable_bytes_view* pieces) noexcept {
+    static_assert(std::is_standard_layout<mutable_bytes_view>::value &&
+            sizeof(mutable_bytes_view) ==
+                sizeof(c_shm_stream_mutable_bytes_view_t) &&
+            alignof(mutable_bytes_view) ==
+                alignof(c_shm_stream_mutable_bytes_view_t),
+        "mutable_bytes_view must have the same layout as "
+        "c_shm_stream_mutable_bytes_view_t.");
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    return reinterpret_cast<const c_shm_stream_mutable_bytes_view_t*>(pieces);
+}
+
+}  // namespace details
+}  // namespace shm_stream
@@ -0,0 +1,416 @@
+/*
+ * Copyright 2023 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Definition of snapshot_channel class.
+ */
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <limits>
+
+#include <boost/atomic/fences.hpp>
+#include <boost/atomic/ipc_atomic.hpp>
+#include <boost/atomic/ipc_atomic_ref.hpp>
+#include <boost/memory_order.hpp>
+
+#include "shm_stream/bytes_view.h"
+#include "shm_stream/c_interface/error_codes.h"
+#include "shm_stream/common_types.h"
+#include "shm_stream/shm_stream_assert.h"
+#include "shm_stream/shm_stream_exception.h"
+
+namespace shm_stream {
+namespace details {
+
+/*!
+ * \brief Class of common definitions of channels of the latest snapshots.
+ *
+ * The buffer consists of two slots, and the writer publishes snapshots to the
+ * slots alternately. Each slot has a sequence lock: the stamp of a slot is odd
+ * while the writer writes a snapshot to the slot, and even after the writer
+ * publishes the snapshot. Readers copy the latest snapshot and check the stamp
+ * again to detect snapshots overwritten while copying. Because the writer
+ * writes the slot not read by readers, readers retry only when the writer
+ * publishes two snapshots while a reader copies one.
+ *
+ * \tparam AtomicType Type of atomic variables.
+ */
+template <typename AtomicType =
+              boost::atomics::ipc_atomic<shm_stream_size64_t>>
+class snapshot_channel_base {
+public:
+    //! Type of atomic variables.
+    using atomic_type = AtomicType;
+
+    //! Type of versions of snapshots.
+    using version_type = typename atomic_type::value_type;
+
+    //! Type of sizes of snapshots.
+    using size_type = shm_stream_size_t;
+
+    //! Type of sizes of buffers.
+    using buffer_size_type = shm_stream_size64_t;
+
+    //! Type of references to stamps in the buffer.
+    using stamp_ref_type = boost::atomics::ipc_atomic_ref<version_type>;
+
+    /*!
+     * \brief Get the size of headers of slots, which is also the alignment of
+     * slots.
+     *
+     * \return Number of bytes.
+     */
+    static constexpr size_type header_size() noexcept { return 16U; }
+
+    /*!
+     * \brief Get the number of slots.
+     *
+     * \return Number of slots.
+     */
+    static constexpr size_type num_slots() noexcept { return 2U; }
+
+    /*!
+     * \brief Calculate the size of the buffer.
+     *
+     * \param[in] max_size Maximum size of snapshots.
+     * \return Size of the buffer.
+     */
+    static buffer_size_type buffer_size(size_type max_size) {
+        if (max_size > std::numeric_limits<size_type>::max() -
+                2U * header_size()) {
+            throw shm_stream_error(c_shm_stream_error_code_invalid_argument);
+        }
+        return static_cast<buffer_size_type>(num_slots()) *
+            slot_size(max_size);
+    }
+
+protected:
+    /*!
+     * \brief Calculate the size of each slot.
+     *
+     * \param[in] max_size Maximum size of snapshots.
+     * \return Size of each slot.
+     */
+    static constexpr size_type slot_size(size_type max_size) noexcept {
+        return (header_size() + max_size + header_size() - 1U) &
+            ~(header_size() - 1U);
+    }
+
+    /*!
+     * \brief Get the maximum size of snapshots from the size of a buffer.
+     *
+     * \param[in] buffer_size Size of the buffer.
+     * \return Maximum size of snapshots.
+     */
+    static size_type max_size_of(buffer_size_type buffer_size) {
+        const buffer_size_type size_of_slot = buffer_size / num_slots();
+        if (buffer_size % (num_slots() * header_size()) != 0U ||
+            size_of_slot < header_size() ||
+            size_of_slot > std::numeric_limits<size_type>::max()) {
+            throw shm_stream_error(c_shm_stream_error_code_invalid_argument);
+        }
+        return static_cast<size_type>(size_of_slot) - header_size();
+    }
+
+    /*!
+     * \brief Get the stamp of a slot.
+     *
+     * \param[in] slot Address of the slot.
+     * \return Reference to the stamp.
+     */
+    static stamp_ref_type stamp_at(char* slot) noexcept {
+        return stamp_ref_type(
+            *static_cast<version_type*>(static_cast<void*>(slot)));  // NOLINT
+    }
+
+    /*!
+     * \brief Get the size of the snapshot in a slot.
+     *
+     * \param[in] slot Address of the slot.
+     * \return Reference to the size.
+     */
+    static size_type& size_at(char* slot) noexcept {
+        return *static_cast<size_type*>(
+            static_cast<void*>(slot + sizeof(version_type)));  // NOLINT
+    }
+
+    /*!
+     * \brief Get the slot of a version.
+     *
+     * \param[in] buffer Buffer.
+     * \param[in] max_size Maximum size of snapshots.
+     * \param[in] version Version of a snapshot.
+     * \return Address of the slot.
+     */
+    static char* slot_at(
+        char* buffer, size_type max_size, version_type version) noexcept {
+        return buffer +
+            static_cast<std::size_t>(version % num_slots()) *
+            slot_size(max_size);
+    }
+
+    /*!
+     * \brief Get the stamp of a slot while the writer writes a version.
+     *
+     * \param[in] version Version of a snapshot.
+     * \return Stamp.
+     */
+    static constexpr version_type writing_stamp(version_type version) noexcept {
+        return 2U * version - 1U;
+    }
+
+    /*!
+     * \brief Get the stamp of a slot after the writer published a version.
+     *
+     * \param[in] version Version of a snapshot.
+     * \return Stamp.
+     */
+    static constexpr version_type published_stamp(
+        version_type version) noexcept {
+        return 2U * version;
+    }
+};
+
+/*!
+ * \brief Class of writers of channels of the latest snapshots.
+ *
+ * \tparam AtomicType Type of atomic variables.
+ *
+ * \thread_safety All operation is safe if only one writer exists.
+ */
+template <typename AtomicType =
+              boost::atomics::ipc_atomic<shm_stream_size64_t>>
+class snapshot_channel_writer : public snapshot_channel_base<AtomicType> {
+public:
+    //! Type of the base class.
+    using base_type = snapshot_channel_base<AtomicType>;
+
+    using typename base_type::atomic_type;
+    using typename base_type::buffer_size_type;
+    using typename base_type::size_type;
+    using typename base_type::version_type;
+
+    /*!
+     * \brief Constructor.
+     *
+     * \param[in] atomic_version Atomic variable of the version of the latest
+     * snapshot.
+     * \param[in] buffer Buffer of data.
+     */
+    snapshot_channel_writer(atomic_type& atomic_version,
+        basic_mutable_bytes_view<buffer_size_type> buffer)
+        : atomic_version_(&atomic_version),
+          buffer_(buffer.data()),
+          max_size_(base_type::max_size_of(buffer.size())),
+          version_(atomic_version.load(boost::memory_order::relaxed)),
+          reserved_slot_(nullptr) {
+        SHM_STREAM_ASSERT(buffer_ != nullptr);
+    }
+
+    /*!
+     * \brief Get the maximum size of snapshots.
+     *
+     * \return Number of bytes.
+     */
+    [[nodiscard]] size_type max_size() const noexcept { return max_size_; }
+
+    /*!
+     * \brief Reserve the buffer of the next snapshot.
+     *
+     * \return Buffer of the snapshot with the maximum size.
+     *
+     * \note The snapshot is published by commit function.
+     */
+    [[nodiscard]] mutable_bytes_view reserve() noexcept {
+        if (reserved_slot_ == nullptr) {
+            const version_type next_version = version_ + 1U;
+            reserved_slot_ =
+                base_type::slot_at(buffer_, max_size_, next_version);
+            base_type::stamp_at(reserved_slot_)
+                .store(base_type::writing_stamp(next_version),
+                    boost::memory_order::relaxed);
+            // Make the odd stamp visible before any byte of the snapshot.
+            boost::atomic_thread_fence(boost::memory_order::release);
+        }
+        return mutable_bytes_view(
+            reserved_slot_ + base_type::header_size(), max_size_);
+    }
+
+    /*!
+     * \brief Publish the reserved snapshot.
+     *
+     * \param[in] size Size of the snapshot.
+     */
+    void commit(size_type size) noexcept {
+        if (reserved_slot_ == nullptr) {
+            return;
+        }
+        SHM_STREAM_ASSERT(size <= max_size_);
+        ++version_;
+        base_type::size_at(reserved_slot_) = size;
+        base_type::stamp_at(reserved_slot_)
+            .store(base_type::published_stamp(version_),
+                boost::memory_order::release);
+        atomic_version_->store(version_, boost::memory_order::release);
+        reserved_slot_ = nullptr;
+    }
+
+    /*!
+     * \brief Publish a snapshot.
+     *
+     * \param[in] data Data of the snapshot.
+     */
+    void publish(bytes_view data) {
+        if (data.size() > max_size_) {
+            throw shm_stream_error(c_shm_stream_error_code_invalid_argument);
+        }
+        const auto buffer = reserve();
+        std::memcpy(buffer.data(), data.data(), data.size());
+        commit(data.size());
+    }
+
+private:
+    //! Atomic variable of the version of the latest snapshot.
+    atomic_type* atomic_version_;
+
+    //! Buffer.
+    char* buffer_;
+
+    //! Maximum size of snapshots.
+    size_type max_size_;
+
+    //! Version of the latest snapshot.
+    version_type version_;
+
+    //! Reserved slot.
+    char* reserved_slot_;
+};
+
+/*!
+ * \brief Class of readers of channels of the latest snapshots.
+ *
+ * Readers don't write to shared memory, so any number of readers can read the
+ * same channel.
+ *
+ * \tparam AtomicType Type of atomic variables.
+ *
+ * \thread_safety All operation is safe if each reader is used in one thread.
+ */
+template <typename AtomicType =
+              boost::atomics::ipc_atomic<shm_stream_size64_t>>
+class snapshot_channel_reader : public snapshot_channel_base<AtomicType> {
+public:
+    //! Type of the base class.
+    using base_type = snapshot_channel_base<AtomicType>;
+
+    using typename base_type::atomic_type;
+    using typename base_type::buffer_size_type;
+    using typename base_type::size_type;
+    using typename base_type::version_type;
+
+    /*!
+     * \brief Constructor.
+     *
+     * \param[in] atomic_version Atomic variable of the version of the latest
+     * snapshot.
+     * \param[in] buffer Buffer of data.
+     */
+    snapshot_channel_reader(const atomic_type& atomic_version,
+        basic_bytes_view<buffer_size_type> buffer)
+        : atomic_version_(&atomic_version),
+          // Stamps are atomically loaded, but never modified by readers.
+          buffer_(const_cast<char*>(buffer.data())),  // NOLINT
+          max_size_(base_type::max_size_of(buffer.size())) {
+        SHM_STREAM_ASSERT(buffer_ != nullptr);
+    }
+
+    /*!
+     * \brief Get the maximum size of snapshots.
+     *
+     * \return Number of bytes.
+     */
+    [[nodiscard]] size_type max_size() const noexcept { return max_size_; }
+
+    /*!
+     * \brief Get the version of the latest snapshot.
+     *
+     * \return Version. (Zero if no snapshot has been published.)
+     *
+     * \note This function can be used to check whether a new snapshot has been
+     * published without copying the snapshot.
+     */
+    [[nodiscard]] version_type version() const noexcept {
+        return atomic_version_->load(boost::memory_order::acquire);
+    }
+
+    /*!
+     * \brief Copy the latest snapshot.
+     *
+     * \param[out] buffer Buffer to copy the snapshot to. If the buffer is
+     * smaller than the snapshot, the snapshot is truncated.
+     * \param[out] size Size of the snapshot.
+     * \return Version of the copied snapshot. (Zero if no snapshot has been
+     * published.)
+     */
+    version_type read(mutable_bytes_view buffer, size_type& size) noexcept {
+        while (true) {
+            const version_type latest_version = version();
+            if (latest_version == 0U) {
+                size = 0U;
+                return 0U;
+            }
+            char* slot =
+                base_type::slot_at(buffer_, max_size_, latest_version);
+            const version_type stamp = base_type::stamp_at(slot).load(
+                boost::memory_order::acquire);
+            if (stamp != base_type::published_stamp(latest_version)) {
+                // The writer has started overwriting this slot.
+                continue;
+            }
+
+            const size_type snapshot_size = base_type::size_at(slot);
+            if (snapshot_size <= max_size_) {
+                std::memcpy(buffer.data(), slot + base_type::header_size(),
+                    std::min(snapshot_size, buffer.size()));
+            }
+
+            // Make the bytes of the snapshot read before checking the stamp
+            // again.
+            boost::atomic_thread_fence(boost::memory_order::acquire);
+            if (base_type::stamp_at(slot).load(boost::memory_order::relaxed) ==
+                stamp) {
+                size = snapshot_size;
+                return latest_version;
+            }
+        }
+    }
+
+private:
+    //! Atomic variable of the version of the latest snapshot.
+    const atomic_type* atomic_version_;
+
+    //! Buffer.
+    char* buffer_;
+
+    //! Maximum size of snapshots.
+    size_type max_size_;
+};
+
+}  // namespace details
+}  // namespace shm_stream
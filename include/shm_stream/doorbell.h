@@ -0,0 +1,173 @@
+/*
+ * Copyright 2023 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Definition of doorbell class.
+ */
+#pragma once
+
+#include <utility>
+
+#include "shm_stream/c_interface/doorbell.h"
+#include "shm_stream/details/throw_if_error.h"
+
+namespace shm_stream {
+
+/*!
+ * \brief Class of doorbells to notify readers of streams of commits of
+ * writers.
+ *
+ * A doorbell is a file descriptor (eventfd on Linux) which can be waited
+ * using poll, epoll, or other event loops together with other file
+ * descriptors. Set the same doorbell to a writer and a reader of a stream,
+ * then the reader can wait for the doorbell as follows:
+ *
+ * 1. Call arm_doorbell function of the reader.
+ * 2. If the function returns true, wait for the file descriptor to be
+ *    readable.
+ * 3. Read bytes from the stream, and go back to 1.
+ *
+ * Writers ring the doorbell only when the reader armed it, so writers don't
+ * make system calls while the reader is reading bytes. Doorbells can be
+ * passed to other processes via Unix domain sockets using send and receive
+ * functions.
+ *
+ * \note This class owns a file descriptor of the doorbell.
+ */
+class doorbell {
+public:
+    /*!
+     * \brief Constructor.
+     *
+     * \note This constructor doesn't create a doorbell. Use create function
+     * to create a doorbell.
+     */
+    doorbell() noexcept = default;
+
+    /*!
+     * \brief Constructor.
+     *
+     * \param[in] fd File descriptor to own.
+     */
+    explicit doorbell(int fd) noexcept : fd_(fd) {}
+
+    // Prevent copy.
+    doorbell(const doorbell&) = delete;
+    auto operator=(const doorbell&) = delete;
+
+    /*!
+     * \brief Move constructor.
+     *
+     * \param[in] obj Object to move from.
+     */
+    doorbell(doorbell&& obj) noexcept : fd_(std::exchange(obj.fd_, -1)) {}
+
+    /*!
+     * \brief Move assignment operator.
+     *
+     * \param[in] obj Object to move from.
+     * \return This.
+     */
+    doorbell& operator=(doorbell&& obj) noexcept {
+        if (this != &obj) {
+            reset();
+            fd_ = std::exchange(obj.fd_, -1);
+        }
+        return *this;
+    }
+
+    /*!
+     * \brief Destructor.
+     */
+    ~doorbell() noexcept { reset(); }
+
+    /*!
+     * \brief Create a doorbell.
+     *
+     * \return Doorbell.
+     *
+     * \note This function is supported only on Linux.
+     */
+    [[nodiscard]] static doorbell create() {
+        int fd{-1};
+        details::throw_if_error(c_shm_stream_doorbell_create(&fd));
+        return doorbell(fd);
+    }
+
+    /*!
+     * \brief Receive a doorbell from another process via a Unix domain
+     * socket.
+     *
+     * \param[in] socket Socket.
+     * \return Doorbell.
+     */
+    [[nodiscard]] static doorbell receive(int socket) {
+        int fd{-1};
+        details::throw_if_error(c_shm_stream_doorbell_receive(socket, &fd));
+        return doorbell(fd);
+    }
+
+    /*!
+     * \brief Send this doorbell to another process via a Unix domain socket.
+     *
+     * \param[in] socket Socket.
+     */
+    void send(int socket) const {
+        details::throw_if_error(c_shm_stream_doorbell_send(socket, fd_));
+    }
+
+    /*!
+     * \brief Check whether this object has a file descriptor.
+     *
+     * \retval true This object has a file descriptor.
+     * \retval false This object has no file descriptor.
+     */
+    [[nodiscard]] bool is_valid() const noexcept { return fd_ >= 0; }
+
+    /*!
+     * \brief Get the file descriptor.
+     *
+     * \return File descriptor.
+     *
+     * \note Wait for this file descriptor to be readable.
+     */
+    [[nodiscard]] int fd() const noexcept { return fd_; }
+
+    /*!
+     * \brief Release the ownership of the file descriptor.
+     *
+     * \return File descriptor.
+     */
+    [[nodiscard]] int release() noexcept { return std::exchange(fd_, -1); }
+
+    /*!
+     * \brief Close the file descriptor.
+     *
+     * \note Writers and readers which this doorbell is set to keep their own
+     * file descriptors.
+     */
+    void reset() noexcept {
+        if (fd_ >= 0) {
+            c_shm_stream_doorbell_close(std::exchange(fd_, -1));
+        }
+    }
+
+private:
+    //! File descriptor. (-1 if not valid.)
+    int fd_{-1};
+};
+
+}  // namespace shm_stream
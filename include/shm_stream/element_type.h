@@ -0,0 +1,162 @@
+/*
+ * Copyright 2023 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Definition of types of elements in typed streams.
+ */
+#pragma once
+
+#include <cstddef>
+#include <initializer_list>
+#include <limits>
+#include <type_traits>
+#include <typeinfo>
+
+#include "shm_stream/c_interface/error_codes.h"
+#include "shm_stream/common_types.h"
+#include "shm_stream/details/cache_line_size.h"
+#include "shm_stream/shm_stream_exception.h"
+
+namespace shm_stream {
+
+/*!
+ * \brief Traits of types of elements in typed streams.
+ *
+ * The name of a type is used to check that the writer and readers of a stream
+ * use the same type of elements. The default name is the one of
+ * `std::type_info`, which is the same only among processes built with the
+ * same compiler. Specialize this template to give a name which is the same
+ * among all processes.
+ *
+ * \tparam T Type of elements.
+ */
+template <typename T>
+struct element_type_traits {
+    /*!
+     * \brief Get the name of the type.
+     *
+     * \return Name.
+     */
+    [[nodiscard]] static const char* name() noexcept {
+        return typeid(T).name();
+    }
+};
+
+namespace details {
+
+/*!
+ * \brief Check a type of elements in typed streams.
+ *
+ * \tparam T Type of elements.
+ */
+template <typename T>
+constexpr void check_element_type() noexcept {
+    static_assert(std::is_trivially_copyable<T>::value,
+        "Elements in typed streams must be trivially copyable.");
+    static_assert(alignof(T) <= cache_line_size(),
+        "Elements in typed streams must not be over-aligned.");
+}
+
+/*!
+ * \brief Calculate the fingerprint of a type of elements.
+ *
+ * \tparam T Type of elements.
+ * \return Fingerprint. (Not zero.)
+ */
+template <typename T>
+[[nodiscard]] shm_stream_size64_t element_type_fingerprint() noexcept {
+    check_element_type<T>();
+
+    // FNV-1a hash of the name, the size, and the alignment of the type.
+    constexpr shm_stream_size64_t offset_basis = 0xCBF29CE484222325U;
+    constexpr shm_stream_size64_t prime = 0x100000001B3U;
+    shm_stream_size64_t hash = offset_basis;
+    const auto add_byte = [&hash](unsigned char byte) {
+        hash ^= byte;
+        hash *= prime;
+    };
+    for (const char* name = element_type_traits<T>::name(); *name != '\0';
+         ++name) {
+        add_byte(static_cast<unsigned char>(*name));
+    }
+    for (const shm_stream_size64_t value :
+        {static_cast<shm_stream_size64_t>(sizeof(T)),
+            static_cast<shm_stream_size64_t>(alignof(T))}) {
+        for (std::size_t i = 0U; i < sizeof(shm_stream_size64_t); ++i) {
+            add_byte(static_cast<unsigned char>(value >> (8U * i)));
+        }
+    }
+
+    // Zero is used for streams of bytes.
+    return hash == 0U ? 1U : hash;
+}
+
+/*!
+ * \brief Calculate the size of buffers of typed streams.
+ *
+ * \tparam T Type of elements.
+ * \param[in] capacity Number of elements which can be written at once.
+ * \return Number of bytes.
+ *
+ * \note Streams leave one byte unused to distinguish full buffers from empty
+ * buffers, so one more element is allocated to write the given number of
+ * elements.
+ */
+template <typename T>
+[[nodiscard]] shm_stream_size_t typed_stream_buffer_size(
+    shm_stream_size_t capacity) {
+    check_element_type<T>();
+    constexpr shm_stream_size_t max_capacity =
+        std::numeric_limits<shm_stream_size_t>::max() / sizeof(T) - 1U;
+    if (capacity == 0U || capacity > max_capacity) {
+        throw shm_stream_error(c_shm_stream_error_code_invalid_argument);
+    }
+    return static_cast<shm_stream_size_t>((capacity + 1U) * sizeof(T));
+}
+
+/*!
+ * \brief Convert a number of elements to the number of bytes.
+ *
+ * \tparam T Type of elements.
+ * \param[in] num_elements Number of elements.
+ * \return Number of bytes. (Saturated at the maximum multiple of the size of
+ * elements.)
+ */
+template <typename T>
+[[nodiscard]] constexpr shm_stream_size_t elements_to_bytes(
+    shm_stream_size_t num_elements) noexcept {
+    constexpr shm_stream_size_t max_elements =
+        std::numeric_limits<shm_stream_size_t>::max() / sizeof(T);
+    return static_cast<shm_stream_size_t>(
+        (num_elements < max_elements ? num_elements : max_elements) *
+        sizeof(T));
+}
+
+/*!
+ * \brief Convert a number of bytes to the number of whole elements.
+ *
+ * \tparam T Type of elements.
+ * \param[in] num_bytes Number of bytes.
+ * \return Number of elements.
+ */
+template <typename T>
+[[nodiscard]] constexpr shm_stream_size_t bytes_to_elements(
+    shm_stream_size_t num_bytes) noexcept {
+    return static_cast<shm_stream_size_t>(num_bytes / sizeof(T));
+}
+
+}  // namespace details
+}  // namespace shm_stream
@@ -0,0 +1,109 @@
+/*
+ * Copyright 2023 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Definition of elements_view class.
+ */
+#pragma once
+
+#include "shm_stream/common_types.h"
+
+namespace shm_stream {
+
+/*!
+ * \brief Class of views of sequences of elements.
+ *
+ * \tparam T Type of elements. (Constant type for views of constant
+ * elements.)
+ */
+template <typename T>
+class elements_view {
+public:
+    //! Type of elements.
+    using value_type = T;
+
+    //! Type of sizes.
+    using size_type = shm_stream_size_t;
+
+    //! Type of iterators.
+    using iterator = T*;
+
+    /*!
+     * \brief Constructor.
+     *
+     * \param[in] data Pointer to the first element.
+     * \param[in] size Number of elements.
+     */
+    constexpr elements_view(T* data, size_type size) noexcept
+        : data_(data), size_(size) {}
+
+    /*!
+     * \brief Get the pointer to the first element.
+     *
+     * \return Pointer to the first element.
+     */
+    [[nodiscard]] constexpr T* data() const noexcept { return data_; }
+
+    /*!
+     * \brief Get the number of elements.
+     *
+     * \return Number of elements.
+     */
+    [[nodiscard]] constexpr size_type size() const noexcept { return size_; }
+
+    /*!
+     * \brief Check whether this view is empty.
+     *
+     * \retval true This view is empty.
+     * \retval false This view is not empty.
+     */
+    [[nodiscard]] constexpr bool empty() const noexcept { return size_ == 0U; }
+
+    /*!
+     * \brief Get an element.
+     *
+     * \param[in] index Index of the element.
+     * \return Element.
+     */
+    [[nodiscard]] constexpr T& operator[](size_type index) const noexcept {
+        return data_[index];
+    }
+
+    /*!
+     * \brief Get the iterator to the first element.
+     *
+     * \return Iterator.
+     */
+    [[nodiscard]] constexpr iterator begin() const noexcept { return data_; }
+
+    /*!
+     * \brief Get the iterator to the past-the-end element.
+     *
+     * \return Iterator.
+     */
+    [[nodiscard]] constexpr iterator end() const noexcept {
+        return data_ + size_;
+    }
+
+private:
+    //! Pointer to the first element.
+    T* data_;
+
+    //! Number of elements.
+    size_type size_;
+};
+
+}  // namespace shm_stream
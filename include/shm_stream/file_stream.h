@@ -0,0 +1,355 @@
+/*
+ * Copyright 2023 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Definition of file-backed streams of bytes.
+ */
+#pragma once
+
+#include "shm_stream/bytes_view.h"
+#include "shm_stream/c_interface/file_stream_common.h"
+#include "shm_stream/c_interface/file_stream_reader.h"
+#include "shm_stream/c_interface/file_stream_writer.h"
+#include "shm_stream/c_interface/string_view.h"
+#include "shm_stream/common_types.h"
+#include "shm_stream/details/smart_ptr.h"
+#include "shm_stream/details/throw_if_error.h"
+#include "shm_stream/flush_policy.h"
+#include "shm_stream/string_view.h"
+
+namespace shm_stream {
+
+/*!
+ * \brief Class of writer of file-backed streams of bytes.
+ *
+ * Bytes are kept in a memory-mapped file, so bytes not read yet remain after
+ * all writers and readers are closed and can be read again for replay.
+ *
+ * \thread_safety All operation is safe if only one writer exists.
+ */
+class file_stream_writer {
+public:
+    /*!
+     * \brief Constructor.
+     */
+    file_stream_writer() = default;
+
+    // Prevent copy.
+    file_stream_writer(const file_stream_writer&) = delete;
+    auto operator=(const file_stream_writer&) = delete;
+
+    /*!
+     * \brief Move constructor.
+     */
+    file_stream_writer(file_stream_writer&& /*obj*/) noexcept = default;
+
+    /*!
+     * \brief Move assignment operator.
+     *
+     * \return This.
+     */
+    file_stream_writer& operator=(
+        file_stream_writer&& /*obj*/) noexcept = default;
+
+    /*!
+     * \brief Destructor.
+     *
+     * \note This function will automatically close this stream.
+     */
+    ~file_stream_writer() noexcept = default;
+
+    /*!
+     * \brief Open a stream.
+     *
+     * \param[in] path Path of the file.
+     * \param[in] buffer_size Size of the buffer.
+     * \param[in] policy Policy to flush.
+     */
+    void open(string_view path, shm_stream_size_t buffer_size,
+        const flush_policy& policy = flush_policy()) {
+        c_shm_stream_file_stream_writer_t* writer{nullptr};
+        details::throw_if_error(c_shm_stream_file_stream_writer_create(&writer,
+            c_shm_stream_string_view_t{path.data(), path.size()}, buffer_size,
+            policy.c_policy()));
+        writer_ = details::smart_ptr<c_shm_stream_file_stream_writer_t>(
+            writer, c_shm_stream_file_stream_writer_destroy);
+    }
+
+    /*!
+     * \brief Close a stream.
+     *
+     * \note This function can be called when this stream has been already
+     * closed.
+     * \note Bytes committed after the last flush are flushed here unless the
+     * mode of the policy is flush_mode::none.
+     */
+    void close() noexcept { writer_.reset(); }
+
+    /*!
+     * \brief Check whether this object is opened.
+     *
+     * \retval true This object is opened.
+     * \retval false This object is not opened.
+     */
+    [[nodiscard]] bool is_opened() const noexcept { return writer_.has_obj(); }
+
+    /*!
+     * \brief Get the number of the available bytes to write.
+     *
+     * \return Number of the available bytes to write.
+     */
+    [[nodiscard]] shm_stream_size_t available_size() const noexcept {
+        return c_shm_stream_file_stream_writer_available_size(writer_.get());
+    }
+
+    /*!
+     * \brief Try to reserve some bytes to write.
+     *
+     * \param[in] expected_size Expected number of bytes to reserve to write.
+     * \return Buffer of the reserved bytes.
+     *
+     * \note This function tries to reserve given number of bytes, but a smaller
+     * or empty buffer may be returned.
+     * \note This function can return a buffer with a size smaller than the
+     * return value of available_size function, because this stream uses a
+     * circular buffer in the implementation and this function reserves
+     * continuous byte sequences from the circular buffer.
+     */
+    [[nodiscard]] mutable_bytes_view try_reserve(
+        shm_stream_size_t expected_size) noexcept {
+        const auto buf = c_shm_stream_file_stream_writer_try_reserve(
+            writer_.get(), expected_size);
+        return mutable_bytes_view(buf.data, buf.size);
+    }
+
+    /*!
+     * \brief Try to reserve some bytes to write as many as possible.
+     *
+     * \return Buffer of the reserved bytes.
+     *
+     * \note This function can return a buffer with a size smaller than the
+     * return value of available_size function, because this stream uses a
+     * circular buffer in the implementation and this function reserves
+     * continuous byte sequences from the circular buffer.
+     */
+    [[nodiscard]] mutable_bytes_view try_reserve() noexcept {
+        const auto buf =
+            c_shm_stream_file_stream_writer_try_reserve_all(writer_.get());
+        return mutable_bytes_view(buf.data, buf.size);
+    }
+
+    /*!
+     * \brief Save written bytes as completed and ready to be read by a reader.
+     *
+     * \param[in] written_size Number of written bytes to save.
+     *
+     * \note This function flushes the file according to the policy. Bytes are
+     * committed even if the flush fails and an exception is thrown.
+     */
+    void commit(shm_stream_size_t written_size) {
+        details::throw_if_error(c_shm_stream_file_stream_writer_commit(
+            writer_.get(), written_size));
+    }
+
+    /*!
+     * \brief Flush committed bytes to the file synchronously.
+     */
+    void flush() {
+        details::throw_if_error(
+            c_shm_stream_file_stream_writer_flush(writer_.get()));
+    }
+
+    /*!
+     * \brief Get the number of flushes done by this writer.
+     *
+     * \return Number of flushes.
+     */
+    [[nodiscard]] shm_stream_size_t flush_count() const noexcept {
+        return c_shm_stream_file_stream_writer_flush_count(writer_.get());
+    }
+
+private:
+    //! Actual writer in C interface.
+    details::smart_ptr<c_shm_stream_file_stream_writer_t> writer_{};
+};
+
+/*!
+ * \brief Class of reader of file-backed streams of bytes.
+ *
+ * \thread_safety All operation is safe if only one reader exists.
+ */
+class file_stream_reader {
+public:
+    /*!
+     * \brief Constructor.
+     */
+    file_stream_reader() = default;
+
+    // Prevent copy.
+    file_stream_reader(const file_stream_reader&) = delete;
+    auto operator=(const file_stream_reader&) = delete;
+
+    /*!
+     * \brief Move constructor.
+     *
+     * \param[in] obj Object to move from.
+     */
+    file_stream_reader(file_stream_reader&& obj) noexcept = default;
+
+    /*!
+     * \brief Move assignment operator.
+     *
+     * \param[in] obj Object to move from.
+     * \return This.
+     */
+    file_stream_reader& operator=(file_stream_reader&& obj) noexcept = default;
+
+    /*!
+     * \brief Destructor.
+     *
+     * \note This function will automatically close this stream.
+     */
+    ~file_stream_reader() noexcept = default;
+
+    /*!
+     * \brief Open a stream.
+     *
+     * \param[in] path Path of the file.
+     * \param[in] buffer_size Size of the buffer.
+     */
+    void open(string_view path, shm_stream_size_t buffer_size) {
+        c_shm_stream_file_stream_reader_t* reader{nullptr};
+        details::throw_if_error(c_shm_stream_file_stream_reader_create(&reader,
+            c_shm_stream_string_view_t{path.data(), path.size()},
+            buffer_size));
+        reader_ = details::smart_ptr<c_shm_stream_file_stream_reader_t>(
+            reader, c_shm_stream_file_stream_reader_destroy);
+    }
+
+    /*!
+     * \brief Close a stream.
+     *
+     * \note This function can be called when this stream has been already
+     * closed.
+     */
+    void close() noexcept { reader_.reset(); }
+
+    /*!
+     * \brief Check whether this object is opened.
+     *
+     * \retval true This object is opened.
+     * \retval false This object is not opened.
+     */
+    [[nodiscard]] bool is_opened() const noexcept { return reader_.has_obj(); }
+
+    /*!
+     * \brief Get the number of the available bytes to read.
+     *
+     * \return Number of the available bytes to read.
+     */
+    [[nodiscard]] shm_stream_size_t available_size() const noexcept {
+        return c_shm_stream_file_stream_reader_available_size(reader_.get());
+    }
+
+    /*!
+     * \brief Try to reserve some bytes to read.
+     *
+     * \param[in] expected_size Expected number of bytes to reserve to read.
+     * \return Buffer of the reserved bytes.
+     *
+     * \note This function tries to reserve given number of bytes, but a smaller
+     * or empty buffer may be returned.
+     * \note This function can return a buffer with a size smaller than the
+     * return value of available_size function, because this stream uses a
+     * circular buffer in the implementation and this function reserves
+     * continuous byte sequences from the circular buffer.
+     */
+    [[nodiscard]] bytes_view try_reserve(
+        shm_stream_size_t expected_size) noexcept {
+        const auto buf = c_shm_stream_file_stream_reader_try_reserve(
+            reader_.get(), expected_size);
+        return bytes_view(buf.data, buf.size);
+    }
+
+    /*!
+     * \brief Try to reserve some bytes to read as many as possible.
+     *
+     * \return Buffer of the reserved bytes.
+     *
+     * \note This function can return a buffer with a size smaller than the
+     * return value of available_size function, because this stream uses a
+     * circular buffer in the implementation and this function reserves
+     * continuous byte sequences from the circular buffer.
+     */
+    [[nodiscard]] bytes_view try_reserve() noexcept {
+        const auto buf =
+            c_shm_stream_file_stream_reader_try_reserve_all(reader_.get());
+        return bytes_view(buf.data, buf.size);
+    }
+
+    /*!
+     * \brief Set some bytes as finished to read and ready to be written by a
+     * writer.
+     *
+     * \param[in] read_size Number of read bytes to save.
+     */
+    void commit(shm_stream_size_t read_size) noexcept {
+        c_shm_stream_file_stream_reader_commit(reader_.get(), read_size);
+    }
+
+private:
+    //! Actual reader in C interface.
+    details::smart_ptr<c_shm_stream_file_stream_reader_t> reader_{};
+};
+
+namespace file_stream {
+
+/*!
+ * \brief Class of writer of file-backed streams of bytes.
+ */
+using writer = file_stream_writer;
+
+/*!
+ * \brief Class of reader of file-backed streams of bytes.
+ */
+using reader = file_stream_reader;
+
+/*!
+ * \brief Create a stream.
+ *
+ * \param[in] path Path of the file.
+ * \param[in] buffer_size Size of the buffer.
+ *
+ * \note If the file already exists, the stream in the file is used.
+ */
+inline void create(string_view path, shm_stream_size_t buffer_size) {
+    details::throw_if_error(c_shm_stream_file_stream_create(
+        c_shm_stream_string_view_t{path.data(), path.size()}, buffer_size));
+}
+
+/*!
+ * \brief Remove a stream.
+ *
+ * \param[in] path Path of the file.
+ */
+inline void remove(string_view path) {
+    c_shm_stream_file_stream_remove(
+        c_shm_stream_string_view_t{path.data(), path.size()});
+}
+
+}  // namespace file_stream
+
+}  // namespace shm_stream
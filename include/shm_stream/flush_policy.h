@@ -0,0 +1,140 @@
+/*
+ * Copyright 2023 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Definition of flush_policy class.
+ */
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+#include "shm_stream/c_interface/flush_policy.h"
+
+namespace shm_stream {
+
+/*!
+ * \brief Enumeration of modes to flush file-backed streams.
+ */
+enum class flush_mode {
+    //! Flush only when requested explicitly.
+    none = c_shm_stream_flush_mode_none,
+
+    /*!
+     * \brief Flush on commits if the interval has passed since the last flush.
+     *
+     * The interval is checked only on commits. Bytes committed after the
+     * last flush are flushed when the writer is closed.
+     */
+    periodic = c_shm_stream_flush_mode_periodic,
+
+    //! Flush on every commit.
+    on_commit = c_shm_stream_flush_mode_on_commit
+};
+
+/*!
+ * \brief Class of policies to flush file-backed streams.
+ *
+ * Flushing writes the modified pages of a stream to the file synchronously,
+ * so that written bytes survive crashes of the operating system.
+ */
+class flush_policy {
+public:
+    /*!
+     * \brief Constructor.
+     *
+     * \note Streams with this policy are flushed only when requested
+     * explicitly.
+     */
+    constexpr flush_policy() noexcept
+        : flush_policy(flush_mode::none, std::chrono::milliseconds(0)) {}
+
+    /*!
+     * \brief Constructor.
+     *
+     * \param[in] mode Mode.
+     * \param[in] interval Interval of flushes for periodic mode.
+     */
+    constexpr flush_policy(
+        flush_mode mode, std::chrono::milliseconds interval) noexcept
+        : policy_{static_cast<c_shm_stream_flush_mode_t>(mode),
+              static_cast<std::uint32_t>(interval.count())} {}
+
+    /*!
+     * \brief Constructor.
+     *
+     * \param[in] policy Policy in C interface.
+     */
+    explicit constexpr flush_policy(
+        const c_shm_stream_flush_policy_t& policy) noexcept
+        : policy_(policy) {}
+
+    /*!
+     * \brief Create a policy to flush on every commit.
+     *
+     * \return Policy.
+     */
+    [[nodiscard]] static constexpr flush_policy on_commit() noexcept {
+        return flush_policy(
+            flush_mode::on_commit, std::chrono::milliseconds(0));
+    }
+
+    /*!
+     * \brief Create a policy to flush periodically.
+     *
+     * \param[in] interval Interval of flushes.
+     * \return Policy.
+     */
+    [[nodiscard]] static constexpr flush_policy periodic(
+        std::chrono::milliseconds interval) noexcept {
+        return flush_policy(flush_mode::periodic, interval);
+    }
+
+    /*!
+     * \brief Get the mode.
+     *
+     * \return Mode.
+     */
+    [[nodiscard]] constexpr flush_mode mode() const noexcept {
+        return static_cast<flush_mode>(policy_.mode);
+    }
+
+    /*!
+     * \brief Get the interval of flushes for periodic mode.
+     *
+     * \return Interval.
+     */
+    [[nodiscard]] constexpr std::chrono::milliseconds interval()
+        const noexcept {
+        return std::chrono::milliseconds(policy_.interval_milliseconds);
+    }
+
+    /*!
+     * \brief Get the policy in C interface.
+     *
+     * \return Policy.
+     */
+    [[nodiscard]] constexpr const c_shm_stream_flush_policy_t& c_policy()
+        const noexcept {
+        return policy_;
+    }
+
+private:
+    //! Policy in C interface.
+    c_shm_stream_flush_policy_t policy_;
+};
+
+}  // namespace shm_stream
@@ -0,0 +1,336 @@
+/*
+ * Copyright 2023 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Definition of light streams of bytes with operations inlined into
+ * callers.
+ */
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+#include <boost/atomic/fences.hpp>
+#include <boost/atomic/ipc_atomic.hpp>
+#include <boost/memory_order.hpp>
+
+#include "shm_stream/bytes_view.h"
+#include "shm_stream/c_interface/light_stream_common.h"
+#include "shm_stream/c_interface/light_stream_reader.h"
+#include "shm_stream/c_interface/light_stream_writer.h"
+#include "shm_stream/c_interface/string_view.h"
+#include "shm_stream/common_types.h"
+#include "shm_stream/details/atomic_index_pair.h"
+#include "shm_stream/details/light_bytes_queue.h"
+#include "shm_stream/details/smart_ptr.h"
+#include "shm_stream/details/throw_if_error.h"
+#include "shm_stream/doorbell.h"
+#include "shm_stream/shm_stream_assert.h"
+#include "shm_stream/string_view.h"
+
+namespace shm_stream {
+
+/*!
+ * \brief Class of writer of light streams of bytes with operations inlined
+ * into callers.
+ *
+ * This class is compatible with light_stream_writer, but operates the queue in
+ * the shared memory directly in functions inlined into callers, and uses the C
+ * interface of this library only to open and close streams (and to ring
+ * doorbells armed by readers). This class avoids calls of functions in the
+ * shared library for each message.
+ *
+ * \thread_safety All operation is safe if only one writer exists.
+ */
+class inline_light_stream_writer {
+public:
+    /*!
+     * \brief Constructor.
+     */
+    inline_light_stream_writer() = default;
+
+    /*!
+     * \brief Open a stream.
+     *
+     * \param[in] name Name of the stream.
+     * \param[in] buffer_size Size of the buffer.
+     * \param[in] options Options of memory.
+     */
+    void open(string_view name, shm_stream_size_t buffer_size,
+        memory_options options = memory_options::none) {
+        c_shm_stream_light_stream_writer_t* writer{nullptr};
+        details::throw_if_error(
+            c_shm_stream_light_stream_writer_create_with_memory_options(
+                &writer, c_shm_stream_string_view_t{name.data(), name.size()},
+                buffer_size,
+                static_cast<c_shm_stream_memory_options_t>(options)));
+        details::smart_ptr<c_shm_stream_light_stream_writer_t> writer_ptr(
+            writer, c_shm_stream_light_stream_writer_destroy);
+
+        c_shm_stream_light_stream_queue_layout_t layout{};
+        details::throw_if_error(
+            c_shm_stream_light_stream_writer_queue_layout(writer, &layout));
+        auto queue = std::make_unique<details::light_bytes_queue_writer<>>(
+            *static_cast<details::atomic_index_pair<>*>(layout.atomic_indices),
+            mutable_bytes_view(layout.buffer, layout.buffer_size),
+            layout.is_mirrored);
+
+        writer_ = std::move(writer_ptr);
+        queue_ = std::move(queue);
+        doorbell_armed_ =
+            static_cast<boost::atomics::ipc_atomic<std::uint32_t>*>(
+                layout.doorbell_armed);
+        has_doorbell_ = false;
+    }
+
+    /*!
+     * \brief Close a stream.
+     *
+     * \note This function can be called when this stream has been already
+     * closed.
+     */
+    void close() noexcept {
+        queue_.reset();
+        writer_.reset();
+        doorbell_armed_ = nullptr;
+        has_doorbell_ = false;
+    }
+
+    /*!
+     * \brief Check whether this object is opened.
+     *
+     * \retval true This object is opened.
+     * \retval false This object is not opened.
+     */
+    [[nodiscard]] bool is_opened() const noexcept { return writer_.has_obj(); }
+
+    /*!
+     * \brief Get the number of the available bytes to write.
+     *
+     * \return Number of the available bytes to write.
+     *
+     * \note This object must be opened.
+     */
+    [[nodiscard]] shm_stream_size_t available_size() const noexcept {
+        SHM_STREAM_ASSERT(queue_);
+        return queue_->available_size();
+    }
+
+    /*!
+     * \brief Set a doorbell to ring when a reader armed it.
+     *
+     * \param[in] bell Doorbell. (Invalid doorbell to remove the doorbell.)
+     */
+    void set_doorbell(const doorbell& bell) {
+        details::throw_if_error(c_shm_stream_light_stream_writer_set_doorbell(
+            writer_.get(), bell.fd()));
+        has_doorbell_ = bell.is_valid();
+    }
+
+    /*!
+     * \brief Try to reserve some bytes to write.
+     *
+     * \param[in] expected_size Expected number of bytes to reserve to write.
+     * \return Buffer of the reserved bytes.
+     *
+     * \note This function tries to reserve given number of bytes, but a smaller
+     * or empty buffer may be returned.
+     * \note This object must be opened.
+     */
+    [[nodiscard]] mutable_bytes_view try_reserve(
+        shm_stream_size_t expected_size) noexcept {
+        SHM_STREAM_ASSERT(queue_);
+        return queue_->try_reserve(expected_size);
+    }
+
+    /*!
+     * \brief Try to reserve some bytes to write as many as possible.
+     *
+     * \return Buffer of the reserved bytes.
+     *
+     * \note This object must be opened.
+     */
+    [[nodiscard]] mutable_bytes_view try_reserve() noexcept {
+        SHM_STREAM_ASSERT(queue_);
+        return queue_->try_reserve();
+    }
+
+    /*!
+     * \brief Save written bytes as completed and ready to be read by a reader.
+     *
+     * \param[in] written_size Number of written bytes to save.
+     *
+     * \note This object must be opened.
+     */
+    void commit(shm_stream_size_t written_size) noexcept {
+        SHM_STREAM_ASSERT(queue_);
+        queue_->commit(written_size);
+        if (has_doorbell_) {
+            // This fence is paired with the fence in arming doorbells so that
+            // either the writer sees the armed doorbell or the reader sees
+            // the new index.
+            boost::atomics::atomic_thread_fence(boost::memory_order::seq_cst);
+            if (doorbell_armed_->load(boost::memory_order::relaxed) != 0U) {
+                c_shm_stream_light_stream_writer_ring_doorbell(writer_.get());
+            }
+        }
+    }
+
+private:
+    //! Actual writer in C interface.
+    details::smart_ptr<c_shm_stream_light_stream_writer_t> writer_{};
+
+    //! Queue operated in this object.
+    std::unique_ptr<details::light_bytes_queue_writer<>> queue_{};
+
+    //! Atomic variable of whether the reader armed the doorbell.
+    boost::atomics::ipc_atomic<std::uint32_t>* doorbell_armed_{nullptr};
+
+    //! Whether a doorbell is set.
+    bool has_doorbell_{false};
+};
+
+/*!
+ * \brief Class of reader of light streams of bytes with operations inlined
+ * into callers.
+ *
+ * This class is compatible with light_stream_reader, but operates the queue in
+ * the shared memory directly in functions inlined into callers, and uses the C
+ * interface of this library only to open and close streams. This class avoids
+ * calls of functions in the shared library for each message.
+ *
+ * \thread_safety All operation is safe if only one reader exists.
+ *
+ * \note Doorbells are not supported in this class. Use light_stream_reader to
+ * wait for doorbells.
+ */
+class inline_light_stream_reader {
+public:
+    /*!
+     * \brief Constructor.
+     */
+    inline_light_stream_reader() = default;
+
+    /*!
+     * \brief Open a stream.
+     *
+     * \param[in] name Name of the stream.
+     * \param[in] buffer_size Size of the buffer.
+     * \param[in] options Options of memory.
+     */
+    void open(string_view name, shm_stream_size_t buffer_size,
+        memory_options options = memory_options::none) {
+        c_shm_stream_light_stream_reader_t* reader{nullptr};
+        details::throw_if_error(
+            c_shm_stream_light_stream_reader_create_with_memory_options(
+                &reader, c_shm_stream_string_view_t{name.data(), name.size()},
+                buffer_size,
+                static_cast<c_shm_stream_memory_options_t>(options)));
+        details::smart_ptr<c_shm_stream_light_stream_reader_t> reader_ptr(
+            reader, c_shm_stream_light_stream_reader_destroy);
+
+        c_shm_stream_light_stream_queue_layout_t layout{};
+        details::throw_if_error(
+            c_shm_stream_light_stream_reader_queue_layout(reader, &layout));
+        auto queue = std::make_unique<details::light_bytes_queue_reader<>>(
+            *static_cast<details::atomic_index_pair<>*>(layout.atomic_indices),
+            bytes_view(layout.buffer, layout.buffer_size), layout.is_mirrored);
+
+        reader_ = std::move(reader_ptr);
+        queue_ = std::move(queue);
+    }
+
+    /*!
+     * \brief Close a stream.
+     *
+     * \note This function can be called when this stream has been already
+     * closed.
+     */
+    void close() noexcept {
+        queue_.reset();
+        reader_.reset();
+    }
+
+    /*!
+     * \brief Check whether this object is opened.
+     *
+     * \retval true This object is opened.
+     * \retval false This object is not opened.
+     */
+    [[nodiscard]] bool is_opened() const noexcept { return reader_.has_obj(); }
+
+    /*!
+     * \brief Get the number of the available bytes to read.
+     *
+     * \return Number of the available bytes to read.
+     *
+     * \note This object must be opened.
+     */
+    [[nodiscard]] shm_stream_size_t available_size() const noexcept {
+        SHM_STREAM_ASSERT(queue_);
+        return queue_->available_size();
+    }
+
+    /*!
+     * \brief Try to reserve some bytes to read.
+     *
+     * \param[in] expected_size Expected number of bytes to reserve to read.
+     * \return Buffer of the reserved bytes.
+     *
+     * \note This function tries to reserve given number of bytes, but a smaller
+     * or empty buffer may be returned.
+     * \note This object must be opened.
+     */
+    [[nodiscard]] bytes_view try_reserve(
+        shm_stream_size_t expected_size) noexcept {
+        SHM_STREAM_ASSERT(queue_);
+        return queue_->try_reserve(expected_size);
+    }
+
+    /*!
+     * \brief Try to reserve some bytes to read as many as possible.
+     *
+     * \return Buffer of the reserved bytes.
+     *
+     * \note This object must be opened.
+     */
+    [[nodiscard]] bytes_view try_reserve() noexcept {
+        SHM_STREAM_ASSERT(queue_);
+        return queue_->try_reserve();
+    }
+
+    /*!
+     * \brief Save read bytes as completed and ready to be written by a writer.
+     *
+     * \param[in] read_size Number of read bytes to save.
+     *
+     * \note This object must be opened.
+     */
+    void commit(shm_stream_size_t read_size) noexcept {
+        SHM_STREAM_ASSERT(queue_);
+        queue_->commit(read_size);
+    }
+
+private:
+    //! Actual reader in C interface.
+    details::smart_ptr<c_shm_stream_light_stream_reader_t> reader_{};
+
+    //! Queue operated in this object.
+    std::unique_ptr<details::light_bytes_queue_reader<>> queue_{};
+};
+
+}  // namespace shm_stream
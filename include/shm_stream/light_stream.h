@@ -20,14 +20,19 @@
  */
 #pragma once
 
+#include <initializer_list>
+
 #include "shm_stream/bytes_view.h"
 #include "shm_stream/c_interface/light_stream_common.h"
 #include "shm_stream/c_interface/light_stream_reader.h"
 #include "shm_stream/c_interface/light_stream_writer.h"
 #include "shm_stream/c_interface/string_view.h"
 #include "shm_stream/common_types.h"
+#include "shm_stream/details/scatter_gather.h"
 #include "shm_stream/details/smart_ptr.h"
 #include "shm_stream/details/throw_if_error.h"
+#include "shm_stream/doorbell.h"
+#include "shm_stream/stream_reactor.h"
 #include "shm_stream/string_view.h"
 
 namespace shm_stream {
@@ -74,11 +79,16 @@ public:
      *
      * \param[in] name Name of the stream.
      * \param[in] buffer_size Size of the buffer.
+     * \param[in] options Options of memory.
      */
-    void open(string_view name, shm_stream_size_t buffer_size) {
+    void open(string_view name, shm_stream_size_t buffer_size,
+        memory_options options = memory_options::none) {
         c_shm_stream_light_stream_writer_t* writer{nullptr};
-        details::throw_if_error(c_shm_stream_light_stream_writer_create(&writer,
-            c_shm_stream_string_view_t{name.data(), name.size()}, buffer_size));
+        details::throw_if_error(
+            c_shm_stream_light_stream_writer_create_with_memory_options(
+                &writer, c_shm_stream_string_view_t{name.data(), name.size()},
+                buffer_size,
+                static_cast<c_shm_stream_memory_options_t>(options)));
         writer_ = details::smart_ptr<c_shm_stream_light_stream_writer_t>(
             writer, c_shm_stream_light_stream_writer_destroy);
     }
@@ -108,6 +118,41 @@ public:
         return c_shm_stream_light_stream_writer_available_size(writer_.get());
     }
 
+    /*!
+     * \brief Get the size of pages backing the buffer of the stream.
+     *
+     * \return Size of pages actually used by the operating system.
+     *
+     * \note This function is useful to check whether huge pages are used with
+     * buffer_layout::huge_pages layout. Pages may be allocated at the first
+     * access, so call this function after some data are transferred.
+     */
+    [[nodiscard]] shm_stream_size_t page_size() const noexcept {
+        return c_shm_stream_light_stream_writer_page_size(writer_.get());
+    }
+
+    /*!
+     * \brief Get the NUMA node on which pages of the stream are.
+     *
+     * \return NUMA node having the most pages of the stream. (numa_node_none
+     * if unknown.)
+     */
+    [[nodiscard]] numa_node_t numa_node() const noexcept {
+        return c_shm_stream_light_stream_writer_numa_node(writer_.get());
+    }
+
+    /*!
+     * \brief Set a doorbell to ring when a reader armed it.
+     *
+     * \param[in] bell Doorbell. (An empty doorbell to remove the doorbell.)
+     *
+     * \note This object keeps its own file descriptor of the doorbell.
+     */
+    void set_doorbell(const doorbell& bell) {
+        details::throw_if_error(c_shm_stream_light_stream_writer_set_doorbell(
+            writer_.get(), bell.fd()));
+    }
+
     /*!
      * \brief Try to reserve some bytes to write.
      *
@@ -146,6 +191,26 @@ public:
         return mutable_bytes_view(buf.data, buf.size);
     }
 
+#ifdef SHM_STREAM_HAS_COROUTINES
+    /*!
+     * \brief Asynchronously wait to reserve some bytes to write.
+     *
+     * \param[in] expected_size Expected number of bytes to reserve to write.
+     * \param[in] reactor Reactor to resume the awaiting coroutine.
+     * \return Awaitable object returning the buffer of the reserved bytes.
+     *
+     * \note The awaiting coroutine is resumed in the thread of the reactor
+     * when at least one byte is available.
+     * \note This function is available only in C++20 or later.
+     */
+    [[nodiscard]] details::reserve_awaitable<light_stream_writer>
+    async_reserve(shm_stream_size_t expected_size,
+        stream_reactor& reactor = stream_reactor::default_reactor()) {
+        return details::reserve_awaitable<light_stream_writer>(
+            *this, expected_size, reactor);
+    }
+#endif
+
     /*!
      * \brief Save written bytes as completed and ready to be read by a reader.
      *
@@ -155,6 +220,54 @@ public:
         c_shm_stream_light_stream_writer_commit(writer_.get(), written_size);
     }
 
+    /*!
+     * \brief Try to write bytes gathered from pieces at once.
+     *
+     * \param[in] pieces Pieces of bytes to write in order.
+     * \param[in] num_pieces Number of the pieces.
+     * \retval true All pieces were written.
+     * \retval false Space was not enough to write all pieces. (No byte is
+     * written.)
+     *
+     * \note This function copies all pieces into one reservation, wrapping
+     * around the end of the circular buffer, and commits them at once.
+     */
+    [[nodiscard]] bool try_write_gather(
+        const bytes_view* pieces, shm_stream_size_t num_pieces) noexcept {
+        return c_shm_stream_light_stream_writer_try_write_gather(
+            writer_.get(), details::to_c_bytes_views(pieces), num_pieces);
+    }
+
+    /*!
+     * \brief Try to write bytes gathered from pieces at once.
+     *
+     * \param[in] pieces Pieces of bytes to write in order.
+     * \retval true All pieces were written.
+     * \retval false Space was not enough to write all pieces. (No byte is
+     * written.)
+     */
+    [[nodiscard]] bool try_write_gather(
+        std::initializer_list<bytes_view> pieces) noexcept {
+        return try_write_gather(
+            pieces.begin(), static_cast<shm_stream_size_t>(pieces.size()));
+    }
+
+    /*!
+     * \brief Try to write all bytes in a byte sequence.
+     *
+     * \param[in] data Bytes to write.
+     * \retval true All bytes were written.
+     * \retval false Space was not enough to write all bytes. (No byte is
+     * written.)
+     *
+     * \note This function copies bytes with non-temporal stores for large
+     * byte sequences so that the bytes do not evict the cache of the writer.
+     */
+    [[nodiscard]] bool try_write_all(bytes_view data) noexcept {
+        return c_shm_stream_light_stream_writer_try_write_all(
+            writer_.get(), c_shm_stream_bytes_view_t{data.data(), data.size()});
+    }
+
 private:
     //! Actual writer in C interface.
     details::smart_ptr<c_shm_stream_light_stream_writer_t> writer_{};
@@ -205,11 +318,16 @@ public:
      *
      * \param[in] name Name of the stream.
      * \param[in] buffer_size Size of the buffer.
+     * \param[in] options Options of memory.
      */
-    void open(string_view name, shm_stream_size_t buffer_size) {
+    void open(string_view name, shm_stream_size_t buffer_size,
+        memory_options options = memory_options::none) {
         c_shm_stream_light_stream_reader_t* reader{nullptr};
-        details::throw_if_error(c_shm_stream_light_stream_reader_create(&reader,
-            c_shm_stream_string_view_t{name.data(), name.size()}, buffer_size));
+        details::throw_if_error(
+            c_shm_stream_light_stream_reader_create_with_memory_options(
+                &reader, c_shm_stream_string_view_t{name.data(), name.size()},
+                buffer_size,
+                static_cast<c_shm_stream_memory_options_t>(options)));
         reader_ = details::smart_ptr<c_shm_stream_light_stream_reader_t>(
             reader, c_shm_stream_light_stream_reader_destroy);
     }
@@ -239,6 +357,55 @@ public:
         return c_shm_stream_light_stream_reader_available_size(reader_.get());
     }
 
+    /*!
+     * \brief Get the size of pages backing the buffer of the stream.
+     *
+     * \return Size of pages actually used by the operating system.
+     *
+     * \note This function is useful to check whether huge pages are used with
+     * buffer_layout::huge_pages layout. Pages may be allocated at the first
+     * access, so call this function after some data are transferred.
+     */
+    [[nodiscard]] shm_stream_size_t page_size() const noexcept {
+        return c_shm_stream_light_stream_reader_page_size(reader_.get());
+    }
+
+    /*!
+     * \brief Get the NUMA node on which pages of the stream are.
+     *
+     * \return NUMA node having the most pages of the stream. (numa_node_none
+     * if unknown.)
+     */
+    [[nodiscard]] numa_node_t numa_node() const noexcept {
+        return c_shm_stream_light_stream_reader_numa_node(reader_.get());
+    }
+
+    /*!
+     * \brief Set a doorbell to be notified of commits of the writer.
+     *
+     * \param[in] bell Doorbell. (An empty doorbell to remove the doorbell.)
+     *
+     * \note This object keeps its own file descriptor of the doorbell.
+     */
+    void set_doorbell(const doorbell& bell) {
+        details::throw_if_error(c_shm_stream_light_stream_reader_set_doorbell(
+            reader_.get(), bell.fd()));
+    }
+
+    /*!
+     * \brief Arm the doorbell before waiting for it.
+     *
+     * \retval true Doorbell is armed. Wait for the file descriptor of the
+     * doorbell to be readable, then read bytes and call this function again.
+     * \retval false Some bytes are available, so the
+     * doorbell is not armed.
+     *
+     * \note The doorbell must be set to both the writer and this reader.
+     */
+    [[nodiscard]] bool arm_doorbell() noexcept {
+        return c_shm_stream_light_stream_reader_arm_doorbell(reader_.get());
+    }
+
     /*!
      * \brief Try to reserve some bytes to read.
      *
@@ -277,6 +444,26 @@ public:
         return bytes_view(buf.data, buf.size);
     }
 
+#ifdef SHM_STREAM_HAS_COROUTINES
+    /*!
+     * \brief Asynchronously wait to reserve some bytes to read.
+     *
+     * \param[in] expected_size Expected number of bytes to reserve to read.
+     * \param[in] reactor Reactor to resume the awaiting coroutine.
+     * \return Awaitable object returning the buffer of the reserved bytes.
+     *
+     * \note The awaiting coroutine is resumed in the thread of the reactor
+     * when at least one byte is available.
+     * \note This function is available only in C++20 or later.
+     */
+    [[nodiscard]] details::reserve_awaitable<light_stream_reader>
+    async_reserve(shm_stream_size_t expected_size,
+        stream_reactor& reactor = stream_reactor::default_reactor()) {
+        return details::reserve_awaitable<light_stream_reader>(
+            *this, expected_size, reactor);
+    }
+#endif
+
     /*!
      * \brief Set some bytes as finished to read and ready to be written by a
      * writer.
@@ -287,6 +474,56 @@ public:
         c_shm_stream_light_stream_reader_commit(reader_.get(), read_size);
     }
 
+    /*!
+     * \brief Try to read bytes scattering into pieces at once.
+     *
+     * \param[in] pieces Pieces of buffers to fill in order.
+     * \param[in] num_pieces Number of the pieces.
+     * \retval true All pieces were filled.
+     * \retval false Bytes were not enough to fill all pieces. (No byte is
+     * read.)
+     *
+     * \note This function copies bytes into all pieces from one reservation,
+     * wrapping around the end of the circular buffer, and commits them at
+     * once.
+     */
+    [[nodiscard]] bool try_read_scatter(const mutable_bytes_view* pieces,
+        shm_stream_size_t num_pieces) noexcept {
+        return c_shm_stream_light_stream_reader_try_read_scatter(
+            reader_.get(), details::to_c_bytes_views(pieces), num_pieces);
+    }
+
+    /*!
+     * \brief Try to read bytes scattering into pieces at once.
+     *
+     * \param[in] pieces Pieces of buffers to fill in order.
+     * \retval true All pieces were filled.
+     * \retval false Bytes were not enough to fill all pieces. (No byte is
+     * read.)
+     */
+    [[nodiscard]] bool try_read_scatter(
+        std::initializer_list<mutable_bytes_view> pieces) noexcept {
+        return try_read_scatter(
+            pieces.begin(), static_cast<shm_stream_size_t>(pieces.size()));
+    }
+
+    /*!
+     * \brief Try to read bytes filling a buffer.
+     *
+     * \param[in] buffer Buffer to fill.
+     * \retval true The buffer was filled.
+     * \retval false Bytes were not enough to fill the buffer. (No byte is
+     * read.)
+     *
+     * \note Unlike the function to write all bytes in the writer, this
+     * function copies bytes without non-temporal stores, because the bytes
+     * are used by the reader soon.
+     */
+    [[nodiscard]] bool try_read_exact(mutable_bytes_view buffer) noexcept {
+        return c_shm_stream_light_stream_reader_try_read_exact(reader_.get(),
+            c_shm_stream_mutable_bytes_view_t{buffer.data(), buffer.size()});
+    }
+
 private:
     //! Actual reader in C interface.
     details::smart_ptr<c_shm_stream_light_stream_reader_t> reader_{};
@@ -315,10 +552,27 @@ using reader = light_stream_reader;
  *
  * \param[in] name Name of the stream.
  * \param[in] buffer_size Size of the buffer.
+ * \param[in] layout Layout of the buffer.
+ * \param[in] numa_node NUMA node to bind pages to. (numa_node_current for the
+ * node of the CPU running the calling thread, numa_node_none for the usual
+ * placement of pages.)
+ *
+ * \note If the stream already exists, the layout and the placement of pages
+ * of the existing stream are used.
+ * \note If pages cannot be bound to the NUMA node, the stream is not created.
  */
-inline void create(string_view name, shm_stream_size_t buffer_size) {
-    details::throw_if_error(c_shm_stream_light_stream_create(
-        c_shm_stream_string_view_t{name.data(), name.size()}, buffer_size));
+inline void create(string_view name, shm_stream_size_t buffer_size,
+    buffer_layout layout = buffer_layout::plain,
+    numa_node_t numa_node = numa_node_none) {
+    if (numa_node == numa_node_none) {
+        details::throw_if_error(c_shm_stream_light_stream_create_with_layout(
+            c_shm_stream_string_view_t{name.data(), name.size()}, buffer_size,
+            static_cast<c_shm_stream_buffer_layout_t>(layout)));
+        return;
+    }
+    details::throw_if_error(c_shm_stream_light_stream_create_on_numa_node(
+        c_shm_stream_string_view_t{name.data(), name.size()}, buffer_size,
+        static_cast<c_shm_stream_buffer_layout_t>(layout), numa_node));
 }
 
 /*!
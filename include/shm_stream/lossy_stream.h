@@ -0,0 +1,328 @@
+/*
+ * Copyright 2023 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Definition of lossy streams of messages overwriting the oldest
+ * messages when full.
+ */
+#pragma once
+
+#include "shm_stream/bytes_view.h"
+#include "shm_stream/c_interface/error_codes.h"
+#include "shm_stream/c_interface/lossy_stream_common.h"
+#include "shm_stream/c_interface/lossy_stream_reader.h"
+#include "shm_stream/c_interface/lossy_stream_writer.h"
+#include "shm_stream/c_interface/string_view.h"
+#include "shm_stream/common_types.h"
+#include "shm_stream/details/smart_ptr.h"
+#include "shm_stream/details/throw_if_error.h"
+#include "shm_stream/shm_stream_exception.h"
+#include "shm_stream/string_view.h"
+
+namespace shm_stream {
+
+/*!
+ * \brief Class of writer of lossy streams of messages.
+ *
+ * The writer never waits for readers. When the buffer is full, the writer
+ * overwrites the oldest message, and readers lagging behind detect the lost
+ * messages.
+ *
+ * \thread_safety All operation is safe if only one writer exists.
+ */
+class lossy_stream_writer {
+public:
+    /*!
+     * \brief Constructor.
+     */
+    lossy_stream_writer() = default;
+
+    // Prevent copy.
+    lossy_stream_writer(const lossy_stream_writer&) = delete;
+    auto operator=(const lossy_stream_writer&) = delete;
+
+    /*!
+     * \brief Move constructor.
+     */
+    lossy_stream_writer(lossy_stream_writer&& /*obj*/) noexcept = default;
+
+    /*!
+     * \brief Move assignment operator.
+     *
+     * \return This.
+     */
+    lossy_stream_writer& operator=(
+        lossy_stream_writer&& /*obj*/) noexcept = default;
+
+    /*!
+     * \brief Destructor.
+     *
+     * \note This function will automatically close this stream.
+     */
+    ~lossy_stream_writer() noexcept = default;
+
+    /*!
+     * \brief Open a stream.
+     *
+     * \param[in] name Name of the stream.
+     * \param[in] num_records Number of records in the buffer. (Must be a power
+     * of two.)
+     * \param[in] max_message_size Maximum size of messages.
+     *
+     * \note If the stream already exists, the parameters of the existing
+     * stream are used.
+     */
+    void open(string_view name, shm_stream_size_t num_records,
+        shm_stream_size_t max_message_size) {
+        c_shm_stream_lossy_stream_writer_t* writer{nullptr};
+        details::throw_if_error(c_shm_stream_lossy_stream_writer_create(&writer,
+            c_shm_stream_string_view_t{name.data(), name.size()}, num_records,
+            max_message_size));
+        writer_ = details::smart_ptr<c_shm_stream_lossy_stream_writer_t>(
+            writer, c_shm_stream_lossy_stream_writer_destroy);
+        max_message_size_ =
+            c_shm_stream_lossy_stream_writer_max_message_size(writer_.get());
+    }
+
+    /*!
+     * \brief Close a stream.
+     *
+     * \note This function can be called when this stream has been already
+     * closed.
+     */
+    void close() noexcept {
+        writer_.reset();
+        max_message_size_ = 0U;
+    }
+
+    /*!
+     * \brief Check whether this object is opened.
+     *
+     * \retval true This object is opened.
+     * \retval false This object is not opened.
+     */
+    [[nodiscard]] bool is_opened() const noexcept { return writer_.has_obj(); }
+
+    /*!
+     * \brief Get the maximum size of messages.
+     *
+     * \return Maximum number of bytes in a message.
+     */
+    [[nodiscard]] shm_stream_size_t max_message_size() const noexcept {
+        return max_message_size_;
+    }
+
+    /*!
+     * \brief Reserve a message to write.
+     *
+     * \param[in] message_size Size of the message.
+     * \return Buffer of the message.
+     *
+     * \note Reserved message is sent to readers by commit_message function.
+     * \note This function overwrites the oldest message in the stream.
+     */
+    [[nodiscard]] mutable_bytes_view reserve_message(
+        shm_stream_size_t message_size) {
+        if (message_size > max_message_size_) {
+            throw shm_stream_error(c_shm_stream_error_code_invalid_argument);
+        }
+        const auto buf = c_shm_stream_lossy_stream_writer_reserve(
+            writer_.get(), message_size);
+        return mutable_bytes_view(buf.data, buf.size);
+    }
+
+    /*!
+     * \brief Save the reserved message as completed and ready to be read by
+     * readers.
+     */
+    void commit_message() noexcept {
+        c_shm_stream_lossy_stream_writer_commit(writer_.get());
+    }
+
+private:
+    //! Actual writer in C interface.
+    details::smart_ptr<c_shm_stream_lossy_stream_writer_t> writer_{};
+
+    //! Maximum size of messages.
+    shm_stream_size_t max_message_size_{0U};
+};
+
+/*!
+ * \brief Class of reader of lossy streams of messages.
+ *
+ * Readers don't modify the stream, so any number of readers can read the same
+ * stream. When the writer has overwritten messages not read yet, the reader
+ * skips to the oldest message left in the stream and counts the skipped
+ * messages in lost_messages function.
+ *
+ * \thread_safety All operation is safe if each reader is used in one thread.
+ */
+class lossy_stream_reader {
+public:
+    /*!
+     * \brief Constructor.
+     */
+    lossy_stream_reader() = default;
+
+    // Prevent copy.
+    lossy_stream_reader(const lossy_stream_reader&) = delete;
+    auto operator=(const lossy_stream_reader&) = delete;
+
+    /*!
+     * \brief Move constructor.
+     *
+     * \param[in] obj Object to move from.
+     */
+    lossy_stream_reader(lossy_stream_reader&& obj) noexcept = default;
+
+    /*!
+     * \brief Move assignment operator.
+     *
+     * \param[in] obj Object to move from.
+     * \return This.
+     */
+    lossy_stream_reader& operator=(
+        lossy_stream_reader&& obj) noexcept = default;
+
+    /*!
+     * \brief Destructor.
+     *
+     * \note This function will automatically close this stream.
+     */
+    ~lossy_stream_reader() noexcept = default;
+
+    /*!
+     * \brief Open a stream.
+     *
+     * \param[in] name Name of the stream.
+     * \param[in] num_records Number of records in the buffer. (Must be a power
+     * of two.)
+     * \param[in] max_message_size Maximum size of messages.
+     *
+     * \note The reader starts from the oldest message left in the stream.
+     * \note If the stream already exists, the parameters of the existing
+     * stream are used.
+     */
+    void open(string_view name, shm_stream_size_t num_records,
+        shm_stream_size_t max_message_size) {
+        c_shm_stream_lossy_stream_reader_t* reader{nullptr};
+        details::throw_if_error(c_shm_stream_lossy_stream_reader_create(&reader,
+            c_shm_stream_string_view_t{name.data(), name.size()}, num_records,
+            max_message_size));
+        reader_ = details::smart_ptr<c_shm_stream_lossy_stream_reader_t>(
+            reader, c_shm_stream_lossy_stream_reader_destroy);
+    }
+
+    /*!
+     * \brief Close a stream.
+     *
+     * \note This function can be called when this stream has been already
+     * closed.
+     */
+    void close() noexcept { reader_.reset(); }
+
+    /*!
+     * \brief Check whether this object is opened.
+     *
+     * \retval true This object is opened.
+     * \retval false This object is not opened.
+     */
+    [[nodiscard]] bool is_opened() const noexcept { return reader_.has_obj(); }
+
+    /*!
+     * \brief Try to get the next message.
+     *
+     * \return Buffer of the message. If no message is available now, the data
+     * pointer of the buffer is null.
+     *
+     * \note The message can be overwritten by the writer while reading it, so
+     * copy the message and check the return value of commit_message function
+     * before using the copy.
+     */
+    [[nodiscard]] bytes_view next_message() noexcept {
+        const auto buf = c_shm_stream_lossy_stream_reader_next(reader_.get());
+        return bytes_view(buf.data, buf.size);
+    }
+
+    /*!
+     * \brief Finish reading the message returned by next_message function.
+     *
+     * \retval true The message was read without being overwritten.
+     * \retval false The message was overwritten while reading it.
+     */
+    bool commit_message() noexcept {
+        return c_shm_stream_lossy_stream_reader_commit(reader_.get());
+    }
+
+    /*!
+     * \brief Get the number of messages lost because the writer overwrote them
+     * before this reader read them.
+     *
+     * \return Number of messages.
+     */
+    [[nodiscard]] shm_stream_size64_t lost_messages() const noexcept {
+        return c_shm_stream_lossy_stream_reader_lost_messages(reader_.get());
+    }
+
+private:
+    //! Actual reader in C interface.
+    details::smart_ptr<c_shm_stream_lossy_stream_reader_t> reader_{};
+};
+
+/*!
+ * \brief Classes and functions of lossy streams of messages overwriting the
+ * oldest messages when full.
+ */
+namespace lossy_stream {
+
+/*!
+ * \brief Class of writer of lossy streams of messages.
+ */
+using writer = lossy_stream_writer;
+
+/*!
+ * \brief Class of reader of lossy streams of messages.
+ */
+using reader = lossy_stream_reader;
+
+/*!
+ * \brief Create a stream.
+ *
+ * \param[in] name Name of the stream.
+ * \param[in] num_records Number of records in the buffer. (Must be a power of
+ * two.)
+ * \param[in] max_message_size Maximum size of messages.
+ */
+inline void create(string_view name, shm_stream_size_t num_records,
+    shm_stream_size_t max_message_size) {
+    details::throw_if_error(c_shm_stream_lossy_stream_create(
+        c_shm_stream_string_view_t{name.data(), name.size()}, num_records,
+        max_message_size));
+}
+
+/*!
+ * \brief Remove a stream.
+ *
+ * \param[in] name Name of the stream.
+ */
+inline void remove(string_view name) {
+    c_shm_stream_lossy_stream_remove(
+        c_shm_stream_string_view_t{name.data(), name.size()});
+}
+
+}  // namespace lossy_stream
+
+}  // namespace shm_stream
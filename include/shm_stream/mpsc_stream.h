@@ -0,0 +1,294 @@
+/*
+ * Copyright 2023 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Definition of MPSC streams of messages without waiting (possibly
+ * lock-free).
+ */
+#pragma once
+
+#include "shm_stream/bytes_view.h"
+#include "shm_stream/c_interface/error_codes.h"
+#include "shm_stream/c_interface/mpsc_stream_common.h"
+#include "shm_stream/c_interface/mpsc_stream_reader.h"
+#include "shm_stream/c_interface/mpsc_stream_writer.h"
+#include "shm_stream/c_interface/string_view.h"
+#include "shm_stream/common_types.h"
+#include "shm_stream/details/smart_ptr.h"
+#include "shm_stream/details/throw_if_error.h"
+#include "shm_stream/shm_stream_exception.h"
+#include "shm_stream/string_view.h"
+
+namespace shm_stream {
+
+/*!
+ * \brief Class of writer of MPSC streams of messages without waiting
+ * (possibly lock-free).
+ *
+ * Each message is written contiguously in the buffer with its size, so
+ * the reader gets one complete message at once.
+ *
+ * \thread_safety Multiple writers can write to the same stream concurrently,
+ * but each writer object must be used in only one thread at once.
+ */
+class mpsc_stream_writer {
+public:
+    /*!
+     * \brief Constructor.
+     */
+    mpsc_stream_writer() = default;
+
+    // Prevent copy.
+    mpsc_stream_writer(const mpsc_stream_writer&) = delete;
+    auto operator=(const mpsc_stream_writer&) = delete;
+
+    /*!
+     * \brief Move constructor.
+     */
+    mpsc_stream_writer(mpsc_stream_writer&& /*obj*/) noexcept = default;
+
+    /*!
+     * \brief Move assignment operator.
+     *
+     * \return This.
+     */
+    mpsc_stream_writer& operator=(
+        mpsc_stream_writer&& /*obj*/) noexcept = default;
+
+    /*!
+     * \brief Destructor.
+     *
+     * \note This function will automatically close this stream.
+     */
+    ~mpsc_stream_writer() noexcept = default;
+
+    /*!
+     * \brief Open a stream.
+     *
+     * \param[in] name Name of the stream.
+     * \param[in] buffer_size Size of the buffer.
+     */
+    void open(string_view name, shm_stream_size_t buffer_size) {
+        c_shm_stream_mpsc_stream_writer_t* writer{nullptr};
+        details::throw_if_error(c_shm_stream_mpsc_stream_writer_create(&writer,
+            c_shm_stream_string_view_t{name.data(), name.size()}, buffer_size));
+        writer_ = details::smart_ptr<c_shm_stream_mpsc_stream_writer_t>(
+            writer, c_shm_stream_mpsc_stream_writer_destroy);
+        max_message_size_ =
+            c_shm_stream_mpsc_stream_writer_max_message_size(writer_.get());
+    }
+
+    /*!
+     * \brief Close a stream.
+     *
+     * \note This function can be called when this stream has been already
+     * closed.
+     */
+    void close() noexcept {
+        writer_.reset();
+        max_message_size_ = 0U;
+    }
+
+    /*!
+     * \brief Check whether this object is opened.
+     *
+     * \retval true This object is opened.
+     * \retval false This object is not opened.
+     */
+    [[nodiscard]] bool is_opened() const noexcept { return writer_.has_obj(); }
+
+    /*!
+     * \brief Get the maximum size of messages.
+     *
+     * \return Maximum number of bytes in a message.
+     */
+    [[nodiscard]] shm_stream_size_t max_message_size() const noexcept {
+        return max_message_size_;
+    }
+
+    /*!
+     * \brief Try to reserve a message to write.
+     *
+     * \param[in] message_size Size of the message.
+     * \return Buffer of the message. If the message cannot be reserved now,
+     * the data pointer of the buffer is null.
+     *
+     * \note Reserved message is sent to the reader by commit_message function.
+     */
+    [[nodiscard]] mutable_bytes_view reserve_message(
+        shm_stream_size_t message_size) {
+        if (message_size > max_message_size_) {
+            throw shm_stream_error(c_shm_stream_error_code_invalid_argument);
+        }
+        const auto buf = c_shm_stream_mpsc_stream_writer_try_reserve(
+            writer_.get(), message_size);
+        return mutable_bytes_view(buf.data, buf.size);
+    }
+
+    /*!
+     * \brief Save the reserved message as completed and ready to be read by the
+     * reader.
+     */
+    void commit_message() noexcept {
+        c_shm_stream_mpsc_stream_writer_commit(writer_.get());
+    }
+
+private:
+    //! Actual writer in C interface.
+    details::smart_ptr<c_shm_stream_mpsc_stream_writer_t> writer_{};
+
+    //! Maximum size of messages.
+    shm_stream_size_t max_message_size_{0U};
+};
+
+/*!
+ * \brief Class of reader of MPSC streams of messages without waiting
+ * (possibly lock-free).
+ *
+ * \thread_safety All operation is safe if only one reader exists.
+ */
+class mpsc_stream_reader {
+public:
+    /*!
+     * \brief Constructor.
+     */
+    mpsc_stream_reader() = default;
+
+    // Prevent copy.
+    mpsc_stream_reader(const mpsc_stream_reader&) = delete;
+    auto operator=(const mpsc_stream_reader&) = delete;
+
+    /*!
+     * \brief Move constructor.
+     *
+     * \param[in] obj Object to move from.
+     */
+    mpsc_stream_reader(mpsc_stream_reader&& obj) noexcept = default;
+
+    /*!
+     * \brief Move assignment operator.
+     *
+     * \param[in] obj Object to move from.
+     * \return This.
+     */
+    mpsc_stream_reader& operator=(mpsc_stream_reader&& obj) noexcept = default;
+
+    /*!
+     * \brief Destructor.
+     *
+     * \note This function will automatically close this stream.
+     */
+    ~mpsc_stream_reader() noexcept = default;
+
+    /*!
+     * \brief Open a stream.
+     *
+     * \param[in] name Name of the stream.
+     * \param[in] buffer_size Size of the buffer.
+     */
+    void open(string_view name, shm_stream_size_t buffer_size) {
+        c_shm_stream_mpsc_stream_reader_t* reader{nullptr};
+        details::throw_if_error(c_shm_stream_mpsc_stream_reader_create(&reader,
+            c_shm_stream_string_view_t{name.data(), name.size()}, buffer_size));
+        reader_ = details::smart_ptr<c_shm_stream_mpsc_stream_reader_t>(
+            reader, c_shm_stream_mpsc_stream_reader_destroy);
+    }
+
+    /*!
+     * \brief Close a stream.
+     *
+     * \note This function can be called when this stream has been already
+     * closed.
+     */
+    void close() noexcept { reader_.reset(); }
+
+    /*!
+     * \brief Check whether this object is opened.
+     *
+     * \retval true This object is opened.
+     * \retval false This object is not opened.
+     */
+    [[nodiscard]] bool is_opened() const noexcept { return reader_.has_obj(); }
+
+    /*!
+     * \brief Try to get the next message.
+     *
+     * \return Buffer of the message. If no message is available now, the data
+     * pointer of the buffer is null.
+     *
+     * \note This function returns the same message until commit_message
+     * function is called.
+     */
+    [[nodiscard]] bytes_view next_message() noexcept {
+        const auto buf = c_shm_stream_mpsc_stream_reader_next(reader_.get());
+        return bytes_view(buf.data, buf.size);
+    }
+
+    /*!
+     * \brief Set the message returned by next_message function as finished to
+     * read.
+     */
+    void commit_message() noexcept {
+        c_shm_stream_mpsc_stream_reader_commit(reader_.get());
+    }
+
+private:
+    //! Actual reader in C interface.
+    details::smart_ptr<c_shm_stream_mpsc_stream_reader_t> reader_{};
+};
+
+/*!
+ * \brief Classes and functions of MPSC streams of messages without waiting
+ * (possibly lock-free).
+ */
+namespace mpsc_stream {
+
+/*!
+ * \brief Class of writer of streams of messages without waiting (possibly
+ * lock-free).
+ */
+using writer = mpsc_stream_writer;
+
+/*!
+ * \brief Class of reader of streams of messages without waiting (possibly
+ * lock-free).
+ */
+using reader = mpsc_stream_reader;
+
+/*!
+ * \brief Create a stream.
+ *
+ * \param[in] name Name of the stream.
+ * \param[in] buffer_size Size of the buffer. (Must be a power of two.)
+ */
+inline void create(string_view name, shm_stream_size_t buffer_size) {
+    details::throw_if_error(c_shm_stream_mpsc_stream_create(
+        c_shm_stream_string_view_t{name.data(), name.size()}, buffer_size));
+}
+
+/*!
+ * \brief Remove a stream.
+ *
+ * \param[in] name Name of the stream.
+ */
+inline void remove(string_view name) {
+    c_shm_stream_mpsc_stream_remove(
+        c_shm_stream_string_view_t{name.data(), name.size()});
+}
+
+}  // namespace mpsc_stream
+
+}  // namespace shm_stream
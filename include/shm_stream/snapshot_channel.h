@@ -0,0 +1,315 @@
+/*
+ * Copyright 2023 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Definition of channels of the latest snapshots.
+ */
+#pragma once
+
+#include "shm_stream/bytes_view.h"
+#include "shm_stream/c_interface/bytes_view.h"
+#include "shm_stream/c_interface/snapshot_channel_common.h"
+#include "shm_stream/c_interface/snapshot_channel_reader.h"
+#include "shm_stream/c_interface/snapshot_channel_writer.h"
+#include "shm_stream/c_interface/string_view.h"
+#include "shm_stream/common_types.h"
+#include "shm_stream/details/smart_ptr.h"
+#include "shm_stream/details/throw_if_error.h"
+#include "shm_stream/string_view.h"
+
+namespace shm_stream {
+
+/*!
+ * \brief Class of writer of channels of the latest snapshots.
+ *
+ * The writer publishes snapshots of a value with a bounded size, and readers
+ * get only the latest snapshot instead of all the published snapshots. The
+ * writer never waits for readers.
+ *
+ * \thread_safety All operation is safe if only one writer exists.
+ */
+class snapshot_channel_writer {
+public:
+    /*!
+     * \brief Constructor.
+     */
+    snapshot_channel_writer() = default;
+
+    // Prevent copy.
+    snapshot_channel_writer(const snapshot_channel_writer&) = delete;
+    auto operator=(const snapshot_channel_writer&) = delete;
+
+    /*!
+     * \brief Move constructor.
+     */
+    snapshot_channel_writer(
+        snapshot_channel_writer&& /*obj*/) noexcept = default;
+
+    /*!
+     * \brief Move assignment operator.
+     *
+     * \return This.
+     */
+    snapshot_channel_writer& operator=(
+        snapshot_channel_writer&& /*obj*/) noexcept = default;
+
+    /*!
+     * \brief Destructor.
+     *
+     * \note This function will automatically close this channel.
+     */
+    ~snapshot_channel_writer() noexcept = default;
+
+    /*!
+     * \brief Open a channel.
+     *
+     * \param[in] name Name of the channel.
+     * \param[in] max_size Maximum size of snapshots.
+     *
+     * \note If the channel already exists, the maximum size of the existing
+     * channel is used.
+     */
+    void open(string_view name, shm_stream_size_t max_size) {
+        c_shm_stream_snapshot_channel_writer_t* writer{nullptr};
+        details::throw_if_error(c_shm_stream_snapshot_channel_writer_create(
+            &writer, c_shm_stream_string_view_t{name.data(), name.size()},
+            max_size));
+        writer_ = details::smart_ptr<c_shm_stream_snapshot_channel_writer_t>(
+            writer, c_shm_stream_snapshot_channel_writer_destroy);
+    }
+
+    /*!
+     * \brief Close a channel.
+     *
+     * \note This function can be called when this channel has been already
+     * closed.
+     */
+    void close() noexcept { writer_.reset(); }
+
+    /*!
+     * \brief Check whether this object is opened.
+     *
+     * \retval true This object is opened.
+     * \retval false This object is not opened.
+     */
+    [[nodiscard]] bool is_opened() const noexcept { return writer_.has_obj(); }
+
+    /*!
+     * \brief Get the maximum size of snapshots.
+     *
+     * \return Maximum number of bytes in a snapshot.
+     */
+    [[nodiscard]] shm_stream_size_t max_size() const noexcept {
+        return c_shm_stream_snapshot_channel_writer_max_size(writer_.get());
+    }
+
+    /*!
+     * \brief Reserve the buffer of the next snapshot.
+     *
+     * \return Buffer of the snapshot with the maximum size.
+     *
+     * \note Readers keep reading the previous snapshot until commit function
+     * is called.
+     */
+    [[nodiscard]] mutable_bytes_view reserve() noexcept {
+        const auto buf =
+            c_shm_stream_snapshot_channel_writer_reserve(writer_.get());
+        return mutable_bytes_view(buf.data, buf.size);
+    }
+
+    /*!
+     * \brief Publish the reserved snapshot.
+     *
+     * \param[in] size Size of the snapshot.
+     */
+    void commit(shm_stream_size_t size) noexcept {
+        c_shm_stream_snapshot_channel_writer_commit(writer_.get(), size);
+    }
+
+    /*!
+     * \brief Publish a snapshot.
+     *
+     * \param[in] data Data of the snapshot.
+     */
+    void publish(bytes_view data) {
+        details::throw_if_error(
+            c_shm_stream_snapshot_channel_writer_publish(writer_.get(),
+                c_shm_stream_bytes_view_t{data.data(), data.size()}));
+    }
+
+private:
+    //! Actual writer in C interface.
+    details::smart_ptr<c_shm_stream_snapshot_channel_writer_t> writer_{};
+};
+
+/*!
+ * \brief Class of reader of channels of the latest snapshots.
+ *
+ * Readers don't modify the channel, so any number of readers can read the
+ * same channel. Reading never blocks the writer, and a reader retries copying
+ * only when the writer publishes two snapshots during one copy.
+ *
+ * \thread_safety All operation is safe if each reader is used in one thread.
+ */
+class snapshot_channel_reader {
+public:
+    /*!
+     * \brief Constructor.
+     */
+    snapshot_channel_reader() = default;
+
+    // Prevent copy.
+    snapshot_channel_reader(const snapshot_channel_reader&) = delete;
+    auto operator=(const snapshot_channel_reader&) = delete;
+
+    /*!
+     * \brief Move constructor.
+     *
+     * \param[in] obj Object to move from.
+     */
+    snapshot_channel_reader(snapshot_channel_reader&& obj) noexcept = default;
+
+    /*!
+     * \brief Move assignment operator.
+     *
+     * \param[in] obj Object to move from.
+     * \return This.
+     */
+    snapshot_channel_reader& operator=(
+        snapshot_channel_reader&& obj) noexcept = default;
+
+    /*!
+     * \brief Destructor.
+     *
+     * \note This function will automatically close this channel.
+     */
+    ~snapshot_channel_reader() noexcept = default;
+
+    /*!
+     * \brief Open a channel.
+     *
+     * \param[in] name Name of the channel.
+     * \param[in] max_size Maximum size of snapshots.
+     *
+     * \note If the channel already exists, the maximum size of the existing
+     * channel is used.
+     */
+    void open(string_view name, shm_stream_size_t max_size) {
+        c_shm_stream_snapshot_channel_reader_t* reader{nullptr};
+        details::throw_if_error(c_shm_stream_snapshot_channel_reader_create(
+            &reader, c_shm_stream_string_view_t{name.data(), name.size()},
+            max_size));
+        reader_ = details::smart_ptr<c_shm_stream_snapshot_channel_reader_t>(
+            reader, c_shm_stream_snapshot_channel_reader_destroy);
+    }
+
+    /*!
+     * \brief Close a channel.
+     *
+     * \note This function can be called when this channel has been already
+     * closed.
+     */
+    void close() noexcept { reader_.reset(); }
+
+    /*!
+     * \brief Check whether this object is opened.
+     *
+     * \retval true This object is opened.
+     * \retval false This object is not opened.
+     */
+    [[nodiscard]] bool is_opened() const noexcept { return reader_.has_obj(); }
+
+    /*!
+     * \brief Get the maximum size of snapshots.
+     *
+     * \return Maximum number of bytes in a snapshot.
+     */
+    [[nodiscard]] shm_stream_size_t max_size() const noexcept {
+        return c_shm_stream_snapshot_channel_reader_max_size(reader_.get());
+    }
+
+    /*!
+     * \brief Get the version of the latest snapshot.
+     *
+     * \return Version. (Zero if no snapshot has been published.)
+     *
+     * \note This function can be used to check whether a new snapshot has been
+     * published without copying the snapshot.
+     */
+    [[nodiscard]] shm_stream_size64_t version() const noexcept {
+        return c_shm_stream_snapshot_channel_reader_version(reader_.get());
+    }
+
+    /*!
+     * \brief Copy the latest snapshot.
+     *
+     * \param[out] buffer Buffer to copy the snapshot to. If the buffer is
+     * smaller than the snapshot, the snapshot is truncated.
+     * \param[out] size Size of the snapshot.
+     * \return Version of the copied snapshot. (Zero if no snapshot has been
+     * published.)
+     */
+    shm_stream_size64_t read(
+        mutable_bytes_view buffer, shm_stream_size_t& size) noexcept {
+        return c_shm_stream_snapshot_channel_reader_read(reader_.get(),
+            c_shm_stream_mutable_bytes_view_t{buffer.data(), buffer.size()},
+            &size);
+    }
+
+private:
+    //! Actual reader in C interface.
+    details::smart_ptr<c_shm_stream_snapshot_channel_reader_t> reader_{};
+};
+
+/*!
+ * \brief Classes and functions of channels of the latest snapshots.
+ */
+namespace snapshot_channel {
+
+/*!
+ * \brief Class of writer of channels of the latest snapshots.
+ */
+using writer = snapshot_channel_writer;
+
+/*!
+ * \brief Class of reader of channels of the latest snapshots.
+ */
+using reader = snapshot_channel_reader;
+
+/*!
+ * \brief Create a channel.
+ *
+ * \param[in] name Name of the channel.
+ * \param[in] max_size Maximum size of snapshots.
+ */
+inline void create(string_view name, shm_stream_size_t max_size) {
+    details::throw_if_error(c_shm_stream_snapshot_channel_create(
+        c_shm_stream_string_view_t{name.data(), name.size()}, max_size));
+}
+
+/*!
+ * \brief Remove a channel.
+ *
+ * \param[in] name Name of the channel.
+ */
+inline void remove(string_view name) {
+    c_shm_stream_snapshot_channel_remove(
+        c_shm_stream_string_view_t{name.data(), name.size()});
+}
+
+}  // namespace snapshot_channel
+
+}  // namespace shm_stream
@@ -0,0 +1,288 @@
+/*
+ * Copyright 2023 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Definition of stream_reactor class to resume coroutines waiting for
+ * streams.
+ *
+ * \note Contents of this header are available only in C++20 or later with
+ * support of coroutines (SHM_STREAM_HAS_COROUTINES macro is defined then).
+ */
+#pragma once
+
+#if defined(__cpp_impl_coroutine) && defined(__has_include)
+#if __has_include(<coroutine>)
+//! Macro defined when coroutines are supported.
+#define SHM_STREAM_HAS_COROUTINES 1
+#endif
+#endif
+
+#ifdef SHM_STREAM_HAS_COROUTINES
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <coroutine>
+#include <cstddef>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "shm_stream/common_types.h"
+
+namespace shm_stream {
+
+/*!
+ * \brief Class of reactors to resume coroutines waiting for streams.
+ *
+ * A reactor has a thread which periodically checks indices of streams awaited
+ * by coroutines, and resumes the coroutines in the thread when the streams
+ * become ready. The interval of checks starts from min_interval and doubles
+ * up to max_interval while no stream becomes ready, so that many streams can
+ * share a thread without busy waiting.
+ *
+ * \thread_safety All operations are safe.
+ *
+ * \note Coroutines still waiting at the destruction of a reactor are never
+ * resumed.
+ */
+class stream_reactor {
+public:
+    /*!
+     * \brief Type of functions to check whether a waiter is ready.
+     *
+     * The argument is the context given with the function.
+     */
+    using ready_checker_type = bool (*)(const void*) noexcept;
+
+    /*!
+     * \brief Constructor.
+     *
+     * \param[in] min_interval Minimum interval of checks of streams.
+     * \param[in] max_interval Maximum interval of checks of streams.
+     */
+    explicit stream_reactor(
+        std::chrono::nanoseconds min_interval = std::chrono::microseconds(1),
+        std::chrono::nanoseconds max_interval = std::chrono::milliseconds(1))
+        : min_interval_(min_interval),
+          max_interval_(std::max(min_interval, max_interval)),
+          thread_([this] { run(); }) {}
+
+    // Prevent copy.
+    stream_reactor(const stream_reactor&) = delete;
+    auto operator=(const stream_reactor&) = delete;
+
+    // Prevent move.
+    stream_reactor(stream_reactor&&) = delete;
+    auto operator=(stream_reactor&&) = delete;
+
+    /*!
+     * \brief Destructor.
+     */
+    ~stream_reactor() noexcept {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            is_stopping_ = true;
+        }
+        condition_.notify_all();
+        thread_.join();
+    }
+
+    /*!
+     * \brief Register a coroutine to resume when it is ready.
+     *
+     * \param[in] handle Handle of the coroutine.
+     * \param[in] is_ready Function to check whether the coroutine is ready.
+     * \param[in] context Context given to is_ready function.
+     */
+    void add(std::coroutine_handle<> handle, ready_checker_type is_ready,
+        const void* context) {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            added_waiters_.push_back(waiter{handle, is_ready, context});
+        }
+        condition_.notify_all();
+    }
+
+    /*!
+     * \brief Get the reactor shared in this process.
+     *
+     * \return Reactor.
+     */
+    [[nodiscard]] static stream_reactor& default_reactor() {
+        static stream_reactor reactor;
+        return reactor;
+    }
+
+private:
+    //! Struct of coroutines waiting for streams.
+    struct waiter {
+        //! Handle of the coroutine.
+        std::coroutine_handle<> handle;
+
+        //! Function to check whether the coroutine is ready.
+        ready_checker_type is_ready;
+
+        //! Context given to is_ready function.
+        const void* context;
+    };
+
+    /*!
+     * \brief Process waiters in the thread of this reactor.
+     */
+    void run() {
+        std::vector<waiter> waiters;
+        std::vector<waiter> ready_waiters;
+        std::chrono::nanoseconds interval = min_interval_;
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (true) {
+            const auto has_update = [this] {
+                return is_stopping_ || !added_waiters_.empty();
+            };
+            if (waiters.empty()) {
+                condition_.wait(lock, has_update);
+            } else {
+                condition_.wait_for(lock, interval, has_update);
+            }
+            if (is_stopping_) {
+                return;
+            }
+            waiters.insert(
+                waiters.end(), added_waiters_.begin(), added_waiters_.end());
+            added_waiters_.clear();
+            lock.unlock();
+
+            const auto ready_begin = std::stable_partition(waiters.begin(),
+                waiters.end(),
+                [](const waiter& w) { return !w.is_ready(w.context); });
+            ready_waiters.assign(ready_begin, waiters.end());
+            waiters.erase(ready_begin, waiters.end());
+            if (ready_waiters.empty()) {
+                interval = std::min(interval * 2, max_interval_);
+            } else {
+                interval = min_interval_;
+            }
+            // Resumed coroutines can register themselves again.
+            for (const auto& w : ready_waiters) {
+                w.handle.resume();
+            }
+            ready_waiters.clear();
+
+            lock.lock();
+        }
+    }
+
+    //! Minimum interval of checks of streams.
+    std::chrono::nanoseconds min_interval_;
+
+    //! Maximum interval of checks of streams.
+    std::chrono::nanoseconds max_interval_;
+
+    //! Mutex.
+    std::mutex mutex_{};
+
+    //! Condition variable to notify updates.
+    std::condition_variable condition_{};
+
+    //! Waiters added after the last check.
+    std::vector<waiter> added_waiters_{};
+
+    //! Whether this reactor is stopping.
+    bool is_stopping_{false};
+
+    //! Thread.
+    std::thread thread_;
+};
+
+namespace details {
+
+/*!
+ * \brief Class of awaitables to reserve bytes in streams.
+ *
+ * \tparam Stream Type of the writer or reader of streams.
+ */
+template <typename Stream>
+class reserve_awaitable {
+public:
+    /*!
+     * \brief Constructor.
+     *
+     * \param[in] stream Writer or reader of a stream.
+     * \param[in] expected_size Expected number of bytes to reserve.
+     * \param[in] reactor Reactor to resume the coroutine.
+     */
+    reserve_awaitable(Stream& stream, shm_stream_size_t expected_size,
+        stream_reactor& reactor) noexcept
+        : stream_(&stream), expected_size_(expected_size), reactor_(&reactor) {}
+
+    /*!
+     * \brief Check whether bytes can be reserved without suspension.
+     *
+     * \return Whether bytes can be reserved without suspension.
+     */
+    [[nodiscard]] bool await_ready() const noexcept { return is_ready(this); }
+
+    /*!
+     * \brief Suspend the coroutine until bytes can be reserved.
+     *
+     * \param[in] handle Handle of the coroutine.
+     */
+    void await_suspend(std::coroutine_handle<> handle) {
+        reactor_->add(handle, &reserve_awaitable::is_ready, this);
+    }
+
+    /*!
+     * \brief Reserve bytes.
+     *
+     * \return Buffer of the reserved bytes.
+     */
+    [[nodiscard]] auto await_resume() noexcept {
+        return stream_->try_reserve(expected_size_);
+    }
+
+private:
+    /*!
+     * \brief Check whether bytes can be reserved.
+     *
+     * \param[in] context This object.
+     * \return Whether bytes can be reserved.
+     */
+    [[nodiscard]] static bool is_ready(const void* context) noexcept {
+        const Stream& stream =
+            *static_cast<const reserve_awaitable*>(context)->stream_;
+        if constexpr (requires { stream.is_stopped(); }) {
+            if (stream.is_stopped()) {
+                return true;
+            }
+        }
+        return stream.available_size() > 0U;
+    }
+
+    //! Writer or reader of the stream.
+    Stream* stream_;
+
+    //! Expected number of bytes to reserve.
+    shm_stream_size_t expected_size_;
+
+    //! Reactor to resume the coroutine.
+    stream_reactor* reactor_;
+};
+
+}  // namespace details
+}  // namespace shm_stream
+
+#endif
@@ -0,0 +1,559 @@
+/*
+ * Copyright 2023 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Definition of blocking streams of elements of a type with wait
+ * operations.
+ */
+#pragma once
+
+#include "shm_stream/c_interface/blocking_stream_common.h"
+#include "shm_stream/c_interface/blocking_stream_reader.h"
+#include "shm_stream/c_interface/blocking_stream_writer.h"
+#include "shm_stream/c_interface/string_view.h"
+#include "shm_stream/common_types.h"
+#include "shm_stream/details/smart_ptr.h"
+#include "shm_stream/details/throw_if_error.h"
+#include "shm_stream/element_type.h"
+#include "shm_stream/elements_view.h"
+#include "shm_stream/string_view.h"
+#include "shm_stream/wait_policy.h"
+
+namespace shm_stream {
+
+/*!
+ * \brief Class of writer of blocking streams of elements of a type with wait
+ * operations.
+ *
+ * Elements are reserved and committed in whole elements, so no element is
+ * split at the end of the circular buffer, and elements in the buffer are
+ * aligned to the alignment of the type.
+ *
+ * \tparam T Type of elements. (Must be trivially copyable.)
+ *
+ * \thread_safety All operation is safe if only one writer exists,
+ * except for stop and is_stopped functions which are safe to call from any
+ * threads.
+ */
+template <typename T>
+class typed_blocking_stream_writer {
+public:
+    //! Type of elements.
+    using value_type = T;
+
+    /*!
+     * \brief Constructor.
+     */
+    typed_blocking_stream_writer() { details::check_element_type<T>(); }
+
+    // Prevent copy.
+    typed_blocking_stream_writer(const typed_blocking_stream_writer&) = delete;
+    auto operator=(const typed_blocking_stream_writer&) = delete;
+
+    /*!
+     * \brief Move constructor.
+     */
+    typed_blocking_stream_writer(
+        typed_blocking_stream_writer&& /*obj*/) noexcept = default;
+
+    /*!
+     * \brief Move assignment operator.
+     *
+     * \return This.
+     */
+    typed_blocking_stream_writer& operator=(
+        typed_blocking_stream_writer&& /*obj*/) noexcept = default;
+
+    /*!
+     * \brief Destructor.
+     *
+     * \note This function will automatically close this stream.
+     */
+    ~typed_blocking_stream_writer() noexcept = default;
+
+    /*!
+     * \brief Open a stream.
+     *
+     * \param[in] name Name of the stream.
+     * \param[in] capacity Number of elements in the buffer.
+     * \param[in] policy Policy to wait.
+     *
+     * \note If the stream already exists, the capacity of the existing stream
+     * is used.
+     * \note If the stream already exists with another type of elements, this
+     * function throws an exception.
+     */
+    void open(string_view name, shm_stream_size_t capacity,
+        const wait_policy& policy = wait_policy()) {
+        c_shm_stream_blocking_stream_writer_t* writer{nullptr};
+        details::throw_if_error(
+            c_shm_stream_blocking_stream_writer_create_typed(&writer,
+                c_shm_stream_string_view_t{name.data(), name.size()},
+                details::typed_stream_buffer_size<T>(capacity),
+                details::element_type_fingerprint<T>(),
+                static_cast<shm_stream_size_t>(sizeof(T)), policy.c_policy()));
+        writer_ = details::smart_ptr<c_shm_stream_blocking_stream_writer_t>(
+            writer, c_shm_stream_blocking_stream_writer_destroy);
+    }
+
+    /*!
+     * \brief Close a stream.
+     *
+     * \note This function can be called when this stream has been already
+     * closed.
+     */
+    void close() noexcept { writer_.reset(); }
+
+    /*!
+     * \brief Check whether this object is opened.
+     *
+     * \retval true This object is opened.
+     * \retval false This object is not opened.
+     */
+    [[nodiscard]] bool is_opened() const noexcept { return writer_.has_obj(); }
+
+    /*!
+     * \brief Get the number of the available elements to write.
+     *
+     * \return Number of the available elements to write.
+     *
+     * \note After stop of this stream, this function returns zero.
+     */
+    [[nodiscard]] shm_stream_size_t available_size() const noexcept {
+        return details::bytes_to_elements<T>(
+            c_shm_stream_blocking_stream_writer_available_size(writer_.get()));
+    }
+
+    /*!
+     * \brief Wait until some elements are available.
+     *
+     * \return Number of the available elements to write.
+     *
+     * \note After stop of this stream, this function immediately returns zero.
+     */
+    shm_stream_size_t wait() const noexcept {
+        return details::bytes_to_elements<T>(
+            c_shm_stream_blocking_stream_writer_wait(writer_.get()));
+    }
+
+    /*!
+     * \brief Stop this stream.
+     */
+    void stop() noexcept {
+        c_shm_stream_blocking_stream_writer_stop(writer_.get());
+    }
+
+    /*!
+     * \brief Check whether this stream is stopped.
+     *
+     * \retval true This stream is stopped.
+     * \retval false This stream is not stopped.
+     */
+    [[nodiscard]] bool is_stopped() const noexcept {
+        return c_shm_stream_blocking_stream_writer_is_stopped(writer_.get());
+    }
+
+    /*!
+     * \brief Try to reserve some elements to write.
+     *
+     * \param[in] expected_size Expected number of elements to reserve to
+     * write.
+     * \return Buffer of the reserved elements.
+     *
+     * \note This function tries to reserve given number of elements, but a
+     * smaller or empty buffer may be returned.
+     * \note This function can return a buffer with a size smaller than the
+     * return value of available_size function, because this stream uses a
+     * circular buffer in the implementation and this function reserves
+     * continuous elements from the circular buffer.
+     * \note After stop of this stream, this function returns empty buffers.
+     */
+    [[nodiscard]] elements_view<T> try_reserve(
+        shm_stream_size_t expected_size) noexcept {
+        return to_elements(c_shm_stream_blocking_stream_writer_try_reserve(
+            writer_.get(), details::elements_to_bytes<T>(expected_size)));
+    }
+
+    /*!
+     * \brief Try to reserve some elements to write as many as possible.
+     *
+     * \return Buffer of the reserved elements.
+     *
+     * \note This function can return a buffer with a size smaller than the
+     * return value of available_size function, because this stream uses a
+     * circular buffer in the implementation and this function reserves
+     * continuous elements from the circular buffer.
+     * \note After stop of this stream, this function returns empty buffers.
+     */
+    [[nodiscard]] elements_view<T> try_reserve() noexcept {
+        return to_elements(
+            c_shm_stream_blocking_stream_writer_try_reserve_all(writer_.get()));
+    }
+
+    /*!
+     * \brief Wait to reserve some elements to write.
+     *
+     * \param[in] expected_size Expected number of elements to reserve to
+     * write.
+     * \return Buffer of the reserved elements.
+     *
+     * \note This function returns when at least one element is available.
+     * \note This function can return a buffer with a size smaller than the
+     * return value of available_size function, because this stream uses a
+     * circular buffer in the implementation and this function reserves
+     * continuous elements from the circular buffer.
+     * \note After stop of this stream, this function immediately returns empty
+     * buffers.
+     */
+    [[nodiscard]] elements_view<T> wait_reserve(
+        shm_stream_size_t expected_size) noexcept {
+        return to_elements(c_shm_stream_blocking_stream_writer_wait_reserve(
+            writer_.get(), details::elements_to_bytes<T>(expected_size)));
+    }
+
+    /*!
+     * \brief Wait to reserve some elements to write as many as possible.
+     *
+     * \return Buffer of the reserved elements.
+     *
+     * \note This function returns when at least one element is available.
+     * \note This function can return a buffer with a size smaller than the
+     * return value of available_size function, because this stream uses a
+     * circular buffer in the implementation and this function reserves
+     * continuous elements from the circular buffer.
+     * \note After stop of this stream, this function immediately returns empty
+     * buffers.
+     */
+    [[nodiscard]] elements_view<T> wait_reserve() noexcept {
+        return to_elements(c_shm_stream_blocking_stream_writer_wait_reserve_all(
+            writer_.get()));
+    }
+
+    /*!
+     * \brief Save written elements as completed and ready to be read by a
+     * reader.
+     *
+     * \param[in] written_size Number of written elements to save.
+     */
+    void commit(shm_stream_size_t written_size) noexcept {
+        c_shm_stream_blocking_stream_writer_commit(
+            writer_.get(), details::elements_to_bytes<T>(written_size));
+    }
+
+private:
+    /*!
+     * \brief Convert a buffer of bytes to a buffer of whole elements.
+     *
+     * \param[in] buf Buffer of bytes.
+     * \return Buffer of elements.
+     */
+    [[nodiscard]] static elements_view<T> to_elements(
+        c_shm_stream_mutable_bytes_view_t buf) noexcept {
+        return elements_view<T>(static_cast<T*>(static_cast<void*>(buf.data)),
+            details::bytes_to_elements<T>(buf.size));
+    }
+
+    //! Actual writer in C interface.
+    details::smart_ptr<c_shm_stream_blocking_stream_writer_t> writer_{};
+};
+
+/*!
+ * \brief Class of reader of blocking streams of elements of a type with wait
+ * operations.
+ *
+ * \tparam T Type of elements. (Must be trivially copyable.)
+ *
+ * \thread_safety All operation is safe if only one reader exists,
+ * except for stop and is_stopped functions which are safe to call from any
+ * threads.
+ */
+template <typename T>
+class typed_blocking_stream_reader {
+public:
+    //! Type of elements.
+    using value_type = T;
+
+    /*!
+     * \brief Constructor.
+     */
+    typed_blocking_stream_reader() { details::check_element_type<T>(); }
+
+    // Prevent copy.
+    typed_blocking_stream_reader(const typed_blocking_stream_reader&) = delete;
+    auto operator=(const typed_blocking_stream_reader&) = delete;
+
+    /*!
+     * \brief Move constructor.
+     *
+     * \param[in] obj Object to move from.
+     */
+    typed_blocking_stream_reader(typed_blocking_stream_reader&& obj) noexcept =
+        default;
+
+    /*!
+     * \brief Move assignment operator.
+     *
+     * \param[in] obj Object to move from.
+     * \return This.
+     */
+    typed_blocking_stream_reader& operator=(
+        typed_blocking_stream_reader&& obj) noexcept = default;
+
+    /*!
+     * \brief Destructor.
+     *
+     * \note This function will automatically close this stream.
+     */
+    ~typed_blocking_stream_reader() noexcept = default;
+
+    /*!
+     * \brief Open a stream.
+     *
+     * \param[in] name Name of the stream.
+     * \param[in] capacity Number of elements in the buffer.
+     * \param[in] policy Policy to wait.
+     *
+     * \note If the stream already exists, the capacity of the existing stream
+     * is used.
+     * \note If the stream already exists with another type of elements, this
+     * function throws an exception.
+     */
+    void open(string_view name, shm_stream_size_t capacity,
+        const wait_policy& policy = wait_policy()) {
+        c_shm_stream_blocking_stream_reader_t* reader{nullptr};
+        details::throw_if_error(
+            c_shm_stream_blocking_stream_reader_create_typed(&reader,
+                c_shm_stream_string_view_t{name.data(), name.size()},
+                details::typed_stream_buffer_size<T>(capacity),
+                details::element_type_fingerprint<T>(),
+                static_cast<shm_stream_size_t>(sizeof(T)), policy.c_policy()));
+        reader_ = details::smart_ptr<c_shm_stream_blocking_stream_reader_t>(
+            reader, c_shm_stream_blocking_stream_reader_destroy);
+    }
+
+    /*!
+     * \brief Close a stream.
+     *
+     * \note This function can be called when this stream has been already
+     * closed.
+     */
+    void close() noexcept { reader_.reset(); }
+
+    /*!
+     * \brief Check whether this object is opened.
+     *
+     * \retval true This object is opened.
+     * \retval false This object is not opened.
+     */
+    [[nodiscard]] bool is_opened() const noexcept { return reader_.has_obj(); }
+
+    /*!
+     * \brief Get the number of the available elements to read.
+     *
+     * \return Number of the available elements to read.
+     *
+     * \note After stop of this stream, this function returns zero.
+     */
+    [[nodiscard]] shm_stream_size_t available_size() const noexcept {
+        return details::bytes_to_elements<T>(
+            c_shm_stream_blocking_stream_reader_available_size(reader_.get()));
+    }
+
+    /*!
+     * \brief Wait until some elements are available.
+     *
+     * \return Number of the available elements to read.
+     *
+     * \note After stop of this stream, this function immediately returns zero.
+     */
+    shm_stream_size_t wait() const noexcept {
+        return details::bytes_to_elements<T>(
+            c_shm_stream_blocking_stream_reader_wait(reader_.get()));
+    }
+
+    /*!
+     * \brief Stop this stream.
+     */
+    void stop() noexcept {
+        c_shm_stream_blocking_stream_reader_stop(reader_.get());
+    }
+
+    /*!
+     * \brief Check whether this stream is stopped.
+     *
+     * \retval true This stream is stopped.
+     * \retval false This stream is not stopped.
+     */
+    [[nodiscard]] bool is_stopped() const noexcept {
+        return c_shm_stream_blocking_stream_reader_is_stopped(reader_.get());
+    }
+
+    /*!
+     * \brief Try to reserve some elements to read.
+     *
+     * \param[in] expected_size Expected number of elements to reserve to
+     * read.
+     * \return Buffer of the reserved elements.
+     *
+     * \note This function tries to reserve given number of elements, but a
+     * smaller or empty buffer may be returned.
+     * \note This function can return a buffer with a size smaller than the
+     * return value of available_size function, because this stream uses a
+     * circular buffer in the implementation and this function reserves
+     * continuous elements from the circular buffer.
+     * \note After stop of this stream, this function returns empty buffers.
+     */
+    [[nodiscard]] elements_view<const T> try_reserve(
+        shm_stream_size_t expected_size) noexcept {
+        return to_elements(c_shm_stream_blocking_stream_reader_try_reserve(
+            reader_.get(), details::elements_to_bytes<T>(expected_size)));
+    }
+
+    /*!
+     * \brief Try to reserve some elements to read as many as possible.
+     *
+     * \return Buffer of the reserved elements.
+     *
+     * \note This function can return a buffer with a size smaller than the
+     * return value of available_size function, because this stream uses a
+     * circular buffer in the implementation and this function reserves
+     * continuous elements from the circular buffer.
+     * \note After stop of this stream, this function returns empty buffers.
+     */
+    [[nodiscard]] elements_view<const T> try_reserve() noexcept {
+        return to_elements(
+            c_shm_stream_blocking_stream_reader_try_reserve_all(reader_.get()));
+    }
+
+    /*!
+     * \brief Wait to reserve some elements to read.
+     *
+     * \param[in] expected_size Expected number of elements to reserve to
+     * read.
+     * \return Buffer of the reserved elements.
+     *
+     * \note This function returns when at least one element is available.
+     * \note This function can return a buffer with a size smaller than the
+     * return value of available_size function, because this stream uses a
+     * circular buffer in the implementation and this function reserves
+     * continuous elements from the circular buffer.
+     * \note After stop of this stream, this function immediately returns empty
+     * buffers.
+     */
+    [[nodiscard]] elements_view<const T> wait_reserve(
+        shm_stream_size_t expected_size) noexcept {
+        return to_elements(c_shm_stream_blocking_stream_reader_wait_reserve(
+            reader_.get(), details::elements_to_bytes<T>(expected_size)));
+    }
+
+    /*!
+     * \brief Wait to reserve some elements to read as many as possible.
+     *
+     * \return Buffer of the reserved elements.
+     *
+     * \note This function returns when at least one element is available.
+     * \note This function can return a buffer with a size smaller than the
+     * return value of available_size function, because this stream uses a
+     * circular buffer in the implementation and this function reserves
+     * continuous elements from the circular buffer.
+     * \note After stop of this stream, this function immediately returns empty
+     * buffers.
+     */
+    [[nodiscard]] elements_view<const T> wait_reserve() noexcept {
+        return to_elements(c_shm_stream_blocking_stream_reader_wait_reserve_all(
+            reader_.get()));
+    }
+
+    /*!
+     * \brief Set some elements as finished to read and ready to be written by
+     * a writer.
+     *
+     * \param[in] read_size Number of read elements to save.
+     */
+    void commit(shm_stream_size_t read_size) noexcept {
+        c_shm_stream_blocking_stream_reader_commit(
+            reader_.get(), details::elements_to_bytes<T>(read_size));
+    }
+
+private:
+    /*!
+     * \brief Convert a buffer of bytes to a buffer of whole elements.
+     *
+     * \param[in] buf Buffer of bytes.
+     * \return Buffer of elements.
+     */
+    [[nodiscard]] static elements_view<const T> to_elements(
+        c_shm_stream_bytes_view_t buf) noexcept {
+        return elements_view<const T>(
+            static_cast<const T*>(static_cast<const void*>(buf.data)),
+            details::bytes_to_elements<T>(buf.size));
+    }
+
+    //! Actual reader in C interface.
+    details::smart_ptr<c_shm_stream_blocking_stream_reader_t> reader_{};
+};
+
+/*!
+ * \brief Classes and functions of blocking streams of elements of a type with
+ * wait operations.
+ */
+namespace typed_blocking_stream {
+
+/*!
+ * \brief Class of writer of blocking streams of elements of a type.
+ *
+ * \tparam T Type of elements.
+ */
+template <typename T>
+using writer = typed_blocking_stream_writer<T>;
+
+/*!
+ * \brief Class of reader of blocking streams of elements of a type.
+ *
+ * \tparam T Type of elements.
+ */
+template <typename T>
+using reader = typed_blocking_stream_reader<T>;
+
+/*!
+ * \brief Create a stream.
+ *
+ * \tparam T Type of elements.
+ * \param[in] name Name of the stream.
+ * \param[in] capacity Number of elements in the buffer.
+ */
+template <typename T>
+inline void create(string_view name, shm_stream_size_t capacity) {
+    details::throw_if_error(c_shm_stream_blocking_stream_create_typed(
+        c_shm_stream_string_view_t{name.data(), name.size()},
+        details::typed_stream_buffer_size<T>(capacity),
+        details::element_type_fingerprint<T>(),
+        static_cast<shm_stream_size_t>(sizeof(T))));
+}
+
+/*!
+ * \brief Remove a stream.
+ *
+ * \param[in] name Name of the stream.
+ */
+inline void remove(string_view name) {
+    c_shm_stream_blocking_stream_remove(
+        c_shm_stream_string_view_t{name.data(), name.size()});
+}
+
+}  // namespace typed_blocking_stream
+
+}  // namespace shm_stream
@@ -0,0 +1,113 @@
+/*
+ * Copyright 2023 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Definition of wait_policy class.
+ */
+#pragma once
+
+#include <cstdint>
+
+#include "shm_stream/c_interface/wait_policy.h"
+
+namespace shm_stream {
+
+/*!
+ * \brief Class of policies to wait for blocking streams.
+ *
+ * Waiting operations first spin with CPU pause instructions, then yield the
+ * thread, and finally sleep until notified. The number of iterations of
+ * spinning is adapted to recently observed waiting time, measured in
+ * iterations of spinning rather than clock time, in the range from
+ * min_spin_count to max_spin_count.
+ */
+class wait_policy {
+public:
+    /*!
+     * \brief Constructor.
+     *
+     * \note Waiting operations with this policy sleep immediately.
+     */
+    constexpr wait_policy() noexcept : wait_policy(0U, 0U, 0U) {}
+
+    /*!
+     * \brief Constructor.
+     *
+     * \param[in] min_spin_count Minimum number of iterations of spinning.
+     * \param[in] max_spin_count Maximum number of iterations of spinning.
+     * \param[in] yield_count Number of iterations of yielding the thread after
+     * spinning.
+     *
+     * \note When min_spin_count is equal to max_spin_count, the number of
+     * iterations of spinning is fixed.
+     */
+    constexpr wait_policy(std::uint32_t min_spin_count,
+        std::uint32_t max_spin_count, std::uint32_t yield_count) noexcept
+        : policy_{min_spin_count, max_spin_count, yield_count} {}
+
+    /*!
+     * \brief Constructor.
+     *
+     * \param[in] policy Policy in C interface.
+     */
+    explicit constexpr wait_policy(
+        const c_shm_stream_wait_policy_t& policy) noexcept
+        : policy_(policy) {}
+
+    /*!
+     * \brief Get the minimum number of iterations of spinning.
+     *
+     * \return Number of iterations.
+     */
+    [[nodiscard]] constexpr std::uint32_t min_spin_count() const noexcept {
+        return policy_.min_spin_count;
+    }
+
+    /*!
+     * \brief Get the maximum number of iterations of spinning.
+     *
+     * \return Number of iterations.
+     */
+    [[nodiscard]] constexpr std::uint32_t max_spin_count() const noexcept {
+        return policy_.max_spin_count;
+    }
+
+    /*!
+     * \brief Get the number of iterations of yielding the thread after
+     * spinning.
+     *
+     * \return Number of iterations.
+     */
+    [[nodiscard]] constexpr std::uint32_t yield_count() const noexcept {
+        return policy_.yield_count;
+    }
+
+    /*!
+     * \brief Get the policy in C interface.
+     *
+     * \return Policy.
+     */
+    [[nodiscard]] constexpr const c_shm_stream_wait_policy_t& c_policy()
+        const noexcept {
+        return policy_;
+    }
+
+private:
+    //! Policy in C interface.
+    c_shm_stream_wait_policy_t policy_;
+};
+
+}  // namespace shm_stream
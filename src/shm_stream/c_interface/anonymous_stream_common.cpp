@@ -0,0 +1,46 @@
+/*
+ * Copyright 2023 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Implementation of C interface of anonymous streams of bytes.
+ */
+#include "shm_stream/c_interface/anonymous_stream_common.h"
+
+#include "anonymous_stream_internal.h"
+#include "fd_transfer_internal.h"
+#include "shm_stream/c_interface/common_types.h"
+#include "shm_stream/c_interface/error_codes.h"
+#include "shm_stream/c_interface/translate_error.h"
+
+c_shm_stream_error_code_t c_shm_stream_anonymous_stream_create(
+    int* fd, c_shm_stream_size_t buffer_size) {
+    C_SHM_STREAM_TRANSLATE_ERROR(
+        *fd = shm_stream::details::create_anonymous_stream(buffer_size));
+}
+
+void c_shm_stream_anonymous_stream_close(int fd) {
+    shm_stream::details::close_anonymous_stream(fd);
+}
+
+c_shm_stream_error_code_t c_shm_stream_anonymous_stream_send(
+    int socket, int fd) {
+    C_SHM_STREAM_TRANSLATE_ERROR(shm_stream::details::send_fd(socket, fd));
+}
+
+c_shm_stream_error_code_t c_shm_stream_anonymous_stream_receive(
+    int socket, int* fd) {
+    C_SHM_STREAM_TRANSLATE_ERROR(*fd = shm_stream::details::receive_fd(socket));
+}
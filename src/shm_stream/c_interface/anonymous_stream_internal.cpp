@@ -0,0 +1,106 @@
+/*
+ * Copyright 2023 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Implementation of internal functions of anonymous streams of bytes.
+ */
+#include "anonymous_stream_internal.h"
+
+#include "shm_stream/c_interface/error_codes.h"
+#include "shm_stream/shm_stream_exception.h"
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/types.h>
+#include <unistd.h>
+#endif
+
+namespace shm_stream {
+namespace details {
+
+#ifdef __linux__
+
+int create_anonymous_stream(shm_stream_size_t buffer_size) {
+    if (buffer_size == 0U) {
+        throw shm_stream_error(c_shm_stream_error_code_invalid_argument);
+    }
+
+    const int fd = ::memfd_create(
+        "shm_stream_anonymous_stream", MFD_CLOEXEC | MFD_ALLOW_SEALING);
+    if (fd < 0) {
+        throw shm_stream_error(c_shm_stream_error_code_failed_to_open);
+    }
+
+    try {
+        if (::ftruncate(fd,
+                static_cast<off_t>(mapped_stream_size(buffer_size))) != 0) {
+            throw shm_stream_error(c_shm_stream_error_code_failed_to_open);
+        }
+        anonymous_stream_data data{};
+        try {
+            init_stream_data_from_mapping(data, fd_mapping(fd), buffer_size);
+        } catch (const boost::interprocess::interprocess_exception&) {
+            throw shm_stream_error(c_shm_stream_error_code_failed_to_open);
+        }
+        // Sizes are sealed so that other processes cannot truncate the memory
+        // under mappings of the stream.
+        if (::fcntl(fd, F_ADD_SEALS,  // NOLINT
+                F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_SEAL) != 0) {
+            throw shm_stream_error(c_shm_stream_error_code_failed_to_open);
+        }
+    } catch (...) {
+        ::close(fd);
+        throw;
+    }
+    return fd;
+}
+
+anonymous_stream_data open_anonymous_stream_data(int fd) {
+    if (fd < 0) {
+        throw shm_stream_error(c_shm_stream_error_code_invalid_argument);
+    }
+    anonymous_stream_data data{};
+    try {
+        extract_stream_data_from_mapping(data, fd_mapping(fd));
+    } catch (const boost::interprocess::interprocess_exception&) {
+        throw shm_stream_error(c_shm_stream_error_code_failed_to_open);
+    }
+    return data;
+}
+
+void close_anonymous_stream(int fd) noexcept {
+    if (fd >= 0) {
+        ::close(fd);
+    }
+}
+
+#else
+
+int create_anonymous_stream(shm_stream_size_t /*buffer_size*/) {
+    throw shm_stream_error(c_shm_stream_error_code_not_supported);
+}
+
+anonymous_stream_data open_anonymous_stream_data(int /*fd*/) {
+    throw shm_stream_error(c_shm_stream_error_code_not_supported);
+}
+
+void close_anonymous_stream(int /*fd*/) noexcept {}
+
+#endif
+
+}  // namespace details
+}  // namespace shm_stream
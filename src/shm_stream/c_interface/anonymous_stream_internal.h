@@ -0,0 +1,60 @@
+/*
+ * Copyright 2023 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Definition of internal functions of anonymous streams of bytes.
+ */
+#pragma once
+
+#include "atomic_stream_internal.h"
+#include "shm_stream/common_types.h"
+
+namespace shm_stream {
+namespace details {
+
+/*!
+ * \brief Data of anonymous streams.
+ *
+ * \note shared_memory member is not used, because the mapping of the memory
+ * is kept after the file descriptor is closed.
+ */
+using anonymous_stream_data = atomic_stream_data;
+
+/*!
+ * \brief Create an anonymous stream.
+ *
+ * \param[in] buffer_size Size of the buffer.
+ * \return File descriptor of the memory of the stream.
+ */
+[[nodiscard]] int create_anonymous_stream(shm_stream_size_t buffer_size);
+
+/*!
+ * \brief Open data of an anonymous stream.
+ *
+ * \param[in] fd File descriptor of the memory of the stream.
+ * \return Data.
+ */
+[[nodiscard]] anonymous_stream_data open_anonymous_stream_data(int fd);
+
+/*!
+ * \brief Close a file descriptor of an anonymous stream.
+ *
+ * \param[in] fd File descriptor.
+ */
+void close_anonymous_stream(int fd) noexcept;
+
+}  // namespace details
+}  // namespace shm_stream
@@ -20,65 +20,904 @@
  */
 #include "atomic_stream_internal.h"
 
+#include <array>
+#include <cerrno>
+#include <climits>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
 #include <mutex>
+#include <sstream>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
 
 #include <boost/interprocess/creation_tags.hpp>
 #include <boost/interprocess/sync/named_mutex.hpp>
 
+#include "shm_stream/c_interface/error_codes.h"
 #include "shm_stream/common_types.h"
+#include "shm_stream/shm_stream_exception.h"
+
+#ifndef _WIN32
+#include <sys/mman.h>
+#include <sys/types.h>
+#endif
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <linux/mempolicy.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <sys/vfs.h>
+#include <unistd.h>
+#endif
 
 namespace shm_stream {
 namespace details {
 
 /*!
  * \brief Header of the data shared in streams based on atomic variables.
+ *
+ * \tparam SizeType Type of sizes and indices.
  */
+template <typename SizeType>
 struct atomic_stream_header {
     //! Atomic variables of indices.
-    alignas(cache_line_size()) details::atomic_index_pair<> indices{};
+    alignas(cache_line_size()) details::atomic_index_pair<
+        boost::atomics::ipc_atomic<SizeType>> indices{};
 
     //! Size of the buffer.
-    alignas(cache_line_size()) shm_stream_size_t buffer_size{};
+    alignas(cache_line_size()) SizeType buffer_size{};
+
+    //! Layout of the buffer.
+    std::uint32_t layout{};
+
+    //! Fingerprint of the type of elements. (Zero for streams of bytes.)
+    shm_stream_size64_t element_type{};
+
+    //! Size of each element. (Zero for streams of bytes.)
+    shm_stream_size_t element_size{};
+
+    //! Whether the reader waits for a notification via a doorbell.
+    boost::atomics::ipc_atomic<std::uint32_t> doorbell_armed{0U};
+
+    /*!
+     * \brief Whether the stream is in a file of hugetlbfs instead of the shared
+     * memory. (Only for buffer_layout::huge_pages layout.)
+     */
+    std::uint32_t in_hugetlbfs{0U};
 };
 
-static_assert(sizeof(atomic_stream_header) == 3U * cache_line_size(),
+static_assert(sizeof(atomic_stream_header<shm_stream_size_t>) ==
+        3U * cache_line_size(),
+    "Unexpected size of atomic_stream_header.");
+static_assert(sizeof(atomic_stream_header<shm_stream_size64_t>) ==
+        3U * cache_line_size(),
     "Unexpected size of atomic_stream_header.");
 
-void init_stream_data_from_shared_memory(
-    atomic_stream_data& data, shm_stream_size_t buffer_size) {
-    const boost::interprocess::offset_t data_size =
-        static_cast<boost::interprocess::offset_t>(
-            sizeof(atomic_stream_header)) +
-        static_cast<boost::interprocess::offset_t>(buffer_size);
-    data.shared_memory.truncate(data_size);
+namespace {
 
-    data.mapped_region = boost::interprocess::mapped_region(
-        data.shared_memory, boost::interprocess::read_write);
+/*!
+ * \brief Get the size of the header in shared memory.
+ *
+ * \tparam SizeType Type of sizes and indices.
+ * \param[in] layout Layout of the buffer.
+ * \return Size of the header.
+ *
+ * \note When the buffer is mirrored, the header is padded to a page so that
+ * the buffer can be mapped separately.
+ */
+template <typename SizeType>
+[[nodiscard]] std::size_t header_size(buffer_layout layout) {
+    if (layout == buffer_layout::mirrored) {
+        return boost::interprocess::mapped_region::get_page_size();
+    }
+    return sizeof(atomic_stream_header<SizeType>);
+}
 
-    auto* header =
-        new (data.mapped_region.get_address()) atomic_stream_header();
+/*!
+ * \brief Set pointers in data of streams from the header.
+ *
+ * \tparam SizeType Type of sizes and indices.
+ * \param[in,out] data Data.
+ * \param[in] header Header.
+ */
+template <typename SizeType>
+void set_stream_data_from_header(basic_atomic_stream_data<SizeType>& data,
+    atomic_stream_header<SizeType>* header) {
+    const auto layout = static_cast<buffer_layout>(header->layout);
+    data.atomic_indices = &header->indices;
+    data.buffer = basic_mutable_bytes_view<SizeType>(
+        static_cast<char*>(static_cast<void*>(header)) +
+            header_size<SizeType>(layout),
+        header->buffer_size);
+    data.is_mirrored = layout == buffer_layout::mirrored;
+    data.element_type.fingerprint = header->element_type;
+    data.element_type.size =
+        (header->element_size == 0U) ? 1U : header->element_size;
+    data.doorbell_armed = &header->doorbell_armed;
+}
+
+/*!
+ * \brief Initialize the header of a stream.
+ *
+ * \tparam SizeType Type of sizes and indices.
+ * \param[in,out] data Data.
+ * \param[in] address Address of the header.
+ * \param[in] buffer_size Size of the buffer.
+ * \param[in] layout Layout of the buffer.
+ * \param[in] element_type Type of elements.
+ */
+template <typename SizeType>
+void initialize_header(basic_atomic_stream_data<SizeType>& data,
+    void* address, SizeType buffer_size, buffer_layout layout,
+    const stream_element_type& element_type) {
+    auto* header = new (address) atomic_stream_header<SizeType>();
     header->indices.writer() = 0U;
     header->indices.reader() = 0U;
+    header->indices.writer_waiters() = 0U;
+    header->indices.reader_waiters() = 0U;
     header->buffer_size = buffer_size;
+    header->layout = static_cast<std::uint32_t>(layout);
+    header->element_type = element_type.fingerprint;
+    header->element_size = element_type.size;
+    header->doorbell_armed = 0U;
+    set_stream_data_from_header(data, header);
+}
 
-    data.atomic_indices = &header->indices;
-    data.buffer =
-        mutable_bytes_view(static_cast<char*>(static_cast<void*>(header + 1)),
-            header->buffer_size);
+/*!
+ * \brief Get the size of shared memory of streams.
+ *
+ * \tparam SizeType Type of sizes and indices.
+ * \param[in] buffer_size Size of the buffer.
+ * \param[in] layout Layout of the buffer.
+ * \return Size of shared memory.
+ */
+template <typename SizeType>
+[[nodiscard]] boost::interprocess::offset_t shared_memory_size(
+    SizeType buffer_size, buffer_layout layout) {
+    std::size_t size = header_size<SizeType>(layout) + buffer_size;
+    if (layout == buffer_layout::huge_pages) {
+        size = (size + huge_page_size() - 1U) / huge_page_size() *
+            huge_page_size();
+    }
+    return static_cast<boost::interprocess::offset_t>(size);
+}
+
+/*!
+ * \brief Map shared memory to an address aligned to huge pages.
+ *
+ * This function is used when hugetlbfs cannot be used, and advises the
+ * operating system to use transparent huge pages, which may be ignored
+ * depending on the configuration of the operating system.
+ *
+ * \param[in] shared_memory Shared memory object.
+ * \param[in] size Size of the shared memory. (Must be a multiple of the size
+ * of huge pages.)
+ * \return Mapped region.
+ */
+[[nodiscard]] boost::interprocess::mapped_region
+map_transparent_huge_page_region(
+    const boost::interprocess::shared_memory_object& shared_memory,
+    std::size_t size) {
+#ifdef _WIN32
+    (void)shared_memory;
+    (void)size;
+    throw shm_stream_error(c_shm_stream_error_code_not_supported);
+#else
+    // Reserve a range of addresses larger by a huge page first, then replace
+    // its aligned part with the mapping of the shared memory.
+    const std::size_t reserved_size = size + huge_page_size();
+    void* reserved = ::mmap(nullptr, reserved_size, PROT_NONE,
+        MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);  // NOLINT
+    if (reserved == MAP_FAILED) {             // NOLINT
+        throw shm_stream_error(c_shm_stream_error_code_internal_error);
+    }
+    char* reserved_begin = static_cast<char*>(reserved);
+    char* reserved_end = reserved_begin + reserved_size;
+    const std::size_t misalignment =
+        reinterpret_cast<std::uintptr_t>(reserved) % huge_page_size();
+    char* aligned = reserved_begin +
+        ((misalignment == 0U) ? 0U : huge_page_size() - misalignment);
+
+    boost::interprocess::mapped_region region;
+    try {
+        region = boost::interprocess::mapped_region(shared_memory,
+            boost::interprocess::read_write, 0, size, aligned, MAP_FIXED);
+    } catch (...) {
+        ::munmap(reserved, reserved_size);
+        throw;
+    }
+    if (aligned != reserved_begin) {
+        ::munmap(reserved_begin,
+            static_cast<std::size_t>(aligned - reserved_begin));
+    }
+    if (aligned + size != reserved_end) {
+        ::munmap(aligned + size,
+            static_cast<std::size_t>(reserved_end - (aligned + size)));
+    }
+
+#ifdef MADV_HUGEPAGE
+    // This is only a hint, so errors (for example, when transparent huge pages
+    // are disabled) are ignored.
+    ::madvise(aligned, size, MADV_HUGEPAGE);
+#endif
+
+    return region;
+#endif
 }
 
-void extract_stream_data_from_shared_memory(atomic_stream_data& data) {
+#ifdef __linux__
+/*!
+ * \brief Find a directory in which hugetlbfs with pages of the size used in
+ * buffer_layout::huge_pages layout is mounted.
+ *
+ * \return Path of the directory. (Empty if not found.)
+ */
+[[nodiscard]] std::string find_hugetlbfs_directory() {
+    // /proc/mounts has a line of "device directory type options ..." for each
+    // mounted file system.
+    std::ifstream mounts("/proc/mounts");
+    std::string line;
+    while (std::getline(mounts, line)) {
+        std::istringstream stream(line);
+        std::string device;
+        std::string directory;
+        std::string type;
+        stream >> device >> directory >> type;
+        if (type != "hugetlbfs") {
+            continue;
+        }
+        struct statfs status {};
+        if (::statfs(directory.c_str(), &status) == 0 &&
+            static_cast<std::size_t>(status.f_bsize) == huge_page_size()) {
+            return directory;
+        }
+    }
+    return std::string();
+}
+#endif
+
+/*!
+ * \brief Get the path of the file of a stream in hugetlbfs.
+ *
+ * \param[in] shm_name Name of the shared memory of the stream.
+ * \return Path of the file. (Empty if hugetlbfs is not available.)
+ */
+[[nodiscard]] std::string hugetlbfs_file_path(const char* shm_name) {
+#ifdef __linux__
+    const std::string directory = find_hugetlbfs_directory();
+    if (directory.empty()) {
+        return std::string();
+    }
+    while (*shm_name == '/') {
+        ++shm_name;
+    }
+    return directory + '/' + shm_name;
+#else
+    (void)shm_name;
+    return std::string();
+#endif
+}
+
+/*!
+ * \brief Map a file of a stream in hugetlbfs.
+ *
+ * \param[in] shm_name Name of the shared memory of the stream.
+ * \param[in] size Size of the file. (Must be a multiple of the size of huge
+ * pages.)
+ * \param[in] create Whether to create the file.
+ * \return Mapped region. (Empty if hugetlbfs cannot be used.)
+ *
+ * \note Huge pages in hugetlbfs are reserved when mapped, so this function
+ * returns an empty region when the operating system has no free huge pages.
+ */
+[[nodiscard]] boost::interprocess::mapped_region map_hugetlbfs_region(
+    const char* shm_name, std::size_t size, bool create) {
+#ifdef __linux__
+    const std::string path = hugetlbfs_file_path(shm_name);
+    if (path.empty()) {
+        return boost::interprocess::mapped_region();
+    }
+    if (create) {
+        // The shared memory has just been created, so a file with the same
+        // name is one left by a crashed process.
+        ::unlink(path.c_str());
+    }
+    const int flags = create ? (O_RDWR | O_CREAT | O_EXCL | O_CLOEXEC)
+                             : (O_RDWR | O_CLOEXEC);
+    constexpr ::mode_t permissions = 0644;
+    const int fd = ::open(path.c_str(), flags, permissions);  // NOLINT
+    if (fd < 0) {
+        return boost::interprocess::mapped_region();
+    }
+    boost::interprocess::mapped_region region;
+    try {
+        if (create && ::ftruncate(fd, static_cast<off_t>(size)) != 0) {
+            throw shm_stream_error(c_shm_stream_error_code_failed_to_open);
+        }
+        region = boost::interprocess::mapped_region(
+            fd_mapping(fd), boost::interprocess::read_write, 0, size);
+    } catch (...) {
+        if (create) {
+            ::unlink(path.c_str());
+        }
+    }
+    // The mapped region keeps the file mapped after the file is closed.
+    ::close(fd);
+    return region;
+#else
+    (void)shm_name;
+    (void)size;
+    (void)create;
+    return boost::interprocess::mapped_region();
+#endif
+}
+
+/*!
+ * \brief Remove the file of a stream in hugetlbfs if exists.
+ *
+ * \param[in] shm_name Name of the shared memory of the stream.
+ */
+void remove_hugetlbfs_file(const char* shm_name) {
+    const std::string path = hugetlbfs_file_path(shm_name);
+    if (!path.empty()) {
+        boost::interprocess::ipcdetail::delete_file(path.c_str());
+    }
+}
+
+/*!
+ * \brief Write the header of a stream in hugetlbfs to the shared memory.
+ *
+ * \tparam SizeType Type of sizes and indices.
+ * \param[in] shared_memory Shared memory object.
+ * \param[in] buffer_size Size of the buffer.
+ *
+ * \note The shared memory keeps only the header, which tells other processes
+ * that the stream is in hugetlbfs.
+ */
+template <typename SizeType>
+void write_hugetlbfs_stub_header(
+    boost::interprocess::shared_memory_object& shared_memory,
+    SizeType buffer_size) {
+    shared_memory.truncate(static_cast<boost::interprocess::offset_t>(
+        sizeof(atomic_stream_header<SizeType>)));
+    const boost::interprocess::mapped_region region(
+        shared_memory, boost::interprocess::read_write);
+    auto* header = new (region.get_address()) atomic_stream_header<SizeType>();
+    header->buffer_size = buffer_size;
+    header->layout = static_cast<std::uint32_t>(buffer_layout::huge_pages);
+    header->in_hugetlbfs = 1U;
+}
+
+/*!
+ * \brief Get the range of addresses of the mapped region of a stream.
+ *
+ * \param[in] mapped_region Mapped region.
+ * \param[in] mirrored_region Mapped region with the buffer mirrored.
+ * \return Address and size of the region.
+ */
+[[nodiscard]] std::pair<void*, std::size_t> mapped_range(
+    const boost::interprocess::mapped_region& mapped_region,
+    const mirrored_region& mirrored_region) {
+    if (mapped_region.get_address() != nullptr) {
+        return {mapped_region.get_address(), mapped_region.get_size()};
+    }
+    return {mirrored_region.get_address(), mirrored_region.get_size()};
+}
+
+#ifdef __linux__
+/*!
+ * \brief Get the maximum number of NUMA nodes supported in this library.
+ *
+ * \return Number of NUMA nodes.
+ */
+[[nodiscard]] constexpr std::size_t max_numa_nodes() noexcept {
+    constexpr std::size_t num_nodes = 1024U;
+    return num_nodes;
+}
+#endif
+
+/*!
+ * \brief Pre-fault pages of a mapped region.
+ *
+ * \param[in] address Address of the region.
+ * \param[in] size Size of the region.
+ */
+void prefault_region(void* address, std::size_t size) {
+#ifdef MADV_POPULATE_WRITE
+    if (::madvise(address, size, MADV_POPULATE_WRITE) == 0) {
+        return;
+    }
+#endif
+    // Other processes may be writing to the region, so pages are touched only
+    // by reading.
+    const std::size_t page_size =
+        boost::interprocess::mapped_region::get_page_size();
+    const volatile char* bytes = static_cast<const volatile char*>(address);
+    for (std::size_t offset = 0U; offset < size; offset += page_size) {
+        (void)bytes[offset];
+    }
+}
+
+/*!
+ * \brief Lock pages of a mapped region in physical memory.
+ *
+ * \param[in] address Address of the region.
+ * \param[in] size Size of the region.
+ */
+void lock_region(void* address, std::size_t size) {
+#ifdef _WIN32
+    (void)address;
+    (void)size;
+    throw shm_stream_error(c_shm_stream_error_code_not_supported);
+#else
+    // Pages are unlocked automatically when unmapped.
+    if (::mlock(address, size) != 0) {
+        throw shm_stream_error(c_shm_stream_error_code_failed_to_lock_memory);
+    }
+#endif
+}
+
+/*!
+ * \brief Apply options of memory to the mapped region of a stream.
+ *
+ * \param[in] mapped_region Mapped region.
+ * \param[in] mirrored_region Mapped region with the buffer mirrored.
+ * \param[in] options Options of memory.
+ */
+void apply_memory_options(
+    const boost::interprocess::mapped_region& mapped_region,
+    const mirrored_region& mirrored_region, memory_options options) {
+    void* address = nullptr;
+    std::size_t size = 0U;
+    std::tie(address, size) = mapped_range(mapped_region, mirrored_region);
+    if (has_memory_option(options, memory_options::lock)) {
+        // Locking pages also faults them in.
+        lock_region(address, size);
+    } else if (has_memory_option(options, memory_options::prefault)) {
+        prefault_region(address, size);
+    }
+}
+
+/*!
+ * \brief Map shared memory of a stream and initialize it.
+ *
+ * \tparam SizeType Type of sizes and indices.
+ * \param[in,out] data Data.
+ * \param[in] buffer_size Size of the buffer.
+ * \param[in] layout Layout of the buffer.
+ * \param[in] element_type Type of elements.
+ * \param[in] options Options of memory.
+ * \param[in] numa_node NUMA node to bind pages to.
+ *
+ * \note Pages are bound and options of memory are applied before the header
+ * is initialized, so that the header is written to pages already placed and
+ * locked as requested.
+ */
+template <typename SizeType>
+void initialize_stream_memory(basic_atomic_stream_data<SizeType>& data,
+    SizeType buffer_size, buffer_layout layout,
+    const stream_element_type& element_type, memory_options options,
+    numa_node_t numa_node) {
+    const boost::interprocess::offset_t data_size =
+        shared_memory_size(buffer_size, layout);
+
+    void* address = nullptr;
+    bool in_hugetlbfs = false;
+    if (layout == buffer_layout::huge_pages) {
+        // hugetlbfs is preferred, because transparent huge pages are often
+        // disabled for shared memory.
+        data.mapped_region =
+            map_hugetlbfs_region(data.shared_memory.get_name(),
+                static_cast<std::size_t>(data_size), true);
+        in_hugetlbfs = data.mapped_region.get_address() != nullptr;
+    }
+    if (!in_hugetlbfs) {
+        data.shared_memory.truncate(data_size);
+    }
+
+    if (layout == buffer_layout::mirrored) {
+        data.mirrored_region = mirrored_region(
+            data.shared_memory, header_size<SizeType>(layout), buffer_size);
+        address = data.mirrored_region.get_address();
+    } else if (in_hugetlbfs) {
+        address = data.mapped_region.get_address();
+    } else if (layout == buffer_layout::huge_pages) {
+        data.mapped_region = map_transparent_huge_page_region(
+            data.shared_memory, static_cast<std::size_t>(data_size));
+        address = data.mapped_region.get_address();
+    } else {
+        data.mapped_region = boost::interprocess::mapped_region(
+            data.shared_memory, boost::interprocess::read_write);
+        address = data.mapped_region.get_address();
+    }
+
+    bind_to_numa_node(data.mapped_region, data.mirrored_region, numa_node);
+    apply_memory_options(data.mapped_region, data.mirrored_region, options);
+
+    initialize_header(data, address, buffer_size, layout, element_type);
+    if (in_hugetlbfs) {
+        static_cast<atomic_stream_header<SizeType>*>(address)->in_hugetlbfs =
+            1U;
+        write_hugetlbfs_stub_header(data.shared_memory, buffer_size);
+    }
+}
+
+}  // namespace
+
+mirrored_region::mirrored_region(
+    const boost::interprocess::shared_memory_object& shared_memory,
+    std::size_t header_size, std::size_t buffer_size) {
+#ifdef _WIN32
+    (void)shared_memory;
+    (void)header_size;
+    (void)buffer_size;
+    throw shm_stream_error(c_shm_stream_error_code_not_supported);
+#else
+    const std::size_t size = header_size + 2U * buffer_size;
+
+    // Reserve the whole range of addresses first, then replace it with the
+    // mappings of the shared memory.
+    void* address = ::mmap(nullptr, size, PROT_NONE,
+        MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);  // NOLINT
+    if (address == MAP_FAILED) {              // NOLINT
+        throw shm_stream_error(c_shm_stream_error_code_internal_error);
+    }
+
+    const int file = shared_memory.get_mapping_handle().handle;
+    void* first = ::mmap(address, header_size + buffer_size,
+        PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, file, 0);  // NOLINT
+    void* second = MAP_FAILED;                                     // NOLINT
+    if (first != MAP_FAILED) {                                     // NOLINT
+        second = ::mmap(static_cast<char*>(address) + header_size + buffer_size,
+            buffer_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, file,
+            static_cast<off_t>(header_size));  // NOLINT
+    }
+    if (second == MAP_FAILED) {  // NOLINT
+        ::munmap(address, size);
+        throw shm_stream_error(c_shm_stream_error_code_internal_error);
+    }
+
+    address_ = address;
+    size_ = size;
+#endif
+}
+
+mirrored_region::mirrored_region(mirrored_region&& obj) noexcept
+    : address_(std::exchange(obj.address_, nullptr)),
+      size_(std::exchange(obj.size_, 0U)) {}
+
+mirrored_region& mirrored_region::operator=(mirrored_region&& obj) noexcept {
+    if (this != &obj) {
+        unmap();
+        address_ = std::exchange(obj.address_, nullptr);
+        size_ = std::exchange(obj.size_, 0U);
+    }
+    return *this;
+}
+
+mirrored_region::~mirrored_region() noexcept { unmap(); }
+
+void mirrored_region::unmap() noexcept {
+#ifndef _WIN32
+    if (address_ != nullptr) {
+        ::munmap(address_, size_);
+    }
+#endif
+    address_ = nullptr;
+    size_ = 0U;
+}
+
+std::size_t effective_page_size(
+    const boost::interprocess::mapped_region& mapped_region,
+    const mirrored_region& mirrored_region) {
+    const std::size_t normal_page_size =
+        boost::interprocess::mapped_region::get_page_size();
+#ifdef __linux__
+    const void* address = (mapped_region.get_address() != nullptr)
+        ? mapped_region.get_address()
+        : mirrored_region.get_address();
+    if (address == nullptr) {
+        return normal_page_size;
+    }
+    const auto target = reinterpret_cast<std::uintptr_t>(address);
+
+    // /proc/self/smaps has a line of the range of addresses for each mapping,
+    // followed by lines of fields in the format "Name: value kB".
+    std::ifstream smaps("/proc/self/smaps");
+    std::string line;
+    bool in_target = false;
+    std::size_t kernel_page_size = 0U;
+    std::size_t pmd_mapped_size = 0U;
+    while (std::getline(smaps, line)) {
+        const auto colon = line.find(':');
+        const auto space = line.find(' ');
+        if (colon == std::string::npos || space < colon) {
+            if (in_target) {
+                break;
+            }
+            char* end = nullptr;
+            const auto begin_address = std::strtoull(line.c_str(), &end, 16);
+            const auto end_address = std::strtoull(end + 1, nullptr, 16);
+            in_target = begin_address <= target && target < end_address;
+            continue;
+        }
+        if (!in_target) {
+            continue;
+        }
+        const auto name = line.substr(0U, colon);
+        const auto value = static_cast<std::size_t>(
+            std::strtoull(line.c_str() + colon + 1U, nullptr, 10));
+        if (name == "KernelPageSize") {
+            kernel_page_size = value * 1024U;
+        } else if (name == "ShmemPmdMapped" || name == "FilePmdMapped") {
+            pmd_mapped_size += value * 1024U;
+        }
+    }
+
+    if (kernel_page_size > normal_page_size) {
+        return kernel_page_size;
+    }
+    if (pmd_mapped_size > 0U) {
+        return huge_page_size();
+    }
+#else
+    (void)mapped_region;
+    (void)mirrored_region;
+#endif
+    return normal_page_size;
+}
+
+void bind_to_numa_node(const boost::interprocess::mapped_region& mapped_region,
+    const mirrored_region& mirrored_region, numa_node_t node) {
+    if (node == numa_node_none) {
+        return;
+    }
+#ifdef __linux__
+    if (node == numa_node_current) {
+        unsigned int cpu = 0U;
+        unsigned int current_node = 0U;
+        if (::syscall(SYS_getcpu, &cpu, &current_node, nullptr) != 0) {
+            throw shm_stream_error(c_shm_stream_error_code_not_supported);
+        }
+        node = static_cast<numa_node_t>(current_node);
+    }
+    if (node < 0 || static_cast<std::size_t>(node) >= max_numa_nodes()) {
+        throw shm_stream_error(c_shm_stream_error_code_invalid_argument);
+    }
+
+    using mask_element_type = unsigned long;  // NOLINT: type used in mbind.
+    constexpr std::size_t mask_element_bits = sizeof(mask_element_type) *
+        CHAR_BIT;
+    std::array<mask_element_type, max_numa_nodes() / mask_element_bits>
+        mask{};
+    const auto index = static_cast<std::size_t>(node);
+    mask[index / mask_element_bits] |= static_cast<mask_element_type>(1U)
+        << (index % mask_element_bits);
+
+    void* address = nullptr;
+    std::size_t size = 0U;
+    std::tie(address, size) = mapped_range(mapped_region, mirrored_region);
+    // mbind ignores the last bit of the mask, so one is added to the number of
+    // nodes.
+    if (::syscall(SYS_mbind, address, size, MPOL_BIND, mask.data(),
+            max_numa_nodes() + 1U, MPOL_MF_MOVE) != 0) {
+        if (errno == EINVAL) {
+            throw shm_stream_error(c_shm_stream_error_code_invalid_argument);
+        }
+        throw shm_stream_error(c_shm_stream_error_code_not_supported);
+    }
+#else
+    (void)mapped_region;
+    (void)mirrored_region;
+    throw shm_stream_error(c_shm_stream_error_code_not_supported);
+#endif
+}
+
+numa_node_t numa_node_of(
+    const boost::interprocess::mapped_region& mapped_region,
+    const mirrored_region& mirrored_region) {
+#ifdef __linux__
+    void* address = nullptr;
+    std::size_t size = 0U;
+    std::tie(address, size) = mapped_range(mapped_region, mirrored_region);
+    if (address == nullptr) {
+        return numa_node_none;
+    }
+
+    // move_pages without target nodes reports the node of each page.
+    constexpr std::size_t pages_per_call = 256U;
+    const std::size_t page_size =
+        boost::interprocess::mapped_region::get_page_size();
+    std::array<void*, pages_per_call> pages{};
+    std::array<int, pages_per_call> status{};
+    std::vector<std::size_t> num_pages_per_node;
+    for (std::size_t offset = 0U; offset < size;) {
+        std::size_t num_pages = 0U;
+        for (; num_pages < pages_per_call && offset < size;
+             ++num_pages, offset += page_size) {
+            pages[num_pages] = static_cast<char*>(address) + offset;
+        }
+        if (::syscall(SYS_move_pages, 0, num_pages, pages.data(), nullptr,
+                status.data(), 0) != 0) {
+            return numa_node_none;
+        }
+        for (std::size_t i = 0U; i < num_pages; ++i) {
+            // Negative values are errors, e.g., for pages not allocated yet.
+            if (status[i] < 0) {
+                continue;
+            }
+            const auto node = static_cast<std::size_t>(status[i]);
+            if (node >= num_pages_per_node.size()) {
+                num_pages_per_node.resize(node + 1U, 0U);
+            }
+            ++num_pages_per_node[node];
+        }
+    }
+
+    numa_node_t result = numa_node_none;
+    std::size_t max_num_pages = 0U;
+    for (std::size_t node = 0U; node < num_pages_per_node.size(); ++node) {
+        if (num_pages_per_node[node] > max_num_pages) {
+            max_num_pages = num_pages_per_node[node];
+            result = static_cast<numa_node_t>(node);
+        }
+    }
+    return result;
+#else
+    (void)mapped_region;
+    (void)mirrored_region;
+    return numa_node_none;
+#endif
+}
+
+void check_buffer_layout(
+    shm_stream_size64_t buffer_size, buffer_layout layout) {
+    switch (layout) {
+    case buffer_layout::plain:
+        return;
+    case buffer_layout::huge_pages:
+#ifdef _WIN32
+        throw shm_stream_error(c_shm_stream_error_code_not_supported);
+#endif
+        return;
+    case buffer_layout::mirrored:
+#ifdef _WIN32
+        throw shm_stream_error(c_shm_stream_error_code_not_supported);
+#endif
+        if (buffer_size == 0U ||
+            buffer_size % boost::interprocess::mapped_region::get_page_size() !=
+                0U) {
+            throw shm_stream_error(c_shm_stream_error_code_invalid_argument);
+        }
+        return;
+    }
+    throw shm_stream_error(c_shm_stream_error_code_invalid_argument);
+}
+
+template <typename SizeType>
+void init_stream_data_from_shared_memory(
+    basic_atomic_stream_data<SizeType>& data, SizeType buffer_size,
+    buffer_layout layout, const stream_element_type& element_type,
+    memory_options options, numa_node_t numa_node) {
+    try {
+        initialize_stream_memory(
+            data, buffer_size, layout, element_type, options, numa_node);
+    } catch (...) {
+        // The stream is removed so that other processes don't open a stream
+        // without the requested options and placement of pages.
+        const std::string shm_name = data.shared_memory.get_name();
+        data = basic_atomic_stream_data<SizeType>();
+        boost::interprocess::shared_memory_object::remove(shm_name.c_str());
+        remove_hugetlbfs_file(shm_name.c_str());
+        throw;
+    }
+}
+
+template <typename SizeType>
+void extract_stream_data_from_shared_memory(
+    basic_atomic_stream_data<SizeType>& data, memory_options options) {
     data.mapped_region = boost::interprocess::mapped_region(
         data.shared_memory, boost::interprocess::read_write);
+    auto* header = static_cast<atomic_stream_header<SizeType>*>(
+        data.mapped_region.get_address());
 
-    auto* header =
-        static_cast<atomic_stream_header*>(data.mapped_region.get_address());
-    data.atomic_indices = &header->indices;
-    data.buffer =
-        mutable_bytes_view(static_cast<char*>(static_cast<void*>(header + 1)),
-            header->buffer_size);
+    const auto layout = static_cast<buffer_layout>(header->layout);
+    if (layout == buffer_layout::mirrored) {
+        data.mirrored_region = mirrored_region(data.shared_memory,
+            header_size<SizeType>(layout), header->buffer_size);
+        data.mapped_region = boost::interprocess::mapped_region();
+        header = static_cast<atomic_stream_header<SizeType>*>(
+            data.mirrored_region.get_address());
+    } else if (layout == buffer_layout::huge_pages) {
+        const auto data_size = static_cast<std::size_t>(
+            shared_memory_size(header->buffer_size, layout));
+        if (header->in_hugetlbfs != 0U) {
+            data.mapped_region = map_hugetlbfs_region(
+                data.shared_memory.get_name(), data_size, false);
+            if (data.mapped_region.get_address() == nullptr) {
+                throw shm_stream_error(c_shm_stream_error_code_failed_to_open);
+            }
+        } else {
+            data.mapped_region = map_transparent_huge_page_region(
+                data.shared_memory, data_size);
+        }
+        header = static_cast<atomic_stream_header<SizeType>*>(
+            data.mapped_region.get_address());
+    }
+
+    set_stream_data_from_header(data, header);
+
+    apply_memory_options(data.mapped_region, data.mirrored_region, options);
+}
+
+std::size_t mapped_stream_size(shm_stream_size_t buffer_size) noexcept {
+    return header_size<shm_stream_size_t>(buffer_layout::plain) + buffer_size;
+}
+
+template <typename MemoryMappable>
+void init_stream_data_from_mapping(atomic_stream_data& data,
+    const MemoryMappable& mapping, shm_stream_size_t buffer_size) {
+    data.mapped_region = boost::interprocess::mapped_region(
+        mapping, boost::interprocess::read_write, 0,
+        mapped_stream_size(buffer_size));
+    initialize_header(data, data.mapped_region.get_address(), buffer_size,
+        buffer_layout::plain, stream_element_type());
 }
 
+template <typename MemoryMappable>
+void extract_stream_data_from_mapping(
+    atomic_stream_data& data, const MemoryMappable& mapping) {
+    data.mapped_region = boost::interprocess::mapped_region(
+        mapping, boost::interprocess::read_write);
+    if (data.mapped_region.get_size() <
+        sizeof(atomic_stream_header<shm_stream_size_t>)) {
+        throw shm_stream_error(c_shm_stream_error_code_failed_to_open);
+    }
+    auto* header = static_cast<atomic_stream_header<shm_stream_size_t>*>(
+        data.mapped_region.get_address());
+    // Files may be left broken by crashes or given by other processes, so the
+    // header is validated.
+    if (static_cast<buffer_layout>(header->layout) != buffer_layout::plain ||
+        header->buffer_size == 0U ||
+        data.mapped_region.get_size() !=
+            mapped_stream_size(header->buffer_size) ||
+        header->indices.writer().load() >= header->buffer_size ||
+        header->indices.reader().load() >= header->buffer_size) {
+        throw shm_stream_error(c_shm_stream_error_code_failed_to_open);
+    }
+    set_stream_data_from_header(data, header);
+}
+
+template void init_stream_data_from_shared_memory<shm_stream_size_t>(
+    atomic_stream_data& data, shm_stream_size_t buffer_size,
+    buffer_layout layout, const stream_element_type& element_type,
+    memory_options options, numa_node_t numa_node);
+template void init_stream_data_from_shared_memory<shm_stream_size64_t>(
+    atomic_stream64_data& data, shm_stream_size64_t buffer_size,
+    buffer_layout layout, const stream_element_type& element_type,
+    memory_options options, numa_node_t numa_node);
+template void extract_stream_data_from_shared_memory<shm_stream_size_t>(
+    atomic_stream_data& data, memory_options options);
+template void extract_stream_data_from_shared_memory<shm_stream_size64_t>(
+    atomic_stream64_data& data, memory_options options);
+template void init_stream_data_from_mapping<boost::interprocess::file_mapping>(
+    atomic_stream_data& data, const boost::interprocess::file_mapping& mapping,
+    shm_stream_size_t buffer_size);
+template void
+extract_stream_data_from_mapping<boost::interprocess::file_mapping>(
+    atomic_stream_data& data, const boost::interprocess::file_mapping& mapping);
+#ifndef _WIN32
+template void init_stream_data_from_mapping<fd_mapping>(
+    atomic_stream_data& data, const fd_mapping& mapping,
+    shm_stream_size_t buffer_size);
+template void extract_stream_data_from_mapping<fd_mapping>(
+    atomic_stream_data& data, const fd_mapping& mapping);
+#endif
+
 void remove_atomic_stream(
     const std::string& mutex_name, const std::string& shm_name) {
     {
@@ -88,6 +927,7 @@ void remove_atomic_stream(
             std::unique_lock<boost::interprocess::named_mutex> lock(mutex);
 
             boost::interprocess::shared_memory_object::remove(shm_name.c_str());
+            remove_hugetlbfs_file(shm_name.c_str());
         }
     }
     boost::interprocess::named_mutex::remove(mutex_name.c_str());
@@ -19,53 +19,340 @@
  */
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include <string>
 
+#include <boost/atomic/ipc_atomic.hpp>
+#include <boost/interprocess/detail/os_file_functions.hpp>
+#include <boost/interprocess/file_mapping.hpp>
 #include <boost/interprocess/mapped_region.hpp>
 #include <boost/interprocess/shared_memory_object.hpp>
 
 #include "atomic_stream_internal.h"
 #include "shm_stream/bytes_view.h"
+#include "shm_stream/c_interface/error_codes.h"
+#include "shm_stream/common_types.h"
 #include "shm_stream/details/atomic_index_pair.h"
+#include "shm_stream/shm_stream_exception.h"
 
 namespace shm_stream {
 namespace details {
 
+/*!
+ * \brief Class of regions of shared memory mapped with the buffer mirrored.
+ *
+ * This class maps the header and the buffer in shared memory, and then maps
+ * the buffer once more just after the first one, so that the bytes after the
+ * end of the buffer are the bytes at the beginning of the buffer.
+ */
+class mirrored_region {
+public:
+    //! Constructor.
+    mirrored_region() noexcept = default;
+
+    /*!
+     * \brief Constructor.
+     *
+     * \param[in] shared_memory Shared memory object.
+     * \param[in] header_size Size of the header before the buffer. (Must be a
+     * multiple of the page size.)
+     * \param[in] buffer_size Size of the buffer. (Must be a multiple of the
+     * page size.)
+     */
+    mirrored_region(
+        const boost::interprocess::shared_memory_object& shared_memory,
+        std::size_t header_size, std::size_t buffer_size);
+
+    // Prevent copy.
+    mirrored_region(const mirrored_region&) = delete;
+    auto operator=(const mirrored_region&) = delete;
+
+    /*!
+     * \brief Move constructor.
+     *
+     * \param[in] obj Object to move from.
+     */
+    mirrored_region(mirrored_region&& obj) noexcept;
+
+    /*!
+     * \brief Move assignment operator.
+     *
+     * \param[in] obj Object to move from.
+     * \return This.
+     */
+    mirrored_region& operator=(mirrored_region&& obj) noexcept;
+
+    //! Destructor.
+    ~mirrored_region() noexcept;
+
+    /*!
+     * \brief Get the address of the header.
+     *
+     * \return Address.
+     */
+    [[nodiscard]] void* get_address() const noexcept { return address_; }
+
+    /*!
+     * \brief Get the size of the region.
+     *
+     * \return Size.
+     */
+    [[nodiscard]] std::size_t get_size() const noexcept { return size_; }
+
+private:
+    //! Unmap the region.
+    void unmap() noexcept;
+
+    //! Address of the region.
+    void* address_{nullptr};
+
+    //! Size of the region.
+    std::size_t size_{0U};
+};
+
+/*!
+ * \brief Struct of types of elements in streams.
+ */
+struct stream_element_type {
+    //! Fingerprint of the type. (Zero for streams of bytes.)
+    shm_stream_size64_t fingerprint{0U};
+
+    //! Size of each element.
+    shm_stream_size_t size{1U};
+};
+
 /*!
  * \brief Data of streams based on atomic variables.
+ *
+ * \tparam SizeType Type of sizes and indices.
  */
-struct atomic_stream_data {
+template <typename SizeType>
+struct basic_atomic_stream_data {
     //! Shared memory object.
     boost::interprocess::shared_memory_object shared_memory{};
 
     //! Mapped region.
     boost::interprocess::mapped_region mapped_region{};
 
+    //! Mapped region with the buffer mirrored.
+    details::mirrored_region mirrored_region{};
+
     /*!
      * \brief Atomic variables of the indices of the next bytes for the writer
      * and the reader.
      */
-    atomic_index_pair<>* atomic_indices{nullptr};
+    atomic_index_pair<boost::atomics::ipc_atomic<SizeType>>* atomic_indices{
+        nullptr};
 
     //! Buffer of data.
-    mutable_bytes_view buffer{nullptr, 0U};
+    basic_mutable_bytes_view<SizeType> buffer{nullptr, 0U};
+
+    //! Whether the buffer is mirrored.
+    bool is_mirrored{false};
+
+    //! Type of elements.
+    stream_element_type element_type{};
+
+    //! Atomic variable of whether the reader armed the doorbell.
+    boost::atomics::ipc_atomic<std::uint32_t>* doorbell_armed{nullptr};
 };
 
+/*!
+ * \brief Data of streams based on atomic variables.
+ */
+using atomic_stream_data = basic_atomic_stream_data<shm_stream_size_t>;
+
+/*!
+ * \brief Data of streams based on atomic variables with 64-bit indices.
+ */
+using atomic_stream64_data = basic_atomic_stream_data<shm_stream_size64_t>;
+
+/*!
+ * \brief Get the size of huge pages used in buffer_layout::huge_pages layout.
+ *
+ * \return Size of huge pages.
+ */
+[[nodiscard]] constexpr std::size_t huge_page_size() noexcept {
+    constexpr std::size_t size = static_cast<std::size_t>(2U) * 1024U * 1024U;
+    return size;
+}
+
+/*!
+ * \brief Get the size of pages backing a mapped region of streams.
+ *
+ * \param[in] mapped_region Mapped region.
+ * \param[in] mirrored_region Mapped region with the buffer mirrored.
+ * \return Size of pages actually used by the operating system for the region
+ * which is mapped.
+ *
+ * \note In Linux, this function reads `/proc/self/smaps`, so the size may
+ * change after the first access to the pages. In other platforms, this
+ * function returns the size of normal pages.
+ */
+[[nodiscard]] std::size_t effective_page_size(
+    const boost::interprocess::mapped_region& mapped_region,
+    const mirrored_region& mirrored_region);
+
+/*!
+ * \brief Bind pages of a mapped region of streams to a NUMA node.
+ *
+ * \param[in] mapped_region Mapped region.
+ * \param[in] mirrored_region Mapped region with the buffer mirrored.
+ * \param[in] node NUMA node. (numa_node_none for no operation.)
+ *
+ * \note The policy is shared by all processes mapping the shared memory, so
+ * this function is used only for shared memory being created.
+ */
+void bind_to_numa_node(const boost::interprocess::mapped_region& mapped_region,
+    const mirrored_region& mirrored_region, numa_node_t node);
+
+/*!
+ * \brief Get the NUMA node on which pages of a mapped region of streams are.
+ *
+ * \param[in] mapped_region Mapped region.
+ * \param[in] mirrored_region Mapped region with the buffer mirrored.
+ * \return NUMA node having the most pages of the region. (numa_node_none if
+ * unknown.)
+ */
+[[nodiscard]] numa_node_t numa_node_of(
+    const boost::interprocess::mapped_region& mapped_region,
+    const mirrored_region& mirrored_region);
+
+/*!
+ * \brief Check whether a layout can be used for a buffer.
+ *
+ * \param[in] buffer_size Size of the buffer.
+ * \param[in] layout Layout of the buffer.
+ */
+void check_buffer_layout(shm_stream_size64_t buffer_size, buffer_layout layout);
+
 /*!
  * \brief Initialize data of streams from shared memory.
  *
+ * \tparam SizeType Type of sizes and indices.
  * \param[in,out] data Data.
  * \param[in] buffer_size Size of the buffer.
+ * \param[in] layout Layout of the buffer.
+ * \param[in] element_type Type of elements.
+ * \param[in] options Options of memory.
+ * \param[in] numa_node NUMA node to bind pages to. (numa_node_none for the
+ * usual placement of pages.)
+ *
+ * \note If this function fails, the shared memory is removed.
+ * \note This function is instantiated for shm_stream_size_t and
+ * shm_stream_size64_t.
  */
+template <typename SizeType>
 void init_stream_data_from_shared_memory(
-    atomic_stream_data& data, shm_stream_size_t buffer_size);
+    basic_atomic_stream_data<SizeType>& data, SizeType buffer_size,
+    buffer_layout layout = buffer_layout::plain,
+    const stream_element_type& element_type = stream_element_type(),
+    memory_options options = memory_options::none,
+    numa_node_t numa_node = numa_node_none);
 
 /*!
  * \brief Extract data of streams from shared memory.
  *
+ * \tparam SizeType Type of sizes and indices.
  * \param[in,out] data Data.
+ * \param[in] options Options of memory.
+ *
+ * \note This function is instantiated for shm_stream_size_t and
+ * shm_stream_size64_t.
+ */
+template <typename SizeType>
+void extract_stream_data_from_shared_memory(
+    basic_atomic_stream_data<SizeType>& data,
+    memory_options options = memory_options::none);
+
+#ifndef _WIN32
+/*!
+ * \brief Class of file descriptors to map using mapped_region class in
+ * Boost.Interprocess.
+ *
+ * \note This class doesn't own the file descriptor.
+ */
+class fd_mapping {
+public:
+    /*!
+     * \brief Constructor.
+     *
+     * \param[in] fd File descriptor.
+     */
+    explicit fd_mapping(int fd) noexcept : fd_(fd) {}
+
+    /*!
+     * \brief Get the handle to map.
+     *
+     * \return Handle.
+     */
+    [[nodiscard]] boost::interprocess::mapping_handle_t get_mapping_handle()
+        const noexcept {
+        return boost::interprocess::ipcdetail::mapping_handle_from_file_handle(
+            fd_);
+    }
+
+private:
+    //! File descriptor.
+    int fd_;
+};
+#endif
+
+/*!
+ * \brief Get the size of files mapped for streams.
+ *
+ * \param[in] buffer_size Size of the buffer.
+ * \return Size of the file.
+ */
+[[nodiscard]] std::size_t mapped_stream_size(
+    shm_stream_size_t buffer_size) noexcept;
+
+/*!
+ * \brief Initialize data of streams from a file to map.
+ *
+ * \tparam MemoryMappable Type of the file to map. (file_mapping class in
+ * Boost.Interprocess or fd_mapping class.)
+ * \param[in,out] data Data.
+ * \param[in] mapping File to map. (Must have the size returned by
+ * mapped_stream_size function.)
+ * \param[in] buffer_size Size of the buffer.
+ *
+ * \note Shared memory in the data is not used, and the mapped region keeps
+ * the file mapped after the file is closed.
+ */
+template <typename MemoryMappable>
+void init_stream_data_from_mapping(atomic_stream_data& data,
+    const MemoryMappable& mapping, shm_stream_size_t buffer_size);
+
+/*!
+ * \brief Extract data of streams from a file to map.
+ *
+ * \tparam MemoryMappable Type of the file to map. (file_mapping class in
+ * Boost.Interprocess or fd_mapping class.)
+ * \param[in,out] data Data.
+ * \param[in] mapping File to map.
+ */
+template <typename MemoryMappable>
+void extract_stream_data_from_mapping(
+    atomic_stream_data& data, const MemoryMappable& mapping);
+
+/*!
+ * \brief Check the type of elements in a stream.
+ *
+ * \tparam SizeType Type of sizes and indices.
+ * \param[in] data Data.
+ * \param[in] element_type Expected type of elements. (Fingerprint of zero to
+ * accept any type.)
  */
-void extract_stream_data_from_shared_memory(atomic_stream_data& data);
+template <typename SizeType>
+void check_element_type(const basic_atomic_stream_data<SizeType>& data,
+    const stream_element_type& element_type) {
+    if (element_type.fingerprint != 0U &&
+        data.element_type.fingerprint != element_type.fingerprint) {
+        throw shm_stream_error(c_shm_stream_error_code_type_mismatch);
+    }
+}
 
 /*!
  * \brief Remove a stream based on atomic variables.
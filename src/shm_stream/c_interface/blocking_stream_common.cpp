@@ -34,6 +34,37 @@ c_shm_stream_error_code_t c_shm_stream_blocking_stream_create(
             shm_stream::string_view(name.data, name.size), buffer_size));
 }
 
+c_shm_stream_error_code_t c_shm_stream_blocking_stream_create_with_layout(
+    c_shm_stream_string_view_t name, c_shm_stream_size_t buffer_size,
+    c_shm_stream_buffer_layout_t layout) {
+    C_SHM_STREAM_TRANSLATE_ERROR(
+        (void)shm_stream::details::prepare_blocking_stream_data(
+            shm_stream::string_view(name.data, name.size), buffer_size,
+            static_cast<shm_stream::buffer_layout>(layout)));
+}
+
+c_shm_stream_error_code_t c_shm_stream_blocking_stream_create_on_numa_node(
+    c_shm_stream_string_view_t name, c_shm_stream_size_t buffer_size,
+    c_shm_stream_buffer_layout_t layout, c_shm_stream_numa_node_t numa_node) {
+    C_SHM_STREAM_TRANSLATE_ERROR(
+        (void)shm_stream::details::prepare_blocking_stream_data(
+            shm_stream::string_view(name.data, name.size), buffer_size,
+            static_cast<shm_stream::buffer_layout>(layout),
+            shm_stream::details::stream_element_type(),
+            shm_stream::memory_options::none, numa_node));
+}
+
+c_shm_stream_error_code_t c_shm_stream_blocking_stream_create_typed(
+    c_shm_stream_string_view_t name, c_shm_stream_size_t buffer_size,
+    c_shm_stream_size64_t element_type, c_shm_stream_size_t element_size) {
+    C_SHM_STREAM_TRANSLATE_ERROR(
+        (void)shm_stream::details::prepare_blocking_stream_data(
+            shm_stream::string_view(name.data, name.size), buffer_size,
+            shm_stream::buffer_layout::plain,
+            shm_stream::details::stream_element_type{
+                element_type, element_size}));
+}
+
 void c_shm_stream_blocking_stream_remove(c_shm_stream_string_view_t name) {
     C_SHM_STREAM_NO_ERROR(shm_stream::details::remove_blocking_stream(
         shm_stream::string_view(name.data, name.size)));
@@ -41,7 +41,11 @@ std::string blocking_stream_mutex_name(string_view stream_name) {
 }
 
 blocking_stream_data create_and_initialize_blocking_stream_data(
-    string_view name, shm_stream_size_t buffer_size) {
+    string_view name, shm_stream_size_t buffer_size, buffer_layout layout,
+    const stream_element_type& element_type, memory_options options,
+    numa_node_t numa_node) {
+    check_buffer_layout(buffer_size, layout);
+
     blocking_stream_data data{};
     const std::string data_shm_name = blocking_stream_shm_name(name);
 
@@ -53,13 +57,16 @@ blocking_stream_data create_and_initialize_blocking_stream_data(
         throw shm_stream_error(c_shm_stream_error_code_failed_to_open);
     }
 
-    init_stream_data_from_shared_memory(data, buffer_size);
+    init_stream_data_from_shared_memory(
+        data, buffer_size, layout, element_type, options, numa_node);
 
     return data;
 }
 
-blocking_stream_data prepare_blocking_stream_data(
-    string_view name, shm_stream_size_t buffer_size) {
+blocking_stream_data prepare_blocking_stream_data(string_view name,
+    shm_stream_size_t buffer_size, buffer_layout layout,
+    const stream_element_type& element_type, memory_options options,
+    numa_node_t numa_node) {
     blocking_stream_data data{};
 
     const std::string data_shm_name = blocking_stream_shm_name(name);
@@ -74,10 +81,12 @@ blocking_stream_data prepare_blocking_stream_data(
             boost::interprocess::read_write);
     } catch (...) {
         // Shared memory doesn't exist, so create one.
-        return create_and_initialize_blocking_stream_data(name, buffer_size);
+        return create_and_initialize_blocking_stream_data(
+            name, buffer_size, layout, element_type, options, numa_node);
     }
 
-    extract_stream_data_from_shared_memory(data);
+    extract_stream_data_from_shared_memory(data, options);
+    check_element_type(data, element_type);
 
     return data;
 }
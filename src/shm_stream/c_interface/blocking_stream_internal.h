@@ -62,20 +62,39 @@ using blocking_stream_data = atomic_stream_data;
  *
  * \param[in] name Name of the stream.
  * \param[in] buffer_size Size of the buffer.
+ * \param[in] layout Layout of the buffer.
+ * \param[in] element_type Type of elements.
+ * \param[in] options Options of memory.
+ * \param[in] numa_node NUMA node to bind pages to. (numa_node_none for the
+ * usual placement of pages.)
  * \return Data.
  */
 [[nodiscard]] blocking_stream_data create_and_initialize_blocking_stream_data(
-    string_view name, shm_stream_size_t buffer_size);
+    string_view name, shm_stream_size_t buffer_size,
+    buffer_layout layout = buffer_layout::plain,
+    const stream_element_type& element_type = stream_element_type(),
+    memory_options options = memory_options::none,
+    numa_node_t numa_node = numa_node_none);
 
 /*!
  * \brief Prepare data of a blocking stream.
  *
  * \param[in] name Name of the stream.
  * \param[in] buffer_size Size of the buffer.
+ * \param[in] layout Layout of the buffer.
+ * \param[in] element_type Type of elements. (Fingerprint of zero to accept
+ * any type in existing streams.)
+ * \param[in] options Options of memory.
+ * \param[in] numa_node NUMA node to bind pages to when the stream is created.
+ * (numa_node_none for the usual placement of pages.)
  * \return Data.
  */
 [[nodiscard]] blocking_stream_data prepare_blocking_stream_data(
-    string_view name, shm_stream_size_t buffer_size);
+    string_view name, shm_stream_size_t buffer_size,
+    buffer_layout layout = buffer_layout::plain,
+    const stream_element_type& element_type = stream_element_type(),
+    memory_options options = memory_options::none,
+    numa_node_t numa_node = numa_node_none);
 
 /*!
  * \brief Remove a blocking stream.
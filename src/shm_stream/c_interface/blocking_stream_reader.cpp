@@ -20,15 +20,24 @@
  */
 #include "shm_stream/c_interface/blocking_stream_reader.h"
 
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+
 #include <boost/interprocess/mapped_region.hpp>
 #include <boost/interprocess/shared_memory_object.hpp>
 
 #include "blocking_stream_internal.h"
+#include "doorbell_internal.h"
 #include "shm_stream/c_interface/bytes_view.h"
 #include "shm_stream/c_interface/translate_error.h"
 #include "shm_stream/common_types.h"
 #include "shm_stream/details/blocking_bytes_queue.h"
 #include "shm_stream/string_view.h"
+#include "shm_stream/wait_policy.h"
+#include "wait_any_internal.h"
 
 /*!
  * \brief Reader of blocking streams of bytes with wait operations.
@@ -40,31 +49,51 @@ struct c_shm_stream_blocking_stream_reader {
     //! Mapped region.
     boost::interprocess::mapped_region mapped_region;
 
+    //! Mapped region with the buffer mirrored.
+    shm_stream::details::mirrored_region mirrored_region;
+
     //! Reader.
     shm_stream::details::blocking_bytes_queue_reader<> reader;
 
+    //! Doorbell.
+    shm_stream::details::doorbell doorbell;
+
     /*!
      * \brief Constructor.
      *
      * \param[in] data Data.
+     * \param[in] policy Policy to wait.
      */
-    explicit c_shm_stream_blocking_stream_reader(
-        shm_stream::details::blocking_stream_data&& data)
+    c_shm_stream_blocking_stream_reader(
+        shm_stream::details::blocking_stream_data&& data,
+        const shm_stream::wait_policy& policy)
         : shared_memory(std::move(data.shared_memory)),
           mapped_region(std::move(data.mapped_region)),
-          reader(*data.atomic_indices, data.buffer) {}
+          mirrored_region(std::move(data.mirrored_region)),
+          reader(*data.atomic_indices, data.buffer, data.is_mirrored,
+              policy),
+          doorbell(data.doorbell_armed) {}
 
     /*!
      * \brief Constructor.
      *
      * \param[in] name Name of the stream.
      * \param[in] buffer_size Size of the buffer.
+     * \param[in] policy Policy to wait.
+     * \param[in] element_type Type of elements.
+     * \param[in] options Options of memory.
      */
-    c_shm_stream_blocking_stream_reader(
-        shm_stream::string_view name, shm_stream::shm_stream_size_t buffer_size)
+    c_shm_stream_blocking_stream_reader(shm_stream::string_view name,
+        shm_stream::shm_stream_size_t buffer_size,
+        const shm_stream::wait_policy& policy = shm_stream::wait_policy(),
+        const shm_stream::details::stream_element_type& element_type =
+            shm_stream::details::stream_element_type(),
+        shm_stream::memory_options options = shm_stream::memory_options::none)
         : c_shm_stream_blocking_stream_reader(
-              shm_stream::details::prepare_blocking_stream_data(
-                  name, buffer_size)) {}
+              shm_stream::details::prepare_blocking_stream_data(name,
+                  buffer_size, shm_stream::buffer_layout::plain,
+                  element_type, options),
+              policy) {}
 };
 
 c_shm_stream_error_code_t c_shm_stream_blocking_stream_reader_create(
@@ -77,6 +106,46 @@ c_shm_stream_error_code_t c_shm_stream_blocking_stream_reader_create(
                                          buffer_size));
 }
 
+c_shm_stream_error_code_t
+c_shm_stream_blocking_stream_reader_create_with_wait_policy(
+    c_shm_stream_blocking_stream_reader_t** reader,
+    c_shm_stream_string_view_t name, c_shm_stream_size_t buffer_size,
+    c_shm_stream_wait_policy_t policy) {
+    C_SHM_STREAM_TRANSLATE_ERROR(*reader =
+                                     new c_shm_stream_blocking_stream_reader(
+                                         shm_stream::string_view{
+                                             name.data, name.size},
+                                         buffer_size,
+                                         shm_stream::wait_policy(policy)));
+}
+
+c_shm_stream_error_code_t c_shm_stream_blocking_stream_reader_create_typed(
+    c_shm_stream_blocking_stream_reader_t** reader,
+    c_shm_stream_string_view_t name, c_shm_stream_size_t buffer_size,
+    c_shm_stream_size64_t element_type, c_shm_stream_size_t element_size,
+    c_shm_stream_wait_policy_t policy) {
+    C_SHM_STREAM_TRANSLATE_ERROR(
+        *reader = new c_shm_stream_blocking_stream_reader(
+            shm_stream::string_view{name.data, name.size}, buffer_size,
+            shm_stream::wait_policy(policy),
+            shm_stream::details::stream_element_type{
+                element_type, element_size}));
+}
+
+c_shm_stream_error_code_t
+c_shm_stream_blocking_stream_reader_create_with_memory_options(
+    c_shm_stream_blocking_stream_reader_t** reader,
+    c_shm_stream_string_view_t name, c_shm_stream_size_t buffer_size,
+    c_shm_stream_wait_policy_t policy,
+    c_shm_stream_memory_options_t options) {
+    C_SHM_STREAM_TRANSLATE_ERROR(
+        *reader = new c_shm_stream_blocking_stream_reader(
+            shm_stream::string_view{name.data, name.size}, buffer_size,
+            shm_stream::wait_policy(policy),
+            shm_stream::details::stream_element_type(),
+            static_cast<shm_stream::memory_options>(options)));
+}
+
 void c_shm_stream_blocking_stream_reader_destroy(
     c_shm_stream_blocking_stream_reader_t* reader) {
     delete reader;
@@ -90,6 +159,25 @@ c_shm_stream_size_t c_shm_stream_blocking_stream_reader_available_size(
     return reader->reader.available_size();
 }
 
+c_shm_stream_size_t c_shm_stream_blocking_stream_reader_page_size(
+    c_shm_stream_blocking_stream_reader_t* reader) {
+    if (reader == nullptr) {
+        return 0U;
+    }
+    return static_cast<c_shm_stream_size_t>(
+        shm_stream::details::effective_page_size(
+            reader->mapped_region, reader->mirrored_region));
+}
+
+c_shm_stream_numa_node_t c_shm_stream_blocking_stream_reader_numa_node(
+    c_shm_stream_blocking_stream_reader_t* reader) {
+    if (reader == nullptr) {
+        return c_shm_stream_numa_node_none;
+    }
+    return shm_stream::details::numa_node_of(
+        reader->mapped_region, reader->mirrored_region);
+}
+
 c_shm_stream_size_t c_shm_stream_blocking_stream_reader_wait(
     c_shm_stream_blocking_stream_reader_t* reader) {
     if (reader == nullptr) {
@@ -160,3 +248,155 @@ void c_shm_stream_blocking_stream_reader_commit(
     }
     reader->reader.commit(read_size);
 }
+
+bool c_shm_stream_blocking_stream_reader_wait_read_scatter(
+    c_shm_stream_blocking_stream_reader_t* reader,
+    const c_shm_stream_mutable_bytes_view_t* pieces,
+    c_shm_stream_size_t num_pieces) {
+    if (reader == nullptr) {
+        return false;
+    }
+    return reader->reader.wait_read_scatter(pieces, num_pieces);
+}
+
+bool c_shm_stream_blocking_stream_reader_read_exact(
+    c_shm_stream_blocking_stream_reader_t* reader,
+    c_shm_stream_mutable_bytes_view_t buffer) {
+    if (reader == nullptr) {
+        return false;
+    }
+    char* destination = buffer.data;
+    shm_stream::shm_stream_size_t remaining = buffer.size;
+    while (remaining > 0U) {
+        const auto reserved = reader->reader.wait_reserve(remaining);
+        if (reserved.empty()) {
+            return false;
+        }
+        // Non-temporal stores are not used, because the caller reads the
+        // bytes soon after this function.
+        std::memcpy(destination, reserved.data(), reserved.size());
+        reader->reader.commit(reserved.size());
+        destination += reserved.size();
+        remaining -= reserved.size();
+    }
+    return true;
+}
+
+c_shm_stream_error_code_t c_shm_stream_blocking_stream_reader_set_doorbell(
+    c_shm_stream_blocking_stream_reader_t* reader, int fd) {
+    if (reader == nullptr) {
+        return c_shm_stream_error_code_invalid_argument;
+    }
+    C_SHM_STREAM_TRANSLATE_ERROR(reader->doorbell.set_fd(fd));
+}
+
+bool c_shm_stream_blocking_stream_reader_arm_doorbell(
+    c_shm_stream_blocking_stream_reader_t* reader) {
+    if (reader == nullptr || reader->doorbell.fd() < 0) {
+        return false;
+    }
+    reader->doorbell.arm();
+    if (reader->reader.available_size() > 0U ||
+        reader->reader.is_stopped()) {
+        reader->doorbell.disarm();
+        return false;
+    }
+    return true;
+}
+
+namespace {
+
+/*!
+ * \brief Collect indices of ready readers.
+ *
+ * \param[in] readers Readers.
+ * \param[in] num_readers Number of readers.
+ * \param[out] ready_indices Buffer to write indices of ready readers.
+ * \return Number of ready readers.
+ */
+c_shm_stream_size_t collect_ready_readers(
+    c_shm_stream_blocking_stream_reader_t* const* readers,
+    c_shm_stream_size_t num_readers, c_shm_stream_size_t* ready_indices) {
+    c_shm_stream_size_t num_ready = 0U;
+    for (c_shm_stream_size_t i = 0U; i < num_readers; ++i) {
+        c_shm_stream_blocking_stream_reader_t* reader = readers[i];
+        if (reader == nullptr || reader->reader.available_size() > 0U ||
+            reader->reader.is_stopped()) {
+            ready_indices[num_ready] = i;
+            ++num_ready;
+        }
+    }
+    return num_ready;
+}
+
+}  // namespace
+
+c_shm_stream_size_t c_shm_stream_blocking_stream_reader_wait_any(
+    c_shm_stream_blocking_stream_reader_t* const* readers,
+    c_shm_stream_size_t num_readers, int64_t timeout_nanoseconds,
+    c_shm_stream_size_t* ready_indices) {
+    if (readers == nullptr || num_readers == 0U ||
+        ready_indices == nullptr) {
+        return 0U;
+    }
+
+    c_shm_stream_size_t num_ready =
+        collect_ready_readers(readers, num_readers, ready_indices);
+    if (num_ready > 0U || timeout_nanoseconds == 0) {
+        return num_ready;
+    }
+
+    using clock = std::chrono::steady_clock;
+    clock::time_point deadline = clock::time_point::max();
+    if (timeout_nanoseconds > 0) {
+        const clock::time_point now = clock::now();
+        const auto timeout = std::chrono::nanoseconds(timeout_nanoseconds);
+        if (timeout < clock::time_point::max() - now) {
+            deadline = now +
+                std::chrono::duration_cast<clock::duration>(timeout);
+        }
+    }
+
+    // Fixed arrays are used so that this function never allocates memory.
+    // Variables of readers after the limit are checked after slices.
+    std::array<const std::uint32_t*,
+        shm_stream::details::max_wait_any_addresses()>
+        addresses{};
+    std::array<std::uint32_t, shm_stream::details::max_wait_any_addresses()>
+        values{};
+    while (true) {
+        // Register all readers as waiters before sleeping, so that writers
+        // notify this thread of any changes after the registration.
+        c_shm_stream_size_t num_registered = 0U;
+        bool is_any_ready = false;
+        for (; num_registered < num_readers; ++num_registered) {
+            auto& reader = readers[num_registered]->reader;
+            shm_stream::shm_stream_size_t value = 0U;
+            if (!reader.begin_wait_any(value)) {
+                is_any_ready = true;
+                break;
+            }
+            if (num_registered < addresses.size()) {
+                addresses[num_registered] =
+                    &reader.atomic_next_write_index().value();
+                values[num_registered] = value;
+            }
+        }
+
+        if (!is_any_ready && clock::now() < deadline) {
+            shm_stream::details::wait_any_change(addresses.data(),
+                values.data(),
+                std::min<std::size_t>(num_registered, addresses.size()),
+                deadline, num_registered > addresses.size());
+        }
+
+        for (c_shm_stream_size_t i = 0U; i < num_registered; ++i) {
+            readers[i]->reader.end_wait_any();
+        }
+
+        num_ready = collect_ready_readers(readers, num_readers, ready_indices);
+        if (num_ready > 0U || clock::now() >= deadline) {
+            return num_ready;
+        }
+    }
+}
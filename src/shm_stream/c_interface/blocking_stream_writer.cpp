@@ -24,11 +24,14 @@
 #include <boost/interprocess/shared_memory_object.hpp>
 
 #include "blocking_stream_internal.h"
+#include "bulk_copy_internal.h"
+#include "doorbell_internal.h"
 #include "shm_stream/c_interface/bytes_view.h"
 #include "shm_stream/c_interface/translate_error.h"
 #include "shm_stream/common_types.h"
 #include "shm_stream/details/blocking_bytes_queue.h"
 #include "shm_stream/string_view.h"
+#include "shm_stream/wait_policy.h"
 
 /*!
  * \brief Writer of blocking streams of bytes with wait operations.
@@ -40,31 +43,51 @@ struct c_shm_stream_blocking_stream_writer {
     //! Mapped region.
     boost::interprocess::mapped_region mapped_region;
 
+    //! Mapped region with the buffer mirrored.
+    shm_stream::details::mirrored_region mirrored_region;
+
     //! Writer.
     shm_stream::details::blocking_bytes_queue_writer<> writer;
 
+    //! Doorbell.
+    shm_stream::details::doorbell doorbell;
+
     /*!
      * \brief Constructor.
      *
      * \param[in] data Data.
+     * \param[in] policy Policy to wait.
      */
-    explicit c_shm_stream_blocking_stream_writer(
-        shm_stream::details::blocking_stream_data&& data)
+    c_shm_stream_blocking_stream_writer(
+        shm_stream::details::blocking_stream_data&& data,
+        const shm_stream::wait_policy& policy)
         : shared_memory(std::move(data.shared_memory)),
           mapped_region(std::move(data.mapped_region)),
-          writer(*data.atomic_indices, data.buffer) {}
+          mirrored_region(std::move(data.mirrored_region)),
+          writer(*data.atomic_indices, data.buffer, data.is_mirrored, policy,
+              data.element_type.size),
+          doorbell(data.doorbell_armed) {}
 
     /*!
      * \brief Constructor.
      *
      * \param[in] name Name of the stream.
      * \param[in] buffer_size Size of the buffer.
+     * \param[in] policy Policy to wait.
+     * \param[in] element_type Type of elements.
+     * \param[in] options Options of memory.
      */
-    c_shm_stream_blocking_stream_writer(
-        shm_stream::string_view name, shm_stream::shm_stream_size_t buffer_size)
+    c_shm_stream_blocking_stream_writer(shm_stream::string_view name,
+        shm_stream::shm_stream_size_t buffer_size,
+        const shm_stream::wait_policy& policy = shm_stream::wait_policy(),
+        const shm_stream::details::stream_element_type& element_type =
+            shm_stream::details::stream_element_type(),
+        shm_stream::memory_options options = shm_stream::memory_options::none)
         : c_shm_stream_blocking_stream_writer(
-              shm_stream::details::prepare_blocking_stream_data(
-                  name, buffer_size)) {}
+              shm_stream::details::prepare_blocking_stream_data(name,
+                  buffer_size, shm_stream::buffer_layout::plain,
+                  element_type, options),
+              policy) {}
 };
 
 c_shm_stream_error_code_t c_shm_stream_blocking_stream_writer_create(
@@ -77,6 +100,46 @@ c_shm_stream_error_code_t c_shm_stream_blocking_stream_writer_create(
                                          buffer_size));
 }
 
+c_shm_stream_error_code_t
+c_shm_stream_blocking_stream_writer_create_with_wait_policy(
+    c_shm_stream_blocking_stream_writer_t** writer,
+    c_shm_stream_string_view_t name, c_shm_stream_size_t buffer_size,
+    c_shm_stream_wait_policy_t policy) {
+    C_SHM_STREAM_TRANSLATE_ERROR(*writer =
+                                     new c_shm_stream_blocking_stream_writer(
+                                         shm_stream::string_view{
+                                             name.data, name.size},
+                                         buffer_size,
+                                         shm_stream::wait_policy(policy)));
+}
+
+c_shm_stream_error_code_t c_shm_stream_blocking_stream_writer_create_typed(
+    c_shm_stream_blocking_stream_writer_t** writer,
+    c_shm_stream_string_view_t name, c_shm_stream_size_t buffer_size,
+    c_shm_stream_size64_t element_type, c_shm_stream_size_t element_size,
+    c_shm_stream_wait_policy_t policy) {
+    C_SHM_STREAM_TRANSLATE_ERROR(
+        *writer = new c_shm_stream_blocking_stream_writer(
+            shm_stream::string_view{name.data, name.size}, buffer_size,
+            shm_stream::wait_policy(policy),
+            shm_stream::details::stream_element_type{
+                element_type, element_size}));
+}
+
+c_shm_stream_error_code_t
+c_shm_stream_blocking_stream_writer_create_with_memory_options(
+    c_shm_stream_blocking_stream_writer_t** writer,
+    c_shm_stream_string_view_t name, c_shm_stream_size_t buffer_size,
+    c_shm_stream_wait_policy_t policy,
+    c_shm_stream_memory_options_t options) {
+    C_SHM_STREAM_TRANSLATE_ERROR(
+        *writer = new c_shm_stream_blocking_stream_writer(
+            shm_stream::string_view{name.data, name.size}, buffer_size,
+            shm_stream::wait_policy(policy),
+            shm_stream::details::stream_element_type(),
+            static_cast<shm_stream::memory_options>(options)));
+}
+
 void c_shm_stream_blocking_stream_writer_destroy(
     c_shm_stream_blocking_stream_writer_t* writer) {
     delete writer;
@@ -90,6 +153,25 @@ c_shm_stream_size_t c_shm_stream_blocking_stream_writer_available_size(
     return writer->writer.available_size();
 }
 
+c_shm_stream_size_t c_shm_stream_blocking_stream_writer_page_size(
+    c_shm_stream_blocking_stream_writer_t* writer) {
+    if (writer == nullptr) {
+        return 0U;
+    }
+    return static_cast<c_shm_stream_size_t>(
+        shm_stream::details::effective_page_size(
+            writer->mapped_region, writer->mirrored_region));
+}
+
+c_shm_stream_numa_node_t c_shm_stream_blocking_stream_writer_numa_node(
+    c_shm_stream_blocking_stream_writer_t* writer) {
+    if (writer == nullptr) {
+        return c_shm_stream_numa_node_none;
+    }
+    return shm_stream::details::numa_node_of(
+        writer->mapped_region, writer->mirrored_region);
+}
+
 c_shm_stream_size_t c_shm_stream_blocking_stream_writer_wait(
     c_shm_stream_blocking_stream_writer_t* writer) {
     if (writer == nullptr) {
@@ -104,6 +186,7 @@ void c_shm_stream_blocking_stream_writer_stop(
         return;
     }
     writer->writer.stop();
+    writer->doorbell.ring_if_armed();
 }
 
 bool c_shm_stream_blocking_stream_writer_is_stopped(
@@ -163,4 +246,49 @@ void c_shm_stream_blocking_stream_writer_commit(
         return;
     }
     writer->writer.commit(written_size);
+    writer->doorbell.ring_if_armed();
+}
+
+bool c_shm_stream_blocking_stream_writer_wait_write_gather(
+    c_shm_stream_blocking_stream_writer_t* writer,
+    const c_shm_stream_bytes_view_t* pieces, c_shm_stream_size_t num_pieces) {
+    if (writer == nullptr) {
+        return false;
+    }
+    if (!writer->writer.wait_write_gather(pieces, num_pieces)) {
+        return false;
+    }
+    writer->doorbell.ring_if_armed();
+    return true;
+}
+
+bool c_shm_stream_blocking_stream_writer_write_all(
+    c_shm_stream_blocking_stream_writer_t* writer,
+    c_shm_stream_bytes_view_t data) {
+    if (writer == nullptr) {
+        return false;
+    }
+    const char* source = data.data;
+    shm_stream::shm_stream_size_t remaining = data.size;
+    while (remaining > 0U) {
+        const auto buffer = writer->writer.wait_reserve(remaining);
+        if (buffer.empty()) {
+            return false;
+        }
+        shm_stream::details::bulk_copy(
+            buffer.data(), source, buffer.size(), data.size);
+        writer->writer.commit(buffer.size());
+        writer->doorbell.ring_if_armed();
+        source += buffer.size();
+        remaining -= buffer.size();
+    }
+    return true;
+}
+
+c_shm_stream_error_code_t c_shm_stream_blocking_stream_writer_set_doorbell(
+    c_shm_stream_blocking_stream_writer_t* writer, int fd) {
+    if (writer == nullptr) {
+        return c_shm_stream_error_code_invalid_argument;
+    }
+    C_SHM_STREAM_TRANSLATE_ERROR(writer->doorbell.set_fd(fd));
 }
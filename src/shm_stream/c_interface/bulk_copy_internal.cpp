@@ -0,0 +1,222 @@
+/*
+ * Copyright 2023 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Implementation of internal functions to copy large byte sequences.
+ */
+#include "bulk_copy_internal.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+#if (defined(__GNUC__) || defined(__clang__)) && \
+    (defined(__x86_64__) || defined(__i386__))
+#define SHM_STREAM_BULK_COPY_X86 1
+#include <immintrin.h>
+#else
+#define SHM_STREAM_BULK_COPY_X86 0
+#endif
+
+namespace shm_stream {
+namespace details {
+
+namespace {
+
+/*!
+ * \brief Type of functions to copy bytes.
+ */
+using bulk_copy_function = void (*)(char*, const char*, std::size_t);
+
+/*!
+ * \brief Copy bytes without vector instructions.
+ *
+ * \param[out] destination Destination.
+ * \param[in] source Source.
+ * \param[in] size Number of bytes to copy.
+ */
+void bulk_copy_portable(
+    char* destination, const char* source, std::size_t size) noexcept {
+    std::memcpy(destination, source, size);
+}
+
+#if SHM_STREAM_BULK_COPY_X86
+
+/*!
+ * \brief Copy bytes until the destination is aligned.
+ *
+ * \param[in] alignment Alignment.
+ * \param[in,out] destination Destination.
+ * \param[in,out] source Source.
+ * \param[in,out] size Number of bytes to copy.
+ */
+void bulk_copy_head(std::size_t alignment, char*& destination,
+    const char*& source, std::size_t& size) noexcept {
+    const std::size_t misalignment =
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+        reinterpret_cast<std::uintptr_t>(destination) & (alignment - 1U);
+    const std::size_t head_size =
+        std::min(size, (alignment - misalignment) & (alignment - 1U));
+    std::memcpy(destination, source, head_size);
+    destination += head_size;
+    source += head_size;
+    size -= head_size;
+}
+
+/*!
+ * \brief Copy bytes using non-temporal stores of SSE2.
+ *
+ * \param[out] destination Destination.
+ * \param[in] source Source.
+ * \param[in] size Number of bytes to copy.
+ */
+__attribute__((target("sse2"))) void bulk_copy_sse2(
+    char* destination, const char* source, std::size_t size) noexcept {
+    constexpr std::size_t width = sizeof(__m128i);
+    constexpr std::size_t block = 4U * width;
+    bulk_copy_head(width, destination, source, size);
+    for (; size >= block; size -= block) {
+        // NOLINTBEGIN(cppcoreguidelines-pro-type-reinterpret-cast)
+        const __m128i v0 =
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(source));
+        const __m128i v1 =
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + width));
+        const __m128i v2 = _mm_loadu_si128(
+            reinterpret_cast<const __m128i*>(source + 2U * width));
+        const __m128i v3 = _mm_loadu_si128(
+            reinterpret_cast<const __m128i*>(source + 3U * width));
+        _mm_stream_si128(reinterpret_cast<__m128i*>(destination), v0);
+        _mm_stream_si128(reinterpret_cast<__m128i*>(destination + width), v1);
+        _mm_stream_si128(
+            reinterpret_cast<__m128i*>(destination + 2U * width), v2);
+        _mm_stream_si128(
+            reinterpret_cast<__m128i*>(destination + 3U * width), v3);
+        // NOLINTEND(cppcoreguidelines-pro-type-reinterpret-cast)
+        destination += block;
+        source += block;
+    }
+    _mm_sfence();
+    std::memcpy(destination, source, size);
+}
+
+/*!
+ * \brief Copy bytes using non-temporal stores of AVX2.
+ *
+ * \param[out] destination Destination.
+ * \param[in] source Source.
+ * \param[in] size Number of bytes to copy.
+ */
+__attribute__((target("avx2"))) void bulk_copy_avx2(
+    char* destination, const char* source, std::size_t size) noexcept {
+    constexpr std::size_t width = sizeof(__m256i);
+    constexpr std::size_t block = 4U * width;
+    bulk_copy_head(width, destination, source, size);
+    for (; size >= block; size -= block) {
+        // NOLINTBEGIN(cppcoreguidelines-pro-type-reinterpret-cast)
+        const __m256i v0 =
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(source));
+        const __m256i v1 = _mm256_loadu_si256(
+            reinterpret_cast<const __m256i*>(source + width));
+        const __m256i v2 = _mm256_loadu_si256(
+            reinterpret_cast<const __m256i*>(source + 2U * width));
+        const __m256i v3 = _mm256_loadu_si256(
+            reinterpret_cast<const __m256i*>(source + 3U * width));
+        _mm256_stream_si256(reinterpret_cast<__m256i*>(destination), v0);
+        _mm256_stream_si256(
+            reinterpret_cast<__m256i*>(destination + width), v1);
+        _mm256_stream_si256(
+            reinterpret_cast<__m256i*>(destination + 2U * width), v2);
+        _mm256_stream_si256(
+            reinterpret_cast<__m256i*>(destination + 3U * width), v3);
+        // NOLINTEND(cppcoreguidelines-pro-type-reinterpret-cast)
+        destination += block;
+        source += block;
+    }
+    _mm_sfence();
+    std::memcpy(destination, source, size);
+}
+
+/*!
+ * \brief Copy bytes using non-temporal stores of AVX-512.
+ *
+ * \param[out] destination Destination.
+ * \param[in] source Source.
+ * \param[in] size Number of bytes to copy.
+ */
+__attribute__((target("avx512f"))) void bulk_copy_avx512(
+    char* destination, const char* source, std::size_t size) noexcept {
+    constexpr std::size_t width = sizeof(__m512i);
+    constexpr std::size_t block = 4U * width;
+    bulk_copy_head(width, destination, source, size);
+    for (; size >= block; size -= block) {
+        const __m512i v0 = _mm512_loadu_si512(source);
+        const __m512i v1 = _mm512_loadu_si512(source + width);
+        const __m512i v2 = _mm512_loadu_si512(source + 2U * width);
+        const __m512i v3 = _mm512_loadu_si512(source + 3U * width);
+        // NOLINTBEGIN(cppcoreguidelines-pro-type-reinterpret-cast)
+        _mm512_stream_si512(reinterpret_cast<__m512i*>(destination), v0);
+        _mm512_stream_si512(
+            reinterpret_cast<__m512i*>(destination + width), v1);
+        _mm512_stream_si512(
+            reinterpret_cast<__m512i*>(destination + 2U * width), v2);
+        _mm512_stream_si512(
+            reinterpret_cast<__m512i*>(destination + 3U * width), v3);
+        // NOLINTEND(cppcoreguidelines-pro-type-reinterpret-cast)
+        destination += block;
+        source += block;
+    }
+    _mm_sfence();
+    std::memcpy(destination, source, size);
+}
+
+#endif
+
+/*!
+ * \brief Select the function to copy bytes using non-temporal stores.
+ *
+ * \return Function.
+ */
+bulk_copy_function select_streaming_bulk_copy() noexcept {
+#if SHM_STREAM_BULK_COPY_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) {
+        return bulk_copy_avx512;
+    }
+    if (__builtin_cpu_supports("avx2")) {
+        return bulk_copy_avx2;
+    }
+    if (__builtin_cpu_supports("sse2")) {
+        return bulk_copy_sse2;
+    }
+#endif
+    return bulk_copy_portable;
+}
+
+}  // namespace
+
+void bulk_copy(char* destination, const char* source, std::size_t size,
+    std::size_t transfer_size) noexcept {
+    if (transfer_size < bulk_copy_streaming_threshold()) {
+        std::memcpy(destination, source, size);
+        return;
+    }
+    static const bulk_copy_function streaming_bulk_copy =
+        select_streaming_bulk_copy();
+    streaming_bulk_copy(destination, source, size);
+}
+
+}  // namespace details
+}  // namespace shm_stream
@@ -0,0 +1,60 @@
+/*
+ * Copyright 2023 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Definition of internal functions to copy large byte sequences.
+ */
+#pragma once
+
+#include <cstddef>
+
+namespace shm_stream {
+namespace details {
+
+/*!
+ * \brief Get the minimum size of transfers copied with non-temporal stores.
+ *
+ * \return Number of bytes.
+ */
+constexpr std::size_t bulk_copy_streaming_threshold() noexcept {
+    return static_cast<std::size_t>(256U) * 1024U;  // NOLINT
+}
+
+/*!
+ * \brief Copy bytes in a transfer of a large byte sequence.
+ *
+ * \param[out] destination Destination.
+ * \param[in] source Source.
+ * \param[in] size Number of bytes to copy.
+ * \param[in] transfer_size Total number of bytes in the transfer which this
+ * copy belongs to.
+ *
+ * \note When transfer_size is at least bulk_copy_streaming_threshold(), this
+ * function copies bytes using non-temporal stores with the widest vector
+ * instructions the CPU supports (selected at the first call), so that the
+ * destination does not evict the cache of the caller. A store fence follows
+ * such stores, so a release store after this function publishes the bytes.
+ * \note Otherwise, or on CPUs without such instructions, this function is
+ * equivalent to std::memcpy.
+ * \note This function is used only for writes, because readers use the bytes
+ * soon after copying, and they would load bytes again from memory if bytes
+ * bypassed the cache.
+ */
+void bulk_copy(char* destination, const char* source, std::size_t size,
+    std::size_t transfer_size) noexcept;
+
+}  // namespace details
+}  // namespace shm_stream
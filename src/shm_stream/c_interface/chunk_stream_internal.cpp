@@ -0,0 +1,177 @@
+/*
+ * Copyright 2023 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Implementation of internal functions of streams of chunks.
+ */
+#include "chunk_stream_internal.h"
+
+#include <cstddef>
+#include <mutex>
+#include <new>
+
+#include <boost/interprocess/creation_tags.hpp>
+#include <boost/interprocess/sync/named_mutex.hpp>
+#include <fmt/format.h>
+
+#include "atomic_stream_internal.h"
+#include "shm_stream/c_interface/error_codes.h"
+#include "shm_stream/details/cache_line_size.h"
+#include "shm_stream/shm_stream_exception.h"
+
+namespace shm_stream {
+namespace details {
+
+/*!
+ * \brief Header of the data shared in streams of chunks.
+ */
+struct chunk_stream_header {
+    //! Atomic variables of the indices of the queue of descriptors.
+    alignas(cache_line_size()) atomic_index_pair<> descriptor_indices{};
+
+    //! Atomic variables of the indices of the queue of returned chunks.
+    alignas(cache_line_size()) atomic_index_pair<> return_indices{};
+
+    //! Number of chunks.
+    alignas(cache_line_size()) shm_stream_size_t num_chunks{};
+
+    //! Size of each chunk.
+    shm_stream_size_t chunk_size{};
+};
+
+namespace {
+
+/*!
+ * \brief Calculate the offset of the first chunk from the header.
+ *
+ * \param[in] num_chunks Number of chunks.
+ * \return Number of bytes.
+ */
+std::size_t chunks_offset(shm_stream_size_t num_chunks) {
+    const std::size_t queues_end = sizeof(chunk_stream_header) +
+        chunk_queue_base<>::descriptor_buffer_size(num_chunks) +
+        chunk_queue_base<>::return_buffer_size(num_chunks);
+    return (queues_end + cache_line_size() - 1U) & ~(cache_line_size() - 1U);
+}
+
+/*!
+ * \brief Set pointers in data of streams of chunks from the header.
+ *
+ * \param[in,out] data Data.
+ * \param[in] header Header.
+ */
+void set_chunk_stream_data_from_header(
+    chunk_stream_data& data, chunk_stream_header* header) {
+    char* address = static_cast<char*>(static_cast<void*>(header));
+    const shm_stream_size_t descriptor_buffer_size =
+        chunk_queue_base<>::descriptor_buffer_size(header->num_chunks);
+    const shm_stream_size_t return_buffer_size =
+        chunk_queue_base<>::return_buffer_size(header->num_chunks);
+
+    data.descriptor_indices = &header->descriptor_indices;
+    data.descriptor_buffer = mutable_bytes_view(
+        address + sizeof(chunk_stream_header), descriptor_buffer_size);
+    data.return_indices = &header->return_indices;
+    data.return_buffer = mutable_bytes_view(address +
+            sizeof(chunk_stream_header) + descriptor_buffer_size,
+        return_buffer_size);
+    data.chunks = address + chunks_offset(header->num_chunks);
+    data.num_chunks = header->num_chunks;
+    data.chunk_size = header->chunk_size;
+}
+
+}  // namespace
+
+std::string chunk_stream_shm_name(string_view stream_name) {
+    return fmt::format("shm_stream_chunk_stream_data_{}", stream_name);
+}
+
+std::string chunk_stream_mutex_name(string_view stream_name) {
+    return fmt::format("shm_stream_chunk_stream_lock_{}", stream_name);
+}
+
+chunk_stream_data create_and_initialize_chunk_stream_data(string_view name,
+    shm_stream_size_t num_chunks, shm_stream_size_t chunk_size) {
+    chunk_pool_view::check_params(num_chunks, chunk_size);
+    const std::string shm_name = chunk_stream_shm_name(name);
+
+    chunk_stream_data data{};
+
+    try {
+        data.shared_memory = boost::interprocess::shared_memory_object(
+            boost::interprocess::create_only, shm_name.c_str(),
+            boost::interprocess::read_write);
+    } catch (...) {
+        throw shm_stream_error(c_shm_stream_error_code_failed_to_open);
+    }
+
+    const boost::interprocess::offset_t data_size =
+        static_cast<boost::interprocess::offset_t>(chunks_offset(num_chunks)) +
+        static_cast<boost::interprocess::offset_t>(num_chunks) *
+            static_cast<boost::interprocess::offset_t>(
+                chunk_pool_view::chunk_stride(chunk_size));
+    data.shared_memory.truncate(data_size);
+    data.mapped_region = boost::interprocess::mapped_region(
+        data.shared_memory, boost::interprocess::read_write);
+
+    auto* header = new (data.mapped_region.get_address()) chunk_stream_header();
+    header->num_chunks = num_chunks;
+    header->chunk_size = chunk_size;
+    set_chunk_stream_data_from_header(data, header);
+
+    chunk_queue_base<>::initialize_returned_chunks(
+        *data.return_indices, data.return_buffer, num_chunks);
+
+    return data;
+}
+
+chunk_stream_data prepare_chunk_stream_data(string_view name,
+    shm_stream_size_t num_chunks, shm_stream_size_t chunk_size) {
+    const std::string shm_name = chunk_stream_shm_name(name);
+    const std::string mutex_name = chunk_stream_mutex_name(name);
+
+    chunk_stream_data data{};
+
+    boost::interprocess::named_mutex mutex{
+        boost::interprocess::open_or_create, mutex_name.c_str()};
+    std::unique_lock<boost::interprocess::named_mutex> lock(mutex);
+
+    try {
+        data.shared_memory = boost::interprocess::shared_memory_object(
+            boost::interprocess::open_only, shm_name.c_str(),
+            boost::interprocess::read_write);
+    } catch (...) {
+        // Shared memory doesn't exist, so create one.
+        return create_and_initialize_chunk_stream_data(
+            name, num_chunks, chunk_size);
+    }
+
+    data.mapped_region = boost::interprocess::mapped_region(
+        data.shared_memory, boost::interprocess::read_write);
+    set_chunk_stream_data_from_header(data,
+        static_cast<chunk_stream_header*>(data.mapped_region.get_address()));
+
+    return data;
+}
+
+void remove_chunk_stream(string_view name) {
+    const std::string mutex_name = chunk_stream_mutex_name(name);
+    const std::string shm_name = chunk_stream_shm_name(name);
+    remove_atomic_stream(mutex_name, shm_name);
+}
+
+}  // namespace details
+}  // namespace shm_stream
@@ -0,0 +1,127 @@
+/*
+ * Copyright 2023 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Definition of internal functions of streams of chunks.
+ */
+#pragma once
+
+#include <string>
+
+#include <boost/interprocess/mapped_region.hpp>
+#include <boost/interprocess/shared_memory_object.hpp>
+
+#include "shm_stream/bytes_view.h"
+#include "shm_stream/common_types.h"
+#include "shm_stream/details/atomic_index_pair.h"
+#include "shm_stream/details/chunk_queue.h"
+#include "shm_stream/string_view.h"
+
+namespace shm_stream {
+namespace details {
+
+/*!
+ * \brief Data of streams of chunks.
+ */
+struct chunk_stream_data {
+    //! Shared memory object.
+    boost::interprocess::shared_memory_object shared_memory{};
+
+    //! Mapped region.
+    boost::interprocess::mapped_region mapped_region{};
+
+    //! Atomic variables of the indices of the queue of descriptors.
+    atomic_index_pair<>* descriptor_indices{nullptr};
+
+    //! Buffer of the queue of descriptors.
+    mutable_bytes_view descriptor_buffer{nullptr, 0U};
+
+    //! Atomic variables of the indices of the queue of returned chunks.
+    atomic_index_pair<>* return_indices{nullptr};
+
+    //! Buffer of the queue of returned chunks.
+    mutable_bytes_view return_buffer{nullptr, 0U};
+
+    //! Address of the first chunk.
+    char* chunks{nullptr};
+
+    //! Number of chunks.
+    shm_stream_size_t num_chunks{0U};
+
+    //! Size of each chunk.
+    shm_stream_size_t chunk_size{0U};
+
+    /*!
+     * \brief Get the pool of chunks.
+     *
+     * \return Pool of chunks.
+     */
+    [[nodiscard]] chunk_pool_view pool() const {
+        return chunk_pool_view(chunks, num_chunks, chunk_size);
+    }
+};
+
+/*!
+ * \brief Get the name of the shared memory of a stream of chunks.
+ *
+ * \param[in] stream_name Name of the stream.
+ * \return Name of the shared memory.
+ */
+[[nodiscard]] std::string chunk_stream_shm_name(string_view stream_name);
+
+/*!
+ * \brief Get the name of the mutex of a stream of chunks.
+ *
+ * \param[in] stream_name Name of the stream.
+ * \return Name of the mutex.
+ */
+[[nodiscard]] std::string chunk_stream_mutex_name(string_view stream_name);
+
+/*!
+ * \brief Create and initialize data of a stream of chunks.
+ *
+ * \param[in] name Name of the stream.
+ * \param[in] num_chunks Number of chunks.
+ * \param[in] chunk_size Size of each chunk.
+ * \return Data.
+ */
+[[nodiscard]] chunk_stream_data create_and_initialize_chunk_stream_data(
+    string_view name, shm_stream_size_t num_chunks,
+    shm_stream_size_t chunk_size);
+
+/*!
+ * \brief Prepare data of a stream of chunks.
+ *
+ * \param[in] name Name of the stream.
+ * \param[in] num_chunks Number of chunks.
+ * \param[in] chunk_size Size of each chunk.
+ * \return Data.
+ *
+ * \note If the stream already exists, the parameters of the existing stream
+ * are used.
+ */
+[[nodiscard]] chunk_stream_data prepare_chunk_stream_data(string_view name,
+    shm_stream_size_t num_chunks, shm_stream_size_t chunk_size);
+
+/*!
+ * \brief Remove a stream of chunks.
+ *
+ * \param[in] name Name of the stream.
+ */
+void remove_chunk_stream(string_view name);
+
+}  // namespace details
+}  // namespace shm_stream
@@ -0,0 +1,104 @@
+/*
+ * Copyright 2023 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Implementation of C interface of readers of streams passing
+ * descriptors of chunks in shared memory.
+ */
+#include "shm_stream/c_interface/chunk_stream_reader.h"
+
+#include <boost/interprocess/mapped_region.hpp>
+#include <boost/interprocess/shared_memory_object.hpp>
+
+#include "chunk_stream_internal.h"
+#include "shm_stream/c_interface/bytes_view.h"
+#include "shm_stream/c_interface/translate_error.h"
+#include "shm_stream/common_types.h"
+#include "shm_stream/details/chunk_queue.h"
+#include "shm_stream/string_view.h"
+
+/*!
+ * \brief Reader of streams of chunks.
+ */
+struct c_shm_stream_chunk_stream_reader {
+    //! Shared memory object.
+    boost::interprocess::shared_memory_object shared_memory;
+
+    //! Mapped region.
+    boost::interprocess::mapped_region mapped_region;
+
+    //! Reader.
+    shm_stream::details::chunk_queue_reader<> reader;
+
+    /*!
+     * \brief Constructor.
+     *
+     * \param[in] data Data.
+     */
+    explicit c_shm_stream_chunk_stream_reader(
+        shm_stream::details::chunk_stream_data&& data)
+        : shared_memory(std::move(data.shared_memory)),
+          mapped_region(std::move(data.mapped_region)),
+          reader(*data.descriptor_indices, data.descriptor_buffer,
+              *data.return_indices, data.return_buffer, data.pool()) {}
+
+    /*!
+     * \brief Constructor.
+     *
+     * \param[in] name Name of the stream.
+     * \param[in] num_chunks Number of chunks.
+     * \param[in] chunk_size Size of each chunk.
+     */
+    c_shm_stream_chunk_stream_reader(shm_stream::string_view name,
+        shm_stream::shm_stream_size_t num_chunks,
+        shm_stream::shm_stream_size_t chunk_size)
+        : c_shm_stream_chunk_stream_reader(
+              shm_stream::details::prepare_chunk_stream_data(
+                  name, num_chunks, chunk_size)) {}
+};
+
+c_shm_stream_error_code_t c_shm_stream_chunk_stream_reader_create(
+    c_shm_stream_chunk_stream_reader_t** reader,
+    c_shm_stream_string_view_t name, c_shm_stream_size_t num_chunks,
+    c_shm_stream_size_t chunk_size) {
+    C_SHM_STREAM_TRANSLATE_ERROR(
+        *reader = new c_shm_stream_chunk_stream_reader(
+            shm_stream::string_view{name.data, name.size}, num_chunks,
+            chunk_size));
+}
+
+void c_shm_stream_chunk_stream_reader_destroy(
+    c_shm_stream_chunk_stream_reader_t* reader) {
+    delete reader;
+}
+
+c_shm_stream_bytes_view_t c_shm_stream_chunk_stream_reader_try_receive(
+    c_shm_stream_chunk_stream_reader_t* reader) {
+    if (reader == nullptr) {
+        return c_shm_stream_bytes_view_t{nullptr, 0U};
+    }
+    const auto buf = reader->reader.try_receive();
+    return c_shm_stream_bytes_view_t{buf.data(), buf.size()};
+}
+
+void c_shm_stream_chunk_stream_reader_release(
+    c_shm_stream_chunk_stream_reader_t* reader,
+    c_shm_stream_bytes_view_t chunk) {
+    if (reader == nullptr || chunk.data == nullptr) {
+        return;
+    }
+    reader->reader.release(shm_stream::bytes_view(chunk.data, chunk.size));
+}
@@ -0,0 +1,106 @@
+/*
+ * Copyright 2023 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Implementation of doorbell class.
+ */
+#include "doorbell_internal.h"
+
+#include <cerrno>
+
+#include "shm_stream/c_interface/error_codes.h"
+#include "shm_stream/shm_stream_exception.h"
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+#endif
+
+namespace shm_stream {
+namespace details {
+
+#ifdef __linux__
+
+int create_doorbell_fd() {
+    const int fd = ::eventfd(0U, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (fd < 0) {
+        throw shm_stream_error(c_shm_stream_error_code_internal_error);
+    }
+    return fd;
+}
+
+void close_doorbell_fd(int fd) noexcept {
+    if (fd >= 0) {
+        ::close(fd);
+    }
+}
+
+doorbell::~doorbell() noexcept { close_doorbell_fd(fd_); }
+
+void doorbell::set_fd(int fd) {
+    int new_fd = -1;
+    if (fd >= 0) {
+        new_fd = ::fcntl(fd, F_DUPFD_CLOEXEC, 0);  // NOLINT
+        if (new_fd < 0) {
+            throw shm_stream_error(c_shm_stream_error_code_invalid_argument);
+        }
+    }
+    close_doorbell_fd(fd_);
+    fd_ = new_fd;
+}
+
+void doorbell::ring() noexcept {
+    const ::eventfd_t value = 1U;
+    // Failures are ignored, because the counter of the eventfd is not zero
+    // when the write would block.
+    while (::eventfd_write(fd_, value) != 0 && errno == EINTR) {
+    }
+}
+
+void doorbell::clear() noexcept {
+    if (fd_ < 0) {
+        return;
+    }
+    ::eventfd_t value = 0U;
+    while (::eventfd_read(fd_, &value) != 0 && errno == EINTR) {
+    }
+}
+
+#else
+
+int create_doorbell_fd() {
+    throw shm_stream_error(c_shm_stream_error_code_not_supported);
+}
+
+void close_doorbell_fd(int /*fd*/) noexcept {}
+
+doorbell::~doorbell() noexcept = default;
+
+void doorbell::set_fd(int fd) {
+    if (fd >= 0) {
+        throw shm_stream_error(c_shm_stream_error_code_not_supported);
+    }
+}
+
+void doorbell::ring() noexcept {}
+
+void doorbell::clear() noexcept {}
+
+#endif
+
+}  // namespace details
+}  // namespace shm_stream
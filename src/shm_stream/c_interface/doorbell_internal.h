@@ -0,0 +1,145 @@
+/*
+ * Copyright 2023 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Definition of doorbell class.
+ */
+#pragma once
+
+#include <cstdint>
+
+#include <boost/atomic/fences.hpp>
+#include <boost/atomic/ipc_atomic.hpp>
+#include <boost/memory_order.hpp>
+
+namespace shm_stream {
+namespace details {
+
+/*!
+ * \brief Create a file descriptor of a doorbell.
+ *
+ * \return File descriptor.
+ */
+[[nodiscard]] int create_doorbell_fd();
+
+/*!
+ * \brief Close a file descriptor of a doorbell.
+ *
+ * \param[in] fd File descriptor.
+ */
+void close_doorbell_fd(int fd) noexcept;
+
+/*!
+ * \brief Class of doorbells to notify readers of streams via file descriptors
+ * (eventfd on Linux).
+ *
+ * A reader arms the doorbell before waiting for the file descriptor to be
+ * readable, and the writer rings the doorbell on the next commit only when
+ * the doorbell is armed, so that the writer doesn't make system calls while
+ * the reader is busy.
+ */
+class doorbell {
+public:
+    /*!
+     * \brief Constructor.
+     *
+     * \param[in] armed Atomic variable of whether the doorbell is armed.
+     */
+    explicit doorbell(
+        boost::atomics::ipc_atomic<std::uint32_t>* armed) noexcept
+        : armed_(armed) {}
+
+    // Prevent copy.
+    doorbell(const doorbell&) = delete;
+    auto operator=(const doorbell&) = delete;
+
+    // Prevent move.
+    doorbell(doorbell&&) = delete;
+    auto operator=(doorbell&&) = delete;
+
+    /*!
+     * \brief Destructor.
+     */
+    ~doorbell() noexcept;
+
+    /*!
+     * \brief Set the file descriptor.
+     *
+     * \param[in] fd File descriptor. (Duplicated in this function. Negative
+     * value to remove the file descriptor.)
+     */
+    void set_fd(int fd);
+
+    /*!
+     * \brief Ring the doorbell if armed. (For writers.)
+     *
+     * \note Call this function after commits of writers.
+     */
+    void ring_if_armed() noexcept {
+        if (fd_ < 0) {
+            return;
+        }
+        // This fence is paired with the fence in arm function so that either
+        // the writer sees the armed doorbell or the reader sees the new index.
+        boost::atomics::atomic_thread_fence(boost::memory_order::seq_cst);
+        if (armed_->load(boost::memory_order::relaxed) != 0U &&
+            armed_->exchange(0U, boost::memory_order::relaxed) != 0U) {
+            ring();
+        }
+    }
+
+    /*!
+     * \brief Arm the doorbell. (For readers.)
+     *
+     * \note Check available bytes after calling this function, and call
+     * disarm function if some bytes are available.
+     */
+    void arm() noexcept {
+        clear();
+        armed_->store(1U, boost::memory_order::relaxed);
+        boost::atomics::atomic_thread_fence(boost::memory_order::seq_cst);
+    }
+
+    /*!
+     * \brief Disarm the doorbell. (For readers.)
+     */
+    void disarm() noexcept {
+        armed_->store(0U, boost::memory_order::relaxed);
+    }
+
+    /*!
+     * \brief Get the file descriptor.
+     *
+     * \return File descriptor. (Negative value if not set.)
+     */
+    [[nodiscard]] int fd() const noexcept { return fd_; }
+
+private:
+    //! Ring the doorbell.
+    void ring() noexcept;
+
+    //! Clear a notification of the doorbell.
+    void clear() noexcept;
+
+    //! Atomic variable of whether the doorbell is armed.
+    boost::atomics::ipc_atomic<std::uint32_t>* armed_;
+
+    //! File descriptor. (Negative value if not set.)
+    int fd_{-1};
+};
+
+}  // namespace details
+}  // namespace shm_stream
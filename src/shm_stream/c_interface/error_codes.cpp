@@ -29,6 +29,16 @@ const char* c_shm_stream_error_message(c_shm_stream_error_code_t code) {
         return "Failed to create or open a stream.";
     case c_shm_stream_error_code_internal_error:
         return "Internal error.";
+    case c_shm_stream_error_code_not_supported:
+        return "Operation not supported in the current environment.";
+    case c_shm_stream_error_code_too_many_readers:
+        return "Too many readers attached to a stream.";
+    case c_shm_stream_error_code_type_mismatch:
+        return "Mismatched type of elements in a stream.";
+    case c_shm_stream_error_code_failed_to_lock_memory:
+        return "Failed to lock memory.";
+    case c_shm_stream_error_code_failed_to_transfer:
+        return "Failed to transfer a handle of a stream to another process.";
     }
     return "Invalid error code.";
 }
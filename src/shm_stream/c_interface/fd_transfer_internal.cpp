@@ -0,0 +1,153 @@
+/*
+ * Copyright 2023 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Implementation of internal functions to transfer file descriptors
+ * between processes.
+ */
+#include "fd_transfer_internal.h"
+
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+
+#include "shm_stream/c_interface/error_codes.h"
+#include "shm_stream/shm_stream_exception.h"
+
+#ifdef __linux__
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <unistd.h>
+#endif
+
+namespace shm_stream {
+namespace details {
+
+#ifdef __linux__
+
+namespace {
+
+/*!
+ * \brief Close all file descriptors received in a message.
+ *
+ * \param[in] message Message.
+ */
+void close_received_fds(::msghdr& message) noexcept {
+    for (::cmsghdr* control_message = CMSG_FIRSTHDR(&message);
+         control_message != nullptr;
+         control_message = CMSG_NXTHDR(&message, control_message)) {
+        if (control_message->cmsg_level != SOL_SOCKET ||
+            control_message->cmsg_type != SCM_RIGHTS) {
+            continue;
+        }
+        const std::size_t num_fds =
+            (control_message->cmsg_len - CMSG_LEN(0)) / sizeof(int);
+        for (std::size_t i = 0U; i < num_fds; ++i) {
+            int fd = -1;
+            std::memcpy(&fd, CMSG_DATA(control_message) + i * sizeof(int),
+                sizeof(int));
+            ::close(fd);
+        }
+    }
+}
+
+}  // namespace
+
+void send_fd(int socket, int fd) {
+    if (fd < 0) {
+        throw shm_stream_error(c_shm_stream_error_code_invalid_argument);
+    }
+
+    // At least one byte of data must be sent together with the file
+    // descriptor.
+    char byte = 0;
+    ::iovec iov{};
+    iov.iov_base = &byte;
+    iov.iov_len = 1U;
+
+    alignas(::cmsghdr) char control[CMSG_SPACE(sizeof(int))] = {};
+    ::msghdr message{};
+    message.msg_iov = &iov;
+    message.msg_iovlen = 1U;
+    message.msg_control = control;
+    message.msg_controllen = sizeof(control);
+
+    ::cmsghdr* control_message = CMSG_FIRSTHDR(&message);
+    control_message->cmsg_level = SOL_SOCKET;
+    control_message->cmsg_type = SCM_RIGHTS;
+    control_message->cmsg_len = CMSG_LEN(sizeof(int));
+    std::memcpy(CMSG_DATA(control_message), &fd, sizeof(int));
+
+    ::ssize_t result = 0;
+    do {
+        result = ::sendmsg(socket, &message, MSG_NOSIGNAL);
+    } while (result < 0 && errno == EINTR);
+    if (result != 1) {
+        throw shm_stream_error(c_shm_stream_error_code_failed_to_transfer);
+    }
+}
+
+int receive_fd(int socket) {
+    char byte = 0;
+    ::iovec iov{};
+    iov.iov_base = &byte;
+    iov.iov_len = 1U;
+
+    alignas(::cmsghdr) char control[CMSG_SPACE(sizeof(int))] = {};
+    ::msghdr message{};
+    message.msg_iov = &iov;
+    message.msg_iovlen = 1U;
+    message.msg_control = control;
+    message.msg_controllen = sizeof(control);
+
+    ::ssize_t result = 0;
+    do {
+        result = ::recvmsg(socket, &message, MSG_CMSG_CLOEXEC);
+    } while (result < 0 && errno == EINTR);
+    if (result != 1) {
+        throw shm_stream_error(c_shm_stream_error_code_failed_to_transfer);
+    }
+
+    const ::cmsghdr* control_message = CMSG_FIRSTHDR(&message);
+    if (control_message == nullptr ||
+        control_message->cmsg_level != SOL_SOCKET ||
+        control_message->cmsg_type != SCM_RIGHTS ||
+        control_message->cmsg_len != CMSG_LEN(sizeof(int)) ||
+        (message.msg_flags & MSG_CTRUNC) != 0) {
+        // File descriptors are already installed in this process even when
+        // the message is rejected.
+        close_received_fds(message);
+        throw shm_stream_error(c_shm_stream_error_code_failed_to_transfer);
+    }
+    int fd = -1;
+    std::memcpy(&fd, CMSG_DATA(control_message), sizeof(int));
+    return fd;
+}
+
+#else
+
+void send_fd(int /*socket*/, int /*fd*/) {
+    throw shm_stream_error(c_shm_stream_error_code_not_supported);
+}
+
+int receive_fd(int /*socket*/) {
+    throw shm_stream_error(c_shm_stream_error_code_not_supported);
+}
+
+#endif
+
+}  // namespace details
+}  // namespace shm_stream
@@ -0,0 +1,43 @@
+/*
+ * Copyright 2023 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Definition of internal functions to transfer file descriptors
+ * between processes.
+ */
+#pragma once
+
+namespace shm_stream {
+namespace details {
+
+/*!
+ * \brief Send a file descriptor via a Unix domain socket.
+ *
+ * \param[in] socket Socket.
+ * \param[in] fd File descriptor.
+ */
+void send_fd(int socket, int fd);
+
+/*!
+ * \brief Receive a file descriptor via a Unix domain socket.
+ *
+ * \param[in] socket Socket.
+ * \return File descriptor.
+ */
+[[nodiscard]] int receive_fd(int socket);
+
+}  // namespace details
+}  // namespace shm_stream
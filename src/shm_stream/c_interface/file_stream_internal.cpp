@@ -0,0 +1,125 @@
+/*
+ * Copyright 2023 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Implementation of internal functions of file-backed streams of
+ * bytes.
+ */
+#include "file_stream_internal.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+#include <boost/interprocess/creation_tags.hpp>
+#include <boost/interprocess/detail/os_file_functions.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/sync/named_mutex.hpp>
+#include <fmt/format.h>
+
+#include "shm_stream/c_interface/error_codes.h"
+#include "shm_stream/shm_stream_exception.h"
+
+namespace shm_stream {
+namespace details {
+
+namespace {
+
+/*!
+ * \brief Create a file of a stream.
+ *
+ * \param[in] path Path of the file.
+ * \param[in] buffer_size Size of the buffer.
+ */
+void create_file(const std::string& path, shm_stream_size_t buffer_size) {
+    const auto handle = boost::interprocess::ipcdetail::create_new_file(
+        path.c_str(), boost::interprocess::read_write);
+    if (handle == boost::interprocess::ipcdetail::invalid_file()) {
+        throw shm_stream_error(c_shm_stream_error_code_failed_to_open);
+    }
+    const bool truncated = boost::interprocess::ipcdetail::truncate_file(
+        handle, mapped_stream_size(buffer_size));
+    boost::interprocess::ipcdetail::close_file(handle);
+    if (!truncated) {
+        boost::interprocess::ipcdetail::delete_file(path.c_str());
+        throw shm_stream_error(c_shm_stream_error_code_failed_to_open);
+    }
+}
+
+}  // namespace
+
+std::string file_stream_mutex_name(string_view path) {
+    // FNV-1a hash.
+    std::uint64_t hash = UINT64_C(0xcbf29ce484222325);
+    for (std::size_t i = 0; i < path.size(); ++i) {
+        hash ^= static_cast<unsigned char>(path.data()[i]);
+        hash *= UINT64_C(0x100000001b3);
+    }
+    return fmt::format("shm_stream_file_stream_lock_{:016x}", hash);
+}
+
+file_stream_data prepare_file_stream_data(
+    string_view path, shm_stream_size_t buffer_size) {
+    if (buffer_size == 0U) {
+        throw shm_stream_error(c_shm_stream_error_code_invalid_argument);
+    }
+
+    const std::string path_str{path.data(), path.size()};
+    file_stream_data data{};
+
+    boost::interprocess::named_mutex mutex{boost::interprocess::open_or_create,
+        file_stream_mutex_name(path).c_str()};
+    std::unique_lock<boost::interprocess::named_mutex> lock(mutex);
+
+    try {
+        const boost::interprocess::file_mapping file(
+            path_str.c_str(), boost::interprocess::read_write);
+        extract_stream_data_from_mapping(data, file);
+        return data;
+    } catch (const shm_stream_error&) {
+        throw;
+    } catch (...) {
+        // File doesn't exist, so create one.
+    }
+
+    create_file(path_str, buffer_size);
+    try {
+        const boost::interprocess::file_mapping file(
+            path_str.c_str(), boost::interprocess::read_write);
+        init_stream_data_from_mapping(data, file, buffer_size);
+    } catch (...) {
+        throw shm_stream_error(c_shm_stream_error_code_failed_to_open);
+    }
+    return data;
+}
+
+void remove_file_stream(string_view path) {
+    const std::string mutex_name = file_stream_mutex_name(path);
+    const std::string path_str{path.data(), path.size()};
+    {
+        boost::interprocess::named_mutex mutex{
+            boost::interprocess::open_or_create, mutex_name.c_str()};
+        {
+            std::unique_lock<boost::interprocess::named_mutex> lock(mutex);
+
+            boost::interprocess::file_mapping::remove(path_str.c_str());
+        }
+    }
+    boost::interprocess::named_mutex::remove(mutex_name.c_str());
+}
+
+}  // namespace details
+}  // namespace shm_stream
@@ -0,0 +1,67 @@
+/*
+ * Copyright 2023 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Definition of internal functions of file-backed streams of bytes.
+ */
+#pragma once
+
+#include <string>
+
+#include "atomic_stream_internal.h"
+#include "shm_stream/common_types.h"
+#include "shm_stream/string_view.h"
+
+namespace shm_stream {
+namespace details {
+
+/*!
+ * \brief Data of file-backed streams.
+ *
+ * \note shared_memory member is not used, because the mapping of the file is
+ * kept after the file object is destroyed.
+ */
+using file_stream_data = atomic_stream_data;
+
+/*!
+ * \brief Get the name of the mutex of a file-backed stream.
+ *
+ * \param[in] path Path of the file.
+ * \return Name of the mutex.
+ *
+ * \note Names of mutexes cannot contain paths, so a hash of the path is used.
+ */
+[[nodiscard]] std::string file_stream_mutex_name(string_view path);
+
+/*!
+ * \brief Prepare data of a file-backed stream.
+ *
+ * \param[in] path Path of the file.
+ * \param[in] buffer_size Size of the buffer.
+ * \return Data.
+ */
+[[nodiscard]] file_stream_data prepare_file_stream_data(
+    string_view path, shm_stream_size_t buffer_size);
+
+/*!
+ * \brief Remove a file-backed stream.
+ *
+ * \param[in] path Path of the file.
+ */
+void remove_file_stream(string_view path);
+
+}  // namespace details
+}  // namespace shm_stream
@@ -0,0 +1,111 @@
+/*
+ * Copyright 2023 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Implementation of C interface of file-backed streams of bytes.
+ */
+#include "shm_stream/c_interface/file_stream_reader.h"
+
+#include <boost/interprocess/mapped_region.hpp>
+
+#include "file_stream_internal.h"
+#include "shm_stream/c_interface/bytes_view.h"
+#include "shm_stream/c_interface/translate_error.h"
+#include "shm_stream/common_types.h"
+#include "shm_stream/details/light_bytes_queue.h"
+#include "shm_stream/string_view.h"
+
+/*!
+ * \brief Reader of file-backed streams of bytes.
+ */
+struct c_shm_stream_file_stream_reader {
+    //! Mapped region.
+    boost::interprocess::mapped_region mapped_region;
+
+    //! Reader.
+    shm_stream::details::light_bytes_queue_reader<> reader;
+
+    /*!
+     * \brief Constructor.
+     *
+     * \param[in] data Data.
+     */
+    explicit c_shm_stream_file_stream_reader(
+        shm_stream::details::file_stream_data&& data)
+        : mapped_region(std::move(data.mapped_region)),
+          reader(*data.atomic_indices, data.buffer, data.is_mirrored) {}
+
+    /*!
+     * \brief Constructor.
+     *
+     * \param[in] path Path of the file.
+     * \param[in] buffer_size Size of the buffer.
+     */
+    c_shm_stream_file_stream_reader(
+        shm_stream::string_view path, shm_stream::shm_stream_size_t buffer_size)
+        : c_shm_stream_file_stream_reader(
+              shm_stream::details::prepare_file_stream_data(
+                  path, buffer_size)) {}
+};
+
+c_shm_stream_error_code_t c_shm_stream_file_stream_reader_create(
+    c_shm_stream_file_stream_reader_t** reader,
+    c_shm_stream_string_view_t path, c_shm_stream_size_t buffer_size) {
+    C_SHM_STREAM_TRANSLATE_ERROR(*reader = new c_shm_stream_file_stream_reader(
+                                     shm_stream::string_view{
+                                         path.data, path.size},
+                                     buffer_size));
+}
+
+void c_shm_stream_file_stream_reader_destroy(
+    c_shm_stream_file_stream_reader_t* reader) {
+    delete reader;
+}
+
+c_shm_stream_size_t c_shm_stream_file_stream_reader_available_size(
+    c_shm_stream_file_stream_reader_t* reader) {
+    if (reader == nullptr) {
+        return 0U;
+    }
+    return reader->reader.available_size();
+}
+
+c_shm_stream_bytes_view_t c_shm_stream_file_stream_reader_try_reserve(
+    c_shm_stream_file_stream_reader_t* reader,
+    c_shm_stream_size_t expected_size) {
+    if (reader == nullptr) {
+        return c_shm_stream_bytes_view_t{nullptr, 0U};
+    }
+    const auto buf = reader->reader.try_reserve(expected_size);
+    return c_shm_stream_bytes_view_t{buf.data(), buf.size()};
+}
+
+c_shm_stream_bytes_view_t c_shm_stream_file_stream_reader_try_reserve_all(
+    c_shm_stream_file_stream_reader_t* reader) {
+    if (reader == nullptr) {
+        return c_shm_stream_bytes_view_t{nullptr, 0U};
+    }
+    const auto buf = reader->reader.try_reserve();
+    return c_shm_stream_bytes_view_t{buf.data(), buf.size()};
+}
+
+void c_shm_stream_file_stream_reader_commit(
+    c_shm_stream_file_stream_reader_t* reader, c_shm_stream_size_t read_size) {
+    if (reader == nullptr) {
+        return;
+    }
+    reader->reader.commit(read_size);
+}
@@ -0,0 +1,292 @@
+/*
+ * Copyright 2023 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Implementation of C interface of file-backed streams of bytes.
+ */
+#include "shm_stream/c_interface/file_stream_writer.h"
+
+#include <chrono>
+#include <cstddef>
+
+#include <boost/interprocess/mapped_region.hpp>
+
+#include "file_stream_internal.h"
+#include "shm_stream/c_interface/bytes_view.h"
+#include "shm_stream/c_interface/translate_error.h"
+#include "shm_stream/common_types.h"
+#include "shm_stream/details/light_bytes_queue.h"
+#include "shm_stream/flush_policy.h"
+#include "shm_stream/string_view.h"
+
+/*!
+ * \brief Writer of file-backed streams of bytes.
+ */
+struct c_shm_stream_file_stream_writer {
+    //! Mapped region.
+    boost::interprocess::mapped_region mapped_region;
+
+    //! Atomic variables of indices in the header of the mapped region.
+    const void* atomic_indices;
+
+    //! Size of the atomic variables of indices.
+    std::size_t atomic_indices_size;
+
+    //! Writer.
+    shm_stream::details::light_bytes_queue_writer<> writer;
+
+    //! Policy to flush.
+    shm_stream::flush_policy policy;
+
+    //! Time of the last flush.
+    std::chrono::steady_clock::time_point last_flush_time;
+
+    //! Number of flushes.
+    c_shm_stream_size_t flush_count{0U};
+
+    //! Beginning of the bytes reserved last.
+    const char* reserved_data{nullptr};
+
+    //! Whether some bytes have been committed after the last flush.
+    bool has_unflushed_commits{false};
+
+    /*!
+     * \brief Constructor.
+     *
+     * \param[in] data Data.
+     * \param[in] policy Policy to flush.
+     */
+    c_shm_stream_file_stream_writer(
+        shm_stream::details::file_stream_data&& data,
+        const shm_stream::flush_policy& policy)
+        : mapped_region(std::move(data.mapped_region)),
+          atomic_indices(data.atomic_indices),
+          atomic_indices_size(sizeof(*data.atomic_indices)),
+          writer(*data.atomic_indices, data.buffer, data.is_mirrored),
+          policy(policy),
+          last_flush_time(std::chrono::steady_clock::now()) {}
+
+    /*!
+     * \brief Constructor.
+     *
+     * \param[in] path Path of the file.
+     * \param[in] buffer_size Size of the buffer.
+     * \param[in] policy Policy to flush.
+     */
+    c_shm_stream_file_stream_writer(shm_stream::string_view path,
+        shm_stream::shm_stream_size_t buffer_size,
+        const shm_stream::flush_policy& policy)
+        : c_shm_stream_file_stream_writer(
+              shm_stream::details::prepare_file_stream_data(path, buffer_size),
+              policy) {}
+
+    // Prevent copy and move.
+    c_shm_stream_file_stream_writer(
+        const c_shm_stream_file_stream_writer&) = delete;
+    c_shm_stream_file_stream_writer(
+        c_shm_stream_file_stream_writer&&) = delete;
+    auto operator=(const c_shm_stream_file_stream_writer&) = delete;
+    auto operator=(c_shm_stream_file_stream_writer&&) = delete;
+
+    /*!
+     * \brief Destructor.
+     *
+     * \note Commits not flushed yet are flushed here unless the policy is
+     * flush_mode::none, so that an idle writer in flush_mode::periodic doesn't
+     * leave its last commits unflushed.
+     */
+    ~c_shm_stream_file_stream_writer() noexcept {
+        if (policy.mode() != shm_stream::flush_mode::none &&
+            has_unflushed_commits) {
+            (void)flush();
+        }
+    }
+
+    /*!
+     * \brief Flush the mapped region to the file.
+     *
+     * \return Whether the flush succeeded.
+     */
+    bool flush() {
+        // Whole mapping is flushed, because indices in the header are updated
+        // together with the buffer.
+        if (!mapped_region.flush(0, 0, false)) {
+            return false;
+        }
+        on_flushed();
+        return true;
+    }
+
+    /*!
+     * \brief Commit bytes and flush the mapped region to the file if the
+     * policy requires.
+     *
+     * \param[in] written_size Number of written bytes.
+     * \return Whether the flush succeeded or was not required.
+     *
+     * \note In flush_mode::on_commit, the committed bytes reach the file before
+     * the index pointing past them, so that a reader recovering the file after
+     * a power loss never finds an index pointing past bytes never written. In
+     * flush_mode::none and flush_mode::periodic, no such guarantee is given,
+     * because the operating system may write pages of the mapped region in
+     * any order.
+     */
+    bool commit(c_shm_stream_size_t written_size) {
+        if (policy.mode() == shm_stream::flush_mode::on_commit) {
+            return commit_and_flush(written_size);
+        }
+        writer.commit(written_size);
+        has_unflushed_commits = true;
+        // The interval is checked only here, so flushes are delayed until the
+        // next commit or the destruction of this object.
+        if (policy.mode() == shm_stream::flush_mode::periodic &&
+            std::chrono::steady_clock::now() - last_flush_time >=
+                policy.interval()) {
+            return flush();
+        }
+        return true;
+    }
+
+private:
+    /*!
+     * \brief Commit bytes flushing the bytes before the index.
+     *
+     * \param[in] written_size Number of written bytes.
+     * \return Whether the flushes succeeded.
+     */
+    bool commit_and_flush(c_shm_stream_size_t written_size) {
+        bool succeeded = true;
+        if (written_size > 0U && reserved_data != nullptr) {
+            succeeded = flush_range(reserved_data, written_size);
+        }
+        writer.commit(written_size);
+        reserved_data = nullptr;
+        has_unflushed_commits = true;
+        if (!succeeded) {
+            return false;
+        }
+        if (!flush_range(atomic_indices, atomic_indices_size)) {
+            return false;
+        }
+        on_flushed();
+        return true;
+    }
+
+    /*!
+     * \brief Flush pages containing a range of the mapped region to the file.
+     *
+     * \param[in] address Address of the beginning of the range.
+     * \param[in] size Size of the range.
+     * \return Whether the flush succeeded.
+     */
+    bool flush_range(const void* address, std::size_t size) {
+        // msync requires addresses aligned to pages, but mapped_region class
+        // doesn't align them.
+        const std::size_t offset = static_cast<std::size_t>(
+            static_cast<const char*>(address) -
+            static_cast<const char*>(mapped_region.get_address()));
+        const std::size_t page_size =
+            boost::interprocess::mapped_region::get_page_size();
+        const std::size_t aligned_offset = offset - offset % page_size;
+        return mapped_region.flush(
+            aligned_offset, size + (offset - aligned_offset), false);
+    }
+
+    /*!
+     * \brief Update the state after a flush.
+     */
+    void on_flushed() noexcept {
+        last_flush_time = std::chrono::steady_clock::now();
+        ++flush_count;
+        has_unflushed_commits = false;
+    }
+};
+
+c_shm_stream_error_code_t c_shm_stream_file_stream_writer_create(
+    c_shm_stream_file_stream_writer_t** writer,
+    c_shm_stream_string_view_t path, c_shm_stream_size_t buffer_size,
+    c_shm_stream_flush_policy_t policy) {
+    C_SHM_STREAM_TRANSLATE_ERROR(
+        *writer = new c_shm_stream_file_stream_writer(
+            shm_stream::string_view{path.data, path.size}, buffer_size,
+            shm_stream::flush_policy(policy)));
+}
+
+void c_shm_stream_file_stream_writer_destroy(
+    c_shm_stream_file_stream_writer_t* writer) {
+    delete writer;
+}
+
+c_shm_stream_size_t c_shm_stream_file_stream_writer_available_size(
+    c_shm_stream_file_stream_writer_t* writer) {
+    if (writer == nullptr) {
+        return 0U;
+    }
+    return writer->writer.available_size();
+}
+
+c_shm_stream_mutable_bytes_view_t c_shm_stream_file_stream_writer_try_reserve(
+    c_shm_stream_file_stream_writer_t* writer,
+    c_shm_stream_size_t expected_size) {
+    if (writer == nullptr) {
+        return c_shm_stream_mutable_bytes_view_t{nullptr, 0U};
+    }
+    const auto buf = writer->writer.try_reserve(expected_size);
+    writer->reserved_data = buf.data();
+    return c_shm_stream_mutable_bytes_view_t{buf.data(), buf.size()};
+}
+
+c_shm_stream_mutable_bytes_view_t
+c_shm_stream_file_stream_writer_try_reserve_all(
+    c_shm_stream_file_stream_writer_t* writer) {
+    if (writer == nullptr) {
+        return c_shm_stream_mutable_bytes_view_t{nullptr, 0U};
+    }
+    const auto buf = writer->writer.try_reserve();
+    writer->reserved_data = buf.data();
+    return c_shm_stream_mutable_bytes_view_t{buf.data(), buf.size()};
+}
+
+c_shm_stream_error_code_t c_shm_stream_file_stream_writer_commit(
+    c_shm_stream_file_stream_writer_t* writer,
+    c_shm_stream_size_t written_size) {
+    if (writer == nullptr) {
+        return c_shm_stream_error_code_invalid_argument;
+    }
+    if (!writer->commit(written_size)) {
+        return c_shm_stream_error_code_internal_error;
+    }
+    return c_shm_stream_error_code_success;
+}
+
+c_shm_stream_error_code_t c_shm_stream_file_stream_writer_flush(
+    c_shm_stream_file_stream_writer_t* writer) {
+    if (writer == nullptr) {
+        return c_shm_stream_error_code_invalid_argument;
+    }
+    if (!writer->flush()) {
+        return c_shm_stream_error_code_internal_error;
+    }
+    return c_shm_stream_error_code_success;
+}
+
+c_shm_stream_size_t c_shm_stream_file_stream_writer_flush_count(
+    c_shm_stream_file_stream_writer_t* writer) {
+    if (writer == nullptr) {
+        return 0U;
+    }
+    return writer->flush_count;
+}
@@ -32,61 +32,206 @@
 namespace shm_stream {
 namespace details {
 
-std::string light_stream_shm_name(string_view stream_name) {
-    return fmt::format("shm_stream_light_stream_data_{}", stream_name);
-}
+namespace {
 
-std::string light_stream_mutex_name(string_view stream_name) {
-    return fmt::format("shm_stream_light_stream_lock_{}", stream_name);
-}
+/*!
+ * \brief Create and initialize data of a light stream.
+ *
+ * \tparam SizeType Type of sizes and indices.
+ * \param[in] shm_name Name of the shared memory.
+ * \param[in] buffer_size Size of the buffer.
+ * \param[in] layout Layout of the buffer.
+ * \param[in] element_type Type of elements.
+ * \param[in] options Options of memory.
+ * \param[in] numa_node NUMA node to bind pages to.
+ * \return Data.
+ */
+template <typename SizeType>
+[[nodiscard]] basic_atomic_stream_data<SizeType> create_and_initialize_data(
+    const std::string& shm_name, SizeType buffer_size, buffer_layout layout,
+    const stream_element_type& element_type = stream_element_type(),
+    memory_options options = memory_options::none,
+    numa_node_t numa_node = numa_node_none) {
+    check_buffer_layout(buffer_size, layout);
 
-light_stream_data create_and_initialize_light_stream_data(
-    string_view name, shm_stream_size_t buffer_size) {
-    light_stream_data data{};
-    const std::string data_shm_name = light_stream_shm_name(name);
+    basic_atomic_stream_data<SizeType> data{};
 
     try {
         data.shared_memory = boost::interprocess::shared_memory_object(
-            boost::interprocess::create_only, data_shm_name.c_str(),
+            boost::interprocess::create_only, shm_name.c_str(),
             boost::interprocess::read_write);
     } catch (...) {
         throw shm_stream_error(c_shm_stream_error_code_failed_to_open);
     }
 
-    init_stream_data_from_shared_memory(data, buffer_size);
+    init_stream_data_from_shared_memory(
+        data, buffer_size, layout, element_type, options, numa_node);
 
     return data;
 }
 
-light_stream_data prepare_light_stream_data(
-    string_view name, shm_stream_size_t buffer_size) {
-    light_stream_data data{};
+/*!
+ * \brief Prepare data of a light stream.
+ *
+ * \tparam SizeType Type of sizes and indices.
+ * \param[in] shm_name Name of the shared memory.
+ * \param[in] mutex_name Name of the mutex.
+ * \param[in] buffer_size Size of the buffer.
+ * \param[in] layout Layout of the buffer.
+ * \param[in] element_type Type of elements.
+ * \param[in] options Options of memory.
+ * \param[in] numa_node NUMA node to bind pages to.
+ * \return Data.
+ */
+template <typename SizeType>
+[[nodiscard]] basic_atomic_stream_data<SizeType> prepare_data(
+    const std::string& shm_name, const std::string& mutex_name,
+    SizeType buffer_size, buffer_layout layout,
+    const stream_element_type& element_type = stream_element_type(),
+    memory_options options = memory_options::none,
+    numa_node_t numa_node = numa_node_none) {
+    basic_atomic_stream_data<SizeType> data{};
 
-    const std::string data_shm_name = light_stream_shm_name(name);
-    const std::string mutex_name = light_stream_mutex_name(name);
     boost::interprocess::named_mutex mutex{
         boost::interprocess::open_or_create, mutex_name.c_str()};
     std::unique_lock<boost::interprocess::named_mutex> lock(mutex);
 
     try {
         data.shared_memory = boost::interprocess::shared_memory_object(
-            boost::interprocess::open_only, data_shm_name.c_str(),
+            boost::interprocess::open_only, shm_name.c_str(),
             boost::interprocess::read_write);
     } catch (...) {
         // Shared memory doesn't exist, so create one.
-        return create_and_initialize_light_stream_data(name, buffer_size);
+        return create_and_initialize_data(
+            shm_name, buffer_size, layout, element_type, options, numa_node);
     }
 
-    extract_stream_data_from_shared_memory(data);
+    extract_stream_data_from_shared_memory(data, options);
+    check_element_type(data, element_type);
 
     return data;
 }
 
+}  // namespace
+
+std::string light_stream_shm_name(string_view stream_name) {
+    return fmt::format("shm_stream_light_stream_data_{}", stream_name);
+}
+
+std::string light_stream_mutex_name(string_view stream_name) {
+    return fmt::format("shm_stream_light_stream_lock_{}", stream_name);
+}
+
+light_stream_data create_and_initialize_light_stream_data(string_view name,
+    shm_stream_size_t buffer_size, buffer_layout layout,
+    const stream_element_type& element_type) {
+    return create_and_initialize_data(
+        light_stream_shm_name(name), buffer_size, layout, element_type);
+}
+
+light_stream_data prepare_light_stream_data(string_view name,
+    shm_stream_size_t buffer_size, buffer_layout layout,
+    const stream_element_type& element_type, memory_options options,
+    numa_node_t numa_node) {
+    return prepare_data(light_stream_shm_name(name),
+        light_stream_mutex_name(name), buffer_size, layout, element_type,
+        options, numa_node);
+}
+
+c_shm_stream_light_stream_queue_layout_t light_stream_queue_layout(
+    const light_stream_data& data) noexcept {
+    c_shm_stream_light_stream_queue_layout_t layout{};
+    layout.atomic_indices = data.atomic_indices;
+    layout.buffer = data.buffer.data();
+    layout.buffer_size = data.buffer.size();
+    layout.is_mirrored = data.is_mirrored;
+    layout.doorbell_armed = data.doorbell_armed;
+    return layout;
+}
+
 void remove_light_stream(string_view name) {
     const std::string mutex_name = details::light_stream_mutex_name(name);
     const std::string shm_name = light_stream_shm_name(name);
     remove_atomic_stream(mutex_name, shm_name);
 }
 
+std::string light_stream64_shm_name(string_view stream_name) {
+    return fmt::format("shm_stream_light_stream64_data_{}", stream_name);
+}
+
+std::string light_stream64_mutex_name(string_view stream_name) {
+    return fmt::format("shm_stream_light_stream64_lock_{}", stream_name);
+}
+
+light_stream64_data create_and_initialize_light_stream64_data(
+    string_view name, shm_stream_size64_t buffer_size, buffer_layout layout) {
+    return create_and_initialize_data(
+        light_stream64_shm_name(name), buffer_size, layout);
+}
+
+light_stream64_data prepare_light_stream64_data(
+    string_view name, shm_stream_size64_t buffer_size, buffer_layout layout) {
+    return prepare_data(light_stream64_shm_name(name),
+        light_stream64_mutex_name(name), buffer_size, layout);
+}
+
+void remove_light_stream64(string_view name) {
+    const std::string mutex_name = light_stream64_mutex_name(name);
+    const std::string shm_name = light_stream64_shm_name(name);
+    remove_atomic_stream(mutex_name, shm_name);
+}
+
+std::string light_message_stream_shm_name(string_view stream_name) {
+    return fmt::format("shm_stream_light_message_stream_data_{}", stream_name);
+}
+
+std::string light_message_stream_mutex_name(string_view stream_name) {
+    return fmt::format("shm_stream_light_message_stream_lock_{}", stream_name);
+}
+
+light_stream_data create_and_initialize_light_message_stream_data(
+    string_view name, shm_stream_size_t buffer_size, buffer_layout layout) {
+    return create_and_initialize_data(
+        light_message_stream_shm_name(name), buffer_size, layout);
+}
+
+light_stream_data prepare_light_message_stream_data(
+    string_view name, shm_stream_size_t buffer_size, buffer_layout layout) {
+    return prepare_data(light_message_stream_shm_name(name),
+        light_message_stream_mutex_name(name), buffer_size, layout);
+}
+
+void remove_light_message_stream(string_view name) {
+    const std::string mutex_name = light_message_stream_mutex_name(name);
+    const std::string shm_name = light_message_stream_shm_name(name);
+    remove_atomic_stream(mutex_name, shm_name);
+}
+
+std::string mpsc_stream_shm_name(string_view stream_name) {
+    return fmt::format("shm_stream_mpsc_stream_data_{}", stream_name);
+}
+
+std::string mpsc_stream_mutex_name(string_view stream_name) {
+    return fmt::format("shm_stream_mpsc_stream_lock_{}", stream_name);
+}
+
+light_stream_data create_and_initialize_mpsc_stream_data(
+    string_view name, shm_stream_size_t buffer_size) {
+    return create_and_initialize_data(
+        mpsc_stream_shm_name(name), buffer_size, buffer_layout::plain);
+}
+
+light_stream_data prepare_mpsc_stream_data(
+    string_view name, shm_stream_size_t buffer_size) {
+    return prepare_data(mpsc_stream_shm_name(name),
+        mpsc_stream_mutex_name(name), buffer_size, buffer_layout::plain);
+}
+
+void remove_mpsc_stream(string_view name) {
+    const std::string mutex_name = mpsc_stream_mutex_name(name);
+    const std::string shm_name = mpsc_stream_shm_name(name);
+    remove_atomic_stream(mutex_name, shm_name);
+}
+
 }  // namespace details
 }  // namespace shm_stream
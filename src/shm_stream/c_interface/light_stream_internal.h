@@ -28,6 +28,7 @@
 
 #include "atomic_stream_internal.h"
 #include "shm_stream/bytes_view.h"
+#include "shm_stream/c_interface/light_stream_common.h"
 #include "shm_stream/common_types.h"
 #include "shm_stream/details/atomic_index_pair.h"
 #include "shm_stream/details/cache_line_size.h"
@@ -62,20 +63,43 @@ using light_stream_data = atomic_stream_data;
  *
  * \param[in] name Name of the stream.
  * \param[in] buffer_size Size of the buffer.
+ * \param[in] layout Layout of the buffer.
+ * \param[in] element_type Type of elements.
  * \return Data.
  */
 [[nodiscard]] light_stream_data create_and_initialize_light_stream_data(
-    string_view name, shm_stream_size_t buffer_size);
+    string_view name, shm_stream_size_t buffer_size,
+    buffer_layout layout = buffer_layout::plain,
+    const stream_element_type& element_type = stream_element_type());
 
 /*!
  * \brief Prepare data of a light stream.
  *
  * \param[in] name Name of the stream.
  * \param[in] buffer_size Size of the buffer.
+ * \param[in] layout Layout of the buffer.
+ * \param[in] element_type Type of elements. (Fingerprint of zero to accept
+ * any type in existing streams.)
+ * \param[in] options Options of memory.
+ * \param[in] numa_node NUMA node to bind pages to when the stream is created.
+ * (numa_node_none for the usual placement of pages.)
  * \return Data.
  */
 [[nodiscard]] light_stream_data prepare_light_stream_data(
-    string_view name, shm_stream_size_t buffer_size);
+    string_view name, shm_stream_size_t buffer_size,
+    buffer_layout layout = buffer_layout::plain,
+    const stream_element_type& element_type = stream_element_type(),
+    memory_options options = memory_options::none,
+    numa_node_t numa_node = numa_node_none);
+
+/*!
+ * \brief Get the layout of the queue of a light stream.
+ *
+ * \param[in] data Data of the stream.
+ * \return Layout of the queue.
+ */
+[[nodiscard]] c_shm_stream_light_stream_queue_layout_t
+light_stream_queue_layout(const light_stream_data& data) noexcept;
 
 /*!
  * \brief Remove a light stream.
@@ -84,5 +108,151 @@ using light_stream_data = atomic_stream_data;
  */
 void remove_light_stream(string_view name);
 
+/*!
+ * \brief Data of light streams with 64-bit indices.
+ */
+using light_stream64_data = atomic_stream64_data;
+
+/*!
+ * \brief Get the name of the shared memory of a light stream with 64-bit
+ * indices.
+ *
+ * \param[in] stream_name Name of the stream.
+ * \return Name of the shared memory.
+ */
+[[nodiscard]] std::string light_stream64_shm_name(string_view stream_name);
+
+/*!
+ * \brief Get the name of the mutex of a light stream with 64-bit indices.
+ *
+ * \param[in] stream_name Name of the stream.
+ * \return Name of the mutex.
+ */
+[[nodiscard]] std::string light_stream64_mutex_name(string_view stream_name);
+
+/*!
+ * \brief Create and initialize data of a light stream with 64-bit indices.
+ *
+ * \param[in] name Name of the stream.
+ * \param[in] buffer_size Size of the buffer.
+ * \param[in] layout Layout of the buffer.
+ * \return Data.
+ */
+[[nodiscard]] light_stream64_data create_and_initialize_light_stream64_data(
+    string_view name, shm_stream_size64_t buffer_size,
+    buffer_layout layout = buffer_layout::plain);
+
+/*!
+ * \brief Prepare data of a light stream with 64-bit indices.
+ *
+ * \param[in] name Name of the stream.
+ * \param[in] buffer_size Size of the buffer.
+ * \param[in] layout Layout of the buffer.
+ * \return Data.
+ */
+[[nodiscard]] light_stream64_data prepare_light_stream64_data(
+    string_view name, shm_stream_size64_t buffer_size,
+    buffer_layout layout = buffer_layout::plain);
+
+/*!
+ * \brief Remove a light stream with 64-bit indices.
+ *
+ * \param[in] name Name of the stream.
+ */
+void remove_light_stream64(string_view name);
+
+/*!
+ * \brief Get the name of the shared memory of a light stream of messages.
+ *
+ * \param[in] stream_name Name of the stream.
+ * \return Name of the shared memory.
+ */
+[[nodiscard]] std::string light_message_stream_shm_name(
+    string_view stream_name);
+
+/*!
+ * \brief Get the name of the mutex of a light stream of messages.
+ *
+ * \param[in] stream_name Name of the stream.
+ * \return Name of the mutex.
+ */
+[[nodiscard]] std::string light_message_stream_mutex_name(
+    string_view stream_name);
+
+/*!
+ * \brief Create and initialize data of a light stream of messages.
+ *
+ * \param[in] name Name of the stream.
+ * \param[in] buffer_size Size of the buffer.
+ * \param[in] layout Layout of the buffer.
+ * \return Data.
+ */
+[[nodiscard]] light_stream_data
+create_and_initialize_light_message_stream_data(string_view name,
+    shm_stream_size_t buffer_size, buffer_layout layout = buffer_layout::plain);
+
+/*!
+ * \brief Prepare data of a light stream of messages.
+ *
+ * \param[in] name Name of the stream.
+ * \param[in] buffer_size Size of the buffer.
+ * \param[in] layout Layout of the buffer.
+ * \return Data.
+ */
+[[nodiscard]] light_stream_data prepare_light_message_stream_data(
+    string_view name, shm_stream_size_t buffer_size,
+    buffer_layout layout = buffer_layout::plain);
+
+/*!
+ * \brief Remove a light stream of messages.
+ *
+ * \param[in] name Name of the stream.
+ */
+void remove_light_message_stream(string_view name);
+
+/*!
+ * \brief Get the name of the shared memory of a MPSC stream, i.e., a stream of
+ * messages with multiple writers and a single reader.
+ *
+ * \param[in] stream_name Name of the stream.
+ * \return Name of the shared memory.
+ */
+[[nodiscard]] std::string mpsc_stream_shm_name(string_view stream_name);
+
+/*!
+ * \brief Get the name of the mutex of a MPSC stream.
+ *
+ * \param[in] stream_name Name of the stream.
+ * \return Name of the mutex.
+ */
+[[nodiscard]] std::string mpsc_stream_mutex_name(string_view stream_name);
+
+/*!
+ * \brief Create and initialize data of a MPSC stream.
+ *
+ * \param[in] name Name of the stream.
+ * \param[in] buffer_size Size of the buffer.
+ * \return Data.
+ */
+[[nodiscard]] light_stream_data create_and_initialize_mpsc_stream_data(
+    string_view name, shm_stream_size_t buffer_size);
+
+/*!
+ * \brief Prepare data of a MPSC stream.
+ *
+ * \param[in] name Name of the stream.
+ * \param[in] buffer_size Size of the buffer.
+ * \return Data.
+ */
+[[nodiscard]] light_stream_data prepare_mpsc_stream_data(
+    string_view name, shm_stream_size_t buffer_size);
+
+/*!
+ * \brief Remove a MPSC stream.
+ *
+ * \param[in] name Name of the stream.
+ */
+void remove_mpsc_stream(string_view name);
+
 }  // namespace details
 }  // namespace shm_stream
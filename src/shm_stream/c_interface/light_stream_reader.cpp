@@ -20,9 +20,12 @@
  */
 #include "shm_stream/c_interface/light_stream_reader.h"
 
+#include <cstring>
+
 #include <boost/interprocess/mapped_region.hpp>
 #include <boost/interprocess/shared_memory_object.hpp>
 
+#include "doorbell_internal.h"
 #include "light_stream_internal.h"
 #include "shm_stream/c_interface/bytes_view.h"
 #include "shm_stream/c_interface/translate_error.h"
@@ -41,9 +44,18 @@ struct c_shm_stream_light_stream_reader {
     //! Mapped region.
     boost::interprocess::mapped_region mapped_region;
 
+    //! Mapped region with the buffer mirrored.
+    shm_stream::details::mirrored_region mirrored_region;
+
     //! Reader.
     shm_stream::details::light_bytes_queue_reader<> reader;
 
+    //! Doorbell.
+    shm_stream::details::doorbell doorbell;
+
+    //! Layout of the queue.
+    c_shm_stream_light_stream_queue_layout_t queue_layout;
+
     /*!
      * \brief Constructor.
      *
@@ -53,19 +65,28 @@ struct c_shm_stream_light_stream_reader {
         shm_stream::details::light_stream_data&& data)
         : shared_memory(std::move(data.shared_memory)),
           mapped_region(std::move(data.mapped_region)),
-          reader(*data.atomic_indices, data.buffer) {}
+          mirrored_region(std::move(data.mirrored_region)),
+          reader(*data.atomic_indices, data.buffer, data.is_mirrored),
+          doorbell(data.doorbell_armed),
+          queue_layout(shm_stream::details::light_stream_queue_layout(data)) {}
 
     /*!
      * \brief Constructor.
      *
      * \param[in] name Name of the stream.
      * \param[in] buffer_size Size of the buffer.
+     * \param[in] element_type Type of elements.
+     * \param[in] options Options of memory.
      */
-    c_shm_stream_light_stream_reader(
-        shm_stream::string_view name, shm_stream::shm_stream_size_t buffer_size)
+    c_shm_stream_light_stream_reader(shm_stream::string_view name,
+        shm_stream::shm_stream_size_t buffer_size,
+        const shm_stream::details::stream_element_type& element_type =
+            shm_stream::details::stream_element_type(),
+        shm_stream::memory_options options = shm_stream::memory_options::none)
         : c_shm_stream_light_stream_reader(
-              shm_stream::details::prepare_light_stream_data(
-                  name, buffer_size)) {}
+              shm_stream::details::prepare_light_stream_data(name,
+                  buffer_size, shm_stream::buffer_layout::plain,
+                  element_type, options)) {}
 };
 
 c_shm_stream_error_code_t c_shm_stream_light_stream_reader_create(
@@ -77,6 +98,29 @@ c_shm_stream_error_code_t c_shm_stream_light_stream_reader_create(
                                      buffer_size));
 }
 
+c_shm_stream_error_code_t c_shm_stream_light_stream_reader_create_typed(
+    c_shm_stream_light_stream_reader_t** reader,
+    c_shm_stream_string_view_t name, c_shm_stream_size_t buffer_size,
+    c_shm_stream_size64_t element_type, c_shm_stream_size_t element_size) {
+    C_SHM_STREAM_TRANSLATE_ERROR(
+        *reader = new c_shm_stream_light_stream_reader(
+            shm_stream::string_view{name.data, name.size}, buffer_size,
+            shm_stream::details::stream_element_type{
+                element_type, element_size}));
+}
+
+c_shm_stream_error_code_t
+c_shm_stream_light_stream_reader_create_with_memory_options(
+    c_shm_stream_light_stream_reader_t** reader,
+    c_shm_stream_string_view_t name, c_shm_stream_size_t buffer_size,
+    c_shm_stream_memory_options_t options) {
+    C_SHM_STREAM_TRANSLATE_ERROR(
+        *reader = new c_shm_stream_light_stream_reader(
+            shm_stream::string_view{name.data, name.size}, buffer_size,
+            shm_stream::details::stream_element_type(),
+            static_cast<shm_stream::memory_options>(options)));
+}
+
 void c_shm_stream_light_stream_reader_destroy(
     c_shm_stream_light_stream_reader_t* reader) {
     delete reader;
@@ -90,6 +134,25 @@ c_shm_stream_size_t c_shm_stream_light_stream_reader_available_size(
     return reader->reader.available_size();
 }
 
+c_shm_stream_size_t c_shm_stream_light_stream_reader_page_size(
+    c_shm_stream_light_stream_reader_t* reader) {
+    if (reader == nullptr) {
+        return 0U;
+    }
+    return static_cast<c_shm_stream_size_t>(
+        shm_stream::details::effective_page_size(
+            reader->mapped_region, reader->mirrored_region));
+}
+
+c_shm_stream_numa_node_t c_shm_stream_light_stream_reader_numa_node(
+    c_shm_stream_light_stream_reader_t* reader) {
+    if (reader == nullptr) {
+        return c_shm_stream_numa_node_none;
+    }
+    return shm_stream::details::numa_node_of(
+        reader->mapped_region, reader->mirrored_region);
+}
+
 c_shm_stream_bytes_view_t c_shm_stream_light_stream_reader_try_reserve(
     c_shm_stream_light_stream_reader_t* reader,
     c_shm_stream_size_t expected_size) {
@@ -116,3 +179,64 @@ void c_shm_stream_light_stream_reader_commit(
     }
     reader->reader.commit(read_size);
 }
+
+bool c_shm_stream_light_stream_reader_try_read_scatter(
+    c_shm_stream_light_stream_reader_t* reader,
+    const c_shm_stream_mutable_bytes_view_t* pieces,
+    c_shm_stream_size_t num_pieces) {
+    if (reader == nullptr) {
+        return false;
+    }
+    return reader->reader.try_read_scatter(pieces, num_pieces);
+}
+
+bool c_shm_stream_light_stream_reader_try_read_exact(
+    c_shm_stream_light_stream_reader_t* reader,
+    c_shm_stream_mutable_bytes_view_t buffer) {
+    if (reader == nullptr || reader->reader.available_size() < buffer.size) {
+        return false;
+    }
+    char* destination = buffer.data;
+    shm_stream::shm_stream_size_t remaining = buffer.size;
+    while (remaining > 0U) {
+        const auto reserved = reader->reader.try_reserve(remaining);
+        // Non-temporal stores are not used, because the caller reads the
+        // bytes soon after this function.
+        std::memcpy(destination, reserved.data(), reserved.size());
+        reader->reader.commit(reserved.size());
+        destination += reserved.size();
+        remaining -= reserved.size();
+    }
+    return true;
+}
+
+c_shm_stream_error_code_t c_shm_stream_light_stream_reader_set_doorbell(
+    c_shm_stream_light_stream_reader_t* reader, int fd) {
+    if (reader == nullptr) {
+        return c_shm_stream_error_code_invalid_argument;
+    }
+    C_SHM_STREAM_TRANSLATE_ERROR(reader->doorbell.set_fd(fd));
+}
+
+bool c_shm_stream_light_stream_reader_arm_doorbell(
+    c_shm_stream_light_stream_reader_t* reader) {
+    if (reader == nullptr || reader->doorbell.fd() < 0) {
+        return false;
+    }
+    reader->doorbell.arm();
+    if (reader->reader.available_size() > 0U) {
+        reader->doorbell.disarm();
+        return false;
+    }
+    return true;
+}
+
+c_shm_stream_error_code_t c_shm_stream_light_stream_reader_queue_layout(
+    c_shm_stream_light_stream_reader_t* reader,
+    c_shm_stream_light_stream_queue_layout_t* layout) {
+    if (reader == nullptr || layout == nullptr) {
+        return c_shm_stream_error_code_invalid_argument;
+    }
+    *layout = reader->queue_layout;
+    return c_shm_stream_error_code_success;
+}
@@ -0,0 +1,150 @@
+/*
+ * Copyright 2023 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Implementation of internal functions of lossy streams of messages.
+ */
+#include "lossy_stream_internal.h"
+
+#include <mutex>
+#include <new>
+
+#include <boost/interprocess/creation_tags.hpp>
+#include <boost/interprocess/sync/named_mutex.hpp>
+#include <fmt/format.h>
+
+#include "atomic_stream_internal.h"
+#include "shm_stream/c_interface/error_codes.h"
+#include "shm_stream/details/cache_line_size.h"
+#include "shm_stream/details/lossy_message_queue.h"
+#include "shm_stream/shm_stream_exception.h"
+
+namespace shm_stream {
+namespace details {
+
+/*!
+ * \brief Header of the data shared in lossy streams.
+ */
+struct lossy_stream_header {
+    //! Atomic variable of the sequence number of the next message.
+    alignas(cache_line_size())
+        boost::atomics::ipc_atomic<shm_stream_size64_t> next_sequence{0U};
+
+    //! Number of records.
+    alignas(cache_line_size()) shm_stream_size_t num_records{};
+
+    //! Maximum size of messages.
+    shm_stream_size_t max_message_size{};
+};
+
+namespace {
+
+/*!
+ * \brief Set pointers in data of lossy streams from the header.
+ *
+ * \param[in,out] data Data.
+ * \param[in] header Header.
+ */
+void set_lossy_stream_data_from_header(
+    lossy_stream_data& data, lossy_stream_header* header) {
+    data.next_sequence = &header->next_sequence;
+    data.buffer = mutable_bytes_view(
+        static_cast<char*>(static_cast<void*>(header)) +
+            sizeof(lossy_stream_header),
+        lossy_message_queue_base<>::buffer_size(
+            header->num_records, header->max_message_size));
+    data.max_message_size = header->max_message_size;
+}
+
+}  // namespace
+
+std::string lossy_stream_shm_name(string_view stream_name) {
+    return fmt::format("shm_stream_lossy_stream_data_{}", stream_name);
+}
+
+std::string lossy_stream_mutex_name(string_view stream_name) {
+    return fmt::format("shm_stream_lossy_stream_lock_{}", stream_name);
+}
+
+lossy_stream_data create_and_initialize_lossy_stream_data(string_view name,
+    shm_stream_size_t num_records, shm_stream_size_t max_message_size) {
+    const std::string shm_name = lossy_stream_shm_name(name);
+    const shm_stream_size_t buffer_size =
+        lossy_message_queue_base<>::buffer_size(num_records, max_message_size);
+
+    lossy_stream_data data{};
+
+    try {
+        data.shared_memory = boost::interprocess::shared_memory_object(
+            boost::interprocess::create_only, shm_name.c_str(),
+            boost::interprocess::read_write);
+    } catch (...) {
+        throw shm_stream_error(c_shm_stream_error_code_failed_to_open);
+    }
+
+    const boost::interprocess::offset_t data_size =
+        static_cast<boost::interprocess::offset_t>(
+            sizeof(lossy_stream_header)) +
+        static_cast<boost::interprocess::offset_t>(buffer_size);
+    data.shared_memory.truncate(data_size);
+    data.mapped_region = boost::interprocess::mapped_region(
+        data.shared_memory, boost::interprocess::read_write);
+
+    auto* header = new (data.mapped_region.get_address()) lossy_stream_header();
+    header->num_records = num_records;
+    header->max_message_size = max_message_size;
+    set_lossy_stream_data_from_header(data, header);
+
+    return data;
+}
+
+lossy_stream_data prepare_lossy_stream_data(string_view name,
+    shm_stream_size_t num_records, shm_stream_size_t max_message_size) {
+    const std::string shm_name = lossy_stream_shm_name(name);
+    const std::string mutex_name = lossy_stream_mutex_name(name);
+
+    lossy_stream_data data{};
+
+    boost::interprocess::named_mutex mutex{
+        boost::interprocess::open_or_create, mutex_name.c_str()};
+    std::unique_lock<boost::interprocess::named_mutex> lock(mutex);
+
+    try {
+        data.shared_memory = boost::interprocess::shared_memory_object(
+            boost::interprocess::open_only, shm_name.c_str(),
+            boost::interprocess::read_write);
+    } catch (...) {
+        // Shared memory doesn't exist, so create one.
+        return create_and_initialize_lossy_stream_data(
+            name, num_records, max_message_size);
+    }
+
+    data.mapped_region = boost::interprocess::mapped_region(
+        data.shared_memory, boost::interprocess::read_write);
+    set_lossy_stream_data_from_header(data,
+        static_cast<lossy_stream_header*>(data.mapped_region.get_address()));
+
+    return data;
+}
+
+void remove_lossy_stream(string_view name) {
+    const std::string mutex_name = lossy_stream_mutex_name(name);
+    const std::string shm_name = lossy_stream_shm_name(name);
+    remove_atomic_stream(mutex_name, shm_name);
+}
+
+}  // namespace details
+}  // namespace shm_stream
@@ -0,0 +1,105 @@
+/*
+ * Copyright 2023 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Definition of internal functions of lossy streams of messages.
+ */
+#pragma once
+
+#include <string>
+
+#include <boost/atomic/ipc_atomic.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <boost/interprocess/shared_memory_object.hpp>
+
+#include "shm_stream/bytes_view.h"
+#include "shm_stream/common_types.h"
+#include "shm_stream/string_view.h"
+
+namespace shm_stream {
+namespace details {
+
+/*!
+ * \brief Data of lossy streams.
+ */
+struct lossy_stream_data {
+    //! Shared memory object.
+    boost::interprocess::shared_memory_object shared_memory{};
+
+    //! Mapped region.
+    boost::interprocess::mapped_region mapped_region{};
+
+    //! Atomic variable of the sequence number of the next message.
+    boost::atomics::ipc_atomic<shm_stream_size64_t>* next_sequence{nullptr};
+
+    //! Buffer of data.
+    mutable_bytes_view buffer{nullptr, 0U};
+
+    //! Maximum size of messages.
+    shm_stream_size_t max_message_size{0U};
+};
+
+/*!
+ * \brief Get the name of the shared memory of a lossy stream.
+ *
+ * \param[in] stream_name Name of the stream.
+ * \return Name of the shared memory.
+ */
+[[nodiscard]] std::string lossy_stream_shm_name(string_view stream_name);
+
+/*!
+ * \brief Get the name of the mutex of a lossy stream.
+ *
+ * \param[in] stream_name Name of the stream.
+ * \return Name of the mutex.
+ */
+[[nodiscard]] std::string lossy_stream_mutex_name(string_view stream_name);
+
+/*!
+ * \brief Create and initialize data of a lossy stream.
+ *
+ * \param[in] name Name of the stream.
+ * \param[in] num_records Number of records.
+ * \param[in] max_message_size Maximum size of messages.
+ * \return Data.
+ */
+[[nodiscard]] lossy_stream_data create_and_initialize_lossy_stream_data(
+    string_view name, shm_stream_size_t num_records,
+    shm_stream_size_t max_message_size);
+
+/*!
+ * \brief Prepare data of a lossy stream.
+ *
+ * \param[in] name Name of the stream.
+ * \param[in] num_records Number of records.
+ * \param[in] max_message_size Maximum size of messages.
+ * \return Data.
+ *
+ * \note If the stream already exists, the parameters of the existing stream
+ * are used.
+ */
+[[nodiscard]] lossy_stream_data prepare_lossy_stream_data(string_view name,
+    shm_stream_size_t num_records, shm_stream_size_t max_message_size);
+
+/*!
+ * \brief Remove a lossy stream.
+ *
+ * \param[in] name Name of the stream.
+ */
+void remove_lossy_stream(string_view name);
+
+}  // namespace details
+}  // namespace shm_stream
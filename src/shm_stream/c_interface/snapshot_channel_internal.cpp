@@ -0,0 +1,97 @@
+/*
+ * Copyright 2023 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Implementation of internal functions of channels of the latest
+ * snapshots.
+ */
+#include "snapshot_channel_internal.h"
+
+#include <mutex>
+
+#include <boost/interprocess/creation_tags.hpp>
+#include <boost/interprocess/sync/named_mutex.hpp>
+#include <fmt/format.h>
+
+#include "shm_stream/c_interface/error_codes.h"
+#include "shm_stream/details/snapshot_channel.h"
+#include "shm_stream/shm_stream_exception.h"
+
+namespace shm_stream {
+namespace details {
+
+std::string snapshot_channel_shm_name(string_view channel_name) {
+    return fmt::format("shm_stream_snapshot_channel_data_{}", channel_name);
+}
+
+std::string snapshot_channel_mutex_name(string_view channel_name) {
+    return fmt::format("shm_stream_snapshot_channel_lock_{}", channel_name);
+}
+
+snapshot_channel_data create_and_initialize_snapshot_channel_data(
+    string_view name, shm_stream_size_t max_size) {
+    const std::string shm_name = snapshot_channel_shm_name(name);
+    const shm_stream_size64_t buffer_size =
+        snapshot_channel_base<>::buffer_size(max_size);
+
+    snapshot_channel_data data{};
+
+    try {
+        data.shared_memory = boost::interprocess::shared_memory_object(
+            boost::interprocess::create_only, shm_name.c_str(),
+            boost::interprocess::read_write);
+    } catch (...) {
+        throw shm_stream_error(c_shm_stream_error_code_failed_to_open);
+    }
+
+    init_stream_data_from_shared_memory(data, buffer_size);
+
+    return data;
+}
+
+snapshot_channel_data prepare_snapshot_channel_data(
+    string_view name, shm_stream_size_t max_size) {
+    const std::string shm_name = snapshot_channel_shm_name(name);
+    const std::string mutex_name = snapshot_channel_mutex_name(name);
+
+    snapshot_channel_data data{};
+
+    boost::interprocess::named_mutex mutex{
+        boost::interprocess::open_or_create, mutex_name.c_str()};
+    std::unique_lock<boost::interprocess::named_mutex> lock(mutex);
+
+    try {
+        data.shared_memory = boost::interprocess::shared_memory_object(
+            boost::interprocess::open_only, shm_name.c_str(),
+            boost::interprocess::read_write);
+    } catch (...) {
+        // Shared memory doesn't exist, so create one.
+        return create_and_initialize_snapshot_channel_data(name, max_size);
+    }
+
+    extract_stream_data_from_shared_memory(data);
+
+    return data;
+}
+
+void remove_snapshot_channel(string_view name) {
+    const std::string mutex_name = snapshot_channel_mutex_name(name);
+    const std::string shm_name = snapshot_channel_shm_name(name);
+    remove_atomic_stream(mutex_name, shm_name);
+}
+
+}  // namespace details
+}  // namespace shm_stream
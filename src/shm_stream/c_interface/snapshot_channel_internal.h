@@ -0,0 +1,88 @@
+/*
+ * Copyright 2023 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Definition of internal functions of channels of the latest
+ * snapshots.
+ */
+#pragma once
+
+#include <string>
+
+#include "atomic_stream_internal.h"
+#include "shm_stream/common_types.h"
+#include "shm_stream/string_view.h"
+
+namespace shm_stream {
+namespace details {
+
+/*!
+ * \brief Data of snapshot channels.
+ *
+ * \note The index of the writer is used as the version of the latest
+ * snapshot, and the index of the reader is not used.
+ */
+using snapshot_channel_data = atomic_stream64_data;
+
+/*!
+ * \brief Get the name of the shared memory of a snapshot channel.
+ *
+ * \param[in] channel_name Name of the channel.
+ * \return Name of the shared memory.
+ */
+[[nodiscard]] std::string snapshot_channel_shm_name(string_view channel_name);
+
+/*!
+ * \brief Get the name of the mutex of a snapshot channel.
+ *
+ * \param[in] channel_name Name of the channel.
+ * \return Name of the mutex.
+ */
+[[nodiscard]] std::string snapshot_channel_mutex_name(
+    string_view channel_name);
+
+/*!
+ * \brief Create and initialize data of a snapshot channel.
+ *
+ * \param[in] name Name of the channel.
+ * \param[in] max_size Maximum size of snapshots.
+ * \return Data.
+ */
+[[nodiscard]] snapshot_channel_data create_and_initialize_snapshot_channel_data(
+    string_view name, shm_stream_size_t max_size);
+
+/*!
+ * \brief Prepare data of a snapshot channel.
+ *
+ * \param[in] name Name of the channel.
+ * \param[in] max_size Maximum size of snapshots.
+ * \return Data.
+ *
+ * \note If the channel already exists, the maximum size of the existing
+ * channel is used.
+ */
+[[nodiscard]] snapshot_channel_data prepare_snapshot_channel_data(
+    string_view name, shm_stream_size_t max_size);
+
+/*!
+ * \brief Remove a snapshot channel.
+ *
+ * \param[in] name Name of the channel.
+ */
+void remove_snapshot_channel(string_view name);
+
+}  // namespace details
+}  // namespace shm_stream
@@ -0,0 +1,109 @@
+/*
+ * Copyright 2023 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Implementation of C interface of readers of channels of the latest
+ * snapshots.
+ */
+#include "shm_stream/c_interface/snapshot_channel_reader.h"
+
+#include <boost/interprocess/mapped_region.hpp>
+#include <boost/interprocess/shared_memory_object.hpp>
+
+#include "shm_stream/bytes_view.h"
+#include "shm_stream/c_interface/bytes_view.h"
+#include "shm_stream/c_interface/translate_error.h"
+#include "shm_stream/common_types.h"
+#include "shm_stream/details/snapshot_channel.h"
+#include "shm_stream/string_view.h"
+#include "snapshot_channel_internal.h"
+
+/*!
+ * \brief Reader of channels of the latest snapshots.
+ */
+struct c_shm_stream_snapshot_channel_reader {
+    //! Shared memory object.
+    boost::interprocess::shared_memory_object shared_memory;
+
+    //! Mapped region.
+    boost::interprocess::mapped_region mapped_region;
+
+    //! Reader.
+    shm_stream::details::snapshot_channel_reader<> reader;
+
+    /*!
+     * \brief Constructor.
+     *
+     * \param[in] data Data.
+     */
+    explicit c_shm_stream_snapshot_channel_reader(
+        shm_stream::details::snapshot_channel_data&& data)
+        : shared_memory(std::move(data.shared_memory)),
+          mapped_region(std::move(data.mapped_region)),
+          reader(data.atomic_indices->writer(), data.buffer) {}
+
+    /*!
+     * \brief Constructor.
+     *
+     * \param[in] name Name of the channel.
+     * \param[in] max_size Maximum size of snapshots.
+     */
+    c_shm_stream_snapshot_channel_reader(
+        shm_stream::string_view name, shm_stream::shm_stream_size_t max_size)
+        : c_shm_stream_snapshot_channel_reader(
+              shm_stream::details::prepare_snapshot_channel_data(
+                  name, max_size)) {}
+};
+
+c_shm_stream_error_code_t c_shm_stream_snapshot_channel_reader_create(
+    c_shm_stream_snapshot_channel_reader_t** reader,
+    c_shm_stream_string_view_t name, c_shm_stream_size_t max_size) {
+    C_SHM_STREAM_TRANSLATE_ERROR(
+        *reader = new c_shm_stream_snapshot_channel_reader(
+            shm_stream::string_view{name.data, name.size}, max_size));
+}
+
+void c_shm_stream_snapshot_channel_reader_destroy(
+    c_shm_stream_snapshot_channel_reader_t* reader) {
+    delete reader;
+}
+
+c_shm_stream_size_t c_shm_stream_snapshot_channel_reader_max_size(
+    c_shm_stream_snapshot_channel_reader_t* reader) {
+    if (reader == nullptr) {
+        return 0U;
+    }
+    return reader->reader.max_size();
+}
+
+c_shm_stream_size64_t c_shm_stream_snapshot_channel_reader_version(
+    c_shm_stream_snapshot_channel_reader_t* reader) {
+    if (reader == nullptr) {
+        return 0U;
+    }
+    return reader->reader.version();
+}
+
+c_shm_stream_size64_t c_shm_stream_snapshot_channel_reader_read(
+    c_shm_stream_snapshot_channel_reader_t* reader,
+    c_shm_stream_mutable_bytes_view_t buffer, c_shm_stream_size_t* size) {
+    if (reader == nullptr) {
+        *size = 0U;
+        return 0U;
+    }
+    return reader->reader.read(
+        shm_stream::mutable_bytes_view(buffer.data, buffer.size), *size);
+}
@@ -0,0 +1,206 @@
+/*
+ * Copyright 2023 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Implementation of functions to wait for changes of multiple atomic
+ * variables.
+ */
+#include "wait_any_internal.h"
+
+#include <algorithm>
+#include <thread>
+
+#ifdef __linux__
+#include <atomic>
+#include <cerrno>
+#include <ctime>
+
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace shm_stream {
+namespace details {
+
+namespace {
+
+/*!
+ * \brief Maximum duration of a wait when some variables can't be watched by
+ * the operating system.
+ */
+constexpr std::chrono::milliseconds wait_slice{1};
+
+/*!
+ * \brief Calculate the duration of a wait.
+ *
+ * \param[in] deadline Deadline.
+ * \param[in] sliced Whether to limit the duration to wait_slice.
+ * \return Duration. (duration::max() for no limit.)
+ */
+[[nodiscard]] std::chrono::steady_clock::duration calc_wait_duration(
+    std::chrono::steady_clock::time_point deadline, bool sliced) noexcept {
+    std::chrono::steady_clock::duration duration =
+        std::chrono::steady_clock::duration::max();
+    if (deadline != std::chrono::steady_clock::time_point::max()) {
+        duration = std::max(deadline - std::chrono::steady_clock::now(),
+            std::chrono::steady_clock::duration::zero());
+    }
+    if (sliced) {
+        duration = std::min<std::chrono::steady_clock::duration>(
+            duration, wait_slice);
+    }
+    return duration;
+}
+
+#ifdef __linux__
+
+/*!
+ * \brief Convert a duration to timespec.
+ *
+ * \param[in] duration Duration.
+ * \return Value of timespec.
+ */
+[[nodiscard]] ::timespec to_timespec(
+    std::chrono::steady_clock::duration duration) noexcept {
+    const auto seconds =
+        std::chrono::duration_cast<std::chrono::seconds>(duration);
+    ::timespec result{};
+    result.tv_sec = static_cast<::time_t>(seconds.count());
+    result.tv_nsec = static_cast<long>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            duration - seconds)
+            .count());
+    return result;
+}
+
+#if defined(SYS_futex_waitv) && defined(FUTEX_32)
+
+static_assert(max_wait_any_addresses() == FUTEX_WAITV_MAX,
+    "Unexpected limit of futex_waitv system call.");
+
+//! Whether futex_waitv system call is known to be unavailable.
+std::atomic<bool> is_futex_waitv_unavailable{false};
+
+/*!
+ * \brief Wait using futex_waitv system call.
+ *
+ * \param[in] addresses Addresses of atomic variables.
+ * \param[in] values Unexpected values of atomic variables.
+ * \param[in] num_addresses Number of atomic variables.
+ * \param[in] deadline Deadline.
+ * \param[in] sliced Whether to limit the duration to a slice.
+ * \retval true Waited.
+ * \retval false futex_waitv system call is not available.
+ */
+[[nodiscard]] bool wait_using_futex_waitv(
+    const std::uint32_t* const* addresses, const std::uint32_t* values,
+    std::size_t num_addresses, std::chrono::steady_clock::time_point deadline,
+    bool sliced) noexcept {
+    if (is_futex_waitv_unavailable.load(std::memory_order_relaxed)) {
+        return false;
+    }
+
+    ::futex_waitv waiters[FUTEX_WAITV_MAX] = {};
+    for (std::size_t i = 0; i < num_addresses; ++i) {
+        waiters[i].val = values[i];
+        waiters[i].uaddr = reinterpret_cast<std::uintptr_t>(addresses[i]);
+        // Without FUTEX_PRIVATE_FLAG for variables shared among processes.
+        waiters[i].flags = FUTEX_32;
+    }
+
+    // futex_waitv system call accepts only absolute timeouts.
+    const auto duration = calc_wait_duration(deadline, sliced);
+    ::timespec timeout{};
+    ::timespec* timeout_ptr = nullptr;
+    if (duration != std::chrono::steady_clock::duration::max()) {
+        ::timespec now{};
+        ::clock_gettime(CLOCK_MONOTONIC, &now);
+        const auto absolute = std::chrono::seconds(now.tv_sec) +
+            std::chrono::nanoseconds(now.tv_nsec) + duration;
+        timeout = to_timespec(
+            std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                absolute));
+        timeout_ptr = &timeout;
+    }
+
+    // Errors other than ENOSYS (changed values, timeouts, signals) are
+    // handled by callers checking the variables again.
+    if (::syscall(SYS_futex_waitv, waiters, num_addresses, 0, timeout_ptr,
+            CLOCK_MONOTONIC) != 0 &&
+        errno == ENOSYS) {
+        is_futex_waitv_unavailable.store(true, std::memory_order_relaxed);
+        return false;
+    }
+    return true;
+}
+
+#endif
+
+/*!
+ * \brief Wait using futex system call for the first variable, and check the
+ * remaining variables after slices.
+ *
+ * \param[in] addresses Addresses of atomic variables.
+ * \param[in] values Unexpected values of atomic variables.
+ * \param[in] num_addresses Number of atomic variables.
+ * \param[in] deadline Deadline.
+ * \param[in] sliced Whether to limit the duration to a slice.
+ */
+void wait_using_futex(const std::uint32_t* const* addresses,
+    const std::uint32_t* values, std::size_t num_addresses,
+    std::chrono::steady_clock::time_point deadline, bool sliced) noexcept {
+    const auto duration =
+        calc_wait_duration(deadline, sliced || num_addresses > 1U);
+    ::timespec timeout{};
+    ::timespec* timeout_ptr = nullptr;
+    if (duration != std::chrono::steady_clock::duration::max()) {
+        timeout = to_timespec(duration);
+        timeout_ptr = &timeout;
+    }
+    ::syscall(SYS_futex, addresses[0], FUTEX_WAIT, values[0], timeout_ptr,
+        nullptr, 0);
+}
+
+#endif
+
+}  // namespace
+
+void wait_any_change(const std::uint32_t* const* addresses,
+    const std::uint32_t* values, std::size_t num_addresses,
+    std::chrono::steady_clock::time_point deadline, bool sliced) noexcept {
+    if (num_addresses == 0U) {
+        return;
+    }
+    num_addresses = std::min(num_addresses, max_wait_any_addresses());
+#ifdef __linux__
+#if defined(SYS_futex_waitv) && defined(FUTEX_32)
+    if (wait_using_futex_waitv(
+            addresses, values, num_addresses, deadline, sliced)) {
+        return;
+    }
+#endif
+    wait_using_futex(addresses, values, num_addresses, deadline, sliced);
+#else
+    (void)addresses;
+    (void)values;
+    (void)sliced;
+    std::this_thread::sleep_for(calc_wait_duration(deadline, true));
+#endif
+}
+
+}  // namespace details
+}  // namespace shm_stream
@@ -0,0 +1,63 @@
+/*
+ * Copyright 2023 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Definition of functions to wait for changes of multiple atomic
+ * variables.
+ */
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace shm_stream {
+namespace details {
+
+/*!
+ * \brief Get the maximum number of atomic variables given to wait_any_change
+ * function at once.
+ *
+ * \return Number of atomic variables. (Same as the limit of futex_waitv system
+ * call.)
+ */
+[[nodiscard]] constexpr std::size_t max_wait_any_addresses() noexcept {
+    constexpr std::size_t num = 128U;
+    return num;
+}
+
+/*!
+ * \brief Wait until one of atomic variables changes from the given values or
+ * a deadline.
+ *
+ * \param[in] addresses Addresses of atomic variables shared among processes.
+ * \param[in] values Unexpected values of atomic variables.
+ * \param[in] num_addresses Number of atomic variables. (At most
+ * max_wait_any_addresses().)
+ * \param[in] deadline Deadline. (time_point::max() for no deadline.)
+ * \param[in] sliced Whether to return after a short time to check variables
+ * not given to this function.
+ *
+ * \note This function can return spuriously (for example, when sliced is true
+ * or futex_waitv system call is not available), so callers must check the
+ * variables again after this function returns.
+ */
+void wait_any_change(const std::uint32_t* const* addresses,
+    const std::uint32_t* values, std::size_t num_addresses,
+    std::chrono::steady_clock::time_point deadline, bool sliced) noexcept;
+
+}  // namespace details
+}  // namespace shm_stream
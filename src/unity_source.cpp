@@ -1,10 +1,48 @@
+#include "shm_stream/c_interface/anonymous_stream_common.cpp"  // NOLINT(bugprone-suspicious-include)
+#include "shm_stream/c_interface/anonymous_stream_internal.cpp"  // NOLINT(bugprone-suspicious-include)
+#include "shm_stream/c_interface/anonymous_stream_reader.cpp"  // NOLINT(bugprone-suspicious-include)
+#include "shm_stream/c_interface/anonymous_stream_writer.cpp"  // NOLINT(bugprone-suspicious-include)
 #include "shm_stream/c_interface/atomic_stream_internal.cpp"  // NOLINT(bugprone-suspicious-include)
 #include "shm_stream/c_interface/blocking_stream_common.cpp"  // NOLINT(bugprone-suspicious-include)
 #include "shm_stream/c_interface/blocking_stream_internal.cpp"  // NOLINT(bugprone-suspicious-include)
 #include "shm_stream/c_interface/blocking_stream_reader.cpp"  // NOLINT(bugprone-suspicious-include)
 #include "shm_stream/c_interface/blocking_stream_writer.cpp"  // NOLINT(bugprone-suspicious-include)
+#include "shm_stream/c_interface/broadcast_stream_common.cpp"  // NOLINT(bugprone-suspicious-include)
+#include "shm_stream/c_interface/broadcast_stream_internal.cpp"  // NOLINT(bugprone-suspicious-include)
+#include "shm_stream/c_interface/broadcast_stream_reader.cpp"  // NOLINT(bugprone-suspicious-include)
+#include "shm_stream/c_interface/broadcast_stream_writer.cpp"  // NOLINT(bugprone-suspicious-include)
+#include "shm_stream/c_interface/bulk_copy_internal.cpp"  // NOLINT(bugprone-suspicious-include)
+#include "shm_stream/c_interface/chunk_stream_common.cpp"  // NOLINT(bugprone-suspicious-include)
+#include "shm_stream/c_interface/chunk_stream_internal.cpp"  // NOLINT(bugprone-suspicious-include)
+#include "shm_stream/c_interface/chunk_stream_reader.cpp"  // NOLINT(bugprone-suspicious-include)
+#include "shm_stream/c_interface/chunk_stream_writer.cpp"  // NOLINT(bugprone-suspicious-include)
+#include "shm_stream/c_interface/doorbell.cpp"  // NOLINT(bugprone-suspicious-include)
+#include "shm_stream/c_interface/doorbell_internal.cpp"  // NOLINT(bugprone-suspicious-include)
 #include "shm_stream/c_interface/error_codes.cpp"  // NOLINT(bugprone-suspicious-include)
+#include "shm_stream/c_interface/fd_transfer_internal.cpp"  // NOLINT(bugprone-suspicious-include)
+#include "shm_stream/c_interface/file_stream_common.cpp"  // NOLINT(bugprone-suspicious-include)
+#include "shm_stream/c_interface/file_stream_internal.cpp"  // NOLINT(bugprone-suspicious-include)
+#include "shm_stream/c_interface/file_stream_reader.cpp"  // NOLINT(bugprone-suspicious-include)
+#include "shm_stream/c_interface/file_stream_writer.cpp"  // NOLINT(bugprone-suspicious-include)
+#include "shm_stream/c_interface/light_message_stream_common.cpp"  // NOLINT(bugprone-suspicious-include)
+#include "shm_stream/c_interface/light_message_stream_reader.cpp"  // NOLINT(bugprone-suspicious-include)
+#include "shm_stream/c_interface/light_message_stream_writer.cpp"  // NOLINT(bugprone-suspicious-include)
+#include "shm_stream/c_interface/light_stream64_common.cpp"  // NOLINT(bugprone-suspicious-include)
+#include "shm_stream/c_interface/light_stream64_reader.cpp"  // NOLINT(bugprone-suspicious-include)
+#include "shm_stream/c_interface/light_stream64_writer.cpp"  // NOLINT(bugprone-suspicious-include)
 #include "shm_stream/c_interface/light_stream_common.cpp"  // NOLINT(bugprone-suspicious-include)
 #include "shm_stream/c_interface/light_stream_internal.cpp"  // NOLINT(bugprone-suspicious-include)
 #include "shm_stream/c_interface/light_stream_reader.cpp"  // NOLINT(bugprone-suspicious-include)
 #include "shm_stream/c_interface/light_stream_writer.cpp"  // NOLINT(bugprone-suspicious-include)
+#include "shm_stream/c_interface/lossy_stream_common.cpp"  // NOLINT(bugprone-suspicious-include)
+#include "shm_stream/c_interface/lossy_stream_internal.cpp"  // NOLINT(bugprone-suspicious-include)
+#include "shm_stream/c_interface/lossy_stream_reader.cpp"  // NOLINT(bugprone-suspicious-include)
+#include "shm_stream/c_interface/lossy_stream_writer.cpp"  // NOLINT(bugprone-suspicious-include)
+#include "shm_stream/c_interface/mpsc_stream_common.cpp"  // NOLINT(bugprone-suspicious-include)
+#include "shm_stream/c_interface/mpsc_stream_reader.cpp"  // NOLINT(bugprone-suspicious-include)
+#include "shm_stream/c_interface/mpsc_stream_writer.cpp"  // NOLINT(bugprone-suspicious-include)
+#include "shm_stream/c_interface/snapshot_channel_common.cpp"  // NOLINT(bugprone-suspicious-include)
+#include "shm_stream/c_interface/snapshot_channel_internal.cpp"  // NOLINT(bugprone-suspicious-include)
+#include "shm_stream/c_interface/snapshot_channel_reader.cpp"  // NOLINT(bugprone-suspicious-include)
+#include "shm_stream/c_interface/snapshot_channel_writer.cpp"  // NOLINT(bugprone-suspicious-include)
+#include "shm_stream/c_interface/wait_any_internal.cpp"  // NOLINT(bugprone-suspicious-include)
@@ -1,21 +1,43 @@
 """Benchmark of sending an receiving data."""
 
+import argparse
 import pathlib
 import subprocess
-import sys
 import time
+import typing
 
+NUMA_NODES_OF_PLACEMENTS: typing.Dict[str, typing.Tuple[int, int]] = {
+    "same": (0, 0),
+    "different": (0, 1),
+}
 
-def bench(build_dir: pathlib.Path) -> None:
+
+def numa_command(node: typing.Optional[int]) -> typing.List[str]:
+    """Get the prefix of commands to run on a NUMA node."""
+    if node is None:
+        return []
+    return ["numactl", f"--cpunodebind={node}"]
+
+
+def bench(build_dir: pathlib.Path, numa_placement: str) -> None:
     bench_results_dir = build_dir / "bench" / "bench_ping_pong"
+    server_node: typing.Optional[int] = None
+    client_node: typing.Optional[int] = None
+    if numa_placement != "none":
+        bench_results_dir = bench_results_dir / f"numa_{numa_placement}"
+        server_node, client_node = NUMA_NODES_OF_PLACEMENTS[numa_placement]
+
+    # The server creates streams on the NUMA node of its CPU.
     server_process = subprocess.Popen(
-        [str(build_dir / "bin" / "bench_ping_pong_server")]
+        numa_command(server_node)
+        + [str(build_dir / "bin" / "bench_ping_pong_server")]
     )
     time.sleep(1)
 
     try:
         client_result = subprocess.run(
-            [
+            numa_command(client_node)
+            + [
                 str(build_dir / "bin" / "bench_ping_pong_client"),
                 "--plot",
                 str(bench_results_dir),
@@ -39,5 +61,18 @@ def bench(build_dir: pathlib.Path) -> None:
     assert client_result.returncode == 0
 
 
+def main() -> None:
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("build_dir", type=pathlib.Path)
+    parser.add_argument(
+        "--numa",
+        choices=["none", "same", "different"],
+        default="none",
+        help="run the client and the server on the same or different NUMA nodes",
+    )
+    args = parser.parse_args()
+    bench(args.build_dir.absolute(), args.numa)
+
+
 if __name__ == "__main__":
-    bench(pathlib.Path(sys.argv[1]).absolute())
+    main()
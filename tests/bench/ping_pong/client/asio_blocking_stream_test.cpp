@@ -0,0 +1,124 @@
+/*
+ * Copyright 2023 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Benchmark of blocking streams of bytes with asynchronous operations
+ * in asio.
+ */
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include <asio/error_code.hpp>
+#include <asio/io_context.hpp>
+#include <stat_bench/benchmark_macros.h>
+
+#include "../common.h"
+#include "command_client.h"
+#include "ping_pong_fixture.h"
+#include "shm_stream/asio_blocking_stream.h"
+#include "shm_stream/blocking_stream.h"
+#include "shm_stream/bytes_view.h"
+#include "shm_stream/common_types.h"
+
+namespace {
+
+/*!
+ * \brief Class of clients sending requests and receiving responses using
+ * asynchronous operations in asio.
+ */
+class asio_ping_pong_client {
+public:
+    /*!
+     * \brief Constructor.
+     *
+     * \param[in] data Data of requests.
+     */
+    explicit asio_ping_pong_client(const std::string& data)
+        : data_(data), received_data_(data.size()) {
+        writer_.open(shm_stream_test::asio_request_stream_name(),
+            shm_stream_test::buffer_size());
+        reader_.open(shm_stream_test::asio_response_stream_name(),
+            shm_stream_test::buffer_size());
+    }
+
+    /*!
+     * \brief Send a request and receive the response.
+     */
+    void ping_pong() {
+        received_size_ = 0U;
+        shm_stream::async_write_all(context_, writer_,
+            shm_stream::bytes_view(data_.data(),
+                static_cast<shm_stream::shm_stream_size_t>(data_.size())),
+            [](const asio::error_code& /*code*/,
+                std::size_t /*bytes_transferred*/) {});
+        async_receive_next();
+        context_.run();
+        context_.restart();
+    }
+
+private:
+    /*!
+     * \brief Start to receive the next bytes of the response.
+     */
+    void async_receive_next() {
+        shm_stream::async_read_some(context_, reader_,
+            shm_stream::mutable_bytes_view(
+                received_data_.data() + received_size_,
+                static_cast<shm_stream::shm_stream_size_t>(
+                    received_data_.size() - received_size_)),
+            [this](const asio::error_code& code,
+                std::size_t bytes_transferred) {
+                if (code) {
+                    return;
+                }
+                received_size_ += bytes_transferred;
+                if (received_size_ < received_data_.size()) {
+                    async_receive_next();
+                }
+            });
+    }
+
+    //! Data of requests.
+    const std::string& data_;
+
+    //! Buffer of responses.
+    std::vector<char> received_data_;
+
+    //! Number of received bytes.
+    std::size_t received_size_{0};
+
+    //! Context of asio.
+    asio::io_context context_{1};
+
+    //! Writer of requests.
+    shm_stream::blocking_stream_writer writer_{};
+
+    //! Reader of responses.
+    shm_stream::blocking_stream_reader reader_{};
+};
+
+}  // namespace
+
+STAT_BENCH_CASE_F(shm_stream_test::ping_pong_fixture, "ping_pong",
+    "asio_blocking_stream") {
+    shm_stream_test::command_client().change_protocol(
+        shm_stream_test::protocol_type::asio_blocking_stream);
+
+    asio_ping_pong_client client{this->get_data()};
+
+    STAT_BENCH_MEASURE() { client.ping_pong(); };
+}
@@ -19,12 +19,17 @@
  */
 #include "shm_stream/blocking_stream.h"
 
+#include <cstdint>
+#include <cstdio>
+
+#include <fmt/format.h>
 #include <stat_bench/benchmark_macros.h>
 
 #include "../common.h"
 #include "command_client.h"
 #include "ping_pong_fixture.h"
 #include "shm_stream/bytes_view.h"
+#include "syscall_counter.h"
 
 STAT_BENCH_CASE_F(
     shm_stream_test::ping_pong_fixture, "ping_pong", "blocking_stream") {
@@ -67,3 +72,67 @@ STAT_BENCH_CASE_F(
         }
     };
 }
+
+STAT_BENCH_CASE_F(shm_stream_test::ping_pong_fixture, "ping_pong_syscalls",
+    "blocking_stream") {
+    using shm_stream::blocking_stream_reader;
+    using shm_stream::blocking_stream_writer;
+    using shm_stream::shm_stream_size_t;
+
+    shm_stream_test::command_client().change_protocol(
+        shm_stream_test::protocol_type::blocking_stream);
+
+    const std::string& data = this->get_data();
+    const std::size_t data_size = data.size();
+    const std::size_t buffer_size = shm_stream_test::buffer_size();
+
+    blocking_stream_writer writer;
+    writer.open(shm_stream_test::request_stream_name(), buffer_size);
+
+    blocking_stream_reader reader;
+    reader.open(shm_stream_test::response_stream_name(), buffer_size);
+
+    shm_stream_test::syscall_counter counter;
+    std::uint64_t num_messages = 0;
+    counter.start();
+
+    STAT_BENCH_MEASURE() {
+        for (auto data_iter = data.cbegin(), data_end = data.cend();
+             data_iter != data_end;) {
+            const auto buffer = writer.wait_reserve();
+            const std::ptrdiff_t writable_size =
+                std::min<std::ptrdiff_t>(buffer.size(), data_end - data_iter);
+            std::copy(data_iter, data_iter + writable_size, buffer.data());
+            writer.commit(static_cast<shm_stream_size_t>(writable_size));
+            data_iter += writable_size;
+
+            if (data_iter == data_end) {
+                break;
+            }
+        }
+
+        for (shm_stream_size_t i = 0; i < data_size;) {
+            const auto buffer = reader.wait_reserve();
+            i += buffer.size();
+            reader.commit(buffer.size());
+        }
+
+        // A request and a response.
+        num_messages += 2U;
+    };
+
+    const std::uint64_t num_syscalls = counter.stop();
+    if (counter.is_available() && num_messages > 0U) {
+        fmt::print(stderr,
+            "ping_pong_syscalls/blocking_stream (size={}): "
+            "{:.3f} system calls per message in the client\n",
+            data_size,
+            static_cast<double>(num_syscalls) /
+                static_cast<double>(num_messages));
+    } else {
+        fmt::print(stderr,
+            "ping_pong_syscalls/blocking_stream (size={}): "
+            "system calls cannot be counted in this environment\n",
+            data_size);
+    }
+}
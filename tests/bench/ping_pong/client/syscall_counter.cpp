@@ -0,0 +1,117 @@
+/*
+ * Copyright 2023 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Implementation of syscall_counter class.
+ */
+#include "syscall_counter.h"
+
+#include <cstdint>
+#include <fstream>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace shm_stream_test {
+
+#ifdef __linux__
+
+/*!
+ * \brief Read the ID of the tracepoint of the entry of system calls.
+ *
+ * \return ID. (Zero if not found.)
+ */
+static std::uint64_t read_sys_enter_tracepoint_id() {
+    for (const char* path :
+        {"/sys/kernel/tracing/events/raw_syscalls/sys_enter/id",
+            "/sys/kernel/debug/tracing/events/raw_syscalls/sys_enter/id"}) {
+        std::ifstream stream{path};
+        std::uint64_t id = 0;
+        if (stream >> id) {
+            return id;
+        }
+    }
+    return 0;
+}
+
+syscall_counter::syscall_counter() {
+    const std::uint64_t id = read_sys_enter_tracepoint_id();
+    if (id == 0) {
+        return;
+    }
+
+    perf_event_attr attr{};
+    attr.type = PERF_TYPE_TRACEPOINT;
+    attr.size = sizeof(attr);
+    attr.config = id;
+    attr.disabled = 1;
+
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-vararg, hicpp-vararg)
+    fd_ = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+}
+
+syscall_counter::~syscall_counter() {
+    if (fd_ >= 0) {
+        close(fd_);
+    }
+}
+
+bool syscall_counter::is_available() const noexcept { return fd_ >= 0; }
+
+void syscall_counter::start() {
+    if (fd_ < 0) {
+        return;
+    }
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-vararg, hicpp-vararg)
+    ioctl(fd_, PERF_EVENT_IOC_RESET, 0);
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-vararg, hicpp-vararg)
+    ioctl(fd_, PERF_EVENT_IOC_ENABLE, 0);
+}
+
+std::uint64_t syscall_counter::stop() {
+    if (fd_ < 0) {
+        return 0;
+    }
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-vararg, hicpp-vararg)
+    ioctl(fd_, PERF_EVENT_IOC_DISABLE, 0);
+    std::uint64_t count = 0;
+    if (read(fd_, &count, sizeof(count)) != sizeof(count)) {
+        return 0;
+    }
+    return count;
+}
+
+#else
+
+syscall_counter::syscall_counter() = default;
+
+syscall_counter::~syscall_counter() = default;
+
+bool syscall_counter::is_available() const noexcept { return false; }
+
+void syscall_counter::start() {
+    // No operation.
+}
+
+std::uint64_t syscall_counter::stop() { return 0; }
+
+#endif
+
+}  // namespace shm_stream_test
@@ -0,0 +1,75 @@
+/*
+ * Copyright 2023 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Definition of syscall_counter class.
+ */
+#pragma once
+
+#include <cstdint>
+
+namespace shm_stream_test {
+
+/*!
+ * \brief Class to count system calls in the current thread.
+ *
+ * \note This class uses a tracepoint of perf events in Linux, and is not
+ * available when the tracepoint cannot be used (for example, because of
+ * permissions).
+ */
+class syscall_counter {
+public:
+    /*!
+     * \brief Constructor.
+     */
+    syscall_counter();
+
+    syscall_counter(const syscall_counter&) = delete;
+    syscall_counter(syscall_counter&&) = delete;
+    syscall_counter& operator=(const syscall_counter&) = delete;
+    syscall_counter& operator=(syscall_counter&&) = delete;
+
+    /*!
+     * \brief Destructor.
+     */
+    ~syscall_counter();
+
+    /*!
+     * \brief Check whether this counter is available.
+     *
+     * \retval true This counter is available.
+     * \retval false This counter is not available.
+     */
+    [[nodiscard]] bool is_available() const noexcept;
+
+    /*!
+     * \brief Reset the count and start counting.
+     */
+    void start();
+
+    /*!
+     * \brief Stop counting.
+     *
+     * \return Number of system calls since the last call to start function.
+     */
+    std::uint64_t stop();
+
+private:
+    //! File descriptor of the perf event.
+    int fd_{-1};
+};
+
+}  // namespace shm_stream_test
@@ -23,6 +23,7 @@
 #include <string>
 
 #include "shm_stream/common_types.h"
+#include "shm_stream/shm_stream_exception.h"
 
 namespace shm_stream_test {
 
@@ -38,7 +39,10 @@ enum class protocol_type {
     udp_v4,
 
     //! UDP in IPv6.
-    udp_v6
+    udp_v6,
+
+    //! Blocking streams with asynchronous operations in asio.
+    asio_blocking_stream
 };
 
 /*!
@@ -79,6 +83,24 @@ inline std::string response_stream_name() {
     return "shm_stream_bench_ping_pong_response";
 }
 
+/*!
+ * \brief Get the name of a stream of requests for asynchronous operations.
+ *
+ * \return Name of the stream.
+ */
+inline std::string asio_request_stream_name() {
+    return "shm_stream_bench_ping_pong_asio_request";
+}
+
+/*!
+ * \brief Get the name of a stream of responses for asynchronous operations.
+ *
+ * \return Name of the stream.
+ */
+inline std::string asio_response_stream_name() {
+    return "shm_stream_bench_ping_pong_asio_response";
+}
+
 /*!
  * \brief Get the port number for benchmark of UDP.
  *
@@ -89,4 +111,27 @@ inline std::uint16_t udp_port() {
     return static_cast<std::uint16_t>(12345);
 }
 
+/*!
+ * \brief Create a stream with pages on the NUMA node of this process if
+ * possible.
+ *
+ * \tparam CreateFunction Type of the function to create streams.
+ * \param[in] create Function to create streams. (For example,
+ * shm_stream::light_stream::create.)
+ * \param[in] name Name of the stream.
+ */
+template <typename CreateFunction>
+inline void create_stream_on_current_numa_node(
+    CreateFunction create, const std::string& name) {
+    try {
+        create(name, buffer_size(), shm_stream::buffer_layout::plain,
+            shm_stream::numa_node_current);
+    } catch (const shm_stream::shm_stream_error&) {
+        // All errors are ignored here, including invalid arguments, not only
+        // the lack of NUMA policies. Errors other than the lack of NUMA
+        // policies are reported when the stream is opened with pages placed
+        // as usual.
+    }
+}
+
 }  // namespace shm_stream_test
@@ -0,0 +1,81 @@
+/*
+ * Copyright 2023 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Implementation of asio_blocking_stream_server class.
+ */
+#include "asio_blocking_stream_server.h"
+
+#include <cstddef>
+
+#include <asio/dispatch.hpp>
+#include <asio/error_code.hpp>
+
+#include "../common.h"
+#include "shm_stream/asio_blocking_stream.h"
+#include "shm_stream/blocking_stream.h"
+
+namespace shm_stream_test {
+
+asio_blocking_stream_server::asio_blocking_stream_server() {
+    shm_stream::blocking_stream::remove(asio_request_stream_name());
+    shm_stream::blocking_stream::remove(asio_response_stream_name());
+    input_.open(asio_request_stream_name(), buffer_size());
+    output_.open(asio_response_stream_name(), buffer_size());
+
+    asio::dispatch(context_, [this] { this->async_receive_next(); });
+    thread_ = std::thread{[this] { context_.run(); }};
+}
+
+asio_blocking_stream_server::~asio_blocking_stream_server() {
+    output_.stop();
+    input_.stop();
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+void asio_blocking_stream_server::start() {
+    // No operation.
+}
+
+void asio_blocking_stream_server::stop() {
+    // No operation.
+}
+
+void asio_blocking_stream_server::async_receive_next() {
+    shm_stream::async_wait_reserve(context_, input_, buffer_size(),
+        [this](const asio::error_code& code, shm_stream::bytes_view request) {
+            if (code) {
+                return;
+            }
+            this->async_send(request);
+        });
+}
+
+void asio_blocking_stream_server::async_send(shm_stream::bytes_view request) {
+    shm_stream::async_write_all(context_, output_, request,
+        [this, request](
+            const asio::error_code& code, std::size_t /*bytes_transferred*/) {
+            if (code) {
+                return;
+            }
+            input_.commit(request.size());
+            this->async_receive_next();
+        });
+}
+
+}  // namespace shm_stream_test
@@ -0,0 +1,91 @@
+/*
+ * Copyright 2023 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Definition of asio_blocking_stream_server class.
+ */
+#pragma once
+
+#include <thread>
+
+#include <asio/io_context.hpp>
+
+#include "server_base.h"
+#include "shm_stream/blocking_stream.h"
+#include "shm_stream/bytes_view.h"
+
+namespace shm_stream_test {
+
+/*!
+ * \brief Class of server using blocking streams with asynchronous operations
+ * in asio.
+ */
+class asio_blocking_stream_server : public server_base {
+public:
+    /*!
+     * \brief Constructor.
+     */
+    asio_blocking_stream_server();
+
+    asio_blocking_stream_server(const asio_blocking_stream_server&) = delete;
+    asio_blocking_stream_server(asio_blocking_stream_server&&) = delete;
+    asio_blocking_stream_server& operator=(
+        const asio_blocking_stream_server&) = delete;
+    asio_blocking_stream_server& operator=(
+        asio_blocking_stream_server&&) = delete;
+
+    /*!
+     * \brief Destructor.
+     */
+    ~asio_blocking_stream_server() override;
+
+    /*!
+     * \brief Start processing.
+     */
+    void start() override;
+
+    /*!
+     * \brief Stop processing.
+     */
+    void stop() override;
+
+private:
+    /*!
+     * \brief Start to receive the next request.
+     */
+    void async_receive_next();
+
+    /*!
+     * \brief Send a response.
+     *
+     * \param[in] request Request.
+     */
+    void async_send(shm_stream::bytes_view request);
+
+    //! Context of asio.
+    asio::io_context context_{1};
+
+    //! Input stream.
+    shm_stream::blocking_stream_reader input_{};
+
+    //! Output stream.
+    shm_stream::blocking_stream_writer output_{};
+
+    //! Thread to process communication.
+    std::thread thread_{};
+};
+
+}  // namespace shm_stream_test
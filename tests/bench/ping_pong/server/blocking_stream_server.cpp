@@ -30,6 +30,10 @@ namespace shm_stream_test {
 blocking_stream_server::blocking_stream_server() {
     shm_stream::blocking_stream::remove(request_stream_name());
     shm_stream::blocking_stream::remove(response_stream_name());
+    create_stream_on_current_numa_node(
+        shm_stream::blocking_stream::create, request_stream_name());
+    create_stream_on_current_numa_node(
+        shm_stream::blocking_stream::create, response_stream_name());
     input_.open(request_stream_name(), buffer_size());
     output_.open(response_stream_name(), buffer_size());
 
@@ -59,18 +63,8 @@ void blocking_stream_server::run() {
             return;
         }
 
-        for (auto iter = input_buffer.data(),
-                  end = input_buffer.data() + input_buffer.size();
-             iter != end;) {
-            const auto output_buffer = output_.wait_reserve();
-
-            const std::ptrdiff_t writable_size =
-                std::min<std::ptrdiff_t>(output_buffer.size(), end - iter);
-            std::copy(iter, iter + writable_size, output_buffer.data());
-            output_.commit(
-                static_cast<shm_stream::shm_stream_size_t>(writable_size));
-
-            iter += writable_size;
+        if (!output_.write_all(input_buffer)) {
+            return;
         }
 
         input_.commit(input_buffer.size());
@@ -23,10 +23,15 @@
 
 #include "../common.h"
 #include "shm_stream/common_types.h"
+#include "shm_stream/light_stream.h"
 
 namespace shm_stream_test {
 
 light_stream_server::light_stream_server() {
+    create_stream_on_current_numa_node(
+        shm_stream::light_stream::create, request_stream_name());
+    create_stream_on_current_numa_node(
+        shm_stream::light_stream::create, response_stream_name());
     input_.open(request_stream_name(), buffer_size());
     output_.open(response_stream_name(), buffer_size());
 }
@@ -25,6 +25,7 @@
 
 #include <fmt/format.h>
 
+#include "asio_blocking_stream_server.h"
 #include "blocking_stream_server.h"
 #include "command_server.h"
 #include "light_stream_server.h"
@@ -57,6 +58,9 @@ int main() {
         bench_server.emplace(shm_stream_test::protocol_type::udp_v6,
             std::make_shared<shm_stream_test::udp_server>(
                 shm_stream_test::protocol_type::udp_v6));
+        bench_server.emplace(
+            shm_stream_test::protocol_type::asio_blocking_stream,
+            std::make_shared<shm_stream_test::asio_blocking_stream_server>());
 
         shm_stream_test::command_server command_server{std::move(bench_server)};
 
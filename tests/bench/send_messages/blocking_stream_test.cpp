@@ -25,6 +25,7 @@
 #include <stat_bench/benchmark_macros.h>
 
 #include "send_messages_fixture.h"
+#include "send_small_messages_fixture.h"
 #include "shm_stream/bytes_view.h"
 
 STAT_BENCH_CASE_F(shm_stream_test::send_messages_fixture, "send_messages",
@@ -79,3 +80,97 @@ STAT_BENCH_CASE_F(shm_stream_test::send_messages_fixture, "send_messages",
     reader.stop();
     reader_thread.join();
 }
+
+STAT_BENCH_CASE_F(shm_stream_test::send_messages_fixture, "send_messages",
+    "blocking_stream_write_all") {
+    using shm_stream::blocking_stream_reader;
+    using shm_stream::blocking_stream_writer;
+    using shm_stream::bytes_view;
+    using shm_stream::shm_stream_size_t;
+
+    const std::string& data = this->get_data();
+    const std::size_t data_size = data.size();
+    const std::size_t buffer_size = 10 * data_size;
+
+    const std::string stream_name = "blocking_stream_test";
+    shm_stream::blocking_stream::remove(stream_name);
+
+    blocking_stream_writer writer;
+    writer.open(stream_name, buffer_size);
+
+    blocking_stream_reader reader;
+    reader.open(stream_name, buffer_size);
+
+    std::thread reader_thread{[&reader] {
+        while (true) {
+            const auto buffer = reader.wait_reserve();
+            if (buffer.empty()) {
+                if (reader.is_stopped()) {
+                    return;
+                }
+                std::this_thread::yield();
+                continue;
+            }
+            reader.commit(buffer.size());
+        }
+    }};
+
+    STAT_BENCH_MEASURE() {
+        (void)writer.write_all(bytes_view(
+            data.data(), static_cast<shm_stream_size_t>(data_size)));
+    };
+
+    reader.stop();
+    reader_thread.join();
+}
+
+STAT_BENCH_CASE_F(shm_stream_test::send_small_messages_fixture,
+    "send_small_messages", "blocking_stream") {
+    using shm_stream::blocking_stream_reader;
+    using shm_stream::blocking_stream_writer;
+    using shm_stream::shm_stream_size_t;
+
+    const std::string& data = this->get_data();
+    const std::size_t num_messages = this->num_messages();
+    const auto read_size = static_cast<shm_stream_size_t>(data.size());
+    const std::size_t buffer_size = this->stream_buffer_size();
+
+    const std::string stream_name = "blocking_stream_test";
+    shm_stream::blocking_stream::remove(stream_name);
+
+    blocking_stream_writer writer;
+    writer.open(stream_name, buffer_size);
+
+    blocking_stream_reader reader;
+    reader.open(stream_name, buffer_size);
+
+    std::thread reader_thread{[&reader, read_size] {
+        while (true) {
+            const auto buffer = reader.wait_reserve(read_size);
+            if (buffer.empty()) {
+                if (reader.is_stopped()) {
+                    return;
+                }
+                std::this_thread::yield();
+                continue;
+            }
+            reader.commit(buffer.size());
+        }
+    }};
+
+    STAT_BENCH_MEASURE() {
+        for (std::size_t i = 0; i < num_messages; ++i) {
+            for (auto data_iter = data.cbegin(), data_end = data.cend();
+                 data_iter != data_end;) {
+                const auto buffer = writer.wait_reserve(
+                    static_cast<shm_stream_size_t>(data_end - data_iter));
+                std::copy(data_iter, data_iter + buffer.size(), buffer.data());
+                writer.commit(buffer.size());
+                data_iter += buffer.size();
+            }
+        }
+    };
+
+    reader.stop();
+    reader_thread.join();
+}
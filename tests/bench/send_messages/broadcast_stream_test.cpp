@@ -0,0 +1,159 @@
+/*
+ * Copyright 2023 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Benchmark of broadcast streams of bytes without waiting.
+ */
+#include "shm_stream/broadcast_stream.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <stat_bench/benchmark_macros.h>
+
+#include "broadcast_fixture.h"
+#include "shm_stream/bytes_view.h"
+#include "shm_stream/common_types.h"
+#include "shm_stream/light_stream.h"
+
+namespace {
+
+/*!
+ * \brief Read bytes from a stream until stopped.
+ *
+ * \tparam Reader Type of the reader.
+ * \param[in] reader Reader.
+ * \param[in] is_running Flag whether the benchmark is running.
+ */
+template <typename Reader>
+void read_until_stopped(Reader& reader, const std::atomic<bool>& is_running) {
+    while (true) {
+        const auto buffer = reader.try_reserve();
+        if (buffer.empty()) {
+            if (!is_running.load(std::memory_order_relaxed)) {
+                return;
+            }
+            std::this_thread::yield();
+            continue;
+        }
+        reader.commit(buffer.size());
+    }
+}
+
+}  // namespace
+
+STAT_BENCH_CASE_F(
+    shm_stream_test::broadcast_fixture, "broadcast", "broadcast_stream") {
+    using shm_stream::broadcast_stream_reader;
+    using shm_stream::broadcast_stream_writer;
+    using shm_stream::shm_stream_size_t;
+
+    const std::string& data = this->get_data();
+    const auto buffer_size =
+        static_cast<shm_stream_size_t>(this->stream_buffer_size());
+
+    const std::string stream_name = "broadcast_stream_test";
+    shm_stream::broadcast_stream::remove(stream_name);
+
+    broadcast_stream_writer writer;
+    writer.open(stream_name, buffer_size);
+
+    std::vector<broadcast_stream_reader> readers(this->num_readers());
+    for (auto& reader : readers) {
+        reader.open(stream_name, buffer_size);
+    }
+
+    std::atomic<bool> is_running{true};
+    std::vector<std::thread> reader_threads;
+    for (auto& reader : readers) {
+        reader_threads.emplace_back(
+            [&reader, &is_running] { read_until_stopped(reader, is_running); });
+    }
+
+    STAT_BENCH_MEASURE() {
+        for (auto data_iter = data.cbegin(), data_end = data.cend();
+             data_iter != data_end;) {
+            const auto buffer = writer.try_reserve(
+                static_cast<shm_stream_size_t>(data_end - data_iter));
+            if (buffer.empty()) {
+                std::this_thread::yield();
+                continue;
+            }
+            std::copy(data_iter, data_iter + buffer.size(), buffer.data());
+            writer.commit(buffer.size());
+            data_iter += buffer.size();
+        }
+    };
+
+    is_running.store(false, std::memory_order_relaxed);
+    for (auto& thread : reader_threads) {
+        thread.join();
+    }
+}
+
+STAT_BENCH_CASE_F(shm_stream_test::broadcast_fixture, "broadcast",
+    "light_stream_per_reader") {
+    using shm_stream::light_stream_reader;
+    using shm_stream::light_stream_writer;
+    using shm_stream::shm_stream_size_t;
+
+    const std::string& data = this->get_data();
+    const auto buffer_size =
+        static_cast<shm_stream_size_t>(this->stream_buffer_size());
+
+    std::vector<light_stream_writer> writers(this->num_readers());
+    std::vector<light_stream_reader> readers(this->num_readers());
+    for (std::size_t i = 0; i < this->num_readers(); ++i) {
+        const std::string stream_name =
+            "broadcast_light_stream_test_" + std::to_string(i);
+        shm_stream::light_stream::remove(stream_name);
+        writers[i].open(stream_name, buffer_size);
+        readers[i].open(stream_name, buffer_size);
+    }
+
+    std::atomic<bool> is_running{true};
+    std::vector<std::thread> reader_threads;
+    for (auto& reader : readers) {
+        reader_threads.emplace_back(
+            [&reader, &is_running] { read_until_stopped(reader, is_running); });
+    }
+
+    STAT_BENCH_MEASURE() {
+        for (auto& writer : writers) {
+            for (auto data_iter = data.cbegin(), data_end = data.cend();
+                 data_iter != data_end;) {
+                const auto buffer = writer.try_reserve(
+                    static_cast<shm_stream_size_t>(data_end - data_iter));
+                if (buffer.empty()) {
+                    std::this_thread::yield();
+                    continue;
+                }
+                std::copy(data_iter, data_iter + buffer.size(), buffer.data());
+                writer.commit(buffer.size());
+                data_iter += buffer.size();
+            }
+        }
+    };
+
+    is_running.store(false, std::memory_order_relaxed);
+    for (auto& thread : reader_threads) {
+        thread.join();
+    }
+}
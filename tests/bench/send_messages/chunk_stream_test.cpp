@@ -0,0 +1,139 @@
+/*
+ * Copyright 2023 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Benchmark of streams passing descriptors of chunks.
+ */
+#include "shm_stream/chunk_stream.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <string>
+#include <thread>
+
+#include <stat_bench/benchmark_macros.h>
+
+#include "frame_fixture.h"
+#include "shm_stream/bytes_view.h"
+#include "shm_stream/common_types.h"
+#include "shm_stream/light_stream.h"
+
+STAT_BENCH_CASE_F(
+    shm_stream_test::frame_fixture, "send_frames", "chunk_stream") {
+    using shm_stream::chunk_stream_reader;
+    using shm_stream::chunk_stream_writer;
+    using shm_stream::shm_stream_size_t;
+
+    const std::string& data = this->get_data();
+    const auto num_chunks =
+        static_cast<shm_stream_size_t>(this->num_buffered_frames());
+    const auto chunk_size = static_cast<shm_stream_size_t>(data.size());
+
+    const std::string stream_name = "frame_chunk_stream_test";
+    shm_stream::chunk_stream::remove(stream_name);
+
+    chunk_stream_writer writer;
+    writer.open(stream_name, num_chunks, chunk_size);
+    chunk_stream_reader reader;
+    reader.open(stream_name, num_chunks, chunk_size);
+
+    std::atomic<bool> is_running{true};
+    std::thread writer_thread{[&writer, &data, &is_running] {
+        while (is_running.load(std::memory_order_relaxed)) {
+            const auto chunk = writer.try_allocate();
+            if (chunk.empty()) {
+                std::this_thread::yield();
+                continue;
+            }
+            // Producers write a frame directly to a chunk.
+            std::copy(data.begin(), data.end(), chunk.data());
+            writer.send(chunk, static_cast<shm_stream_size_t>(data.size()));
+        }
+    }};
+
+    STAT_BENCH_MEASURE() {
+        while (true) {
+            const auto chunk = reader.try_receive();
+            if (chunk.data() != nullptr) {
+                reader.release(chunk);
+                break;
+            }
+        }
+    };
+
+    is_running.store(false, std::memory_order_relaxed);
+    writer_thread.join();
+}
+
+STAT_BENCH_CASE_F(
+    shm_stream_test::frame_fixture, "send_frames", "light_stream_copy") {
+    using shm_stream::light_stream_reader;
+    using shm_stream::light_stream_writer;
+    using shm_stream::shm_stream_size_t;
+
+    const std::string& data = this->get_data();
+    const auto buffer_size = static_cast<shm_stream_size_t>(
+        data.size() * this->num_buffered_frames());
+
+    const std::string stream_name = "frame_light_stream_test";
+    shm_stream::light_stream::remove(stream_name);
+
+    light_stream_writer writer;
+    writer.open(stream_name, buffer_size);
+    light_stream_reader reader;
+    reader.open(stream_name, buffer_size);
+
+    std::atomic<bool> is_running{true};
+    std::thread writer_thread{[&writer, &data, &is_running] {
+        while (is_running.load(std::memory_order_relaxed)) {
+            for (auto data_iter = data.cbegin(), data_end = data.cend();
+                 data_iter != data_end;) {
+                const auto buffer = writer.try_reserve(
+                    static_cast<shm_stream_size_t>(data_end - data_iter));
+                if (buffer.empty()) {
+                    if (!is_running.load(std::memory_order_relaxed)) {
+                        return;
+                    }
+                    std::this_thread::yield();
+                    continue;
+                }
+                std::copy(data_iter, data_iter + buffer.size(), buffer.data());
+                writer.commit(buffer.size());
+                data_iter += buffer.size();
+            }
+        }
+    }};
+
+    // Readers copy a frame out of the stream to use it.
+    std::string frame(data.size(), '\0');
+    STAT_BENCH_MEASURE() {
+        for (std::size_t position = 0; position < frame.size();) {
+            const auto buffer = reader.try_reserve(
+                static_cast<shm_stream_size_t>(frame.size() - position));
+            if (buffer.empty()) {
+                continue;
+            }
+            std::copy(buffer.data(), buffer.data() + buffer.size(),
+                &frame[position]);
+            position += buffer.size();
+            reader.commit(buffer.size());
+        }
+    };
+
+    is_running.store(false, std::memory_order_relaxed);
+    writer_thread.join();
+}
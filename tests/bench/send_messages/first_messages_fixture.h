@@ -0,0 +1,85 @@
+/*
+ * Copyright 2023 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Definition of first_messages_fixture class.
+ */
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+#include <stat_bench/fixture_base.h>
+#include <stat_bench/invocation_context.h>
+
+#include "shm_stream/common_types.h"
+#include "shm_stream_test/generate_data.h"
+
+namespace shm_stream_test {
+
+/*!
+ * \brief Fixture of benchmarks sending messages through freshly created
+ * streams.
+ *
+ * Buffers of streams are large so that messages in early iterations are
+ * written to pages never accessed before, unless pages are pre-faulted.
+ */
+class first_messages_fixture : public stat_bench::FixtureBase {
+public:
+    first_messages_fixture() {
+        this->add_param<std::size_t>("prefault")->add(0)->add(1);
+    }
+
+    void setup(stat_bench::InvocationContext& context) override {
+        options_ = (context.get_param<std::size_t>("prefault") != 0U)
+            ? shm_stream::memory_options::prefault
+            : shm_stream::memory_options::none;
+        data_ = generate_data(message_size());
+    }
+
+    /*!
+     * \brief Get the size of buffers of streams.
+     *
+     * \return Number of bytes.
+     */
+    [[nodiscard]] static constexpr std::size_t stream_buffer_size() noexcept {
+        return 64 * 1024 * 1024;  // NOLINT
+    }
+
+    /*!
+     * \brief Get the size of messages.
+     *
+     * \return Number of bytes.
+     */
+    [[nodiscard]] static constexpr std::size_t message_size() noexcept {
+        return 4 * 1024;  // NOLINT
+    }
+
+    [[nodiscard]] shm_stream::memory_options options() const noexcept {
+        return options_;
+    }
+
+    [[nodiscard]] const std::string& get_data() const noexcept { return data_; }
+
+private:
+    //! Options of memory.
+    shm_stream::memory_options options_{shm_stream::memory_options::none};
+
+    //! Data of a message.
+    std::string data_{};
+};
+
+}  // namespace shm_stream_test
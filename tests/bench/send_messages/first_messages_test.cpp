@@ -0,0 +1,95 @@
+/*
+ * Copyright 2023 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Benchmark of the first messages in streams.
+ */
+#include <algorithm>
+#include <string>
+
+#include <stat_bench/benchmark_macros.h>
+
+#include "first_messages_fixture.h"
+#include "shm_stream/blocking_stream.h"
+#include "shm_stream/common_types.h"
+#include "shm_stream/light_stream.h"
+#include "shm_stream/wait_policy.h"
+
+STAT_BENCH_CASE_F(shm_stream_test::first_messages_fixture, "first_messages",
+    "light_stream") {
+    using shm_stream::light_stream_reader;
+    using shm_stream::light_stream_writer;
+    using shm_stream::shm_stream_size_t;
+
+    const std::string& data = this->get_data();
+    const auto buffer_size =
+        static_cast<shm_stream_size_t>(this->stream_buffer_size());
+
+    const std::string stream_name = "first_messages_light_stream_test";
+    shm_stream::light_stream::remove(stream_name);
+
+    light_stream_writer writer;
+    writer.open(stream_name, buffer_size, this->options());
+    light_stream_reader reader;
+    reader.open(stream_name, buffer_size, this->options());
+
+    STAT_BENCH_MEASURE() {
+        const auto write_buffer = writer.try_reserve(
+            static_cast<shm_stream_size_t>(data.size()));
+        std::copy(data.begin(), data.begin() + write_buffer.size(),
+            write_buffer.data());
+        writer.commit(write_buffer.size());
+
+        const auto read_buffer = reader.try_reserve();
+        reader.commit(read_buffer.size());
+    };
+
+    shm_stream::light_stream::remove(stream_name);
+}
+
+STAT_BENCH_CASE_F(shm_stream_test::first_messages_fixture, "first_messages",
+    "blocking_stream") {
+    using shm_stream::blocking_stream_reader;
+    using shm_stream::blocking_stream_writer;
+    using shm_stream::shm_stream_size_t;
+
+    const std::string& data = this->get_data();
+    const auto buffer_size =
+        static_cast<shm_stream_size_t>(this->stream_buffer_size());
+
+    const std::string stream_name = "first_messages_blocking_stream_test";
+    shm_stream::blocking_stream::remove(stream_name);
+
+    blocking_stream_writer writer;
+    writer.open(
+        stream_name, buffer_size, shm_stream::wait_policy(), this->options());
+    blocking_stream_reader reader;
+    reader.open(
+        stream_name, buffer_size, shm_stream::wait_policy(), this->options());
+
+    STAT_BENCH_MEASURE() {
+        const auto write_buffer = writer.try_reserve(
+            static_cast<shm_stream_size_t>(data.size()));
+        std::copy(data.begin(), data.begin() + write_buffer.size(),
+            write_buffer.data());
+        writer.commit(write_buffer.size());
+
+        const auto read_buffer = reader.try_reserve();
+        reader.commit(read_buffer.size());
+    };
+
+    shm_stream::blocking_stream::remove(stream_name);
+}
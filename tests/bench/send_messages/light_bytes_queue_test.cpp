@@ -0,0 +1,180 @@
+/*
+ * Copyright 2023 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Benchmark of policies of indices in queues of bytes.
+ */
+#include "shm_stream/details/light_bytes_queue.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <boost/atomic/ipc_atomic.hpp>
+#include <stat_bench/benchmark_macros.h>
+
+#include "send_small_messages_fixture.h"
+#include "shm_stream/bytes_view.h"
+#include "shm_stream/common_types.h"
+#include "shm_stream/details/atomic_index_pair.h"
+#include "shm_stream/details/index_policy.h"
+
+namespace {
+
+/*!
+ * \brief Class of a pair of queues in the current process with a thread
+ * reading bytes.
+ *
+ * \tparam IndexPolicy Policy of indices.
+ */
+template <typename IndexPolicy>
+class light_bytes_queue_pair {
+public:
+    //! Type of atomic variables.
+    using atomic_type =
+        boost::atomics::ipc_atomic<shm_stream::shm_stream_size_t>;
+
+    //! Type of writers.
+    using writer_type =
+        shm_stream::details::light_bytes_queue_writer<atomic_type, IndexPolicy>;
+
+    //! Type of readers.
+    using reader_type =
+        shm_stream::details::light_bytes_queue_reader<atomic_type, IndexPolicy>;
+
+    /*!
+     * \brief Constructor.
+     *
+     * \param[in] buffer_size Size of the buffer.
+     * \param[in] read_size Number of bytes to read at once.
+     */
+    light_bytes_queue_pair(shm_stream::shm_stream_size_t buffer_size,
+        shm_stream::shm_stream_size_t read_size)
+        : buffer_(buffer_size),
+          writer_(indices_,
+              shm_stream::mutable_bytes_view(buffer_.data(), buffer_size)),
+          reader_(indices_,
+              shm_stream::bytes_view(buffer_.data(), buffer_size)),
+          reader_thread_([this, read_size] { read(read_size); }) {}
+
+    light_bytes_queue_pair(const light_bytes_queue_pair&) = delete;
+    light_bytes_queue_pair(light_bytes_queue_pair&&) = delete;
+    light_bytes_queue_pair& operator=(const light_bytes_queue_pair&) = delete;
+    light_bytes_queue_pair& operator=(light_bytes_queue_pair&&) = delete;
+
+    /*!
+     * \brief Destructor.
+     */
+    ~light_bytes_queue_pair() {
+        is_running_.store(false, std::memory_order_relaxed);
+        reader_thread_.join();
+    }
+
+    /*!
+     * \brief Send messages.
+     *
+     * \param[in] data Data of a message.
+     * \param[in] num_messages Number of messages.
+     */
+    void send(const std::string& data, std::size_t num_messages) {
+        for (std::size_t i = 0; i < num_messages; ++i) {
+            for (auto data_iter = data.cbegin(), data_end = data.cend();
+                 data_iter != data_end;) {
+                const auto buffer = writer_.try_reserve(
+                    static_cast<shm_stream::shm_stream_size_t>(
+                        data_end - data_iter));
+                if (buffer.empty()) {
+                    std::this_thread::yield();
+                    continue;
+                }
+                std::copy(data_iter, data_iter + buffer.size(), buffer.data());
+                writer_.commit(buffer.size());
+                data_iter += buffer.size();
+            }
+        }
+    }
+
+private:
+    /*!
+     * \brief Read bytes until this object is destructed.
+     *
+     * \param[in] read_size Number of bytes to read at once.
+     */
+    void read(shm_stream::shm_stream_size_t read_size) {
+        while (true) {
+            const auto buffer = reader_.try_reserve(read_size);
+            if (buffer.empty()) {
+                if (!is_running_.load(std::memory_order_relaxed)) {
+                    return;
+                }
+                std::this_thread::yield();
+                continue;
+            }
+            reader_.commit(buffer.size());
+        }
+    }
+
+    //! Indices.
+    shm_stream::details::atomic_index_pair<atomic_type> indices_{};
+
+    //! Buffer.
+    std::vector<char> buffer_;
+
+    //! Writer.
+    writer_type writer_;
+
+    //! Reader.
+    reader_type reader_;
+
+    //! Whether the reader is running.
+    std::atomic<bool> is_running_{true};
+
+    //! Thread of the reader.
+    std::thread reader_thread_;
+};
+
+}  // namespace
+
+STAT_BENCH_CASE_F(shm_stream_test::send_small_messages_fixture,
+    "send_small_messages", "light_bytes_queue_wrapped_index") {
+    using shm_stream::shm_stream_size_t;
+
+    const std::string& data = this->get_data();
+    const std::size_t num_messages = this->num_messages();
+
+    light_bytes_queue_pair<shm_stream::details::wrapped_index_policy> queues{
+        static_cast<shm_stream_size_t>(this->stream_buffer_size()),
+        static_cast<shm_stream_size_t>(data.size())};
+
+    STAT_BENCH_MEASURE() { queues.send(data, num_messages); };
+}
+
+STAT_BENCH_CASE_F(shm_stream_test::send_small_messages_fixture,
+    "send_small_messages", "light_bytes_queue_masked_index") {
+    using shm_stream::shm_stream_size_t;
+
+    const std::string& data = this->get_data();
+    const std::size_t num_messages = this->num_messages();
+
+    light_bytes_queue_pair<shm_stream::details::masked_index_policy> queues{
+        static_cast<shm_stream_size_t>(this->stream_buffer_size()),
+        static_cast<shm_stream_size_t>(data.size())};
+
+    STAT_BENCH_MEASURE() { queues.send(data, num_messages); };
+}
@@ -19,13 +19,16 @@
  */
 #include "shm_stream/light_stream.h"
 
+#include <array>
 #include <atomic>
 #include <thread>
 
 #include <stat_bench/benchmark_macros.h>
 
 #include "send_messages_fixture.h"
+#include "send_small_messages_fixture.h"
 #include "shm_stream/bytes_view.h"
+#include "shm_stream/inline_light_stream.h"
 
 STAT_BENCH_CASE_F(
     shm_stream_test::send_messages_fixture, "send_messages", "light_stream") {
@@ -84,3 +87,218 @@ STAT_BENCH_CASE_F(
     is_running.store(false, std::memory_order_relaxed);
     reader_thread.join();
 }
+
+STAT_BENCH_CASE_F(shm_stream_test::send_messages_fixture, "send_messages",
+    "light_stream_write_all") {
+    using shm_stream::bytes_view;
+    using shm_stream::light_stream_reader;
+    using shm_stream::light_stream_writer;
+    using shm_stream::shm_stream_size_t;
+
+    const std::string& data = this->get_data();
+    const std::size_t data_size = data.size();
+    const std::size_t buffer_size = 10 * data_size;
+
+    const std::string stream_name = "light_stream_test";
+    shm_stream::light_stream::remove(stream_name);
+
+    light_stream_writer writer;
+    writer.open(stream_name, buffer_size);
+
+    light_stream_reader reader;
+    reader.open(stream_name, buffer_size);
+
+    std::atomic<bool> is_running{true};
+    std::thread reader_thread{[&reader, &is_running] {
+        while (true) {
+            const auto buffer = reader.try_reserve();
+            if (buffer.empty()) {
+                if (!is_running.load(std::memory_order_relaxed)) {
+                    return;
+                }
+                std::this_thread::yield();
+                continue;
+            }
+            reader.commit(buffer.size());
+        }
+    }};
+
+    STAT_BENCH_MEASURE() {
+        while (!writer.try_write_all(bytes_view(
+            data.data(), static_cast<shm_stream_size_t>(data_size)))) {
+            std::this_thread::yield();
+        }
+    };
+
+    is_running.store(false, std::memory_order_relaxed);
+    reader_thread.join();
+}
+
+STAT_BENCH_CASE_F(shm_stream_test::send_small_messages_fixture,
+    "send_small_messages", "light_stream") {
+    using shm_stream::light_stream_reader;
+    using shm_stream::light_stream_writer;
+    using shm_stream::shm_stream_size_t;
+
+    const std::string& data = this->get_data();
+    const std::size_t num_messages = this->num_messages();
+    const auto read_size = static_cast<shm_stream_size_t>(data.size());
+    const std::size_t buffer_size = this->stream_buffer_size();
+
+    const std::string stream_name = "light_stream_test";
+    shm_stream::light_stream::remove(stream_name);
+
+    light_stream_writer writer;
+    writer.open(stream_name, buffer_size);
+
+    light_stream_reader reader;
+    reader.open(stream_name, buffer_size);
+
+    std::atomic<bool> is_running{true};
+    std::thread reader_thread{[&reader, &is_running, read_size] {
+        while (true) {
+            const auto buffer = reader.try_reserve(read_size);
+            if (buffer.empty()) {
+                if (!is_running.load(std::memory_order_relaxed)) {
+                    return;
+                }
+                std::this_thread::yield();
+                continue;
+            }
+            reader.commit(buffer.size());
+        }
+    }};
+
+    STAT_BENCH_MEASURE() {
+        for (std::size_t i = 0; i < num_messages; ++i) {
+            for (auto data_iter = data.cbegin(), data_end = data.cend();
+                 data_iter != data_end;) {
+                const auto buffer = writer.try_reserve(
+                    static_cast<shm_stream_size_t>(data_end - data_iter));
+                if (buffer.empty()) {
+                    std::this_thread::yield();
+                    continue;
+                }
+                std::copy(data_iter, data_iter + buffer.size(), buffer.data());
+                writer.commit(buffer.size());
+                data_iter += buffer.size();
+            }
+        }
+    };
+
+    is_running.store(false, std::memory_order_relaxed);
+    reader_thread.join();
+}
+
+STAT_BENCH_CASE_F(shm_stream_test::send_small_messages_fixture,
+    "send_small_messages", "inline_light_stream") {
+    using shm_stream::inline_light_stream_reader;
+    using shm_stream::inline_light_stream_writer;
+    using shm_stream::shm_stream_size_t;
+
+    const std::string& data = this->get_data();
+    const std::size_t num_messages = this->num_messages();
+    const auto read_size = static_cast<shm_stream_size_t>(data.size());
+    const std::size_t buffer_size = this->stream_buffer_size();
+
+    const std::string stream_name = "light_stream_test";
+    shm_stream::light_stream::remove(stream_name);
+
+    inline_light_stream_writer writer;
+    writer.open(stream_name, buffer_size);
+
+    inline_light_stream_reader reader;
+    reader.open(stream_name, buffer_size);
+
+    std::atomic<bool> is_running{true};
+    std::thread reader_thread{[&reader, &is_running, read_size] {
+        while (true) {
+            const auto buffer = reader.try_reserve(read_size);
+            if (buffer.empty()) {
+                if (!is_running.load(std::memory_order_relaxed)) {
+                    return;
+                }
+                std::this_thread::yield();
+                continue;
+            }
+            reader.commit(buffer.size());
+        }
+    }};
+
+    STAT_BENCH_MEASURE() {
+        for (std::size_t i = 0; i < num_messages; ++i) {
+            for (auto data_iter = data.cbegin(), data_end = data.cend();
+                 data_iter != data_end;) {
+                const auto buffer = writer.try_reserve(
+                    static_cast<shm_stream_size_t>(data_end - data_iter));
+                if (buffer.empty()) {
+                    std::this_thread::yield();
+                    continue;
+                }
+                std::copy(data_iter, data_iter + buffer.size(), buffer.data());
+                writer.commit(buffer.size());
+                data_iter += buffer.size();
+            }
+        }
+    };
+
+    is_running.store(false, std::memory_order_relaxed);
+    reader_thread.join();
+}
+
+STAT_BENCH_CASE_F(shm_stream_test::send_small_messages_fixture,
+    "send_small_messages", "light_stream_gather") {
+    using shm_stream::bytes_view;
+    using shm_stream::light_stream_reader;
+    using shm_stream::light_stream_writer;
+    using shm_stream::shm_stream_size_t;
+
+    const std::string& data = this->get_data();
+    const std::size_t num_messages = this->num_messages();
+    const auto read_size = static_cast<shm_stream_size_t>(data.size());
+    const std::size_t buffer_size = this->stream_buffer_size();
+
+    // Header, metadata, and payload of each message.
+    constexpr shm_stream_size_t header_size = 8U;
+    constexpr shm_stream_size_t metadata_size = 8U;
+    const std::array<bytes_view, 3> pieces{
+        bytes_view(data.data(), header_size),
+        bytes_view(data.data() + header_size, metadata_size),
+        bytes_view(data.data() + header_size + metadata_size,
+            read_size - header_size - metadata_size)};
+
+    const std::string stream_name = "light_stream_test";
+    shm_stream::light_stream::remove(stream_name);
+
+    light_stream_writer writer;
+    writer.open(stream_name, buffer_size);
+
+    light_stream_reader reader;
+    reader.open(stream_name, buffer_size);
+
+    std::atomic<bool> is_running{true};
+    std::thread reader_thread{[&reader, &is_running, read_size] {
+        while (true) {
+            const auto buffer = reader.try_reserve(read_size);
+            if (buffer.empty()) {
+                if (!is_running.load(std::memory_order_relaxed)) {
+                    return;
+                }
+                std::this_thread::yield();
+                continue;
+            }
+            reader.commit(buffer.size());
+        }
+    }};
+
+    STAT_BENCH_MEASURE() {
+        for (std::size_t i = 0; i < num_messages; ++i) {
+            while (!writer.try_write_gather(pieces.data(), pieces.size())) {
+                std::this_thread::yield();
+            }
+        }
+    };
+
+    is_running.store(false, std::memory_order_relaxed);
+    reader_thread.join();
+}
@@ -0,0 +1,93 @@
+/*
+ * Copyright 2023 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Definition of mpsc_fixture class.
+ */
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+#include <stat_bench/fixture_base.h>
+#include <stat_bench/invocation_context.h>
+
+#include "shm_stream_test/generate_data.h"
+
+namespace shm_stream_test {
+
+/*!
+ * \brief Fixture of benchmarks sending small messages from multiple writers.
+ */
+class mpsc_fixture : public stat_bench::FixtureBase {
+public:
+    mpsc_fixture() {
+        this->add_param<std::size_t>("writers")
+            ->add(1)   // NOLINT
+            ->add(2)   // NOLINT
+            ->add(4)   // NOLINT
+            ->add(8)   // NOLINT
+            ->add(16)  // NOLINT
+            ;
+    }
+
+    void setup(stat_bench::InvocationContext& context) override {
+        num_writers_ = context.get_param<std::size_t>("writers");
+        data_ = generate_data(message_size());
+    }
+
+    /*!
+     * \brief Get the size of each message.
+     *
+     * \return Number of bytes.
+     */
+    [[nodiscard]] static constexpr std::size_t message_size() noexcept {
+        return 32;  // NOLINT
+    }
+
+    /*!
+     * \brief Get the number of messages sent by each writer.
+     *
+     * \return Number of messages.
+     */
+    [[nodiscard]] static constexpr std::size_t messages_per_writer() noexcept {
+        return 1000;  // NOLINT
+    }
+
+    /*!
+     * \brief Get the size of buffers of streams.
+     *
+     * \return Number of bytes.
+     */
+    [[nodiscard]] static constexpr std::size_t stream_buffer_size() noexcept {
+        return 64 * 1024;  // NOLINT
+    }
+
+    [[nodiscard]] std::size_t num_writers() const noexcept {
+        return num_writers_;
+    }
+
+    [[nodiscard]] const std::string& get_data() const noexcept { return data_; }
+
+private:
+    //! Number of writers.
+    std::size_t num_writers_{0};
+
+    //! Data of a message.
+    std::string data_{};
+};
+
+}  // namespace shm_stream_test
@@ -0,0 +1,166 @@
+/*
+ * Copyright 2023 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Benchmark of MPSC streams of messages without waiting.
+ */
+#include "shm_stream/mpsc_stream.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <stat_bench/benchmark_macros.h>
+
+#include "mpsc_fixture.h"
+#include "shm_stream/bytes_view.h"
+#include "shm_stream/common_types.h"
+#include "shm_stream/light_stream.h"
+
+STAT_BENCH_CASE_F(shm_stream_test::mpsc_fixture, "mpsc", "mpsc_stream") {
+    using shm_stream::mpsc_stream_reader;
+    using shm_stream::mpsc_stream_writer;
+    using shm_stream::shm_stream_size_t;
+
+    const std::string& data = this->get_data();
+    const auto message_size = static_cast<shm_stream_size_t>(data.size());
+    const auto buffer_size =
+        static_cast<shm_stream_size_t>(this->stream_buffer_size());
+
+    const std::string stream_name = "mpsc_stream_test";
+    shm_stream::mpsc_stream::remove(stream_name);
+
+    std::vector<mpsc_stream_writer> writers(this->num_writers());
+    for (auto& writer : writers) {
+        writer.open(stream_name, buffer_size);
+    }
+    mpsc_stream_reader reader;
+    reader.open(stream_name, buffer_size);
+
+    std::atomic<bool> is_running{true};
+    std::thread reader_thread{[&reader, &is_running] {
+        while (true) {
+            const auto buffer = reader.next_message();
+            if (buffer.data() == nullptr) {
+                if (!is_running.load(std::memory_order_relaxed)) {
+                    return;
+                }
+                std::this_thread::yield();
+                continue;
+            }
+            reader.commit_message();
+        }
+    }};
+
+    STAT_BENCH_MEASURE() {
+        std::vector<std::thread> writer_threads;
+        writer_threads.reserve(writers.size());
+        for (auto& writer : writers) {
+            writer_threads.emplace_back([&writer, &data, message_size] {
+                for (std::size_t i = 0; i < messages_per_writer(); ++i) {
+                    while (true) {
+                        const auto buffer =
+                            writer.reserve_message(message_size);
+                        if (buffer.data() != nullptr) {
+                            std::copy(data.begin(), data.end(), buffer.data());
+                            writer.commit_message();
+                            break;
+                        }
+                        std::this_thread::yield();
+                    }
+                }
+            });
+        }
+        for (auto& thread : writer_threads) {
+            thread.join();
+        }
+    };
+
+    is_running.store(false, std::memory_order_relaxed);
+    reader_thread.join();
+}
+
+STAT_BENCH_CASE_F(
+    shm_stream_test::mpsc_fixture, "mpsc", "light_stream_with_mutex") {
+    using shm_stream::light_stream_reader;
+    using shm_stream::light_stream_writer;
+    using shm_stream::shm_stream_size_t;
+
+    const std::string& data = this->get_data();
+    const auto buffer_size =
+        static_cast<shm_stream_size_t>(this->stream_buffer_size());
+
+    const std::string stream_name = "mpsc_light_stream_test";
+    shm_stream::light_stream::remove(stream_name);
+
+    light_stream_writer writer;
+    writer.open(stream_name, buffer_size);
+    std::mutex writer_mutex;
+    light_stream_reader reader;
+    reader.open(stream_name, buffer_size);
+
+    std::atomic<bool> is_running{true};
+    std::thread reader_thread{[&reader, &is_running] {
+        while (true) {
+            const auto buffer = reader.try_reserve();
+            if (buffer.empty()) {
+                if (!is_running.load(std::memory_order_relaxed)) {
+                    return;
+                }
+                std::this_thread::yield();
+                continue;
+            }
+            reader.commit(buffer.size());
+        }
+    }};
+
+    STAT_BENCH_MEASURE() {
+        std::vector<std::thread> writer_threads;
+        writer_threads.reserve(this->num_writers());
+        for (std::size_t t = 0; t < this->num_writers(); ++t) {
+            writer_threads.emplace_back([&writer, &writer_mutex, &data] {
+                for (std::size_t i = 0; i < messages_per_writer(); ++i) {
+                    std::lock_guard<std::mutex> lock(writer_mutex);
+                    for (auto data_iter = data.cbegin(),
+                              data_end = data.cend();
+                         data_iter != data_end;) {
+                        const auto buffer = writer.try_reserve(
+                            static_cast<shm_stream_size_t>(
+                                data_end - data_iter));
+                        if (buffer.empty()) {
+                            std::this_thread::yield();
+                            continue;
+                        }
+                        std::copy(data_iter, data_iter + buffer.size(),
+                            buffer.data());
+                        writer.commit(buffer.size());
+                        data_iter += buffer.size();
+                    }
+                }
+            });
+        }
+        for (auto& thread : writer_threads) {
+            thread.join();
+        }
+    };
+
+    is_running.store(false, std::memory_order_relaxed);
+    reader_thread.join();
+}
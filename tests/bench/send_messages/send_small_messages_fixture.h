@@ -0,0 +1,84 @@
+/*
+ * Copyright 2023 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Definition of send_small_messages_fixture class.
+ */
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+#include <stat_bench/fixture_base.h>
+#include <stat_bench/invocation_context.h>
+
+#include "shm_stream_test/generate_data.h"
+
+namespace shm_stream_test {
+
+/*!
+ * \brief Fixture of benchmarks sending many small messages.
+ */
+class send_small_messages_fixture : public stat_bench::FixtureBase {
+public:
+    send_small_messages_fixture() {
+        this->add_param<std::size_t>("messages")
+            ->add(1)    // NOLINT
+            ->add(100)  // NOLINT
+#ifdef NDEBUG
+            ->add(10000)  // NOLINT
+#endif
+            ;
+    }
+
+    void setup(stat_bench::InvocationContext& context) override {
+        num_messages_ = context.get_param<std::size_t>("messages");
+        data_ = generate_data(message_size());
+    }
+
+    /*!
+     * \brief Get the size of each message.
+     *
+     * \return Number of bytes.
+     */
+    [[nodiscard]] static constexpr std::size_t message_size() noexcept {
+        return 32;  // NOLINT
+    }
+
+    /*!
+     * \brief Get the size of buffers of streams.
+     *
+     * \return Number of bytes.
+     */
+    [[nodiscard]] static constexpr std::size_t stream_buffer_size() noexcept {
+        return 1024 * message_size();  // NOLINT
+    }
+
+    [[nodiscard]] std::size_t num_messages() const noexcept {
+        return num_messages_;
+    }
+
+    [[nodiscard]] const std::string& get_data() const noexcept { return data_; }
+
+private:
+    //! Number of messages.
+    std::size_t num_messages_{0};
+
+    //! Data of a message.
+    std::string data_{};
+};
+
+}  // namespace shm_stream_test
@@ -0,0 +1,135 @@
+/*
+ * Copyright 2023 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Benchmark of channels of the latest snapshots.
+ */
+#include "shm_stream/snapshot_channel.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <string>
+#include <thread>
+
+#include <stat_bench/benchmark_macros.h>
+
+#include "shm_stream/bytes_view.h"
+#include "shm_stream/common_types.h"
+#include "shm_stream/light_stream.h"
+#include "snapshot_fixture.h"
+
+STAT_BENCH_CASE_F(
+    shm_stream_test::snapshot_fixture, "read_latest", "snapshot_channel") {
+    using shm_stream::shm_stream_size_t;
+    using shm_stream::snapshot_channel_reader;
+    using shm_stream::snapshot_channel_writer;
+
+    const std::string& data = this->get_data();
+    const auto data_size = static_cast<shm_stream_size_t>(data.size());
+
+    const std::string channel_name = "snapshot_channel_test";
+    shm_stream::snapshot_channel::remove(channel_name);
+
+    snapshot_channel_writer writer;
+    writer.open(channel_name, data_size);
+    snapshot_channel_reader reader;
+    reader.open(channel_name, data_size);
+
+    std::atomic<bool> is_running{true};
+    std::thread writer_thread{[&writer, &data, &is_running] {
+        const auto value = shm_stream::bytes_view(
+            data.data(), static_cast<shm_stream_size_t>(data.size()));
+        while (is_running.load(std::memory_order_relaxed)) {
+            writer.publish(value);
+        }
+    }};
+
+    std::string latest(data.size(), '\0');
+    STAT_BENCH_MEASURE() {
+        shm_stream_size_t size = 0U;
+        (void)reader.read(
+            shm_stream::mutable_bytes_view(&latest[0], data_size), size);
+    };
+
+    is_running.store(false, std::memory_order_relaxed);
+    writer_thread.join();
+}
+
+STAT_BENCH_CASE_F(
+    shm_stream_test::snapshot_fixture, "read_latest", "light_stream_drain") {
+    using shm_stream::light_stream_reader;
+    using shm_stream::light_stream_writer;
+    using shm_stream::shm_stream_size_t;
+
+    const std::string& data = this->get_data();
+    const auto buffer_size =
+        static_cast<shm_stream_size_t>(this->stream_buffer_size());
+
+    const std::string stream_name = "snapshot_light_stream_test";
+    shm_stream::light_stream::remove(stream_name);
+
+    light_stream_writer writer;
+    writer.open(stream_name, buffer_size);
+    light_stream_reader reader;
+    reader.open(stream_name, buffer_size);
+
+    std::atomic<bool> is_running{true};
+    std::thread writer_thread{[&writer, &data, &is_running] {
+        while (is_running.load(std::memory_order_relaxed)) {
+            for (auto data_iter = data.cbegin(), data_end = data.cend();
+                 data_iter != data_end;) {
+                const auto buffer = writer.try_reserve(
+                    static_cast<shm_stream_size_t>(data_end - data_iter));
+                if (buffer.empty()) {
+                    if (!is_running.load(std::memory_order_relaxed)) {
+                        return;
+                    }
+                    std::this_thread::yield();
+                    continue;
+                }
+                std::copy(data_iter, data_iter + buffer.size(), buffer.data());
+                writer.commit(buffer.size());
+                data_iter += buffer.size();
+            }
+        }
+    }};
+
+    // Bytes of the value being received, which becomes the latest value when
+    // completed.
+    std::string latest(data.size(), '\0');
+    std::size_t position = 0;
+    STAT_BENCH_MEASURE() {
+        while (true) {
+            const auto buffer = reader.try_reserve();
+            if (buffer.empty()) {
+                break;
+            }
+            for (std::size_t offset = 0; offset < buffer.size();) {
+                const std::size_t copied_size = std::min<std::size_t>(
+                    latest.size() - position, buffer.size() - offset);
+                std::copy(buffer.data() + offset,
+                    buffer.data() + offset + copied_size, &latest[position]);
+                offset += copied_size;
+                position = (position + copied_size) % latest.size();
+            }
+            reader.commit(buffer.size());
+        }
+    };
+
+    is_running.store(false, std::memory_order_relaxed);
+    writer_thread.join();
+}
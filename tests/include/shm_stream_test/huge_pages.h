@@ -0,0 +1,110 @@
+/*
+ * Copyright 2023 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Definition of functions to check huge pages in the environment.
+ */
+#pragma once
+
+#include <cstddef>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#ifdef __linux__
+#include <sys/vfs.h>
+#endif
+
+namespace shm_stream_test {
+
+/*!
+ * \brief Get the size of huge pages used in buffer_layout::huge_pages layout.
+ *
+ * \return Size of huge pages.
+ */
+[[nodiscard]] constexpr std::size_t huge_page_size() noexcept {
+    constexpr std::size_t size = static_cast<std::size_t>(2U) * 1024U * 1024U;
+    return size;
+}
+
+/*!
+ * \brief Check whether hugetlbfs with free huge pages is available.
+ *
+ * \retval true hugetlbfs is available.
+ * \retval false hugetlbfs is not available.
+ */
+[[nodiscard]] inline bool is_hugetlbfs_available() {
+#ifdef __linux__
+    bool is_mounted = false;
+    std::ifstream mounts("/proc/mounts");
+    std::string line;
+    while (!is_mounted && std::getline(mounts, line)) {
+        std::istringstream stream(line);
+        std::string device;
+        std::string directory;
+        std::string type;
+        stream >> device >> directory >> type;
+        struct statfs status {};
+        is_mounted = type == "hugetlbfs" &&
+            ::statfs(directory.c_str(), &status) == 0 &&
+            static_cast<std::size_t>(status.f_bsize) == huge_page_size();
+    }
+    if (!is_mounted) {
+        return false;
+    }
+
+    std::ifstream meminfo("/proc/meminfo");
+    std::size_t num_free = 0U;
+    std::size_t num_reserved = 0U;
+    while (std::getline(meminfo, line)) {
+        std::istringstream stream(line);
+        std::string name;
+        std::size_t value = 0U;
+        stream >> name >> value;
+        if (name == "HugePages_Free:") {
+            num_free = value;
+        } else if (name == "HugePages_Rsvd:") {
+            num_reserved = value;
+        }
+    }
+    return num_free > num_reserved;
+#else
+    return false;
+#endif
+}
+
+/*!
+ * \brief Check whether transparent huge pages are disabled for shared memory.
+ *
+ * \retval true Transparent huge pages are disabled.
+ * \retval false Transparent huge pages may be used.
+ */
+[[nodiscard]] inline bool is_shmem_thp_disabled() {
+#ifdef __linux__
+    std::ifstream file("/sys/kernel/mm/transparent_hugepage/shmem_enabled");
+    std::string line;
+    if (!std::getline(file, line)) {
+        return true;
+    }
+    // The selected value is enclosed in brackets.
+    return line.find("[never]") != std::string::npos ||
+        line.find("[deny]") != std::string::npos;
+#else
+    return true;
+#endif
+}
+
+}  // namespace shm_stream_test
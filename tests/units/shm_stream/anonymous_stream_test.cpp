@@ -0,0 +1,273 @@
+/*
+ * Copyright 2023 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Test of anonymous streams of bytes.
+ */
+#include "shm_stream/anonymous_stream.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <string>
+
+#include <catch2/catch_test_macros.hpp>
+#include <dirent.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "shm_stream/c_interface/error_codes.h"
+#include "shm_stream/common_types.h"
+#include "shm_stream/shm_stream_exception.h"
+
+namespace {
+
+/*!
+ * \brief Write a string to a stream.
+ *
+ * \param[in] writer Writer.
+ * \param[in] data String.
+ */
+void write_string(
+    shm_stream::anonymous_stream_writer& writer, const std::string& data) {
+    const auto buffer = writer.try_reserve(data.size());
+    REQUIRE(buffer.size() == data.size());
+    std::copy(data.begin(), data.end(), buffer.data());
+    writer.commit(buffer.size());
+}
+
+/*!
+ * \brief Read a string from a stream.
+ *
+ * \param[in] reader Reader.
+ * \return String.
+ */
+std::string read_string(shm_stream::anonymous_stream_reader& reader) {
+    const auto buffer = reader.try_reserve();
+    std::string data{buffer.data(), buffer.size()};
+    reader.commit(buffer.size());
+    return data;
+}
+
+/*!
+ * \brief Check the error code of an exception thrown from a function.
+ *
+ * \tparam Function Type of the function.
+ * \param[in] function Function.
+ * \param[in] expected_code Expected error code.
+ */
+template <typename Function>
+void check_error_code(
+    Function&& function, c_shm_stream_error_code_t expected_code) {
+    try {
+        function();
+        FAIL();
+    } catch (const shm_stream::shm_stream_error& e) {
+        CHECK(e.code() == expected_code);
+    }
+}
+
+/*!
+ * \brief Count file descriptors opened in this process.
+ *
+ * \return Number of file descriptors.
+ */
+std::size_t count_fds() {
+    DIR* directory = ::opendir("/proc/self/fd");
+    REQUIRE(directory != nullptr);
+    std::size_t count = 0U;
+    while (::readdir(directory) != nullptr) {
+        ++count;
+    }
+    ::closedir(directory);
+    return count;
+}
+
+}  // namespace
+
+TEST_CASE("shm_stream::anonymous_stream") {
+    using shm_stream::anonymous_stream_handle;
+    using shm_stream::anonymous_stream_reader;
+    using shm_stream::anonymous_stream_writer;
+    using shm_stream::shm_stream_size_t;
+
+    SECTION("create a stream") {
+        constexpr shm_stream_size_t buffer_size = 10U;
+        const anonymous_stream_handle handle =
+            shm_stream::anonymous_stream::create(buffer_size);
+        CHECK(handle.is_valid());
+    }
+
+    SECTION("create a stream with a buffer of size zero") {
+        constexpr shm_stream_size_t buffer_size = 0U;
+        check_error_code(
+            [] {
+                (void)shm_stream::anonymous_stream::create(buffer_size);
+            },
+            c_shm_stream_error_code_invalid_argument);
+    }
+
+    SECTION("transfer bytes") {
+        constexpr shm_stream_size_t buffer_size = 10U;
+        anonymous_stream_handle handle =
+            shm_stream::anonymous_stream::create(buffer_size);
+        anonymous_stream_writer writer;
+        writer.open(handle);
+        CHECK(writer.is_opened());
+        anonymous_stream_reader reader;
+        reader.open(handle);
+        CHECK(reader.is_opened());
+
+        // Writers and readers keep the stream after the handle is closed.
+        handle.reset();
+        CHECK_FALSE(handle.is_valid());
+
+        CHECK(writer.available_size() == buffer_size - 1U);
+        CHECK(reader.available_size() == 0U);
+
+        write_string(writer, "abcdef");
+        CHECK(writer.available_size() == buffer_size - 7U);
+        CHECK(reader.available_size() == 6U);
+        CHECK(read_string(reader) == "abcdef");
+
+        write_string(writer, "ghij");
+        write_string(writer, "kl");
+        CHECK(read_string(reader) == "ghij");
+        CHECK(read_string(reader) == "kl");
+    }
+
+    SECTION("send a handle via a socket") {
+        int sockets[2] = {-1, -1};
+        REQUIRE(::socketpair(AF_UNIX, SOCK_STREAM, 0, sockets) == 0);
+
+        constexpr shm_stream_size_t buffer_size = 10U;
+        {
+            const anonymous_stream_handle handle =
+                shm_stream::anonymous_stream::create(buffer_size);
+            anonymous_stream_writer writer;
+            writer.open(handle);
+            write_string(writer, "abc");
+            shm_stream::anonymous_stream::send(sockets[0], handle);
+        }
+
+        const anonymous_stream_handle received =
+            shm_stream::anonymous_stream::receive(sockets[1]);
+        CHECK(received.is_valid());
+        anonymous_stream_reader reader;
+        reader.open(received);
+        CHECK(read_string(reader) == "abc");
+
+        ::close(sockets[0]);
+        ::close(sockets[1]);
+    }
+
+    SECTION("receive a handle from a closed socket") {
+        int sockets[2] = {-1, -1};
+        REQUIRE(::socketpair(AF_UNIX, SOCK_STREAM, 0, sockets) == 0);
+        ::close(sockets[0]);
+
+        check_error_code(
+            [&sockets] {
+                (void)shm_stream::anonymous_stream::receive(sockets[1]);
+            },
+            c_shm_stream_error_code_failed_to_transfer);
+
+        ::close(sockets[1]);
+    }
+
+    SECTION("receive a message with too many file descriptors") {
+        int sockets[2] = {-1, -1};
+        REQUIRE(::socketpair(AF_UNIX, SOCK_STREAM, 0, sockets) == 0);
+
+        // Send three file descriptors, which are more than expected.
+        constexpr std::size_t num_fds = 3U;
+        int fds[num_fds] = {sockets[0], sockets[0], sockets[0]};
+        char byte = 0;
+        ::iovec iov{&byte, 1U};
+        alignas(::cmsghdr) char control[CMSG_SPACE(sizeof(fds))] = {};
+        ::msghdr message{};
+        message.msg_iov = &iov;
+        message.msg_iovlen = 1U;
+        message.msg_control = control;
+        message.msg_controllen = sizeof(control);
+        ::cmsghdr* control_message = CMSG_FIRSTHDR(&message);
+        control_message->cmsg_level = SOL_SOCKET;
+        control_message->cmsg_type = SCM_RIGHTS;
+        control_message->cmsg_len = CMSG_LEN(sizeof(fds));
+        std::memcpy(CMSG_DATA(control_message), fds, sizeof(fds));
+        REQUIRE(::sendmsg(sockets[0], &message, 0) == 1);
+
+        const std::size_t num_fds_before = count_fds();
+        check_error_code(
+            [&sockets] {
+                (void)shm_stream::anonymous_stream::receive(sockets[1]);
+            },
+            c_shm_stream_error_code_failed_to_transfer);
+        CHECK(count_fds() == num_fds_before);
+
+        ::close(sockets[0]);
+        ::close(sockets[1]);
+    }
+
+    SECTION("open a stream with an invalid handle") {
+        const anonymous_stream_handle handle;
+        anonymous_stream_writer writer;
+        check_error_code([&writer, &handle] { writer.open(handle); },
+            c_shm_stream_error_code_invalid_argument);
+        CHECK_FALSE(writer.is_opened());
+    }
+
+    SECTION("open a stream with a file descriptor of another file") {
+        int sockets[2] = {-1, -1};
+        REQUIRE(::socketpair(AF_UNIX, SOCK_STREAM, 0, sockets) == 0);
+        const anonymous_stream_handle handle(sockets[0]);
+
+        anonymous_stream_reader reader;
+        check_error_code([&reader, &handle] { reader.open(handle); },
+            c_shm_stream_error_code_failed_to_open);
+        CHECK_FALSE(reader.is_opened());
+
+        ::close(sockets[1]);
+    }
+
+    SECTION("move a handle") {
+        constexpr shm_stream_size_t buffer_size = 10U;
+        anonymous_stream_handle handle =
+            shm_stream::anonymous_stream::create(buffer_size);
+        const int fd = handle.fd();
+
+        anonymous_stream_handle moved{std::move(handle)};
+        CHECK(moved.fd() == fd);
+        CHECK_FALSE(handle.is_valid());  // NOLINT
+
+        const int released = moved.release();
+        CHECK(released == fd);
+        CHECK_FALSE(moved.is_valid());
+        ::close(released);
+    }
+
+    SECTION("call functions for closed stream") {
+        anonymous_stream_writer writer;
+        CHECK(writer.available_size() == 0U);
+        CHECK(writer.try_reserve().size() == 0U);
+        CHECK_NOTHROW(writer.commit(0U));
+
+        anonymous_stream_reader reader;
+        CHECK(reader.available_size() == 0U);
+        CHECK(reader.try_reserve().size() == 0U);
+        CHECK_NOTHROW(reader.commit(0U));
+    }
+}
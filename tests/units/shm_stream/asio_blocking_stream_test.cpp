@@ -0,0 +1,171 @@
+/*
+ * Copyright 2023 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Test of asynchronous operations of blocking streams in asio.
+ */
+#include "shm_stream/asio_blocking_stream.h"
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include <asio/error.hpp>
+#include <asio/error_code.hpp>
+#include <asio/io_context.hpp>
+#include <boost/interprocess/shared_memory_object.hpp>
+#include <boost/interprocess/sync/named_mutex.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "shm_stream/blocking_stream.h"
+#include "shm_stream/bytes_view.h"
+#include "shm_stream/common_types.h"
+
+TEST_CASE("shm_stream::async_wait_reserve") {
+    using shm_stream::shm_stream_size_t;
+
+    const std::string stream_name = "asio_blocking_stream_test";
+    const auto remove_stream = [&stream_name] {
+        boost::interprocess::shared_memory_object::remove(
+            ("shm_stream_blocking_stream_data_" + stream_name).c_str());
+        boost::interprocess::named_mutex::remove(
+            ("shm_stream_blocking_stream_lock_" + stream_name).c_str());
+    };
+    remove_stream();
+
+    constexpr shm_stream_size_t buffer_size = 8U;
+    shm_stream::blocking_stream_writer writer;
+    writer.open(stream_name, buffer_size);
+    shm_stream::blocking_stream_reader reader;
+    reader.open(stream_name, buffer_size);
+    asio::io_context context;
+
+    SECTION("wait to reserve bytes to read") {
+        bool is_completed = false;
+        shm_stream::async_wait_reserve(context, reader, 3U,
+            [&is_completed](
+                const asio::error_code& error, shm_stream::bytes_view buffer) {
+                CHECK_FALSE(error);
+                CHECK(buffer.size() == 2U);
+                is_completed = true;
+            });
+        context.poll();
+        CHECK_FALSE(is_completed);
+
+        writer.commit(writer.try_reserve(2U).size());
+        context.run();
+        CHECK(is_completed);
+    }
+
+    SECTION("wait to reserve bytes to write") {
+        writer.commit(writer.try_reserve().size());
+        bool is_completed = false;
+        shm_stream::async_wait_reserve(context.get_executor(), writer, 3U,
+            [&is_completed](const asio::error_code& error,
+                shm_stream::mutable_bytes_view buffer) {
+                CHECK_FALSE(error);
+                CHECK(buffer.size() == 1U);
+                is_completed = true;
+            });
+        context.poll();
+        CHECK_FALSE(is_completed);
+
+        reader.commit(reader.try_reserve(1U).size());
+        context.run();
+        CHECK(is_completed);
+    }
+
+    SECTION("complete operations after the initiating functions") {
+        writer.commit(writer.try_reserve(1U).size());
+        bool is_completed = false;
+        shm_stream::async_wait_reserve(context, reader, 3U,
+            [&is_completed](const asio::error_code& error,
+                shm_stream::bytes_view /*buffer*/) {
+                CHECK_FALSE(error);
+                is_completed = true;
+            });
+        CHECK_FALSE(is_completed);
+
+        context.run();
+        CHECK(is_completed);
+    }
+
+    SECTION("write and read bytes larger than the buffer") {
+        std::string data;
+        for (std::size_t i = 0U; i < 100U; ++i) {
+            data.push_back(static_cast<char>('a' + i % 26U));
+        }
+
+        std::size_t written_size = 0U;
+        shm_stream::async_write_all(context, writer,
+            shm_stream::bytes_view(
+                data.data(), static_cast<shm_stream_size_t>(data.size())),
+            [&written_size](const asio::error_code& error, std::size_t size) {
+                CHECK_FALSE(error);
+                written_size = size;
+            });
+
+        std::string read_data;
+        std::vector<char> buffer(3U);
+        std::function<void(const asio::error_code&, std::size_t)> on_read;
+        const auto read_next = [&] {
+            shm_stream::async_read_some(context, reader,
+                shm_stream::mutable_bytes_view(buffer.data(),
+                    static_cast<shm_stream_size_t>(buffer.size())),
+                on_read);
+        };
+        on_read = [&](const asio::error_code& error, std::size_t size) {
+            REQUIRE_FALSE(error);
+            REQUIRE(size > 0U);
+            read_data.append(buffer.data(), size);
+            if (read_data.size() < data.size()) {
+                read_next();
+            }
+        };
+        read_next();
+        context.run();
+
+        CHECK(written_size == data.size());
+        CHECK(read_data == data);
+    }
+
+    SECTION("complete operations with errors after stop") {
+        asio::error_code read_error;
+        shm_stream::async_wait_reserve(context, reader, 1U,
+            [&read_error](const asio::error_code& error,
+                shm_stream::bytes_view /*buffer*/) { read_error = error; });
+        context.poll();
+
+        writer.stop();
+        context.run();
+        CHECK(read_error == asio::error::eof);
+
+        context.restart();
+        asio::error_code write_error;
+        const std::string data = "abc";
+        shm_stream::async_write_all(context, writer,
+            shm_stream::bytes_view(data.data(), 3U),
+            [&write_error](const asio::error_code& error,
+                std::size_t /*size*/) { write_error = error; });
+        context.run();
+        CHECK(write_error == asio::error::broken_pipe);
+    }
+
+    reader.close();
+    writer.close();
+    remove_stream();
+}
@@ -19,16 +19,27 @@
  */
 #include "shm_stream/blocking_stream.h"
 
+#include <algorithm>
+#include <array>
 #include <chrono>
 #include <future>
+#include <string>
 #include <thread>
+#include <vector>
 
+#include <boost/interprocess/mapped_region.hpp>
 #include <boost/interprocess/shared_memory_object.hpp>
 #include <boost/interprocess/sync/named_mutex.hpp>
 #include <catch2/catch_test_macros.hpp>
+#include <poll.h>
 
 #include "shm_stream/bytes_view.h"
+#include "shm_stream/c_interface/error_codes.h"
 #include "shm_stream/common_types.h"
+#include "shm_stream/doorbell.h"
+#include "shm_stream/shm_stream_exception.h"
+#include "shm_stream/wait_policy.h"
+#include "shm_stream_test/huge_pages.h"
 
 TEST_CASE("shm_stream::blocking_stream_writer") {
     using shm_stream::blocking_stream_writer;
@@ -49,6 +60,24 @@ TEST_CASE("shm_stream::blocking_stream_writer") {
         CHECK(writer.is_opened());
     }
 
+    SECTION("open a stream with a policy to wait") {
+        blocking_stream_writer writer;
+
+        constexpr shm_stream_size_t buffer_size = 10U;
+        writer.open(stream_name, buffer_size,
+            shm_stream::wait_policy(10U, 100U, 2U));  // NOLINT
+        CHECK(writer.is_opened());
+    }
+
+    SECTION("open a stream with an invalid policy to wait") {
+        blocking_stream_writer writer;
+
+        constexpr shm_stream_size_t buffer_size = 10U;
+        CHECK_THROWS(writer.open(stream_name, buffer_size,
+            shm_stream::wait_policy(100U, 10U, 0U)));  // NOLINT
+        CHECK_FALSE(writer.is_opened());
+    }
+
     SECTION("move construct") {
         blocking_stream_writer writer;
         constexpr shm_stream_size_t buffer_size = 10U;
@@ -194,6 +223,9 @@ TEST_CASE("shm_stream::blocking_stream_writer") {
         CHECK(writer.wait_reserve(1U).size() == 0U);  // NOLINT
         CHECK(writer.wait_reserve().size() == 0U);    // NOLINT
         CHECK_NOTHROW(writer.commit(1U));
+        CHECK_FALSE(
+            writer.wait_write_gather({shm_stream::bytes_view("a", 1U)}));
+        CHECK_FALSE(writer.write_all(shm_stream::bytes_view("a", 1U)));
     }
 
     boost::interprocess::shared_memory_object::remove(
@@ -225,6 +257,44 @@ TEST_CASE("shm_stream::blocking_stream_reader") {
         CHECK(reader.is_opened());
     }
 
+    SECTION("open a stream with options of memory") {
+        constexpr shm_stream_size_t buffer_size = 10U;
+        blocking_stream_writer writer;
+        writer.open(stream_name, buffer_size, shm_stream::wait_policy(),
+            shm_stream::memory_options::prefault);
+        blocking_stream_reader reader;
+        reader.open(stream_name, buffer_size, shm_stream::wait_policy(),
+            shm_stream::memory_options::prefault |
+                shm_stream::memory_options::lock);
+        REQUIRE(reader.is_opened());
+
+        const std::string data = "abc";
+        const auto write_buffer = writer.try_reserve();
+        std::copy(data.begin(), data.end(), write_buffer.data());
+        writer.commit(static_cast<shm_stream_size_t>(data.size()));
+
+        const auto read_buffer = reader.try_reserve();
+        CHECK(std::string(read_buffer.data(), read_buffer.size()) == data);
+    }
+
+    SECTION("open a stream with a policy to wait") {
+        blocking_stream_reader reader;
+
+        constexpr shm_stream_size_t buffer_size = 10U;
+        reader.open(stream_name, buffer_size,
+            shm_stream::wait_policy(10U, 100U, 2U));  // NOLINT
+        CHECK(reader.is_opened());
+    }
+
+    SECTION("open a stream with an invalid policy to wait") {
+        blocking_stream_reader reader;
+
+        constexpr shm_stream_size_t buffer_size = 10U;
+        CHECK_THROWS(reader.open(stream_name, buffer_size,
+            shm_stream::wait_policy(100U, 10U, 0U)));  // NOLINT
+        CHECK_FALSE(reader.is_opened());
+    }
+
     SECTION("move construct") {
         blocking_stream_reader reader;
         constexpr shm_stream_size_t buffer_size = 10U;
@@ -282,6 +352,30 @@ TEST_CASE("shm_stream::blocking_stream_reader") {
         CHECK(future.get() == 3U);
     }
 
+    SECTION("wait available bytes with spinning") {
+        blocking_stream_reader reader;
+        constexpr shm_stream_size_t buffer_size = 10U;
+        reader.open(stream_name, buffer_size,
+            shm_stream::wait_policy(100U, 10000U, 10U));  // NOLINT
+
+        std::promise<shm_stream_size_t> promise;
+        auto future = promise.get_future();
+        std::thread thread{[&reader, &promise] {
+            const auto available = reader.wait();
+            promise.set_value_at_thread_exit(available);
+        }};
+
+        blocking_stream_writer writer;
+        writer.open(stream_name, buffer_size);
+        (void)writer.try_reserve();
+        writer.commit(3U);
+
+        REQUIRE(future.wait_for(timeout) == std::future_status::ready);
+        thread.join();
+
+        CHECK(future.get() == 3U);
+    }
+
     SECTION("stop stream") {
         blocking_stream_reader reader;
         constexpr shm_stream_size_t buffer_size = 10U;
@@ -426,6 +520,89 @@ TEST_CASE("shm_stream::blocking_stream_reader") {
         CHECK(reader.available_size() == 1U);
     }
 
+    SECTION("transfer pieces of bytes at once") {
+        blocking_stream_reader reader;
+        constexpr shm_stream_size_t buffer_size = 10U;
+        reader.open(stream_name, buffer_size);
+        blocking_stream_writer writer;
+        writer.open(stream_name, buffer_size);
+        (void)writer.try_reserve();
+        writer.commit(7U);  // NOLINT
+        (void)reader.try_reserve();
+        reader.commit(7U);  // NOLINT
+
+        CHECK(writer.wait_write_gather({shm_stream::bytes_view("abc", 3U),
+            shm_stream::bytes_view("defg", 4U)}));  // NOLINT
+        CHECK(reader.available_size() == 7U);       // NOLINT
+
+        std::array<char, 4> first{};
+        std::array<char, 3> second{};
+        CHECK(reader.wait_read_scatter(
+            {shm_stream::mutable_bytes_view(first.data(), first.size()),
+                shm_stream::mutable_bytes_view(second.data(), second.size())}));
+        CHECK(std::string(first.data(), first.size()) == "abcd");
+        CHECK(std::string(second.data(), second.size()) == "efg");
+        CHECK(reader.available_size() == 0U);
+    }
+
+    SECTION("transfer a large byte sequence in parts") {
+        blocking_stream_reader reader;
+        constexpr shm_stream_size_t buffer_size = 64U * 1024U;  // NOLINT
+        reader.open(stream_name, buffer_size);
+        blocking_stream_writer writer;
+        writer.open(stream_name, buffer_size);
+
+        constexpr shm_stream_size_t data_size =
+            2U * 1024U * 1024U + 3U;  // NOLINT
+        std::vector<char> data(data_size);
+        for (std::size_t i = 0; i < data.size(); ++i) {
+            data[i] = static_cast<char>(i % 251U);  // NOLINT
+        }
+
+        std::promise<bool> promise;
+        auto future = promise.get_future();
+        std::thread thread{[&writer, &data, &promise] {
+            const bool result = writer.write_all(
+                shm_stream::bytes_view(data.data(), data_size));
+            promise.set_value_at_thread_exit(result);
+        }};
+
+        std::vector<char> received(data_size);
+        CHECK(reader.read_exact(
+            shm_stream::mutable_bytes_view(received.data(), data_size)));
+
+        REQUIRE(future.wait_for(timeout) == std::future_status::ready);
+        thread.join();
+
+        CHECK(future.get());
+        CHECK(received == data);
+    }
+
+    SECTION("stop reading bytes filling a buffer") {
+        blocking_stream_reader reader;
+        constexpr shm_stream_size_t buffer_size = 10U;
+        reader.open(stream_name, buffer_size);
+
+        std::promise<bool> promise;
+        auto future = promise.get_future();
+        std::thread thread{[&reader, &promise] {
+            std::array<char, 5> buffer{};
+            const bool result = reader.read_exact(
+                shm_stream::mutable_bytes_view(buffer.data(), buffer.size()));
+            promise.set_value_at_thread_exit(result);
+        }};
+
+        blocking_stream_writer writer;
+        writer.open(stream_name, buffer_size);
+        CHECK(writer.write_all(shm_stream::bytes_view("abc", 3U)));
+        writer.stop();
+
+        REQUIRE(future.wait_for(timeout) == std::future_status::ready);
+        thread.join();
+
+        CHECK_FALSE(future.get());
+    }
+
     SECTION("call functions for closed stream") {
         blocking_stream_reader reader;
 
@@ -438,6 +615,11 @@ TEST_CASE("shm_stream::blocking_stream_reader") {
         CHECK(reader.wait_reserve(1U).size() == 0U);  // NOLINT
         CHECK(reader.wait_reserve().size() == 0U);    // NOLINT
         CHECK_NOTHROW(reader.commit(1U));
+        char byte{};
+        CHECK_FALSE(reader.wait_read_scatter(
+            {shm_stream::mutable_bytes_view(&byte, 1U)}));
+        CHECK_FALSE(
+            reader.read_exact(shm_stream::mutable_bytes_view(&byte, 1U)));
     }
 
     boost::interprocess::shared_memory_object::remove(
@@ -466,6 +648,176 @@ TEST_CASE("shm_stream::blocking_stream") {
             ("shm_stream_blocking_stream_lock_" + stream_name).c_str()));
     }
 
+    SECTION("create a stream with a mirrored buffer") {
+        const auto buffer_size = static_cast<shm_stream_size_t>(
+            boost::interprocess::mapped_region::get_page_size());
+        shm_stream::blocking_stream::create(
+            stream_name, buffer_size, shm_stream::buffer_layout::mirrored);
+        shm_stream::blocking_stream_writer writer;
+        writer.open(stream_name, buffer_size);
+        shm_stream::blocking_stream_reader reader;
+        reader.open(stream_name, buffer_size);
+
+        constexpr shm_stream_size_t first_size = 10U;
+        writer.commit(writer.try_reserve(first_size).size());
+        reader.commit(reader.try_reserve().size());
+
+        const auto write_buffer = writer.try_reserve();
+        REQUIRE(write_buffer.size() == buffer_size - 1U);
+        for (shm_stream_size_t i = 0U; i < write_buffer.size(); ++i) {
+            write_buffer.data()[i] = static_cast<char>(i);
+        }
+        writer.commit(write_buffer.size());
+
+        const auto read_buffer = reader.try_reserve();
+        REQUIRE(read_buffer.size() == buffer_size - 1U);
+        bool is_same = true;
+        for (shm_stream_size_t i = 0U; i < read_buffer.size(); ++i) {
+            is_same =
+                is_same && (read_buffer.data()[i] == static_cast<char>(i));
+        }
+        CHECK(is_same);
+        reader.commit(read_buffer.size());
+        CHECK(reader.available_size() == 0U);
+    }
+
+    SECTION("create a stream with a buffer on huge pages") {
+        constexpr shm_stream_size_t buffer_size = 100U;
+        shm_stream::blocking_stream::create(
+            stream_name, buffer_size, shm_stream::buffer_layout::huge_pages);
+        shm_stream::blocking_stream_writer writer;
+        writer.open(stream_name, buffer_size);
+        shm_stream::blocking_stream_reader reader;
+        reader.open(stream_name, buffer_size);
+
+        const auto write_buffer = writer.try_reserve();
+        REQUIRE(write_buffer.size() == buffer_size - 1U);
+        for (shm_stream_size_t i = 0U; i < write_buffer.size(); ++i) {
+            write_buffer.data()[i] = static_cast<char>(i);
+        }
+        writer.commit(write_buffer.size());
+
+        const auto read_buffer = reader.try_reserve();
+        REQUIRE(read_buffer.size() == buffer_size - 1U);
+        bool is_same = true;
+        for (shm_stream_size_t i = 0U; i < read_buffer.size(); ++i) {
+            is_same =
+                is_same && (read_buffer.data()[i] == static_cast<char>(i));
+        }
+        CHECK(is_same);
+        reader.commit(read_buffer.size());
+
+        const auto normal_page_size = static_cast<shm_stream_size_t>(
+            boost::interprocess::mapped_region::get_page_size());
+        const auto huge_page_size =
+            static_cast<shm_stream_size_t>(shm_stream_test::huge_page_size());
+        if (shm_stream_test::is_hugetlbfs_available()) {
+            CHECK(writer.page_size() == huge_page_size);
+            CHECK(reader.page_size() == huge_page_size);
+        } else if (shm_stream_test::is_shmem_thp_disabled()) {
+            CHECK(writer.page_size() == normal_page_size);
+            CHECK(reader.page_size() == normal_page_size);
+        } else {
+            // Transparent huge pages are not guaranteed to be allocated.
+            CHECK((writer.page_size() == huge_page_size ||
+                writer.page_size() == normal_page_size));
+            CHECK(reader.page_size() == writer.page_size());
+        }
+
+        // Files in hugetlbfs are removed only with the stream.
+        writer.close();
+        reader.close();
+        shm_stream::blocking_stream::remove(stream_name);
+    }
+
+    SECTION("get the page size of a stream") {
+        constexpr shm_stream_size_t buffer_size = 100U;
+        shm_stream::blocking_stream_writer writer;
+        CHECK(writer.page_size() == 0U);
+
+        writer.open(stream_name, buffer_size);
+        CHECK(writer.page_size() ==
+            static_cast<shm_stream_size_t>(
+                boost::interprocess::mapped_region::get_page_size()));
+    }
+
+    SECTION("create a stream on a NUMA node") {
+        constexpr shm_stream_size_t buffer_size = 100U;
+        try {
+            shm_stream::blocking_stream::create(stream_name, buffer_size,
+                shm_stream::buffer_layout::plain,
+                shm_stream::numa_node_current);
+        } catch (const shm_stream::shm_stream_error& e) {
+            // NUMA policies can be unavailable in some environments.
+            CHECK(e.code() == c_shm_stream_error_code_not_supported);
+            return;
+        }
+        shm_stream::blocking_stream_writer writer;
+        writer.open(stream_name, buffer_size);
+        CHECK(writer.numa_node() >= 0);
+    }
+
+    SECTION("create a stream on an invalid NUMA node") {
+        constexpr shm_stream_size_t buffer_size = 100U;
+        constexpr shm_stream::numa_node_t invalid_numa_node = 1023;
+        CHECK_THROWS(shm_stream::blocking_stream::create(stream_name,
+            buffer_size, shm_stream::buffer_layout::plain, invalid_numa_node));
+
+        CHECK_FALSE(boost::interprocess::shared_memory_object::remove(
+            ("shm_stream_blocking_stream_data_" + stream_name).c_str()));
+    }
+
+    SECTION("create an existing stream on an invalid NUMA node") {
+        constexpr shm_stream_size_t buffer_size = 100U;
+        shm_stream::blocking_stream::create(stream_name, buffer_size);
+
+        // Pages of existing streams are not bound again.
+        constexpr shm_stream::numa_node_t invalid_numa_node = 1023;
+        CHECK_NOTHROW(shm_stream::blocking_stream::create(stream_name,
+            buffer_size, shm_stream::buffer_layout::plain, invalid_numa_node));
+    }
+
+    SECTION("create a stream with a mirrored buffer of an invalid size") {
+        constexpr shm_stream_size_t buffer_size = 10U;
+        CHECK_THROWS(shm_stream::blocking_stream::create(
+            stream_name, buffer_size, shm_stream::buffer_layout::mirrored));
+    }
+
+    SECTION("wait for a doorbell") {
+        constexpr shm_stream_size_t buffer_size = 10U;
+        shm_stream::blocking_stream_writer writer;
+        writer.open(stream_name, buffer_size);
+        shm_stream::blocking_stream_reader reader;
+        reader.open(stream_name, buffer_size);
+        const auto bell = shm_stream::doorbell::create();
+        writer.set_doorbell(bell);
+        reader.set_doorbell(bell);
+        ::pollfd fd{bell.fd(), POLLIN, 0};
+
+        // Doorbell is not rung without arming.
+        writer.commit(writer.try_reserve(1U).size());
+        CHECK(::poll(&fd, 1, 0) == 0);
+        CHECK_FALSE(reader.arm_doorbell());
+        reader.commit(reader.try_reserve().size());
+
+        CHECK(reader.arm_doorbell());
+        CHECK(::poll(&fd, 1, 0) == 0);
+        writer.commit(writer.try_reserve(3U).size());
+        CHECK(::poll(&fd, 1, 0) == 1);
+        CHECK(reader.available_size() == 3U);
+        reader.commit(reader.try_reserve().size());
+
+        // Arming clears the last notification.
+        CHECK(reader.arm_doorbell());
+        CHECK(::poll(&fd, 1, 0) == 0);
+
+        // Stop of the stream also rings the doorbell.
+        CHECK(reader.arm_doorbell());
+        writer.stop();
+        CHECK(::poll(&fd, 1, 0) == 1);
+        CHECK_FALSE(reader.arm_doorbell());
+    }
+
     SECTION("remove a stream") {
         constexpr shm_stream_size_t buffer_size = 10U;
         shm_stream::blocking_stream::create(stream_name, buffer_size);
@@ -482,3 +834,91 @@ TEST_CASE("shm_stream::blocking_stream") {
     boost::interprocess::named_mutex::remove(
         ("shm_stream_blocking_stream_lock_" + stream_name).c_str());
 }
+
+TEST_CASE("shm_stream::wait_any") {
+    using shm_stream::shm_stream_size_t;
+
+    const std::string stream_name1 = "blocking_stream_wait_any_test1";
+    const std::string stream_name2 = "blocking_stream_wait_any_test2";
+    const auto remove_streams = [&stream_name1, &stream_name2] {
+        for (const auto& stream_name : {stream_name1, stream_name2}) {
+            boost::interprocess::shared_memory_object::remove(
+                ("shm_stream_blocking_stream_data_" + stream_name).c_str());
+            boost::interprocess::named_mutex::remove(
+                ("shm_stream_blocking_stream_lock_" + stream_name).c_str());
+        }
+    };
+    remove_streams();
+
+    constexpr shm_stream_size_t buffer_size = 10U;
+    shm_stream::blocking_stream_writer writer1;
+    writer1.open(stream_name1, buffer_size);
+    shm_stream::blocking_stream_writer writer2;
+    writer2.open(stream_name2, buffer_size);
+    shm_stream::blocking_stream_reader reader1;
+    reader1.open(stream_name1, buffer_size);
+    shm_stream::blocking_stream_reader reader2;
+    reader2.open(stream_name2, buffer_size);
+
+    SECTION("get ready readers without waiting") {
+        writer2.commit(writer2.try_reserve(1U).size());
+
+        const auto ready = shm_stream::wait_any({&reader1, &reader2});
+        CHECK(ready == std::vector<shm_stream_size_t>{1U});
+    }
+
+    SECTION("wait until a timeout") {
+        constexpr auto timeout = std::chrono::milliseconds(10);
+        const auto start = std::chrono::steady_clock::now();
+        const auto ready = shm_stream::wait_any({&reader1, &reader2}, timeout);
+        const auto end = std::chrono::steady_clock::now();
+
+        CHECK(ready.empty());
+        CHECK(end - start >= timeout);
+    }
+
+    SECTION("wait for bytes in one of streams") {
+        std::promise<std::vector<shm_stream_size_t>> promise;
+        auto future = promise.get_future();
+        std::thread thread{[&reader1, &reader2, &promise] {
+            promise.set_value(shm_stream::wait_any({&reader1, &reader2}));
+        }};
+
+        constexpr auto wait_duration = std::chrono::milliseconds(10);
+        CHECK(future.wait_for(wait_duration) == std::future_status::timeout);
+        writer2.commit(writer2.try_reserve(1U).size());
+        CHECK(future.wait_for(std::chrono::seconds(1)) ==
+            std::future_status::ready);
+        CHECK(future.get() == std::vector<shm_stream_size_t>{1U});
+        thread.join();
+    }
+
+    SECTION("wait for stop of one of streams") {
+        std::promise<std::vector<shm_stream_size_t>> promise;
+        auto future = promise.get_future();
+        std::thread thread{[&reader1, &reader2, &promise] {
+            promise.set_value(shm_stream::wait_any({&reader1, &reader2}));
+        }};
+
+        constexpr auto wait_duration = std::chrono::milliseconds(10);
+        CHECK(future.wait_for(wait_duration) == std::future_status::timeout);
+        writer1.stop();
+        CHECK(future.wait_for(std::chrono::seconds(1)) ==
+            std::future_status::ready);
+        CHECK(future.get() == std::vector<shm_stream_size_t>{0U});
+        thread.join();
+    }
+
+    SECTION("treat closed readers as ready") {
+        reader1.close();
+
+        const auto ready = shm_stream::wait_any({&reader1, &reader2});
+        CHECK(ready == std::vector<shm_stream_size_t>{0U});
+    }
+
+    reader1.close();
+    reader2.close();
+    writer1.close();
+    writer2.close();
+    remove_streams();
+}
@@ -0,0 +1,134 @@
+/*
+ * Copyright 2023 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Test of broadcast streams of bytes without waiting (possibly
+ * lock-free).
+ */
+#include "shm_stream/broadcast_stream.h"
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include <boost/interprocess/shared_memory_object.hpp>
+#include <boost/interprocess/sync/named_mutex.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+TEST_CASE("shm_stream::broadcast_stream") {
+    using shm_stream::broadcast_stream_reader;
+    using shm_stream::broadcast_stream_writer;
+    using shm_stream::shm_stream_size_t;
+
+    const std::string stream_name = "broadcast_stream_test";
+    boost::interprocess::shared_memory_object::remove(
+        ("shm_stream_broadcast_stream_data_" + stream_name).c_str());
+    boost::interprocess::named_mutex::remove(
+        ("shm_stream_broadcast_stream_lock_" + stream_name).c_str());
+
+    constexpr shm_stream_size_t buffer_size = 10U;
+
+    SECTION("open streams") {
+        broadcast_stream_writer writer;
+        broadcast_stream_reader reader;
+        CHECK_FALSE(writer.is_opened());
+        CHECK_FALSE(reader.is_opened());
+
+        writer.open(stream_name, buffer_size);
+        reader.open(stream_name, buffer_size);
+        CHECK(writer.is_opened());
+        CHECK(reader.is_opened());
+
+        writer.close();
+        reader.close();
+        CHECK_FALSE(writer.is_opened());
+        CHECK_FALSE(reader.is_opened());
+    }
+
+    SECTION("send bytes to multiple readers") {
+        broadcast_stream_writer writer;
+        writer.open(stream_name, buffer_size);
+        broadcast_stream_reader reader1;
+        reader1.open(stream_name, buffer_size);
+        broadcast_stream_reader reader2;
+        reader2.open(stream_name, buffer_size);
+
+        const std::string data = "abcde";
+        const auto write_buffer = writer.try_reserve(
+            static_cast<shm_stream_size_t>(data.size()));
+        REQUIRE(write_buffer.size() == data.size());
+        std::copy(data.begin(), data.end(), write_buffer.data());
+        writer.commit(write_buffer.size());
+
+        for (auto* reader : {&reader1, &reader2}) {
+            const auto read_buffer = reader->try_reserve();
+            CHECK(std::string(read_buffer.data(), read_buffer.size()) == data);
+            reader->commit(read_buffer.size());
+        }
+        CHECK(writer.available_size() == buffer_size - 1U);
+    }
+
+    SECTION("wait for the slowest reader") {
+        broadcast_stream_writer writer;
+        writer.open(stream_name, buffer_size);
+        broadcast_stream_reader reader;
+        reader.open(stream_name, buffer_size);
+
+        writer.commit(writer.try_reserve().size());
+        CHECK(writer.available_size() == 0U);
+
+        reader.close();
+        CHECK(writer.available_size() == buffer_size - 1U);
+    }
+
+    SECTION("attach too many readers") {
+        std::vector<broadcast_stream_reader> readers(
+            shm_stream::broadcast_stream::max_readers());
+        for (auto& reader : readers) {
+            reader.open(stream_name, buffer_size);
+        }
+
+        broadcast_stream_reader reader;
+        CHECK_THROWS(reader.open(stream_name, buffer_size));
+    }
+
+    SECTION("call functions for closed stream") {
+        broadcast_stream_writer writer;
+        broadcast_stream_reader reader;
+
+        CHECK(writer.available_size() == 0U);
+        CHECK(writer.try_reserve().size() == 0U);
+        CHECK_NOTHROW(writer.commit(1U));
+        CHECK(reader.available_size() == 0U);
+        CHECK(reader.try_reserve().size() == 0U);
+        CHECK_NOTHROW(reader.commit(1U));
+    }
+
+    SECTION("create and remove a stream") {
+        shm_stream::broadcast_stream::create(stream_name, buffer_size);
+        shm_stream::broadcast_stream::remove(stream_name);
+
+        CHECK_FALSE(boost::interprocess::shared_memory_object::remove(
+            ("shm_stream_broadcast_stream_data_" + stream_name).c_str()));
+        CHECK_FALSE(boost::interprocess::named_mutex::remove(
+            ("shm_stream_broadcast_stream_lock_" + stream_name).c_str()));
+    }
+
+    boost::interprocess::shared_memory_object::remove(
+        ("shm_stream_broadcast_stream_data_" + stream_name).c_str());
+    boost::interprocess::named_mutex::remove(
+        ("shm_stream_broadcast_stream_lock_" + stream_name).c_str());
+}
@@ -17,10 +17,40 @@
  * \file
  * \brief Test of C headers.
  */
+#include "shm_stream/c_interface/anonymous_stream_common.h"
+#include "shm_stream/c_interface/anonymous_stream_reader.h"
+#include "shm_stream/c_interface/anonymous_stream_writer.h"
+#include "shm_stream/c_interface/broadcast_stream_common.h"
+#include "shm_stream/c_interface/broadcast_stream_reader.h"
+#include "shm_stream/c_interface/broadcast_stream_writer.h"
 #include "shm_stream/c_interface/bytes_view.h"
+#include "shm_stream/c_interface/chunk_stream_common.h"
+#include "shm_stream/c_interface/chunk_stream_reader.h"
+#include "shm_stream/c_interface/chunk_stream_writer.h"
 #include "shm_stream/c_interface/common_types.h"
+#include "shm_stream/c_interface/doorbell.h"
 #include "shm_stream/c_interface/error_codes.h"
+#include "shm_stream/c_interface/file_stream_common.h"
+#include "shm_stream/c_interface/file_stream_reader.h"
+#include "shm_stream/c_interface/file_stream_writer.h"
+#include "shm_stream/c_interface/flush_policy.h"
+#include "shm_stream/c_interface/light_message_stream_common.h"
+#include "shm_stream/c_interface/light_message_stream_reader.h"
+#include "shm_stream/c_interface/light_message_stream_writer.h"
+#include "shm_stream/c_interface/light_stream64_common.h"
+#include "shm_stream/c_interface/light_stream64_reader.h"
+#include "shm_stream/c_interface/light_stream64_writer.h"
 #include "shm_stream/c_interface/light_stream_common.h"
 #include "shm_stream/c_interface/light_stream_reader.h"
 #include "shm_stream/c_interface/light_stream_writer.h"
+#include "shm_stream/c_interface/lossy_stream_common.h"
+#include "shm_stream/c_interface/lossy_stream_reader.h"
+#include "shm_stream/c_interface/lossy_stream_writer.h"
+#include "shm_stream/c_interface/mpsc_stream_common.h"
+#include "shm_stream/c_interface/mpsc_stream_reader.h"
+#include "shm_stream/c_interface/mpsc_stream_writer.h"
+#include "shm_stream/c_interface/snapshot_channel_common.h"
+#include "shm_stream/c_interface/snapshot_channel_reader.h"
+#include "shm_stream/c_interface/snapshot_channel_writer.h"
 #include "shm_stream/c_interface/string_view.h"
+#include "shm_stream/c_interface/wait_policy.h"
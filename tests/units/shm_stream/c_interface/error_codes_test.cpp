@@ -37,8 +37,18 @@ TEST_CASE("c_shm_stream_error_message") {
             "Failed to create or open a stream.");
         CHECK(to_message(c_shm_stream_error_code_internal_error) ==
             "Internal error.");
+        CHECK(to_message(c_shm_stream_error_code_not_supported) ==
+            "Operation not supported in the current environment.");
+        CHECK(to_message(c_shm_stream_error_code_too_many_readers) ==
+            "Too many readers attached to a stream.");
+        CHECK(to_message(c_shm_stream_error_code_type_mismatch) ==
+            "Mismatched type of elements in a stream.");
+        CHECK(to_message(c_shm_stream_error_code_failed_to_lock_memory) ==
+            "Failed to lock memory.");
+        CHECK(to_message(c_shm_stream_error_code_failed_to_transfer) ==
+            "Failed to transfer a handle of a stream to another process.");
         CHECK(to_message(static_cast<c_shm_stream_error_code_t>(
-                  c_shm_stream_error_code_internal_error + 1)) ==
+                  c_shm_stream_error_code_failed_to_transfer + 1)) ==
             "Invalid error code.");
     }
 }
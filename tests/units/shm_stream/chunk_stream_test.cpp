@@ -0,0 +1,136 @@
+/*
+ * Copyright 2023 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Test of streams of chunks.
+ */
+#include "shm_stream/chunk_stream.h"
+
+#include <cstring>
+#include <string>
+
+#include <boost/interprocess/shared_memory_object.hpp>
+#include <boost/interprocess/sync/named_mutex.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+TEST_CASE("shm_stream::chunk_stream") {
+    using shm_stream::chunk_stream_reader;
+    using shm_stream::chunk_stream_writer;
+    using shm_stream::shm_stream_size_t;
+
+    const std::string stream_name = "chunk_stream_test";
+    boost::interprocess::shared_memory_object::remove(
+        ("shm_stream_chunk_stream_data_" + stream_name).c_str());
+    boost::interprocess::named_mutex::remove(
+        ("shm_stream_chunk_stream_lock_" + stream_name).c_str());
+
+    constexpr shm_stream_size_t num_chunks = 4U;
+    constexpr shm_stream_size_t chunk_size = 1000U;
+
+    SECTION("open streams") {
+        chunk_stream_writer writer;
+        chunk_stream_reader reader;
+        CHECK_FALSE(writer.is_opened());
+        CHECK_FALSE(reader.is_opened());
+
+        writer.open(stream_name, num_chunks, chunk_size);
+        reader.open(stream_name, num_chunks, chunk_size);
+        CHECK(writer.is_opened());
+        CHECK(reader.is_opened());
+        CHECK(writer.chunk_size() == chunk_size);
+
+        writer.close();
+        reader.close();
+        CHECK_FALSE(writer.is_opened());
+        CHECK_FALSE(reader.is_opened());
+    }
+
+    SECTION("open a stream with invalid parameters") {
+        chunk_stream_writer writer;
+        CHECK_THROWS(writer.open(stream_name, 0U, chunk_size));
+        CHECK_THROWS(writer.open(stream_name, num_chunks, 0U));
+    }
+
+    SECTION("send chunks") {
+        chunk_stream_writer writer;
+        writer.open(stream_name, num_chunks, chunk_size);
+        chunk_stream_reader reader;
+        reader.open(stream_name, num_chunks, chunk_size);
+
+        constexpr shm_stream_size_t num_messages = 20U;
+        for (shm_stream_size_t i = 0U; i < num_messages; ++i) {
+            const std::string message(i * 50U, static_cast<char>('a' + i));
+            const auto chunk = writer.try_allocate();
+            REQUIRE(chunk.data() != nullptr);
+            REQUIRE(chunk.size() == chunk_size);
+            std::memcpy(chunk.data(), message.data(), message.size());
+            writer.send(chunk, static_cast<shm_stream_size_t>(message.size()));
+
+            const auto received = reader.try_receive();
+            REQUIRE(received.data() != nullptr);
+            CHECK(std::string(received.data(), received.size()) == message);
+            reader.release(received);
+        }
+        CHECK(reader.try_receive().data() == nullptr);
+    }
+
+    SECTION("run out of chunks") {
+        chunk_stream_writer writer;
+        writer.open(stream_name, num_chunks, chunk_size);
+        chunk_stream_reader reader;
+        reader.open(stream_name, num_chunks, chunk_size);
+
+        for (shm_stream_size_t i = 0U; i < num_chunks; ++i) {
+            const auto chunk = writer.try_allocate();
+            REQUIRE(chunk.data() != nullptr);
+            writer.send(chunk, 0U);
+        }
+        CHECK(writer.try_allocate().data() == nullptr);
+
+        const auto received = reader.try_receive();
+        REQUIRE(received.data() != nullptr);
+        reader.release(received);
+        CHECK(writer.try_allocate().data() != nullptr);
+        CHECK(writer.try_allocate().data() == nullptr);
+    }
+
+    SECTION("call functions for closed stream") {
+        chunk_stream_writer writer;
+        chunk_stream_reader reader;
+
+        CHECK(writer.chunk_size() == 0U);
+        CHECK(writer.try_allocate().data() == nullptr);
+        CHECK_NOTHROW(
+            writer.send(shm_stream::mutable_bytes_view(nullptr, 0U), 0U));
+        CHECK(reader.try_receive().data() == nullptr);
+        CHECK_NOTHROW(reader.release(shm_stream::bytes_view(nullptr, 0U)));
+    }
+
+    SECTION("create and remove a stream") {
+        shm_stream::chunk_stream::create(stream_name, num_chunks, chunk_size);
+        shm_stream::chunk_stream::remove(stream_name);
+
+        CHECK_FALSE(boost::interprocess::shared_memory_object::remove(
+            ("shm_stream_chunk_stream_data_" + stream_name).c_str()));
+        CHECK_FALSE(boost::interprocess::named_mutex::remove(
+            ("shm_stream_chunk_stream_lock_" + stream_name).c_str()));
+    }
+
+    boost::interprocess::shared_memory_object::remove(
+        ("shm_stream_chunk_stream_data_" + stream_name).c_str());
+    boost::interprocess::named_mutex::remove(
+        ("shm_stream_chunk_stream_lock_" + stream_name).c_str());
+}
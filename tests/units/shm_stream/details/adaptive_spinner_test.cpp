@@ -0,0 +1,170 @@
+/*
+ * Copyright 2023 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Test of adaptive_spinner class.
+ */
+#include "shm_stream/details/adaptive_spinner.h"
+
+#include <chrono>
+#include <cstdint>
+#include <future>
+#include <thread>
+
+#include <boost/atomic/ipc_atomic.hpp>
+#include <boost/memory_order.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "shm_stream/common_types.h"
+#include "shm_stream/wait_policy.h"
+
+namespace {
+
+/*!
+ * \brief Class of variables changing after a given number of loads.
+ */
+class variable_changing_after_loads {
+public:
+    //! Type of values.
+    using value_type = shm_stream::shm_stream_size_t;
+
+    /*!
+     * \brief Set the number of loads before the change.
+     *
+     * \param[in] num_loads Number of loads returning the unchanged value.
+     */
+    void reset(std::uint32_t num_loads) noexcept {
+        num_unchanged_loads_ = num_loads;
+    }
+
+    /*!
+     * \brief Load the value.
+     *
+     * \return Value. (2 before the change, 3 after the change.)
+     */
+    value_type load(boost::memory_order /*order*/) const noexcept {
+        if (num_unchanged_loads_ > 0U) {
+            --num_unchanged_loads_;
+            return 2U;
+        }
+        return 3U;
+    }
+
+private:
+    //! Number of remaining loads returning the unchanged value.
+    mutable std::uint32_t num_unchanged_loads_{0U};
+};
+
+}  // namespace
+
+TEST_CASE("shm_stream::details::adaptive_spinner") {
+    using shm_stream::shm_stream_size_t;
+    using shm_stream::wait_policy;
+    using shm_stream::details::adaptive_spinner;
+
+    using atomic_type = boost::atomics::ipc_atomic<shm_stream_size_t>;
+
+    SECTION("check policy in constructor") {
+        CHECK_NOTHROW(adaptive_spinner(wait_policy()));
+        CHECK_NOTHROW(adaptive_spinner(wait_policy(1U, 1U, 0U)));
+        CHECK_NOTHROW(adaptive_spinner(wait_policy(1U, 2U, 0U)));
+        CHECK_THROWS(adaptive_spinner(wait_policy(2U, 1U, 0U)));
+    }
+
+    SECTION("start from the maximum number of iterations") {
+        const adaptive_spinner spinner{wait_policy(10U, 100U, 0U)};  // NOLINT
+
+        CHECK(spinner.spin_count() == 100U);  // NOLINT
+    }
+
+    SECTION("return immediately when the value is already changed") {
+        adaptive_spinner spinner{wait_policy(10U, 100U, 0U)};  // NOLINT
+        atomic_type variable{3U};
+
+        shm_stream_size_t value = 0U;
+        CHECK(spinner.spin(variable, 2U, value));
+        CHECK(value == 3U);
+        CHECK(spinner.spin_count() < 100U);  // NOLINT
+    }
+
+    SECTION("decrease the number of iterations when the value doesn't change") {
+        adaptive_spinner spinner{wait_policy(10U, 100U, 1U)};  // NOLINT
+        atomic_type variable{2U};
+
+        shm_stream_size_t value = 0U;
+        for (int i = 0; i < 100; ++i) {  // NOLINT
+            CHECK_FALSE(spinner.spin(variable, 2U, value));
+        }
+        CHECK(spinner.spin_count() >= 10U);  // NOLINT
+        CHECK(spinner.spin_count() < 20U);   // NOLINT
+    }
+
+    SECTION("converge to the minimum and maximum numbers of iterations") {
+        adaptive_spinner spinner{wait_policy(10U, 100U, 1U)};  // NOLINT
+
+        // Values never changing lead to the minimum.
+        atomic_type variable{2U};
+        shm_stream_size_t value = 0U;
+        for (int i = 0; i < 100; ++i) {  // NOLINT
+            CHECK_FALSE(spinner.spin(variable, 2U, value));
+        }
+        CHECK(spinner.spin_count() == 10U);  // NOLINT
+
+        // Values changing only while yielding lead to the maximum.
+        variable_changing_after_loads changing_variable;
+        for (int i = 0; i < 100; ++i) {  // NOLINT
+            changing_variable.reset(spinner.spin_count());
+            CHECK(spinner.spin(changing_variable, 2U, value));
+        }
+        CHECK(spinner.spin_count() == 100U);  // NOLINT
+    }
+
+    SECTION("keep the number of iterations when not adaptive") {
+        adaptive_spinner spinner{wait_policy(100U, 100U, 0U)};  // NOLINT
+        atomic_type variable{2U};
+
+        shm_stream_size_t value = 0U;
+        CHECK_FALSE(spinner.spin(variable, 2U, value));
+        CHECK(spinner.spin_count() == 100U);  // NOLINT
+    }
+
+    SECTION("never spin with the default policy") {
+        adaptive_spinner spinner{};
+        atomic_type variable{2U};
+
+        shm_stream_size_t value = 0U;
+        CHECK_FALSE(spinner.spin(variable, 2U, value));
+        CHECK(spinner.spin_count() == 0U);
+    }
+
+    SECTION("detect changes from another thread") {
+        adaptive_spinner spinner{
+            wait_policy(1000U, 1000000U, 1000000U)};  // NOLINT
+        atomic_type variable{2U};
+
+        std::thread thread{[&variable] {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            variable.store(5U);  // NOLINT
+        }};
+
+        shm_stream_size_t value = 0U;
+        const bool changed = spinner.spin(variable, 2U, value);
+        thread.join();
+
+        CHECK(changed);
+        CHECK(value == 5U);
+    }
+}
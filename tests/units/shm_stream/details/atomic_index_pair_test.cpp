@@ -31,4 +31,13 @@ TEST_CASE("shm_stream::details::atomic_index_pair") {
         STATIC_CHECK(alignof(atomic_index_pair<>) == cache_line_size());
         STATIC_CHECK(sizeof(atomic_index_pair<>) == 2U * cache_line_size());
     }
+
+    SECTION("initialize variables") {
+        atomic_index_pair<> indices;
+
+        CHECK(indices.writer().load() == 0U);
+        CHECK(indices.reader().load() == 0U);
+        CHECK(indices.writer_waiters().load() == 0U);
+        CHECK(indices.reader_waiters().load() == 0U);
+    }
 }
@@ -22,6 +22,7 @@
 #include <array>
 #include <chrono>
 #include <future>
+#include <string>
 #include <thread>
 
 #include <boost/atomic/ipc_atomic.hpp>
@@ -215,6 +216,45 @@ TEST_CASE("shm_stream::details::blocking_bytes_queue_writer") {
             CHECK(indices.reader().load() == blocking_bytes_queue_stop_index());
             CHECK(indices.writer().load() == blocking_bytes_queue_stop_index());
         }
+
+        SECTION("when the reader reads bytes after the last reservation") {
+            indices.reader() = 2U;
+            indices.writer() = 1U;
+            writer_type writer{
+                indices, mutable_bytes_view(raw_buffer.data(), buffer_size)};
+            CHECK(writer.try_reserve().size() == 0U);  // NOLINT
+
+            indices.reader() = 4U;
+            const auto buffer = writer.try_reserve();
+
+            CHECK(buffer.data() - raw_buffer.data() == 1U);
+            CHECK(buffer.size() == 2U);  // NOLINT
+        }
+
+        SECTION("when the buffer is mirrored") {
+            indices.reader() = 2U;
+            indices.writer() = 4U;
+            writer_type writer{indices,
+                mutable_bytes_view(raw_buffer.data(), buffer_size), true};
+
+            const auto buffer = writer.try_reserve();
+
+            CHECK(buffer.data() - raw_buffer.data() == 4U);
+            CHECK(buffer.size() == 4U);  // NOLINT
+        }
+
+        SECTION("when stopped after the last reservation") {
+            indices.reader() = 1U;
+            indices.writer() = 1U;
+            writer_type writer{
+                indices, mutable_bytes_view(raw_buffer.data(), buffer_size)};
+            CHECK(writer.try_reserve(1U).size() == 1U);  // NOLINT
+
+            writer.stop();
+            const auto buffer = writer.try_reserve(1U);
+
+            CHECK(buffer.size() == 0U);  // NOLINT
+        }
     }
 
     SECTION("commit bytes") {
@@ -264,6 +304,20 @@ TEST_CASE("shm_stream::details::blocking_bytes_queue_writer") {
             CHECK(indices.writer() == 0U);
         }
 
+        SECTION("when bytes are written across the end of a mirrored buffer") {
+            indices.reader() = 2U;
+            indices.writer() = 4U;
+            writer_type writer{indices,
+                mutable_bytes_view(raw_buffer.data(), buffer_size), true};
+            const auto buffer = writer.try_reserve();
+            CHECK(buffer.size() == 4U);
+
+            writer.commit(4U);
+
+            CHECK(indices.reader() == 2U);
+            CHECK(indices.writer() == 1U);
+        }
+
         SECTION("when stopped after call to try_reserve") {
             indices.reader() = 1U;
             indices.writer() = 1U;
@@ -561,6 +615,124 @@ TEST_CASE("shm_stream::details::blocking_bytes_queue_writer") {
             const auto buffer = future.get();
             CHECK(buffer.size() == 0U);  // NOLINT
         }
+
+        SECTION("when a reader commits bytes after some time") {
+            indices.reader() = 2U;
+            indices.writer() = 1U;
+            writer_type writer{
+                indices, mutable_bytes_view(raw_buffer.data(), buffer_size)};
+            shm_stream::details::blocking_bytes_queue_reader<atomic_type>
+                reader{indices,
+                    shm_stream::bytes_view(raw_buffer.data(), buffer_size)};
+
+            std::promise<mutable_bytes_view> promise;
+            auto future = promise.get_future();
+            std::thread thread{[&writer, &promise] {
+                const auto res = writer.wait_reserve();
+                promise.set_value_at_thread_exit(res);
+            }};
+
+            std::this_thread::sleep_for(wait_time);
+            CHECK(indices.reader_waiters().load() == 1U);
+
+            CHECK(reader.try_reserve(1U).size() == 1U);  // NOLINT
+            reader.commit(1U);
+
+            REQUIRE(future.wait_for(timeout) == std::future_status::ready);
+            thread.join();
+
+            const auto buffer = future.get();
+            CHECK(buffer.data() - raw_buffer.data() == 1U);
+            CHECK(buffer.size() == 1U);  // NOLINT
+            CHECK(indices.reader_waiters().load() == 0U);
+        }
+    }
+
+    SECTION("write pieces of bytes at once") {
+        atomic_index_pair_type indices;
+        constexpr shm_stream_size_t buffer_size = 7U;
+        std::array<char, buffer_size> raw_buffer{};
+        const std::array<shm_stream::bytes_view, 2> pieces{
+            shm_stream::bytes_view("ab", 2U),
+            shm_stream::bytes_view("cde", 3U)};  // NOLINT
+
+        SECTION("when the buffer has enough space") {
+            indices.reader() = 4U;
+            indices.writer() = 4U;
+            writer_type writer{
+                indices, mutable_bytes_view(raw_buffer.data(), buffer_size)};
+
+            CHECK(writer.wait_write_gather(pieces.data(), pieces.size()));
+
+            CHECK(indices.writer() == 2U);
+            CHECK(std::string(raw_buffer.data() + 4, 3U) == "abc");  // NOLINT
+            CHECK(std::string(raw_buffer.data(), 2U) == "de");
+        }
+
+        SECTION("when pieces are larger than the buffer") {
+            const std::array<shm_stream::bytes_view, 3> large_pieces{
+                pieces[0], pieces[1], pieces[0]};
+            writer_type writer{
+                indices, mutable_bytes_view(raw_buffer.data(), buffer_size)};
+
+            CHECK_FALSE(writer.wait_write_gather(
+                large_pieces.data(), large_pieces.size()));
+
+            CHECK(indices.writer() == 0U);
+        }
+
+        SECTION("when a reader commits enough bytes after some time") {
+            indices.reader() = 2U;
+            indices.writer() = 0U;
+            writer_type writer{
+                indices, mutable_bytes_view(raw_buffer.data(), buffer_size)};
+            shm_stream::details::blocking_bytes_queue_reader<atomic_type>
+                reader{indices,
+                    shm_stream::bytes_view(raw_buffer.data(), buffer_size)};
+
+            std::promise<bool> promise;
+            auto future = promise.get_future();
+            std::thread thread{[&writer, &pieces, &promise] {
+                const bool res =
+                    writer.wait_write_gather(pieces.data(), pieces.size());
+                promise.set_value_at_thread_exit(res);
+            }};
+
+            std::this_thread::sleep_for(wait_time);
+
+            CHECK(reader.try_reserve(4U).size() == 4U);  // NOLINT
+            reader.commit(4U);                            // NOLINT
+
+            REQUIRE(future.wait_for(timeout) == std::future_status::ready);
+            thread.join();
+
+            CHECK(future.get());
+            CHECK(indices.writer() == 5U);  // NOLINT
+        }
+
+        SECTION("when the queue is stopped") {
+            indices.reader() = 2U;
+            indices.writer() = 0U;
+            writer_type writer{
+                indices, mutable_bytes_view(raw_buffer.data(), buffer_size)};
+
+            std::promise<bool> promise;
+            auto future = promise.get_future();
+            std::thread thread{[&writer, &pieces, &promise] {
+                const bool res =
+                    writer.wait_write_gather(pieces.data(), pieces.size());
+                promise.set_value_at_thread_exit(res);
+            }};
+
+            std::this_thread::sleep_for(wait_time);
+
+            writer.stop();
+
+            REQUIRE(future.wait_for(timeout) == std::future_status::ready);
+            thread.join();
+
+            CHECK_FALSE(future.get());
+        }
     }
 }
 
@@ -729,6 +901,45 @@ TEST_CASE("shm_stream::details::blocking_bytes_queue_reader") {
             CHECK(indices.reader().load() == blocking_bytes_queue_stop_index());
             CHECK(indices.writer().load() == blocking_bytes_queue_stop_index());
         }
+
+        SECTION("when the writer writes bytes after the last reservation") {
+            indices.reader() = 2U;
+            indices.writer() = 2U;
+            reader_type reader{
+                indices, bytes_view(raw_buffer.data(), buffer_size)};
+            CHECK(reader.try_reserve().size() == 0U);  // NOLINT
+
+            indices.writer() = 5U;  // NOLINT
+            const auto buffer = reader.try_reserve();
+
+            CHECK(buffer.data() - raw_buffer.data() == 2U);
+            CHECK(buffer.size() == 3U);  // NOLINT
+        }
+
+        SECTION("when indices are at inverse position in a mirrored buffer") {
+            indices.reader() = 5U;  // NOLINT
+            indices.writer() = 3U;
+            reader_type reader{
+                indices, bytes_view(raw_buffer.data(), buffer_size), true};
+
+            const auto buffer = reader.try_reserve();
+
+            CHECK(buffer.data() - raw_buffer.data() == 5U);  // NOLINT
+            CHECK(buffer.size() == 5U);                      // NOLINT
+        }
+
+        SECTION("when stopped after the last reservation") {
+            indices.reader() = 2U;
+            indices.writer() = 5U;  // NOLINT
+            reader_type reader{
+                indices, bytes_view(raw_buffer.data(), buffer_size)};
+            CHECK(reader.try_reserve(1U).size() == 1U);  // NOLINT
+
+            reader.stop();
+            const auto buffer = reader.try_reserve(1U);
+
+            CHECK(buffer.size() == 0U);  // NOLINT
+        }
     }
 
     SECTION("commit bytes") {
@@ -792,6 +1003,20 @@ TEST_CASE("shm_stream::details::blocking_bytes_queue_reader") {
             CHECK(indices.writer() == 2U);  // NOLINT
         }
 
+        SECTION("when bytes are read across the end of a mirrored buffer") {
+            indices.reader() = 5U;  // NOLINT
+            indices.writer() = 3U;
+            reader_type reader{
+                indices, bytes_view(raw_buffer.data(), buffer_size), true};
+            const auto buffer = reader.try_reserve();
+            CHECK(buffer.size() == 5U);  // NOLINT
+
+            reader.commit(5U);  // NOLINT
+
+            CHECK(indices.reader() == 3U);
+            CHECK(indices.writer() == 3U);
+        }
+
         SECTION("when stopped after call to try_reserve") {
             indices.reader() = 2U;
             indices.writer() = 5U;  // NOLINT
@@ -1088,5 +1313,123 @@ TEST_CASE("shm_stream::details::blocking_bytes_queue_reader") {
             const auto buffer = future.get();
             CHECK(buffer.size() == 0U);  // NOLINT
         }
+
+        SECTION("when a writer commits bytes after some time") {
+            indices.reader() = 3U;
+            indices.writer() = 3U;
+            reader_type reader{
+                indices, bytes_view(raw_buffer.data(), buffer_size)};
+            shm_stream::details::blocking_bytes_queue_writer<atomic_type>
+                writer{indices,
+                    shm_stream::mutable_bytes_view(
+                        raw_buffer.data(), buffer_size)};
+
+            std::promise<bytes_view> promise;
+            auto future = promise.get_future();
+            std::thread thread{[&reader, &promise] {
+                const auto res = reader.wait_reserve();
+                promise.set_value_at_thread_exit(res);
+            }};
+
+            std::this_thread::sleep_for(wait_time);
+            CHECK(indices.writer_waiters().load() == 1U);
+
+            CHECK(writer.try_reserve(2U).size() == 2U);  // NOLINT
+            writer.commit(2U);
+
+            REQUIRE(future.wait_for(timeout) == std::future_status::ready);
+            thread.join();
+
+            const auto buffer = future.get();
+            CHECK(buffer.data() - raw_buffer.data() == 3U);
+            CHECK(buffer.size() == 2U);  // NOLINT
+            CHECK(indices.writer_waiters().load() == 0U);
+        }
+    }
+
+    SECTION("read bytes into pieces at once") {
+        atomic_index_pair_type indices;
+        constexpr shm_stream_size_t buffer_size = 7U;
+        const std::array<char, buffer_size> raw_buffer{
+            'a', 'b', 'c', 'd', 'e', 'f', 'g'};
+        std::array<char, 2> first{};
+        std::array<char, 3> second{};
+        const std::array<shm_stream::mutable_bytes_view, 2> pieces{
+            shm_stream::mutable_bytes_view(first.data(), first.size()),
+            shm_stream::mutable_bytes_view(second.data(), second.size())};
+
+        SECTION("when enough bytes are available") {
+            indices.reader() = 4U;
+            indices.writer() = 2U;
+            reader_type reader{
+                indices, bytes_view(raw_buffer.data(), buffer_size)};
+
+            CHECK(reader.wait_read_scatter(pieces.data(), pieces.size()));
+
+            CHECK(indices.reader() == 2U);
+            CHECK(std::string(first.data(), first.size()) == "ef");
+            CHECK(std::string(second.data(), second.size()) == "gab");
+        }
+
+        SECTION("when a writer commits enough bytes after some time") {
+            indices.reader() = 3U;
+            indices.writer() = 3U;
+            reader_type reader{
+                indices, bytes_view(raw_buffer.data(), buffer_size)};
+            std::array<char, buffer_size> writer_buffer{};
+            shm_stream::details::blocking_bytes_queue_writer<atomic_type>
+                writer{indices,
+                    shm_stream::mutable_bytes_view(
+                        writer_buffer.data(), buffer_size)};
+
+            std::promise<bool> promise;
+            auto future = promise.get_future();
+            std::thread thread{[&reader, &pieces, &promise] {
+                const bool res =
+                    reader.wait_read_scatter(pieces.data(), pieces.size());
+                promise.set_value_at_thread_exit(res);
+            }};
+
+            std::this_thread::sleep_for(wait_time);
+
+            CHECK(writer.try_reserve(4U).size() == 4U);  // NOLINT
+            writer.commit(4U);                            // NOLINT
+            std::this_thread::sleep_for(wait_time);
+            CHECK(future.wait_for(std::chrono::milliseconds(0)) ==
+                std::future_status::timeout);
+
+            CHECK(writer.try_reserve(1U).size() == 1U);
+            writer.commit(1U);
+
+            REQUIRE(future.wait_for(timeout) == std::future_status::ready);
+            thread.join();
+
+            CHECK(future.get());
+            CHECK(indices.reader() == 1U);
+        }
+
+        SECTION("when the queue is stopped") {
+            indices.reader() = 3U;
+            indices.writer() = 3U;
+            reader_type reader{
+                indices, bytes_view(raw_buffer.data(), buffer_size)};
+
+            std::promise<bool> promise;
+            auto future = promise.get_future();
+            std::thread thread{[&reader, &pieces, &promise] {
+                const bool res =
+                    reader.wait_read_scatter(pieces.data(), pieces.size());
+                promise.set_value_at_thread_exit(res);
+            }};
+
+            std::this_thread::sleep_for(wait_time);
+
+            reader.stop();
+
+            REQUIRE(future.wait_for(timeout) == std::future_status::ready);
+            thread.join();
+
+            CHECK_FALSE(future.get());
+        }
     }
 }
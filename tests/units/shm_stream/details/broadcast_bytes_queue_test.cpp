@@ -0,0 +1,134 @@
+/*
+ * Copyright 2023 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Test of broadcast_bytes_queue class.
+ */
+#include "shm_stream/details/broadcast_bytes_queue.h"
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "shm_stream/bytes_view.h"
+#include "shm_stream/common_types.h"
+#include "shm_stream/details/broadcast_index_table.h"
+
+TEST_CASE("shm_stream::details::broadcast_bytes_queue") {
+    using shm_stream::bytes_view;
+    using shm_stream::mutable_bytes_view;
+    using shm_stream::shm_stream_size_t;
+    using shm_stream::details::broadcast_bytes_queue_reader;
+    using shm_stream::details::broadcast_bytes_queue_writer;
+    using shm_stream::details::broadcast_index_table;
+
+    using index_table_type = broadcast_index_table<>;
+    using writer_type = broadcast_bytes_queue_writer<>;
+    using reader_type = broadcast_bytes_queue_reader<>;
+
+    index_table_type indices;
+    constexpr shm_stream_size_t buffer_size = 8U;
+    std::array<char, buffer_size> raw_buffer{};
+    const auto writer_buffer =
+        mutable_bytes_view(raw_buffer.data(), buffer_size);
+    const auto reader_buffer = bytes_view(raw_buffer.data(), buffer_size);
+
+    SECTION("check size in constructor") {
+        CHECK_THROWS(
+            writer_type(indices, mutable_bytes_view(raw_buffer.data(), 1U)));
+        CHECK_THROWS(reader_type(indices, bytes_view(raw_buffer.data(), 1U)));
+        CHECK(indices.reader(0U).load() == index_table_type::detached_index());
+    }
+
+    SECTION("write without readers") {
+        writer_type writer{indices, writer_buffer};
+
+        CHECK(writer.available_size() == buffer_size - 1U);
+        writer.commit(writer.try_reserve().size());
+        CHECK(indices.writer().load() == buffer_size - 1U);
+        CHECK(writer.available_size() == buffer_size - 1U);
+    }
+
+    SECTION("read by multiple readers") {
+        writer_type writer{indices, writer_buffer};
+        reader_type reader1{indices, reader_buffer};
+        reader_type reader2{indices, reader_buffer};
+        CHECK(reader1.slot() == 0U);
+        CHECK(reader2.slot() == 1U);
+
+        constexpr shm_stream_size_t written_size = 5U;
+        CHECK(writer.try_reserve(written_size).size() == written_size);
+        writer.commit(written_size);
+        CHECK(reader1.available_size() == written_size);
+        CHECK(reader2.available_size() == written_size);
+
+        reader1.commit(reader1.try_reserve().size());
+        CHECK(writer.available_size() == 2U);
+
+        reader2.commit(reader2.try_reserve(3U).size());  // NOLINT
+        CHECK(writer.available_size() == 5U);             // NOLINT
+        CHECK(writer.try_reserve().size() == 3U);
+    }
+
+    SECTION("attach a reader after bytes are written") {
+        writer_type writer{indices, writer_buffer};
+        writer.commit(writer.try_reserve(3U).size());
+
+        reader_type reader{indices, reader_buffer};
+
+        CHECK(reader.available_size() == 0U);
+        CHECK(indices.reader(reader.slot()).load() == 3U);
+    }
+
+    SECTION("detach a reader") {
+        writer_type writer{indices, writer_buffer};
+        {
+            reader_type reader{indices, reader_buffer};
+            writer.commit(writer.try_reserve().size());
+            CHECK(writer.available_size() == 0U);
+        }
+
+        CHECK(indices.reader(0U).load() == index_table_type::detached_index());
+        CHECK(writer.available_size() == buffer_size - 1U);
+    }
+
+    SECTION("move a reader") {
+        reader_type reader{indices, reader_buffer};
+        reader_type moved{std::move(reader)};
+        CHECK(moved.slot() == 0U);
+
+        reader_type other{indices, reader_buffer};
+        CHECK(other.slot() == 1U);
+        other = std::move(moved);
+
+        CHECK(other.slot() == 0U);
+        CHECK(indices.reader(1U).load() == index_table_type::detached_index());
+    }
+
+    SECTION("attach too many readers") {
+        std::vector<reader_type> readers;
+        for (std::size_t i = 0U; i < index_table_type::max_readers(); ++i) {
+            readers.emplace_back(indices, reader_buffer);
+        }
+
+        CHECK_THROWS(reader_type(indices, reader_buffer));
+
+        readers.pop_back();
+        CHECK_NOTHROW(reader_type(indices, reader_buffer));
+    }
+}
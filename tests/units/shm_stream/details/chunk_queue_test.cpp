@@ -0,0 +1,178 @@
+/*
+ * Copyright 2023 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Test of chunk_queue class.
+ */
+#include "shm_stream/details/chunk_queue.h"
+
+#include <cstring>
+#include <string>
+#include <thread>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "shm_stream/bytes_view.h"
+#include "shm_stream/common_types.h"
+#include "shm_stream/details/atomic_index_pair.h"
+#include "shm_stream/details/cache_line_size.h"
+
+TEST_CASE("shm_stream::details::chunk_queue") {
+    using shm_stream::bytes_view;
+    using shm_stream::mutable_bytes_view;
+    using shm_stream::shm_stream_size_t;
+    using shm_stream::details::atomic_index_pair;
+    using shm_stream::details::cache_line_size;
+    using shm_stream::details::chunk_pool_view;
+    using shm_stream::details::chunk_queue_reader;
+    using shm_stream::details::chunk_queue_writer;
+
+    using writer_type = chunk_queue_writer<>;
+    using reader_type = chunk_queue_reader<>;
+
+    constexpr shm_stream_size_t num_chunks = 3U;
+    constexpr shm_stream_size_t chunk_size = 100U;
+    constexpr shm_stream_size_t descriptor_buffer_size = 32U;
+    constexpr shm_stream_size_t return_buffer_size = 16U;
+    constexpr std::size_t pool_size = 3U * 128U;
+
+    atomic_index_pair<> descriptor_indices{};
+    atomic_index_pair<> return_indices{};
+    alignas(8) char descriptor_buffer[descriptor_buffer_size]{};  // NOLINT
+    alignas(8) char return_buffer[return_buffer_size]{};          // NOLINT
+    alignas(cache_line_size()) char pool[pool_size]{};             // NOLINT
+    const chunk_pool_view chunks{
+        static_cast<char*>(pool), num_chunks, chunk_size};
+
+    const auto make_writer = [&] {
+        return writer_type(descriptor_indices,
+            mutable_bytes_view(static_cast<char*>(descriptor_buffer),
+                descriptor_buffer_size),
+            return_indices,
+            bytes_view(static_cast<char*>(return_buffer), return_buffer_size),
+            chunks);
+    };
+    const auto make_reader = [&] {
+        return reader_type(descriptor_indices,
+            bytes_view(static_cast<char*>(descriptor_buffer),
+                descriptor_buffer_size),
+            return_indices,
+            mutable_bytes_view(
+                static_cast<char*>(return_buffer), return_buffer_size),
+            chunks);
+    };
+    writer_type::initialize_returned_chunks(return_indices,
+        mutable_bytes_view(
+            static_cast<char*>(return_buffer), return_buffer_size),
+        num_chunks);
+
+    SECTION("calculate the size of buffers") {
+        CHECK(writer_type::descriptor_buffer_size(num_chunks) ==
+            descriptor_buffer_size);
+        CHECK(writer_type::return_buffer_size(num_chunks) ==
+            return_buffer_size);
+        CHECK(writer_type::descriptor_buffer_size(1U) == 16U);
+        CHECK(chunk_pool_view::chunk_stride(chunk_size) == 128U);
+        CHECK_THROWS((void)writer_type::descriptor_buffer_size(0U));
+        CHECK_THROWS(chunk_pool_view::check_params(num_chunks, 0U));
+    }
+
+    SECTION("allocate all chunks") {
+        writer_type writer = make_writer();
+        CHECK(writer.chunk_size() == chunk_size);
+
+        for (shm_stream_size_t i = 0U; i < num_chunks; ++i) {
+            const auto chunk = writer.try_allocate();
+            CHECK(chunk.data() == chunks.chunk(i));
+            CHECK(chunk.size() == chunk_size);
+        }
+        CHECK(writer.try_allocate().data() == nullptr);
+    }
+
+    SECTION("send chunks") {
+        writer_type writer = make_writer();
+        reader_type reader = make_reader();
+
+        CHECK(reader.try_receive().data() == nullptr);
+
+        const std::string message = "abc";
+        const auto chunk = writer.try_allocate();
+        REQUIRE(chunk.data() != nullptr);
+        std::memcpy(chunk.data(), message.data(), message.size());
+        writer.send(chunk, static_cast<shm_stream_size_t>(message.size()));
+
+        const auto received = reader.try_receive();
+        REQUIRE(received.data() == chunk.data());
+        CHECK(std::string(received.data(), received.size()) == message);
+        CHECK(reader.try_receive().data() == nullptr);
+        reader.release(received);
+    }
+
+    SECTION("reuse released chunks") {
+        writer_type writer = make_writer();
+        reader_type reader = make_reader();
+
+        constexpr shm_stream_size_t num_messages = 10U;
+        for (shm_stream_size_t i = 0U; i < num_messages; ++i) {
+            for (shm_stream_size_t j = 0U; j < num_chunks; ++j) {
+                const auto chunk = writer.try_allocate();
+                REQUIRE(chunk.data() != nullptr);
+                chunk.data()[0] = static_cast<char>('a' + j);
+                writer.send(chunk, 1U);
+            }
+            CHECK(writer.try_allocate().data() == nullptr);
+
+            for (shm_stream_size_t j = 0U; j < num_chunks; ++j) {
+                const auto chunk = reader.try_receive();
+                REQUIRE(chunk.data() != nullptr);
+                CHECK(chunk.size() == 1U);
+                CHECK(chunk.data()[0] == static_cast<char>('a' + j));
+                reader.release(chunk);
+            }
+        }
+    }
+
+    SECTION("send chunks from another thread") {
+        constexpr shm_stream_size_t num_messages = 1000U;
+
+        std::thread writer_thread{[&make_writer] {
+            writer_type writer = make_writer();
+            for (shm_stream_size_t i = 0U; i < num_messages; ++i) {
+                mutable_bytes_view chunk{nullptr, 0U};
+                do {
+                    chunk = writer.try_allocate();
+                } while (chunk.data() == nullptr);
+                std::memcpy(chunk.data(), &i, sizeof(i));
+                writer.send(chunk, static_cast<shm_stream_size_t>(sizeof(i)));
+            }
+        }};
+
+        reader_type reader = make_reader();
+        for (shm_stream_size_t i = 0U; i < num_messages; ++i) {
+            bytes_view chunk{nullptr, 0U};
+            do {
+                chunk = reader.try_receive();
+            } while (chunk.data() == nullptr);
+            REQUIRE(chunk.size() == sizeof(i));
+            shm_stream_size_t value = 0U;
+            std::memcpy(&value, chunk.data(), sizeof(value));
+            CHECK(value == i);
+            reader.release(chunk);
+        }
+
+        writer_thread.join();
+    }
+}
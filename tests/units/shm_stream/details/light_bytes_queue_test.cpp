@@ -20,6 +20,7 @@
 #include "shm_stream/details/light_bytes_queue.h"
 
 #include <array>
+#include <string>
 
 #include <boost/atomic/ipc_atomic.hpp>
 #include <catch2/catch_test_macros.hpp>
@@ -183,6 +184,32 @@ TEST_CASE("shm_stream::details::light_bytes_queue_writer") {
             CHECK(buffer.data() - raw_buffer.data() == 1U);
             CHECK(buffer.size() == 0U);  // NOLINT
         }
+
+        SECTION("when the reader reads bytes after the last reservation") {
+            indices.reader() = 2U;
+            indices.writer() = 1U;
+            writer_type writer{
+                indices, mutable_bytes_view(raw_buffer.data(), buffer_size)};
+            CHECK(writer.try_reserve().size() == 0U);  // NOLINT
+
+            indices.reader() = 4U;
+            const auto buffer = writer.try_reserve();
+
+            CHECK(buffer.data() - raw_buffer.data() == 1U);
+            CHECK(buffer.size() == 2U);  // NOLINT
+        }
+
+        SECTION("when the buffer is mirrored") {
+            indices.reader() = 2U;
+            indices.writer() = 4U;
+            writer_type writer{indices,
+                mutable_bytes_view(raw_buffer.data(), buffer_size), true};
+
+            const auto buffer = writer.try_reserve();
+
+            CHECK(buffer.data() - raw_buffer.data() == 4U);
+            CHECK(buffer.size() == 4U);  // NOLINT
+        }
     }
 
     SECTION("commit bytes") {
@@ -231,6 +258,55 @@ TEST_CASE("shm_stream::details::light_bytes_queue_writer") {
             CHECK(indices.reader() == 2U);
             CHECK(indices.writer() == 0U);
         }
+
+        SECTION("when bytes are written across the end of a mirrored buffer") {
+            indices.reader() = 2U;
+            indices.writer() = 4U;
+            writer_type writer{indices,
+                mutable_bytes_view(raw_buffer.data(), buffer_size), true};
+            const auto buffer = writer.try_reserve();
+            CHECK(buffer.size() == 4U);
+
+            writer.commit(4U);
+
+            CHECK(indices.reader() == 2U);
+            CHECK(indices.writer() == 1U);
+        }
+    }
+
+    SECTION("write pieces of bytes at once") {
+        atomic_index_pair_type indices;
+        constexpr shm_stream_size_t buffer_size = 7U;
+        std::array<char, buffer_size> raw_buffer{};
+        const std::array<shm_stream::bytes_view, 2> pieces{
+            shm_stream::bytes_view("ab", 2U),
+            shm_stream::bytes_view("cde", 3U)};  // NOLINT
+
+        SECTION("when the buffer has enough space") {
+            indices.reader() = 4U;
+            indices.writer() = 4U;
+            writer_type writer{
+                indices, mutable_bytes_view(raw_buffer.data(), buffer_size)};
+
+            CHECK(writer.try_write_gather(pieces.data(), pieces.size()));
+
+            CHECK(indices.reader() == 4U);
+            CHECK(indices.writer() == 2U);
+            CHECK(std::string(raw_buffer.data() + 4, 3U) == "abc");  // NOLINT
+            CHECK(std::string(raw_buffer.data(), 2U) == "de");
+        }
+
+        SECTION("when the buffer doesn't have enough space") {
+            indices.reader() = 2U;
+            indices.writer() = 6U;  // NOLINT
+            writer_type writer{
+                indices, mutable_bytes_view(raw_buffer.data(), buffer_size)};
+
+            CHECK_FALSE(writer.try_write_gather(pieces.data(), pieces.size()));
+
+            CHECK(indices.reader() == 2U);
+            CHECK(indices.writer() == 6U);  // NOLINT
+        }
     }
 }
 
@@ -373,6 +449,32 @@ TEST_CASE("shm_stream::details::light_bytes_queue_reader") {
             CHECK(buffer.data() - raw_buffer.data() == 5U);  // NOLINT
             CHECK(buffer.size() == 2U);                      // NOLINT
         }
+
+        SECTION("when the writer writes bytes after the last reservation") {
+            indices.reader() = 2U;
+            indices.writer() = 2U;
+            reader_type reader{
+                indices, bytes_view(raw_buffer.data(), buffer_size)};
+            CHECK(reader.try_reserve().size() == 0U);  // NOLINT
+
+            indices.writer() = 5U;  // NOLINT
+            const auto buffer = reader.try_reserve();
+
+            CHECK(buffer.data() - raw_buffer.data() == 2U);
+            CHECK(buffer.size() == 3U);  // NOLINT
+        }
+
+        SECTION("when indices are at inverse position in a mirrored buffer") {
+            indices.reader() = 5U;  // NOLINT
+            indices.writer() = 3U;
+            reader_type reader{
+                indices, bytes_view(raw_buffer.data(), buffer_size), true};
+
+            const auto buffer = reader.try_reserve();
+
+            CHECK(buffer.data() - raw_buffer.data() == 5U);  // NOLINT
+            CHECK(buffer.size() == 5U);                      // NOLINT
+        }
     }
 
     SECTION("commit bytes") {
@@ -435,5 +537,273 @@ TEST_CASE("shm_stream::details::light_bytes_queue_reader") {
             CHECK(indices.reader() == 0U);
             CHECK(indices.writer() == 2U);  // NOLINT
         }
+
+        SECTION("when bytes are read across the end of a mirrored buffer") {
+            indices.reader() = 5U;  // NOLINT
+            indices.writer() = 3U;
+            reader_type reader{
+                indices, bytes_view(raw_buffer.data(), buffer_size), true};
+            const auto buffer = reader.try_reserve();
+            CHECK(buffer.size() == 5U);  // NOLINT
+
+            reader.commit(5U);  // NOLINT
+
+            CHECK(indices.reader() == 3U);
+            CHECK(indices.writer() == 3U);
+        }
+    }
+
+    SECTION("read bytes into pieces at once") {
+        atomic_index_pair_type indices;
+        constexpr shm_stream_size_t buffer_size = 7U;
+        const std::array<char, buffer_size> raw_buffer{
+            'd', 'e', 'x', 'x', 'a', 'b', 'c'};
+        std::array<char, 2> first{};
+        std::array<char, 3> second{};
+        const std::array<shm_stream::mutable_bytes_view, 2> pieces{
+            shm_stream::mutable_bytes_view(first.data(), first.size()),
+            shm_stream::mutable_bytes_view(second.data(), second.size())};
+
+        SECTION("when enough bytes are available") {
+            indices.reader() = 4U;
+            indices.writer() = 2U;
+            reader_type reader{
+                indices, bytes_view(raw_buffer.data(), buffer_size)};
+
+            CHECK(reader.try_read_scatter(pieces.data(), pieces.size()));
+
+            CHECK(indices.reader() == 2U);
+            CHECK(indices.writer() == 2U);
+            CHECK(std::string(first.data(), first.size()) == "ab");
+            CHECK(std::string(second.data(), second.size()) == "cde");
+        }
+
+        SECTION("when bytes are not enough") {
+            indices.reader() = 4U;
+            indices.writer() = 1U;
+            reader_type reader{
+                indices, bytes_view(raw_buffer.data(), buffer_size)};
+
+            CHECK_FALSE(reader.try_read_scatter(pieces.data(), pieces.size()));
+
+            CHECK(indices.reader() == 4U);
+            CHECK(indices.writer() == 1U);
+        }
+    }
+}
+
+TEST_CASE("shm_stream::details::light_bytes_queue_writer with 64-bit indices") {
+    using shm_stream::mutable_bytes_view64;
+    using shm_stream::shm_stream_size64_t;
+    using shm_stream::details::light_bytes_queue_writer;
+
+    using atomic_type = boost::atomics::ipc_atomic<shm_stream_size64_t>;
+    using atomic_index_pair_type =
+        shm_stream::details::atomic_index_pair<atomic_type>;
+    using writer_type = light_bytes_queue_writer<atomic_type>;
+
+    SECTION("check size in constructor") {
+        atomic_index_pair_type indices;
+        char dummy_buffer{};
+        const auto try_create = [&indices, &dummy_buffer](
+                                    shm_stream_size64_t size) {
+            (void)writer_type(
+                indices, mutable_bytes_view64(&dummy_buffer, size));
+        };
+
+        CHECK_THROWS(try_create(1U));
+        CHECK_NOTHROW(try_create(2U));
+        CHECK_NOTHROW(try_create(0x80000000U));
+        CHECK_NOTHROW(try_create(0x7FFFFFFFFFFFFFFFU));
+        CHECK_THROWS(try_create(0x8000000000000000U));
+    }
+
+    SECTION("get available size with indices larger than 32 bits") {
+        atomic_index_pair_type indices;
+        char dummy_buffer{};
+        constexpr shm_stream_size64_t buffer_size = 0x300000000U;
+        indices.reader() = 0x100000000U;
+        indices.writer() = 0x200000000U;
+        writer_type writer{
+            indices, mutable_bytes_view64(&dummy_buffer, buffer_size)};
+
+        CHECK(writer.available_size() == 0x1FFFFFFFFU);  // NOLINT
+    }
+}
+
+TEST_CASE("shm_stream::details::light_bytes_queue_reader with 64-bit indices") {
+    using shm_stream::bytes_view64;
+    using shm_stream::shm_stream_size64_t;
+    using shm_stream::details::light_bytes_queue_reader;
+
+    using atomic_type = boost::atomics::ipc_atomic<shm_stream_size64_t>;
+    using atomic_index_pair_type =
+        shm_stream::details::atomic_index_pair<atomic_type>;
+    using reader_type = light_bytes_queue_reader<atomic_type>;
+
+    SECTION("get available size with indices larger than 32 bits") {
+        atomic_index_pair_type indices;
+        char dummy_buffer{};
+        constexpr shm_stream_size64_t buffer_size = 0x300000000U;
+        indices.reader() = 0x100000000U;
+        indices.writer() = 0x200000000U;
+        reader_type reader{indices, bytes_view64(&dummy_buffer, buffer_size)};
+
+        CHECK(reader.available_size() == 0x100000000U);  // NOLINT
+    }
+}
+
+TEST_CASE(
+    "shm_stream::details::light_bytes_queue_writer with masked indices") {
+    using shm_stream::mutable_bytes_view;
+    using shm_stream::shm_stream_size_t;
+    using shm_stream::details::light_bytes_queue_writer;
+    using shm_stream::details::masked_index_policy;
+
+    using atomic_type = boost::atomics::ipc_atomic<shm_stream_size_t>;
+    using atomic_index_pair_type =
+        shm_stream::details::atomic_index_pair<atomic_type>;
+    using writer_type =
+        light_bytes_queue_writer<atomic_type, masked_index_policy>;
+
+    SECTION("check size in constructor") {
+        atomic_index_pair_type indices;
+        char dummy_buffer{};
+        const auto try_create = [&indices, &dummy_buffer](
+                                    shm_stream_size_t size) {
+            (void)writer_type(indices, mutable_bytes_view(&dummy_buffer, size));
+        };
+
+        CHECK_THROWS(try_create(1U));
+        CHECK_NOTHROW(try_create(2U));
+        CHECK_THROWS(try_create(6U));
+        CHECK_NOTHROW(try_create(8U));
+        CHECK_NOTHROW(try_create(0x40000000U));
+        CHECK_THROWS(try_create(0x80000000U));
+    }
+
+    atomic_index_pair_type indices;
+    constexpr shm_stream_size_t buffer_size = 8U;
+    std::array<char, buffer_size> raw_buffer{};
+
+    SECTION("get available size") {
+        SECTION("when no byte is written") {
+            indices.reader() = 5U;
+            indices.writer() = 5U;
+            writer_type writer{
+                indices, mutable_bytes_view(raw_buffer.data(), buffer_size)};
+
+            CHECK(writer.available_size() == 8U);  // NOLINT
+        }
+
+        SECTION("when indices overflow") {
+            indices.reader() = 0xFFFFFFFEU;
+            indices.writer() = 2U;
+            writer_type writer{
+                indices, mutable_bytes_view(raw_buffer.data(), buffer_size)};
+
+            CHECK(writer.available_size() == 4U);  // NOLINT
+        }
+
+        SECTION("when full") {
+            indices.reader() = 3U;
+            indices.writer() = 11U;
+            writer_type writer{
+                indices, mutable_bytes_view(raw_buffer.data(), buffer_size)};
+
+            CHECK(writer.available_size() == 0U);
+            CHECK(writer.try_reserve().size() == 0U);
+        }
+    }
+
+    SECTION("reserve and commit bytes across the overflow of indices") {
+        indices.reader() = 0xFFFFFFFEU;
+        indices.writer() = 0xFFFFFFFEU;
+        writer_type writer{
+            indices, mutable_bytes_view(raw_buffer.data(), buffer_size)};
+
+        auto buffer = writer.try_reserve();
+        CHECK(buffer.data() - raw_buffer.data() == 6U);  // NOLINT
+        CHECK(buffer.size() == 2U);
+        writer.commit(2U);
+        CHECK(indices.writer() == 0U);
+
+        buffer = writer.try_reserve();
+        CHECK(buffer.data() - raw_buffer.data() == 0U);
+        CHECK(buffer.size() == 6U);  // NOLINT
+        writer.commit(6U);  // NOLINT
+        CHECK(indices.writer() == 6U);
+        CHECK(writer.available_size() == 0U);
+    }
+
+    SECTION("reserve bytes in a mirrored buffer") {
+        indices.reader() = 0xFFFFFFFEU;
+        indices.writer() = 0xFFFFFFFEU;
+        writer_type writer{
+            indices, mutable_bytes_view(raw_buffer.data(), buffer_size), true};
+
+        const auto buffer = writer.try_reserve();
+        CHECK(buffer.data() - raw_buffer.data() == 6U);  // NOLINT
+        CHECK(buffer.size() == 8U);                      // NOLINT
+    }
+}
+
+TEST_CASE(
+    "shm_stream::details::light_bytes_queue_reader with masked indices") {
+    using shm_stream::bytes_view;
+    using shm_stream::shm_stream_size_t;
+    using shm_stream::details::light_bytes_queue_reader;
+    using shm_stream::details::masked_index_policy;
+
+    using atomic_type = boost::atomics::ipc_atomic<shm_stream_size_t>;
+    using atomic_index_pair_type =
+        shm_stream::details::atomic_index_pair<atomic_type>;
+    using reader_type =
+        light_bytes_queue_reader<atomic_type, masked_index_policy>;
+
+    atomic_index_pair_type indices;
+    constexpr shm_stream_size_t buffer_size = 8U;
+    std::array<char, buffer_size> raw_buffer{};
+
+    SECTION("check size in constructor") {
+        const auto try_create = [&indices, &raw_buffer](
+                                    shm_stream_size_t size) {
+            (void)reader_type(indices, bytes_view(raw_buffer.data(), size));
+        };
+
+        CHECK_NOTHROW(try_create(4U));
+        CHECK_THROWS(try_create(5U));
+    }
+
+    SECTION("reserve and commit bytes across the overflow of indices") {
+        indices.reader() = 0xFFFFFFFCU;
+        indices.writer() = 4U;
+        reader_type reader{
+            indices, bytes_view(raw_buffer.data(), buffer_size)};
+        CHECK(reader.available_size() == 8U);  // NOLINT
+
+        auto buffer = reader.try_reserve();
+        CHECK(buffer.data() - raw_buffer.data() == 4U);
+        CHECK(buffer.size() == 4U);
+        reader.commit(4U);
+        CHECK(indices.reader() == 0U);
+
+        buffer = reader.try_reserve();
+        CHECK(buffer.data() - raw_buffer.data() == 0U);
+        CHECK(buffer.size() == 4U);
+        reader.commit(4U);
+        CHECK(indices.reader() == 4U);
+        CHECK(reader.available_size() == 0U);
+    }
+
+    SECTION("reserve bytes in a mirrored buffer") {
+        indices.reader() = 0xFFFFFFFCU;
+        indices.writer() = 4U;
+        reader_type reader{
+            indices, bytes_view(raw_buffer.data(), buffer_size), true};
+
+        const auto buffer = reader.try_reserve();
+        CHECK(buffer.data() - raw_buffer.data() == 4U);
+        CHECK(buffer.size() == 8U);  // NOLINT
     }
 }
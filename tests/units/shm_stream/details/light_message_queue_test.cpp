@@ -0,0 +1,160 @@
+/*
+ * Copyright 2023 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Test of light_message_queue class.
+ */
+#include "shm_stream/details/light_message_queue.h"
+
+#include <array>
+#include <cstring>
+#include <string>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "shm_stream/bytes_view.h"
+#include "shm_stream/common_types.h"
+#include "shm_stream/details/atomic_index_pair.h"
+
+TEST_CASE("shm_stream::details::light_message_queue") {
+    using shm_stream::bytes_view;
+    using shm_stream::mutable_bytes_view;
+    using shm_stream::shm_stream_size_t;
+    using shm_stream::details::light_message_queue_reader;
+    using shm_stream::details::light_message_queue_writer;
+
+    using writer_type = light_message_queue_writer<>;
+    using reader_type = light_message_queue_reader<>;
+    using atomic_index_pair_type =
+        shm_stream::details::atomic_index_pair<writer_type::atomic_type>;
+
+    atomic_index_pair_type indices;
+    constexpr shm_stream_size_t buffer_size = 16U;
+    std::array<char, buffer_size> raw_buffer{};
+
+    const auto write = [](writer_type& writer, const std::string& message) {
+        const auto buffer = writer.try_reserve_message(
+            static_cast<shm_stream_size_t>(message.size()));
+        REQUIRE(buffer.data() != nullptr);
+        REQUIRE(buffer.size() == message.size());
+        std::memcpy(buffer.data(), message.data(), message.size());
+        writer.commit_message();
+    };
+    const auto read = [](reader_type& reader) {
+        const auto buffer = reader.next_message();
+        REQUIRE(buffer.data() != nullptr);
+        std::string message{buffer.data(), buffer.size()};
+        reader.commit_message();
+        return message;
+    };
+
+    SECTION("get the maximum size of messages") {
+        writer_type writer{
+            indices, mutable_bytes_view(raw_buffer.data(), buffer_size)};
+
+        CHECK(writer.max_message_size() == 11U);  // NOLINT
+        CHECK(writer.try_reserve_message(12U).data() == nullptr);  // NOLINT
+    }
+
+    SECTION("send messages") {
+        writer_type writer{
+            indices, mutable_bytes_view(raw_buffer.data(), buffer_size)};
+        reader_type reader{indices, bytes_view(raw_buffer.data(), buffer_size)};
+        CHECK(reader.next_message().data() == nullptr);
+
+        write(writer, "abc");
+        write(writer, "");
+
+        const auto buffer = reader.next_message();
+        CHECK(std::string(buffer.data(), buffer.size()) == "abc");
+        CHECK(reader.next_message().data() == buffer.data());
+        reader.commit_message();
+        CHECK(read(reader).empty());
+        CHECK(reader.next_message().data() == nullptr);
+    }
+
+    SECTION("fail to reserve when the buffer is full") {
+        writer_type writer{
+            indices, mutable_bytes_view(raw_buffer.data(), buffer_size)};
+        reader_type reader{indices, bytes_view(raw_buffer.data(), buffer_size)};
+
+        write(writer, "abcdefgh");
+        CHECK(writer.try_reserve_message(4U).data() == nullptr);
+
+        CHECK(read(reader) == "abcdefgh");
+        CHECK(writer.try_reserve_message(4U).data() != nullptr);
+    }
+
+    SECTION("skip bytes at the end of the buffer with a padding marker") {
+        indices.reader() = 12U;
+        indices.writer() = 12U;
+        writer_type writer{
+            indices, mutable_bytes_view(raw_buffer.data(), buffer_size)};
+        reader_type reader{indices, bytes_view(raw_buffer.data(), buffer_size)};
+
+        write(writer, "abcdef");
+
+        CHECK(indices.writer() == 10U);  // NOLINT
+        CHECK(read(reader) == "abcdef");
+        CHECK(indices.reader() == 10U);  // NOLINT
+    }
+
+    SECTION("skip bytes too few for a header at the end of the buffer") {
+        indices.reader() = 14U;
+        indices.writer() = 14U;
+        writer_type writer{
+            indices, mutable_bytes_view(raw_buffer.data(), buffer_size)};
+        reader_type reader{indices, bytes_view(raw_buffer.data(), buffer_size)};
+
+        write(writer, "ab");
+
+        CHECK(indices.writer() == 6U);  // NOLINT
+        CHECK(read(reader) == "ab");
+        CHECK(indices.reader() == 6U);  // NOLINT
+    }
+
+    SECTION("wait for the reader before wrapping around") {
+        indices.reader() = 0U;
+        indices.writer() = 0U;
+        writer_type writer{
+            indices, mutable_bytes_view(raw_buffer.data(), buffer_size)};
+        reader_type reader{indices, bytes_view(raw_buffer.data(), buffer_size)};
+
+        write(writer, "abcdefgh");
+        CHECK(writer.try_reserve_message(2U).data() == nullptr);
+
+        CHECK(read(reader) == "abcdefgh");
+        write(writer, "ab");
+        CHECK(indices.writer() == 6U);  // NOLINT
+        CHECK(read(reader) == "ab");
+    }
+
+    SECTION("write messages across the end of a mirrored buffer") {
+        indices.reader() = 14U;
+        indices.writer() = 14U;
+        std::array<char, buffer_size * 2U> mirrored_buffer{};
+        writer_type writer{indices,
+            mutable_bytes_view(mirrored_buffer.data(), buffer_size), true};
+        reader_type reader{indices,
+            bytes_view(mirrored_buffer.data(), buffer_size), true};
+
+        write(writer, "ab");
+
+        CHECK(indices.writer() == 4U);
+        CHECK(read(reader) == "ab");
+        CHECK(indices.reader() == 4U);
+    }
+}
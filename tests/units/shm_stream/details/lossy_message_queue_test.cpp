@@ -0,0 +1,216 @@
+/*
+ * Copyright 2023 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Test of lossy_message_queue class.
+ */
+#include "shm_stream/details/lossy_message_queue.h"
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <thread>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "shm_stream/bytes_view.h"
+#include "shm_stream/common_types.h"
+
+TEST_CASE("shm_stream::details::lossy_message_queue") {
+    using shm_stream::bytes_view;
+    using shm_stream::mutable_bytes_view;
+    using shm_stream::shm_stream_size_t;
+    using shm_stream::details::lossy_message_queue_reader;
+    using shm_stream::details::lossy_message_queue_writer;
+
+    using writer_type = lossy_message_queue_writer<>;
+    using reader_type = lossy_message_queue_reader<>;
+
+    writer_type::atomic_type next_sequence{0U};
+    constexpr shm_stream_size_t num_records = 4U;
+    constexpr shm_stream_size_t max_message_size = 8U;
+    constexpr shm_stream_size_t buffer_size = 128U;
+    alignas(8) char raw_buffer[buffer_size]{};  // NOLINT
+    const auto writer_buffer =
+        mutable_bytes_view(static_cast<char*>(raw_buffer), buffer_size);
+    const auto reader_buffer =
+        bytes_view(static_cast<char*>(raw_buffer), buffer_size);
+
+    const auto write = [](writer_type& writer, const std::string& message) {
+        const auto buffer = writer.reserve_message(
+            static_cast<shm_stream_size_t>(message.size()));
+        REQUIRE(buffer.data() != nullptr);
+        REQUIRE(buffer.size() == message.size());
+        std::memcpy(buffer.data(), message.data(), message.size());
+        writer.commit_message();
+    };
+    const auto read = [](reader_type& reader) {
+        const auto buffer = reader.next_message();
+        REQUIRE(buffer.data() != nullptr);
+        std::string message{buffer.data(), buffer.size()};
+        REQUIRE(reader.commit_message());
+        return message;
+    };
+
+    SECTION("calculate the size of buffers") {
+        CHECK(writer_type::buffer_size(num_records, max_message_size) ==
+            buffer_size);
+        CHECK_THROWS((void)writer_type::buffer_size(3U, max_message_size));
+        CHECK_THROWS((void)writer_type::buffer_size(1U, max_message_size));
+    }
+
+    SECTION("check size in constructor") {
+        CHECK_THROWS(writer_type(next_sequence,
+            mutable_bytes_view(static_cast<char*>(raw_buffer), 96U),
+            max_message_size));
+        CHECK_THROWS(writer_type(next_sequence,
+            mutable_bytes_view(static_cast<char*>(raw_buffer), 100U),
+            max_message_size));
+        CHECK_THROWS(reader_type(next_sequence,
+            bytes_view(static_cast<char*>(raw_buffer), 96U),
+            max_message_size));
+    }
+
+    SECTION("send messages") {
+        writer_type writer{next_sequence, writer_buffer, max_message_size};
+        reader_type reader{next_sequence, reader_buffer, max_message_size};
+        CHECK(writer.max_message_size() == max_message_size);
+        CHECK(writer.reserve_message(9U).data() == nullptr);  // NOLINT
+        CHECK(reader.next_message().data() == nullptr);
+
+        write(writer, "abc");
+        write(writer, "");
+
+        const auto message = reader.next_message();
+        CHECK(std::string(message.data(), message.size()) == "abc");
+        CHECK(reader.next_message().data() == message.data());
+        CHECK(reader.commit_message());
+        CHECK(read(reader).empty());
+        CHECK(reader.next_message().data() == nullptr);
+        CHECK_FALSE(reader.commit_message());
+        CHECK(reader.lost_messages() == 0U);
+        CHECK(next_sequence.load() == 2U);
+    }
+
+    SECTION("skip a message not committed yet") {
+        writer_type writer{next_sequence, writer_buffer, max_message_size};
+        reader_type reader{next_sequence, reader_buffer, max_message_size};
+
+        CHECK(writer.reserve_message(1U).data() != nullptr);
+        CHECK(reader.next_message().data() == nullptr);
+
+        writer.commit_message();
+        CHECK(reader.next_message().data() != nullptr);
+    }
+
+    SECTION("overwrite messages not read") {
+        writer_type writer{next_sequence, writer_buffer, max_message_size};
+        reader_type reader{next_sequence, reader_buffer, max_message_size};
+
+        for (char c = '0'; c < '6'; ++c) {
+            write(writer, std::string(1, c));
+        }
+
+        CHECK(read(reader) == "2");
+        CHECK(reader.lost_messages() == 2U);
+        CHECK(read(reader) == "3");
+        CHECK(read(reader) == "4");
+        CHECK(read(reader) == "5");
+        CHECK(reader.next_message().data() == nullptr);
+        CHECK(reader.lost_messages() == 2U);
+    }
+
+    SECTION("detect a message overwritten while reading") {
+        writer_type writer{next_sequence, writer_buffer, max_message_size};
+        reader_type reader{next_sequence, reader_buffer, max_message_size};
+
+        write(writer, "a");
+        CHECK(reader.next_message().data() != nullptr);
+        for (char c = 'b'; c < 'f'; ++c) {
+            write(writer, std::string(1, c));
+        }
+
+        CHECK_FALSE(reader.commit_message());
+        CHECK(reader.lost_messages() == 1U);
+        CHECK(read(reader) == "b");
+    }
+
+    SECTION("skip a record being overwritten") {
+        writer_type writer{next_sequence, writer_buffer, max_message_size};
+        for (char c = 'a'; c < 'e'; ++c) {
+            write(writer, std::string(1, c));
+        }
+        CHECK(writer.reserve_message(1U).data() != nullptr);
+
+        reader_type reader{next_sequence, reader_buffer, max_message_size};
+        CHECK(read(reader) == "b");
+        CHECK(reader.lost_messages() == 1U);
+    }
+
+    SECTION("start reading from the oldest message") {
+        writer_type writer{next_sequence, writer_buffer, max_message_size};
+        for (char c = 'a'; c < 'g'; ++c) {
+            write(writer, std::string(1, c));
+        }
+
+        reader_type reader{next_sequence, reader_buffer, max_message_size};
+        CHECK(read(reader) == "c");
+        CHECK(reader.lost_messages() == 0U);
+    }
+
+    SECTION("read messages while writing in another thread") {
+        constexpr std::uint64_t num_messages = 100000U;
+        reader_type reader{next_sequence, reader_buffer, max_message_size};
+
+        std::thread writer_thread{[&next_sequence, &writer_buffer] {
+            writer_type writer{next_sequence, writer_buffer, max_message_size};
+            for (std::uint64_t i = 0U; i < num_messages; ++i) {
+                const auto buffer = writer.reserve_message(
+                    static_cast<shm_stream_size_t>(sizeof(i)));
+                std::memcpy(buffer.data(), &i, sizeof(i));
+                writer.commit_message();
+            }
+        }};
+
+        std::uint64_t num_received = 0U;
+        std::uint64_t last_received = 0U;
+        bool is_ordered = true;
+        while (true) {
+            const auto buffer = reader.next_message();
+            if (buffer.data() == nullptr) {
+                if (next_sequence.load() == num_messages &&
+                    reader.next_message().data() == nullptr) {
+                    break;
+                }
+                std::this_thread::yield();
+                continue;
+            }
+            std::uint64_t value = 0U;
+            std::memcpy(&value, buffer.data(), sizeof(value));
+            if (reader.commit_message()) {
+                if (num_received > 0U && value <= last_received) {
+                    is_ordered = false;
+                }
+                last_received = value;
+                ++num_received;
+            }
+        }
+        writer_thread.join();
+
+        CHECK(is_ordered);
+        CHECK(num_received + reader.lost_messages() == num_messages);
+    }
+}
@@ -0,0 +1,189 @@
+/*
+ * Copyright 2023 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Test of mpsc_message_queue class.
+ */
+#include "shm_stream/details/mpsc_message_queue.h"
+
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "shm_stream/bytes_view.h"
+#include "shm_stream/common_types.h"
+#include "shm_stream/details/atomic_index_pair.h"
+
+TEST_CASE("shm_stream::details::mpsc_message_queue") {
+    using shm_stream::mutable_bytes_view;
+    using shm_stream::shm_stream_size_t;
+    using shm_stream::details::mpsc_message_queue_reader;
+    using shm_stream::details::mpsc_message_queue_writer;
+
+    using writer_type = mpsc_message_queue_writer<>;
+    using reader_type = mpsc_message_queue_reader<>;
+    using atomic_index_pair_type =
+        shm_stream::details::atomic_index_pair<writer_type::atomic_type>;
+
+    atomic_index_pair_type indices;
+    constexpr shm_stream_size_t buffer_size = 32U;
+    alignas(8) char raw_buffer[buffer_size]{};  // NOLINT
+    const auto buffer = mutable_bytes_view(
+        static_cast<char*>(raw_buffer), buffer_size);
+
+    const auto write = [](writer_type& writer, const std::string& message) {
+        const auto buffer = writer.try_reserve_message(
+            static_cast<shm_stream_size_t>(message.size()));
+        REQUIRE(buffer.data() != nullptr);
+        REQUIRE(buffer.size() == message.size());
+        std::memcpy(buffer.data(), message.data(), message.size());
+        writer.commit_message();
+    };
+    const auto read = [](reader_type& reader) {
+        const auto buffer = reader.next_message();
+        REQUIRE(buffer.data() != nullptr);
+        std::string message{buffer.data(), buffer.size()};
+        reader.commit_message();
+        return message;
+    };
+
+    SECTION("check size in constructor") {
+        CHECK_THROWS(writer_type(indices,
+            mutable_bytes_view(static_cast<char*>(raw_buffer), 8U)));
+        CHECK_THROWS(writer_type(indices,
+            mutable_bytes_view(static_cast<char*>(raw_buffer), 24U)));
+        CHECK_THROWS(reader_type(indices,
+            mutable_bytes_view(static_cast<char*>(raw_buffer), 24U)));
+    }
+
+    SECTION("get the maximum size of messages") {
+        writer_type writer{indices, buffer};
+
+        CHECK(writer.max_message_size() == 8U);  // NOLINT
+        CHECK(writer.try_reserve_message(9U).data() == nullptr);  // NOLINT
+    }
+
+    SECTION("send messages") {
+        writer_type writer{indices, buffer};
+        reader_type reader{indices, buffer};
+        CHECK(reader.next_message().data() == nullptr);
+
+        write(writer, "abc");
+        write(writer, "");
+
+        const auto message = reader.next_message();
+        CHECK(std::string(message.data(), message.size()) == "abc");
+        CHECK(reader.next_message().data() == message.data());
+        reader.commit_message();
+        CHECK(read(reader).empty());
+        CHECK(reader.next_message().data() == nullptr);
+        CHECK(indices.reader() == 24U);  // NOLINT
+    }
+
+    SECTION("read messages in the order of reservation") {
+        writer_type writer1{indices, buffer};
+        writer_type writer2{indices, buffer};
+        reader_type reader{indices, buffer};
+
+        const auto buffer1 = writer1.try_reserve_message(1U);
+        const auto buffer2 = writer2.try_reserve_message(1U);
+        REQUIRE(buffer1.data() != nullptr);
+        REQUIRE(buffer2.data() != nullptr);
+        buffer1.data()[0] = 'a';
+        buffer2.data()[0] = 'b';
+
+        writer2.commit_message();
+        CHECK(reader.next_message().data() == nullptr);
+
+        writer1.commit_message();
+        CHECK(read(reader) == "a");
+        CHECK(read(reader) == "b");
+        CHECK(reader.next_message().data() == nullptr);
+    }
+
+    SECTION("fail to reserve when the buffer is full") {
+        writer_type writer{indices, buffer};
+        reader_type reader{indices, buffer};
+
+        write(writer, "abcdefgh");
+        write(writer, "ijklmnop");
+        CHECK(writer.try_reserve_message(1U).data() == nullptr);
+
+        CHECK(read(reader) == "abcdefgh");
+        CHECK(writer.try_reserve_message(1U).data() != nullptr);
+    }
+
+    SECTION("skip bytes at the end of the buffer with a padding marker") {
+        indices.reader() = 24U;  // NOLINT
+        indices.writer() = 24U;  // NOLINT
+        writer_type writer{indices, buffer};
+        reader_type reader{indices, buffer};
+
+        write(writer, "abcdef");
+
+        CHECK(indices.writer() == 48U);  // NOLINT
+        CHECK(read(reader) == "abcdef");
+        CHECK(indices.reader() == 48U);  // NOLINT
+    }
+
+    SECTION("send messages from multiple threads") {
+        reader_type reader{indices, buffer};
+
+        constexpr std::size_t num_threads = 4U;
+        constexpr shm_stream_size_t num_messages = 1000U;
+        std::vector<std::thread> threads;
+        threads.reserve(num_threads);
+        for (std::size_t i = 0U; i < num_threads; ++i) {
+            threads.emplace_back([&indices, &buffer, i] {
+                writer_type writer{indices, buffer};
+                for (shm_stream_size_t j = 0U; j < num_messages; ++j) {
+                    mutable_bytes_view message{nullptr, 0U};
+                    while ((message = writer.try_reserve_message(2U))
+                               .data() == nullptr) {
+                        std::this_thread::yield();
+                    }
+                    message.data()[0] = static_cast<char>('a' + i);
+                    message.data()[1] = static_cast<char>(j % 128U);
+                    writer.commit_message();
+                }
+            });
+        }
+
+        std::vector<shm_stream_size_t> counts(num_threads, 0U);
+        for (std::size_t k = 0U; k < num_threads * num_messages; ++k) {
+            shm_stream::bytes_view message{nullptr, 0U};
+            while ((message = reader.next_message()).data() == nullptr) {
+                std::this_thread::yield();
+            }
+            REQUIRE(message.size() == 2U);
+            const auto thread_index =
+                static_cast<std::size_t>(message.data()[0] - 'a');
+            REQUIRE(thread_index < num_threads);
+            CHECK(static_cast<shm_stream_size_t>(message.data()[1]) ==
+                counts[thread_index] % 128U);
+            ++counts[thread_index];
+            reader.commit_message();
+        }
+
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        CHECK(reader.next_message().data() == nullptr);
+    }
+}
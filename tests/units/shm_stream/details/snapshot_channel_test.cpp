@@ -0,0 +1,174 @@
+/*
+ * Copyright 2023 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Test of snapshot_channel class.
+ */
+#include "shm_stream/details/snapshot_channel.h"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <thread>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "shm_stream/bytes_view.h"
+#include "shm_stream/common_types.h"
+
+TEST_CASE("shm_stream::details::snapshot_channel") {
+    using shm_stream::basic_bytes_view;
+    using shm_stream::basic_mutable_bytes_view;
+    using shm_stream::bytes_view;
+    using shm_stream::mutable_bytes_view;
+    using shm_stream::shm_stream_size64_t;
+    using shm_stream::shm_stream_size_t;
+    using shm_stream::details::snapshot_channel_reader;
+    using shm_stream::details::snapshot_channel_writer;
+
+    using writer_type = snapshot_channel_writer<>;
+    using reader_type = snapshot_channel_reader<>;
+
+    writer_type::atomic_type version{0U};
+    constexpr shm_stream_size_t max_size = 16U;
+    constexpr shm_stream_size64_t buffer_size = 64U;
+    alignas(8) char raw_buffer[buffer_size]{};  // NOLINT
+    const auto writer_buffer = basic_mutable_bytes_view<shm_stream_size64_t>(
+        static_cast<char*>(raw_buffer), buffer_size);
+    const auto reader_buffer = basic_bytes_view<shm_stream_size64_t>(
+        static_cast<char*>(raw_buffer), buffer_size);
+
+    std::array<char, max_size> read_buffer{};
+    const auto read = [&read_buffer](reader_type& reader) {
+        shm_stream_size_t size = 0U;
+        (void)reader.read(
+            mutable_bytes_view(read_buffer.data(), max_size), size);
+        return std::string(read_buffer.data(), size);
+    };
+
+    SECTION("calculate the size of buffers") {
+        CHECK(writer_type::buffer_size(max_size) == buffer_size);
+        CHECK(writer_type::buffer_size(0U) == 32U);  // NOLINT
+    }
+
+    SECTION("check size in constructor") {
+        CHECK_THROWS(writer_type(version,
+            basic_mutable_bytes_view<shm_stream_size64_t>(
+                static_cast<char*>(raw_buffer), 48U)));
+        CHECK_THROWS(reader_type(version,
+            basic_bytes_view<shm_stream_size64_t>(
+                static_cast<char*>(raw_buffer), 16U)));
+    }
+
+    SECTION("read before publishing") {
+        reader_type reader{version, reader_buffer};
+
+        shm_stream_size_t size = 1U;
+        CHECK(reader.read(mutable_bytes_view(read_buffer.data(), max_size),
+                  size) == 0U);
+        CHECK(size == 0U);
+        CHECK(reader.version() == 0U);
+    }
+
+    SECTION("publish snapshots") {
+        writer_type writer{version, writer_buffer};
+        reader_type reader{version, reader_buffer};
+        CHECK(writer.max_size() == max_size);
+        CHECK(reader.max_size() == max_size);
+
+        writer.publish(bytes_view("abc", 3U));
+        CHECK(reader.version() == 1U);
+        CHECK(read(reader) == "abc");
+        CHECK(read(reader) == "abc");
+
+        writer.publish(bytes_view("defgh", 5U));
+        writer.publish(bytes_view("ij", 2U));
+        CHECK(reader.version() == 3U);
+        CHECK(read(reader) == "ij");
+
+        CHECK_THROWS(writer.publish(bytes_view(read_buffer.data(), 17U)));
+    }
+
+    SECTION("read the previous snapshot while reserving the next one") {
+        writer_type writer{version, writer_buffer};
+        reader_type reader{version, reader_buffer};
+
+        writer.publish(bytes_view("abc", 3U));
+        const auto buffer = writer.reserve();
+        CHECK(buffer.size() == max_size);
+        std::memcpy(buffer.data(), "def", 3U);
+        CHECK(read(reader) == "abc");
+
+        writer.commit(3U);
+        CHECK(read(reader) == "def");
+    }
+
+    SECTION("truncate a snapshot larger than the buffer") {
+        writer_type writer{version, writer_buffer};
+        reader_type reader{version, reader_buffer};
+
+        writer.publish(bytes_view("abcdef", 6U));
+        std::array<char, 4> small_buffer{};
+        shm_stream_size_t size = 0U;
+        CHECK(reader.read(mutable_bytes_view(small_buffer.data(), 4U), size) ==
+            1U);
+        CHECK(size == 6U);
+        CHECK(std::string(small_buffer.data(), 4U) == "abcd");
+    }
+
+    SECTION("read consistent snapshots while writing in another thread") {
+        constexpr std::uint64_t num_snapshots = 100000U;
+        reader_type reader{version, reader_buffer};
+
+        std::atomic<bool> is_finished{false};
+        std::thread writer_thread{[&version, &writer_buffer, &is_finished] {
+            writer_type writer{version, writer_buffer};
+            for (std::uint64_t i = 1U; i <= num_snapshots; ++i) {
+                const std::array<std::uint64_t, 2> data{i, i};
+                const auto buffer = writer.reserve();
+                std::memcpy(buffer.data(), data.data(), sizeof(data));
+                writer.commit(static_cast<shm_stream_size_t>(sizeof(data)));
+            }
+            is_finished.store(true);
+        }};
+
+        bool is_consistent = true;
+        std::uint64_t last_value = 0U;
+        while (!is_finished.load()) {
+            std::array<std::uint64_t, 2> data{};
+            shm_stream_size_t size = 0U;
+            const auto read_version = reader.read(
+                mutable_bytes_view(static_cast<char*>(static_cast<void*>(
+                                       data.data())),  // NOLINT
+                    sizeof(data)),
+                size);
+            if (read_version == 0U) {
+                continue;
+            }
+            if (data[0] != data[1] || data[0] != read_version ||
+                data[0] < last_value) {
+                is_consistent = false;
+            }
+            last_value = data[0];
+        }
+        writer_thread.join();
+
+        CHECK(is_consistent);
+        CHECK(reader.version() == num_snapshots);
+    }
+}
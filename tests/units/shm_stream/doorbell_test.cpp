@@ -0,0 +1,81 @@
+/*
+ * Copyright 2023 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Test of doorbell class.
+ */
+#include "shm_stream/doorbell.h"
+
+#include <utility>
+
+#include <catch2/catch_test_macros.hpp>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "shm_stream/c_interface/error_codes.h"
+#include "shm_stream/shm_stream_exception.h"
+
+TEST_CASE("shm_stream::doorbell") {
+    using shm_stream::doorbell;
+
+    SECTION("create a doorbell") {
+        const doorbell bell = doorbell::create();
+        CHECK(bell.is_valid());
+        CHECK(bell.fd() >= 0);
+    }
+
+    SECTION("move a doorbell") {
+        doorbell bell = doorbell::create();
+        const int fd = bell.fd();
+
+        doorbell moved{std::move(bell)};
+        CHECK(moved.fd() == fd);
+        CHECK_FALSE(bell.is_valid());  // NOLINT
+
+        moved.reset();
+        CHECK_FALSE(moved.is_valid());
+    }
+
+    SECTION("send a doorbell via a socket") {
+        int sockets[2] = {-1, -1};
+        REQUIRE(::socketpair(AF_UNIX, SOCK_STREAM, 0, sockets) == 0);
+
+        const doorbell bell = doorbell::create();
+        bell.send(sockets[0]);
+        const doorbell received = doorbell::receive(sockets[1]);
+        CHECK(received.is_valid());
+        CHECK(received.fd() != bell.fd());
+
+        ::close(sockets[0]);
+        ::close(sockets[1]);
+    }
+
+    SECTION("send an empty doorbell") {
+        int sockets[2] = {-1, -1};
+        REQUIRE(::socketpair(AF_UNIX, SOCK_STREAM, 0, sockets) == 0);
+
+        const doorbell bell;
+        try {
+            bell.send(sockets[0]);
+            FAIL();
+        } catch (const shm_stream::shm_stream_error& e) {
+            CHECK(e.code() == c_shm_stream_error_code_invalid_argument);
+        }
+
+        ::close(sockets[0]);
+        ::close(sockets[1]);
+    }
+}
@@ -0,0 +1,248 @@
+/*
+ * Copyright 2023 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Test of file-backed streams of bytes.
+ */
+#include "shm_stream/file_stream.h"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <string>
+#include <thread>
+
+#include <boost/interprocess/file_mapping.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "shm_stream/c_interface/error_codes.h"
+#include "shm_stream/common_types.h"
+#include "shm_stream/flush_policy.h"
+#include "shm_stream/shm_stream_exception.h"
+
+namespace {
+
+/*!
+ * \brief Write a string to a stream.
+ *
+ * \param[in] writer Writer.
+ * \param[in] data String.
+ */
+void write_string(
+    shm_stream::file_stream_writer& writer, const std::string& data) {
+    const auto buffer = writer.try_reserve(data.size());
+    REQUIRE(buffer.size() == data.size());
+    std::copy(data.begin(), data.end(), buffer.data());
+    writer.commit(buffer.size());
+}
+
+/*!
+ * \brief Read a string from a stream.
+ *
+ * \param[in] reader Reader.
+ * \return String.
+ */
+std::string read_string(shm_stream::file_stream_reader& reader) {
+    const auto buffer = reader.try_reserve();
+    std::string data{buffer.data(), buffer.size()};
+    reader.commit(buffer.size());
+    return data;
+}
+
+}  // namespace
+
+TEST_CASE("shm_stream::file_stream") {
+    using shm_stream::file_stream_reader;
+    using shm_stream::file_stream_writer;
+    using shm_stream::shm_stream_size_t;
+
+    const std::string path = "file_stream_test.bin";
+    shm_stream::file_stream::remove(path);
+
+    SECTION("create a stream") {
+        constexpr shm_stream_size_t buffer_size = 10U;
+        shm_stream::file_stream::create(path, buffer_size);
+
+        CHECK(std::ifstream(path).good());
+    }
+
+    SECTION("create a stream with a buffer of size zero") {
+        constexpr shm_stream_size_t buffer_size = 0U;
+        CHECK_THROWS_AS(shm_stream::file_stream::create(path, buffer_size),
+            shm_stream::shm_stream_error);
+    }
+
+    SECTION("transfer bytes") {
+        constexpr shm_stream_size_t buffer_size = 10U;
+        file_stream_writer writer;
+        writer.open(path, buffer_size);
+        CHECK(writer.is_opened());
+        file_stream_reader reader;
+        reader.open(path, buffer_size);
+        CHECK(reader.is_opened());
+        CHECK(writer.available_size() == buffer_size - 1U);
+        CHECK(reader.available_size() == 0U);
+
+        write_string(writer, "abcdef");
+        CHECK(writer.available_size() == buffer_size - 7U);
+        CHECK(reader.available_size() == 6U);
+
+        CHECK(read_string(reader) == "abcdef");
+        CHECK(writer.available_size() == buffer_size - 1U);
+
+        // Reservations wrap around the end of the buffer.
+        write_string(writer, "ghij");
+        write_string(writer, "kl");
+        CHECK(read_string(reader) == "ghij");
+        CHECK(read_string(reader) == "kl");
+    }
+
+    SECTION("replay bytes after reopening a stream") {
+        constexpr shm_stream_size_t buffer_size = 10U;
+        {
+            file_stream_writer writer;
+            writer.open(
+                path, buffer_size, shm_stream::flush_policy::on_commit());
+            write_string(writer, "abc");
+            write_string(writer, "def");
+        }
+        {
+            file_stream_reader reader;
+            reader.open(path, buffer_size);
+            const auto buffer = reader.try_reserve(3U);
+            CHECK(std::string(buffer.data(), buffer.size()) == "abc");
+            reader.commit(buffer.size());
+        }
+        {
+            file_stream_reader reader;
+            reader.open(path, buffer_size);
+            CHECK(read_string(reader) == "def");
+        }
+    }
+
+    SECTION("flush a stream periodically") {
+        constexpr shm_stream_size_t buffer_size = 10U;
+        constexpr auto interval = std::chrono::milliseconds(200);
+        file_stream_writer writer;
+        writer.open(
+            path, buffer_size, shm_stream::flush_policy::periodic(interval));
+        write_string(writer, "abc");
+        CHECK(writer.flush_count() == 0U);
+
+        std::this_thread::sleep_for(interval * 2);
+        write_string(writer, "def");
+        CHECK(writer.flush_count() == 1U);
+
+        file_stream_reader reader;
+        reader.open(path, buffer_size);
+        CHECK(read_string(reader) == "abcdef");
+    }
+
+    SECTION("flush a stream on every commit") {
+        constexpr shm_stream_size_t buffer_size = 10U;
+        file_stream_writer writer;
+        writer.open(
+            path, buffer_size, shm_stream::flush_policy::on_commit());
+        write_string(writer, "abc");
+        CHECK(writer.flush_count() == 1U);
+        write_string(writer, "def");
+        CHECK(writer.flush_count() == 2U);
+
+        file_stream_reader reader;
+        reader.open(path, buffer_size);
+        CHECK(read_string(reader) == "abcdef");
+    }
+
+    SECTION("flush a stream only when requested") {
+        constexpr shm_stream_size_t buffer_size = 10U;
+        file_stream_writer writer;
+        writer.open(path, buffer_size, shm_stream::flush_policy());
+        write_string(writer, "abc");
+        CHECK(writer.flush_count() == 0U);
+        CHECK_NOTHROW(writer.flush());
+        CHECK(writer.flush_count() == 1U);
+    }
+
+    SECTION("open a broken file") {
+        {
+            std::ofstream stream(path);
+            stream << "not a stream";
+        }
+        constexpr shm_stream_size_t buffer_size = 10U;
+        file_stream_writer writer;
+        try {
+            writer.open(path, buffer_size);
+            FAIL();
+        } catch (const shm_stream::shm_stream_error& e) {
+            CHECK(e.code() == c_shm_stream_error_code_failed_to_open);
+        }
+        CHECK_FALSE(writer.is_opened());
+    }
+
+    SECTION("open a file with a corrupted index") {
+        constexpr shm_stream_size_t buffer_size = 10U;
+        shm_stream::file_stream::create(path, buffer_size);
+        {
+            // The index of the writer is at the beginning of the file.
+            std::fstream stream(
+                path, std::ios::in | std::ios::out | std::ios::binary);
+            const shm_stream_size_t index = buffer_size;
+            stream.write(reinterpret_cast<const char*>(&index),  // NOLINT
+                sizeof(index));
+        }
+
+        file_stream_writer writer;
+        try {
+            writer.open(path, buffer_size);
+            FAIL();
+        } catch (const shm_stream::shm_stream_error& e) {
+            CHECK(e.code() == c_shm_stream_error_code_failed_to_open);
+        }
+        CHECK_FALSE(writer.is_opened());
+
+        file_stream_reader reader;
+        try {
+            reader.open(path, buffer_size);
+            FAIL();
+        } catch (const shm_stream::shm_stream_error& e) {
+            CHECK(e.code() == c_shm_stream_error_code_failed_to_open);
+        }
+        CHECK_FALSE(reader.is_opened());
+    }
+
+    SECTION("remove a stream") {
+        constexpr shm_stream_size_t buffer_size = 10U;
+        shm_stream::file_stream::create(path, buffer_size);
+        shm_stream::file_stream::remove(path);
+
+        CHECK_FALSE(boost::interprocess::file_mapping::remove(path.c_str()));
+    }
+
+    SECTION("call functions for closed stream") {
+        file_stream_writer writer;
+        CHECK(writer.available_size() == 0U);
+        CHECK(writer.try_reserve().size() == 0U);
+        CHECK_THROWS(writer.commit(0U));
+        CHECK_THROWS(writer.flush());
+
+        file_stream_reader reader;
+        CHECK(reader.available_size() == 0U);
+        CHECK(reader.try_reserve().size() == 0U);
+        CHECK_NOTHROW(reader.commit(0U));
+    }
+
+    shm_stream::file_stream::remove(path);
+}
@@ -0,0 +1,132 @@
+/*
+ * Copyright 2023 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Test of light streams of bytes with operations inlined into callers.
+ */
+#include "shm_stream/inline_light_stream.h"
+
+#include <string>
+
+#include <boost/interprocess/shared_memory_object.hpp>
+#include <boost/interprocess/sync/named_mutex.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <poll.h>
+
+#include "shm_stream/common_types.h"
+#include "shm_stream/doorbell.h"
+#include "shm_stream/light_stream.h"
+
+TEST_CASE("shm_stream::inline_light_stream") {
+    using shm_stream::shm_stream_size_t;
+
+    const std::string stream_name = "inline_light_stream_test";
+    const auto remove_stream = [&stream_name] {
+        boost::interprocess::shared_memory_object::remove(
+            ("shm_stream_light_stream_data_" + stream_name).c_str());
+        boost::interprocess::named_mutex::remove(
+            ("shm_stream_light_stream_lock_" + stream_name).c_str());
+    };
+    remove_stream();
+
+    constexpr shm_stream_size_t buffer_size = 10U;
+
+    SECTION("open and close") {
+        shm_stream::inline_light_stream_writer writer;
+        CHECK_FALSE(writer.is_opened());
+        writer.open(stream_name, buffer_size);
+        CHECK(writer.is_opened());
+        CHECK(writer.available_size() == buffer_size - 1U);
+
+        shm_stream::inline_light_stream_reader reader;
+        CHECK_FALSE(reader.is_opened());
+        reader.open(stream_name, buffer_size);
+        CHECK(reader.is_opened());
+        CHECK(reader.available_size() == 0U);
+
+        writer.close();
+        CHECK_FALSE(writer.is_opened());
+        reader.close();
+        CHECK_FALSE(reader.is_opened());
+    }
+
+    SECTION("write and read bytes around the end of the buffer") {
+        shm_stream::inline_light_stream_writer writer;
+        writer.open(stream_name, buffer_size);
+        shm_stream::inline_light_stream_reader reader;
+        reader.open(stream_name, buffer_size);
+
+        std::string read_data;
+        const std::string data = "abcdefg";
+        for (int i = 0; i < 3; ++i) {
+            for (std::size_t offset = 0U; offset < data.size();) {
+                const auto buffer = writer.try_reserve(
+                    static_cast<shm_stream_size_t>(data.size() - offset));
+                REQUIRE_FALSE(buffer.empty());
+                data.copy(buffer.data(), buffer.size(), offset);
+                writer.commit(buffer.size());
+                offset += buffer.size();
+            }
+            while (reader.available_size() > 0U) {
+                const auto buffer = reader.try_reserve();
+                read_data.append(buffer.data(), buffer.size());
+                reader.commit(buffer.size());
+            }
+        }
+        CHECK(read_data == data + data + data);
+    }
+
+    SECTION("communicate with usual streams") {
+        shm_stream::inline_light_stream_writer writer;
+        writer.open(stream_name, buffer_size);
+        shm_stream::light_stream_reader reader;
+        reader.open(stream_name, buffer_size);
+
+        const auto buffer = writer.try_reserve(3U);
+        REQUIRE(buffer.size() == 3U);
+        buffer.data()[0] = 'a';
+        buffer.data()[1] = 'b';
+        buffer.data()[2] = 'c';
+        writer.commit(3U);
+
+        const auto read_buffer = reader.try_reserve();
+        CHECK(std::string(read_buffer.data(), read_buffer.size()) == "abc");
+        reader.commit(read_buffer.size());
+        CHECK(writer.available_size() == buffer_size - 1U);
+    }
+
+    SECTION("ring a doorbell") {
+        shm_stream::inline_light_stream_writer writer;
+        writer.open(stream_name, buffer_size);
+        shm_stream::light_stream_reader reader;
+        reader.open(stream_name, buffer_size);
+        const auto bell = shm_stream::doorbell::create();
+        writer.set_doorbell(bell);
+        reader.set_doorbell(bell);
+        ::pollfd fd{bell.fd(), POLLIN, 0};
+
+        writer.commit(writer.try_reserve(1U).size());
+        CHECK(::poll(&fd, 1, 0) == 0);
+        reader.commit(reader.try_reserve().size());
+
+        CHECK(reader.arm_doorbell());
+        writer.commit(writer.try_reserve(2U).size());
+        CHECK(::poll(&fd, 1, 0) == 1);
+        CHECK(reader.available_size() == 2U);
+    }
+
+    remove_stream();
+}
@@ -0,0 +1,117 @@
+/*
+ * Copyright 2023 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Test of streams of messages without waiting (possibly lock-free).
+ */
+#include "shm_stream/light_message_stream.h"
+
+#include <cstring>
+#include <string>
+
+#include <boost/interprocess/shared_memory_object.hpp>
+#include <boost/interprocess/sync/named_mutex.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+TEST_CASE("shm_stream::light_message_stream") {
+    using shm_stream::light_message_stream_reader;
+    using shm_stream::light_message_stream_writer;
+    using shm_stream::shm_stream_size_t;
+
+    const std::string stream_name = "light_message_stream_test";
+    boost::interprocess::shared_memory_object::remove(
+        ("shm_stream_light_message_stream_data_" + stream_name).c_str());
+    boost::interprocess::named_mutex::remove(
+        ("shm_stream_light_message_stream_lock_" + stream_name).c_str());
+
+    SECTION("open streams") {
+        light_message_stream_writer writer;
+        light_message_stream_reader reader;
+        CHECK_FALSE(writer.is_opened());
+        CHECK_FALSE(reader.is_opened());
+
+        constexpr shm_stream_size_t buffer_size = 32U;
+        writer.open(stream_name, buffer_size);
+        reader.open(stream_name, buffer_size);
+        CHECK(writer.is_opened());
+        CHECK(reader.is_opened());
+        CHECK(writer.max_message_size() == 27U);  // NOLINT
+
+        writer.close();
+        reader.close();
+        CHECK_FALSE(writer.is_opened());
+        CHECK_FALSE(reader.is_opened());
+    }
+
+    SECTION("send messages") {
+        constexpr shm_stream_size_t buffer_size = 32U;
+        light_message_stream_writer writer;
+        writer.open(stream_name, buffer_size);
+        light_message_stream_reader reader;
+        reader.open(stream_name, buffer_size);
+
+        constexpr shm_stream_size_t num_messages = 20U;
+        for (shm_stream_size_t i = 0U; i < num_messages; ++i) {
+            const std::string message(i % 10U, static_cast<char>('a' + i));
+            const auto write_buffer = writer.reserve_message(
+                static_cast<shm_stream_size_t>(message.size()));
+            REQUIRE(write_buffer.data() != nullptr);
+            std::memcpy(write_buffer.data(), message.data(), message.size());
+            writer.commit_message();
+
+            const auto read_buffer = reader.next_message();
+            REQUIRE(read_buffer.data() != nullptr);
+            CHECK(std::string(read_buffer.data(), read_buffer.size()) ==
+                message);
+            reader.commit_message();
+        }
+        CHECK(reader.next_message().data() == nullptr);
+    }
+
+    SECTION("reserve a too large message") {
+        constexpr shm_stream_size_t buffer_size = 32U;
+        light_message_stream_writer writer;
+        writer.open(stream_name, buffer_size);
+
+        CHECK_THROWS((void)writer.reserve_message(28U));  // NOLINT
+    }
+
+    SECTION("call functions for closed stream") {
+        light_message_stream_writer writer;
+        light_message_stream_reader reader;
+
+        CHECK(writer.max_message_size() == 0U);
+        CHECK_NOTHROW(writer.commit_message());
+        CHECK(reader.next_message().data() == nullptr);
+        CHECK_NOTHROW(reader.commit_message());
+    }
+
+    SECTION("create and remove a stream") {
+        constexpr shm_stream_size_t buffer_size = 32U;
+        shm_stream::light_message_stream::create(stream_name, buffer_size);
+        shm_stream::light_message_stream::remove(stream_name);
+
+        CHECK_FALSE(boost::interprocess::shared_memory_object::remove(
+            ("shm_stream_light_message_stream_data_" + stream_name).c_str()));
+        CHECK_FALSE(boost::interprocess::named_mutex::remove(
+            ("shm_stream_light_message_stream_lock_" + stream_name).c_str()));
+    }
+
+    boost::interprocess::shared_memory_object::remove(
+        ("shm_stream_light_message_stream_data_" + stream_name).c_str());
+    boost::interprocess::named_mutex::remove(
+        ("shm_stream_light_message_stream_lock_" + stream_name).c_str());
+}
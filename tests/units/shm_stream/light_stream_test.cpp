@@ -19,9 +19,22 @@
  */
 #include "shm_stream/light_stream.h"
 
+#include <algorithm>
+#include <array>
+#include <string>
+#include <vector>
+
+#include <boost/interprocess/mapped_region.hpp>
 #include <boost/interprocess/shared_memory_object.hpp>
 #include <boost/interprocess/sync/named_mutex.hpp>
 #include <catch2/catch_test_macros.hpp>
+#include <poll.h>
+
+#include "shm_stream/c_interface/error_codes.h"
+#include "shm_stream/common_types.h"
+#include "shm_stream/doorbell.h"
+#include "shm_stream/shm_stream_exception.h"
+#include "shm_stream_test/huge_pages.h"
 
 TEST_CASE("shm_stream::light_stream_writer") {
     using shm_stream::light_stream_writer;
@@ -126,6 +139,8 @@ TEST_CASE("shm_stream::light_stream_writer") {
         CHECK(writer.try_reserve(1U).size() == 0U);  // NOLINT
         CHECK(writer.try_reserve().size() == 0U);    // NOLINT
         CHECK_NOTHROW(writer.commit(1U));
+        CHECK_FALSE(writer.try_write_gather({shm_stream::bytes_view("a", 1U)}));
+        CHECK_FALSE(writer.try_write_all(shm_stream::bytes_view("a", 1U)));
     }
 
     boost::interprocess::shared_memory_object::remove(
@@ -154,6 +169,26 @@ TEST_CASE("shm_stream::light_stream_reader") {
         CHECK(reader.is_opened());
     }
 
+    SECTION("open a stream with options of memory") {
+        constexpr shm_stream_size_t buffer_size = 10U;
+        light_stream_writer writer;
+        writer.open(
+            stream_name, buffer_size, shm_stream::memory_options::prefault);
+        light_stream_reader reader;
+        reader.open(stream_name, buffer_size,
+            shm_stream::memory_options::prefault |
+                shm_stream::memory_options::lock);
+        REQUIRE(reader.is_opened());
+
+        const std::string data = "abc";
+        const auto write_buffer = writer.try_reserve();
+        std::copy(data.begin(), data.end(), write_buffer.data());
+        writer.commit(static_cast<shm_stream_size_t>(data.size()));
+
+        const auto read_buffer = reader.try_reserve();
+        CHECK(std::string(read_buffer.data(), read_buffer.size()) == data);
+    }
+
     SECTION("move construct") {
         light_stream_reader reader;
         constexpr shm_stream_size_t buffer_size = 10U;
@@ -247,6 +282,62 @@ TEST_CASE("shm_stream::light_stream_reader") {
         CHECK(reader.available_size() == 1U);
     }
 
+    SECTION("transfer pieces of bytes at once") {
+        light_stream_reader reader;
+        constexpr shm_stream_size_t buffer_size = 10U;
+        reader.open(stream_name, buffer_size);
+        light_stream_writer writer;
+        writer.open(stream_name, buffer_size);
+        (void)writer.try_reserve();
+        writer.commit(7U);  // NOLINT
+        (void)reader.try_reserve();
+        reader.commit(7U);  // NOLINT
+
+        CHECK(writer.try_write_gather({shm_stream::bytes_view("abc", 3U),
+            shm_stream::bytes_view("defg", 4U)}));  // NOLINT
+        CHECK(reader.available_size() == 7U);       // NOLINT
+
+        std::array<char, 4> first{};
+        std::array<char, 3> second{};
+        CHECK(reader.try_read_scatter(
+            {shm_stream::mutable_bytes_view(first.data(), first.size()),
+                shm_stream::mutable_bytes_view(second.data(), second.size())}));
+        CHECK(std::string(first.data(), first.size()) == "abcd");
+        CHECK(std::string(second.data(), second.size()) == "efg");
+        CHECK(reader.available_size() == 0U);
+    }
+
+    SECTION("transfer a large byte sequence at once") {
+        light_stream_reader reader;
+        constexpr shm_stream_size_t data_size = 1024U * 1024U;  // NOLINT
+        constexpr shm_stream_size_t offset = 1001U;             // NOLINT
+        constexpr shm_stream_size_t buffer_size = data_size + offset;
+        reader.open(stream_name, buffer_size);
+        light_stream_writer writer;
+        writer.open(stream_name, buffer_size);
+        (void)writer.try_reserve();
+        writer.commit(offset);
+        (void)reader.try_reserve();
+        reader.commit(offset);
+
+        std::vector<char> data(data_size);
+        for (std::size_t i = 0; i < data.size(); ++i) {
+            data[i] = static_cast<char>(i % 251U);  // NOLINT
+        }
+        CHECK_FALSE(writer.try_write_all(
+            shm_stream::bytes_view(data.data(), buffer_size)));
+        CHECK(writer.try_write_all(
+            shm_stream::bytes_view(data.data(), data_size)));
+        CHECK(reader.available_size() == data_size);
+
+        std::vector<char> received(data_size);
+        CHECK(reader.try_read_exact(
+            shm_stream::mutable_bytes_view(received.data(), data_size)));
+        CHECK(received == data);
+        CHECK_FALSE(reader.try_read_exact(
+            shm_stream::mutable_bytes_view(received.data(), 1U)));
+    }
+
     SECTION("call functions for closed stream") {
         light_stream_reader reader;
 
@@ -254,6 +345,11 @@ TEST_CASE("shm_stream::light_stream_reader") {
         CHECK(reader.try_reserve(1U).size() == 0U);  // NOLINT
         CHECK(reader.try_reserve().size() == 0U);    // NOLINT
         CHECK_NOTHROW(reader.commit(1U));
+        char byte{};
+        CHECK_FALSE(reader.try_read_scatter(
+            {shm_stream::mutable_bytes_view(&byte, 1U)}));
+        CHECK_FALSE(
+            reader.try_read_exact(shm_stream::mutable_bytes_view(&byte, 1U)));
     }
 
     boost::interprocess::shared_memory_object::remove(
@@ -282,6 +378,170 @@ TEST_CASE("shm_stream::light_stream") {
             ("shm_stream_light_stream_lock_" + stream_name).c_str()));
     }
 
+    SECTION("create a stream with a mirrored buffer") {
+        const auto buffer_size = static_cast<shm_stream_size_t>(
+            boost::interprocess::mapped_region::get_page_size());
+        shm_stream::light_stream::create(
+            stream_name, buffer_size, shm_stream::buffer_layout::mirrored);
+        shm_stream::light_stream_writer writer;
+        writer.open(stream_name, buffer_size);
+        shm_stream::light_stream_reader reader;
+        reader.open(stream_name, buffer_size);
+
+        constexpr shm_stream_size_t first_size = 10U;
+        writer.commit(writer.try_reserve(first_size).size());
+        reader.commit(reader.try_reserve().size());
+
+        const auto write_buffer = writer.try_reserve();
+        REQUIRE(write_buffer.size() == buffer_size - 1U);
+        for (shm_stream_size_t i = 0U; i < write_buffer.size(); ++i) {
+            write_buffer.data()[i] = static_cast<char>(i);
+        }
+        writer.commit(write_buffer.size());
+
+        const auto read_buffer = reader.try_reserve();
+        REQUIRE(read_buffer.size() == buffer_size - 1U);
+        bool is_same = true;
+        for (shm_stream_size_t i = 0U; i < read_buffer.size(); ++i) {
+            is_same =
+                is_same && (read_buffer.data()[i] == static_cast<char>(i));
+        }
+        CHECK(is_same);
+        reader.commit(read_buffer.size());
+        CHECK(reader.available_size() == 0U);
+    }
+
+    SECTION("create a stream with a buffer on huge pages") {
+        constexpr shm_stream_size_t buffer_size = 100U;
+        shm_stream::light_stream::create(
+            stream_name, buffer_size, shm_stream::buffer_layout::huge_pages);
+        shm_stream::light_stream_writer writer;
+        writer.open(stream_name, buffer_size);
+        shm_stream::light_stream_reader reader;
+        reader.open(stream_name, buffer_size);
+
+        const auto write_buffer = writer.try_reserve();
+        REQUIRE(write_buffer.size() == buffer_size - 1U);
+        for (shm_stream_size_t i = 0U; i < write_buffer.size(); ++i) {
+            write_buffer.data()[i] = static_cast<char>(i);
+        }
+        writer.commit(write_buffer.size());
+
+        const auto read_buffer = reader.try_reserve();
+        REQUIRE(read_buffer.size() == buffer_size - 1U);
+        bool is_same = true;
+        for (shm_stream_size_t i = 0U; i < read_buffer.size(); ++i) {
+            is_same =
+                is_same && (read_buffer.data()[i] == static_cast<char>(i));
+        }
+        CHECK(is_same);
+        reader.commit(read_buffer.size());
+
+        const auto normal_page_size = static_cast<shm_stream_size_t>(
+            boost::interprocess::mapped_region::get_page_size());
+        const auto huge_page_size =
+            static_cast<shm_stream_size_t>(shm_stream_test::huge_page_size());
+        if (shm_stream_test::is_hugetlbfs_available()) {
+            CHECK(writer.page_size() == huge_page_size);
+            CHECK(reader.page_size() == huge_page_size);
+        } else if (shm_stream_test::is_shmem_thp_disabled()) {
+            CHECK(writer.page_size() == normal_page_size);
+            CHECK(reader.page_size() == normal_page_size);
+        } else {
+            // Transparent huge pages are not guaranteed to be allocated.
+            CHECK((writer.page_size() == huge_page_size ||
+                writer.page_size() == normal_page_size));
+            CHECK(reader.page_size() == writer.page_size());
+        }
+
+        // Files in hugetlbfs are removed only with the stream.
+        writer.close();
+        reader.close();
+        shm_stream::light_stream::remove(stream_name);
+    }
+
+    SECTION("get the page size of a stream") {
+        constexpr shm_stream_size_t buffer_size = 100U;
+        shm_stream::light_stream_writer writer;
+        CHECK(writer.page_size() == 0U);
+
+        writer.open(stream_name, buffer_size);
+        CHECK(writer.page_size() ==
+            static_cast<shm_stream_size_t>(
+                boost::interprocess::mapped_region::get_page_size()));
+    }
+
+    SECTION("create a stream on a NUMA node") {
+        constexpr shm_stream_size_t buffer_size = 100U;
+        try {
+            shm_stream::light_stream::create(stream_name, buffer_size,
+                shm_stream::buffer_layout::plain,
+                shm_stream::numa_node_current);
+        } catch (const shm_stream::shm_stream_error& e) {
+            // NUMA policies can be unavailable in some environments.
+            CHECK(e.code() == c_shm_stream_error_code_not_supported);
+            return;
+        }
+        shm_stream::light_stream_writer writer;
+        writer.open(stream_name, buffer_size);
+        CHECK(writer.numa_node() >= 0);
+    }
+
+    SECTION("create a stream on an invalid NUMA node") {
+        constexpr shm_stream_size_t buffer_size = 100U;
+        constexpr shm_stream::numa_node_t invalid_numa_node = 1023;
+        CHECK_THROWS(shm_stream::light_stream::create(stream_name,
+            buffer_size, shm_stream::buffer_layout::plain, invalid_numa_node));
+
+        CHECK_FALSE(boost::interprocess::shared_memory_object::remove(
+            ("shm_stream_light_stream_data_" + stream_name).c_str()));
+    }
+
+    SECTION("create an existing stream on an invalid NUMA node") {
+        constexpr shm_stream_size_t buffer_size = 100U;
+        shm_stream::light_stream::create(stream_name, buffer_size);
+
+        // Pages of existing streams are not bound again.
+        constexpr shm_stream::numa_node_t invalid_numa_node = 1023;
+        CHECK_NOTHROW(shm_stream::light_stream::create(stream_name,
+            buffer_size, shm_stream::buffer_layout::plain, invalid_numa_node));
+    }
+
+    SECTION("create a stream with a mirrored buffer of an invalid size") {
+        constexpr shm_stream_size_t buffer_size = 10U;
+        CHECK_THROWS(shm_stream::light_stream::create(
+            stream_name, buffer_size, shm_stream::buffer_layout::mirrored));
+    }
+
+    SECTION("wait for a doorbell") {
+        constexpr shm_stream_size_t buffer_size = 10U;
+        shm_stream::light_stream_writer writer;
+        writer.open(stream_name, buffer_size);
+        shm_stream::light_stream_reader reader;
+        reader.open(stream_name, buffer_size);
+        const auto bell = shm_stream::doorbell::create();
+        writer.set_doorbell(bell);
+        reader.set_doorbell(bell);
+        ::pollfd fd{bell.fd(), POLLIN, 0};
+
+        // Doorbell is not rung without arming.
+        writer.commit(writer.try_reserve(1U).size());
+        CHECK(::poll(&fd, 1, 0) == 0);
+        CHECK_FALSE(reader.arm_doorbell());
+        reader.commit(reader.try_reserve().size());
+
+        CHECK(reader.arm_doorbell());
+        CHECK(::poll(&fd, 1, 0) == 0);
+        writer.commit(writer.try_reserve(3U).size());
+        CHECK(::poll(&fd, 1, 0) == 1);
+        CHECK(reader.available_size() == 3U);
+        reader.commit(reader.try_reserve().size());
+
+        // Arming clears the last notification.
+        CHECK(reader.arm_doorbell());
+        CHECK(::poll(&fd, 1, 0) == 0);
+    }
+
     SECTION("remove a stream") {
         constexpr shm_stream_size_t buffer_size = 10U;
         shm_stream::light_stream::create(stream_name, buffer_size);
@@ -0,0 +1,151 @@
+/*
+ * Copyright 2023 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Test of lossy streams of messages.
+ */
+#include "shm_stream/lossy_stream.h"
+
+#include <cstring>
+#include <string>
+
+#include <boost/interprocess/shared_memory_object.hpp>
+#include <boost/interprocess/sync/named_mutex.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+TEST_CASE("shm_stream::lossy_stream") {
+    using shm_stream::lossy_stream_reader;
+    using shm_stream::lossy_stream_writer;
+    using shm_stream::shm_stream_size_t;
+
+    const std::string stream_name = "lossy_stream_test";
+    boost::interprocess::shared_memory_object::remove(
+        ("shm_stream_lossy_stream_data_" + stream_name).c_str());
+    boost::interprocess::named_mutex::remove(
+        ("shm_stream_lossy_stream_lock_" + stream_name).c_str());
+
+    constexpr shm_stream_size_t num_records = 4U;
+    constexpr shm_stream_size_t max_message_size = 10U;
+
+    const auto write = [](lossy_stream_writer& writer,
+                           const std::string& message) {
+        const auto buffer = writer.reserve_message(
+            static_cast<shm_stream_size_t>(message.size()));
+        REQUIRE(buffer.data() != nullptr);
+        std::memcpy(buffer.data(), message.data(), message.size());
+        writer.commit_message();
+    };
+    const auto read = [](lossy_stream_reader& reader) {
+        const auto buffer = reader.next_message();
+        REQUIRE(buffer.data() != nullptr);
+        std::string message{buffer.data(), buffer.size()};
+        REQUIRE(reader.commit_message());
+        return message;
+    };
+
+    SECTION("open streams") {
+        lossy_stream_writer writer;
+        lossy_stream_reader reader;
+        CHECK_FALSE(writer.is_opened());
+        CHECK_FALSE(reader.is_opened());
+
+        writer.open(stream_name, num_records, max_message_size);
+        reader.open(stream_name, num_records, max_message_size);
+        CHECK(writer.is_opened());
+        CHECK(reader.is_opened());
+        CHECK(writer.max_message_size() == max_message_size);
+
+        writer.close();
+        reader.close();
+        CHECK_FALSE(writer.is_opened());
+        CHECK_FALSE(reader.is_opened());
+    }
+
+    SECTION("open a stream with a number of records not a power of two") {
+        lossy_stream_writer writer;
+        CHECK_THROWS(writer.open(stream_name, 3U, max_message_size));
+    }
+
+    SECTION("send messages") {
+        lossy_stream_writer writer;
+        writer.open(stream_name, num_records, max_message_size);
+        lossy_stream_reader reader;
+        reader.open(stream_name, num_records, max_message_size);
+
+        constexpr shm_stream_size_t num_messages = 20U;
+        for (shm_stream_size_t i = 0U; i < num_messages; ++i) {
+            const std::string message(i % 10U, static_cast<char>('a' + i));
+            write(writer, message);
+            CHECK(read(reader) == message);
+        }
+        CHECK(reader.next_message().data() == nullptr);
+        CHECK(reader.lost_messages() == 0U);
+    }
+
+    SECTION("overwrite messages with multiple readers") {
+        lossy_stream_writer writer;
+        writer.open(stream_name, num_records, max_message_size);
+        lossy_stream_reader reader1;
+        reader1.open(stream_name, num_records, max_message_size);
+        lossy_stream_reader reader2;
+        reader2.open(stream_name, num_records, max_message_size);
+
+        write(writer, "a");
+        CHECK(read(reader1) == "a");
+        for (char c = 'b'; c < 'h'; ++c) {
+            write(writer, std::string(1, c));
+        }
+
+        CHECK(read(reader1) == "d");
+        CHECK(reader1.lost_messages() == 2U);
+        CHECK(read(reader2) == "d");
+        CHECK(reader2.lost_messages() == 3U);
+    }
+
+    SECTION("reserve a too large message") {
+        lossy_stream_writer writer;
+        writer.open(stream_name, num_records, max_message_size);
+
+        CHECK_THROWS((void)writer.reserve_message(max_message_size + 1U));
+    }
+
+    SECTION("call functions for closed stream") {
+        lossy_stream_writer writer;
+        lossy_stream_reader reader;
+
+        CHECK(writer.max_message_size() == 0U);
+        CHECK_NOTHROW(writer.commit_message());
+        CHECK(reader.next_message().data() == nullptr);
+        CHECK_FALSE(reader.commit_message());
+        CHECK(reader.lost_messages() == 0U);
+    }
+
+    SECTION("create and remove a stream") {
+        shm_stream::lossy_stream::create(
+            stream_name, num_records, max_message_size);
+        shm_stream::lossy_stream::remove(stream_name);
+
+        CHECK_FALSE(boost::interprocess::shared_memory_object::remove(
+            ("shm_stream_lossy_stream_data_" + stream_name).c_str()));
+        CHECK_FALSE(boost::interprocess::named_mutex::remove(
+            ("shm_stream_lossy_stream_lock_" + stream_name).c_str()));
+    }
+
+    boost::interprocess::shared_memory_object::remove(
+        ("shm_stream_lossy_stream_data_" + stream_name).c_str());
+    boost::interprocess::named_mutex::remove(
+        ("shm_stream_lossy_stream_lock_" + stream_name).c_str());
+}
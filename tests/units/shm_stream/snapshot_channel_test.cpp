@@ -0,0 +1,128 @@
+/*
+ * Copyright 2023 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Test of channels of the latest snapshots.
+ */
+#include "shm_stream/snapshot_channel.h"
+
+#include <array>
+#include <cstring>
+#include <string>
+
+#include <boost/interprocess/shared_memory_object.hpp>
+#include <boost/interprocess/sync/named_mutex.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+TEST_CASE("shm_stream::snapshot_channel") {
+    using shm_stream::bytes_view;
+    using shm_stream::mutable_bytes_view;
+    using shm_stream::shm_stream_size_t;
+    using shm_stream::snapshot_channel_reader;
+    using shm_stream::snapshot_channel_writer;
+
+    const std::string channel_name = "snapshot_channel_test";
+    boost::interprocess::shared_memory_object::remove(
+        ("shm_stream_snapshot_channel_data_" + channel_name).c_str());
+    boost::interprocess::named_mutex::remove(
+        ("shm_stream_snapshot_channel_lock_" + channel_name).c_str());
+
+    constexpr shm_stream_size_t max_size = 32U;
+    std::array<char, max_size> read_buffer{};
+    const auto read = [&read_buffer](snapshot_channel_reader& reader) {
+        shm_stream_size_t size = 0U;
+        (void)reader.read(
+            mutable_bytes_view(read_buffer.data(), max_size), size);
+        return std::string(read_buffer.data(), size);
+    };
+
+    SECTION("open channels") {
+        snapshot_channel_writer writer;
+        snapshot_channel_reader reader;
+        CHECK_FALSE(writer.is_opened());
+        CHECK_FALSE(reader.is_opened());
+
+        writer.open(channel_name, max_size);
+        reader.open(channel_name, max_size);
+        CHECK(writer.is_opened());
+        CHECK(reader.is_opened());
+        CHECK(writer.max_size() == max_size);
+        CHECK(reader.max_size() == max_size);
+
+        writer.close();
+        reader.close();
+        CHECK_FALSE(writer.is_opened());
+        CHECK_FALSE(reader.is_opened());
+    }
+
+    SECTION("publish snapshots to multiple readers") {
+        snapshot_channel_writer writer;
+        writer.open(channel_name, max_size);
+        snapshot_channel_reader reader1;
+        reader1.open(channel_name, max_size);
+        snapshot_channel_reader reader2;
+        reader2.open(channel_name, max_size);
+        CHECK(reader1.version() == 0U);
+
+        writer.publish(bytes_view("abc", 3U));
+        writer.publish(bytes_view("defg", 4U));
+        CHECK(reader1.version() == 2U);
+        CHECK(read(reader1) == "defg");
+        CHECK(read(reader2) == "defg");
+
+        const auto buffer = writer.reserve();
+        REQUIRE(buffer.size() == max_size);
+        std::memcpy(buffer.data(), "hi", 2U);
+        writer.commit(2U);
+        CHECK(read(reader1) == "hi");
+    }
+
+    SECTION("publish a too large snapshot") {
+        snapshot_channel_writer writer;
+        writer.open(channel_name, max_size);
+
+        const std::string data(max_size + 1U, 'a');
+        CHECK_THROWS(writer.publish(bytes_view(data.data(), max_size + 1U)));
+    }
+
+    SECTION("call functions for closed channel") {
+        snapshot_channel_writer writer;
+        snapshot_channel_reader reader;
+
+        CHECK(writer.max_size() == 0U);
+        CHECK(writer.reserve().data() == nullptr);
+        CHECK_NOTHROW(writer.commit(0U));
+        CHECK_THROWS(writer.publish(bytes_view("a", 1U)));
+        CHECK(reader.max_size() == 0U);
+        CHECK(reader.version() == 0U);
+        CHECK(read(reader).empty());
+    }
+
+    SECTION("create and remove a channel") {
+        shm_stream::snapshot_channel::create(channel_name, max_size);
+        shm_stream::snapshot_channel::remove(channel_name);
+
+        CHECK_FALSE(boost::interprocess::shared_memory_object::remove(
+            ("shm_stream_snapshot_channel_data_" + channel_name).c_str()));
+        CHECK_FALSE(boost::interprocess::named_mutex::remove(
+            ("shm_stream_snapshot_channel_lock_" + channel_name).c_str()));
+    }
+
+    boost::interprocess::shared_memory_object::remove(
+        ("shm_stream_snapshot_channel_data_" + channel_name).c_str());
+    boost::interprocess::named_mutex::remove(
+        ("shm_stream_snapshot_channel_lock_" + channel_name).c_str());
+}
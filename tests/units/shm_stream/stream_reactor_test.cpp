@@ -0,0 +1,222 @@
+/*
+ * Copyright 2023 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Test of stream_reactor class and awaitables of streams.
+ */
+#include "shm_stream/stream_reactor.h"
+
+#ifdef SHM_STREAM_HAS_COROUTINES
+
+#include <chrono>
+#include <coroutine>
+#include <exception>
+#include <future>
+#include <string>
+#include <utility>
+
+#include <boost/interprocess/shared_memory_object.hpp>
+#include <boost/interprocess/sync/named_mutex.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "shm_stream/blocking_stream.h"
+#include "shm_stream/common_types.h"
+#include "shm_stream/light_stream.h"
+
+namespace {
+
+/*!
+ * \brief Class of coroutines setting the result to a promise.
+ */
+struct test_task {
+    //! Type of promises of coroutines.
+    struct promise_type {
+        test_task get_return_object() noexcept { return test_task{}; }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() noexcept {}
+        void unhandled_exception() noexcept { std::terminate(); }
+    };
+};
+
+/*!
+ * \brief Read bytes from a stream in a coroutine.
+ *
+ * \tparam Reader Type of the reader.
+ * \param[in] reader Reader.
+ * \param[in] reactor Reactor.
+ * \param[out] result Promise of the read bytes.
+ * \return Coroutine.
+ */
+template <typename Reader>
+test_task read_async(Reader& reader, shm_stream::stream_reactor& reactor,
+    std::promise<std::string>& result) {
+    const auto buffer = co_await reader.async_reserve(100U, reactor);
+    std::string bytes(buffer.data(), buffer.size());
+    reader.commit(buffer.size());
+    result.set_value(std::move(bytes));
+}
+
+/*!
+ * \brief Write bytes to a stream in a coroutine.
+ *
+ * \tparam Writer Type of the writer.
+ * \param[in] writer Writer.
+ * \param[in] reactor Reactor.
+ * \param[out] result Promise of the number of written bytes.
+ * \return Coroutine.
+ */
+template <typename Writer>
+test_task write_async(Writer& writer, shm_stream::stream_reactor& reactor,
+    std::promise<shm_stream::shm_stream_size_t>& result) {
+    const auto buffer = co_await writer.async_reserve(1U, reactor);
+    if (!buffer.empty()) {
+        buffer.data()[0] = 'a';
+        writer.commit(1U);
+    }
+    result.set_value(buffer.size());
+}
+
+}  // namespace
+
+TEST_CASE("shm_stream::stream_reactor") {
+    using shm_stream::shm_stream_size_t;
+
+    const std::string stream_name = "stream_reactor_test";
+    const auto remove_streams = [&stream_name] {
+        boost::interprocess::shared_memory_object::remove(
+            ("shm_stream_light_stream_data_" + stream_name).c_str());
+        boost::interprocess::named_mutex::remove(
+            ("shm_stream_light_stream_lock_" + stream_name).c_str());
+        boost::interprocess::shared_memory_object::remove(
+            ("shm_stream_blocking_stream_data_" + stream_name).c_str());
+        boost::interprocess::named_mutex::remove(
+            ("shm_stream_blocking_stream_lock_" + stream_name).c_str());
+    };
+    remove_streams();
+
+    constexpr shm_stream_size_t buffer_size = 4U;
+    constexpr auto wait_duration = std::chrono::milliseconds(10);
+    shm_stream::stream_reactor reactor;
+
+    SECTION("read bytes from a light stream") {
+        shm_stream::light_stream_writer writer;
+        writer.open(stream_name, buffer_size);
+        shm_stream::light_stream_reader reader;
+        reader.open(stream_name, buffer_size);
+
+        std::promise<std::string> result;
+        auto future = result.get_future();
+        read_async(reader, reactor, result);
+        CHECK(future.wait_for(wait_duration) == std::future_status::timeout);
+
+        const auto buffer = writer.try_reserve(2U);
+        REQUIRE(buffer.size() == 2U);
+        buffer.data()[0] = 'a';
+        buffer.data()[1] = 'b';
+        writer.commit(2U);
+        CHECK(future.get() == "ab");
+    }
+
+    SECTION("read bytes without suspension") {
+        shm_stream::light_stream_writer writer;
+        writer.open(stream_name, buffer_size);
+        shm_stream::light_stream_reader reader;
+        reader.open(stream_name, buffer_size);
+        const auto buffer = writer.try_reserve(1U);
+        REQUIRE(buffer.size() == 1U);
+        buffer.data()[0] = 'a';
+        writer.commit(1U);
+
+        std::promise<std::string> result;
+        auto future = result.get_future();
+        read_async(reader, reactor, result);
+        REQUIRE(future.wait_for(std::chrono::seconds(0)) ==
+            std::future_status::ready);
+        CHECK(future.get() == "a");
+    }
+
+    SECTION("write bytes to a light stream") {
+        shm_stream::light_stream_writer writer;
+        writer.open(stream_name, buffer_size);
+        shm_stream::light_stream_reader reader;
+        reader.open(stream_name, buffer_size);
+        writer.commit(writer.try_reserve().size());
+        REQUIRE(writer.available_size() == 0U);
+
+        std::promise<shm_stream_size_t> result;
+        auto future = result.get_future();
+        write_async(writer, reactor, result);
+        CHECK(future.wait_for(wait_duration) == std::future_status::timeout);
+
+        reader.commit(reader.try_reserve(1U).size());
+        CHECK(future.get() == 1U);
+    }
+
+    SECTION("read bytes from a blocking stream") {
+        shm_stream::blocking_stream_writer writer;
+        writer.open(stream_name, buffer_size);
+        shm_stream::blocking_stream_reader reader;
+        reader.open(stream_name, buffer_size);
+
+        std::promise<std::string> result;
+        auto future = result.get_future();
+        read_async(reader, reactor, result);
+        CHECK(future.wait_for(wait_duration) == std::future_status::timeout);
+
+        const auto buffer = writer.try_reserve(1U);
+        REQUIRE(buffer.size() == 1U);
+        buffer.data()[0] = 'x';
+        writer.commit(1U);
+        CHECK(future.get() == "x");
+    }
+
+    SECTION("resume readers of stopped blocking streams") {
+        shm_stream::blocking_stream_writer writer;
+        writer.open(stream_name, buffer_size);
+        shm_stream::blocking_stream_reader reader;
+        reader.open(stream_name, buffer_size);
+
+        std::promise<std::string> result;
+        auto future = result.get_future();
+        read_async(reader, reactor, result);
+        CHECK(future.wait_for(wait_duration) == std::future_status::timeout);
+
+        writer.stop();
+        CHECK(future.get().empty());
+    }
+
+    SECTION("write bytes to a blocking stream") {
+        shm_stream::blocking_stream_writer writer;
+        writer.open(stream_name, buffer_size);
+        shm_stream::blocking_stream_reader reader;
+        reader.open(stream_name, buffer_size);
+        writer.commit(writer.try_reserve().size());
+        REQUIRE(writer.available_size() == 0U);
+
+        std::promise<shm_stream_size_t> result;
+        auto future = result.get_future();
+        write_async(writer, reactor, result);
+        CHECK(future.wait_for(wait_duration) == std::future_status::timeout);
+
+        reader.commit(reader.try_reserve(1U).size());
+        CHECK(future.get() == 1U);
+    }
+
+    remove_streams();
+}
+
+#endif
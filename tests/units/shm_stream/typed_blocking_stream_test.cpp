@@ -0,0 +1,147 @@
+/*
+ * Copyright 2023 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Test of blocking streams of elements of a type.
+ */
+#include "shm_stream/typed_blocking_stream.h"
+
+#include <cstdint>
+#include <string>
+#include <thread>
+
+#include <boost/interprocess/shared_memory_object.hpp>
+#include <boost/interprocess/sync/named_mutex.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "shm_stream/common_types.h"
+#include "shm_stream/wait_policy.h"
+
+namespace {
+
+/*!
+ * \brief Struct of elements in tests of typed blocking streams.
+ */
+struct typed_blocking_stream_test_sample {
+    //! Time.
+    std::uint64_t time;
+
+    //! Value.
+    std::int16_t value;
+};
+
+}  // namespace
+
+TEST_CASE("shm_stream::typed_blocking_stream") {
+    using shm_stream::shm_stream_size_t;
+    using sample = typed_blocking_stream_test_sample;
+    using writer_type = shm_stream::typed_blocking_stream_writer<sample>;
+    using reader_type = shm_stream::typed_blocking_stream_reader<sample>;
+
+    const std::string stream_name = "typed_blocking_stream_test";
+    boost::interprocess::shared_memory_object::remove(
+        ("shm_stream_blocking_stream_data_" + stream_name).c_str());
+    boost::interprocess::named_mutex::remove(
+        ("shm_stream_blocking_stream_lock_" + stream_name).c_str());
+
+    constexpr shm_stream_size_t capacity = 5U;
+
+    SECTION("open streams") {
+        writer_type writer;
+        reader_type reader;
+
+        writer.open(stream_name, capacity);
+        reader.open(stream_name, capacity,
+            shm_stream::wait_policy(10U, 100U, 2U));  // NOLINT
+        CHECK(writer.is_opened());
+        CHECK(reader.is_opened());
+        CHECK(writer.available_size() == capacity);
+        CHECK(reader.available_size() == 0U);
+    }
+
+    SECTION("open a stream with another type of elements") {
+        writer_type writer;
+        writer.open(stream_name, capacity);
+
+        shm_stream::typed_blocking_stream_reader<std::uint64_t> reader;
+        CHECK_THROWS(reader.open(stream_name, capacity));
+        CHECK_FALSE(reader.is_opened());
+    }
+
+    SECTION("send elements from another thread") {
+        constexpr std::uint64_t num_elements = 1000U;
+
+        std::thread writer_thread{[&stream_name] {
+            writer_type writer;
+            writer.open(stream_name, capacity);
+            for (std::uint64_t i = 0U; i < num_elements;) {
+                const auto buffer = writer.wait_reserve(
+                    static_cast<shm_stream_size_t>(num_elements - i));
+                REQUIRE_FALSE(buffer.empty());
+                for (sample& element : buffer) {
+                    element = sample{i, static_cast<std::int16_t>(i % 100U)};
+                    ++i;
+                }
+                writer.commit(buffer.size());
+            }
+        }};
+
+        reader_type reader;
+        reader.open(stream_name, capacity);
+        for (std::uint64_t i = 0U; i < num_elements;) {
+            const auto buffer = reader.wait_reserve();
+            REQUIRE_FALSE(buffer.empty());
+            for (const sample& element : buffer) {
+                CHECK(element.time == i);
+                CHECK(element.value == static_cast<std::int16_t>(i % 100U));
+                ++i;
+            }
+            reader.commit(buffer.size());
+        }
+
+        writer_thread.join();
+    }
+
+    SECTION("stop streams") {
+        writer_type writer;
+        writer.open(stream_name, capacity);
+        reader_type reader;
+        reader.open(stream_name, capacity);
+
+        reader.stop();
+        CHECK(reader.is_stopped());
+        CHECK(writer.is_stopped());
+        CHECK(writer.wait() == 0U);
+        CHECK(writer.wait_reserve().empty());
+        CHECK(reader.wait_reserve(1U).empty());
+    }
+
+    SECTION("create and remove a stream") {
+        shm_stream::typed_blocking_stream::create<sample>(
+            stream_name, capacity);
+        shm_stream::typed_blocking_stream::remove(stream_name);
+
+        CHECK_FALSE(boost::interprocess::shared_memory_object::remove(
+            ("shm_stream_blocking_stream_data_" + stream_name).c_str()));
+        CHECK_FALSE(boost::interprocess::named_mutex::remove(
+            ("shm_stream_blocking_stream_lock_" + stream_name).c_str()));
+    }
+
+    boost::interprocess::shared_memory_object::remove(
+        ("shm_stream_blocking_stream_data_" + stream_name).c_str());
+    boost::interprocess::named_mutex::remove(
+        ("shm_stream_blocking_stream_lock_" + stream_name).c_str());
+}
@@ -0,0 +1,178 @@
+/*
+ * Copyright 2023 MusicScience37 (Kenta Kabashima)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*!
+ * \file
+ * \brief Test of light streams of elements of a type.
+ */
+#include "shm_stream/typed_light_stream.h"
+
+#include <cstdint>
+#include <string>
+
+#include <boost/interprocess/shared_memory_object.hpp>
+#include <boost/interprocess/sync/named_mutex.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "shm_stream/common_types.h"
+#include "shm_stream/light_stream.h"
+#include "shm_stream/shm_stream_exception.h"
+
+namespace {
+
+/*!
+ * \brief Struct of elements in tests of typed light streams.
+ */
+struct typed_light_stream_test_point {
+    //! X coordinate.
+    double x;
+
+    //! Y coordinate.
+    double y;
+
+    //! ID.
+    std::int32_t id;
+};
+
+}  // namespace
+
+TEST_CASE("shm_stream::typed_light_stream") {
+    using shm_stream::shm_stream_size_t;
+    using point = typed_light_stream_test_point;
+    using writer_type = shm_stream::typed_light_stream_writer<point>;
+    using reader_type = shm_stream::typed_light_stream_reader<point>;
+
+    const std::string stream_name = "typed_light_stream_test";
+    boost::interprocess::shared_memory_object::remove(
+        ("shm_stream_light_stream_data_" + stream_name).c_str());
+    boost::interprocess::named_mutex::remove(
+        ("shm_stream_light_stream_lock_" + stream_name).c_str());
+
+    constexpr shm_stream_size_t capacity = 3U;
+
+    SECTION("open streams") {
+        writer_type writer;
+        reader_type reader;
+        CHECK_FALSE(writer.is_opened());
+        CHECK_FALSE(reader.is_opened());
+
+        writer.open(stream_name, capacity);
+        reader.open(stream_name, capacity);
+        CHECK(writer.is_opened());
+        CHECK(reader.is_opened());
+        CHECK(writer.available_size() == capacity);
+        CHECK(reader.available_size() == 0U);
+    }
+
+    SECTION("open a stream with an invalid capacity") {
+        writer_type writer;
+        CHECK_THROWS(writer.open(stream_name, 0U));
+    }
+
+    SECTION("open a stream with another type of elements") {
+        writer_type writer;
+        writer.open(stream_name, capacity);
+
+        shm_stream::typed_light_stream_reader<std::int32_t> reader;
+        try {
+            reader.open(stream_name, capacity);
+            FAIL("No exception thrown.");
+        } catch (const shm_stream::shm_stream_error& e) {
+            CHECK(e.code() == c_shm_stream_error_code_type_mismatch);
+        }
+        CHECK_FALSE(reader.is_opened());
+    }
+
+    SECTION("open a stream with a stream of bytes") {
+        writer_type writer;
+        writer.open(stream_name, capacity);
+
+        shm_stream::light_stream_reader reader;
+        CHECK_NOTHROW(reader.open(stream_name, 1U));
+    }
+
+    SECTION("send elements") {
+        writer_type writer;
+        writer.open(stream_name, capacity);
+        reader_type reader;
+        reader.open(stream_name, capacity);
+
+        std::int32_t next_write_id = 0;
+        std::int32_t next_read_id = 0;
+        constexpr std::int32_t num_elements = 20;
+        while (next_read_id < num_elements) {
+            const auto write_buffer = writer.try_reserve(2U);
+            REQUIRE(write_buffer.size() <= 2U);
+            for (point& element : write_buffer) {
+                element = point{0.5, 1.5, next_write_id};  // NOLINT
+                ++next_write_id;
+            }
+            writer.commit(write_buffer.size());
+
+            const auto read_buffer = reader.try_reserve();
+            REQUIRE_FALSE(read_buffer.empty());
+            CHECK(reinterpret_cast<std::uintptr_t>(read_buffer.data()) %
+                    alignof(point) ==
+                0U);
+            for (const point& element : read_buffer) {
+                CHECK(element.id == next_read_id);
+                ++next_read_id;
+            }
+            reader.commit(read_buffer.size());
+        }
+    }
+
+    SECTION("fill the buffer") {
+        writer_type writer;
+        writer.open(stream_name, capacity);
+        reader_type reader;
+        reader.open(stream_name, capacity);
+
+        const auto write_buffer = writer.try_reserve(capacity + 1U);
+        CHECK(write_buffer.size() == capacity);
+        writer.commit(write_buffer.size());
+        CHECK(writer.available_size() == 0U);
+        CHECK(reader.available_size() == capacity);
+    }
+
+    SECTION("call functions for closed stream") {
+        writer_type writer;
+        reader_type reader;
+
+        CHECK(writer.available_size() == 0U);
+        CHECK(writer.try_reserve().empty());
+        CHECK_NOTHROW(writer.commit(1U));
+        CHECK(reader.available_size() == 0U);
+        CHECK(reader.try_reserve().empty());
+        CHECK_NOTHROW(reader.commit(1U));
+    }
+
+    SECTION("create and remove a stream") {
+        shm_stream::typed_light_stream::create<point>(stream_name, capacity);
+        CHECK_THROWS(shm_stream::typed_light_stream::create<std::int32_t>(
+            stream_name, capacity));
+        shm_stream::typed_light_stream::remove(stream_name);
+
+        CHECK_FALSE(boost::interprocess::shared_memory_object::remove(
+            ("shm_stream_light_stream_data_" + stream_name).c_str()));
+        CHECK_FALSE(boost::interprocess::named_mutex::remove(
+            ("shm_stream_light_stream_lock_" + stream_name).c_str()));
+    }
+
+    boost::interprocess::shared_memory_object::remove(
+        ("shm_stream_light_stream_data_" + stream_name).c_str());
+    boost::interprocess::named_mutex::remove(
+        ("shm_stream_light_stream_lock_" + stream_name).c_str());
+}
@@ -1,12 +1,34 @@
 set(SOURCE_FILES
+    shm_stream/anonymous_stream_test.cpp
+    shm_stream/asio_blocking_stream_test.cpp
     shm_stream/blocking_stream_test.cpp
+    shm_stream/broadcast_stream_test.cpp
     shm_stream/c_interface/c_headers.c
     shm_stream/c_interface/error_codes_test.cpp
     shm_stream/c_interface/translate_error_test.cpp
+    shm_stream/chunk_stream_test.cpp
+    shm_stream/details/adaptive_spinner_test.cpp
     shm_stream/details/atomic_index_pair_test.cpp
     shm_stream/details/blocking_bytes_queue_test.cpp
+    shm_stream/details/broadcast_bytes_queue_test.cpp
+    shm_stream/details/chunk_queue_test.cpp
     shm_stream/details/light_bytes_queue_test.cpp
+    shm_stream/details/light_message_queue_test.cpp
+    shm_stream/details/lossy_message_queue_test.cpp
+    shm_stream/details/mpsc_message_queue_test.cpp
     shm_stream/details/smart_ptr_test.cpp
+    shm_stream/details/snapshot_channel_test.cpp
+    shm_stream/doorbell_test.cpp
+    shm_stream/file_stream_test.cpp
+    shm_stream/inline_light_stream_test.cpp
+    shm_stream/light_message_stream_test.cpp
+    shm_stream/light_stream64_test.cpp
     shm_stream/light_stream_test.cpp
+    shm_stream/lossy_stream_test.cpp
+    shm_stream/mpsc_stream_test.cpp
+    shm_stream/snapshot_channel_test.cpp
+    shm_stream/stream_reactor_test.cpp
     shm_stream/string_view_test.cpp
+    shm_stream/typed_blocking_stream_test.cpp
+    shm_stream/typed_light_stream_test.cpp
 )